@@ -10,6 +10,21 @@
 #include "pcr.h"
 
 
+/**
+ * Indicate that a measurement in the PCR bank has changed.  The aggregate measurement for this
+ * index and all subsequent indexes will be recomputed on the next call to pcr_compute.  The PCR
+ * bank must be locked by the caller.
+ *
+ * @param pcr The PCR bank that was updated.
+ * @param measurement_index The index of the measurement that changed.
+ */
+static void pcr_mark_dirty (struct pcr_bank *pcr, uint8_t measurement_index)
+{
+	if (measurement_index < pcr->dirty_index) {
+		pcr->dirty_index = measurement_index;
+	}
+}
+
 /**
  * Common function to update digest in PCR bank's list of measurements
  *
@@ -42,6 +57,7 @@ static int pcr_update_digest_common (struct pcr_bank *pcr, uint8_t measurement_i
 	memcpy (pcr->measurement_list[measurement_index].digest, digest, digest_len);
 	pcr->measurement_list[measurement_index].measurement_config = measurement_config;
 	pcr->measurement_list[measurement_index].version = version;
+	pcr_mark_dirty (pcr, measurement_index);
 
 	platform_mutex_unlock (&pcr->lock);
 
@@ -346,7 +362,9 @@ int pcr_get_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint32_
 }
 
 /**
- * Compute aggregate of all measurements that have added to PCR bank
+ * Compute aggregate of all measurements that have added to PCR bank.  Aggregate measurements are
+ * cached in the PCR bank, so only measurements that have changed since the last computation, and
+ * the ones that follow them, need to be extended again.
  *
  * @param pcr The PCR bank to compute aggregate measurement of
  * @param hash Hashing engine to utilize
@@ -374,7 +392,19 @@ int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measur
 	}
 
 	if (!pcr->explicit_measurement) {
-		for (i_measurement = 0; i_measurement < (int) pcr->num_measurements; ++i_measurement) {
+		i_measurement = (int) pcr->dirty_index;
+		if (i_measurement > (int) pcr->num_measurements) {
+			i_measurement = pcr->num_measurements;
+		}
+
+		pcr->hashes_saved += i_measurement;
+
+		if (i_measurement != 0) {
+			memcpy (prev_measurement, pcr->measurement_list[i_measurement - 1].measurement,
+				sizeof (prev_measurement));
+		}
+
+		for (; i_measurement < (int) pcr->num_measurements; ++i_measurement) {
 			status = hash->start_sha256 (hash);
 			if (status != 0) {
 				goto exit;
@@ -398,6 +428,7 @@ int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measur
 
 			memcpy (pcr->measurement_list[i_measurement].measurement, prev_measurement,
 				sizeof (prev_measurement));
+			pcr->dirty_index = i_measurement + 1;
 		}
 	}
 	else {
@@ -429,6 +460,28 @@ exit:
 	return status;
 }
 
+/**
+ * Get the number of hash operations that were avoided by reusing cached aggregate measurements when
+ * computing the PCR.
+ *
+ * @param pcr The PCR bank to query.
+ * @param hashes_saved Output for the number of measurement extensions that were skipped.
+ *
+ * @return 0 if the count was retrieved successfully or an error code.
+ */
+int pcr_get_hashes_saved (struct pcr_bank *pcr, uint32_t *hashes_saved)
+{
+	if ((pcr == NULL) || (hashes_saved == NULL)) {
+		return PCR_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&pcr->lock);
+	*hashes_saved = pcr->hashes_saved;
+	platform_mutex_unlock (&pcr->lock);
+
+	return 0;
+}
+
 /**
  * Set the measured data for PCR bank
  *
@@ -751,6 +804,7 @@ int pcr_invalidate_measurement_index (struct pcr_bank *pcr, uint8_t measurement_
 
 	memset (pcr->measurement_list[measurement_index].digest, 0,
 		sizeof (pcr->measurement_list[measurement_index].digest));
+	pcr_mark_dirty (pcr, measurement_index);
 
 	platform_mutex_unlock (&pcr->lock);
 
@@ -46,6 +46,8 @@ struct pcr_bank {
 	size_t num_measurements;								/**< Number of measurements */
 	bool explicit_measurement;								/**< PCR bank contains an explicit measurement */
 	platform_mutex lock;									/**< Synchronization lock */
+	size_t dirty_index;										/**< Lowest measurement index that needs to be recomputed */
+	uint32_t hashes_saved;									/**< Number of hash operations skipped by using cached measurements */
 };
 
 #pragma pack(push, 1)
@@ -115,6 +117,7 @@ int pcr_update_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint
 int pcr_get_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint32_t *event_type);
 
 int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measurement, bool lock);
+int pcr_get_hashes_saved (struct pcr_bank *pcr, uint32_t *hashes_saved);
 int pcr_get_measurement (struct pcr_bank *pcr, uint8_t measurement_index,
 	struct pcr_measurement *measurement);
 int pcr_get_all_measurements (struct pcr_bank *pcr, const uint8_t **measurement_list);
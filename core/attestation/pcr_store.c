@@ -28,6 +28,8 @@ int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size
 		return PCR_INVALID_ARGUMENT;
 	}
 
+	memset (store, 0, sizeof (struct pcr_store));
+
 	store->banks = platform_malloc (sizeof (struct pcr_bank) * num_pcr);
 	if (store->banks == NULL) {
 		return PCR_NO_MEMORY;
@@ -35,6 +37,12 @@ int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size
 
 	store->num_pcr_banks = num_pcr;
 
+	status = platform_mutex_init (&store->log_lock);
+	if (status != 0) {
+		platform_free (store->banks);
+		return status;
+	}
+
 	for (i_pcr = 0; i_pcr < num_pcr; ++i_pcr) {
 		status = pcr_init (&store->banks[i_pcr], num_pcr_measurements[i_pcr]);
 		if (status != 0) {
@@ -43,6 +51,7 @@ int pcr_store_init (struct pcr_store *store, uint8_t *num_pcr_measurements, size
 				pcr_release (&store->banks[i_pcr]);
 			}
 
+			platform_mutex_free (&store->log_lock);
 			platform_free (store->banks);
 
 			return status;
@@ -66,6 +75,8 @@ void pcr_store_release (struct pcr_store *store)
 			pcr_release (&store->banks[i_pcr]);
 		}
 
+		platform_free (store->log_snapshot);
+		platform_mutex_free (&store->log_lock);
 		platform_free (store->banks);
 	}
 }
@@ -411,6 +422,68 @@ int pcr_store_get_attestation_log_size (struct pcr_store *store)
 	return (status * sizeof (struct pcr_store_attestation_log_entry));
 }
 
+/**
+ * Free the memory used by an attestation log snapshot.  The log lock must be held by the caller.
+ *
+ * @param store The PCR store holding the snapshot.
+ */
+static void pcr_store_free_log_snapshot (struct pcr_store *store)
+{
+	platform_free (store->log_snapshot);
+	store->log_snapshot = NULL;
+	store->log_snapshot_length = 0;
+}
+
+/**
+ * Enable attestation log snapshots for multi-part log reads.  When enabled, a read starting at
+ * offset 0 will capture a serialized copy of the complete attestation log.  Reads at other offsets
+ * will be served from this copy, which ensures a consistent view of the log across all reads and
+ * avoids the need to regenerate the log for every request.
+ *
+ * The snapshot is discarded once the end of the log has been read or if no reads are received
+ * before the timeout expires.
+ *
+ * @param store The PCR store to configure.
+ * @param timeout_ms The amount of time a snapshot will be held between log reads, in milliseconds.
+ * Setting this to 0 disables log snapshots.
+ *
+ * @return 0 if the snapshot configuration was updated or an error code.
+ */
+int pcr_store_enable_attestation_log_snapshot (struct pcr_store *store, uint32_t timeout_ms)
+{
+	if (store == NULL) {
+		return PCR_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&store->log_lock);
+
+	store->log_snapshot_timeout = timeout_ms;
+	if (timeout_ms == 0) {
+		pcr_store_free_log_snapshot (store);
+	}
+
+	platform_mutex_unlock (&store->log_lock);
+
+	return 0;
+}
+
+/**
+ * Discard any attestation log snapshot currently being held.  The next log read will be generated
+ * from the current PCR state.
+ *
+ * @param store The PCR store to update.
+ */
+void pcr_store_release_attestation_log_snapshot (struct pcr_store *store)
+{
+	if (store != NULL) {
+		platform_mutex_lock (&store->log_lock);
+
+		pcr_store_free_log_snapshot (store);
+
+		platform_mutex_unlock (&store->log_lock);
+	}
+}
+
 /**
  * Generate attestation log from PCR banks.
  *
@@ -422,7 +495,7 @@ int pcr_store_get_attestation_log_size (struct pcr_store *store)
  *
  * @return The number of bytes read from the log or an error code.
  */
-int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *hash,
+static int pcr_store_generate_attestation_log (struct pcr_store *store, struct hash_engine *hash,
 	uint32_t offset, uint8_t *contents, size_t length)
 {
 	struct pcr_store_attestation_log_entry log_entry;
@@ -438,10 +511,6 @@ int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *
 	int i_measurement;
 	int status;
 
-	if ((store == NULL) || (hash == NULL) || (contents == NULL)) {
-		return PCR_INVALID_ARGUMENT;
-	}
-
 	for (i_bank = 0; i_bank < store->num_pcr_banks; ++i_bank) {
 		status = pcr_lock (&store->banks[i_bank]);
 		if (status != 0) {
@@ -534,6 +603,112 @@ int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *
 	return contents_offset;
 }
 
+/**
+ * Capture a snapshot of the complete attestation log.  Any existing snapshot must already have
+ * been released.  The log lock must be held by the caller.
+ *
+ * @param store PCR store to capture the log from.
+ * @param hash Hashing engine to utilize in PCR bank operations.
+ *
+ * @return 0 if the snapshot was captured or an error code.  If there is not enough memory for the
+ * snapshot, no snapshot will be captured but no error will be reported.
+ */
+static int pcr_store_capture_attestation_log (struct pcr_store *store, struct hash_engine *hash)
+{
+	int log_size;
+	int status;
+
+	log_size = pcr_store_get_attestation_log_size (store);
+	if (ROT_IS_ERROR (log_size)) {
+		return log_size;
+	}
+
+	if (log_size == 0) {
+		return 0;
+	}
+
+	store->log_snapshot = platform_malloc (log_size);
+	if (store->log_snapshot == NULL) {
+		return 0;
+	}
+
+	status = pcr_store_generate_attestation_log (store, hash, 0, store->log_snapshot, log_size);
+	if (ROT_IS_ERROR (status)) {
+		platform_free (store->log_snapshot);
+		store->log_snapshot = NULL;
+		return status;
+	}
+
+	store->log_snapshot_length = status;
+
+	return 0;
+}
+
+/**
+ * Read the attestation log generated from the PCR banks.  If log snapshots have been enabled, the
+ * data will be read from a snapshot captured at the start of the log read.
+ *
+ * @param store PCR store to get measurements from.
+ * @param hash Hashing engine to utilize in PCR bank operations.
+ * @param offset Offset within the log to start reading data.
+ * @param contents Output buffer for the log contents.
+ * @param length Maximum number of bytes to read from the log.
+ *
+ * @return The number of bytes read from the log or an error code.
+ */
+int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *hash,
+	uint32_t offset, uint8_t *contents, size_t length)
+{
+	int status;
+
+	if ((store == NULL) || (hash == NULL) || (contents == NULL)) {
+		return PCR_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&store->log_lock);
+
+	if (store->log_snapshot_timeout == 0) {
+		status = pcr_store_generate_attestation_log (store, hash, offset, contents, length);
+		goto exit;
+	}
+
+	if ((store->log_snapshot != NULL) &&
+		((offset == 0) || (platform_has_timeout_expired (&store->log_snapshot_expiration) != 0))) {
+		pcr_store_free_log_snapshot (store);
+	}
+
+	if (offset == 0) {
+		status = pcr_store_capture_attestation_log (store, hash);
+		if (status != 0) {
+			goto exit;
+		}
+	}
+
+	if (store->log_snapshot == NULL) {
+		status = pcr_store_generate_attestation_log (store, hash, offset, contents, length);
+		goto exit;
+	}
+
+	if (offset < store->log_snapshot_length) {
+		status = min (length, store->log_snapshot_length - offset);
+		memcpy (contents, &store->log_snapshot[offset], status);
+	}
+	else {
+		status = 0;
+	}
+
+	if ((offset + status) >= store->log_snapshot_length) {
+		pcr_store_free_log_snapshot (store);
+	}
+	else {
+		platform_init_timeout (store->log_snapshot_timeout, &store->log_snapshot_expiration);
+	}
+
+exit:
+	platform_mutex_unlock (&store->log_lock);
+	return status;
+}
+
 /**
  * Generate TCG formatted log from PCR banks.
  *
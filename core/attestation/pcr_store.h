@@ -20,6 +20,11 @@
 struct pcr_store {
 	struct pcr_bank *banks;								/**< PCR banks */
 	size_t num_pcr_banks;								/**< Number of PCR banks */
+	platform_mutex log_lock;							/**< Synchronization for the log snapshot. */
+	uint8_t *log_snapshot;								/**< Serialized attestation log being read. */
+	size_t log_snapshot_length;							/**< Length of the log snapshot. */
+	uint32_t log_snapshot_timeout;						/**< Idle time before the snapshot is discarded. */
+	platform_clock log_snapshot_expiration;				/**< Expiration time for the log snapshot. */
 };
 
 #pragma pack(push, 1)
@@ -74,6 +79,8 @@ int pcr_store_invalidate_measurement (struct pcr_store *store, uint16_t measurem
 int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *hash,
 	uint32_t offset, uint8_t *contents, size_t length);
 int pcr_store_get_attestation_log_size (struct pcr_store *store);
+int pcr_store_enable_attestation_log_snapshot (struct pcr_store *store, uint32_t timeout_ms);
+void pcr_store_release_attestation_log_snapshot (struct pcr_store *store);
 
 int pcr_store_get_tcg_log (struct pcr_store *store, uint8_t *buffer, size_t offset, size_t length);
 
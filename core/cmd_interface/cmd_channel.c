@@ -140,6 +140,64 @@ static int cmd_channel_send_packets (struct cmd_channel *channel, struct cmd_mes
 	platform_mutex_unlock (&channel->lock);
 	return status;
 }
+
+/**
+ * Send a list of scatter/gather packets over a command channel.  Packets are sent with the same
+ * guarantees as cmd_channel_send_packets.  If the channel does not support scatter/gather
+ * transmission, each packet will be assembled in the packet buffer and sent normally.
+ *
+ * @param channel The channel to send the packets on.
+ * @param message The message container with the packets that should be sent.
+ * @param packet A packet buffer to use for sending the packets.  Once access to the channel is
+ * granted, the timeout on this packet will be checked to see if it should still be sent.
+ *
+ * @return 0 if all packets were successfully sent or an error code.  If no packets were sent due to
+ * the packet timeout value, CMD_CHANNEL_PKT_EXPIRED will be returned.
+ */
+static int cmd_channel_send_packets_sg (struct cmd_channel *channel,
+	const struct cmd_message_sg *message, struct cmd_packet *packet)
+{
+	const struct cmd_packet_sg *pkt_sg;
+	size_t i;
+	int status = 0;
+
+	platform_mutex_lock (&channel->lock);
+
+	if (!packet->timeout_valid || !platform_has_timeout_expired (&packet->pkt_timeout)) {
+		memset (packet, 0, sizeof (*packet));
+		packet->state = CMD_VALID_PACKET;
+
+		for (i = 0; (i < message->num_packets) && (status == 0); i++) {
+			pkt_sg = &message->packets[i];
+
+			if (channel->send_packet_sg != NULL) {
+				status = channel->send_packet_sg (channel, pkt_sg);
+			}
+			else {
+				packet->pkt_size = pkt_sg->header_len + pkt_sg->payload_len + pkt_sg->trailer_len;
+				if (packet->pkt_size > sizeof (packet->data)) {
+					status = CMD_CHANNEL_INVALID_PKT_SIZE;
+					continue;
+				}
+
+				memcpy (packet->data, pkt_sg->header, pkt_sg->header_len);
+				memcpy (&packet->data[pkt_sg->header_len], pkt_sg->payload, pkt_sg->payload_len);
+				memcpy (&packet->data[pkt_sg->header_len + pkt_sg->payload_len], pkt_sg->trailer,
+					pkt_sg->trailer_len);
+				packet->dest_addr = pkt_sg->dest_addr;
+
+				status = channel->send_packet (channel, packet);
+			}
+		}
+	}
+	else {
+		status = CMD_CHANNEL_PKT_EXPIRED;
+	}
+
+	platform_mutex_unlock (&channel->lock);
+	return status;
+}
+
 /**
  * Receive a single packet from the command channel and process it.  Errors will be logged.
  *
@@ -155,6 +213,7 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 {
 	struct cmd_packet packet;
 	struct cmd_message *message;
+	struct cmd_message_sg *message_sg;
 	int status;
 
 	if ((channel == NULL) || (mctp == NULL)) {
@@ -193,10 +252,16 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 			CMD_LOGGING_CHANNEL_PACKET_ERROR, channel->id, 0);
 	}
 
-	status = mctp_interface_process_packet (mctp, &packet, &message);
+	status = mctp_interface_process_packet_sg (mctp, &packet, &message, &message_sg);
 	if (status == 0) {
-		if (message != NULL) {
-			status = cmd_channel_send_packets (channel, message, &packet);
+		if ((message != NULL) || (message_sg != NULL)) {
+			if (message_sg != NULL) {
+				status = cmd_channel_send_packets_sg (channel, message_sg, &packet);
+			}
+			else {
+				status = cmd_channel_send_packets (channel, message, &packet);
+			}
+
 			if (status != 0) {
 				if (status == CMD_CHANNEL_PKT_EXPIRED) {
 					platform_clock now;
@@ -244,3 +309,26 @@ int cmd_channel_send_message (struct cmd_channel *channel, struct cmd_message *m
 	packet.timeout_valid = false;
 	return cmd_channel_send_packets (channel, message, &packet);
 }
+
+/**
+ * Send a message that has been packetized into scatter/gather packets over a communication
+ * channel.  This call will block until the last packet has been sent, which follows the same
+ * postconditions as the send_packet call.
+ *
+ * @param channel The channel to send the message on.
+ * @param message The scatter/gather packets to send.
+ *
+ * @return 0 if the message was successfully sent or an error code.
+ */
+int cmd_channel_send_message_sg (struct cmd_channel *channel,
+	const struct cmd_message_sg *message)
+{
+	struct cmd_packet packet;
+
+	if ((channel == NULL) || (message == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	packet.timeout_valid = false;
+	return cmd_channel_send_packets_sg (channel, message, &packet);
+}
@@ -17,6 +17,16 @@
  */
 #define	CMD_MAX_PACKET_SIZE				MCTP_BASE_PROTOCOL_MAX_PACKET_LEN
 
+/**
+ * The maximum size of the header added before the payload of a scatter/gather packet.
+ */
+#define	CMD_MAX_PACKET_SG_HEADER_SIZE	(sizeof (struct mctp_base_protocol_transport_header))
+
+/**
+ * The maximum size of the trailer added after the payload of a scatter/gather packet.
+ */
+#define	CMD_MAX_PACKET_SG_TRAILER_SIZE	MCTP_BASE_PROTOCOL_PEC_SIZE
+
 #define CMD_CHANNEL_I3C_BASE				0x80
 #define CMD_CHANNEL_I3C_TARGET				0x40
 /**
@@ -53,6 +63,30 @@ struct cmd_message {
 	uint8_t dest_addr;					/**< The destination address for the message. */
 };
 
+/**
+ * Information for a single command packet that is stored as separate segments.  The packet
+ * payload references the message data directly, so it does not need to be copied into a packet
+ * buffer before transmission.  The packet data is the header, followed by the payload, followed by
+ * the trailer.
+ */
+struct cmd_packet_sg {
+	uint8_t header[CMD_MAX_PACKET_SG_HEADER_SIZE];		/**< Packet data preceding the payload. */
+	size_t header_len;									/**< Length of the packet header. */
+	const uint8_t *payload;								/**< The packet payload. */
+	size_t payload_len;									/**< Length of the packet payload. */
+	uint8_t trailer[CMD_MAX_PACKET_SG_TRAILER_SIZE];	/**< Packet data following the payload. */
+	size_t trailer_len;									/**< Length of the packet trailer. */
+	uint8_t dest_addr;									/**< The destination address for the packet. */
+};
+
+/**
+ * Information for a single command message that is stored as a list of scatter/gather packets.
+ */
+struct cmd_message_sg {
+	const struct cmd_packet_sg *packets;				/**< The list of packets in the message. */
+	size_t num_packets;									/**< The number of packets in the message. */
+};
+
 
 struct mctp_interface;
 
@@ -91,6 +125,24 @@ struct cmd_channel {
 	 */
 	int (*send_packet) (struct cmd_channel *channel, struct cmd_packet *packet);
 
+	/**
+	 * Send a command packet over a communication channel directly from separate header, payload,
+	 * and trailer segments.  This allows a channel to transmit message data without first copying
+	 * it into a contiguous packet buffer.
+	 *
+	 * This is optional and can be set to null if the channel does not support scatter/gather
+	 * transmission.  In that case, the packet will be assembled and sent with send_packet.
+	 *
+	 * The same postconditions as send_packet apply to this call.  The packet segments may be
+	 * modified after the call returns, so any data still in flight must be buffered by the channel.
+	 *
+	 * @param channel The channel to send a packet on.
+	 * @param packet The packet to send.
+	 *
+	 * @return 0 if the the packet was successfully sent or an error code.
+	 */
+	int (*send_packet_sg) (struct cmd_channel *channel, const struct cmd_packet_sg *packet);
+
 	int id;					/**< ID for the command channel. */
 	bool overflow;			/**< Flag if the channel is in an overflow condition. */
 	platform_mutex lock;	/**< Synchronization for message transmission. */
@@ -103,6 +155,8 @@ int cmd_channel_validate_packet_for_send (const struct cmd_packet *packet);
 int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_interface *mctp,
 	int ms_timeout);
 int cmd_channel_send_message (struct cmd_channel *channel, struct cmd_message *message);
+int cmd_channel_send_message_sg (struct cmd_channel *channel,
+	const struct cmd_message_sg *message);
 
 /* Internal functions for use by derived types. */
 int cmd_channel_init (struct cmd_channel *channel, int id);
@@ -0,0 +1,396 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "cmd_dispatch.h"
+#include "cmd_logging.h"
+#include "logging/debug_log.h"
+#include "mctp/mctp_interface.h"
+
+
+/**
+ * Initialize a queue for executing received requests from worker contexts.  No requests are
+ * executed until a worker context is running cmd_dispatch_run or requests are manually processed
+ * with cmd_dispatch_process_next.
+ *
+ * @param dispatch The dispatch queue to initialize.
+ * @param requests The requests to use for queued messages.  This determines the maximum number of
+ * requests that can be outstanding across all channels using the queue.
+ * @param count The number of requests available to the queue.
+ *
+ * @return 0 if the queue was initialized successfully or an error code.
+ */
+int cmd_dispatch_init (struct cmd_dispatch *dispatch, struct cmd_dispatch_request *requests,
+	size_t count)
+{
+	size_t i;
+	int status;
+
+	if ((dispatch == NULL) || (requests == NULL) || (count == 0)) {
+		return CMD_DISPATCH_INVALID_ARGUMENT;
+	}
+
+	memset (dispatch, 0, sizeof (struct cmd_dispatch));
+
+	status = platform_mutex_init (&dispatch->lock);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_mutex_init (&dispatch->execute);
+	if (status != 0) {
+		goto exit_mutex;
+	}
+
+	status = platform_semaphore_init (&dispatch->pending);
+	if (status != 0) {
+		goto exit_execute;
+	}
+
+	memset (requests, 0, sizeof (struct cmd_dispatch_request) * count);
+	for (i = 0; i < count; i++) {
+		requests[i].request.data = &requests[i].msg_buffer[
+			sizeof (requests[i].msg_buffer) - MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+		requests[i].next = dispatch->free;
+		dispatch->free = &requests[i];
+	}
+
+	dispatch->requests = requests;
+	dispatch->count = count;
+
+	return 0;
+
+exit_execute:
+	platform_mutex_free (&dispatch->execute);
+exit_mutex:
+	platform_mutex_free (&dispatch->lock);
+	return status;
+}
+
+/**
+ * Release the resources used by a dispatch queue.  All worker contexts must be stopped before the
+ * queue is released.
+ *
+ * @param dispatch The dispatch queue to release.
+ */
+void cmd_dispatch_release (struct cmd_dispatch *dispatch)
+{
+	if (dispatch != NULL) {
+		platform_semaphore_free (&dispatch->pending);
+		platform_mutex_free (&dispatch->execute);
+		platform_mutex_free (&dispatch->lock);
+	}
+}
+
+/**
+ * Submit a complete request message to be executed by a worker context.  The message data is
+ * copied, so the request buffer can be reused as soon as this call returns.
+ *
+ * If all requests in the queue are in use, this will block until one is available.
+ *
+ * @param dispatch The dispatch queue to add the request to.
+ * @param mctp The MCTP layer that received the request.  This MCTP layer must be using the dispatch
+ * queue.
+ * @param request The request message to execute.
+ * @param response_addr The address to send the response to.
+ * @param source_addr The address the response will be sent from.
+ * @param msg_tag The message tag to use for the response.
+ * @param cmd_set The command set of the request.
+ *
+ * @return 0 if the request was added to the queue or an error code.
+ */
+int cmd_dispatch_submit (struct cmd_dispatch *dispatch, struct mctp_interface *mctp,
+	const struct cmd_interface_msg *request, uint8_t response_addr, uint8_t source_addr,
+	uint8_t msg_tag, uint8_t cmd_set)
+{
+	struct cmd_dispatch_waiter waiter;
+	struct cmd_dispatch_waiter **pos;
+	struct cmd_dispatch_request *work;
+	int status;
+
+	if ((dispatch == NULL) || (mctp == NULL) || (request == NULL)) {
+		return CMD_DISPATCH_INVALID_ARGUMENT;
+	}
+
+	if (request->length > MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY) {
+		return CMD_DISPATCH_MSG_TOO_LARGE;
+	}
+
+	platform_mutex_lock (&dispatch->lock);
+
+	if (!dispatch->stop && (dispatch->free == NULL)) {
+		status = platform_semaphore_init (&waiter.available);
+		if (status != 0) {
+			platform_mutex_unlock (&dispatch->lock);
+			return status;
+		}
+
+		waiter.next = dispatch->waiters;
+		dispatch->waiters = &waiter;
+
+		while (!dispatch->stop && (dispatch->free == NULL)) {
+			platform_mutex_unlock (&dispatch->lock);
+
+			platform_semaphore_wait (&waiter.available, 0);
+
+			platform_mutex_lock (&dispatch->lock);
+		}
+
+		/* Notifications are only posted while holding the dispatch lock, so once the waiter is
+		 * removed, nothing else will access it. */
+		pos = &dispatch->waiters;
+		while (*pos != &waiter) {
+			pos = &(*pos)->next;
+		}
+		*pos = waiter.next;
+
+		platform_semaphore_free (&waiter.available);
+	}
+
+	if (dispatch->stop) {
+		platform_mutex_unlock (&dispatch->lock);
+		return CMD_DISPATCH_STOPPED;
+	}
+
+	work = dispatch->free;
+	dispatch->free = work->next;
+
+	work->mctp = mctp;
+	memcpy (work->request.data, request->data, request->length);
+	work->request.length = request->length;
+	work->request.max_response = request->max_response;
+	work->request.source_eid = request->source_eid;
+	work->request.source_addr = request->source_addr;
+	work->request.target_eid = request->target_eid;
+	work->request.crypto_timeout = false;
+	work->request.channel_id = request->channel_id;
+	memset (&work->response, 0, sizeof (work->response));
+	work->response_addr = response_addr;
+	work->source_addr = source_addr;
+	work->msg_tag = msg_tag;
+	work->cmd_set = cmd_set;
+	work->sequence = mctp->dispatch.next_sequence++;
+	work->state = CMD_DISPATCH_REQUEST_QUEUED;
+	work->next = NULL;
+
+	if (dispatch->tail != NULL) {
+		dispatch->tail->next = work;
+	}
+	else {
+		dispatch->head = work;
+	}
+	dispatch->tail = work;
+
+	platform_mutex_unlock (&dispatch->lock);
+
+	return platform_semaphore_post (&dispatch->pending);
+}
+
+/**
+ * Find the completed request that holds the next response to send for an MCTP layer.  This must be
+ * called while holding the dispatch lock.
+ *
+ * @param dispatch The dispatch queue to search.
+ * @param mctp The MCTP layer to find the next response for.
+ *
+ * @return The next response to send or null if it has not been completed yet.
+ */
+static struct cmd_dispatch_request* cmd_dispatch_find_next_response (struct cmd_dispatch *dispatch,
+	struct mctp_interface *mctp)
+{
+	size_t i;
+
+	for (i = 0; i < dispatch->count; i++) {
+		if ((dispatch->requests[i].state == CMD_DISPATCH_REQUEST_COMPLETE) &&
+			(dispatch->requests[i].mctp == mctp) &&
+			(dispatch->requests[i].sequence == mctp->dispatch.send_sequence)) {
+			return &dispatch->requests[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Notify all contexts waiting for a free request.  This must be called while holding the dispatch
+ * lock.
+ *
+ * @param dispatch The dispatch queue to notify.
+ */
+static void cmd_dispatch_notify_waiters (struct cmd_dispatch *dispatch)
+{
+	struct cmd_dispatch_waiter *waiter;
+
+	for (waiter = dispatch->waiters; waiter != NULL; waiter = waiter->next) {
+		platform_semaphore_post (&waiter->available);
+	}
+}
+
+/**
+ * Mark a request as complete and send all responses for the channel that are ready, in the order
+ * the requests were received.  If another worker is already sending responses for the channel, it
+ * will send this response once all earlier responses have been sent.
+ *
+ * @param dispatch The dispatch queue that executed the request.
+ * @param work The request that has completed.
+ */
+static void cmd_dispatch_send_responses (struct cmd_dispatch *dispatch,
+	struct cmd_dispatch_request *work)
+{
+	struct cmd_dispatch_channel *order = &work->mctp->dispatch;
+	struct cmd_dispatch_request *next;
+	int status;
+
+	platform_mutex_lock (&dispatch->lock);
+
+	work->state = CMD_DISPATCH_REQUEST_COMPLETE;
+
+	while (!order->sending &&
+		((next = cmd_dispatch_find_next_response (dispatch, work->mctp)) != NULL)) {
+		order->sending = true;
+		next->state = CMD_DISPATCH_REQUEST_SENDING;
+		platform_mutex_unlock (&dispatch->lock);
+
+		if (next->response.msg_size != 0) {
+			status = cmd_channel_send_message (order->channel, &next->response);
+			if (status != 0) {
+				debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
+					CMD_LOGGING_SEND_PACKET_FAIL, order->channel->id, status);
+			}
+		}
+
+		platform_mutex_lock (&dispatch->lock);
+
+		order->sending = false;
+		order->send_sequence++;
+
+		next->state = CMD_DISPATCH_REQUEST_FREE;
+		next->next = dispatch->free;
+		dispatch->free = next;
+	}
+
+	cmd_dispatch_notify_waiters (dispatch);
+
+	platform_mutex_unlock (&dispatch->lock);
+}
+
+/**
+ * Execute the next request in the queue, if there is one, and send any responses that are ready.
+ * This is called from the worker contexts, but can also be called directly on systems that do not
+ * run dedicated workers.
+ *
+ * @param dispatch The dispatch queue to process.
+ *
+ * @return 1 if a request was executed, 0 if the queue is empty, or an error code.
+ */
+int cmd_dispatch_process_next (struct cmd_dispatch *dispatch)
+{
+	struct cmd_dispatch_request *work;
+	platform_mutex *execute;
+	bool more;
+	int status;
+
+	if (dispatch == NULL) {
+		return CMD_DISPATCH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&dispatch->lock);
+
+	work = dispatch->head;
+	if (work != NULL) {
+		dispatch->head = work->next;
+		if (dispatch->head == NULL) {
+			dispatch->tail = NULL;
+		}
+
+		work->state = CMD_DISPATCH_REQUEST_RUNNING;
+	}
+	more = (dispatch->head != NULL);
+
+	platform_mutex_unlock (&dispatch->lock);
+
+	if (work == NULL) {
+		return 0;
+	}
+
+	/* Semaphores may not count multiple notifications, so make sure another worker is woken up to
+	 * handle the remaining requests while this one is executing. */
+	if (more) {
+		platform_semaphore_post (&dispatch->pending);
+	}
+
+	/* Most command handlers keep state that is not safe to access from multiple contexts, and they
+	 * can share components with the handlers for other channels.  Requests are serialized with all
+	 * other channels using the same execution lock, so only handlers that share components block
+	 * each other.  Requests for reentrant channels don't need any serialization. */
+	execute = work->mctp->dispatch.execute;
+	if (execute != NULL) {
+		platform_mutex_lock (execute);
+	}
+
+	status = mctp_interface_process_dispatched_request (work->mctp, work);
+
+	if (execute != NULL) {
+		platform_mutex_unlock (execute);
+	}
+
+	if (status != 0) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CMD_INTERFACE,
+			CMD_LOGGING_PROCESS_FAIL, status, work->mctp->dispatch.channel->id);
+
+		work->response.msg_size = 0;
+	}
+
+	cmd_dispatch_send_responses (dispatch, work);
+
+	return 1;
+}
+
+/**
+ * Worker loop for executing queued requests.  Any number of worker contexts can run this loop for
+ * the same queue.  This does not return until the queue has been stopped.
+ *
+ * @param dispatch The dispatch queue to process.
+ */
+void cmd_dispatch_run (struct cmd_dispatch *dispatch)
+{
+	bool stop;
+
+	if (dispatch == NULL) {
+		return;
+	}
+
+	do {
+		platform_semaphore_wait (&dispatch->pending, 0);
+
+		/* Check for a stop request before processing so no accepted request is left behind. */
+		platform_mutex_lock (&dispatch->lock);
+		stop = dispatch->stop;
+		platform_mutex_unlock (&dispatch->lock);
+
+		while (cmd_dispatch_process_next (dispatch) == 1);
+	} while (!stop);
+
+	/* Pass the stop notification on to the next worker. */
+	platform_semaphore_post (&dispatch->pending);
+}
+
+/**
+ * Stop the queue from accepting new requests and signal the worker contexts to exit once all
+ * outstanding requests have been executed.
+ *
+ * @param dispatch The dispatch queue to stop.
+ */
+void cmd_dispatch_stop (struct cmd_dispatch *dispatch)
+{
+	if (dispatch != NULL) {
+		platform_mutex_lock (&dispatch->lock);
+		dispatch->stop = true;
+		cmd_dispatch_notify_waiters (dispatch);
+		platform_mutex_unlock (&dispatch->lock);
+
+		platform_semaphore_post (&dispatch->pending);
+	}
+}
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_DISPATCH_H_
+#define CMD_DISPATCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "status/rot_status.h"
+#include "platform_api.h"
+#include "cmd_interface/cmd_channel.h"
+#include "cmd_interface/cmd_interface.h"
+#include "mctp/mctp_base_protocol.h"
+
+
+struct mctp_interface;
+struct cmd_dispatch;
+
+/**
+ * Processing state of a dispatched request.
+ */
+enum cmd_dispatch_request_state {
+	CMD_DISPATCH_REQUEST_FREE = 0,		/**< The request is not in use. */
+	CMD_DISPATCH_REQUEST_QUEUED,		/**< The request is waiting for a worker. */
+	CMD_DISPATCH_REQUEST_RUNNING,		/**< The request is being executed by a worker. */
+	CMD_DISPATCH_REQUEST_COMPLETE,		/**< The response is waiting to be sent. */
+	CMD_DISPATCH_REQUEST_SENDING,		/**< The response is being sent. */
+};
+
+/**
+ * A complete request message waiting to be executed by a dispatch worker.  Each request has its
+ * own message buffer, so requests can be received while others are being executed.
+ */
+struct cmd_dispatch_request {
+	struct mctp_interface *mctp;						/**< MCTP layer that received the request. */
+	struct cmd_interface_msg request;					/**< The request to execute. */
+	struct cmd_message response;						/**< The packetized response to send. */
+	uint8_t msg_buffer[MCTP_BASE_PROTOCOL_MAX_MESSAGE_LEN];	/**< Buffer for the request and response. */
+	uint8_t response_addr;								/**< Address to send the response to. */
+	uint8_t source_addr;								/**< Address to send the response from. */
+	uint8_t msg_tag;									/**< Message tag for the response. */
+	uint8_t cmd_set;									/**< Command set of the request. */
+	uint32_t sequence;									/**< Order of the request on the channel. */
+	enum cmd_dispatch_request_state state;				/**< Processing state of the request. */
+	struct cmd_dispatch_request *next;					/**< Next request in the list. */
+};
+
+/**
+ * Dispatch state for a single command channel.  Responses are sent on the channel in the same order
+ * the requests were received, regardless of the order in which the workers complete them.
+ */
+struct cmd_dispatch_channel {
+	struct cmd_dispatch *dispatch;		/**< The dispatch queue for executing requests. */
+	struct cmd_channel *channel;		/**< The channel for sending responses. */
+	uint32_t next_sequence;				/**< Sequence number for the next received request. */
+	uint32_t send_sequence;				/**< Sequence number of the next response to send. */
+	bool sending;						/**< Flag indicating a worker is sending responses. */
+	platform_mutex *execute;			/**< Serialization for the handlers.  Null if reentrant. */
+};
+
+/**
+ * A context waiting for a request to be freed.  Each waiter has its own notification, so all
+ * waiting contexts are woken up without depending on the platform providing counting semaphores.
+ */
+struct cmd_dispatch_waiter {
+	platform_semaphore available;		/**< Notification that a request has been freed. */
+	struct cmd_dispatch_waiter *next;	/**< The next waiting context. */
+};
+
+/**
+ * A bounded queue of complete request messages that are executed by a pool of worker contexts.
+ * This separates packet reception and message reassembly from command execution, so a long-running
+ * command does not block requests received on other channels.
+ */
+struct cmd_dispatch {
+	platform_mutex lock;					/**< Synchronization for dispatch state. */
+	platform_mutex execute;					/**< Default serialization for non-reentrant handlers. */
+	platform_semaphore pending;				/**< Notification that requests are waiting for a worker. */
+	struct cmd_dispatch_request *free;		/**< List of requests available for use. */
+	struct cmd_dispatch_request *head;		/**< The next request to execute. */
+	struct cmd_dispatch_request *tail;		/**< The last request that was submitted. */
+	struct cmd_dispatch_request *requests;	/**< All requests managed by the queue. */
+	size_t count;							/**< The number of requests managed by the queue. */
+	struct cmd_dispatch_waiter *waiters;	/**< The contexts waiting for a free request. */
+	bool stop;								/**< Flag to stop the worker contexts. */
+};
+
+
+int cmd_dispatch_init (struct cmd_dispatch *dispatch, struct cmd_dispatch_request *requests,
+	size_t count);
+void cmd_dispatch_release (struct cmd_dispatch *dispatch);
+
+int cmd_dispatch_submit (struct cmd_dispatch *dispatch, struct mctp_interface *mctp,
+	const struct cmd_interface_msg *request, uint8_t response_addr, uint8_t source_addr,
+	uint8_t msg_tag, uint8_t cmd_set);
+
+int cmd_dispatch_process_next (struct cmd_dispatch *dispatch);
+void cmd_dispatch_run (struct cmd_dispatch *dispatch);
+void cmd_dispatch_stop (struct cmd_dispatch *dispatch);
+
+
+#define	CMD_DISPATCH_ERROR(code)		ROT_ERROR (ROT_MODULE_CMD_DISPATCH, code)
+
+/**
+ * Error codes that can be generated by a command dispatch queue.
+ */
+enum {
+	CMD_DISPATCH_INVALID_ARGUMENT = CMD_DISPATCH_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	CMD_DISPATCH_NO_MEMORY = CMD_DISPATCH_ERROR (0x01),			/**< Memory allocation failed. */
+	CMD_DISPATCH_STOPPED = CMD_DISPATCH_ERROR (0x02),			/**< The queue is no longer accepting requests. */
+	CMD_DISPATCH_MSG_TOO_LARGE = CMD_DISPATCH_ERROR (0x03),		/**< The request does not fit in the request buffer. */
+};
+
+
+#endif /* CMD_DISPATCH_H_ */
@@ -81,19 +81,86 @@ static int session_manager_get_paired_key_index (struct session_manager *session
 }
 
 /**
- * Find AES session key for requested EID then set it in the AES engine
+ * Discard the cached state of any AES engine that is holding the key for a session.  This must be
+ * called any time the key for a session changes.
+ *
+ * @param session Session manager instance to utilize.
+ * @param entry The session whose key is changing.
+ */
+static void session_manager_unload_key (struct session_manager *session,
+	struct session_manager_entry *entry)
+{
+	size_t i;
+
+	for (i = 0; i < session->num_key_slots; i++) {
+		if (session->key_slots[i].loaded_key == entry) {
+			session->key_slots[i].loaded_key = NULL;
+		}
+	}
+}
+
+/**
+ * Find the key slot to use for a session.  This will be the slot that already has the key for the
+ * session loaded, if there is one.  Otherwise, it is an empty slot or the least recently used slot.
+ *
+ * @param session Session manager instance to utilize.
+ * @param entry The session that needs a key slot.
+ * @param loaded Output indicating if the session key is already loaded in the slot.
+ *
+ * @return The key slot to use for the session.
+ */
+static struct session_manager_key_slot* session_manager_find_key_slot (
+	struct session_manager *session, struct session_manager_entry *entry, bool *loaded)
+{
+	struct session_manager_key_slot *slot;
+	struct session_manager_key_slot *lru = NULL;
+	size_t i;
+
+	for (i = 0; i < session->num_key_slots; i++) {
+		slot = &session->key_slots[i];
+
+		if ((slot->loaded_key == entry) && (slot->loaded_generation == slot->aes->key_generation)) {
+			*loaded = true;
+			return slot;
+		}
+
+		if (lru == NULL) {
+			lru = slot;
+		}
+		else if (lru->loaded_key != NULL) {
+			/* Prefer empty slots, then the slot that has gone the longest without being used.  The
+			 * age of each slot is compared so the use counter is allowed to wrap. */
+			if ((slot->loaded_key == NULL) ||
+				((session->key_use - slot->last_use) > (session->key_use - lru->last_use))) {
+				lru = slot;
+			}
+		}
+	}
+
+	*loaded = false;
+	return lru;
+}
+
+/**
+ * Find AES session key for requested EID then set it in an AES engine.  If the key for the session
+ * is already set in one of the AES engines and no other key has been set in that engine since, it
+ * will not be set again.
  *
  * @param session Session manager instance to utilize.
  * @param eid Device EID.
  * @param entry points to requested session container if exists
+ * @param aes Output for the AES engine that holds the session key.
  *
  * @return Completion status, 0 if success or an error code.
  */
 static int session_manager_set_key (struct session_manager *session, uint8_t eid,
-	struct session_manager_entry **entry)
+	struct session_manager_entry **entry, struct aes_engine **aes)
 {
 	struct session_manager_entry *curr_session;
-	int status;
+	struct session_manager_key_slot *slot;
+	uint32_t generation;
+	bool loaded;
+	int status = 0;
 
 	curr_session = session_manager_get_session (session, eid);
 	if (curr_session == NULL) {
@@ -103,12 +170,28 @@ static int session_manager_set_key (struct session_manager *session, uint8_t eid
 		return SESSION_MANAGER_SESSION_NOT_ESTABLISHED;
 	}
 
-	status = session->aes->set_key (session->aes, curr_session->session_key,
-		sizeof (curr_session->session_key));
+	slot = session_manager_find_key_slot (session, curr_session, &loaded);
+	if (!loaded) {
+		slot->loaded_key = NULL;
+		generation = slot->aes->key_generation;
+
+		status = slot->aes->set_key (slot->aes, curr_session->session_key,
+			sizeof (curr_session->session_key));
+
+		/* An engine that does not update the key generation can't report key changes made by other
+		 * modules, so the key must be set for every message. */
+		if ((status == 0) && (slot->aes->key_generation != generation)) {
+			slot->loaded_key = curr_session;
+			slot->loaded_generation = slot->aes->key_generation;
+		}
+	}
+
+	slot->last_use = ++session->key_use;
 
 	if (entry) {
 		*entry = curr_session;
 	}
+	*aes = slot->aes;
 
 	return status;
 }
@@ -193,6 +276,7 @@ int session_manager_get_pairing_state (struct session_manager *session, uint8_t
 int session_manager_decrypt_message (struct session_manager *session,
 	struct cmd_interface_msg *request)
 {
+	struct aes_engine *aes;
 	uint8_t *payload;
 	size_t payload_len;
 	size_t buffer_len;
@@ -218,14 +302,14 @@ int session_manager_decrypt_message (struct session_manager *session,
 		SESSION_MANAGER_TRAILER_LEN;
 	buffer_len = request->max_response - CERBERUS_PROTOCOL_HEADER_SIZE_NO_ID;
 
-	status = session_manager_set_key (session, request->source_eid, NULL);
+	status = session_manager_set_key (session, request->source_eid, NULL, &aes);
 	if (status != 0) {
 		return status;
 	}
 
 	request->length -= SESSION_MANAGER_TRAILER_LEN;
 
-	return session->aes->decrypt_data (session->aes, payload, payload_len, &payload[payload_len],
+	return aes->decrypt_data (aes, payload, payload_len, &payload[payload_len],
 		&payload[payload_len + CERBERUS_PROTOCOL_AES_GCM_TAG_LEN], CERBERUS_PROTOCOL_AES_IV_LEN,
 		payload, buffer_len);
 }
@@ -248,6 +332,7 @@ int session_manager_encrypt_message (struct session_manager *session,
 	size_t buffer_len;
 	int status;
 	struct session_manager_entry *curr_session;
+	struct aes_engine *aes;
 
 	if ((session == NULL) || (request == NULL)) {
 		return SESSION_MANAGER_INVALID_ARGUMENT;
@@ -266,7 +351,7 @@ int session_manager_encrypt_message (struct session_manager *session,
 	buffer_len = request->max_response - CERBERUS_PROTOCOL_HEADER_SIZE_NO_ID;
 	aes_iv = &payload[payload_len + CERBERUS_PROTOCOL_AES_GCM_TAG_LEN];
 
-	status = session_manager_set_key (session, request->source_eid, &curr_session);
+	status = session_manager_set_key (session, request->source_eid, &curr_session, &aes);
 	if (status != 0) {
 		return status;
 	}
@@ -278,7 +363,7 @@ int session_manager_encrypt_message (struct session_manager *session,
 
 	memcpy (aes_iv, curr_session->aes_init_vector, CERBERUS_PROTOCOL_AES_IV_LEN);
 
-	status = session->aes->encrypt_data (session->aes, payload, payload_len, aes_iv,
+	status = aes->encrypt_data (aes, payload, payload_len, aes_iv,
 		CERBERUS_PROTOCOL_AES_IV_LEN, payload, buffer_len - SESSION_MANAGER_TRAILER_LEN,
 		&payload[payload_len],
 		CERBERUS_PROTOCOL_AES_GCM_TAG_LEN);
@@ -321,6 +406,8 @@ int session_manager_add_session (struct session_manager *session, uint8_t eid,
 		}
 	}
 
+	session_manager_unload_key (session, curr_session);
+
 	memcpy (curr_session->device_nonce, device_nonce, SESSION_MANAGER_NONCE_LEN);
 	memcpy (curr_session->cerberus_nonce, cerberus_nonce, SESSION_MANAGER_NONCE_LEN);
 	memset (curr_session->aes_init_vector, 0, CERBERUS_PROTOCOL_AES_IV_LEN);
@@ -403,6 +490,7 @@ int session_manager_reset_session (struct session_manager *session, uint8_t eid,
 		}
 	}
 
+	session_manager_unload_key (session, req_session);
 	memset (req_session, 0, sizeof (struct session_manager_entry));
 
 	req_session->session_state = SESSION_STATE_UNUSED;
@@ -534,6 +622,7 @@ int session_manager_setup_paired_session (struct session_manager *session, uint8
 	}
 
 	memcpy (label, req_session->session_key, sizeof (label));
+	session_manager_unload_key (session, req_session);
 
 	status = kdf_nist800_108_counter_mode (session->hash, HMAC_SHA256, pairing_key,
 		sizeof (pairing_key), label, sizeof (label), NULL, 0, req_session->session_key,
@@ -627,6 +716,9 @@ int session_manager_init (struct session_manager *session, struct aes_engine *ae
 	memset (session, 0, sizeof (struct session_manager));
 
 	session->aes = aes;
+	session->default_slot.aes = aes;
+	session->key_slots = &session->default_slot;
+	session->num_key_slots = 1;
 	session->hash = hash;
 	session->riot = riot;
 	session->num_sessions = num_sessions;
@@ -652,6 +744,49 @@ int session_manager_init (struct session_manager *session, struct aes_engine *ae
 	return 0;
 }
 
+/**
+ * Provide additional AES engines to the session manager so the keys for multiple sessions can remain
+ * loaded at the same time.  When a session key is needed that is not already loaded, it is set in
+ * an unused key slot or the key slot that was least recently used.
+ *
+ * The AES engine provided during initialization is not used once key slots have been enabled,
+ * unless it is also one of the key slot engines.
+ *
+ * @param session Session manager instance to update.
+ * @param slots Storage for the key slots.  This must remain valid for the lifetime of the session
+ * manager.
+ * @param aes The list of AES engines to use for the key slots.  Each engine will be assigned to
+ * the key slot at the same index.
+ * @param count The number of key slots.
+ *
+ * @return 0 if the key slots were enabled successfully or an error code.
+ */
+int session_manager_enable_key_slots (struct session_manager *session,
+	struct session_manager_key_slot *slots, struct aes_engine *const *aes, size_t count)
+{
+	size_t i;
+
+	if ((session == NULL) || (slots == NULL) || (aes == NULL) || (count == 0)) {
+		return SESSION_MANAGER_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (aes[i] == NULL) {
+			return SESSION_MANAGER_INVALID_ARGUMENT;
+		}
+	}
+
+	memset (slots, 0, sizeof (struct session_manager_key_slot) * count);
+	for (i = 0; i < count; i++) {
+		slots[i].aes = aes[i];
+	}
+
+	session->key_slots = slots;
+	session->num_key_slots = count;
+
+	return 0;
+}
+
 /**
  * Release session manager
  *
@@ -53,9 +53,26 @@ struct session_manager_entry {
 	uint8_t aes_init_vector[CERBERUS_PROTOCOL_AES_IV_LEN];	/**< AES Initialization vector used in encryption */
 };
 
+/**
+ * An AES engine used to hold the key for one session at a time.
+ */
+struct session_manager_key_slot {
+	struct aes_engine *aes;						/**< AES engine for the key slot */
+	struct session_manager_entry *loaded_key;	/**< Session whose key is currently set in the AES engine */
+	uint32_t loaded_generation;					/**< AES engine key generation when the session key was set */
+	uint32_t last_use;							/**< Key slot use counter when the slot was last used */
+};
+
 /**
  * Module which holds engines needed for session manager operation and caches session keys. Each
  * instance is intended to be dedicated to a single command interface.
+ *
+ * The session manager tracks which session key is set in each AES engine it can use, so messages
+ * for a session with a loaded key do not need to reload the key.  By default, there is a single
+ * AES engine, so only the last session used keeps its key loaded.  Additional engines can be
+ * provided as key slots to keep the keys for multiple sessions loaded, with the least recently
+ * used slot being replaced when a new key is needed.  AES engines can be shared with other
+ * modules, since a change in the engine key generation causes the key to be set again.
  */
 struct session_manager {
 	/**
@@ -176,6 +193,10 @@ struct session_manager {
 	const uint8_t *pairing_eids;						/**< List of supported devices for pairing mode */
 	bool sessions_table_preallocated;					/**< Flag indicating if session tables were provided by caller */
 	const struct keystore *store;						/**< Keystore used to persist pairing keys */
+	struct session_manager_key_slot default_slot;		/**< Key slot for the AES engine used by default */
+	struct session_manager_key_slot *key_slots;			/**< Key slots used to hold session keys */
+	size_t num_key_slots;								/**< Total number of key slots */
+	uint32_t key_use;									/**< Counter to track the least recently used key slot */
 };
 
 
@@ -186,6 +207,9 @@ int session_manager_init (struct session_manager *session, struct aes_engine *ae
 	size_t num_pairing_eids, const struct keystore *store);
 void session_manager_release (struct session_manager *session);
 
+int session_manager_enable_key_slots (struct session_manager *session,
+	struct session_manager_key_slot *slots, struct aes_engine *const *aes, size_t count);
+
 int session_manager_add_session (struct session_manager *session, uint8_t eid,
 	const uint8_t *device_nonce, const uint8_t *cerberus_nonce);
 int session_manager_decrypt_message (struct session_manager *session,
@@ -23,6 +23,10 @@
 /**
  * A platform-independent API for encrypting data using AES.  AES engine instances are not
  * guaranteed to be thread-safe.
+ *
+ * An engine may be shared by multiple modules, each setting its own key before use.  Modules that
+ * avoid setting the same key again must check the key generation to detect when a different key
+ * has been set by another module.
  */
 struct aes_engine {
 	/**
@@ -78,6 +82,8 @@ struct aes_engine {
 	int (*decrypt_data) (struct aes_engine *engine, const uint8_t *ciphertext, size_t length,
 		const uint8_t *tag, const uint8_t *iv, size_t iv_length, uint8_t *plaintext,
 		size_t out_length);
+
+	uint32_t key_generation;	/**< Counter incremented by the engine on every call to set_key. */
 };
 
 
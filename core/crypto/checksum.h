@@ -7,10 +7,36 @@
 #include <stdint.h>
 
 
+/**
+ * Calculate SMBus CRC8 values 8 bytes at a time using sliced lookup tables.  This speeds up the
+ * calculation for full size packets at the cost of an additional 1792 bytes of constant data.  Set
+ * to 0 to process one byte at a time using a single lookup table.
+ */
+#ifndef CHECKSUM_SMBUS_CRC8_SLICE_BY_8
+#define	CHECKSUM_SMBUS_CRC8_SLICE_BY_8		1
+#endif
+
+
 uint8_t checksum_crc8 (uint8_t smbus_addr, const uint8_t *data, uint8_t len);
 
 uint8_t checksum_init_smbus_crc8 (uint8_t smbus_addr);
 uint8_t checksum_update_smbus_crc8 (uint8_t crc, const uint8_t *data, uint8_t len);
+uint8_t checksum_sw_update_smbus_crc8 (uint8_t crc, const uint8_t *data, uint8_t len);
+
+#ifdef CHECKSUM_ENABLE_HW_SMBUS_CRC8
+/**
+ * Continue an SMBus CRC8 calculation using a hardware CRC unit.  Platforms that define
+ * CHECKSUM_ENABLE_HW_SMBUS_CRC8 must provide this function, and all SMBus CRC8 updates will be
+ * passed to it.  The data buffer will never be null.
+ *
+ * @param crc The initial CRC8 value to use for the calculation.
+ * @param data Buffer that contains the data to use for the calculation.
+ * @param len The number of bytes in the buffer.
+ *
+ * @return The resulting CRC8.
+ */
+uint8_t checksum_hw_update_smbus_crc8 (uint8_t crc, const uint8_t *data, uint8_t len);
+#endif
 
 
 #endif //CHECKSUM_H_
@@ -14,6 +14,14 @@
 #define	FLASH_REGION_OFFSET(x, size)	((x) & ((size) - 1))
 
 
+/**
+ * Defines a single region of flash memory.
+ */
+struct flash_region {
+	uint32_t start_addr;	/**< The starting address of the memory region. */
+	size_t length;			/**< The size of the region. */
+};
+
 /**
  * API for interfacing with a flash device.
  */
@@ -40,6 +48,24 @@ struct flash {
 	 */
 	int (*read) (const struct flash *flash, uint32_t address, uint8_t *data, size_t length);
 
+	/**
+	 * Read multiple regions of flash as a single operation.  The data for each region is placed in
+	 * the buffer immediately after the data for the previous region.
+	 *
+	 * This is optional and can be null if the flash device has no native support for reading
+	 * multiple regions.  Callers must fall back to reading each region with read in this case.
+	 *
+	 * @param flash The flash to read from.
+	 * @param regions The list of flash regions to read.
+	 * @param count The number of regions in the list.
+	 * @param data The buffer to hold the data that has been read.
+	 * @param length The size of the data buffer.
+	 *
+	 * @return 0 if all regions were read from flash or an error code.
+	 */
+	int (*read_regions) (const struct flash *flash, const struct flash_region *regions,
+		size_t count, uint8_t *data, size_t length);
+
 	/**
 	 * Get the size of a flash page for write operations.
 	 *
@@ -175,6 +175,21 @@ struct flash_master {
 	 * ROT_IS_ERROR to check the return value.
 	 */
 	int (*set_spi_clock_frequency) (const struct flash_master *spi, uint32_t freq);
+
+	/**
+	 * Submit a list of transfers to be executed back to back by the SPI master.  The transfers are
+	 * executed in order and processing stops at the first transfer that fails.
+	 *
+	 * This is optional and can be null if the SPI master has no native support for batching
+	 * transfers.  Callers must fall back to submitting each transfer with xfer in this case.
+	 *
+	 * @param spi The SPI master to use to execute the transfers.
+	 * @param xfer The list of transfers to execute.
+	 * @param count The number of transfers in the list.
+	 *
+	 * @return 0 if all transfers were executed successfully or an error code.
+	 */
+	int (*xfer_batch) (const struct flash_master *spi, const struct flash_xfer *xfer, size_t count);
 };
 
 
@@ -0,0 +1,355 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "flash_queue.h"
+
+
+/**
+ * Initialize a queue for executing flash operations.  The queue does not process any requests until
+ * a worker context is running flash_queue_run or requests are manually processed with
+ * flash_queue_process_next.
+ *
+ * @param queue The queue to initialize.
+ * @param flash The flash device that will execute the queued requests.
+ *
+ * @return 0 if the queue was initialized successfully or an error code.
+ */
+int flash_queue_init (struct flash_queue *queue, const struct flash *flash)
+{
+	int status;
+
+	if ((queue == NULL) || (flash == NULL)) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	memset (queue, 0, sizeof (struct flash_queue));
+
+	status = platform_mutex_init (&queue->lock);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_semaphore_init (&queue->pending);
+	if (status != 0) {
+		goto exit_mutex;
+	}
+
+	queue->flash = flash;
+
+	return 0;
+
+exit_mutex:
+	platform_mutex_free (&queue->lock);
+	return status;
+}
+
+/**
+ * Release the resources used by a flash operation queue.  The worker context must be stopped before
+ * the queue is released.
+ *
+ * @param queue The queue to release.
+ */
+void flash_queue_release (struct flash_queue *queue)
+{
+	if (queue != NULL) {
+		platform_semaphore_free (&queue->pending);
+		platform_mutex_free (&queue->lock);
+	}
+}
+
+/**
+ * Submit a request to be executed by the flash queue.  Requests are executed in the order they are
+ * submitted.
+ *
+ * @param queue The queue to add the request to.
+ * @param request The request to execute.  The request must not be modified until it has
+ * completed.
+ *
+ * @return 0 if the request was added to the queue or an error code.
+ */
+int flash_queue_submit (struct flash_queue *queue, struct flash_queue_request *request)
+{
+	if ((queue == NULL) || (request == NULL)) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	if (request->op >= NUM_FLASH_QUEUE_OPERATIONS) {
+		return FLASH_QUEUE_UNKNOWN_OPERATION;
+	}
+
+	if (((request->op == FLASH_QUEUE_OP_READ) || (request->op == FLASH_QUEUE_OP_WRITE)) &&
+		(request->data == NULL)) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&queue->lock);
+
+	if (queue->stop) {
+		platform_mutex_unlock (&queue->lock);
+		return FLASH_QUEUE_STOPPED;
+	}
+
+	request->status = 0;
+	request->done = false;
+	request->next = NULL;
+
+	if (queue->tail != NULL) {
+		queue->tail->next = request;
+	}
+	else {
+		queue->head = request;
+	}
+	queue->tail = request;
+
+	platform_mutex_unlock (&queue->lock);
+
+	return platform_semaphore_post (&queue->pending);
+}
+
+/**
+ * Check if a submitted request has completed.
+ *
+ * @param queue The queue the request was submitted to.
+ * @param request The request to check.
+ *
+ * @return 1 if the request has completed, 0 if it has not, or an error code.
+ */
+int flash_queue_is_complete (struct flash_queue *queue, const struct flash_queue_request *request)
+{
+	int status;
+
+	if ((queue == NULL) || (request == NULL)) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&queue->lock);
+	status = (request->done) ? 1 : 0;
+	platform_mutex_unlock (&queue->lock);
+
+	return status;
+}
+
+/**
+ * Wait for a submitted request to complete.
+ *
+ * @param queue The queue the request was submitted to.
+ * @param request The request to wait for.
+ * @param ms_timeout The maximum amount of time to wait for completion, in milliseconds.  A timeout
+ * of 0 will wait forever.
+ *
+ * @return The completion status of the request or an error code if the request did not complete.
+ */
+int flash_queue_wait (struct flash_queue *queue, const struct flash_queue_request *request,
+	uint32_t ms_timeout)
+{
+	struct flash_queue_waiter waiter;
+	struct flash_queue_waiter **pos;
+	platform_clock timeout;
+	uint32_t remaining = 0;
+	int status;
+
+	if ((queue == NULL) || (request == NULL)) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	if (ms_timeout != 0) {
+		status = platform_init_timeout (ms_timeout, &timeout);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	platform_mutex_lock (&queue->lock);
+
+	if (request->done) {
+		status = request->status;
+		goto exit;
+	}
+
+	status = platform_semaphore_init (&waiter.completed);
+	if (status != 0) {
+		goto exit;
+	}
+
+	waiter.request = request;
+	waiter.next = queue->waiters;
+	queue->waiters = &waiter;
+
+	while (!request->done) {
+		if (ms_timeout != 0) {
+			status = platform_get_timeout_remaining (&timeout, &remaining);
+			if (status != 0) {
+				goto remove;
+			}
+
+			if (remaining == 0) {
+				status = FLASH_QUEUE_WAIT_TIMEOUT;
+				goto remove;
+			}
+		}
+
+		platform_mutex_unlock (&queue->lock);
+
+		status = platform_semaphore_wait (&waiter.completed, remaining);
+
+		platform_mutex_lock (&queue->lock);
+
+		if (ROT_IS_ERROR (status)) {
+			goto remove;
+		}
+	}
+
+	status = request->status;
+
+remove:
+	/* Notifications are only posted while holding the queue lock, so once the waiter is removed,
+	 * nothing else will access it. */
+	pos = &queue->waiters;
+	while (*pos != &waiter) {
+		pos = &(*pos)->next;
+	}
+	*pos = waiter.next;
+
+	platform_semaphore_free (&waiter.completed);
+
+exit:
+	platform_mutex_unlock (&queue->lock);
+	return status;
+}
+
+/**
+ * Execute a single flash request.
+ *
+ * @param flash The flash device to use for the request.
+ * @param request The request to execute.
+ *
+ * @return 0 if the request was successful or an error code.
+ */
+static int flash_queue_execute (const struct flash *flash, struct flash_queue_request *request)
+{
+	int status;
+
+	switch (request->op) {
+		case FLASH_QUEUE_OP_READ:
+			return flash->read (flash, request->address, request->data, request->length);
+
+		case FLASH_QUEUE_OP_WRITE:
+			status = flash->write (flash, request->address, request->data, request->length);
+			if (ROT_IS_ERROR (status)) {
+				return status;
+			}
+
+			return (status == (int) request->length) ? 0 : FLASH_QUEUE_INCOMPLETE_WRITE;
+
+		case FLASH_QUEUE_OP_SECTOR_ERASE:
+			return flash->sector_erase (flash, request->address);
+
+		case FLASH_QUEUE_OP_BLOCK_ERASE:
+			return flash->block_erase (flash, request->address);
+
+		default:
+			return FLASH_QUEUE_UNKNOWN_OPERATION;
+	}
+}
+
+/**
+ * Execute the next request in the queue, if there is one.  This is called from the worker context,
+ * but can also be called directly on systems that do not run a dedicated worker.
+ *
+ * @param queue The queue to process.
+ *
+ * @return 1 if a request was executed, 0 if the queue is empty, or an error code.
+ */
+int flash_queue_process_next (struct flash_queue *queue)
+{
+	struct flash_queue_request *request;
+	struct flash_queue_waiter *waiter;
+
+	if (queue == NULL) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&queue->lock);
+
+	request = queue->head;
+	if (request != NULL) {
+		queue->head = request->next;
+		if (queue->head == NULL) {
+			queue->tail = NULL;
+		}
+	}
+
+	platform_mutex_unlock (&queue->lock);
+
+	if (request == NULL) {
+		return 0;
+	}
+
+	request->status = flash_queue_execute (queue->flash, request);
+
+	/* Run the callback before marking the request done, since a waiting context is free to reuse
+	 * the request as soon as it sees the completion. */
+	if (request->complete != NULL) {
+		request->complete (request);
+	}
+
+	platform_mutex_lock (&queue->lock);
+
+	request->done = true;
+
+	for (waiter = queue->waiters; waiter != NULL; waiter = waiter->next) {
+		if (waiter->request == request) {
+			platform_semaphore_post (&waiter->completed);
+		}
+	}
+
+	platform_mutex_unlock (&queue->lock);
+
+	return 1;
+}
+
+/**
+ * Worker loop for executing queued flash requests.  This does not return until the queue has been
+ * stopped.  All requests submitted before the queue was stopped will be executed before returning.
+ *
+ * @param queue The queue to process.
+ */
+void flash_queue_run (struct flash_queue *queue)
+{
+	bool stop;
+
+	if (queue == NULL) {
+		return;
+	}
+
+	do {
+		platform_semaphore_wait (&queue->pending, 0);
+
+		/* Check for a stop request before processing so no accepted request is left behind. */
+		platform_mutex_lock (&queue->lock);
+		stop = queue->stop;
+		platform_mutex_unlock (&queue->lock);
+
+		while (flash_queue_process_next (queue) == 1);
+	} while (!stop);
+}
+
+/**
+ * Stop the queue from accepting new requests and signal the worker context to exit once all
+ * outstanding requests have been executed.
+ *
+ * @param queue The queue to stop.
+ */
+void flash_queue_stop (struct flash_queue *queue)
+{
+	if (queue != NULL) {
+		platform_mutex_lock (&queue->lock);
+		queue->stop = true;
+		platform_mutex_unlock (&queue->lock);
+
+		platform_semaphore_post (&queue->pending);
+	}
+}
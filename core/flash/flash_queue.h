@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_QUEUE_H_
+#define FLASH_QUEUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "status/rot_status.h"
+#include "platform_api.h"
+#include "flash.h"
+
+
+/**
+ * Flash operations that can be executed through the queue.
+ */
+enum flash_queue_operation {
+	FLASH_QUEUE_OP_READ = 0,		/**< Read data from flash. */
+	FLASH_QUEUE_OP_WRITE,			/**< Write data to flash. */
+	FLASH_QUEUE_OP_SECTOR_ERASE,	/**< Erase a single sector of flash. */
+	FLASH_QUEUE_OP_BLOCK_ERASE,		/**< Erase a single block of flash. */
+	NUM_FLASH_QUEUE_OPERATIONS		/**< Number of supported flash operations. */
+};
+
+/**
+ * A single flash operation submitted to the queue.  The memory for the request, including any data
+ * buffer, is owned by the submitter and must remain valid until the request has completed.
+ */
+struct flash_queue_request {
+	enum flash_queue_operation op;		/**< The flash operation to execute. */
+	uint32_t address;					/**< The flash address for the operation. */
+	uint8_t *data;						/**< Buffer for data to read or write.  Not used for erase. */
+	size_t length;						/**< Length of the data buffer. */
+
+	/**
+	 * Optional notification that the request has completed.  This is called from the context
+	 * processing the queue, so it must not block and must not wait for other queued requests.
+	 *
+	 * @param request The request that completed.  The request status is already set.
+	 */
+	void (*complete) (struct flash_queue_request *request);
+
+	void *context;						/**< Caller context for the completion callback. */
+	int status;							/**< Result of the operation.  Valid after completion. */
+	bool done;							/**< Flag indicating the request has completed. */
+	struct flash_queue_request *next;	/**< Next request in the queue. */
+};
+
+/**
+ * A context waiting for a request to complete.  Each waiter has its own notification, so completion
+ * does not depend on the platform providing counting semaphores.
+ */
+struct flash_queue_waiter {
+	const struct flash_queue_request *request;	/**< The request being waited on. */
+	platform_semaphore completed;				/**< Notification that the request has completed. */
+	struct flash_queue_waiter *next;			/**< The next waiting context. */
+};
+
+/**
+ * A queue of flash operations executed in order by a separate worker context.  This allows tasks to
+ * continue processing while flash writes and erases are in progress.
+ */
+struct flash_queue {
+	const struct flash *flash;			/**< The flash device that executes queued requests. */
+	platform_mutex lock;				/**< Synchronization for queue state. */
+	platform_semaphore pending;			/**< Notification that requests have been submitted. */
+	struct flash_queue_request *head;	/**< The next request to execute. */
+	struct flash_queue_request *tail;	/**< The last request that was submitted. */
+	struct flash_queue_waiter *waiters;	/**< The contexts waiting for requests to complete. */
+	bool stop;							/**< Flag to stop the worker context. */
+};
+
+
+int flash_queue_init (struct flash_queue *queue, const struct flash *flash);
+void flash_queue_release (struct flash_queue *queue);
+
+int flash_queue_submit (struct flash_queue *queue, struct flash_queue_request *request);
+int flash_queue_is_complete (struct flash_queue *queue, const struct flash_queue_request *request);
+int flash_queue_wait (struct flash_queue *queue, const struct flash_queue_request *request,
+	uint32_t ms_timeout);
+
+int flash_queue_process_next (struct flash_queue *queue);
+void flash_queue_run (struct flash_queue *queue);
+void flash_queue_stop (struct flash_queue *queue);
+
+
+#define	FLASH_QUEUE_ERROR(code)		ROT_ERROR (ROT_MODULE_FLASH_QUEUE, code)
+
+/**
+ * Error codes that can be generated by a flash operation queue.
+ */
+enum {
+	FLASH_QUEUE_INVALID_ARGUMENT = FLASH_QUEUE_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	FLASH_QUEUE_NO_MEMORY = FLASH_QUEUE_ERROR (0x01),			/**< Memory allocation failed. */
+	FLASH_QUEUE_UNKNOWN_OPERATION = FLASH_QUEUE_ERROR (0x02),	/**< The request specifies an unsupported operation. */
+	FLASH_QUEUE_INCOMPLETE_WRITE = FLASH_QUEUE_ERROR (0x03),	/**< Not all data was written to flash. */
+	FLASH_QUEUE_WAIT_TIMEOUT = FLASH_QUEUE_ERROR (0x04),		/**< The request did not complete in the allotted time. */
+	FLASH_QUEUE_STOPPED = FLASH_QUEUE_ERROR (0x05),				/**< The queue is no longer accepting requests. */
+};
+
+
+#endif /* FLASH_QUEUE_H_ */
@@ -15,6 +15,39 @@
 #define	FLASH_STORE_MAX_DATA_SIZE		((64 * 1024) - 1)
 
 
+/**
+ * Mark the cached header information for a block as no longer matching the flash contents.
+ *
+ * @param flash The flash store that manages contiguous blocks of memory.
+ * @param id Block ID to invalidate.
+ */
+static void flash_store_contiguous_blocks_invalidate_index (
+	const struct flash_store_contiguous_blocks *flash, int id)
+{
+	if (flash->state->index) {
+		flash->state->index[id].flags = 0;
+	}
+}
+
+/**
+ * Update the cached header information for a block after new data has been written.
+ *
+ * @param flash The flash store that manages contiguous blocks of memory.
+ * @param id Block ID that was written.
+ * @param length Length of the data that was written.
+ */
+static void flash_store_contiguous_blocks_update_index (
+	const struct flash_store_contiguous_blocks *flash, int id, size_t length)
+{
+	if (flash->state->index) {
+		flash->state->index[id].length = length;
+		flash->state->index[id].header_len =
+			(flash->state->old_header) ? sizeof (uint16_t) : FLASH_STORE_HEADER_LENGTH;
+		flash->state->index[id].flags =
+			FLASH_STORE_BLOCK_INDEX_VALID | FLASH_STORE_BLOCK_INDEX_HAS_DATA;
+	}
+}
+
 /**
  * Verify that parameters are valid for writing to a flash data block.
  *
@@ -73,6 +106,8 @@ int flash_store_contiguous_blocks_write_common (const struct flash_store_contigu
 	}
 	offset = base_offset;
 
+	flash_store_contiguous_blocks_invalidate_index (flash, id);
+
 	status = flash_sector_erase_region (flash->flash, flash->base_addr + base_offset,
 		flash->state->block_size);
 	if (status != 0) {
@@ -246,6 +281,95 @@ int flash_store_contiguous_blocks_write_common (const struct flash_store_contigu
 		}
 	}
 
+	flash_store_contiguous_blocks_update_index (flash, id, length);
+
+	return 0;
+}
+
+/**
+ * Prepare a data block to be written incrementally by a derived type.  Any existing data in the
+ * block will be erased.  After all data has been written,
+ * flash_store_contiguous_blocks_finish_block_write must be called to complete the block.
+ *
+ * Incremental writes must only be used when flash pages can be programmed multiple times.
+ * Parameters must have been prevalidated.
+ *
+ * @param flash The flash where the data will be written.
+ * @param id Block ID of the data.
+ * @param data_addr Output for the flash address where the data should be written.
+ *
+ * @return 0 if the block is ready to be written or an error code.
+ */
+int flash_store_contiguous_blocks_start_block_write (
+	const struct flash_store_contiguous_blocks *flash, int id, uint32_t *data_addr)
+{
+	int offset;
+	int status;
+
+	offset = id * flash->state->block_size;
+	if (flash->decreasing) {
+		offset = -offset;
+	}
+
+	flash_store_contiguous_blocks_invalidate_index (flash, id);
+
+	status = flash_sector_erase_region (flash->flash, flash->base_addr + offset,
+		flash->state->block_size);
+	if (status != 0) {
+		return status;
+	}
+
+	*data_addr = flash->base_addr + offset;
+	if (flash->variable) {
+		*data_addr += (flash->state->old_header) ? sizeof (uint16_t) : FLASH_STORE_HEADER_LENGTH;
+	}
+
+	return 0;
+}
+
+/**
+ * Complete an incremental write to a data block.  For variable length storage, this writes the
+ * header that marks the block as containing valid data.
+ *
+ * @param flash The flash where the data was written.
+ * @param id Block ID of the data.
+ * @param length Length of the data that was written.
+ *
+ * @return 0 if the block was completed successfully or an error code.
+ */
+int flash_store_contiguous_blocks_finish_block_write (
+	const struct flash_store_contiguous_blocks *flash, int id, size_t length)
+{
+	int offset;
+	int status;
+
+	if (flash->variable) {
+		struct flash_store_header header = {
+			.header_len = FLASH_STORE_HEADER_LENGTH,
+			.marker = FLASH_STORE_HEADER_MARKER,
+			.length = length
+		};
+
+		offset = id * flash->state->block_size;
+		if (flash->decreasing) {
+			offset = -offset;
+		}
+
+		if (!flash->state->old_header) {
+			status = flash_write_and_verify (flash->flash, flash->base_addr + offset,
+				(uint8_t*) &header, sizeof (header));
+		}
+		else {
+			status = flash_write_and_verify (flash->flash, flash->base_addr + offset,
+				(uint8_t*) &header.length, sizeof (header.length));
+		}
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	flash_store_contiguous_blocks_update_index (flash, id, length);
+
 	return 0;
 }
 
@@ -329,6 +453,55 @@ static int flash_store_contiguous_blocks_read_header (
 	return 0;
 }
 
+/**
+ * Get the header on variable length data.  If the store has a block index with valid information
+ * for the block, no flash access is necessary.  Otherwise, the header is read from flash and the
+ * index is updated.
+ *
+ * @param flash The flash store that manages contiguous blocks of memory.
+ * @param id Block ID of the data.
+ * @param header Output for the header data.
+ *
+ * @return 0 if the header was retrieved and is valid or an error code.
+ */
+static int flash_store_contiguous_blocks_get_header (
+	const struct flash_store_contiguous_blocks *flash, int id, struct flash_store_header *header)
+{
+	struct flash_store_block_index *index = flash->state->index;
+	int offset;
+	int status;
+
+	if (index && (index[id].flags & FLASH_STORE_BLOCK_INDEX_VALID)) {
+		if (!(index[id].flags & FLASH_STORE_BLOCK_INDEX_HAS_DATA)) {
+			return FLASH_STORE_NO_DATA;
+		}
+
+		header->header_len = index[id].header_len;
+		header->length = index[id].length;
+
+		return 0;
+	}
+
+	offset = id * flash->state->block_size;
+	if (flash->decreasing) {
+		offset = -offset;
+	}
+
+	status = flash_store_contiguous_blocks_read_header (flash, offset, header);
+	if (index) {
+		if (status == 0) {
+			index[id].length = header->length;
+			index[id].header_len = header->header_len;
+			index[id].flags = FLASH_STORE_BLOCK_INDEX_VALID | FLASH_STORE_BLOCK_INDEX_HAS_DATA;
+		}
+		else if (status == FLASH_STORE_NO_DATA) {
+			index[id].flags = FLASH_STORE_BLOCK_INDEX_VALID;
+		}
+	}
+
+	return status;
+}
+
 /**
  * Read a block of data from flash.
  *
@@ -370,7 +543,7 @@ int flash_store_contiguous_blocks_read_common (const struct flash_store_contiguo
 	if (flash->variable) {
 		struct flash_store_header header;
 
-		status = flash_store_contiguous_blocks_read_header (flash, offset, &header);
+		status = flash_store_contiguous_blocks_get_header (flash, id, &header);
 		if (status != 0) {
 			return status;
 		}
@@ -404,6 +577,55 @@ int flash_store_contiguous_blocks_read_common (const struct flash_store_contiguo
 	return 0;
 }
 
+/**
+ * Get the location of the data stored in a block.
+ *
+ * @param flash The flash that contains the requested data.
+ * @param id Block ID of the data.
+ * @param data_addr Output for the flash address of the stored data.
+ * @param length Output for the length of the stored data.
+ *
+ * @return 0 if the data location was determined successfully or an error code.
+ */
+int flash_store_contiguous_blocks_get_data_address (
+	const struct flash_store_contiguous_blocks *flash, int id, uint32_t *data_addr,
+	size_t *length)
+{
+	int offset;
+	int status;
+
+	if ((flash == NULL) || (data_addr == NULL) || (length == NULL)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	if ((id < 0) || ((uint32_t) id >= flash->state->blocks)) {
+		return FLASH_STORE_UNSUPPORTED_ID;
+	}
+
+	offset = id * flash->state->block_size;
+	if (flash->decreasing) {
+		offset = -offset;
+	}
+
+	if (flash->variable) {
+		struct flash_store_header header;
+
+		status = flash_store_contiguous_blocks_get_header (flash, id, &header);
+		if (status != 0) {
+			return status;
+		}
+
+		offset += header.header_len;
+		*length = header.length;
+	}
+	else {
+		*length = flash->state->max_size;
+	}
+
+	*data_addr = flash->base_addr + offset;
+	return 0;
+}
+
 int flash_store_contiguous_blocks_read_no_hash (const struct flash_store *flash_store, int id,
 	uint8_t *data, size_t length)
 {
@@ -445,6 +667,7 @@ int flash_store_contiguous_blocks_read_with_hash (const struct flash_store *flas
 int flash_store_contiguous_blocks_erase (const struct flash_store *flash_store, int id)
 {
 	int offset;
+	int status;
 	const struct flash_store_contiguous_blocks *flash =
 		(const struct flash_store_contiguous_blocks*) flash_store;
 
@@ -461,8 +684,15 @@ int flash_store_contiguous_blocks_erase (const struct flash_store *flash_store,
 		offset = -offset;
 	}
 
-	return flash_sector_erase_region_and_verify (flash->flash, flash->base_addr + offset,
+	flash_store_contiguous_blocks_invalidate_index (flash, id);
+
+	status = flash_sector_erase_region_and_verify (flash->flash, flash->base_addr + offset,
 		flash->state->block_size);
+	if ((status == 0) && flash->state->index) {
+		flash->state->index[id].flags = FLASH_STORE_BLOCK_INDEX_VALID;
+	}
+
+	return status;
 }
 
 int flash_store_contiguous_blocks_erase_all (const struct flash_store *flash_store)
@@ -470,6 +700,8 @@ int flash_store_contiguous_blocks_erase_all (const struct flash_store *flash_sto
 	int offset = 0;
 	const struct flash_store_contiguous_blocks *flash =
 		(const struct flash_store_contiguous_blocks*) flash_store;
+	uint32_t i;
+	int status;
 
 	if (flash == NULL) {
 		return FLASH_STORE_INVALID_ARGUMENT;
@@ -479,8 +711,19 @@ int flash_store_contiguous_blocks_erase_all (const struct flash_store *flash_sto
 		offset = flash->state->block_size * (flash->state->blocks - 1);
 	}
 
-	return flash_sector_erase_region_and_verify (flash->flash, flash->base_addr - offset,
+	for (i = 0; i < flash->state->blocks; i++) {
+		flash_store_contiguous_blocks_invalidate_index (flash, i);
+	}
+
+	status = flash_optimal_erase_region_and_verify (flash->flash, flash->base_addr - offset,
 		flash->state->block_size * flash->state->blocks);
+	if ((status == 0) && flash->state->index) {
+		for (i = 0; i < flash->state->blocks; i++) {
+			flash->state->index[i].flags = FLASH_STORE_BLOCK_INDEX_VALID;
+		}
+	}
+
+	return status;
 }
 
 int flash_store_contiguous_blocks_get_data_length (const struct flash_store *flash_store, int id)
@@ -498,15 +741,9 @@ int flash_store_contiguous_blocks_get_data_length (const struct flash_store *fla
 
 	if (flash->variable) {
 		struct flash_store_header header;
-		int offset;
 		int status;
 
-		offset = id * flash->state->block_size;
-		if (flash->decreasing) {
-			offset = -offset;
-		}
-
-		status = flash_store_contiguous_blocks_read_header (flash, offset, &header);
+		status = flash_store_contiguous_blocks_get_header (flash, id, &header);
 		if (status != 0) {
 			return status;
 		}
@@ -533,15 +770,9 @@ int flash_store_contiguous_blocks_has_data_stored (const struct flash_store *fla
 
 	if (flash->variable) {
 		struct flash_store_header header;
-		int offset;
 		int status;
 
-		offset = id * flash->state->block_size;
-		if (flash->decreasing) {
-			offset = -offset;
-		}
-
-		status = flash_store_contiguous_blocks_read_header (flash, offset, &header);
+		status = flash_store_contiguous_blocks_get_header (flash, id, &header);
 		switch (status) {
 			case 0:
 				return 1;
@@ -957,3 +1188,52 @@ void flash_store_contiguous_blocks_use_length_only_header
 		store->state->old_header = true;
 	}
 }
+
+/**
+ * Enable an in-memory index of the headers for variable length data blocks.  Queries for the
+ * length or presence of data will be served from the index without needing to read flash, and
+ * reading data will not need to read the header from flash.  The index is kept up to date as data
+ * is written or erased through the flash store.
+ *
+ * The index is built by reading the header of every data block.  If a header cannot be read, that
+ * block will be read from flash the next time it is accessed.
+ *
+ * This must be called after the flash store has been initialized.  Fixed length storage never needs
+ * to read metadata from flash, so the index will not be used for those stores.
+ *
+ * @param store The flash storage to configure.
+ * @param index Buffer to use for the block index.  This must remain valid for the lifetime of the
+ * flash store.
+ * @param count The number of entries in the index buffer.  This must be at least the number of
+ * data blocks managed by the flash store.
+ *
+ * @return 0 if the block index was enabled successfully or an error code.
+ */
+int flash_store_contiguous_blocks_enable_block_index (
+	const struct flash_store_contiguous_blocks *store, struct flash_store_block_index *index,
+	size_t count)
+{
+	struct flash_store_header header;
+	uint32_t i;
+
+	if ((store == NULL) || (index == NULL)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	if (count < store->state->blocks) {
+		return FLASH_STORE_INSUFFICIENT_STORAGE;
+	}
+
+	if (!store->variable) {
+		return 0;
+	}
+
+	memset (index, 0, sizeof (struct flash_store_block_index) * store->state->blocks);
+	store->state->index = index;
+
+	for (i = 0; i < store->state->blocks; i++) {
+		flash_store_contiguous_blocks_get_header (store, i, &header);
+	}
+
+	return 0;
+}
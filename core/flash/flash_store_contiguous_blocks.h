@@ -26,6 +26,18 @@ struct flash_store_header {
 #define	FLASH_STORE_HEADER_LENGTH		(sizeof (struct flash_store_header))
 #define	FLASH_STORE_HEADER_MIN_LENGTH	4
 
+/**
+ * Cached information about the header for a single block of variable length data.
+ */
+struct flash_store_block_index {
+	uint16_t length;				/**< Length of the data stored in the block. */
+	uint8_t header_len;				/**< Length of the header on the stored data. */
+	uint8_t flags;					/**< Flags indicating the state of the cached information. */
+};
+
+#define	FLASH_STORE_BLOCK_INDEX_VALID		(1U << 0)	/**< The cached header matches flash contents. */
+#define	FLASH_STORE_BLOCK_INDEX_HAS_DATA	(1U << 1)	/**< The block contains valid data. */
+
 /**
  * Variable context for a flash store instance.
  */
@@ -39,6 +51,7 @@ struct flash_store_contiguous_blocks_state {
 	platform_mutex lock;		/**< Page buffer synchronization. */
 #endif
 	bool old_header;			/**< Flag indicating variable storage header only saves the length. */
+	struct flash_store_block_index *index;	/**< Optional cache of the variable storage headers. */
 };
 
 /**
@@ -81,6 +94,10 @@ void flash_store_contiguous_blocks_release (const struct flash_store_contiguous_
 void flash_store_contiguous_blocks_use_length_only_header (
 	struct flash_store_contiguous_blocks *store);
 
+int flash_store_contiguous_blocks_enable_block_index (
+	const struct flash_store_contiguous_blocks *store, struct flash_store_block_index *index,
+	size_t count);
+
 /* Internal functions for use by derived types. */
 int flash_store_contiguous_blocks_init_state_common (
 	const struct flash_store_contiguous_blocks *store, size_t block_count, size_t data_length,
@@ -99,5 +116,13 @@ int flash_store_contiguous_blocks_read_common (const struct flash_store_contiguo
 	int id, uint8_t *data, size_t length, uint8_t *extra_data, size_t extra_length,
 	size_t *out_length);
 
+int flash_store_contiguous_blocks_start_block_write (
+	const struct flash_store_contiguous_blocks *flash, int id, uint32_t *data_addr);
+int flash_store_contiguous_blocks_finish_block_write (
+	const struct flash_store_contiguous_blocks *flash, int id, size_t length);
+int flash_store_contiguous_blocks_get_data_address (
+	const struct flash_store_contiguous_blocks *flash, int id, uint32_t *data_addr,
+	size_t *length);
+
 
 #endif /* FLASH_STORE_CONTIGUOUS_BLOCKS_H_ */
@@ -7,6 +7,7 @@
 #include "platform_api.h"
 #include "flash_store_contiguous_blocks_encrypted.h"
 #include "flash_util.h"
+#include "common/common_math.h"
 
 
 /**
@@ -14,6 +15,404 @@
  */
 #define	FLASH_STORE_AES_IV_LENGTH		12
 
+/**
+ * Flag added to the chunk number when generating the IV for the last chunk of data.  This ensures
+ * that truncation of chunked data is detected.
+ */
+#define	FLASH_STORE_AES_LAST_CHUNK		(1U << 31)
+
+
+/**
+ * Get the number of chunks needed to encrypt data.
+ *
+ * @param length The length of the data.
+ * @param chunk_size The size of each chunk.
+ */
+#define	flash_store_contiguous_blocks_encrypted_chunk_count(length, chunk_size) \
+	(((length) + ((chunk_size) - 1)) / (chunk_size))
+
+
+/**
+ * Encrypt or decrypt a single chunk of data.  Each chunk uses a unique IV derived from the IV
+ * stored with the data block by adding the chunk number to the last four bytes.
+ *
+ * @param encrypted The flash store being accessed.
+ * @param iv The IV stored with the data block.
+ * @param chunk The chunk number being processed.
+ * @param last Flag indicating if this is the last chunk of data in the block.
+ * @param in Input data for the AES operation.
+ * @param out Output buffer for the AES operation.  This can be the same as the input buffer.
+ * @param length Length of the chunk.
+ * @param tag The GCM tag for the chunk.  This is an output for encryption and an input for
+ * decryption.
+ * @param decrypt Flag indicating the chunk should be decrypted.
+ *
+ * @return 0 if the chunk was processed successfully or an error code.
+ */
+static int flash_store_contiguous_blocks_encrypted_process_chunk (
+	const struct flash_store_contiguous_blocks_encrypted *encrypted, const uint8_t *iv,
+	uint32_t chunk, bool last, const uint8_t *in, uint8_t *out, size_t length, uint8_t *tag,
+	bool decrypt)
+{
+	uint8_t chunk_iv[FLASH_STORE_AES_IV_LENGTH];
+
+	if (last) {
+		chunk |= FLASH_STORE_AES_LAST_CHUNK;
+	}
+
+	memcpy (chunk_iv, iv, sizeof (chunk_iv));
+	chunk_iv[8] ^= (chunk >> 24);
+	chunk_iv[9] ^= (chunk >> 16);
+	chunk_iv[10] ^= (chunk >> 8);
+	chunk_iv[11] ^= chunk;
+
+	if (decrypt) {
+		return encrypted->aes->decrypt_data (encrypted->aes, in, length, tag, chunk_iv,
+			sizeof (chunk_iv), out, length);
+	}
+	else {
+		return encrypted->aes->encrypt_data (encrypted->aes, in, length, chunk_iv,
+			sizeof (chunk_iv), out, length, tag, AES_TAG_LENGTH);
+	}
+}
+
+#ifdef FLASH_STORE_SUPPORT_NO_PARTIAL_PAGE_WRITE
+/**
+ * Write chunked encrypted data to flash that does not support multiple writes to the same page.
+ * The entire block of data must be encrypted before it can be written.
+ *
+ * @param encrypted The flash store to write to.
+ * @param id Block ID of the data.
+ * @param data The data to write.
+ * @param length Length of the data.
+ *
+ * @return 0 if the data was written successfully or an error code.
+ */
+static int flash_store_contiguous_blocks_encrypted_write_chunked_buffered (
+	const struct flash_store_contiguous_blocks_encrypted *encrypted, int id, const uint8_t *data,
+	size_t length)
+{
+	size_t chunks = flash_store_contiguous_blocks_encrypted_chunk_count (length,
+		encrypted->chunk_size);
+	size_t extra_length = FLASH_STORE_AES_IV_LENGTH + (AES_TAG_LENGTH * chunks);
+	uint8_t *enc_data;
+	uint8_t *iv_tag;
+	size_t offset;
+	size_t chunk_len;
+	uint32_t chunk;
+	int status;
+
+	enc_data = platform_malloc (length + extra_length);
+	if (enc_data == NULL) {
+		return FLASH_STORE_NO_MEMORY;
+	}
+
+	iv_tag = &enc_data[length];
+
+	status = encrypted->rng->generate_random_buffer (encrypted->rng, FLASH_STORE_AES_IV_LENGTH,
+		iv_tag);
+	if (status != 0) {
+		goto exit;
+	}
+
+	for (chunk = 0, offset = 0; offset < length; chunk++, offset += chunk_len) {
+		chunk_len = min (encrypted->chunk_size, length - offset);
+
+		status = flash_store_contiguous_blocks_encrypted_process_chunk (encrypted, iv_tag, chunk,
+			((offset + chunk_len) == length), &data[offset], &enc_data[offset], chunk_len,
+			&iv_tag[FLASH_STORE_AES_IV_LENGTH + (AES_TAG_LENGTH * chunk)], false);
+		if (status != 0) {
+			goto exit;
+		}
+	}
+
+	status = flash_store_contiguous_blocks_write_common (&encrypted->base, id, enc_data, length,
+		iv_tag, extra_length);
+
+exit:
+	platform_free (enc_data);
+	return status;
+}
+#endif
+
+/**
+ * Write data to flash that is encrypted in chunks.  Each chunk is written to flash as soon as it
+ * has been encrypted, so only enough memory for a single chunk is needed.
+ *
+ * The IV is stored immediately after the encrypted data, followed by the tag for each chunk.
+ *
+ * @param encrypted The flash store to write to.
+ * @param id Block ID of the data.
+ * @param data The data to write.
+ * @param length Length of the data.
+ *
+ * @return 0 if the data was written successfully or an error code.
+ */
+static int flash_store_contiguous_blocks_encrypted_write_chunked (
+	const struct flash_store_contiguous_blocks_encrypted *encrypted, int id, const uint8_t *data,
+	size_t length)
+{
+	uint8_t *enc_data;
+	uint8_t iv[FLASH_STORE_AES_IV_LENGTH];
+	uint8_t tag[AES_TAG_LENGTH];
+	uint32_t data_addr;
+	uint32_t tag_addr;
+	size_t offset;
+	size_t chunk_len;
+	uint32_t chunk;
+	int status;
+
+#ifdef FLASH_STORE_SUPPORT_NO_PARTIAL_PAGE_WRITE
+	if (encrypted->base.state->page_buffer) {
+		return flash_store_contiguous_blocks_encrypted_write_chunked_buffered (encrypted, id, data,
+			length);
+	}
+#endif
+
+	enc_data = platform_malloc (min (encrypted->chunk_size, length));
+	if (enc_data == NULL) {
+		return FLASH_STORE_NO_MEMORY;
+	}
+
+	status = encrypted->rng->generate_random_buffer (encrypted->rng, sizeof (iv), iv);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = flash_store_contiguous_blocks_start_block_write (&encrypted->base, id, &data_addr);
+	if (status != 0) {
+		goto exit;
+	}
+
+	tag_addr = data_addr + length + sizeof (iv);
+
+	for (chunk = 0, offset = 0; offset < length; chunk++, offset += chunk_len) {
+		chunk_len = min (encrypted->chunk_size, length - offset);
+
+		status = flash_store_contiguous_blocks_encrypted_process_chunk (encrypted, iv, chunk,
+			((offset + chunk_len) == length), &data[offset], enc_data, chunk_len, tag, false);
+		if (status != 0) {
+			goto exit;
+		}
+
+		status = flash_write_and_verify (encrypted->base.flash, data_addr + offset, enc_data,
+			chunk_len);
+		if (status != 0) {
+			goto exit;
+		}
+
+		status = flash_write_and_verify (encrypted->base.flash,
+			tag_addr + (AES_TAG_LENGTH * chunk), tag, sizeof (tag));
+		if (status != 0) {
+			goto exit;
+		}
+	}
+
+	status = flash_write_and_verify (encrypted->base.flash, data_addr + length, iv, sizeof (iv));
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = flash_store_contiguous_blocks_finish_block_write (&encrypted->base, id, length);
+
+exit:
+	platform_free (enc_data);
+	return status;
+}
+
+/**
+ * Read data from flash that was encrypted in chunks.  Each chunk is authenticated and decrypted
+ * in the output buffer, so no additional memory is needed.
+ *
+ * @param encrypted The flash store to read from.
+ * @param id Block ID of the data.
+ * @param data Output buffer for the data.
+ * @param length Length of the output buffer.
+ *
+ * @return The length of the data read or an error code.
+ */
+static int flash_store_contiguous_blocks_encrypted_read_chunked (
+	const struct flash_store_contiguous_blocks_encrypted *encrypted, int id, uint8_t *data,
+	size_t length)
+{
+	uint8_t iv[FLASH_STORE_AES_IV_LENGTH];
+	uint8_t tag[AES_TAG_LENGTH];
+	uint32_t data_addr;
+	uint32_t tag_addr;
+	size_t stored;
+	size_t offset;
+	size_t chunk_len;
+	uint32_t chunk;
+	int status;
+
+	if (data == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	status = flash_store_contiguous_blocks_get_data_address (&encrypted->base, id, &data_addr,
+		&stored);
+	if (status != 0) {
+		return status;
+	}
+
+	if (length < stored) {
+		return FLASH_STORE_BUFFER_TOO_SMALL;
+	}
+
+	status = encrypted->base.flash->read (encrypted->base.flash, data_addr, data, stored);
+	if (status != 0) {
+		return status;
+	}
+
+	status = encrypted->base.flash->read (encrypted->base.flash, data_addr + stored, iv,
+		sizeof (iv));
+	if (status != 0) {
+		return status;
+	}
+
+	tag_addr = data_addr + stored + sizeof (iv);
+
+	for (chunk = 0, offset = 0; offset < stored; chunk++, offset += chunk_len) {
+		chunk_len = min (encrypted->chunk_size, stored - offset);
+
+		status = encrypted->base.flash->read (encrypted->base.flash,
+			tag_addr + (AES_TAG_LENGTH * chunk), tag, sizeof (tag));
+		if (status != 0) {
+			return status;
+		}
+
+		status = flash_store_contiguous_blocks_encrypted_process_chunk (encrypted, iv, chunk,
+			((offset + chunk_len) == stored), &data[offset], &data[offset], chunk_len, tag, true);
+		if (status != 0) {
+			if (status == AES_ENGINE_GCM_AUTH_FAILED) {
+				return FLASH_STORE_CORRUPT_DATA;
+			}
+			else {
+				return status;
+			}
+		}
+	}
+
+	return stored;
+}
+
+/**
+ * Read part of a data block that was encrypted in chunks.  Only the chunks that contain the
+ * requested data are read from flash, authenticated, and decrypted.  Chunks that are completely
+ * contained in the requested range are decrypted in the output buffer.  Chunks that only partially
+ * overlap the requested range are decrypted in a temporary buffer of a single chunk.
+ *
+ * This is only supported for storage that was initialized with a chunk size.
+ *
+ * @param store The flash store to read from.
+ * @param id Block ID of the data.
+ * @param offset Offset within the stored data to start reading.
+ * @param data Output buffer for the data.
+ * @param length The amount of data to read.  If this extends past the end of the stored data, only
+ * the data up to the end will be read.
+ *
+ * @return The length of the data read or an error code.  If the offset is at or past the end of the
+ * stored data, no data will be read and 0 is returned.
+ */
+int flash_store_contiguous_blocks_encrypted_read_range (
+	const struct flash_store_contiguous_blocks_encrypted *store, int id, size_t offset,
+	uint8_t *data, size_t length)
+{
+	uint8_t iv[FLASH_STORE_AES_IV_LENGTH];
+	uint8_t tag[AES_TAG_LENGTH];
+	uint8_t *chunk_data = NULL;
+	uint8_t *out;
+	uint32_t data_addr;
+	uint32_t tag_addr;
+	size_t stored;
+	size_t end;
+	size_t chunk_start;
+	size_t chunk_len;
+	size_t copy_start;
+	size_t copy_end;
+	uint32_t chunk;
+	int status;
+
+	if ((store == NULL) || (data == NULL) || (store->chunk_size == 0)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	status = flash_store_contiguous_blocks_get_data_address (&store->base, id, &data_addr,
+		&stored);
+	if (status != 0) {
+		return status;
+	}
+
+	if (offset >= stored) {
+		return 0;
+	}
+
+	length = min (length, stored - offset);
+	end = offset + length;
+
+	status = store->base.flash->read (store->base.flash, data_addr + stored, iv, sizeof (iv));
+	if (status != 0) {
+		return status;
+	}
+
+	tag_addr = data_addr + stored + sizeof (iv);
+
+	chunk = offset / store->chunk_size;
+	for (chunk_start = chunk * store->chunk_size; chunk_start < end;
+		chunk++, chunk_start += chunk_len) {
+		chunk_len = min (store->chunk_size, stored - chunk_start);
+
+		if ((chunk_start >= offset) && ((chunk_start + chunk_len) <= end)) {
+			out = &data[chunk_start - offset];
+		}
+		else {
+			if (chunk_data == NULL) {
+				chunk_data = platform_malloc (store->chunk_size);
+				if (chunk_data == NULL) {
+					return FLASH_STORE_NO_MEMORY;
+				}
+			}
+
+			out = chunk_data;
+		}
+
+		status = store->base.flash->read (store->base.flash,
+			tag_addr + (AES_TAG_LENGTH * chunk), tag, sizeof (tag));
+		if (status != 0) {
+			goto exit;
+		}
+
+		status = store->base.flash->read (store->base.flash, data_addr + chunk_start, out,
+			chunk_len);
+		if (status != 0) {
+			goto exit;
+		}
+
+		status = flash_store_contiguous_blocks_encrypted_process_chunk (store, iv, chunk,
+			((chunk_start + chunk_len) == stored), out, out, chunk_len, tag, true);
+		if (status != 0) {
+			if (status == AES_ENGINE_GCM_AUTH_FAILED) {
+				status = FLASH_STORE_CORRUPT_DATA;
+			}
+			goto exit;
+		}
+
+		if (out == chunk_data) {
+			copy_start = (chunk_start > offset) ? chunk_start : offset;
+			copy_end = min (end, chunk_start + chunk_len);
+
+			memcpy (&data[copy_start - offset], &chunk_data[copy_start - chunk_start],
+				copy_end - copy_start);
+		}
+	}
+
+	status = length;
+
+exit:
+	platform_free (chunk_data);
+	return status;
+}
+
 
 int flash_store_contiguous_blocks_encrypted_write (const struct flash_store *flash_store, int id,
 	const uint8_t *data, size_t length)
@@ -29,6 +428,10 @@ int flash_store_contiguous_blocks_encrypted_write (const struct flash_store *fla
 		return status;
 	}
 
+	if (encrypted->chunk_size != 0) {
+		return flash_store_contiguous_blocks_encrypted_write_chunked (encrypted, id, data, length);
+	}
+
 	enc_data = platform_malloc (length);
 	if (enc_data == NULL) {
 		return FLASH_STORE_NO_MEMORY;
@@ -63,6 +466,10 @@ int flash_store_contiguous_blocks_encrypted_read (const struct flash_store *flas
 	uint8_t iv_tag[FLASH_STORE_AES_IV_LENGTH + AES_TAG_LENGTH];
 	int status;
 
+	if ((encrypted != NULL) && (encrypted->chunk_size != 0)) {
+		return flash_store_contiguous_blocks_encrypted_read_chunked (encrypted, id, data, length);
+	}
+
 	status = flash_store_contiguous_blocks_read_common (&encrypted->base, id, data, length, iv_tag,
 		sizeof (iv_tag), &length);
 	if (status != 0) {
@@ -95,6 +502,8 @@ int flash_store_contiguous_blocks_encrypted_read (const struct flash_store *flas
  * @param aes The AES engine to use for data encryption.  The must be pre-loaded with the encryption
  * key.
  * @param rng The random number generator to use for creating encryption IVs.
+ * @param chunk_size The maximum amount of data to encrypt with a single authentication tag.  Set
+ * this to 0 to encrypt each data block as a single unit.
  * @param decreasing Flag indicating if the storage grows down in the device address space.
  * @param variable Flag indicating if the blocks contain variable length data.
  *
@@ -104,7 +513,7 @@ static int flash_store_contiguous_blocks_encrypted_init_storage_common (
 	struct flash_store_contiguous_blocks_encrypted *store,
 	struct flash_store_contiguous_blocks_state *state, const struct flash *flash,
 	uint32_t base_addr, size_t block_count, size_t data_length, struct aes_engine *aes,
-	struct rng_engine *rng, bool decreasing, bool variable)
+	struct rng_engine *rng, size_t chunk_size, bool decreasing, bool variable)
 {
 	int status;
 
@@ -118,6 +527,8 @@ static int flash_store_contiguous_blocks_encrypted_init_storage_common (
 		return status;
 	}
 
+	store->chunk_size = chunk_size;
+
 	status = flash_store_contiguous_blocks_encrypted_init_state (store, block_count,
 		data_length);
 	if (status != 0) {
@@ -155,7 +566,7 @@ int flash_store_contiguous_blocks_encrypted_init_fixed_storage (
 	struct rng_engine *rng)
 {
 	return flash_store_contiguous_blocks_encrypted_init_storage_common (store, state, flash,
-		base_addr, block_count, data_length, aes, rng, false, false);
+		base_addr, block_count, data_length, aes, rng, 0, false, false);
 }
 
 /**
@@ -181,7 +592,7 @@ int flash_store_contiguous_blocks_encrypted_init_fixed_storage_decreasing (
 	struct rng_engine *rng)
 {
 	return flash_store_contiguous_blocks_encrypted_init_storage_common (store, state, flash,
-		base_addr, block_count, data_length, aes, rng, true, false);
+		base_addr, block_count, data_length, aes, rng, 0, true, false);
 }
 
 /**
@@ -206,7 +617,7 @@ int flash_store_contiguous_blocks_encrypted_init_variable_storage (
 	size_t block_count, size_t min_length, struct aes_engine *aes, struct rng_engine *rng)
 {
 	return flash_store_contiguous_blocks_encrypted_init_storage_common (store, state, flash,
-		base_addr, block_count, min_length, aes, rng, false, true);
+		base_addr, block_count, min_length, aes, rng, 0, false, true);
 }
 
 /**
@@ -233,7 +644,80 @@ int flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing (
 	struct rng_engine *rng)
 {
 	return flash_store_contiguous_blocks_encrypted_init_storage_common (store, state, flash,
-		base_addr, block_count, min_length, aes, rng, true, true);
+		base_addr, block_count, min_length, aes, rng, 0, true, true);
+}
+
+/**
+ * Initialize flash storage for variable sized contiguous blocks of data.  Data will be encrypted in
+ * chunks, each with a separate authentication tag, so that memory requirements do not depend on
+ * the size of the data being stored.
+ *
+ * Data stored this way is not compatible with storage that encrypts each data block as a single
+ * unit.
+ *
+ * @param store The flash storage to initialize.
+ * @param flash The flash device used for storage.
+ * @param base_addr The address of the first storage block.  This must be aligned to a minimum erase
+ * block.
+ * @param block_count The number of data blocks used for storage.
+ * @param min_length The minimum length required for each data block.  The actual length length will
+ * be determined by the flash sector size.
+ * @param aes The AES engine to use for data encryption.  The must be pre-loaded with the encryption
+ * key.
+ * @param rng The random number generator to use for creating encryption IVs.
+ * @param chunk_size The maximum amount of data to encrypt with a single authentication tag.
+ *
+ * @return 0 if the flash storage was successfully initialized or an error code.
+ */
+int flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (
+	struct flash_store_contiguous_blocks_encrypted *store,
+	struct flash_store_contiguous_blocks_state *state, const struct flash *flash,
+	uint32_t base_addr, size_t block_count, size_t min_length, struct aes_engine *aes,
+	struct rng_engine *rng, size_t chunk_size)
+{
+	if (chunk_size == 0) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	return flash_store_contiguous_blocks_encrypted_init_storage_common (store, state, flash,
+		base_addr, block_count, min_length, aes, rng, chunk_size, false, true);
+}
+
+/**
+ * Initialize flash storage for variable sized contiguous blocks of data.  Data will be encrypted in
+ * chunks, each with a separate authentication tag, so that memory requirements do not depend on
+ * the size of the data being stored.  Blocks will be stored in addresses decreasing from the first
+ * block.
+ *
+ * Data stored this way is not compatible with storage that encrypts each data block as a single
+ * unit.
+ *
+ * @param store The flash storage to initialize.
+ * @param flash The flash device used for storage.
+ * @param base_addr The address of the first storage block.  This must be aligned to a minimum erase
+ * block.
+ * @param block_count The number of data blocks used for storage.
+ * @param min_length The minimum length required for each data block.  The actual length length will
+ * be determined by the flash sector size.
+ * @param aes The AES engine to use for data encryption.  The must be pre-loaded with the encryption
+ * key.
+ * @param rng The random number generator to use for creating encryption IVs.
+ * @param chunk_size The maximum amount of data to encrypt with a single authentication tag.
+ *
+ * @return 0 if the flash storage was successfully initialized or an error code.
+ */
+int flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing_chunked (
+	struct flash_store_contiguous_blocks_encrypted *store,
+	struct flash_store_contiguous_blocks_state *state, const struct flash *flash,
+	uint32_t base_addr, size_t block_count, size_t min_length, struct aes_engine *aes,
+	struct rng_engine *rng, size_t chunk_size)
+{
+	if (chunk_size == 0) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	return flash_store_contiguous_blocks_encrypted_init_storage_common (store, state, flash,
+		base_addr, block_count, min_length, aes, rng, chunk_size, true, true);
 }
 
 /**
@@ -249,8 +733,38 @@ int flash_store_contiguous_blocks_encrypted_init_state (
 	const struct flash_store_contiguous_blocks_encrypted *store, size_t block_count,
 	size_t data_length)
 {
-	return flash_store_contiguous_blocks_init_state_common (&store->base, block_count, data_length,
-		FLASH_STORE_AES_IV_LENGTH + AES_TAG_LENGTH);
+	size_t chunk_space;
+	size_t remain;
+	int status;
+
+	if (store->chunk_size == 0) {
+		return flash_store_contiguous_blocks_init_state_common (&store->base, block_count,
+			data_length, FLASH_STORE_AES_IV_LENGTH + AES_TAG_LENGTH);
+	}
+
+	status = flash_store_contiguous_blocks_init_state_common (&store->base, block_count,
+		data_length, FLASH_STORE_AES_IV_LENGTH +
+			(AES_TAG_LENGTH * flash_store_contiguous_blocks_encrypted_chunk_count (data_length,
+				store->chunk_size)));
+	if (status != 0) {
+		return status;
+	}
+
+	if (store->base.variable) {
+		/* The number of tags depends on the amount of data stored, so determine the largest amount
+		 * of data that will fit in the block with the tag for each chunk. */
+		chunk_space = store->base.state->block_size - FLASH_STORE_HEADER_LENGTH -
+			FLASH_STORE_AES_IV_LENGTH;
+		remain = chunk_space % (store->chunk_size + AES_TAG_LENGTH);
+
+		store->base.state->max_size =
+			(chunk_space / (store->chunk_size + AES_TAG_LENGTH)) * store->chunk_size;
+		if (remain > AES_TAG_LENGTH) {
+			store->base.state->max_size += remain - AES_TAG_LENGTH;
+		}
+	}
+
+	return 0;
 }
 
 /**
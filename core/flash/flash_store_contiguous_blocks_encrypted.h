@@ -17,6 +17,7 @@ struct flash_store_contiguous_blocks_encrypted {
 	struct flash_store_contiguous_blocks base;	/**< Base flash storage instance. */
 	struct aes_engine *aes;						/**< Engine to use for data encryption. */
 	struct rng_engine *rng;						/**< Random number generator for encryption IVs. */
+	size_t chunk_size;							/**< Size of independently encrypted chunks of data, or 0 for none. */
 };
 
 int flash_store_contiguous_blocks_encrypted_init_fixed_storage (
@@ -41,6 +42,17 @@ int flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing (
 	uint32_t base_addr, size_t block_count, size_t min_length, struct aes_engine *aes,
 	struct rng_engine *rng);
 
+int flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (
+	struct flash_store_contiguous_blocks_encrypted *store,
+	struct flash_store_contiguous_blocks_state *state, const struct flash *flash,
+	uint32_t base_addr, size_t block_count, size_t min_length, struct aes_engine *aes,
+	struct rng_engine *rng, size_t chunk_size);
+int flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing_chunked (
+	struct flash_store_contiguous_blocks_encrypted *store,
+	struct flash_store_contiguous_blocks_state *state, const struct flash *flash,
+	uint32_t base_addr, size_t block_count, size_t min_length, struct aes_engine *aes,
+	struct rng_engine *rng, size_t chunk_size);
+
 int flash_store_contiguous_blocks_encrypted_init_state (
 	const struct flash_store_contiguous_blocks_encrypted *store, size_t block_count,
 	size_t data_length);
@@ -48,5 +60,9 @@ int flash_store_contiguous_blocks_encrypted_init_state (
 void flash_store_contiguous_blocks_encrypted_release (
 	const struct flash_store_contiguous_blocks_encrypted *store);
 
+int flash_store_contiguous_blocks_encrypted_read_range (
+	const struct flash_store_contiguous_blocks_encrypted *store, int id, size_t offset,
+	uint8_t *data, size_t length);
+
 
 #endif /* FLASH_STORE_CONTIGUOUS_BLOCKS_ENCRYPTED_H_ */
@@ -50,6 +50,7 @@ int flash_store_contiguous_blocks_encrypted_read (const struct flash_store *flas
 			NULL), \
 		.aes = aes_ptr, \
 		.rng = rng_ptr, \
+		.chunk_size = 0, \
 	}
 
 /**
@@ -72,6 +73,7 @@ int flash_store_contiguous_blocks_encrypted_read (const struct flash_store *flas
 			NULL), \
 		.aes = aes_ptr, \
 		.rng = rng_ptr, \
+		.chunk_size = 0, \
 	}
 
 /**
@@ -94,6 +96,7 @@ int flash_store_contiguous_blocks_encrypted_read (const struct flash_store *flas
 			NULL), \
 		.aes = aes_ptr, \
 		.rng = rng_ptr, \
+		.chunk_size = 0, \
 	}
 
 /**
@@ -116,6 +119,58 @@ int flash_store_contiguous_blocks_encrypted_read (const struct flash_store *flas
 			NULL), \
 		.aes = aes_ptr, \
 		.rng = rng_ptr, \
+		.chunk_size = 0, \
+	}
+
+/**
+ * Initialize a static instance of a encrypted flash storage for variable sized contiguous blocks of
+ * data.  Data will be encrypted in fixed size chunks, each with a separate authentication tag.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the flash store.
+ * @param flash_addr The address of the first storage block.  This must be aligned to a minimum
+ * erase block.
+ * @param flash_ptr The flash device that is managed by the store.
+ * @param aes_ptr AES engine instance for encryption.
+ * @param rng_ptr RNG engine instance for encryption.
+ * @param chunk The maximum amount of data to encrypt with a single authentication tag.  This must
+ * not be 0.
+ */
+#define	flash_store_contiguous_blocks_encrypted_static_init_variable_storage_chunked(state_ptr, \
+	flash_addr, flash_ptr, aes_ptr, rng_ptr, chunk) { \
+		.base = flash_store_contiguous_blocks_static_init_variable_storage ( \
+			FLASH_STORE_CONTIGUOUS_BLOCKS_ENCRYPTED_API_INIT, state_ptr, flash_addr, flash_ptr, \
+			NULL), \
+		.aes = aes_ptr, \
+		.rng = rng_ptr, \
+		.chunk_size = chunk, \
+	}
+
+/**
+ * Initialize a static instance of a encrypted flash storage for variable sized contiguous blocks of
+ * data.  Data will be encrypted in fixed size chunks, each with a separate authentication tag.
+ * Blocks will be stored in addresses decreasing from the first block.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the flash store.
+ * @param flash_addr The address of the first storage block.  This must be aligned to a minimum
+ * erase block.
+ * @param flash_ptr The flash device that is managed by the store.
+ * @param aes_ptr AES engine instance for encryption.
+ * @param rng_ptr RNG engine instance for encryption.
+ * @param chunk The maximum amount of data to encrypt with a single authentication tag.  This must
+ * not be 0.
+ */
+#define	flash_store_contiguous_blocks_encrypted_static_init_variable_storage_decreasing_chunked( \
+	state_ptr, flash_addr, flash_ptr, aes_ptr, rng_ptr, chunk) { \
+		.base = flash_store_contiguous_blocks_static_init_variable_storage_decreasing ( \
+			FLASH_STORE_CONTIGUOUS_BLOCKS_ENCRYPTED_API_INIT, state_ptr, flash_addr, flash_ptr, \
+			NULL), \
+		.aes = aes_ptr, \
+		.rng = rng_ptr, \
+		.chunk_size = chunk, \
 	}
 
 
@@ -59,7 +59,7 @@ int flash_updater_init (struct flash_updater *updater, const struct flash *flash
 /**
  * Initialize a flash update manager that will operate on erase sectors.  The base address and
  * maximum size don't need to be aligned to the sector size, but erase sectors need to accounted for
- * externally.
+ * externally.  Any complete flash blocks in the erased region will be erased with block commands.
  *
  * @param updater The update manager to initialize.
  * @param flash The flash device where updates will be written.
@@ -72,7 +72,7 @@ int flash_updater_init_sector (struct flash_updater *updater, const struct flash
 	uint32_t base_addr, size_t max_size)
 {
 	return flash_updater_init_common (updater, flash, base_addr, max_size,
-		flash_sector_erase_region_and_verify);
+		flash_optimal_erase_region_and_verify);
 }
 
 /**
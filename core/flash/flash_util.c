@@ -2,13 +2,15 @@
 // Licensed under the MIT license.
 
 #include <stdbool.h>
-#include <zephyr/kernel.h>
-#include <soc.h>
+#include <string.h>
 #include "platform_api.h"
 #include "flash_util.h"
 #include "flash_common.h"
 
-#define ASYNC_HASH_OPERATION 1
+#if FLASH_HASH_PIPELINE && defined (__ZEPHYR__)
+#include <zephyr/kernel.h>
+#include <soc.h>
+#endif
 
 /**
  * Validate the contents of a contiguous block of data stored in a flash device against an RSA
@@ -100,6 +102,40 @@ int flash_verify_noncontiguous_contents_at_offset (const struct flash *flash, ui
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
 	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length)
+{
+	return flash_verify_noncontiguous_contents_pipelined (NULL, flash, offset, regions, count, hash,
+		type, rsa, signature, sig_length, pub_key, hash_out, hash_length);
+}
+
+/**
+ * Validate the contents of a group of noncontiguous blocks of data stored in a flash device
+ * against an RSA encrypted signature, using a specific pipeline for hashing the flash data.
+ *
+ * All regions will be verified starting at a fixed offset in flash.
+ *
+ * @param pipeline The pipeline to use for hashing.  If this is null, the default pipeline will be
+ * used if it is available.
+ * @param flash The flash device that contains the data to verify.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of flash regions that should be verified as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use for verification.
+ * @param type The hashing algorithm used for the signature.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param signature The signature for the data block.
+ * @param sig_length The length of the signature.
+ * @param pub_key The public key for the signature.
+ * @param hash_out Optional output buffer for the calculated hash. This will be valid even if the
+ * signature verification fails.  Set this to NULL if the hash is not needed.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the flash contents are valid or an error code.
+ */
+int flash_verify_noncontiguous_contents_pipelined (struct flash_hash_pipeline *pipeline,
+	const struct flash *flash, uint32_t offset, const struct flash_region *regions, size_t count,
+	struct hash_engine *hash, enum hash_type type, struct rsa_engine *rsa,
+	const uint8_t *signature, size_t sig_length, const struct rsa_public_key *pub_key,
+	uint8_t *hash_out, size_t hash_length)
 {
 	uint8_t data_hash[SHA256_HASH_LENGTH];
 	int status;
@@ -130,8 +166,8 @@ int flash_verify_noncontiguous_contents_at_offset (const struct flash *flash, ui
 			return FLASH_UTIL_UNKNOWN_SIG_HASH;
 	}
 
-	status = flash_hash_noncontiguous_contents_at_offset (flash, offset, regions, count, hash, type,
-		hash_out, SHA256_HASH_LENGTH);
+	status = flash_hash_noncontiguous_contents_pipelined (pipeline, flash, offset, regions, count,
+		hash, type, hash_out, SHA256_HASH_LENGTH);
 	if (status != 0) {
 		return status;
 	}
@@ -328,6 +364,32 @@ int flash_hash_noncontiguous_contents (const struct flash *flash,
 int flash_hash_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	uint8_t *hash_out, size_t hash_length)
+{
+	return flash_hash_noncontiguous_contents_pipelined (NULL, flash, offset, regions, count, hash,
+		type, hash_out, hash_length);
+}
+
+/**
+ * Generate a hash for a group of noncontiguous blocks of data stored in a flash device, using a
+ * specific pipeline for hashing the flash data.  All regions will be hashed starting at a fixed
+ * offset in flash.
+ *
+ * @param pipeline The pipeline to use for hashing.  If this is null, the default pipeline will be
+ * used if it is available.
+ * @param flash The flash device that contains the data to hash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ * @param type The type of hash to generate.
+ * @param hash_out The buffer to hold the generated hash value.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the hash was generated successfully or an error code.
+ */
+int flash_hash_noncontiguous_contents_pipelined (struct flash_hash_pipeline *pipeline,
+	const struct flash *flash, uint32_t offset, const struct flash_region *regions, size_t count,
+	struct hash_engine *hash, enum hash_type type, uint8_t *hash_out, size_t hash_length)
 {
 	int status;
 
@@ -341,8 +403,8 @@ int flash_hash_noncontiguous_contents_at_offset (const struct flash *flash, uint
 		return status;
 	}
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (flash, offset, regions, count,
-		hash);
+	status = flash_hash_update_noncontiguous_contents_pipelined (pipeline, flash, offset, regions,
+		count, hash);
 	if (status != 0) {
 		goto fail;
 	}
@@ -406,66 +468,206 @@ int flash_hash_update_noncontiguous_contents (const struct flash *flash,
 	return flash_hash_update_noncontiguous_contents_at_offset (flash, 0, regions, count, hash);
 }
 
-#define FLASH_VERIFICATION_SIZE 16384
+/**
+ * Track the position of a read through a group of noncontiguous flash regions.
+ */
+struct flash_hash_read_position {
+	size_t index;		/**< The region containing the next data to read. */
+	size_t consumed;	/**< The amount of data that has been read from the current region. */
+};
 
-#if ASYNC_HASH_OPERATION
-#define HASH_FIFO_SIZE          1024
-#define HASH_BUFFER_COUNT       2
+/**
+ * Read the next block of data from a group of noncontiguous flash regions.  If the flash device
+ * supports reading multiple regions in a single operation, data from small regions is combined into
+ * a single block.  Otherwise, a block never contains data from more than one region.
+ *
+ * @param flash The flash device that contains the data to read.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions being read.
+ * @param count The number of regions defined in the group.
+ * @param pos The current read position in the group of regions.  This will be updated to the
+ * position after the data that was read.
+ * @param data The buffer to hold the block of data.
+ * @param max_length The maximum length of the block.
+ * @param length Output for the amount of data in the block.  This will be 0 when there is no more
+ * data to read.
+ *
+ * @return 0 if the block was read successfully or an error code.
+ */
+static int flash_hash_read_block (const struct flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct flash_hash_read_position *pos,
+	uint8_t *data, size_t max_length, size_t *length)
+{
+	struct flash_region block[FLASH_HASH_READ_REGIONS_MAX];
+	size_t pieces = 0;
+	size_t total = 0;
+	size_t next_read;
 
-#if defined(CONFIG_SPI_DMA_SUPPORT_ASPEED)
-static uint8_t hash_buffer[HASH_BUFFER_COUNT][FLASH_VERIFICATION_SIZE] NON_CACHED_BSS_ALIGN16;
-#else
-static uint8_t hash_buffer[HASH_BUFFER_COUNT][FLASH_VERIFICATION_SIZE] __aligned(16);
-#endif
+	while ((pos->index < count) && (total < max_length) &&
+		(pieces < FLASH_HASH_READ_REGIONS_MAX)) {
+		if (pos->consumed >= regions[pos->index].length) {
+			pos->index++;
+			pos->consumed = 0;
+			continue;
+		}
 
-// thread
-static bool thread_created;
-static struct k_thread hash_thread;
-K_THREAD_STACK_DEFINE(hash_stack_area, HASH_FIFO_SIZE);
+		next_read = regions[pos->index].length - pos->consumed;
+		if (next_read > (max_length - total)) {
+			next_read = max_length - total;
+		}
 
-// message queue
-struct hash_msgq_data_type {
-	uint8_t buf_id;
-	size_t next_read;
-	bool last_req;
-};
+		block[pieces].start_addr = regions[pos->index].start_addr + offset + pos->consumed;
+		block[pieces].length = next_read;
 
-struct flash_msgq_data_type {
-	uint8_t buf_id;
-};
+		pieces++;
+		total += next_read;
+		pos->consumed += next_read;
 
-K_MSGQ_DEFINE(hash_msgq, sizeof(struct hash_msgq_data_type), HASH_BUFFER_COUNT, 4);
-K_MSGQ_DEFINE(flash_msgq, sizeof(struct flash_msgq_data_type), HASH_BUFFER_COUNT, 4);
-K_SEM_DEFINE(hash_done_sem, 0, 1);
+		if (flash->read_regions == NULL) {
+			break;
+		}
+	}
+
+	*length = total;
+	if (pieces == 0) {
+		return 0;
+	}
+	else if (pieces == 1) {
+		return flash->read (flash, block[0].start_addr, data, block[0].length);
+	}
+	else {
+		return flash->read_regions (flash, block, pieces, data, total);
+	}
+}
 
-static void hash_update_thread(void *arg1, void *unused1, void *unused2)
+/**
+ * Update a hash for a group of noncontiguous blocks of data stored in a flash device by reading
+ * and hashing each block in turn from the calling context.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ *
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+static int flash_hash_update_noncontiguous_contents_serial (const struct flash *flash,
+	uint32_t offset, const struct flash_region *regions, size_t count, struct hash_engine *hash)
 {
-	struct hash_msgq_data_type hash_msgq_data;
-	struct flash_msgq_data_type flash_msgq_data;
-	struct hash_engine *hash = (struct hash_engine *)arg1;
+	uint8_t data[FLASH_VERIFICATION_BLOCK];
+	struct flash_hash_read_position pos = {0, 0};
+	size_t length;
 	int status;
 
-	while(1) {
-		status = k_msgq_get(&hash_msgq, &hash_msgq_data, K_FOREVER);
-		if (status == -ENOMSG) {
-			// Message queue is purged.
-			continue;
+	do {
+		status = flash_hash_read_block (flash, offset, regions, count, &pos, data, sizeof (data),
+			&length);
+		if (status != 0) {
+			return status;
+		}
+
+		if (length != 0) {
+			status = hash->update (hash, data, length);
+			if (status != 0) {
+				return status;
+			}
 		}
+	} while (length != 0);
+
+	return 0;
+}
+
+#if FLASH_HASH_PIPELINE && defined (__ZEPHYR__)
+#define	FLASH_HASH_PIPELINE_STACK_SIZE		1024
+
+#if defined(CONFIG_SPI_DMA_SUPPORT_ASPEED)
+static struct flash_hash_pipeline flash_hash_zephyr_pipeline NON_CACHED_BSS_ALIGN16;
+#else
+static struct flash_hash_pipeline flash_hash_zephyr_pipeline __aligned(16);
+#endif
+
+static bool flash_hash_thread_created;
+static struct k_thread flash_hash_thread;
+K_THREAD_STACK_DEFINE (flash_hash_stack_area, FLASH_HASH_PIPELINE_STACK_SIZE);
+K_MUTEX_DEFINE (flash_hash_thread_lock);
+
+/**
+ * Zephyr thread entry point for the hashing stage of the default pipeline.
+ *
+ * @param pipeline The pipeline to run.
+ * @param unused1 Unused.
+ * @param unused2 Unused.
+ */
+static void flash_hash_pipeline_zephyr_thread (void *pipeline, void *unused1, void *unused2)
+{
+	flash_hash_pipeline_run ((struct flash_hash_pipeline*) pipeline);
+}
+#endif
+
+/**
+ * The pipeline used for hashing requests that do not provide their own pipeline.
+ */
+static struct flash_hash_pipeline *flash_hash_default_pipeline;
+
+/**
+ * Get the pipeline to use for hashing requests that do not provide their own pipeline.  On Zephyr
+ * builds with FLASH_HASH_PIPELINE enabled, a default pipeline with a dedicated hashing thread is
+ * started the first time it is needed, unless the platform has registered a different one.
+ *
+ * @return The default pipeline or null if there is none.
+ */
+static struct flash_hash_pipeline* flash_hash_get_default_pipeline (void)
+{
+#if FLASH_HASH_PIPELINE && defined (__ZEPHYR__)
+	k_tid_t hash_pid;
 
-		hash->update(hash, (uint8_t *)&hash_buffer[hash_msgq_data.buf_id], hash_msgq_data.next_read);
-		if (hash_msgq_data.last_req) {
-			k_sem_give(&hash_done_sem);
+	if (flash_hash_default_pipeline == NULL) {
+		k_mutex_lock (&flash_hash_thread_lock, K_FOREVER);
+
+		if (!flash_hash_thread_created &&
+			(flash_hash_pipeline_init (&flash_hash_zephyr_pipeline) == 0)) {
+			hash_pid = k_thread_create (&flash_hash_thread, flash_hash_stack_area,
+				K_THREAD_STACK_SIZEOF (flash_hash_stack_area), flash_hash_pipeline_zephyr_thread,
+				&flash_hash_zephyr_pipeline, NULL, NULL, 0, 0, K_NO_WAIT);
+			k_thread_name_set (hash_pid, "Hash Update Handler");
+
+			flash_hash_thread_created = true;
 		}
 
-		flash_msgq_data.buf_id = hash_msgq_data.buf_id;
-		k_msgq_put(&flash_msgq, &flash_msgq_data, K_FOREVER);
+		k_mutex_unlock (&flash_hash_thread_lock);
+
+		if (flash_hash_thread_created) {
+			return &flash_hash_zephyr_pipeline;
+		}
 	}
+#endif
+
+	return flash_hash_default_pipeline;
+}
+
+/**
+ * Register the pipeline to use for flash hashing requests that do not provide their own pipeline.
+ * If the default pipeline is already in use by another request, the flash data will be hashed
+ * without a pipeline instead of waiting for it to be available.
+ *
+ * This must be called during system initialization, before any flash hashing is executed.
+ *
+ * @param pipeline The initialized pipeline to use by default.  Set this to null to disable the
+ * default pipeline.
+ */
+void flash_hash_set_default_pipeline (struct flash_hash_pipeline *pipeline)
+{
+	flash_hash_default_pipeline = pipeline;
 }
 
 /**
  * Update a hash for a group of noncontiguous blocks of data stored in a flash device.  All regions
  * will be hashed starting at a fixed offset in flash.
  *
+ * If there is a default hashing pipeline that is not being used, the flash reads will overlap with
+ * hashing of the data.  Otherwise, the data is read and hashed one block at a time.
+ *
  * The hash context must already be started prior to this call.  The hashing context will not be
  * canceled on failure.
  *
@@ -480,87 +682,229 @@ static void hash_update_thread(void *arg1, void *unused1, void *unused2)
 int flash_hash_update_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash)
 {
-	size_t next_read;
-	uint32_t current_addr;
-	size_t remaining;
-	size_t i;
+	return flash_hash_update_noncontiguous_contents_pipelined (NULL, flash, offset, regions, count,
+		hash);
+}
+
+/**
+ * Update a hash for a group of noncontiguous blocks of data stored in a flash device using a
+ * specific hashing pipeline.  All regions will be hashed starting at a fixed offset in flash.
+ *
+ * The hash context must already be started prior to this call.  The hashing context will not be
+ * canceled on failure.
+ *
+ * @param pipeline The pipeline to use for hashing.  This must not be used by any other request
+ * at the same time.  If this is null, the default pipeline will be used if it is available.
+ * @param flash The flash device that contains the data to hash.
+ * @param offset An offset to apply to each region address.
+ * @param regions The group of regions that should be hashed as a single region.
+ * @param count The number of regions defined in the group.
+ * @param hash The hashing engine to use to generate the hash.
+ *
+ * @return 0 if the hash was updated successfully or an error code.
+ */
+int flash_hash_update_noncontiguous_contents_pipelined (struct flash_hash_pipeline *pipeline,
+	const struct flash *flash, uint32_t offset, const struct flash_region *regions, size_t count,
+	struct hash_engine *hash)
+{
 	int status;
-	k_tid_t hash_pid;
-	uint8_t buf_id = 0;
-	struct hash_msgq_data_type hash_msgq_data;
-	struct flash_msgq_data_type flash_msgq_data;
-
-	if (!thread_created) {
-		for (i = 0; i < HASH_BUFFER_COUNT; i++) {
-			flash_msgq_data.buf_id = i;
-			k_msgq_put(&flash_msgq, &flash_msgq_data, K_NO_WAIT);
-		}
 
-		hash_pid = k_thread_create(&hash_thread,
-				hash_stack_area,
-				K_THREAD_STACK_SIZEOF(hash_stack_area),
-				(k_thread_entry_t) hash_update_thread,
-				hash, NULL, NULL,
-				0,
-				0, K_NO_WAIT);
-		k_thread_name_set(hash_pid, "Hash Update Handler");
-		thread_created = true;
+	if ((flash == NULL) || (regions == NULL) || (count == 0) || (hash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	if ((flash == NULL) || (regions == NULL) || (count == 0) || (hash == NULL)) {
+	if (pipeline != NULL) {
+		return flash_hash_pipeline_update (pipeline, flash, offset, regions, count, hash);
+	}
+
+	pipeline = flash_hash_get_default_pipeline ();
+	if (pipeline != NULL) {
+		status = flash_hash_pipeline_update (pipeline, flash, offset, regions, count, hash);
+		if (status != FLASH_UTIL_PIPELINE_BUSY) {
+			return status;
+		}
+	}
+
+	return flash_hash_update_noncontiguous_contents_serial (flash, offset, regions, count, hash);
+}
+
+/**
+ * Initialize a pipeline for hashing flash data.
+ *
+ * Without any other configuration, blocks are hashed by the caller as block buffers are needed, so
+ * there is no overlap between flash reads and hashing.  To overlap the operations, a dedicated
+ * context must be running flash_hash_pipeline_run for the pipeline.
+ *
+ * @param pipeline The pipeline to initialize.
+ *
+ * @return 0 if the pipeline was initialized successfully or an error code.
+ */
+int flash_hash_pipeline_init (struct flash_hash_pipeline *pipeline)
+{
+	int status;
+
+	if (pipeline == NULL) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
+	memset (pipeline, 0, sizeof (struct flash_hash_pipeline));
 
-	for (i = 0; i < count; i++) {
-		current_addr = regions[i].start_addr + offset;
-		remaining = regions[i].length;
+	status = platform_mutex_init (&pipeline->lock);
+	if (status != 0) {
+		return status;
+	}
 
-		while (remaining > 0) {
-			next_read = (remaining < FLASH_VERIFICATION_SIZE) ?
-				remaining : FLASH_VERIFICATION_SIZE;
+	status = platform_semaphore_init (&pipeline->filled);
+	if (status != 0) {
+		goto exit_lock;
+	}
 
-			k_msgq_get(&flash_msgq, &flash_msgq_data, K_FOREVER);
-			buf_id = flash_msgq_data.buf_id;
-			status = flash->read (flash, current_addr, (uint8_t *)&hash_buffer[buf_id], next_read);
-			if (status != 0) {
-				/* Make sure the hash->update() finish */
-				hash_msgq_data.buf_id = buf_id;
-				hash_msgq_data.next_read = next_read;
-				hash_msgq_data.last_req = true;
-				k_msgq_put(&hash_msgq, &hash_msgq_data, K_FOREVER);
-				k_sem_take(&hash_done_sem, K_FOREVER);
-				return status;
-			}
-			hash_msgq_data.buf_id = buf_id;
-			hash_msgq_data.next_read = next_read;
-			if ((i == count - 1) && ((remaining - next_read) == 0))
-				hash_msgq_data.last_req = true;
-			else
-				hash_msgq_data.last_req = false;
-
-			k_msgq_put(&hash_msgq, &hash_msgq_data, K_FOREVER);
-			k_yield();
-
-			remaining -= next_read;
-			current_addr += next_read;
+	status = platform_semaphore_init (&pipeline->emptied);
+	if (status != 0) {
+		goto exit_filled;
+	}
+
+	return 0;
+
+exit_filled:
+	platform_semaphore_free (&pipeline->filled);
+exit_lock:
+	platform_mutex_free (&pipeline->lock);
+	return status;
+}
+
+/**
+ * Release the resources used by a hashing pipeline.  The hashing stage must be stopped before the
+ * pipeline is released.
+ *
+ * @param pipeline The pipeline to release.
+ */
+void flash_hash_pipeline_release (struct flash_hash_pipeline *pipeline)
+{
+	if (pipeline != NULL) {
+		platform_semaphore_free (&pipeline->emptied);
+		platform_semaphore_free (&pipeline->filled);
+		platform_mutex_free (&pipeline->lock);
+	}
+}
+
+/**
+ * Hash the next block waiting in the pipeline.  If hashing has already failed for the active
+ * request, the block is discarded.  This must be called while holding the pipeline lock, and the
+ * lock will be held when this returns.
+ *
+ * @param pipeline The pipeline to process.
+ */
+static void flash_hash_pipeline_hash_block (struct flash_hash_pipeline *pipeline)
+{
+	size_t block = pipeline->head;
+	int status;
+
+	if (pipeline->status == 0) {
+		pipeline->hashing = true;
+		platform_mutex_unlock (&pipeline->lock);
+
+		status = pipeline->hash->update (pipeline->hash, pipeline->buffer[block],
+			pipeline->length[block]);
+
+		platform_mutex_lock (&pipeline->lock);
+		pipeline->hashing = false;
+
+		if (pipeline->status == 0) {
+			pipeline->status = status;
 		}
 	}
 
-	k_sem_take(&hash_done_sem, K_FOREVER);
+	pipeline->head = (block + 1) % FLASH_HASH_PIPELINE_DEPTH;
+	pipeline->queued--;
+}
 
-	return 0;
+/**
+ * Hashing stage of the pipeline.  Each block of data read from flash is added to the hash and the
+ * buffer is made available for the next block.  This does not return until the pipeline has been
+ * stopped.
+ *
+ * @param pipeline The pipeline to run.
+ */
+void flash_hash_pipeline_run (struct flash_hash_pipeline *pipeline)
+{
+	if (pipeline == NULL) {
+		return;
+	}
+
+	platform_mutex_lock (&pipeline->lock);
+	pipeline->running = true;
+
+	while (!pipeline->stop) {
+		if ((pipeline->queued == 0) || pipeline->hashing) {
+			platform_mutex_unlock (&pipeline->lock);
+			platform_semaphore_wait (&pipeline->filled, 0);
+			platform_mutex_lock (&pipeline->lock);
+		}
+		else {
+			flash_hash_pipeline_hash_block (pipeline);
+			platform_semaphore_post (&pipeline->emptied);
+		}
+	}
+
+	pipeline->running = false;
+	platform_mutex_unlock (&pipeline->lock);
+
+	/* A request in progress may be waiting for this stage to hash its data. */
+	platform_semaphore_post (&pipeline->emptied);
 }
-#else
-uint8_t hash_buffer[FLASH_VERIFICATION_SIZE];
 
 /**
- * Update a hash for a group of noncontiguous blocks of data stored in a flash device.  All regions
- * will be hashed starting at a fixed offset in flash.
+ * Stop the hashing stage of a pipeline.  Any request still using the pipeline will finish hashing
+ * its data from the calling context.
+ *
+ * @param pipeline The pipeline to stop.
+ */
+void flash_hash_pipeline_stop (struct flash_hash_pipeline *pipeline)
+{
+	if (pipeline != NULL) {
+		platform_mutex_lock (&pipeline->lock);
+		pipeline->stop = true;
+		platform_mutex_unlock (&pipeline->lock);
+
+		platform_semaphore_post (&pipeline->filled);
+	}
+}
+
+/**
+ * Wait until the number of blocks waiting to be hashed drops below a limit.  If no context is
+ * running the hashing stage, the blocks will be hashed by the caller.  This must be called while
+ * holding the pipeline lock, and the lock will be held when this returns.
+ *
+ * @param pipeline The pipeline to wait on.
+ * @param limit The number of blocks that can remain queued.
+ */
+static void flash_hash_pipeline_drain (struct flash_hash_pipeline *pipeline, size_t limit)
+{
+	while (pipeline->queued > limit) {
+		if (!pipeline->running && !pipeline->hashing) {
+			flash_hash_pipeline_hash_block (pipeline);
+
+			/* A hashing stage that started during the update needs to pick up the next block. */
+			platform_semaphore_post (&pipeline->filled);
+		}
+		else {
+			platform_mutex_unlock (&pipeline->lock);
+			platform_semaphore_wait (&pipeline->emptied, 0);
+			platform_mutex_lock (&pipeline->lock);
+		}
+	}
+}
+
+/**
+ * Update a hash for a group of noncontiguous blocks of data stored in a flash device using a
+ * hashing pipeline.  Flash data is read into the block buffers by the calling context while
+ * previous blocks are being hashed.
  *
  * The hash context must already be started prior to this call.  The hashing context will not be
  * canceled on failure.
  *
+ * @param pipeline The pipeline to use for hashing.
  * @param flash The flash device that contains the data to hash.
  * @param offset An offset to apply to each region address.
  * @param regions The group of regions that should be hashed as a single region.
@@ -569,46 +913,67 @@ uint8_t hash_buffer[FLASH_VERIFICATION_SIZE];
  *
  * @return 0 if the hash was updated successfully or an error code.
  */
-int flash_hash_update_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
-	const struct flash_region *regions, size_t count, struct hash_engine *hash)
+int flash_hash_pipeline_update (struct flash_hash_pipeline *pipeline, const struct flash *flash,
+	uint32_t offset, const struct flash_region *regions, size_t count, struct hash_engine *hash)
 {
-	//uint8_t data[FLASH_VERIFICATION_BLOCK];
-	size_t next_read;
-	uint32_t current_addr;
-	size_t remaining;
-	size_t i;
+	struct flash_hash_read_position pos = {0, 0};
+	size_t length = 0;
+	size_t block;
 	int status;
 
-	if ((flash == NULL) || (regions == NULL) || (count == 0) || (hash == NULL)) {
+	if ((pipeline == NULL) || (flash == NULL) || (regions == NULL) || (count == 0) ||
+		(hash == NULL)) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
-	for (i = 0; i < count; i++) {
-		current_addr = regions[i].start_addr + offset;
-		remaining = regions[i].length;
+	platform_mutex_lock (&pipeline->lock);
 
-		while (remaining > 0) {
-			next_read = (remaining < FLASH_VERIFICATION_SIZE) ?
-				remaining : FLASH_VERIFICATION_SIZE;
+	if (pipeline->busy) {
+		platform_mutex_unlock (&pipeline->lock);
+		return FLASH_UTIL_PIPELINE_BUSY;
+	}
 
-			status = flash->read (flash, current_addr, hash_buffer, next_read);
-			if (status != 0) {
-				return status;
-			}
+	pipeline->busy = true;
+	pipeline->hash = hash;
+	pipeline->status = 0;
 
-			status = hash->update (hash, hash_buffer, next_read);
-			if (status != 0) {
-				return status;
-			}
+	do {
+		/* Wait for a buffer to be available.  This also reports hashing failures for data
+		 * previously submitted to the pipeline. */
+		flash_hash_pipeline_drain (pipeline, FLASH_HASH_PIPELINE_DEPTH - 1);
+		status = pipeline->status;
+		if (status != 0) {
+			break;
+		}
+
+		/* Only queued buffers are accessed by the hashing stage, so the next free buffer can be
+		 * filled without holding the lock. */
+		block = (pipeline->head + pipeline->queued) % FLASH_HASH_PIPELINE_DEPTH;
+		platform_mutex_unlock (&pipeline->lock);
 
-			remaining -= next_read;
-			current_addr += next_read;
+		status = flash_hash_read_block (flash, offset, regions, count, &pos,
+			pipeline->buffer[block], FLASH_HASH_BLOCK_SIZE, &length);
+
+		platform_mutex_lock (&pipeline->lock);
+		if ((status == 0) && (length != 0)) {
+			pipeline->length[block] = length;
+			pipeline->queued++;
+			platform_semaphore_post (&pipeline->filled);
 		}
+	} while ((status == 0) && (length != 0));
+
+	/* Wait for all outstanding blocks to be hashed before the caller can finish the hash. */
+	flash_hash_pipeline_drain (pipeline, 0);
+	if (status == 0) {
+		status = pipeline->status;
 	}
 
-	return 0;
+	pipeline->hash = NULL;
+	pipeline->busy = false;
+	platform_mutex_unlock (&pipeline->lock);
+
+	return status;
 }
-#endif
 
 /**
  * Erase a region of flash.
@@ -692,6 +1057,133 @@ int flash_sector_erase_region (const struct flash *flash, uint32_t start_addr, s
 		flash->sector_erase);
 }
 
+/**
+ * Erase a region of flash using the largest erase operations possible.  The erasure will cover
+ * exactly the flash sectors that contain the region, typically 4kB, but any part of the region
+ * that contains complete, aligned flash blocks, typically 64kB, will be erased with block erase
+ * commands.  If the region covers the entire flash device, a single chip erase will be used.
+ *
+ * The total amount of data erased from the flash could be up to two flash sectors more than
+ * requested, depending on the defined region.
+ *
+ * @param flash The flash device to erase.
+ * @param start_addr The starting address of the region to erase.  The erase operation will actually
+ * start at the beginning of the flash sector that contains the starting address.
+ * @param length The number of bytes to erase starting from start_addr.  Any additional data that
+ * needs to be erased to align to sector boundaries does not count toward this length.
+ *
+ * @return 0 if the region was successfully erased or an error code.
+ */
+int flash_optimal_erase_region (const struct flash *flash, uint32_t start_addr, size_t length)
+{
+	uint32_t sector;
+	uint32_t block;
+	uint32_t device_size;
+	size_t remaining;
+	int status;
+
+	if (flash == NULL) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if (length == 0) {
+		return 0;
+	}
+
+	status = flash->get_sector_size (flash, &sector);
+	if (status != 0) {
+		return status;
+	}
+
+	status = flash->get_block_size (flash, &block);
+	if (status != 0) {
+		return status;
+	}
+
+	remaining = length + FLASH_REGION_OFFSET (start_addr, sector);
+	remaining = ((remaining + sector - 1) / sector) * sector;
+	start_addr = FLASH_REGION_BASE (start_addr, sector);
+
+	if ((start_addr == 0) && (flash->chip_erase != NULL)) {
+		status = flash->get_device_size (flash, &device_size);
+		if (status != 0) {
+			return status;
+		}
+
+		if (remaining >= device_size) {
+			return flash->chip_erase (flash);
+		}
+	}
+
+	while ((status == 0) && (remaining != 0)) {
+		if ((FLASH_REGION_OFFSET (start_addr, block) == 0) && (remaining >= block)) {
+			status = flash->block_erase (flash, start_addr);
+			start_addr += block;
+			remaining -= block;
+		}
+		else {
+			status = flash->sector_erase (flash, start_addr);
+			start_addr += sector;
+			remaining -= sector;
+		}
+	}
+
+	return status;
+}
+
+/**
+ * Check a region of flash to ensure every byte contains the same value.  Data is compared a word at
+ * a time, with a byte comparison only for any trailing bytes that don't fill a complete word.
+ *
+ * @param flash The flash device to check.
+ * @param start_addr The starting address of the region to check.
+ * @param value The value that should be in every byte.
+ * @param length The size of the flash region to check.
+ *
+ * @return 0 if the region contains the expected data or an error code.
+ */
+static int flash_check_region_for_value (const struct flash *flash, uint32_t start_addr,
+	uint8_t value, size_t length)
+{
+	uint64_t block[FLASH_BLANK_CHECK_BLOCK / sizeof (uint64_t)];
+	uint64_t pattern = value * 0x0101010101010101ULL;
+	const uint8_t *tail;
+	size_t read_len;
+	size_t words;
+	int flash_good = 0;
+	size_t i;
+
+	if (flash == NULL) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	while ((flash_good == 0) && (length > 0)) {
+		read_len = (length > sizeof (block)) ? sizeof (block) : length;
+
+		flash_good = flash->read (flash, start_addr, (uint8_t*) block, read_len);
+		if (flash_good == 0) {
+			words = read_len / sizeof (uint64_t);
+			for (i = 0; i < words; i++) {
+				if (block[i] != pattern) {
+					return FLASH_UTIL_DATA_MISMATCH;
+				}
+			}
+
+			tail = (const uint8_t*) &block[words];
+			for (i = 0; i < (read_len % sizeof (uint64_t)); i++) {
+				if (tail[i] != value) {
+					return FLASH_UTIL_DATA_MISMATCH;
+				}
+			}
+
+			start_addr += read_len;
+			length -= read_len;
+		}
+	}
+
+	return flash_good;
+}
+
 /**
  * Check a region of flash to ensure it contains the expected data.
  *
@@ -708,27 +1200,27 @@ static int flash_check_region_for_data (const struct flash *flash, uint32_t star
 	const uint8_t *data, size_t length, bool const_byte)
 {
 	uint8_t block[FLASH_VERIFICATION_BLOCK];
-	uint8_t next = (const_byte) ? 0 : 1;
 	size_t read_len;
 	int flash_good = 0;
-	size_t i;
 
 	if (flash == NULL) {
 		return FLASH_UTIL_INVALID_ARGUMENT;
 	}
 
+	if (const_byte) {
+		return flash_check_region_for_value (flash, start_addr, *data, length);
+	}
+
 	while ((flash_good == 0) && (length > 0)) {
 		read_len = (length > sizeof (block)) ? sizeof (block) : length;
 
 		flash_good = flash->read (flash, start_addr, block, read_len);
 		if (flash_good == 0) {
-			for (i = 0; i < read_len; i++, data += next) {
-				if (*data != block[i]) {
-					flash_good = FLASH_UTIL_DATA_MISMATCH;
-					break;
-				}
+			if (memcmp (data, block, read_len) != 0) {
+				return FLASH_UTIL_DATA_MISMATCH;
 			}
 
+			data += read_len;
 			start_addr += read_len;
 			length -= read_len;
 		}
@@ -833,6 +1325,27 @@ int flash_sector_erase_region_and_verify (const struct flash *flash, uint32_t st
 	return flash_erase_region_and_verify_ext (flash, start_addr, length, flash_sector_erase_region);
 }
 
+/**
+ * Erase a region of flash and check that the contents are blank.  The erasure will occur on sector
+ * boundaries, typically 4kB, but will use the largest erase operations supported for the region.
+ * The total amount of data erased from the flash could be up to two flash sectors more than
+ * requested, depending on the defined region.
+ *
+ * @param flash The flash device to erase.
+ * @param start_addr The starting address of the region to erase.  The erase operation will actually
+ * start at the beginning of the flash sector that contains the starting address.
+ * @param length The number of bytes to erase starting from start_addr.  Any additional data that
+ * needs to be erased to align to sector boundaries does not count toward this length.
+ *
+ * @return 0 if the region was successfully erased or an error code.
+ */
+int flash_optimal_erase_region_and_verify (const struct flash *flash, uint32_t start_addr,
+	size_t length)
+{
+	return flash_erase_region_and_verify_ext (flash, start_addr, length,
+		flash_optimal_erase_region);
+}
+
 /**
  * Program a block of data to a flash device after first erasing the region to be programmed.
  *
@@ -1562,3 +2075,151 @@ int flash_copy_ext_to_blank_and_verify (const struct flash *dest_flash, uint32_t
 {
 	return flash_copy_data_region (dest_flash, dest_addr, src_flash, src_addr, length, NULL, 1);
 }
+
+/**
+ * Copy data stored at one flash location to another flash location, only updating the destination
+ * sectors whose contents differ from the source.  Each sector of the destination region is
+ * compared against the source data.  Sectors that already match are left untouched, while sectors
+ * that differ are erased, blank checked, and reprogrammed.
+ *
+ * Any data in a modified sector that is outside the destination region will be erased, just as it
+ * would be for a full sector copy.
+ *
+ * @param dest_flash The flash device to copy data to.
+ * @param dest_addr The starting address of the region to copy to.
+ * @param src_flash The flash device to copy data from.
+ * @param src_addr The starting address of the region to copy from.
+ * @param length The size of the region to copy.
+ * @param verify Flag indicating if the copy should be verified after the data has been written to
+ * the destination.
+ * @param rewritten Optional output for the number of bytes in the region that needed to be
+ * rewritten.  This will be valid even if the copy fails.
+ *
+ * @return 0 if the data was successfully copied or an error code.
+ */
+static int flash_copy_data_region_differences (const struct flash *dest_flash, uint32_t dest_addr,
+	const struct flash *src_flash, uint32_t src_addr, size_t length, uint8_t verify,
+	size_t *rewritten)
+{
+	uint32_t sector;
+	uint32_t page;
+	size_t sector_len;
+	int status;
+
+	if (rewritten) {
+		*rewritten = 0;
+	}
+
+	if ((dest_flash == NULL) || (src_flash == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	if (length == 0) {
+		return 0;
+	}
+
+	status = dest_flash->get_sector_size (dest_flash, &sector);
+	if (status != 0) {
+		return status;
+	}
+
+	if (dest_flash == src_flash) {
+		status = flash_check_copy_region (dest_addr, src_addr, length, FLASH_REGION_MASK (sector));
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	status = dest_flash->get_page_size (dest_flash, &page);
+	if (status != 0) {
+		return status;
+	}
+
+	if (page > FLASH_MAX_COPY_BLOCK) {
+		return FLASH_UTIL_UNSUPPORTED_PAGE_SIZE;
+	}
+
+	while (length != 0) {
+		sector_len = sector - FLASH_REGION_OFFSET (dest_addr, sector);
+		sector_len = (length > sector_len) ? sector_len : length;
+
+		status = flash_verify_copy_ext (src_flash, src_addr, dest_flash, dest_addr, sector_len);
+		if (status == FLASH_UTIL_DATA_MISMATCH) {
+			status = dest_flash->sector_erase (dest_flash, dest_addr);
+			if (status != 0) {
+				return status;
+			}
+
+			status = flash_blank_check (dest_flash, dest_addr, sector_len);
+			if (status != 0) {
+				return status;
+			}
+
+			status = flash_copy_data_to_blank_region (dest_flash, dest_addr, src_flash, src_addr,
+				sector_len, page, verify);
+			if (rewritten) {
+				*rewritten += sector_len;
+			}
+		}
+
+		if (status != 0) {
+			return status;
+		}
+
+		length -= sector_len;
+		src_addr += sector_len;
+		dest_addr += sector_len;
+	}
+
+	return 0;
+}
+
+/**
+ * Copy data stored in at a location in flash to another flash location, only erasing and
+ * programming the destination sectors that do not already contain the source data.  The source and
+ * destination flash devices can be the same or different devices.  If they are the same, then the
+ * source and destination regions must not overlap or be within the same erase block.
+ *
+ * Erase blocks are on 4kB boundaries.
+ *
+ * @param dest_flash The flash device to write the copy to.
+ * @param dest_addr The flash address where the copy will be stored.
+ * @param src_flash The flash device to read the copy from.
+ * @param src_addr The flash address where the data will be copied from.
+ * @param length The number of bytes to copy.
+ * @param rewritten Optional output for the number of bytes that were erased and reprogrammed.
+ *
+ * @return 0 if the data was successfully copied or an error code.
+ */
+int flash_sector_copy_ext_differences (const struct flash *dest_flash, uint32_t dest_addr,
+	const struct flash *src_flash, uint32_t src_addr, size_t length, size_t *rewritten)
+{
+	return flash_copy_data_region_differences (dest_flash, dest_addr, src_flash, src_addr, length,
+		0, rewritten);
+}
+
+/**
+ * Copy data stored in at a location in flash to another flash location, only erasing and
+ * programming the destination sectors that do not already contain the source data.  The source and
+ * destination flash devices can be the same or different devices.  If they are the same, then the
+ * source and destination regions must not overlap or be within the same erase block.  Any sectors
+ * that get reprogrammed will be verified after the copy.
+ *
+ * Erase blocks are on 4kB boundaries.
+ *
+ * @param dest_flash The flash device to write the copy to.
+ * @param dest_addr The flash address where the copy will be stored.
+ * @param src_flash The flash device to read the copy from.
+ * @param src_addr The flash address where the data will be copied from.
+ * @param length The number of bytes to copy.
+ * @param rewritten Optional output for the number of bytes that were erased and reprogrammed.
+ *
+ * @return 0 if the data was successfully copied or an error code.
+ */
+int flash_sector_copy_ext_differences_and_verify (const struct flash *dest_flash,
+	uint32_t dest_addr, const struct flash *src_flash, uint32_t src_addr, size_t length,
+	size_t *rewritten)
+{
+	return flash_copy_data_region_differences (dest_flash, dest_addr, src_flash, src_addr, length,
+		1, rewritten);
+}
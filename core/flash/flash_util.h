@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
+#include "platform_api.h"
 #include "status/rot_status.h"
 #include "flash.h"
 #include "crypto/hash.h"
@@ -18,6 +20,56 @@
  */
 #define	FLASH_VERIFICATION_BLOCK	4096
 
+/**
+ * The maximum block size read from the flash when checking for blank or constant value regions.
+ * The read buffer is allocated on the stack.  This must be a multiple of 8 bytes.
+ */
+#ifndef FLASH_BLANK_CHECK_BLOCK
+#define	FLASH_BLANK_CHECK_BLOCK		FLASH_VERIFICATION_BLOCK
+#endif
+
+/**
+ * Use larger blocks for pipelined flash hashing, where flash reads for the next block of data
+ * overlap with hashing of the current block.  On Zephyr, this also starts a default pipeline with a
+ * dedicated hashing thread for requests that don't provide their own pipeline.  It is enabled by
+ * default on Zephyr.  Set this to 0 to disable it.
+ */
+#ifndef FLASH_HASH_PIPELINE
+#ifdef __ZEPHYR__
+#define	FLASH_HASH_PIPELINE			1
+#else
+#define	FLASH_HASH_PIPELINE			0
+#endif
+#endif
+
+/**
+ * The block size read from flash when hashing flash contents.
+ */
+#ifndef FLASH_HASH_BLOCK_SIZE
+#if FLASH_HASH_PIPELINE
+#define	FLASH_HASH_BLOCK_SIZE		16384
+#else
+#define	FLASH_HASH_BLOCK_SIZE		FLASH_VERIFICATION_BLOCK
+#endif
+#endif
+
+/**
+ * The number of block buffers used by the flash hashing pipeline.  Two buffers allow one block to
+ * be read while another is hashed.  A third buffer can absorb variations in read and hash latency.
+ */
+#ifndef FLASH_HASH_PIPELINE_DEPTH
+#define	FLASH_HASH_PIPELINE_DEPTH	2
+#endif
+
+/**
+ * The maximum number of flash regions combined into a single block read when hashing noncontiguous
+ * flash data.  Small regions are only combined when the flash device supports reading multiple
+ * regions in one operation.  The region list is allocated on the stack.
+ */
+#ifndef FLASH_HASH_READ_REGIONS_MAX
+#define	FLASH_HASH_READ_REGIONS_MAX	8
+#endif
+
 /**
  * The maximum block size supported for flash copy operations.
  */
@@ -25,11 +77,28 @@
 
 
 /**
- * Defines a single region of flash memory.
+ * Context for pipelined flash hashing, where flash reads for the next block of data overlap with
+ * hashing of the current block.  Blocks are hashed by a dedicated context running
+ * flash_hash_pipeline_run.  If no context is running the hashing stage, blocks are hashed by the
+ * caller as buffers are needed.
+ *
+ * A pipeline can only be used for one request at a time.  Contexts that hash flash data in
+ * parallel must each have their own pipeline.
  */
-struct flash_region {
-	uint32_t start_addr;	/**< The starting address of the memory region. */
-	size_t length;			/**< The size of the region. */
+struct flash_hash_pipeline {
+	uint8_t buffer[FLASH_HASH_PIPELINE_DEPTH][FLASH_HASH_BLOCK_SIZE];	/**< Buffers for flash data. */
+	size_t length[FLASH_HASH_PIPELINE_DEPTH];	/**< Amount of data in each buffer. */
+	platform_mutex lock;						/**< Synchronization for pipeline state. */
+	platform_semaphore filled;					/**< Notification that a block is ready to hash. */
+	platform_semaphore emptied;					/**< Notification that a block has been hashed. */
+	struct hash_engine *hash;					/**< Hash engine for the active request. */
+	size_t head;								/**< The next buffer to hash. */
+	size_t queued;								/**< The number of buffers waiting to be hashed. */
+	int status;									/**< Result of hashing for the active request. */
+	bool hashing;								/**< Flag indicating the head buffer is being hashed. */
+	bool running;								/**< Flag indicating the hashing stage is running. */
+	bool busy;									/**< Flag indicating a request is using the pipeline. */
+	bool stop;									/**< Flag to stop the hashing stage. */
 };
 
 
@@ -44,6 +113,11 @@ int flash_verify_noncontiguous_contents_at_offset (const struct flash *flash, ui
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	struct rsa_engine *rsa, const uint8_t *signature, size_t sig_length,
 	const struct rsa_public_key *pub_key, uint8_t *hash_out, size_t hash_length);
+int flash_verify_noncontiguous_contents_pipelined (struct flash_hash_pipeline *pipeline,
+	const struct flash *flash, uint32_t offset, const struct flash_region *regions, size_t count,
+	struct hash_engine *hash, enum hash_type type, struct rsa_engine *rsa,
+	const uint8_t *signature, size_t sig_length, const struct rsa_public_key *pub_key,
+	uint8_t *hash_out, size_t hash_length);
 
 int flash_contents_verification (const struct flash *flash, uint32_t start_addr, size_t length,
 	struct hash_engine *hash, enum hash_type type,
@@ -66,6 +140,9 @@ int flash_hash_noncontiguous_contents (const struct flash *flash,
 int flash_hash_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	uint8_t *hash_out, size_t hash_length);
+int flash_hash_noncontiguous_contents_pipelined (struct flash_hash_pipeline *pipeline,
+	const struct flash *flash, uint32_t offset, const struct flash_region *regions, size_t count,
+	struct hash_engine *hash, enum hash_type type, uint8_t *hash_out, size_t hash_length);
 
 int flash_hash_update_contents (const struct flash *flash, uint32_t start_addr, size_t length,
 	struct hash_engine *hash);
@@ -73,9 +150,21 @@ int flash_hash_update_noncontiguous_contents (const struct flash *flash,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash);
 int flash_hash_update_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash);
+int flash_hash_update_noncontiguous_contents_pipelined (struct flash_hash_pipeline *pipeline,
+	const struct flash *flash, uint32_t offset, const struct flash_region *regions, size_t count,
+	struct hash_engine *hash);
+
+int flash_hash_pipeline_init (struct flash_hash_pipeline *pipeline);
+void flash_hash_pipeline_release (struct flash_hash_pipeline *pipeline);
+void flash_hash_pipeline_run (struct flash_hash_pipeline *pipeline);
+void flash_hash_pipeline_stop (struct flash_hash_pipeline *pipeline);
+int flash_hash_pipeline_update (struct flash_hash_pipeline *pipeline, const struct flash *flash,
+	uint32_t offset, const struct flash_region *regions, size_t count, struct hash_engine *hash);
+void flash_hash_set_default_pipeline (struct flash_hash_pipeline *pipeline);
 
 int flash_erase_region (const struct flash *flash, uint32_t start_addr, size_t length);
 int flash_sector_erase_region (const struct flash *flash, uint32_t start_addr, size_t length);
+int flash_optimal_erase_region (const struct flash *flash, uint32_t start_addr, size_t length);
 int flash_blank_check (const struct flash *flash, uint32_t start_addr, size_t length);
 int flash_value_check (const struct flash *flash, uint32_t start_addr, size_t length,
 	uint8_t value);
@@ -83,6 +172,8 @@ int flash_value_check (const struct flash *flash, uint32_t start_addr, size_t le
 int flash_erase_region_and_verify (const struct flash *flash, uint32_t start_addr, size_t length);
 int flash_sector_erase_region_and_verify (const struct flash *flash, uint32_t start_addr,
 	size_t length);
+int flash_optimal_erase_region_and_verify (const struct flash *flash, uint32_t start_addr,
+	size_t length);
 
 int flash_program_data (const struct flash *flash, uint32_t start_addr, const uint8_t *data,
 	size_t length);
@@ -130,6 +221,12 @@ int flash_copy_ext_to_blank (const struct flash *dest_flash, uint32_t dest_addr,
 int flash_copy_ext_to_blank_and_verify (const struct flash *dest_flash, uint32_t dest_addr,
 	const struct flash *src_flash, uint32_t src_addr, size_t length);
 
+int flash_sector_copy_ext_differences (const struct flash *dest_flash, uint32_t dest_addr,
+	const struct flash *src_flash, uint32_t src_addr, size_t length, size_t *rewritten);
+int flash_sector_copy_ext_differences_and_verify (const struct flash *dest_flash,
+	uint32_t dest_addr, const struct flash *src_flash, uint32_t src_addr, size_t length,
+	size_t *rewritten);
+
 
 #define	FLASH_UTIL_ERROR(code)		ROT_ERROR (ROT_MODULE_FLASH_UTIL, code)
 
@@ -149,6 +246,7 @@ enum {
 	FLASH_UTIL_UNEXPECTED_VALUE = FLASH_UTIL_ERROR (0x09),		/**< The flash does not contain the expected value. */
 	FLASH_UTIL_HASH_BUFFER_TOO_SMALL = FLASH_UTIL_ERROR (0x0a),	/**< The hash out buffer is not large enough. */
 	FLASH_UTIL_UNSUPPORTED_PAGE_SIZE = FLASH_UTIL_ERROR (0x0b),	/**< Flash page size is unsupported. */
+	FLASH_UTIL_PIPELINE_BUSY = FLASH_UTIL_ERROR (0x0c),			/**< The hashing pipeline is being used by another request. */
 };
 
 
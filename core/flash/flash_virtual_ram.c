@@ -41,6 +41,42 @@ int flash_virtual_ram_read (const struct flash *virtual_flash, uint32_t address,
 	return 0;
 }
 
+int flash_virtual_ram_read_regions (const struct flash *virtual_flash,
+	const struct flash_region *regions, size_t count, uint8_t *data, size_t length)
+{
+	struct flash_virtual_ram *ram = (struct flash_virtual_ram*) virtual_flash;
+	size_t total = 0;
+	size_t i;
+
+	if ((ram == NULL) || (regions == NULL) || (count == 0) || (data == NULL)) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < count; i++) {
+		if ((regions[i].start_addr >= ram->size) ||
+			(regions[i].length > (ram->size - regions[i].start_addr))) {
+			return FLASH_ADDRESS_OUT_OF_RANGE;
+		}
+
+		total += regions[i].length;
+	}
+
+	if (total > length) {
+		return FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&ram->state->lock);
+
+	for (i = 0; i < count; i++) {
+		memcpy (data, (ram->buffer + regions[i].start_addr), regions[i].length);
+		data += regions[i].length;
+	}
+
+	platform_mutex_unlock (&ram->state->lock);
+
+	return 0;
+}
+
 int flash_virtual_ram_get_block_size (const struct flash *virtual_flash, uint32_t *bytes)
 {
 	if ((virtual_flash == NULL) || (bytes == NULL)) {
@@ -135,6 +171,7 @@ int flash_virtual_ram_init (struct flash_virtual_ram *virtual_flash,
 
 	virtual_flash->base.get_device_size = flash_virtual_ram_get_device_size;
 	virtual_flash->base.read = flash_virtual_ram_read;
+	virtual_flash->base.read_regions = flash_virtual_ram_read_regions;
 	virtual_flash->base.get_page_size = flash_virtual_ram_get_block_size;
 	virtual_flash->base.minimum_write_per_page = flash_virtual_ram_get_block_size;
 	virtual_flash->base.write = flash_virtual_ram_write;
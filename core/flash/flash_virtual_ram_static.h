@@ -11,6 +11,8 @@
 int flash_virtual_ram_get_device_size (const struct flash *virtual_ram, uint32_t *bytes);
 int flash_virtual_ram_read (const struct flash *virtual_ram, uint32_t address, uint8_t *data,
 	size_t length);
+int flash_virtual_ram_read_regions (const struct flash *virtual_ram,
+	const struct flash_region *regions, size_t count, uint8_t *data, size_t length);
 int flash_virtual_ram_get_block_size (const struct flash *virtual_ram, uint32_t *bytes);
 int flash_virtual_ram_write (const struct flash *virtual_ram, uint32_t address,
 	const uint8_t *data, size_t length);
@@ -23,6 +25,7 @@ int flash_virtual_ram_chip_erase (const struct flash *virtual_ram);
 #define	FLASH_VIRTUAL_RAM_API_INIT  { \
 		.get_device_size = flash_virtual_ram_get_device_size, \
 		.read = flash_virtual_ram_read, \
+		.read_regions = flash_virtual_ram_read_regions, \
 		.get_page_size = flash_virtual_ram_get_block_size, \
 		.minimum_write_per_page = flash_virtual_ram_get_block_size, \
 		.write = flash_virtual_ram_write, \
@@ -9,6 +9,7 @@
 #include "flash/flash_common.h"
 #include "flash/flash_logging.h"
 #include "common/unused.h"
+#include "common/common_math.h"
 
 
 /* Status bits indicating when flash is operating in 4-byte address mode. */
@@ -443,6 +444,8 @@ static int spi_flash_init_api (struct spi_flash *flash, struct spi_flash_state *
 	flash->base.get_device_size =
 		(int (*) (const struct flash*, uint32_t*)) spi_flash_get_device_size;
 	flash->base.read = (int (*) (const struct flash*, uint32_t, uint8_t*, size_t)) spi_flash_read;
+	flash->base.read_regions = (int (*) (const struct flash*, const struct flash_region*, size_t,
+		uint8_t*, size_t)) spi_flash_read_regions;
 	flash->base.get_page_size = (int (*) (const struct flash*, uint32_t*)) spi_flash_get_page_size;
 	flash->base.minimum_write_per_page =
 		(int (*) (const struct flash*, uint32_t*)) spi_flash_minimum_write_per_page;
@@ -568,6 +571,10 @@ int spi_flash_init_state (const struct spi_flash *flash)
 	 * modes. */
 	flash->state->capabilities = (FLASH_CAP_3BYTE_ADDR | FLASH_CAP_4BYTE_ADDR);
 
+	/* The state of the device is not known until the status register has been read. */
+	flash->state->track_write = SPI_FLASH_TRACK_WRITE_STATE_DEFAULT;
+	flash->state->write_pending = true;
+
 	return 0;
 }
 
@@ -679,6 +686,7 @@ static int spi_flash_simple_command (const struct spi_flash *flash, uint8_t cmd)
  */
 static int spi_flash_write_enable (const struct spi_flash *flash)
 {
+	flash->state->write_pending = true;
 	return spi_flash_simple_command (flash, FLASH_CMD_WREN);
 }
 
@@ -691,6 +699,7 @@ static int spi_flash_write_enable (const struct spi_flash *flash)
  */
 static int spi_flash_volatile_write_enable (const struct spi_flash *flash)
 {
+	flash->state->write_pending = true;
 	return spi_flash_simple_command (flash, FLASH_CMD_VOLATILE_WREN);
 }
 
@@ -717,15 +726,160 @@ static int spi_flash_is_wip_set (const struct spi_flash *flash)
 	status = flash->spi->xfer (flash->spi, &xfer);
 	if (status == 0) {
 		if (!flash->state->use_busy_flag) {
-			return ((reg & FLASH_STATUS_WIP) != 0);
+			status = ((reg & FLASH_STATUS_WIP) != 0);
 		}
 		else {
-			return ((reg & FLASH_FLAG_STATUS_READY) == 0);
+			status = ((reg & FLASH_FLAG_STATUS_READY) == 0);
 		}
+
+		flash->state->write_pending = (status != 0);
+	}
+
+	return status;
+}
+
+/**
+ * Determine if the flash could be executing a write command before starting a new operation.  If
+ * write state tracking is enabled and the driver has not issued any write since the device was
+ * last seen to be idle, the status register will not be read.
+ *
+ * @param flash The flash instance to check.
+ *
+ * @return 0 if no write is in progress, 1 if there is, or an error code.
+ */
+static int spi_flash_is_write_pending (const struct spi_flash *flash)
+{
+	if (flash->state->track_write && !flash->state->write_pending) {
+		return 0;
+	}
+
+	return spi_flash_is_wip_set (flash);
+}
+
+/**
+ * Indicates a wait for a write operation not issued by the driver.
+ */
+#define	SPI_FLASH_OP_UNKNOWN		NUM_SPI_FLASH_WRITE_OPERATIONS
+
+/**
+ * Determine how long to wait before checking the status of a write operation again.
+ *
+ * Program and register writes complete in well under a millisecond, so the status is polled
+ * without sleeping.  For erase operations, the first delay is based on the typical erase time
+ * reported by the device.  After that, the delay starts at 1 ms and doubles after every poll up to
+ * SPI_FLASH_POLL_MAX_DELAY_MS.  Writes of unknown type are polled at the maximum delay.
+ *
+ * @param flash The flash instance that is executing a write operation.
+ * @param op The type of write operation being executed.
+ * @param polls The number of times the status has been checked.
+ *
+ * @return The number of milliseconds to wait before the next status check.
+ */
+static uint32_t spi_flash_get_poll_delay (const struct spi_flash *flash, int op, uint32_t polls)
+{
+	uint32_t typical;
+
+	switch (op) {
+		case SPI_FLASH_OP_PAGE_PROGRAM:
+		case SPI_FLASH_OP_REGISTER_WRITE:
+			return 0;
+
+		case SPI_FLASH_OP_SECTOR_ERASE:
+			typical = flash->state->timing.sector_erase_ms;
+			break;
+
+		case SPI_FLASH_OP_BLOCK_ERASE:
+			typical = flash->state->timing.block_erase_ms;
+			break;
+
+		case SPI_FLASH_OP_CHIP_ERASE:
+			typical = flash->state->timing.chip_erase_ms;
+			break;
+
+		default:
+			return SPI_FLASH_POLL_MAX_DELAY_MS;
+	}
+
+	if ((polls <= 1) && (typical > 2)) {
+		/* Skip most of the expected erase time before checking again. */
+		return typical / 2;
+	}
+	else if (polls <= 1) {
+		return 1;
+	}
+	else if ((polls - 2) >= 16) {
+		return SPI_FLASH_POLL_MAX_DELAY_MS;
 	}
 	else {
-		return status;
+		return min (1U << (polls - 2), SPI_FLASH_POLL_MAX_DELAY_MS);
+	}
+}
+
+/**
+ * Determine how long to wait for a write operation to complete.  Erase operations are limited to
+ * the maximum erase time reported by the device.  Other writes, and erase operations with no
+ * reported maximum time, wait until the device is no longer busy.
+ *
+ * @param flash The flash instance that is executing a write operation.
+ * @param op The type of write operation being executed.
+ *
+ * @return The maximum number of milliseconds to wait for completion or -1 to wait forever.
+ */
+static int32_t spi_flash_get_write_timeout (const struct spi_flash *flash, int op)
+{
+	uint32_t max_ms;
+
+	switch (op) {
+		case SPI_FLASH_OP_SECTOR_ERASE:
+			max_ms = flash->state->timing.sector_erase_max_ms;
+			break;
+
+		case SPI_FLASH_OP_BLOCK_ERASE:
+			max_ms = flash->state->timing.block_erase_max_ms;
+			break;
+
+		case SPI_FLASH_OP_CHIP_ERASE:
+			max_ms = flash->state->timing.chip_erase_max_ms;
+			break;
+
+		default:
+			return -1;
+	}
+
+	if ((max_ms == 0) || (max_ms > INT32_MAX)) {
+		return -1;
+	}
+
+	return max_ms;
+}
+
+/**
+ * Add a completed write operation to the latency histogram.
+ *
+ * @param flash The flash instance that executed the write operation.
+ * @param op The type of write operation that completed.
+ * @param start The time when the operation started.
+ * @param polls The number of status checks needed to detect completion.
+ */
+static void spi_flash_record_write_latency (const struct spi_flash *flash, int op,
+	const platform_clock *start, uint32_t polls)
+{
+	platform_clock end;
+	uint32_t elapsed;
+	int bucket = 0;
+
+	if ((op >= NUM_SPI_FLASH_WRITE_OPERATIONS) || (platform_init_current_tick (&end) != 0)) {
+		return;
 	}
+
+	elapsed = platform_get_duration (start, &end);
+	while (elapsed && (bucket < (SPI_FLASH_LATENCY_BUCKETS - 1))) {
+		elapsed >>= 1;
+		bucket++;
+	}
+
+	flash->state->latency[op].bucket[bucket]++;
+	flash->state->latency[op].polls += polls;
 }
 
 /**
@@ -734,14 +888,18 @@ static int spi_flash_is_wip_set (const struct spi_flash *flash)
  * @param flash The flash instance that is executing a write operation.
  * @param timeout The maximum number of milliseconds to wait for completion.  A negative number will
  * wait forever.  0 will return immediately.
- * @param no_sleep Flag indicating no sleep should be inserted between status reads.
+ * @param op The type of write operation being executed.  This determines how often the status is
+ * checked.  Use SPI_FLASH_OP_UNKNOWN when waiting on a write not issued by the driver.
  *
  * @return 0 if the write was completed or an error code.
  */
 static int spi_flash_wait_for_write_completion (const struct spi_flash *flash, int32_t timeout,
-	uint8_t no_sleep)
+	int op)
 {
 	platform_clock timeout_val;
+	platform_clock start;
+	uint32_t polls = 0;
+	uint32_t delay;
 	int done = 0;
 	int status;
 
@@ -752,8 +910,12 @@ static int spi_flash_wait_for_write_completion (const struct spi_flash *flash, i
 		}
 	}
 
+	platform_init_current_tick (&start);
+
 	do {
 		status = spi_flash_is_wip_set (flash);
+		polls++;
+
 		if (status == 0) {
 			done = 1;
 		}
@@ -768,13 +930,18 @@ static int spi_flash_wait_for_write_completion (const struct spi_flash *flash, i
 			}
 
 			if (status == 0) {
-				if (!no_sleep) {
-					platform_msleep (10);
+				delay = spi_flash_get_poll_delay (flash, op, polls);
+				if (delay) {
+					platform_msleep (delay);
 				}
 			}
 		}
 	} while ((status == 0) && !done);
 
+	if (done) {
+		spi_flash_record_write_latency (flash, op, &start, polls);
+	}
+
 	return status;
 }
 
@@ -796,7 +963,7 @@ static int spi_flash_write_register (const struct spi_flash *flash, uint8_t cmd,
 	struct flash_xfer xfer;
 	int status;
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_is_write_pending (flash);
 	if (status != 0) {
 		return (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 	}
@@ -817,7 +984,7 @@ static int spi_flash_write_register (const struct spi_flash *flash, uint8_t cmd,
 		return status;
 	}
 
-	return spi_flash_wait_for_write_completion (flash, -1, 1);
+	return spi_flash_wait_for_write_completion (flash, -1, SPI_FLASH_OP_REGISTER_WRITE);
 }
 
 /**
@@ -907,6 +1074,9 @@ int spi_flash_discover_device_properties (const struct spi_flash *flash,
 	flash->state->use_busy_flag = spi_flash_sfdp_use_busy_flag_status (&parameters);
 	flash->state->sr1_volatile = spi_flash_sfdp_use_volatile_write_enable (&parameters);
 
+	/* Timing information is only used to tune status polling, so it is not required. */
+	spi_flash_sfdp_get_operation_timing (&parameters, &flash->state->timing);
+
 	status = 0;
 
 exit:
@@ -1095,6 +1265,9 @@ static int spi_flash_execute_reset_device (const struct spi_flash *flash, uint32
 {
 	int status;
 
+	/* The device may not be ready immediately after reset. */
+	flash->state->write_pending = true;
+
 	if (flash->state->command.reset == FLASH_CMD_RST) {
 		status = spi_flash_simple_command (flash, FLASH_CMD_RSTEN);
 		if (status != 0) {
@@ -1320,6 +1493,9 @@ int spi_flash_deep_power_down (const struct spi_flash *flash, uint8_t enable)
 
 	platform_mutex_lock (&flash->state->lock);
 
+	/* Status must be checked again after leaving deep power down. */
+	flash->state->write_pending = true;
+
 	if (enable) {
 		status = spi_flash_simple_command (flash, flash->state->command.enter_pwrdown);
 	}
@@ -1932,7 +2108,7 @@ int spi_flash_read (const struct spi_flash *flash, uint32_t address, uint8_t *da
 
 	platform_mutex_lock (&flash->state->lock);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_is_write_pending (flash);
 	if (status != 0) {
 		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
@@ -1948,6 +2124,111 @@ exit:
 	return status;
 }
 
+/**
+ * Execute a list of transfers against the flash device.  If the SPI master supports batched
+ * transfers, the list is submitted in a single request.  Otherwise, each transfer is submitted
+ * individually.
+ *
+ * @param flash The flash device to access.
+ * @param xfer The list of transfers to execute.
+ * @param count The number of transfers in the list.
+ *
+ * @return 0 if all transfers were successful or an error code.
+ */
+static int spi_flash_xfer_batch (const struct spi_flash *flash, const struct flash_xfer *xfer,
+	size_t count)
+{
+	size_t i;
+	int status;
+
+	if (flash->spi->xfer_batch != NULL) {
+		return flash->spi->xfer_batch (flash->spi, xfer, count);
+	}
+
+	for (i = 0; i < count; i++) {
+		status = flash->spi->xfer (flash->spi, &xfer[i]);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Read multiple regions of the SPI flash as a single operation.  The device is locked for the
+ * duration of all reads, and when the SPI master supports it, the reads are submitted as a batch of
+ * transfers.
+ *
+ * @param flash The flash to read from.
+ * @param regions The list of flash regions to read.
+ * @param count The number of regions in the list.
+ * @param data The buffer to hold the data that has been read.  The data for each region is placed
+ * immediately after the data for the previous region.
+ * @param length The size of the data buffer.
+ *
+ * @return 0 if all regions were read from flash or an error code.
+ */
+int spi_flash_read_regions (const struct spi_flash *flash, const struct flash_region *regions,
+	size_t count, uint8_t *data, size_t length)
+{
+	struct flash_xfer xfer[SPI_FLASH_READ_BATCH_SIZE];
+	size_t total = 0;
+	size_t queued = 0;
+	size_t i;
+	int status;
+
+	if ((flash == NULL) || (regions == NULL) || (count == 0) || (data == NULL)) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < count; i++) {
+		SPI_FLASH_BOUNDS_CHECK (flash->state->device_size, regions[i].start_addr,
+			regions[i].length);
+		total += regions[i].length;
+	}
+
+	if (total > length) {
+		return SPI_FLASH_SMALL_BUFFER;
+	}
+
+	platform_mutex_lock (&flash->state->lock);
+
+	status = spi_flash_is_write_pending (flash);
+	if (status != 0) {
+		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
+		goto exit;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (regions[i].length == 0) {
+			continue;
+		}
+
+		FLASH_XFER_INIT_READ (xfer[queued], flash->state->command.read, regions[i].start_addr,
+			flash->state->command.read_dummy, flash->state->command.read_mode, data,
+			regions[i].length, flash->state->command.read_flags | flash->state->addr_mode);
+		data += regions[i].length;
+
+		if (++queued == SPI_FLASH_READ_BATCH_SIZE) {
+			status = spi_flash_xfer_batch (flash, xfer, queued);
+			if (status != 0) {
+				goto exit;
+			}
+
+			queued = 0;
+		}
+	}
+
+	if (queued != 0) {
+		status = spi_flash_xfer_batch (flash, xfer, queued);
+	}
+
+exit:
+	platform_mutex_unlock (&flash->state->lock);
+	return status;
+}
+
 /**
  * Get the size of a flash page for write operations.
  *
@@ -2026,7 +2307,7 @@ int spi_flash_write (const struct spi_flash *flash, uint32_t address, const uint
 
 	platform_mutex_lock (&flash->state->lock);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_is_write_pending (flash);
 	if (status != 0) {
 		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
@@ -2053,7 +2334,8 @@ int spi_flash_write (const struct spi_flash *flash, uint32_t address, const uint
 
 		status = flash->spi->xfer (flash->spi, &xfer);
 		if (status == 0) {
-			status = spi_flash_wait_for_write_completion (flash, -1, 1);
+			status = spi_flash_wait_for_write_completion (flash, -1,
+				SPI_FLASH_OP_PAGE_PROGRAM);
 			if (status == 0) {
 				remaining -= write_len;
 				data += write_len;
@@ -2099,11 +2381,12 @@ int spi_flash_write_read_only (const struct flash *flash, uint32_t address, cons
  * @param address An address within the region to erase.
  * @param erase_cmd The erase command to use.
  * @param erase_flags Transfer flags for the command.
+ * @param op The type of erase being executed.
  *
  * @return 0 if the region was erased or an error code.
  */
 static int spi_flash_erase_region (const struct spi_flash *flash, uint32_t address,
-	uint8_t erase_cmd, uint16_t erase_flags)
+	uint8_t erase_cmd, uint16_t erase_flags, enum spi_flash_write_operation op)
 {
 	struct flash_xfer xfer;
 	int status;
@@ -2114,7 +2397,7 @@ static int spi_flash_erase_region (const struct spi_flash *flash, uint32_t addre
 
 	platform_mutex_lock (&flash->state->lock);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_is_write_pending (flash);
 	if (status != 0) {
 		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
@@ -2132,7 +2415,8 @@ static int spi_flash_erase_region (const struct spi_flash *flash, uint32_t addre
 		goto exit;
 	}
 
-	status = spi_flash_wait_for_write_completion (flash, -1, 0);
+	status = spi_flash_wait_for_write_completion (flash, spi_flash_get_write_timeout (flash, op),
+		op);
 
 exit:
 	platform_mutex_unlock (&flash->state->lock);
@@ -2174,7 +2458,8 @@ int spi_flash_sector_erase (const struct spi_flash *flash, uint32_t sector_addr)
 	}
 
 	return spi_flash_erase_region (flash, FLASH_SECTOR_BASE (sector_addr),
-		flash->state->command.erase_sector, flash->state->command.sector_flags);
+		flash->state->command.erase_sector, flash->state->command.sector_flags,
+		SPI_FLASH_OP_SECTOR_ERASE);
 }
 
 /* API handler for sector_erase and block_erase when statically initialized for read only access. */
@@ -2221,7 +2506,8 @@ int spi_flash_block_erase (const struct spi_flash *flash, uint32_t block_addr)
 	}
 
 	return spi_flash_erase_region (flash, FLASH_BLOCK_BASE (block_addr),
-		flash->state->command.erase_block, flash->state->command.block_flags);
+		flash->state->command.erase_block, flash->state->command.block_flags,
+		SPI_FLASH_OP_BLOCK_ERASE);
 }
 
 /**
@@ -2241,7 +2527,7 @@ int spi_flash_chip_erase (const struct spi_flash *flash)
 
 	platform_mutex_lock (&flash->state->lock);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_is_write_pending (flash);
 	if (status != 0) {
 		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
@@ -2257,7 +2543,8 @@ int spi_flash_chip_erase (const struct spi_flash *flash)
 		goto exit;
 	}
 
-	status = spi_flash_wait_for_write_completion (flash, -1, 0);
+	status = spi_flash_wait_for_write_completion (flash,
+		spi_flash_get_write_timeout (flash, SPI_FLASH_OP_CHIP_ERASE), SPI_FLASH_OP_CHIP_ERASE);
 
 exit:
 	platform_mutex_unlock (&flash->state->lock);
@@ -2312,8 +2599,83 @@ int spi_flash_wait_for_write (const struct spi_flash *flash, int32_t timeout)
 	}
 
 	platform_mutex_lock (&flash->state->lock);
-	status = spi_flash_wait_for_write_completion (flash, timeout, 0);
+	status = spi_flash_wait_for_write_completion (flash, timeout, SPI_FLASH_OP_UNKNOWN);
 	platform_mutex_unlock (&flash->state->lock);
 
 	return status;
 }
+
+/**
+ * Enable or disable tracking of outstanding program and erase operations.  While tracking is
+ * enabled, operations will not check the status register for a write in progress unless the driver
+ * has issued a command that could leave the device busy.
+ *
+ * Tracking must not be enabled if the flash device is accessible by any other SPI master, since
+ * writes from other masters cannot be detected.  In these cases, the status register is checked
+ * before every operation.
+ *
+ * @param flash The flash to configure.
+ * @param enable true to enable write state tracking or false to check the status register before
+ * every operation.
+ *
+ * @return 0 if write state tracking was configured or an error code.
+ */
+int spi_flash_enable_write_state_tracking (const struct spi_flash *flash, bool enable)
+{
+	if (flash == NULL) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->state->lock);
+
+	flash->state->track_write = enable;
+	flash->state->write_pending = true;
+
+	platform_mutex_unlock (&flash->state->lock);
+	return 0;
+}
+
+/**
+ * Get the latency histogram for a type of write operation.  Only operations that completed are
+ * included in the histogram.
+ *
+ * @param flash The flash to query.
+ * @param op The type of write operation to query.
+ * @param histogram Output for the latency histogram.
+ *
+ * @return 0 if the histogram was retrieved successfully or an error code.
+ */
+int spi_flash_get_write_latency (const struct spi_flash *flash, enum spi_flash_write_operation op,
+	struct spi_flash_latency_histogram *histogram)
+{
+	if ((flash == NULL) || (histogram == NULL) || ((int) op < 0) ||
+		(op >= NUM_SPI_FLASH_WRITE_OPERATIONS)) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->state->lock);
+	memcpy (histogram, &flash->state->latency[op], sizeof (struct spi_flash_latency_histogram));
+	platform_mutex_unlock (&flash->state->lock);
+
+	return 0;
+}
+
+/**
+ * Clear the latency histograms for all write operations.
+ *
+ * @param flash The flash to update.
+ *
+ * @return 0 if the histograms were cleared successfully or an error code.
+ */
+int spi_flash_clear_write_latency (const struct spi_flash *flash)
+{
+	if (flash == NULL) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->state->lock);
+	memset (flash->state->latency, 0, sizeof (flash->state->latency));
+	platform_mutex_unlock (&flash->state->lock);
+
+	return 0;
+}
@@ -12,6 +12,63 @@
 #include "flash_master.h"
 #include "spi_flash_sfdp.h"
 #include "platform_api.h"
+#include "platform_config.h"
+
+
+/* Configurable SPI flash parameters.  Defaults can be overridden in platform_config.h. */
+#ifndef SPI_FLASH_TRACK_WRITE_STATE_DEFAULT
+/**
+ * Default setting for tracking outstanding program and erase operations in the driver.  When
+ * tracking is enabled, the status register is not polled before an operation if the driver knows
+ * there is no write in progress.  This must only be enabled for devices that are not shared with
+ * any other SPI master that could start a write without the driver being aware.
+ */
+#define	SPI_FLASH_TRACK_WRITE_STATE_DEFAULT		false
+#endif
+
+#ifndef SPI_FLASH_POLL_MAX_DELAY_MS
+/**
+ * The longest time to wait between status register reads while waiting for an erase to complete,
+ * in milliseconds.  Erase polling starts with shorter delays and backs off up to this limit.
+ */
+#define	SPI_FLASH_POLL_MAX_DELAY_MS				10
+#endif
+
+#ifndef SPI_FLASH_READ_BATCH_SIZE
+/**
+ * The maximum number of read transfers submitted to the SPI master at once when reading multiple
+ * regions of flash.  The transfer descriptors are allocated on the stack.
+ */
+#define	SPI_FLASH_READ_BATCH_SIZE				8
+#endif
+
+/**
+ * The number of buckets in each write latency histogram.
+ */
+#define	SPI_FLASH_LATENCY_BUCKETS				12
+
+
+/**
+ * Operations that require waiting for the flash device to finish writing.
+ */
+enum spi_flash_write_operation {
+	SPI_FLASH_OP_PAGE_PROGRAM = 0,		/**< Program data to a single page. */
+	SPI_FLASH_OP_REGISTER_WRITE,		/**< Write to a device register. */
+	SPI_FLASH_OP_SECTOR_ERASE,			/**< Erase a 4kB sector. */
+	SPI_FLASH_OP_BLOCK_ERASE,			/**< Erase a 64kB block. */
+	SPI_FLASH_OP_CHIP_ERASE,			/**< Erase the entire device. */
+	NUM_SPI_FLASH_WRITE_OPERATIONS		/**< Number of write operations that are tracked. */
+};
+
+/**
+ * Distribution of completion times for a single type of write operation.  Bucket 0 counts
+ * operations that completed in less than 1 ms.  Bucket n counts operations that took between
+ * 2^(n-1) and 2^n - 1 ms, with the last bucket also counting all longer operations.
+ */
+struct spi_flash_latency_histogram {
+	uint32_t bucket[SPI_FLASH_LATENCY_BUCKETS];			/**< Number of operations in each latency range. */
+	uint32_t polls;										/**< Total status reads needed for completion. */
+};
 
 
 /**
@@ -49,6 +106,10 @@ struct spi_flash_state {
 	bool reset_3byte;									/**< Flag to switch to 3-byte mode on reset. */
 	enum spi_flash_sfdp_quad_enable quad_enable;		/**< Method to enable QSPI. */
 	bool sr1_volatile;									/**< Flag to use volatile write enable for status register 1. */
+	bool track_write;									/**< Flag to skip WIP checks when no write is outstanding. */
+	bool write_pending;									/**< Flag indicating the device may be executing a write. */
+	struct spi_flash_sfdp_timing timing;				/**< Program and erase times reported by the device. */
+	struct spi_flash_latency_histogram latency[NUM_SPI_FLASH_WRITE_OPERATIONS];	/**< Latency of write operations. */
 };
 
 /**
@@ -157,6 +218,8 @@ int spi_flash_is_quad_spi_enabled (const struct spi_flash *flash);
 int spi_flash_configure_drive_strength (const struct spi_flash *flash);
 
 int spi_flash_read (const struct spi_flash *flash, uint32_t address, uint8_t *data, size_t length);
+int spi_flash_read_regions (const struct spi_flash *flash, const struct flash_region *regions,
+	size_t count, uint8_t *data, size_t length);
 
 int spi_flash_get_page_size (const struct spi_flash *flash, uint32_t *bytes);
 int spi_flash_minimum_write_per_page (const struct spi_flash *flash, uint32_t *bytes);
@@ -173,6 +236,11 @@ int spi_flash_chip_erase (const struct spi_flash *flash);
 
 int spi_flash_is_write_in_progress (const struct spi_flash *flash);
 int spi_flash_wait_for_write (const struct spi_flash *flash, int32_t timeout);
+int spi_flash_enable_write_state_tracking (const struct spi_flash *flash, bool enable);
+
+int spi_flash_get_write_latency (const struct spi_flash *flash, enum spi_flash_write_operation op,
+	struct spi_flash_latency_histogram *histogram);
+int spi_flash_clear_write_latency (const struct spi_flash *flash);
 
 
 #define	SPI_FLASH_ERROR(code)		ROT_ERROR (ROT_MODULE_SPI_FLASH, code)
@@ -197,6 +265,7 @@ enum {
 	SPI_FLASH_RESET_NOT_SUPPORTED = SPI_FLASH_ERROR (0x0d),		/**< Soft reset is not supported by the device. */
 	SPI_FLASH_PWRDOWN_NOT_SUPPORTED = SPI_FLASH_ERROR (0x0e),	/**< Deep power down is not supported by the device. */
 	SPI_FLASH_READ_ONLY_INTERFACE = SPI_FLASH_ERROR (0x0f),		/**< The interface is only configured to allow read access. */
+	SPI_FLASH_SMALL_BUFFER = SPI_FLASH_ERROR (0x10),			/**< The output buffer is not large enough for the requested data. */
 };
 
 
@@ -86,9 +86,13 @@ struct spi_flash_sfdp_basic_parameter_table_1_0 {
 struct spi_flash_sfdp_basic_parameter_table_1_5 {
 	struct spi_flash_sfdp_basic_parameter_table_1_0 table_1_0;
 	uint32_t erase_time;			/**< 10th DWORD: Erase typical timing. */
+#define	SPI_FLASH_SFDP_ERASE_MAX_MULT(x)	((((x) & 0x0f) + 1) * 2)
+#define	SPI_FLASH_SFDP_ERASE_TIME(x, n)		(((x) >> (4 + (7 * (n)))) & 0x7f)
 	uint8_t page_size;				/**< 11th DWORD: Page size. */
 #define	SPI_FLASH_SFDP_PAGE_SIZE(x)			(((x) & 0xf0) >> 4)
+#define	SPI_FLASH_SFDP_PROGRAM_MAX_MULT(x)	((((x) & 0x0f) + 1) * 2)
 	uint16_t program_time;			/**< 11th DWORD: Page programming typical timing. */
+#define	SPI_FLASH_SFDP_PROGRAM_TIME(x)		((x) & 0x3f)
 	uint8_t chip_erase_time;		/**< 11th DWORD: Chip erase typical timing. */
 	uint32_t suspend_attr;			/**< 12th DWORD: Suspend/Resume attributes. */
 	uint8_t program_resume;			/**< 13th DWORD: Program Resume instruction. */
@@ -823,6 +827,85 @@ int spi_flash_sfdp_get_deep_powerdown_commands (const struct spi_flash_sfdp_basi
 	return status;
 }
 
+/**
+ * Convert an SFDP timing value to a time.  Timing values are encoded as a count in the lower 5 bits
+ * and an index into a table of units in the upper bits.
+ *
+ * @param value The encoded timing value.
+ * @param units The time units for each possible index.
+ *
+ * @return The decoded time.
+ */
+static uint32_t spi_flash_sfdp_decode_time (uint8_t value, const uint32_t *units)
+{
+	return ((value & 0x1f) + 1) * units[value >> 5];
+}
+
+/**
+ * Get the typical and maximum times for program and erase operations reported by the device.
+ *
+ * @param table The basic parameters table that will be queried.
+ * @param timing Output for the operation timing.  Any operation not reported by the device will
+ * have a time of 0.
+ *
+ * @return 0 if the operation timing was retrieved successfully or an error code.
+ */
+int spi_flash_sfdp_get_operation_timing (const struct spi_flash_sfdp_basic_table *table,
+	struct spi_flash_sfdp_timing *timing)
+{
+	const uint32_t erase_units[] = {1, 16, 128, 1000};
+	const uint32_t program_units[] = {8, 64};
+	const uint32_t chip_units[] = {16, 256, 4000, 64000};
+	struct spi_flash_sfdp_basic_parameter_table_1_5 *params;
+	const uint8_t *erase_size;
+	uint32_t erase_ms;
+	int i;
+
+	if ((table == NULL) || (timing == NULL)) {
+		return SPI_FLASH_SFDP_INVALID_ARGUMENT;
+	}
+
+	memset (timing, 0, sizeof (struct spi_flash_sfdp_timing));
+
+	if (table->sfdp->sfdp_header.parameter0.minor_revision < 5) {
+		return SPI_FLASH_SFDP_TIMING_UNKNOWN;
+	}
+
+	params = (struct spi_flash_sfdp_basic_parameter_table_1_5*) table->data;
+
+	timing->page_program_us =
+		spi_flash_sfdp_decode_time (SPI_FLASH_SFDP_PROGRAM_TIME (params->program_time),
+			program_units);
+	timing->page_program_max_us =
+		timing->page_program_us * SPI_FLASH_SFDP_PROGRAM_MAX_MULT (params->page_size);
+
+	timing->chip_erase_ms = spi_flash_sfdp_decode_time (params->chip_erase_time & 0x7f,
+		chip_units);
+	timing->chip_erase_max_ms =
+		timing->chip_erase_ms * SPI_FLASH_SFDP_ERASE_MAX_MULT (params->erase_time);
+
+	/* Erase times are reported for each erase type.  Find the types that match the sector and
+	 * block sizes used by the driver. */
+	erase_size = &params->table_1_0.erase1_size;
+	for (i = 0; i < 4; i++, erase_size += 2) {
+		erase_ms = spi_flash_sfdp_decode_time (SPI_FLASH_SFDP_ERASE_TIME (params->erase_time, i),
+			erase_units);
+
+		if (*erase_size == 12) {
+			timing->sector_erase_ms = erase_ms;
+			timing->sector_erase_max_ms =
+				erase_ms * SPI_FLASH_SFDP_ERASE_MAX_MULT (params->erase_time);
+		}
+		else if (*erase_size == 16) {
+			timing->block_erase_ms = erase_ms;
+			timing->block_erase_max_ms =
+				erase_ms * SPI_FLASH_SFDP_ERASE_MAX_MULT (params->erase_time);
+		}
+	}
+
+	return 0;
+}
+
 /**
  * Print the contents of the basic parameters table.
  *
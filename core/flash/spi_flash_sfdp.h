@@ -110,6 +110,21 @@ enum spi_flash_sfdp_quad_enable {
 	SPI_FLASH_SFDP_QUAD_NO_QE_HOLD_DISABLE = 8,		/**< No quad enable bit, but HOLD/RESET can be disabled. */
 };
 
+/**
+ * Typical and maximum times for flash program and erase operations.  A value of 0 indicates the
+ * time is not reported by the device.
+ */
+struct spi_flash_sfdp_timing {
+	uint32_t page_program_us;					/**< Typical page program time, in microseconds. */
+	uint32_t page_program_max_us;				/**< Maximum page program time, in microseconds. */
+	uint32_t sector_erase_ms;					/**< Typical 4kB erase time, in milliseconds. */
+	uint32_t sector_erase_max_ms;				/**< Maximum 4kB erase time, in milliseconds. */
+	uint32_t block_erase_ms;					/**< Typical 64kB erase time, in milliseconds. */
+	uint32_t block_erase_max_ms;				/**< Maximum 64kB erase time, in milliseconds. */
+	uint32_t chip_erase_ms;						/**< Typical chip erase time, in milliseconds. */
+	uint32_t chip_erase_max_ms;					/**< Maximum chip erase time, in milliseconds. */
+};
+
 
 int spi_flash_sfdp_basic_table_init (struct spi_flash_sfdp_basic_table *table,
 	const struct spi_flash_sfdp *sfdp);
@@ -139,6 +154,9 @@ int spi_flash_sfdp_get_reset_command (const struct spi_flash_sfdp_basic_table *t
 int spi_flash_sfdp_get_deep_powerdown_commands (const struct spi_flash_sfdp_basic_table *table,
 	uint8_t *enter, uint8_t *exit);
 
+int spi_flash_sfdp_get_operation_timing (const struct spi_flash_sfdp_basic_table *table,
+	struct spi_flash_sfdp_timing *timing);
+
 void spi_flash_sfdp_dump_basic_table (const struct spi_flash_sfdp_basic_table *table);
 
 
@@ -157,6 +175,7 @@ enum {
 	SPI_FLASH_SFDP_QUAD_ENABLE_UNKNOWN = SPI_FLASH_SFDP_ERROR (0x06),	/**< QSPI enabled method cannot be determined. */
 	SPI_FLASH_SFDP_RESET_NOT_SUPPORTED = SPI_FLASH_SFDP_ERROR (0x07),	/**< Soft reset is not supported by the device. */
 	SPI_FLASH_SFDP_PWRDOWN_NOT_SUPPORTED = SPI_FLASH_SFDP_ERROR (0x08),	/**< Deep power down is not supported by the device. */
+	SPI_FLASH_SFDP_TIMING_UNKNOWN = SPI_FLASH_SFDP_ERROR (0x09),		/**< Operation timing is not reported by the device. */
 };
 
 
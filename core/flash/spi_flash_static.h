@@ -21,6 +21,8 @@ int spi_flash_chip_erase_read_only (const struct flash *flash);
 #define	SPI_FLASH_API_INIT  { \
 		.get_device_size = (int (*) (const struct flash*, uint32_t*)) spi_flash_get_device_size, \
 		.read = (int (*) (const struct flash*, uint32_t, uint8_t*, size_t)) spi_flash_read, \
+		.read_regions = (int (*) (const struct flash*, const struct flash_region*, size_t, \
+			uint8_t*, size_t)) spi_flash_read_regions, \
 		.get_page_size = (int (*) (const struct flash*, uint32_t*)) spi_flash_get_page_size, \
 		.minimum_write_per_page = \
 			(int (*) (const struct flash*, uint32_t*)) spi_flash_minimum_write_per_page, \
@@ -43,6 +45,8 @@ int spi_flash_chip_erase_read_only (const struct flash *flash);
 #define	SPI_FLASH_READ_ONLY_API_INIT  { \
 		.get_device_size = (int (*) (const struct flash*, uint32_t*)) spi_flash_get_device_size, \
 		.read = (int (*) (const struct flash*, uint32_t, uint8_t*, size_t)) spi_flash_read, \
+		.read_regions = (int (*) (const struct flash*, const struct flash_region*, size_t, \
+			uint8_t*, size_t)) spi_flash_read_regions, \
 		.get_page_size = spi_flash_get_size_read_only, \
 		.minimum_write_per_page = spi_flash_get_size_read_only, \
 		.write = spi_flash_write_read_only, \
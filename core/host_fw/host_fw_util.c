@@ -316,6 +316,73 @@ bool host_fw_are_images_different (const struct pfm_image_list *img_list1,
 	return false;
 }
 
+/**
+ * Determine if an image in the list should be validated.
+ *
+ * @param img_list The list of images.
+ * @param index Index of the image to check.
+ * @param validate_all Override the image validation flag and validate all images in the list.
+ *
+ * @return true if the image needs to be validated.
+ */
+static bool host_fw_is_image_validated (const struct pfm_image_list *img_list, size_t index,
+	bool validate_all)
+{
+	if (validate_all) {
+		return true;
+	}
+
+	if (img_list->images_sig) {
+		return img_list->images_sig[index].always_validate;
+	}
+	else {
+		return img_list->images_hash[index].always_validate;
+	}
+}
+
+/**
+ * Verify that a single image on the flash is valid.  All image addresses specified in the PFM will
+ * be offset by a fixed amount.
+ *
+ * @param flash The flash that contains the image to validate.
+ * @param img_list The list of images.
+ * @param index Index of the image to validate.
+ * @param offset The offset to apply to image addresses.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ * @param pipeline The pipeline to use for hashing flash data.  Null to use the default pipeline.
+ *
+ * @return 0 if the image is good or an error code.
+ */
+static int host_fw_verify_image_on_flash (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t index, uint32_t offset,
+	struct hash_engine *hash, struct rsa_engine *rsa, struct flash_hash_pipeline *pipeline)
+{
+	uint8_t img_hash[SHA512_HASH_LENGTH];
+	int status;
+
+	if (img_list->images_sig) {
+		return flash_verify_noncontiguous_contents_pipelined (pipeline, &flash->base, offset,
+			img_list->images_sig[index].regions, img_list->images_sig[index].count, hash,
+			HASH_TYPE_SHA256, rsa, img_list->images_sig[index].signature,
+			img_list->images_sig[index].sig_length, &img_list->images_sig[index].key, NULL, 0);
+	}
+
+	status = flash_hash_noncontiguous_contents_pipelined (pipeline, &flash->base, offset,
+		img_list->images_hash[index].regions, img_list->images_hash[index].count, hash,
+		img_list->images_hash[index].hash_type, img_hash, sizeof (img_hash));
+	if (status != 0) {
+		return status;
+	}
+
+	if (memcmp (img_list->images_hash[index].hash, img_hash,
+		img_list->images_hash[index].hash_length) != 0) {
+		return HOST_FW_UTIL_BAD_IMAGE_HASH;
+	}
+
+	return 0;
+}
+
 /**
  * Verify that images on the flash are valid.  All image addresses specified in the PFM will be
  * offset by a fixed amount.
@@ -334,38 +401,19 @@ static int host_fw_verify_images_on_flash (const struct spi_flash *flash,
 	struct hash_engine *hash, struct rsa_engine *rsa)
 {
 	size_t i;
-	int status = 0;
+	int status;
 
 	for (i = 0; i < img_list->count; i++) {
-		if (img_list->images_sig) {
-			if (validate_all || img_list->images_sig[i].always_validate) {
-				status = flash_verify_noncontiguous_contents_at_offset (&flash->base, offset,
-					img_list->images_sig[i].regions, img_list->images_sig[i].count, hash,
-					HASH_TYPE_SHA256, rsa, img_list->images_sig[i].signature,
-					img_list->images_sig[i].sig_length, &img_list->images_sig[i].key, NULL, 0);
-				if (status != 0) {
-					return status;
-				}
-			}
-		}
-		else if (validate_all || img_list->images_hash[i].always_validate) {
-			uint8_t img_hash[SHA512_HASH_LENGTH];
-
-			status = flash_hash_noncontiguous_contents_at_offset (&flash->base, offset,
-				img_list->images_hash[i].regions, img_list->images_hash[i].count, hash,
-				img_list->images_hash[i].hash_type, img_hash, sizeof (img_hash));
+		if (host_fw_is_image_validated (img_list, i, validate_all)) {
+			status = host_fw_verify_image_on_flash (flash, img_list, i, offset, hash, rsa,
+				NULL);
 			if (status != 0) {
 				return status;
 			}
-
-			if (memcmp (img_list->images_hash[i].hash, img_hash,
-				img_list->images_hash[i].hash_length) != 0) {
-				return HOST_FW_UTIL_BAD_IMAGE_HASH;
-			}
 		}
 	}
 
-	return status;
+	return 0;
 }
 
 /**
@@ -459,6 +507,153 @@ int host_fw_verify_offset_images_multiple_fw (const struct spi_flash *flash,
 	return 0;
 }
 
+/**
+ * Initialize a set of host firmware images for verification by multiple workers.  Only images
+ * flagged for validation will be checked.
+ *
+ * Each worker verifying images must call host_fw_verify_work_run with its own set of engines.
+ * After all workers have completed, the result is available from host_fw_verify_work_get_status.
+ *
+ * @param work The verification work to initialize.
+ * @param flash The flash that contains the images to validate.
+ * @param img_list An array of firmware images that should be validated.
+ * @param fw_count The number of firmware components in the list.
+ * @param offset The offset to apply to image addresses.
+ *
+ * @return 0 if the verification work was initialized successfully or an error code.
+ */
+int host_fw_verify_work_init (struct host_fw_verify_work *work, const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset)
+{
+	if ((work == NULL) || (flash == NULL) || (img_list == NULL)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	memset (work, 0, sizeof (struct host_fw_verify_work));
+
+	work->flash = flash;
+	work->img_list = img_list;
+	work->fw_count = fw_count;
+	work->offset = offset;
+
+	return platform_mutex_init (&work->lock);
+}
+
+/**
+ * Release the resources used for parallel image verification.
+ *
+ * @param work The verification work to release.
+ */
+void host_fw_verify_work_release (struct host_fw_verify_work *work)
+{
+	if (work) {
+		platform_mutex_free (&work->lock);
+	}
+}
+
+/**
+ * Assign the next image that needs to be verified to a worker.  The verification lock must be held.
+ *
+ * @param work The verification work to take an image from.
+ * @param fw Output for the firmware component that contains the image.
+ * @param img Output for the index of the image to verify.
+ * @param seq Output for the order in which the image was assigned.
+ *
+ * @return true if an image was assigned or false if there are no more images to verify.
+ */
+static bool host_fw_verify_work_next_image (struct host_fw_verify_work *work, size_t *fw,
+	size_t *img, size_t *seq)
+{
+	const struct pfm_image_list *list;
+
+	/* Stop handing out images as soon as any failure is reported.  Images assigned before the
+	 * failure are still verified, so the final status matches what serial verification reports. */
+	if (work->status != 0) {
+		return false;
+	}
+
+	while (work->next_fw < work->fw_count) {
+		list = &work->img_list[work->next_fw];
+
+		while (work->next_img < list->count) {
+			*img = work->next_img++;
+			if (host_fw_is_image_validated (list, *img, false)) {
+				*fw = work->next_fw;
+				*seq = work->claimed++;
+				return true;
+			}
+		}
+
+		work->next_fw++;
+		work->next_img = 0;
+	}
+
+	return false;
+}
+
+/**
+ * Verify images from a shared set of work until there is nothing left to verify or an image has
+ * failed verification.  This can be called concurrently from any number of workers, each with a
+ * unique hash engine and hashing pipeline.
+ *
+ * @param work The verification work to process.
+ * @param engines The engines this worker will use for verification.
+ *
+ * @return 0 if the worker completed processing or an error code.  Errors from image verification
+ * are not returned here, but are reported by host_fw_verify_work_get_status.
+ */
+int host_fw_verify_work_run (struct host_fw_verify_work *work,
+	const struct host_fw_verify_engines *engines)
+{
+	size_t fw;
+	size_t img;
+	size_t seq;
+	bool assigned;
+	int status;
+
+	if ((work == NULL) || (engines == NULL) || (engines->hash == NULL) || (engines->rsa == NULL)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	do {
+		platform_mutex_lock (&work->lock);
+		assigned = host_fw_verify_work_next_image (work, &fw, &img, &seq);
+		platform_mutex_unlock (&work->lock);
+
+		if (assigned) {
+			status = host_fw_verify_image_on_flash (work->flash, &work->img_list[fw], img,
+				work->offset, engines->hash, engines->rsa, engines->pipeline);
+			if (status != 0) {
+				platform_mutex_lock (&work->lock);
+				if ((work->status == 0) || (seq < work->fail_seq)) {
+					work->status = status;
+					work->fail_seq = seq;
+				}
+				platform_mutex_unlock (&work->lock);
+			}
+		}
+	} while (assigned);
+
+	return 0;
+}
+
+/**
+ * Get the result of parallel image verification.  This must only be called after all workers have
+ * completed.
+ *
+ * @param work The verification work to query.
+ *
+ * @return 0 if all images that should be validated are good or an error code.
+ */
+int host_fw_verify_work_get_status (struct host_fw_verify_work *work)
+{
+	if (work == NULL) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	return work->status;
+}
+
 /**
  * Find the next flash region defined to be part of a firmware image.
  *
@@ -899,6 +1094,203 @@ int host_fw_restore_flash_device (const struct spi_flash *restore, const struct
 	return 0;
 }
 
+/**
+ * Process the parts of firmware images that are contained within a single sector of flash.
+ *
+ * @param restore The flash device being restored.
+ * @param from The device to restore from.
+ * @param img_list The list of firmware images in the good flash device.
+ * @param addr The address of the sector data to process.
+ * @param length The length of the sector data to process.
+ * @param expected Buffer to load with the image data from the good flash device.  If this is null,
+ * the image data will instead be copied to the already erased sector on the restored device.
+ *
+ * @return 0 if the image data was processed successfully or an error code.
+ */
+static int host_fw_process_sector_images (const struct spi_flash *restore,
+	const struct spi_flash *from, const struct pfm_image_list *img_list, uint32_t addr,
+	size_t length, uint8_t *expected)
+{
+	const struct flash_region *img_data;
+	size_t img_count;
+	uint32_t start;
+	uint32_t end;
+	int status;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < img_list->count; i++) {
+		if (img_list->images_sig) {
+			img_data = img_list->images_sig[i].regions;
+			img_count = img_list->images_sig[i].count;
+		}
+		else {
+			img_data = img_list->images_hash[i].regions;
+			img_count = img_list->images_hash[i].count;
+		}
+
+		for (j = 0; j < img_count; j++) {
+			start = (img_data[j].start_addr > addr) ? img_data[j].start_addr : addr;
+			end = img_data[j].start_addr + img_data[j].length;
+			end = (end < (addr + length)) ? end : (addr + length);
+
+			if (start < end) {
+				if (expected) {
+					status = from->base.read (&from->base, start, &expected[start - addr],
+						end - start);
+				}
+				else {
+					status = flash_copy_ext_to_blank (&restore->base, start, &from->base, start,
+						end - start);
+				}
+
+				if (status != 0) {
+					return status;
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Restore a region of read-only data on a flash device, only modifying the sectors that don't
+ * already contain the expected data.  Image data is expected to match the good flash device and
+ * all other data is expected to be blank.
+ *
+ * @param restore The flash device being restored.
+ * @param from The device to restore from.
+ * @param img_list The list of firmware images in the good flash device.
+ * @param addr The starting address of the read-only region.
+ * @param length The length of the read-only region.
+ * @param sector The size of a flash sector.
+ * @param expected Buffer to use for the expected sector contents.  This must be large enough to
+ * hold an entire sector.
+ * @param rewritten Output for the number of bytes that were erased and reprogrammed.  This will be
+ * incremented by the number of bytes that needed to be restored.
+ *
+ * @return 0 if the region was restored successfully or an error code.
+ */
+static int host_fw_restore_read_only_region (const struct spi_flash *restore,
+	const struct spi_flash *from, const struct pfm_image_list *img_list, uint32_t addr,
+	size_t length, uint32_t sector, uint8_t *expected, size_t *rewritten)
+{
+	size_t sector_len;
+	int status;
+
+	while (length != 0) {
+		sector_len = sector - FLASH_REGION_OFFSET (addr, sector);
+		sector_len = (length > sector_len) ? sector_len : length;
+
+		memset (expected, 0xff, sector_len);
+		status = host_fw_process_sector_images (restore, from, img_list, addr, sector_len,
+			expected);
+		if (status != 0) {
+			return status;
+		}
+
+		status = flash_verify_data (&restore->base, addr, expected, sector_len);
+		if (status == FLASH_UTIL_DATA_MISMATCH) {
+			status = restore->base.sector_erase (&restore->base, addr);
+			if (status != 0) {
+				return status;
+			}
+
+			status = host_fw_process_sector_images (restore, from, img_list, addr, sector_len,
+				NULL);
+			*rewritten += sector_len;
+		}
+
+		if (status != 0) {
+			return status;
+		}
+
+		length -= sector_len;
+		addr += sector_len;
+	}
+
+	return 0;
+}
+
+/**
+ * Restore the firmware images in a flash device from the contents of a different device.  The end
+ * result is the same as host_fw_restore_flash_device, but each sector of the read-only regions is
+ * first compared against the expected contents and only sectors that differ will be erased and
+ * reprogrammed.  This significantly reduces recovery time and flash wear when only a small part of
+ * the flash is corrupted.
+ *
+ * No verification will be performed on the restored device.
+ *
+ * @param restore The flash device that should be restored.
+ * @param from The device to restore from.
+ * @param img_list The list of firmware images in the good flash device.
+ * @param writable The list of read/write regions in the good flash device.
+ * @param rewritten Optional output for the number of bytes that needed to be erased and
+ * reprogrammed.  This will be valid even if the restore fails.
+ *
+ * @return 0 if the bad flash was restored to a good state or an error code.
+ */
+int host_fw_restore_flash_device_differences (const struct spi_flash *restore,
+	const struct spi_flash *from, const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable, size_t *rewritten)
+{
+	uint32_t flash_size;
+	uint32_t sector;
+	uint32_t last_addr;
+	const struct flash_region *pos;
+	uint8_t *expected;
+	size_t total = 0;
+	int status;
+
+	if (rewritten) {
+		*rewritten = 0;
+	}
+
+	if ((restore == NULL) || (from == NULL) || (img_list == NULL) || (writable == NULL)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	status = spi_flash_get_device_size (restore, &flash_size);
+	if (status != 0) {
+		return status;
+	}
+
+	status = restore->base.get_sector_size (&restore->base, &sector);
+	if (status != 0) {
+		return status;
+	}
+
+	expected = platform_malloc (sector);
+	if (expected == NULL) {
+		return HOST_FW_UTIL_NO_MEMORY;
+	}
+
+	last_addr = 0;
+	pos = host_fw_find_next_rw_region (last_addr, writable, 1);
+	while (pos) {
+		status = host_fw_restore_read_only_region (restore, from, img_list, last_addr,
+			pos->start_addr - last_addr, sector, expected, &total);
+		if (status != 0) {
+			goto exit;
+		}
+
+		last_addr = pos->start_addr + pos->length;
+		pos = host_fw_find_next_rw_region (last_addr, writable, 1);
+	}
+
+	status = host_fw_restore_read_only_region (restore, from, img_list, last_addr,
+		flash_size - last_addr, sector, expected, &total);
+
+exit:
+	platform_free (expected);
+	if (rewritten) {
+		*rewritten = total;
+	}
+
+	return status;
+}
+
 /**
  * Restore the read/write data in a flash device.  Based on the configuration of each region, the
  * destination flash will either be left unchanged, completely erased, or copied from a different
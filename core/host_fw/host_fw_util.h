@@ -6,9 +6,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "platform_api.h"
 #include "status/rot_status.h"
 #include "manifest/pfm/pfm.h"
 #include "flash/spi_flash.h"
+#include "flash/flash_util.h"
 #include "spi_filter/spi_filter_interface.h"
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
@@ -34,6 +36,49 @@ int host_fw_verify_offset_images_multiple_fw (const struct spi_flash *flash,
 	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset,
 	struct hash_engine *hash, struct rsa_engine *rsa);
 
+/**
+ * The engines available to a single worker for verifying host firmware images.  Each worker must
+ * have a dedicated hash engine.  RSA engines can be shared if the implementation allows concurrent
+ * signature verification.
+ *
+ * Each worker can also have a dedicated pipeline for hashing flash data.  Workers without a
+ * pipeline use the default pipeline when it is not busy, and otherwise hash flash data directly.
+ */
+struct host_fw_verify_engines {
+	struct hash_engine *hash;				/**< Hash engine to use for image verification. */
+	struct rsa_engine *rsa;					/**< RSA engine to use for signature checking. */
+	struct flash_hash_pipeline *pipeline;	/**< Optional pipeline for hashing flash data. */
+};
+
+/**
+ * A set of host firmware images to verify that can be split between multiple workers running in
+ * parallel.  The result of verification is the same as running the equivalent serial verification
+ * with host_fw_verify_offset_images_multiple_fw.
+ *
+ * When FLASH_HASH_PIPELINE is enabled, each worker should be given its own pipeline so workers do
+ * not contend for the default one.
+ */
+struct host_fw_verify_work {
+	const struct spi_flash *flash;				/**< The flash that contains the images. */
+	const struct pfm_image_list *img_list;		/**< The list of firmware images to verify. */
+	size_t fw_count;							/**< The number of firmware components. */
+	uint32_t offset;							/**< Offset to apply to image addresses. */
+	platform_mutex lock;						/**< Synchronization between workers. */
+	size_t next_fw;								/**< Firmware component of the next image. */
+	size_t next_img;							/**< Index of the next image to verify. */
+	size_t claimed;								/**< Number of images assigned to workers. */
+	size_t fail_seq;							/**< Assignment order of the reported failure. */
+	int status;									/**< The current verification result. */
+};
+
+int host_fw_verify_work_init (struct host_fw_verify_work *work, const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset);
+void host_fw_verify_work_release (struct host_fw_verify_work *work);
+
+int host_fw_verify_work_run (struct host_fw_verify_work *work,
+	const struct host_fw_verify_engines *engines);
+int host_fw_verify_work_get_status (struct host_fw_verify_work *work);
+
 int host_fw_full_flash_verification (const struct spi_flash *flash,
 	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
 	uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa);
@@ -54,6 +99,9 @@ int host_fw_migrate_read_write_data_multiple_fw (const struct spi_flash *dest,
 
 int host_fw_restore_flash_device (const struct spi_flash *restore, const struct spi_flash *from,
 	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable);
+int host_fw_restore_flash_device_differences (const struct spi_flash *restore,
+	const struct spi_flash *from, const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable, size_t *rewritten);
 
 int host_fw_restore_read_write_data (const struct spi_flash *restore, const struct spi_flash *from,
 	const struct pfm_read_write_regions *writable);
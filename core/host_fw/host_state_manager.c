@@ -96,6 +96,33 @@ static int host_state_manager_is_manifest_valid (struct state_manager *manager,
 	return 0;
 }
 
+/**
+ * Finish initializing a host state manager after the base state manager has been initialized.
+ *
+ * @param manager The state manager to initialize.
+ *
+ * @return 0 if the state manager was successfully initialized or an error code.
+ */
+static int host_state_manager_init_common (struct host_state_manager *manager)
+{
+	int status;
+
+	status = observable_init (&manager->observable);
+	if (status != 0) {
+		state_manager_release (&manager->base);
+		return status;
+	}
+
+	manager->base.get_active_manifest = host_state_manager_get_active_manifest;
+	manager->base.save_active_manifest = host_state_manager_save_active_manifest;
+	manager->base.restore_default_state = host_state_manager_restore_default_state;
+	manager->base.is_manifest_valid = host_state_manager_is_manifest_valid;
+
+	manager->base.volatile_state |= PFM_DIRTY_MASK;
+
+	return 0;
+}
+
 /**
  * Initialize the manager for host state information.
  *
@@ -123,20 +150,35 @@ int host_state_manager_init (struct host_state_manager *manager, const struct fl
 		return status;
 	}
 
-	status = observable_init (&manager->observable);
-	if (status != 0) {
-		state_manager_release (&manager->base);
-		return status;
+	return host_state_manager_init_common (manager);
+}
+
+/**
+ * Initialize the manager for host state information that is stored in a state journal.
+ *
+ * @param manager The state manager to initialize.
+ * @param journal The journal that contains the non-volatile state information.
+ * @param index Index of the host state in the journal records.
+ *
+ * @return 0 if the state manager was successfully initialized or an error code.
+ */
+int host_state_manager_init_journal (struct host_state_manager *manager,
+	const struct state_journal *journal, uint8_t index)
+{
+	int status;
+
+	if (manager == NULL) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
 	}
 
-	manager->base.get_active_manifest = host_state_manager_get_active_manifest;
-	manager->base.save_active_manifest = host_state_manager_save_active_manifest;
-	manager->base.restore_default_state = host_state_manager_restore_default_state;
-	manager->base.is_manifest_valid = host_state_manager_is_manifest_valid;
+	memset (manager, 0, sizeof (struct host_state_manager));
 
-	manager->base.volatile_state |= PFM_DIRTY_MASK;
+	status = state_manager_init_journal (&manager->base, journal, index);
+	if (status != 0) {
+		return status;
+	}
 
-	return 0;
+	return host_state_manager_init_common (manager);
 }
 
 /**
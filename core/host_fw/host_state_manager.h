@@ -21,6 +21,8 @@ struct host_state_manager {
 
 int host_state_manager_init (struct host_state_manager *manager, const struct flash *state_flash,
 	uint32_t store_addr);
+int host_state_manager_init_journal (struct host_state_manager *manager,
+	const struct state_journal *journal, uint8_t index);
 void host_state_manager_release (struct host_state_manager *manager);
 
 int host_state_manager_add_observer (struct host_state_manager *manager,
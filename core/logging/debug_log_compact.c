@@ -0,0 +1,445 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "debug_log_compact.h"
+#include "debug_log_compact_format.h"
+#include "common/buffer_util.h"
+
+
+/**
+ * Start a new batch of encoded entries.
+ *
+ * @param logging The log to update.
+ * @param time Base time for the entries in the batch.
+ */
+static void debug_log_compact_start_batch (const struct debug_log_compact *logging, uint64_t time)
+{
+	struct debug_log_compact_header header;
+
+	header.format = DEBUG_LOG_ENTRY_FORMAT_COMPACT;
+	header.time = time;
+	memcpy (logging->batch, &header, sizeof (header));
+
+	/* Encoding the first record is relative to an empty entry at the base time. */
+	memset (&logging->state->last, 0, sizeof (logging->state->last));
+	logging->state->last.time = time;
+
+	logging->state->batch_length = sizeof (header);
+	logging->state->repeat_offset = 0;
+}
+
+/**
+ * Save the current batch of encoded entries to the target log.  Nothing is saved if the batch
+ * contains no entries.
+ *
+ * @param logging The log to save.
+ *
+ * @return 0 if the batch was saved successfully or an error code.
+ */
+static int debug_log_compact_save_batch (const struct debug_log_compact *logging)
+{
+	int status;
+
+	if (logging->state->batch_length <= sizeof (struct debug_log_compact_header)) {
+		return 0;
+	}
+
+	status = logging->log->create_entry (logging->log, logging->batch,
+		logging->state->batch_length);
+	if (status == 0) {
+		logging->state->batch_length = 0;
+		logging->state->batch_id_valid = false;
+	}
+
+	return status;
+}
+
+/**
+ * Get the length the current batch of encoded entries would have as an entry in the target log.
+ *
+ * @param logging The log to query.
+ *
+ * @return Length of the batch entry, including the entry header, or 0 if there are no batched
+ * entries.
+ */
+static size_t debug_log_compact_batch_entry_length (const struct debug_log_compact *logging)
+{
+	if (logging->state->batch_length <= sizeof (struct debug_log_compact_header)) {
+		return 0;
+	}
+
+	return sizeof (struct logging_entry_header) + logging->state->batch_length;
+}
+
+/**
+ * Determine the entry ID to report for the current batch of encoded entries.  This is the ID that
+ * follows the newest entry in the target log.  The target log is only scanned once for each batch.
+ *
+ * @param logging The log to query.
+ * @param log_size The current size of the target log.
+ *
+ * @return 0 if the batch entry ID was determined or an error code.
+ */
+static int debug_log_compact_find_batch_id (const struct debug_log_compact *logging,
+	size_t log_size)
+{
+	struct logging_entry_header header;
+	size_t offset = 0;
+	int status;
+
+	if (logging->state->batch_id_valid) {
+		return 0;
+	}
+
+	logging->state->batch_id = 0;
+	while ((offset + sizeof (header)) <= log_size) {
+		status = logging->log->read_contents (logging->log, offset, (uint8_t*) &header,
+			sizeof (header));
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		if ((status != sizeof (header)) || !LOGGING_IS_ENTRY_START (header.log_magic) ||
+			(header.length < sizeof (header))) {
+			break;
+		}
+
+		logging->state->batch_id = header.entry_id + 1;
+		offset += header.length;
+	}
+
+	logging->state->batch_id_valid = true;
+
+	return 0;
+}
+
+/**
+ * Encode a debug log entry and add it to the current batch.
+ *
+ * @param logging The log to update.
+ * @param entry The entry to add.
+ *
+ * @return 0 if the entry was added to the batch or an error code.
+ */
+static int debug_log_compact_add_to_batch (const struct debug_log_compact *logging,
+	const struct debug_log_entry_info *entry)
+{
+	struct debug_log_compact_state *state = logging->state;
+	struct debug_log_entry_info *last = &state->last;
+	uint8_t repeat[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	if ((state->batch_length > sizeof (struct debug_log_compact_header)) &&
+		(entry->severity == last->severity) && (entry->component == last->component) &&
+		(entry->msg_index == last->msg_index) && (entry->arg1 == last->arg1) &&
+		(entry->arg2 == last->arg2)) {
+		/* The entry is the same as the last one, so just update the repeat count. */
+		if (state->repeat_offset == 0) {
+			state->repeat_offset = state->batch_length;
+			state->repeat_base = last->time;
+			state->repeat_count = 0;
+		}
+
+		/* Encode the updated repeat record separately so the existing record remains intact if
+		 * the new one doesn't fit in the batch. */
+		status = debug_log_compact_encode_repeat (state->repeat_count + 1,
+			(entry->time > state->repeat_base) ? (entry->time - state->repeat_base) : 0, repeat,
+			sizeof (repeat));
+		if (!ROT_IS_ERROR (status) &&
+			((state->repeat_offset + status) > logging->batch_size)) {
+			status = LOGGING_BUFFER_TOO_SMALL;
+		}
+
+		if (ROT_IS_ERROR (status)) {
+			if (state->repeat_count == 0) {
+				state->repeat_offset = 0;
+			}
+
+			return status;
+		}
+
+		memcpy (&logging->batch[state->repeat_offset], repeat, status);
+		state->batch_length = state->repeat_offset + status;
+		state->repeat_count++;
+	}
+	else {
+		status = debug_log_compact_encode_record (entry, last,
+			&logging->batch[state->batch_length], logging->batch_size - state->batch_length);
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		state->batch_length += status;
+		state->repeat_offset = 0;
+	}
+
+	memcpy (last, entry, sizeof (*last));
+
+	return 0;
+}
+
+int debug_log_compact_create_entry (const struct logging *logging, uint8_t *entry, size_t length)
+{
+	const struct debug_log_compact *compact = (const struct debug_log_compact*) logging;
+	struct debug_log_entry_info info;
+	int status;
+
+	if ((compact == NULL) || (entry == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (length == sizeof (info)) {
+		memcpy (&info, entry, sizeof (info));
+	}
+
+	platform_mutex_lock (&compact->state->lock);
+
+	if ((length != sizeof (info)) || (info.format != DEBUG_LOG_ENTRY_FORMAT) ||
+		(info.severity >= DEBUG_LOG_COMPACT_TAG_REPEAT)) {
+		/* Entries that can't be encoded are stored without changes after any batched entries. */
+		status = debug_log_compact_save_batch (compact);
+		if (status == 0) {
+			status = compact->log->create_entry (compact->log, entry, length);
+			compact->state->batch_id_valid = false;
+		}
+
+		goto exit;
+	}
+
+	if (compact->state->batch_length == 0) {
+		debug_log_compact_start_batch (compact, info.time);
+	}
+
+	status = debug_log_compact_add_to_batch (compact, &info);
+	if (status == LOGGING_BUFFER_TOO_SMALL) {
+		status = debug_log_compact_save_batch (compact);
+		if (status != 0) {
+			goto exit;
+		}
+
+		debug_log_compact_start_batch (compact, info.time);
+		status = debug_log_compact_add_to_batch (compact, &info);
+	}
+
+exit:
+	platform_mutex_unlock (&compact->state->lock);
+	return status;
+}
+
+#ifndef LOGGING_DISABLE_FLUSH
+int debug_log_compact_flush (const struct logging *logging)
+{
+	const struct debug_log_compact *compact = (const struct debug_log_compact*) logging;
+	int status;
+
+	if (compact == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&compact->state->lock);
+
+	status = debug_log_compact_save_batch (compact);
+	if (status == 0) {
+		status = compact->log->flush (compact->log);
+	}
+
+	platform_mutex_unlock (&compact->state->lock);
+
+	return status;
+}
+#endif
+
+int debug_log_compact_clear (const struct logging *logging)
+{
+	const struct debug_log_compact *compact = (const struct debug_log_compact*) logging;
+	int status;
+
+	if (compact == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&compact->state->lock);
+
+	status = compact->log->clear (compact->log);
+	if (status == 0) {
+		compact->state->batch_length = 0;
+		compact->state->batch_id_valid = false;
+	}
+
+	platform_mutex_unlock (&compact->state->lock);
+
+	return status;
+}
+
+int debug_log_compact_get_size (const struct logging *logging)
+{
+	const struct debug_log_compact *compact = (const struct debug_log_compact*) logging;
+	int status;
+
+	if (compact == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&compact->state->lock);
+
+	/* Batched entries are reported as an additional entry without saving them to the target log. */
+	status = compact->log->get_size (compact->log);
+	if (!ROT_IS_ERROR (status)) {
+		status += debug_log_compact_batch_entry_length (compact);
+	}
+
+	platform_mutex_unlock (&compact->state->lock);
+
+	return status;
+}
+
+int debug_log_compact_read_contents (const struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	const struct debug_log_compact *compact = (const struct debug_log_compact*) logging;
+	struct logging_entry_header header;
+	size_t bytes_read = 0;
+	size_t copy_offset;
+	size_t copy_length;
+	int log_size;
+	int status;
+
+	if ((compact == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&compact->state->lock);
+
+	log_size = compact->log->get_size (compact->log);
+	if (ROT_IS_ERROR (log_size)) {
+		status = log_size;
+		goto exit;
+	}
+
+	if (offset < (uint32_t) log_size) {
+		status = compact->log->read_contents (compact->log, offset, contents, length);
+		if (ROT_IS_ERROR (status)) {
+			goto exit;
+		}
+
+		bytes_read = status;
+	}
+
+	/* Batched entries are read from memory as if they had been saved to the target log.  Saving
+	 * them here would fragment the batches every time the log is read. */
+	if ((debug_log_compact_batch_entry_length (compact) != 0) && (bytes_read < length) &&
+		((offset + bytes_read) >= (size_t) log_size)) {
+		status = debug_log_compact_find_batch_id (compact, log_size);
+		if (status != 0) {
+			goto exit;
+		}
+
+		header.log_magic = LOGGING_MAGIC_START;
+		header.length = debug_log_compact_batch_entry_length (compact);
+		header.entry_id = compact->state->batch_id;
+
+		copy_offset = (offset + bytes_read) - log_size;
+		copy_length = length - bytes_read;
+
+		bytes_read += buffer_copy ((uint8_t*) &header, sizeof (header), &copy_offset, &copy_length,
+			&contents[bytes_read]);
+		bytes_read += buffer_copy (compact->batch, compact->state->batch_length, &copy_offset,
+			&copy_length, &contents[bytes_read]);
+	}
+
+	status = bytes_read;
+
+exit:
+	platform_mutex_unlock (&compact->state->lock);
+
+	return status;
+}
+
+/**
+ * Initialize a debug log that stores entries in a compact format.
+ *
+ * Debug log entries are encoded with variable length arguments and time deltas, and identical
+ * entries added back to back are stored as a repeat count.  Encoded entries are collected into
+ * batches that get saved to the target log as a single entry.  Any entries that are not standard
+ * debug log entries are saved to the target log without modification.
+ *
+ * @param logging The log to initialize.
+ * @param state Variable context for the log.  This must be uninitialized.
+ * @param log The log that will store the encoded entries.  This log must support variable length
+ * entries.
+ * @param batch Buffer for collecting encoded entries.  This determines the maximum size of each
+ * entry saved to the target log and must be no larger than the largest entry the target log can
+ * accept.
+ * @param batch_size Size of the batch buffer.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int debug_log_compact_init (struct debug_log_compact *logging,
+	struct debug_log_compact_state *state, const struct logging *log, uint8_t *batch,
+	size_t batch_size)
+{
+	if (logging == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (logging, 0, sizeof (struct debug_log_compact));
+
+	logging->base.create_entry = debug_log_compact_create_entry;
+#ifndef LOGGING_DISABLE_FLUSH
+	logging->base.flush = debug_log_compact_flush;
+#endif
+	logging->base.clear = debug_log_compact_clear;
+	logging->base.get_size = debug_log_compact_get_size;
+	logging->base.read_contents = debug_log_compact_read_contents;
+
+	logging->state = state;
+	logging->log = log;
+	logging->batch = batch;
+	logging->batch_size = batch_size;
+
+	return debug_log_compact_init_state (logging);
+}
+
+/**
+ * Initialize only the variable state for a compact debug log.  The rest of the log instance is
+ * assumed to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param logging The log instance that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int debug_log_compact_init_state (const struct debug_log_compact *logging)
+{
+	if ((logging == NULL) || (logging->state == NULL) || (logging->log == NULL) ||
+		(logging->batch == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (logging->batch_size <
+		(sizeof (struct debug_log_compact_header) + DEBUG_LOG_COMPACT_MAX_RECORD_LEN)) {
+		return LOGGING_INSUFFICIENT_STORAGE;
+	}
+
+	memset (logging->state, 0, sizeof (struct debug_log_compact_state));
+
+	return platform_mutex_init (&logging->state->lock);
+}
+
+/**
+ * Release the resources used by a compact debug log.  Any entries that have not been saved to the
+ * target log will be lost.
+ *
+ * @param logging The log to release.
+ */
+void debug_log_compact_release (const struct debug_log_compact *logging)
+{
+	if (logging) {
+		platform_mutex_free (&logging->state->lock);
+	}
+}
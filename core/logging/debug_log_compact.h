@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef DEBUG_LOG_COMPACT_H_
+#define DEBUG_LOG_COMPACT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "logging.h"
+#include "debug_log.h"
+#include "platform_api.h"
+
+
+/**
+ * Variable context for a debug log that uses the compact entry format.
+ */
+struct debug_log_compact_state {
+	platform_mutex lock;					/**< Synchronization for log accesses. */
+	size_t batch_length;					/**< Number of bytes of encoded records in the batch. */
+	struct debug_log_entry_info last;		/**< The last entry added to the batch. */
+	uint64_t repeat_base;					/**< Time of the entry being repeated. */
+	size_t repeat_offset;					/**< Batch offset of the current repeat record. */
+	uint32_t repeat_count;					/**< Number of times the last entry was repeated. */
+	uint32_t batch_id;						/**< Entry ID reported for the unsaved batch. */
+	bool batch_id_valid;					/**< Flag indicating the batch entry ID is known. */
+};
+
+/**
+ * A log for debug entries that encodes them in a compact format before storing them in another
+ * log.  Entries are collected into a batch that gets saved as a single entry in the target log
+ * when the batch is full or the log is flushed.  Reading the log reports the current batch as the
+ * newest entry without saving it.
+ */
+struct debug_log_compact {
+	struct logging base;					/**< The base logging instance. */
+	struct debug_log_compact_state *state;	/**< Variable context for the log instance. */
+	const struct logging *log;				/**< The log that will store the encoded entries. */
+	uint8_t *batch;							/**< Buffer for collecting encoded entries. */
+	size_t batch_size;						/**< Size of the batch buffer. */
+};
+
+
+int debug_log_compact_init (struct debug_log_compact *logging,
+	struct debug_log_compact_state *state, const struct logging *log, uint8_t *batch,
+	size_t batch_size);
+int debug_log_compact_init_state (const struct debug_log_compact *logging);
+void debug_log_compact_release (const struct debug_log_compact *logging);
+
+
+#endif /* DEBUG_LOG_COMPACT_H_ */
@@ -0,0 +1,290 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "debug_log_compact_format.h"
+
+
+/**
+ * Encode an integer using a variable number of bytes.
+ *
+ * @param value The value to encode.
+ * @param data Output buffer for the encoded value.
+ * @param length Length of the output buffer.
+ *
+ * @return The number of bytes used to encode the value or an error code.  Use ROT_IS_ERROR to
+ * check the return value.
+ */
+int debug_log_compact_encode_varint (uint64_t value, uint8_t *data, size_t length)
+{
+	size_t i = 0;
+
+	do {
+		if (i >= length) {
+			return LOGGING_BUFFER_TOO_SMALL;
+		}
+
+		data[i] = value & 0x7f;
+		value >>= 7;
+		if (value != 0) {
+			data[i] |= 0x80;
+		}
+
+		i++;
+	} while (value != 0);
+
+	return i;
+}
+
+/**
+ * Decode an integer that was encoded using a variable number of bytes.
+ *
+ * @param data The encoded data.
+ * @param length Length of the encoded data.
+ * @param value Output for the decoded value.
+ *
+ * @return The number of bytes consumed by the encoded value or an error code.  Use ROT_IS_ERROR to
+ * check the return value.
+ */
+int debug_log_compact_decode_varint (const uint8_t *data, size_t length, uint64_t *value)
+{
+	size_t i = 0;
+	int shift = 0;
+
+	*value = 0;
+	do {
+		if ((i >= length) || (shift >= 64)) {
+			return LOGGING_MALFORMED_ENTRY;
+		}
+
+		*value |= ((uint64_t) (data[i] & 0x7f)) << shift;
+		shift += 7;
+	} while (data[i++] & 0x80);
+
+	return i;
+}
+
+/**
+ * Encode a debug log entry as a single record in the compact format.
+ *
+ * @param entry The entry to encode.
+ * @param prev The previous entry that was encoded.  For the first record, this must contain only
+ * zeros except for the time, which must match the base time in the entry header.
+ * @param data Output buffer for the encoded record.
+ * @param length Length of the output buffer.
+ *
+ * @return The number of bytes used to encode the record or an error code.  Use ROT_IS_ERROR to
+ * check the return value.
+ */
+int debug_log_compact_encode_record (const struct debug_log_entry_info *entry,
+	const struct debug_log_entry_info *prev, uint8_t *data, size_t length)
+{
+	size_t offset = 1;
+	int status;
+
+	if ((entry == NULL) || (prev == NULL) || (data == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (entry->severity >= DEBUG_LOG_COMPACT_TAG_REPEAT) {
+		return LOGGING_UNSUPPORTED_SEVERITY;
+	}
+
+	if (length < 2) {
+		return LOGGING_BUFFER_TOO_SMALL;
+	}
+
+	data[0] = entry->severity;
+	if (entry->component == prev->component) {
+		data[0] |= DEBUG_LOG_COMPACT_TAG_SAME_COMPONENT;
+	}
+	else {
+		data[offset++] = entry->component;
+	}
+
+	if (offset >= length) {
+		return LOGGING_BUFFER_TOO_SMALL;
+	}
+	data[offset++] = entry->msg_index;
+
+	status = debug_log_compact_encode_varint (entry->arg1, &data[offset], length - offset);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	offset += status;
+
+	status = debug_log_compact_encode_varint (entry->arg2, &data[offset], length - offset);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	offset += status;
+
+	/* Time is not expected to go backwards, but don't let it generate a large delta if it does. */
+	status = debug_log_compact_encode_varint (
+		(entry->time > prev->time) ? (entry->time - prev->time) : 0, &data[offset],
+		length - offset);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	return offset + status;
+}
+
+/**
+ * Encode a record indicating the previous record was repeated.
+ *
+ * @param count The number of times the previous record was repeated.
+ * @param time_delta The time between the previous record and the last time it was repeated.
+ * @param data Output buffer for the encoded record.
+ * @param length Length of the output buffer.
+ *
+ * @return The number of bytes used to encode the record or an error code.  Use ROT_IS_ERROR to
+ * check the return value.
+ */
+int debug_log_compact_encode_repeat (uint32_t count, uint64_t time_delta, uint8_t *data,
+	size_t length)
+{
+	size_t offset = 1;
+	int status;
+
+	if (data == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (length < 1) {
+		return LOGGING_BUFFER_TOO_SMALL;
+	}
+
+	data[0] = DEBUG_LOG_COMPACT_TAG_REPEAT;
+
+	status = debug_log_compact_encode_varint (count, &data[offset], length - offset);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	offset += status;
+
+	status = debug_log_compact_encode_varint (time_delta, &data[offset], length - offset);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	return offset + status;
+}
+
+/**
+ * Decode the header for log entry data in the compact format.
+ *
+ * @param data The log entry data, not including the standard logging header.
+ * @param length Length of the log entry data.
+ * @param entry Output for the initial decoding context.  This should be provided when decoding the
+ * first record.
+ *
+ * @return The number of bytes consumed by the header or an error code.  Use ROT_IS_ERROR to check
+ * the return value.
+ */
+int debug_log_compact_decode_header (const uint8_t *data, size_t length,
+	struct debug_log_entry_info *entry)
+{
+	struct debug_log_compact_header header;
+
+	if ((data == NULL) || (entry == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (length < sizeof (header)) {
+		return LOGGING_MALFORMED_ENTRY;
+	}
+
+	memcpy (&header, data, sizeof (header));
+	if (header.format != DEBUG_LOG_ENTRY_FORMAT_COMPACT) {
+		return LOGGING_MALFORMED_ENTRY;
+	}
+
+	memset (entry, 0, sizeof (*entry));
+	entry->format = DEBUG_LOG_ENTRY_FORMAT;
+	entry->time = header.time;
+
+	return sizeof (header);
+}
+
+/**
+ * Decode a single record from log entry data in the compact format.
+ *
+ * @param data The encoded record.
+ * @param length Length of the remaining log entry data.
+ * @param entry On input, the previously decoded entry.  On output, the decoded entry.  If the
+ * record indicates a repeat of the previous entry, only the time will be updated.
+ * @param repeat Output for the number of times the entry was repeated.  This will be 0 for a new
+ * entry.
+ *
+ * @return The number of bytes consumed by the record or an error code.  Use ROT_IS_ERROR to check
+ * the return value.
+ */
+int debug_log_compact_decode_record (const uint8_t *data, size_t length,
+	struct debug_log_entry_info *entry, uint32_t *repeat)
+{
+	uint64_t value;
+	size_t offset = 1;
+	int status;
+
+	if ((data == NULL) || (entry == NULL) || (repeat == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (length < 1) {
+		return LOGGING_MALFORMED_ENTRY;
+	}
+
+	if ((data[0] & DEBUG_LOG_COMPACT_TAG_SEVERITY) == DEBUG_LOG_COMPACT_TAG_REPEAT) {
+		status = debug_log_compact_decode_varint (&data[offset], length - offset, &value);
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+		offset += status;
+
+		*repeat = value;
+	}
+	else {
+		entry->severity = data[0] & DEBUG_LOG_COMPACT_TAG_SEVERITY;
+
+		if (!(data[0] & DEBUG_LOG_COMPACT_TAG_SAME_COMPONENT)) {
+			if (offset >= length) {
+				return LOGGING_MALFORMED_ENTRY;
+			}
+			entry->component = data[offset++];
+		}
+
+		if (offset >= length) {
+			return LOGGING_MALFORMED_ENTRY;
+		}
+		entry->msg_index = data[offset++];
+
+		status = debug_log_compact_decode_varint (&data[offset], length - offset, &value);
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+		offset += status;
+		entry->arg1 = value;
+
+		status = debug_log_compact_decode_varint (&data[offset], length - offset, &value);
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+		offset += status;
+		entry->arg2 = value;
+
+		*repeat = 0;
+	}
+
+	status = debug_log_compact_decode_varint (&data[offset], length - offset, &value);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+	offset += status;
+
+	entry->time += value;
+
+	return offset;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef DEBUG_LOG_COMPACT_FORMAT_H_
+#define DEBUG_LOG_COMPACT_FORMAT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "debug_log.h"
+
+
+/**
+ * Format identifier for a log entry that contains multiple debug log records in the compact
+ * encoding.
+ */
+#define	DEBUG_LOG_ENTRY_FORMAT_COMPACT		2
+
+/**
+ * The maximum number of bytes needed to encode a single record in the compact format.  This
+ * includes the record tag, component, message index, two 32-bit arguments, and a 64-bit time
+ * delta.
+ */
+#define	DEBUG_LOG_COMPACT_MAX_RECORD_LEN	(3 + 5 + 5 + 10)
+
+/**
+ * Mask for the severity field in a record tag.
+ */
+#define	DEBUG_LOG_COMPACT_TAG_SEVERITY		0x03
+
+/**
+ * Record tag flag indicating the record uses the same component as the previous record.  The
+ * component is not encoded when this flag is set.
+ */
+#define	DEBUG_LOG_COMPACT_TAG_SAME_COMPONENT	(1U << 2)
+
+/**
+ * Severity value in a record tag that indicates the record is a repeat of the previous record.
+ */
+#define	DEBUG_LOG_COMPACT_TAG_REPEAT		DEBUG_LOG_COMPACT_TAG_SEVERITY
+
+
+#pragma pack(push, 1)
+
+/**
+ * Header for the data in a log entry that uses the compact encoding.  The header is followed by
+ * a sequence of records, each encoded as:
+ *
+ * 	- A single byte tag containing the severity and flags.
+ * 	- The component, if not the same as the previous record.
+ * 	- The message index.
+ * 	- Both message arguments as variable length integers.
+ * 	- The time since the previous record, in milliseconds, as a variable length integer.
+ *
+ * A record with a repeat tag indicates that the previous record was logged again one or more times.
+ * It contains the number of repeats and the time from the previous record to the last repeat, both
+ * as variable length integers.
+ *
+ * Variable length integers are encoded 7 bits at a time, least significant bits first, with the
+ * high bit set on every byte except the last.
+ */
+struct debug_log_compact_header {
+	uint16_t format;			/**< Format of the log entry.  This is always the compact format. */
+	uint64_t time;				/**< Base time for the records, in milliseconds since boot. */
+};
+
+#pragma pack(pop)
+
+
+int debug_log_compact_encode_varint (uint64_t value, uint8_t *data, size_t length);
+int debug_log_compact_decode_varint (const uint8_t *data, size_t length, uint64_t *value);
+
+int debug_log_compact_encode_record (const struct debug_log_entry_info *entry,
+	const struct debug_log_entry_info *prev, uint8_t *data, size_t length);
+int debug_log_compact_encode_repeat (uint32_t count, uint64_t time_delta, uint8_t *data,
+	size_t length);
+
+int debug_log_compact_decode_header (const uint8_t *data, size_t length,
+	struct debug_log_entry_info *entry);
+int debug_log_compact_decode_record (const uint8_t *data, size_t length,
+	struct debug_log_entry_info *entry, uint32_t *repeat);
+
+
+#endif /* DEBUG_LOG_COMPACT_FORMAT_H_ */
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef DEBUG_LOG_COMPACT_STATIC_H_
+#define DEBUG_LOG_COMPACT_STATIC_H_
+
+#include "logging/debug_log_compact.h"
+
+
+/* Internal functions declared to allow for static initialization. */
+int debug_log_compact_create_entry (const struct logging *logging, uint8_t *entry, size_t length);
+int debug_log_compact_flush (const struct logging *logging);
+int debug_log_compact_clear (const struct logging *logging);
+int debug_log_compact_get_size (const struct logging *logging);
+int debug_log_compact_read_contents (const struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length);
+
+
+/**
+ * Constant initializer for the flush operation.
+ */
+#ifndef LOGGING_DISABLE_FLUSH
+#define	DEBUG_LOG_COMPACT_FLUSH_API	.flush = debug_log_compact_flush,
+#else
+#define	DEBUG_LOG_COMPACT_FLUSH_API
+#endif
+
+/**
+ * Constant initializer for the logging API.
+ */
+#define	DEBUG_LOG_COMPACT_API_INIT  { \
+		.create_entry = debug_log_compact_create_entry, \
+		DEBUG_LOG_COMPACT_FLUSH_API \
+		.clear = debug_log_compact_clear, \
+		.get_size = debug_log_compact_get_size, \
+		.read_contents = debug_log_compact_read_contents \
+	}
+
+
+/**
+ * Initialize a static instance of a debug log that uses the compact entry format.  This can be a
+ * constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the log.
+ * @param log_ptr The log that will store the encoded entries.
+ * @param batch_ptr Buffer for collecting encoded entries.
+ * @param batch_len Size of the batch buffer.
+ */
+#define	debug_log_compact_static_init(state_ptr, log_ptr, batch_ptr, batch_len)	{ \
+		.base = DEBUG_LOG_COMPACT_API_INIT, \
+		.state = state_ptr, \
+		.log = log_ptr, \
+		.batch = batch_ptr, \
+		.batch_size = batch_len \
+	}
+
+
+#endif /* DEBUG_LOG_COMPACT_STATIC_H_ */
@@ -21,7 +21,9 @@ struct log_flush_handler_state {
 };
 
 /**
- * Handler to flush log data.
+ * Handler to flush log data.  This provides the flush context for logs that defer writing entries
+ * to persistent storage, such as flash logs with deferred flushing enabled.  Those logs will only
+ * write full sectors of entries when flushed by the periodic task running this handler.
  */
 struct log_flush_handler {
 	struct periodic_task_handler base;		/**< Base interface for task integration. */
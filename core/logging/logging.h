@@ -136,6 +136,11 @@ enum {
 	LOGGING_BAD_ENTRY_LENGTH = LOGGING_ERROR (0x0a),		/**< The entry data is not the right size for the log. */
 	LOGGING_NO_LOG_AVAILABLE = LOGGING_ERROR (0x0b),		/**< There is no log available for the operation. */
 	LOGGING_INSUFFICIENT_STORAGE = LOGGING_ERROR (0x0c),	/**< Memory for the log does not meet minimum requirements. */
+	LOGGING_BUFFER_TOO_SMALL = LOGGING_ERROR (0x0d),		/**< The output buffer cannot hold a complete log entry. */
+	LOGGING_MALFORMED_ENTRY = LOGGING_ERROR (0x0e),			/**< The log entry data is not formatted correctly. */
+	LOGGING_ENTRY_DROPPED = LOGGING_ERROR (0x0f),			/**< There was no space to buffer the entry. */
+	LOGGING_LOCK_FREE_UNSUPPORTED = LOGGING_ERROR (0x10),	/**< The log cannot be switched to lock-free mode. */
+	LOGGING_INCONSISTENT_READ = LOGGING_ERROR (0x11),		/**< A consistent view of the log contents could not be read. */
 };
 
 
@@ -13,6 +13,154 @@
  */
 #define	LOGGING_FLASH_TERMINATOR	(1U << 15)
 
+/**
+ * Get the flash sector at a position in the log, relative to the sector with the oldest entries.
+ */
+#define	LOGGING_FLASH_SECTOR_AT(state, pos)	(((state)->log_start + (pos)) % LOGGING_FLASH_SECTORS)
+
+
+/**
+ * Rebuild the byte offsets of the sectors in the log index.  This must be called any time the
+ * amount of data stored in a sector changes or the sector with the oldest entries moves.
+ *
+ * @param logging The log to update.
+ */
+static void logging_flash_update_index (const struct logging_flash *logging)
+{
+	struct logging_flash_state *state = logging->state;
+	uint32_t offset = 0;
+	int sector;
+
+	state->index_count = 0;
+	while (state->index_count < LOGGING_FLASH_SECTORS) {
+		sector = LOGGING_FLASH_SECTOR_AT (state, state->index_count);
+		if (state->flash_used[sector] == 0) {
+			break;
+		}
+
+		state->index[sector].offset = offset;
+		offset += state->flash_used[sector];
+		state->index_count++;
+	}
+}
+
+/**
+ * Record the first entry ID for a sector that is about to receive data.  Nothing is changed if the
+ * sector already contains log entries.
+ *
+ * @param logging The log being written.
+ * @param sector_num The sector that will be written.
+ * @param data The data being written to the sector.  This must start with an entry header.
+ */
+static void logging_flash_index_sector (const struct logging_flash *logging, uint8_t sector_num,
+	const uint8_t *data)
+{
+	if (logging->state->flash_used[sector_num] == 0) {
+		logging->state->index[sector_num].first_id =
+			((const struct logging_entry_header*) data)->entry_id;
+	}
+}
+
+/**
+ * Get the total amount of log data stored in flash.
+ *
+ * @param state The log state to query.
+ *
+ * @return The number of log bytes stored in flash.
+ */
+static uint32_t logging_flash_stored_length (const struct logging_flash_state *state)
+{
+	int last;
+
+	if (state->index_count == 0) {
+		return 0;
+	}
+
+	last = LOGGING_FLASH_SECTOR_AT (state, state->index_count - 1);
+
+	return state->index[last].offset + state->flash_used[last];
+}
+
+
+/**
+ * Determine if a flash sector needs to be erased before writing log entries to an address.  A
+ * sector only needs to be erased when writing to the beginning of the sector and it was not
+ * already erased ahead of time.
+ *
+ * @param logging The log being written.
+ * @param addr The flash address that will be written.
+ *
+ * @return true if the sector needs to be erased.
+ */
+static bool logging_flash_needs_erase (const struct logging_flash *logging, uint32_t addr)
+{
+	if (FLASH_SECTOR_OFFSET (addr) != 0) {
+		return false;
+	}
+
+	if (logging->state->erased) {
+		logging->state->erased = false;
+		if (logging->state->erased_addr == addr) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Remove any log entries stored in a flash sector that is being erased.
+ *
+ * @param logging The log being written.
+ * @param addr The base address of the sector being erased.
+ */
+static void logging_flash_remove_sector (const struct logging_flash *logging, uint32_t addr)
+{
+	uint8_t sector_num;
+
+	sector_num = (addr - logging->base_addr) / FLASH_SECTOR_SIZE;
+	if (logging->state->log_start == sector_num) {
+		/* The oldest entries are being removed, so all log offsets move. */
+		logging->state->log_base += logging->state->flash_used[sector_num];
+	}
+	logging->state->flash_used[sector_num] = 0;
+
+	if (logging->state->log_start == sector_num) {
+		int next_sector = (logging->state->log_start + 1) % LOGGING_FLASH_SECTORS;
+		if (logging->state->flash_used[next_sector] != 0) {
+			logging->state->log_start = next_sector;
+		}
+	}
+
+	logging_flash_update_index (logging);
+}
+
+/**
+ * Prepare a flash sector to receive new log entries.  If the address is at the beginning of a
+ * sector, the sector will be erased unless it was already erased ahead of time.
+ *
+ * @param logging The log being written.
+ * @param addr The flash address that will be written.
+ *
+ * @return 0 if the sector is ready to be written or an error code.
+ */
+static int logging_flash_prepare_sector (const struct logging_flash *logging, uint32_t addr)
+{
+	int status;
+
+	if (!logging_flash_needs_erase (logging, addr)) {
+		return 0;
+	}
+
+	status = spi_flash_sector_erase (logging->flash, addr);
+	if (status != 0) {
+		return status;
+	}
+
+	logging_flash_remove_sector (logging, addr);
+
+	return 0;
+}
 
 /**
  * Save the entry buffer to flash.
@@ -32,20 +180,9 @@ static int logging_flash_save_buffer (const struct logging_flash *logging)
 		curr_sector_num = (FLASH_SECTOR_BASE (logging->state->next_addr) - logging->base_addr) /
 			FLASH_SECTOR_SIZE;
 
-		if (FLASH_SECTOR_OFFSET (logging->state->next_addr) == 0) {
-			status = spi_flash_sector_erase (logging->flash, logging->state->next_addr);
-			if (status != 0) {
-				return status;
-			}
-
-			logging->state->flash_used[curr_sector_num] = 0;
-
-			if (logging->state->log_start == curr_sector_num) {
-				int next_sector = (logging->state->log_start + 1) % LOGGING_FLASH_SECTORS;
-				if (logging->state->flash_used[next_sector] != 0) {
-					logging->state->log_start = next_sector;
-				}
-			}
+		status = logging_flash_prepare_sector (logging, logging->state->next_addr);
+		if (status != 0) {
+			return status;
 		}
 
 		status = spi_flash_write (logging->flash, logging->state->next_addr,
@@ -61,6 +198,7 @@ static int logging_flash_save_buffer (const struct logging_flash *logging)
 			status = 0;
 		}
 
+		logging_flash_index_sector (logging, curr_sector_num, logging->state->entry_buffer);
 		logging->state->next_addr += write_len;
 		logging->state->flash_used[curr_sector_num] += write_len;
 
@@ -79,6 +217,7 @@ static int logging_flash_save_buffer (const struct logging_flash *logging)
 			logging->state->next_write = logging->state->entry_buffer;
 			logging->state->write_remain = sizeof (logging->state->entry_buffer) -
 				FLASH_SECTOR_OFFSET (logging->state->next_addr);
+			logging->state->split = false;
 			if (logging->state->terminated) {
 				logging->state->flash_used[curr_sector_num] -= sizeof (struct logging_entry_header);
 				logging->state->terminated = false;
@@ -90,12 +229,201 @@ static int logging_flash_save_buffer (const struct logging_flash *logging)
 			memmove (logging->state->entry_buffer, &logging->state->entry_buffer[write_len],
 				logging->state->next_write - logging->state->entry_buffer - write_len);
 			logging->state->next_write -= write_len;
+			if (write_len != 0) {
+				logging->state->split = true;
+			}
 		}
+
+		logging_flash_update_index (logging);
 	}
 
 	return status;
 }
 
+/**
+ * Update the log after data from the oldest pending sector has been written to flash.  If not all
+ * the data was written, the remaining data stays pending.
+ *
+ * @param logging The log that was written.
+ * @param written The number of bytes from the pending sector that were written to flash.
+ *
+ * @return 0 if all data from the pending sector was written or an error code.
+ */
+static int logging_flash_pending_written (const struct logging_flash *logging, size_t written)
+{
+	struct logging_flash_state *state = logging->state;
+	struct logging_flash_pending *sector;
+	uint8_t *data;
+	uint8_t curr_sector_num;
+
+	sector = &state->pending_sector[state->pending_first];
+	data = &state->pending[state->pending_first * FLASH_SECTOR_SIZE];
+	curr_sector_num = (FLASH_SECTOR_BASE (sector->addr) - logging->base_addr) / FLASH_SECTOR_SIZE;
+
+	logging_flash_index_sector (logging, curr_sector_num, data);
+	state->flash_used[curr_sector_num] += written;
+
+	if (written != sector->length) {
+		/* Keep the data that was not written so it gets saved on the next flush. */
+		memmove (data, &data[written], sector->length - written);
+		sector->addr += written;
+		sector->length -= written;
+		if (written != 0) {
+			state->split = true;
+		}
+
+		logging_flash_update_index (logging);
+		return LOGGING_INCOMPLETE_FLUSH;
+	}
+
+	if (sector->terminated) {
+		state->flash_used[curr_sector_num] -= sizeof (struct logging_entry_header);
+	}
+
+	logging_flash_update_index (logging);
+
+	state->pending_first = (state->pending_first + 1) % state->pending_max;
+	state->pending_count--;
+	state->split = false;
+
+	if (state->pending_count == 0) {
+		state->pending_first = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * Save all full sectors waiting in the pending buffer to flash.  Sectors are written in the order
+ * they were filled.  The log lock must be held for the entire operation.
+ *
+ * @param logging The log that should be saved.
+ *
+ * @return 0 if all pending data was successfully saved or an error code.
+ */
+static int logging_flash_save_pending (const struct logging_flash *logging)
+{
+	struct logging_flash_state *state = logging->state;
+	struct logging_flash_pending *sector;
+	int status;
+
+	while (state->pending_count != 0) {
+		sector = &state->pending_sector[state->pending_first];
+
+		status = logging_flash_prepare_sector (logging, sector->addr);
+		if (status != 0) {
+			return status;
+		}
+
+		status = spi_flash_write (logging->flash, sector->addr,
+			&state->pending[state->pending_first * FLASH_SECTOR_SIZE], sector->length);
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		status = logging_flash_pending_written (logging, status);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Write the oldest pending sector to flash.  The log lock is only held while updating the log
+ * state, so new entries can be added to the log while flash is being erased and written.  This
+ * must only be called by the context holding the flush lock.
+ *
+ * @param logging The log that should be saved.
+ *
+ * @return 0 if the pending sector was successfully saved or an error code.
+ */
+static int logging_flash_write_pending (const struct logging_flash *logging)
+{
+	struct logging_flash_state *state = logging->state;
+	const uint8_t *data;
+	uint32_t addr;
+	size_t length;
+	bool erase;
+	int status;
+
+	platform_mutex_lock (&state->lock);
+
+	addr = state->pending_sector[state->pending_first].addr;
+	length = state->pending_sector[state->pending_first].length;
+	data = &state->pending[state->pending_first * FLASH_SECTOR_SIZE];
+
+	erase = logging_flash_needs_erase (logging, addr);
+	if (erase) {
+		/* Stop reporting the old entries before the sector gets erased. */
+		logging_flash_remove_sector (logging, addr);
+	}
+
+	platform_mutex_unlock (&state->lock);
+
+	/* A pending sector is not modified by any other context until it is removed from the pending
+	 * buffer, so the data can be written without holding the lock. */
+	if (erase) {
+		status = spi_flash_sector_erase (logging->flash, addr);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	status = spi_flash_write (logging->flash, addr, data, length);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	platform_mutex_lock (&state->lock);
+	status = logging_flash_pending_written (logging, status);
+	platform_mutex_unlock (&state->lock);
+
+	return status;
+}
+
+/**
+ * Move the entries in the entry buffer to the pending buffer so they can be written to flash during
+ * the next flush.  If the entry buffer still has space for more entries, new entries will be
+ * written to the same flash sector.  There must be space available in the pending buffer.
+ *
+ * @param logging The log to update.
+ */
+static void logging_flash_defer_buffer (const struct logging_flash *logging)
+{
+	struct logging_flash_state *state = logging->state;
+	struct logging_flash_pending *sector;
+	size_t index;
+
+	if (state->next_write == state->entry_buffer) {
+		return;
+	}
+
+	index = (state->pending_first + state->pending_count) % state->pending_max;
+	sector = &state->pending_sector[index];
+
+	sector->addr = state->next_addr;
+	sector->length = state->next_write - state->entry_buffer;
+	sector->terminated = state->terminated;
+	memcpy (&state->pending[index * FLASH_SECTOR_SIZE], state->entry_buffer, sector->length);
+	state->pending_count++;
+
+	state->next_addr += sector->length;
+	if ((FLASH_SECTOR_OFFSET (state->next_addr) != 0) &&
+		((state->write_remain < (int) sizeof (struct logging_entry_header)) || state->terminated)) {
+		state->next_addr = FLASH_SECTOR_BASE (state->next_addr) + FLASH_SECTOR_SIZE;
+	}
+
+	if (state->next_addr >= (logging->base_addr + LOGGING_FLASH_AREA_LEN)) {
+		state->next_addr = logging->base_addr;
+	}
+
+	state->next_write = state->entry_buffer;
+	state->write_remain = sizeof (state->entry_buffer) - FLASH_SECTOR_OFFSET (state->next_addr);
+	state->terminated = false;
+}
+
 /**
  * Write an entry header to the entry buffer.  It assumed there is sufficient space for the header.
  *
@@ -136,6 +464,14 @@ int logging_flash_create_entry (const struct logging *logging, uint8_t *entry, s
 
 	if (flash_log->state->terminated ||
 		(flash_log->state->write_remain < (int) (sizeof (struct logging_entry_header) + length))) {
+		if ((flash_log->state->pending != NULL) &&
+			(flash_log->state->pending_count >= flash_log->state->pending_max)) {
+			/* Writing the buffered entries now would block on flash, so drop the new entry until a
+			 * flush makes room for it. */
+			flash_log->state->dropped++;
+			platform_mutex_unlock (&flash_log->state->lock);
+			return LOGGING_ENTRY_DROPPED;
+		}
 
 		if (!flash_log->state->terminated &&
 			(flash_log->state->write_remain >= (int) sizeof (struct logging_entry_header))) {
@@ -143,10 +479,15 @@ int logging_flash_create_entry (const struct logging *logging, uint8_t *entry, s
 			flash_log->state->terminated = true;
 		}
 
-		status = logging_flash_save_buffer (flash_log);
-		if (status != 0) {
-			platform_mutex_unlock (&flash_log->state->lock);
-			return status;
+		if (flash_log->state->pending != NULL) {
+			logging_flash_defer_buffer (flash_log);
+		}
+		else {
+			status = logging_flash_save_buffer (flash_log);
+			if (status != 0) {
+				platform_mutex_unlock (&flash_log->state->lock);
+				return status;
+			}
 		}
 	}
 
@@ -160,6 +501,78 @@ int logging_flash_create_entry (const struct logging *logging, uint8_t *entry, s
 	return 0;
 }
 
+/**
+ * Write all entries buffered in memory to flash when deferred flushing is enabled.  The log is only
+ * locked while updating the log state, so new entries can be added while flash is being written.
+ * The flush lock must be held by the caller.
+ *
+ * @param logging The log to flush.
+ *
+ * @return 0 if all buffered entries were written to flash or an error code.
+ */
+static int logging_flash_flush_deferred (const struct logging_flash *logging)
+{
+	struct logging_flash_state *state = logging->state;
+	size_t count;
+	bool buffered;
+	uint32_t addr;
+	bool erase;
+	int pass;
+	int status;
+
+	/* Move the partial entry buffer to the pending buffer so it gets written with the full sectors.
+	 * If the pending buffer is full, write the full sectors first to make room. */
+	for (pass = 0; pass < 2; pass++) {
+		platform_mutex_lock (&state->lock);
+
+		buffered = (state->pending_count >= state->pending_max);
+		if (!buffered) {
+			logging_flash_defer_buffer (logging);
+		}
+
+		count = state->pending_count;
+
+		platform_mutex_unlock (&state->lock);
+
+		while (count-- != 0) {
+			status = logging_flash_write_pending (logging);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		if (!buffered) {
+			break;
+		}
+	}
+
+	/* Erase the sector that will receive the next entries now so it doesn't need to happen when
+	 * those entries are being saved. */
+	platform_mutex_lock (&state->lock);
+
+	addr = state->next_addr;
+	erase = (state->pending_count == 0) && (FLASH_SECTOR_OFFSET (addr) == 0) && !state->erased;
+	if (erase) {
+		logging_flash_remove_sector (logging, addr);
+	}
+
+	platform_mutex_unlock (&state->lock);
+
+	if (!erase) {
+		return 0;
+	}
+
+	status = spi_flash_sector_erase (logging->flash, addr);
+	if (status == 0) {
+		platform_mutex_lock (&state->lock);
+		state->erased_addr = addr;
+		state->erased = true;
+		platform_mutex_unlock (&state->lock);
+	}
+
+	return status;
+}
+
 int logging_flash_flush (const struct logging *logging)
 {
 	const struct logging_flash *flash_log = (const struct logging_flash*) logging;
@@ -169,9 +582,18 @@ int logging_flash_flush (const struct logging *logging)
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash_log->state->lock);
-	status = logging_flash_save_buffer (flash_log);
-	platform_mutex_unlock (&flash_log->state->lock);
+	platform_mutex_lock (&flash_log->state->flush_lock);
+
+	if (flash_log->state->pending != NULL) {
+		status = logging_flash_flush_deferred (flash_log);
+	}
+	else {
+		platform_mutex_lock (&flash_log->state->lock);
+		status = logging_flash_save_buffer (flash_log);
+		platform_mutex_unlock (&flash_log->state->lock);
+	}
+
+	platform_mutex_unlock (&flash_log->state->flush_lock);
 
 	return status;
 }
@@ -185,6 +607,7 @@ int logging_flash_clear (const struct logging *logging)
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
+	platform_mutex_lock (&flash_log->state->flush_lock);
 	platform_mutex_lock (&flash_log->state->lock);
 
 	status = spi_flash_block_erase (flash_log->flash, flash_log->base_addr);
@@ -194,17 +617,69 @@ int logging_flash_clear (const struct logging *logging)
 
 	memset (flash_log->state->flash_used, 0, sizeof (flash_log->state->flash_used));
 	flash_log->state->log_start = 0;
+	flash_log->state->index_count = 0;
+	flash_log->state->tail_valid = false;
+	flash_log->state->split = false;
 
 	flash_log->state->next_addr = flash_log->base_addr;
 	flash_log->state->next_write = flash_log->state->entry_buffer;
 	flash_log->state->write_remain = sizeof (flash_log->state->entry_buffer);
 	flash_log->state->terminated = false;
+	flash_log->state->pending_first = 0;
+	flash_log->state->pending_count = 0;
+
+	/* When tracking sectors erased ahead of time, note that the first sector is already erased. */
+	flash_log->state->erased_addr = flash_log->base_addr;
+	flash_log->state->erased = (flash_log->state->pending != NULL);
 
 exit:
 	platform_mutex_unlock (&flash_log->state->lock);
+	platform_mutex_unlock (&flash_log->state->flush_lock);
 	return status;
 }
 
+/**
+ * Get the amount of valid log data held in a pending sector.
+ *
+ * @param sector The pending sector to query.
+ *
+ * @return The number of bytes of log data in the sector.
+ */
+static size_t logging_flash_pending_length (const struct logging_flash_pending *sector)
+{
+	if (sector->terminated) {
+		return sector->length - sizeof (struct logging_entry_header);
+	}
+	else {
+		return sector->length;
+	}
+}
+
+/**
+ * Get the amount of log data held in memory that has not yet been written to flash.
+ *
+ * @param state The log state to query.
+ *
+ * @return The number of log bytes waiting to be written.
+ */
+static size_t logging_flash_buffered_length (const struct logging_flash_state *state)
+{
+	size_t pending;
+	size_t length = 0;
+
+	for (pending = 0; pending < state->pending_count; ++pending) {
+		length += logging_flash_pending_length (
+			&state->pending_sector[(state->pending_first + pending) % state->pending_max]);
+	}
+
+	length += (state->next_write - state->entry_buffer);
+	if (state->terminated) {
+		length -= sizeof (struct logging_entry_header);
+	}
+
+	return length;
+}
+
 int logging_flash_get_size (const struct logging *logging)
 {
 	const struct logging_flash *flash_log = (const struct logging_flash*) logging;
@@ -221,76 +696,276 @@ int logging_flash_get_size (const struct logging *logging)
 		log_size += flash_log->state->flash_used[sector];
 	}
 
-	log_size += (flash_log->state->next_write - flash_log->state->entry_buffer);
-	if (flash_log->state->terminated) {
-		log_size -= sizeof (struct logging_entry_header);
-	}
+	log_size += logging_flash_buffered_length (flash_log->state);
 
 	platform_mutex_unlock (&flash_log->state->lock);
 
 	return log_size;
 }
 
-int logging_flash_read_contents (const struct logging *logging, uint32_t offset, uint8_t *contents,
-	size_t length)
+/**
+ * Find the position in the log of the flash sector that contains a byte offset.  The offset must
+ * be within the data stored in flash.
+ *
+ * @param state The log state to search.
+ * @param offset The offset in the log contents to find.
+ *
+ * @return The position of the sector, relative to the sector with the oldest entries.
+ */
+static int logging_flash_find_sector (const struct logging_flash_state *state, uint32_t offset)
 {
-	const struct logging_flash *flash_log = (const struct logging_flash*) logging;
+	int low = 0;
+	int high = state->index_count - 1;
+	int mid;
+
+	while (low < high) {
+		mid = (low + high + 1) / 2;
+		if (state->index[LOGGING_FLASH_SECTOR_AT (state, mid)].offset <= offset) {
+			low = mid;
+		}
+		else {
+			high = mid - 1;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * Read log data, including entries that have not yet been written to flash.  The log must be
+ * locked by the caller.
+ *
+ * @param logging The log to read.
+ * @param offset The offset in the log contents to start reading from.
+ * @param contents Output buffer for the log data.
+ * @param length Maximum number of bytes to read.
+ *
+ * @return The number of bytes read or an error code.
+ */
+static int logging_flash_read_log (const struct logging_flash *logging, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	struct logging_flash_state *state = logging->state;
 	int bytes_read = 0;
 	int i;
-	int sectors;
+	int pos;
+	size_t pending;
+	size_t index;
 	size_t read_len;
 	uint32_t read_offset;
+	uint32_t stored;
 	int status;
 
-	if ((flash_log == NULL) || (contents == NULL)) {
-		return LOGGING_INVALID_ARGUMENT;
-	}
-
-	platform_mutex_lock (&flash_log->state->lock);
-
-	i = flash_log->state->log_start;
-	sectors = 0;
+	stored = logging_flash_stored_length (state);
+	if (offset < stored) {
+		/* Use the index to start reading from the sector that contains the requested data. */
+		pos = logging_flash_find_sector (state, offset);
+		offset -= state->index[LOGGING_FLASH_SECTOR_AT (state, pos)].offset;
 
-	while ((length != 0) && (sectors < LOGGING_FLASH_SECTORS) &&
-		(flash_log->state->flash_used[i] != 0)) {
+		while ((length != 0) && (pos < state->index_count)) {
+			i = LOGGING_FLASH_SECTOR_AT (state, pos);
+			read_len = (length < (state->flash_used[i] - offset)) ?
+				length : (state->flash_used[i] - offset);
 
-		read_offset = (offset < flash_log->state->flash_used[i]) ?
-			offset : flash_log->state->flash_used[i];
-		read_len = (length < (flash_log->state->flash_used[i] - read_offset)) ?
-			length : (flash_log->state->flash_used[i] - read_offset);
-
-		if (read_len != 0) {
-			status = spi_flash_read (flash_log->flash,
-				flash_log->base_addr + (FLASH_SECTOR_SIZE * i) + read_offset, contents, read_len);
+			status = spi_flash_read (logging->flash,
+				logging->base_addr + (FLASH_SECTOR_SIZE * i) + offset, contents, read_len);
 			if (status != 0) {
-				platform_mutex_unlock (&flash_log->state->lock);
 				return status;
 			}
+
+			bytes_read += read_len;
+			contents += read_len;
+			length -= read_len;
+			offset = 0;
+			pos++;
 		}
+	}
+	else {
+		offset -= stored;
+	}
+
+	/* After reading all data from flash, read buffered entries that haven't been flushed yet,
+	 * starting with full sectors waiting to be written. */
+	for (pending = 0; (length != 0) && (pending < state->pending_count); ++pending) {
+		index = (state->pending_first + pending) % state->pending_max;
+		read_len = logging_flash_pending_length (&state->pending_sector[index]);
+
+		read_offset = (offset < read_len) ? offset : read_len;
+		read_len = (length < (read_len - read_offset)) ? length : (read_len - read_offset);
+
+		memcpy (contents, &state->pending[(index * FLASH_SECTOR_SIZE) + read_offset], read_len);
 
 		bytes_read += read_len;
 		contents += read_len;
 		length -= read_len;
 		offset -= read_offset;
-
-		i = (i + 1) % LOGGING_FLASH_SECTORS;
-		sectors++;
 	}
 
-	/* After reading all data from flash, read buffered entries that haven't been flushed yet. */
-	read_len = flash_log->state->next_write - flash_log->state->entry_buffer;
-	if (flash_log->state->terminated) {
+	read_len = state->next_write - state->entry_buffer;
+	if (state->terminated) {
 		read_len -= sizeof (struct logging_entry_header);
 	}
 	read_offset = (offset < read_len) ? offset : read_len;
 	read_len = (length < (read_len - read_offset)) ? length : (read_len - read_offset);
 
-	memcpy (contents, flash_log->state->entry_buffer + read_offset, read_len);
+	memcpy (contents, state->entry_buffer + read_offset, read_len);
 	bytes_read += read_len;
 
+	return bytes_read;
+}
+
+int logging_flash_read_contents (const struct logging *logging, uint32_t offset, uint8_t *contents,
+	size_t length)
+{
+	const struct logging_flash *flash_log = (const struct logging_flash*) logging;
+	int status;
+
+	if ((flash_log == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash_log->state->lock);
+	status = logging_flash_read_log (flash_log, offset, contents, length);
 	platform_mutex_unlock (&flash_log->state->lock);
 
-	return bytes_read;
+	return status;
+}
+
+/**
+ * Get the oldest log entry that is being held in memory waiting to be written to flash.
+ *
+ * @param state The log state to query.
+ *
+ * @return The header for the oldest buffered entry or null if there are no buffered entries or the
+ * buffered data does not start with a complete entry.
+ */
+static const struct logging_entry_header* logging_flash_first_buffered (
+	const struct logging_flash_state *state)
+{
+	if (state->split || (logging_flash_buffered_length (state) == 0)) {
+		return NULL;
+	}
+
+	if (state->pending_count != 0) {
+		return (const struct logging_entry_header*)
+			&state->pending[state->pending_first * FLASH_SECTOR_SIZE];
+	}
+	else {
+		return (const struct logging_entry_header*) state->entry_buffer;
+	}
+}
+
+/**
+ * Find the offset in the log contents of the first entry with an ID that is the same or newer than
+ * a specified ID.  The log must be locked by the caller.
+ *
+ * @param logging The log to search.
+ * @param entry_id The entry ID to find.
+ * @param offset Output for the offset of the entry.  If there are no entries that match, this will
+ * be the total size of the log.
+ *
+ * @return 0 if the offset was determined successfully or an error code.
+ */
+static int logging_flash_find_entry (const struct logging_flash *logging, uint32_t entry_id,
+	uint32_t *offset)
+{
+	struct logging_flash_state *state = logging->state;
+	const struct logging_entry_header *buffered;
+	struct logging_entry_header header;
+	uint32_t next = 0;
+	int low = 0;
+	int high = state->index_count - 1;
+	int mid;
+	int sector;
+	int status;
+
+	if ((int32_t) (entry_id - state->next_entry_id) >= 0) {
+		*offset = logging_flash_stored_length (state) + logging_flash_buffered_length (state);
+		return 0;
+	}
+
+	if (state->tail_valid && (entry_id == state->tail_id) &&
+		((int32_t) (state->tail_pos - state->log_base) >= 0)) {
+		/* The entry is the one following the last entry read while tailing the log. */
+		*offset = state->tail_pos - state->log_base;
+		return 0;
+	}
+
+	buffered = logging_flash_first_buffered (state);
+	if ((buffered != NULL) && ((int32_t) (entry_id - buffered->entry_id) >= 0)) {
+		/* The entry has not been written to flash, so only buffered entries need to be searched. */
+		next = logging_flash_stored_length (state);
+	}
+	else {
+		/* Find the newest sector that starts with an entry no newer than the requested ID.  Entry
+		 * IDs are compared in a way that allows for the ID counter to wrap. */
+		while (low <= high) {
+			mid = (low + high) / 2;
+			sector = LOGGING_FLASH_SECTOR_AT (state, mid);
+
+			if ((int32_t) (state->index[sector].first_id - entry_id) <= 0) {
+				next = state->index[sector].offset;
+				if (state->index[sector].first_id == entry_id) {
+					*offset = next;
+					return 0;
+				}
+
+				low = mid + 1;
+			}
+			else {
+				high = mid - 1;
+			}
+		}
+
+		if ((high < 0) && (state->index_count != 0)) {
+			/* All entries in the log are newer than the requested ID. */
+			*offset = 0;
+			return 0;
+		}
+	}
+
+	/* Walk the entries from the start of that sector to find the requested entry.  This will
+	 * continue into entries that have not yet been written to flash, if necessary. */
+	while (1) {
+		status = logging_flash_read_log (logging, next, (uint8_t*) &header, sizeof (header));
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		if ((status < (int) sizeof (header)) || ((int32_t) (header.entry_id - entry_id) >= 0) ||
+			(header.length < sizeof (header))) {
+			break;
+		}
+
+		next += header.length;
+	}
+
+	*offset = next;
+	return 0;
+}
+
+/**
+ * Configure the buffer used to hold full sectors of entries for deferred flushing.  The log lock
+ * must be held by the caller if the log is in use.
+ *
+ * @param logging The log to configure.
+ * @param buffer The buffer for pending sectors or null to disable deferred flushing.
+ * @param length Length of the pending buffer.
+ */
+static void logging_flash_set_pending_buffer (const struct logging_flash *logging, uint8_t *buffer,
+	size_t length)
+{
+	logging->state->pending = buffer;
+	if (buffer != NULL) {
+		logging->state->pending_max = length / FLASH_SECTOR_SIZE;
+		if (logging->state->pending_max > LOGGING_FLASH_MAX_PENDING_SECTORS) {
+			logging->state->pending_max = LOGGING_FLASH_MAX_PENDING_SECTORS;
+		}
+	}
+	else {
+		logging->state->pending_max = 0;
+		logging->state->erased = false;
+	}
 }
 
 /**
@@ -309,6 +984,36 @@ int logging_flash_read_contents (const struct logging *logging, uint32_t offset,
  */
 int logging_flash_init (struct logging_flash *logging, struct logging_flash_state *state,
 	const struct spi_flash *flash, uint32_t base_addr)
+{
+	return logging_flash_init_with_deferred_flush (logging, state, flash, base_addr, NULL, 0);
+}
+
+/**
+ * Initialize a log that uses flash for persistent storage and has deferred flushing enabled.  Log
+ * entries already on flash will be detected and maintained.
+ *
+ * Full sectors of log entries will only be written to flash when the log is flushed, so the log
+ * must be registered with a task that periodically flushes it, such as a log flush handler.  See
+ * logging_flash_enable_deferred_flush for details about deferred flushing.
+ *
+ * The log will consume an entire flash erase block.
+ *
+ * @param logging The log to initialize.
+ * @param state Variable context for the log.  This must be uninitialized.
+ * @param flash The flash device where log entries are stored.
+ * @param base_addr The starting address for log entries.  This must be aligned to the beginning of
+ * an erase block.
+ * @param pending Buffer to hold full sectors of entries waiting to be written to flash.  This must
+ * be large enough to hold at least one flash sector.  Set this to null to create a log that writes
+ * full sectors to flash as entries are added.
+ * @param length Length of the pending buffer.  No more than LOGGING_FLASH_MAX_PENDING_SECTORS
+ * sectors of the buffer will be used.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int logging_flash_init_with_deferred_flush (struct logging_flash *logging,
+	struct logging_flash_state *state, const struct spi_flash *flash, uint32_t base_addr,
+	uint8_t *pending, size_t length)
 {
 	if ((logging == NULL) || (flash == NULL) || (state == NULL)) {
 		return LOGGING_INVALID_ARGUMENT;
@@ -325,6 +1030,8 @@ int logging_flash_init (struct logging_flash *logging, struct logging_flash_stat
 	logging->state = state;
 	logging->flash = flash;
 	logging->base_addr = base_addr;
+	logging->pending_buffer = pending;
+	logging->pending_length = length;
 
 	return logging_flash_init_state (logging);
 }
@@ -354,6 +1061,10 @@ int logging_flash_init_state (const struct logging_flash *logging)
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
+	if ((logging->pending_buffer != NULL) && (logging->pending_length < FLASH_SECTOR_SIZE)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
 	if (FLASH_BLOCK_BASE (logging->base_addr) != logging->base_addr) {
 		return LOGGING_STORAGE_NOT_ALIGNED;
 	}
@@ -435,6 +1146,10 @@ int logging_flash_init_state (const struct logging_flash *logging)
 					}
 				}
 
+				if (logging->state->flash_used[curr_sector_num] == 0) {
+					logging->state->index[curr_sector_num].first_id = header->entry_id;
+				}
+
 				logging->state->flash_used[curr_sector_num] += length;
 				pos += length;
 			}
@@ -455,6 +1170,15 @@ int logging_flash_init_state (const struct logging_flash *logging)
 		return status;
 	}
 
+	status = platform_mutex_init (&logging->state->flush_lock);
+	if (status != 0) {
+		platform_mutex_free (&logging->state->lock);
+		return status;
+	}
+
+	logging_flash_update_index (logging);
+	logging_flash_set_pending_buffer (logging, logging->pending_buffer, logging->pending_length);
+
 	logging->state->next_addr = flash_addr;
 	logging->state->next_entry_id = entry_id;
 	logging->state->next_write = logging->state->entry_buffer;
@@ -473,6 +1197,184 @@ int logging_flash_init_state (const struct logging_flash *logging)
 void logging_flash_release (const struct logging_flash *logging)
 {
 	if (logging) {
+		platform_mutex_free (&logging->state->flush_lock);
 		platform_mutex_free (&logging->state->lock);
 	}
 }
+
+/**
+ * Enable deferred flushing of log entries.  When enabled, full sectors of log entries are held in
+ * memory until the log is flushed rather than being written to flash as soon as the entry buffer
+ * is full.  This allows multiple sectors to be written by the context that handles periodic log
+ * flushes instead of blocking the context that is creating log entries.  Each flush will also
+ * erase the sector that will receive the next entries, if necessary, so creating entries does not
+ * need to wait for a sector erase.
+ *
+ * The flushes are expected to come from the periodic task running a log flush handler that
+ * contains this log.  Without such a task, entries will be dropped once the pending buffer fills.
+ * Deferred flushing can also be enabled when the log is initialized by using
+ * logging_flash_init_with_deferred_flush or logging_flash_static_init_with_deferred_flush.
+ *
+ * Adding a log entry never writes to flash.  If the pending buffer is full when the entry buffer
+ * needs to be moved to it, the new entry is dropped and counted.  Flushes only hold the log lock
+ * while updating the log state, so entries can be added while flash is being erased or written.
+ *
+ * Erasing the next sector ahead of time means that when the log has wrapped, the oldest entries
+ * will be removed before it is strictly necessary.
+ *
+ * @param logging The log to configure.
+ * @param buffer Buffer to hold full sectors of entries waiting to be written to flash.  This must
+ * be large enough to hold at least one flash sector and must remain valid for as long as deferred
+ * flushing is enabled.  Set this to null to disable deferred flushing.  Any pending entries will
+ * be written to flash before the buffer is changed.
+ * @param length Length of the pending buffer.  No more than LOGGING_FLASH_MAX_PENDING_SECTORS
+ * sectors of the buffer will be used.
+ *
+ * @return 0 if deferred flushing was configured successfully or an error code.
+ */
+int logging_flash_enable_deferred_flush (const struct logging_flash *logging, uint8_t *buffer,
+	size_t length)
+{
+	int status;
+
+	if ((logging == NULL) || ((buffer != NULL) && (length < FLASH_SECTOR_SIZE))) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&logging->state->flush_lock);
+	platform_mutex_lock (&logging->state->lock);
+
+	status = logging_flash_save_pending (logging);
+	if (status != 0) {
+		goto exit;
+	}
+
+	logging_flash_set_pending_buffer (logging, buffer, length);
+
+exit:
+	platform_mutex_unlock (&logging->state->lock);
+	platform_mutex_unlock (&logging->state->flush_lock);
+	return status;
+}
+
+/**
+ * Get the number of log entries that have been dropped because there was no space to buffer them
+ * while waiting for a flush.  Entries can only be dropped when deferred flushing is enabled.
+ *
+ * @param logging The log to query.
+ * @param count Output for the number of dropped entries.
+ *
+ * @return 0 if the count was retrieved successfully or an error code.
+ */
+int logging_flash_get_dropped_entries (const struct logging_flash *logging, uint32_t *count)
+{
+	if ((logging == NULL) || (count == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&logging->state->lock);
+	*count = logging->state->dropped;
+	platform_mutex_unlock (&logging->state->lock);
+
+	return 0;
+}
+
+/**
+ * Determine the offset in the log contents of a specific log entry.  This can be used to read the
+ * log starting at a specific entry.
+ *
+ * @param logging The log to query.
+ * @param entry_id ID of the entry to find.  If this entry is no longer in the log, the offset of
+ * the next newer entry will be provided.
+ * @param offset Output for the offset of the entry in the log contents.  If there are no entries
+ * that are the same or newer than the requested ID, this will be the total size of the log.
+ *
+ * @return 0 if the entry offset was determined successfully or an error code.
+ */
+int logging_flash_get_entry_offset (const struct logging_flash *logging, uint32_t entry_id,
+	uint32_t *offset)
+{
+	int status;
+
+	if ((logging == NULL) || (offset == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&logging->state->lock);
+	status = logging_flash_find_entry (logging, entry_id, offset);
+	platform_mutex_unlock (&logging->state->lock);
+
+	return status;
+}
+
+/**
+ * Read all log entries that are newer than a specified entry.  Only complete entries will be
+ * provided.  This allows the log to be tailed by passing the ID of the last entry previously read
+ * to get only the entries that have been added since then.
+ *
+ * @param logging The log to read.
+ * @param entry_id ID of the last entry that has already been read.
+ * @param contents Output buffer for the log entries.
+ * @param length Length of the output buffer.
+ *
+ * @return The number of bytes read or an error code.  If there are no newer entries in the log,
+ * no bytes will be read.
+ */
+int logging_flash_read_entries_after (const struct logging_flash *logging, uint32_t entry_id,
+	uint8_t *contents, size_t length)
+{
+	struct logging_entry_header header;
+	uint32_t offset;
+	int bytes_read;
+	int entries_len = 0;
+	int last_entry = 0;
+	int status;
+
+	if ((logging == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&logging->state->lock);
+
+	status = logging_flash_find_entry (logging, entry_id + 1, &offset);
+	if (status != 0) {
+		goto exit;
+	}
+
+	bytes_read = logging_flash_read_log (logging, offset, contents, length);
+	if (ROT_IS_ERROR (bytes_read)) {
+		status = bytes_read;
+		goto exit;
+	}
+
+	/* Drop any partial entry at the end of the output buffer. */
+	while ((bytes_read - entries_len) >= (int) sizeof (header)) {
+		memcpy (&header, &contents[entries_len], sizeof (header));
+		if ((header.length < sizeof (header)) || (header.length > (bytes_read - entries_len))) {
+			break;
+		}
+
+		last_entry = entries_len;
+		entries_len += header.length;
+	}
+
+	if ((entries_len == 0) && (bytes_read != 0)) {
+		status = LOGGING_BUFFER_TOO_SMALL;
+	}
+	else {
+		if (entries_len != 0) {
+			/* Remember where the next entry starts so the following read doesn't need to search
+			 * for it. */
+			memcpy (&header, &contents[last_entry], sizeof (header));
+			logging->state->tail_id = header.entry_id + 1;
+			logging->state->tail_pos = logging->state->log_base + offset + entries_len;
+			logging->state->tail_valid = true;
+		}
+
+		status = entries_len;
+	}
+
+exit:
+	platform_mutex_unlock (&logging->state->lock);
+	return status;
+}
@@ -18,12 +18,38 @@
 #define LOGGING_FLASH_AREA_LEN		FLASH_BLOCK_SIZE
 #define LOGGING_FLASH_SECTORS 		(LOGGING_FLASH_AREA_LEN / FLASH_SECTOR_SIZE)
 
+/**
+ * The maximum number of full sectors that can be held in memory waiting to be written to flash
+ * when deferred flushing is enabled.
+ */
+#ifndef LOGGING_FLASH_MAX_PENDING_SECTORS
+#define	LOGGING_FLASH_MAX_PENDING_SECTORS	4
+#endif
+
+
+/**
+ * Information about a full sector of log entries waiting to be written to flash.
+ */
+struct logging_flash_pending {
+	uint32_t addr;								/**< Flash address for the buffered data. */
+	size_t length;								/**< Number of bytes to write to flash. */
+	bool terminated;							/**< The data ends with a termination entry. */
+};
+
+/**
+ * Index information for the entries stored in a single flash sector.
+ */
+struct logging_flash_sector_index {
+	uint32_t first_id;							/**< ID of the first entry stored in the sector. */
+	uint32_t offset;							/**< Offset of the sector data in the log contents. */
+};
 
 /**
  * Variable context for a log that stores entries in SPI flash.
  */
 struct logging_flash_state {
 	platform_mutex lock;						/**< Synchronization for log accesses. */
+	platform_mutex flush_lock;					/**< Synchronization for writing to flash. */
 	uint8_t entry_buffer[FLASH_SECTOR_SIZE];	/**< Buffered entries waiting to be flushed. */
 	uint8_t *next_write;						/**< The next write position in the entry buffer. */
 	int write_remain;							/**< Remaining space in the entry buffer. */
@@ -32,6 +58,21 @@ struct logging_flash_state {
 	uint32_t flash_used[LOGGING_FLASH_SECTORS];	/**< Number of valid bytes stored in each sector. */
 	uint32_t next_addr;							/**< Next flash address to write to. */
 	int log_start;								/**< The sector that contains the first entries. */
+	uint8_t *pending;							/**< Buffer for full sectors waiting for a flush. */
+	size_t pending_max;							/**< Maximum number of buffered sectors. */
+	size_t pending_first;						/**< Index of the oldest buffered sector. */
+	size_t pending_count;						/**< Number of sectors waiting to be written. */
+	struct logging_flash_pending pending_sector[LOGGING_FLASH_MAX_PENDING_SECTORS];	/**< Pending sectors. */
+	uint32_t erased_addr;						/**< Address of a sector erased ahead of time. */
+	bool erased;								/**< Flag indicating a sector was erased early. */
+	uint32_t dropped;							/**< Entries dropped with no buffer space. */
+	struct logging_flash_sector_index index[LOGGING_FLASH_SECTORS];	/**< Index of each sector. */
+	int index_count;							/**< Number of sectors that contain entries. */
+	uint32_t log_base;							/**< Total bytes removed from the start of the log. */
+	uint32_t tail_id;							/**< ID of the next entry to tail from the log. */
+	uint32_t tail_pos;							/**< Log position of the next entry to tail. */
+	bool tail_valid;							/**< Flag indicating the tail position is valid. */
+	bool split;									/**< Buffered data starts in the middle of an entry. */
 };
 
 /**
@@ -42,13 +83,27 @@ struct logging_flash {
 	struct logging_flash_state *state;			/**< Variable context for the log instance. */
 	const struct spi_flash *flash;				/**< The flash where log entries are stored. */
 	uint32_t base_addr;							/**< The base address of the log data on flash. */
+	uint8_t *pending_buffer;					/**< Buffer for sectors waiting for a deferred flush. */
+	size_t pending_length;						/**< Length of the deferred flush buffer. */
 };
 
 
 int logging_flash_init (struct logging_flash *logging, struct logging_flash_state *state,
 	const struct spi_flash *flash, uint32_t base_addr);
+int logging_flash_init_with_deferred_flush (struct logging_flash *logging,
+	struct logging_flash_state *state, const struct spi_flash *flash, uint32_t base_addr,
+	uint8_t *pending, size_t length);
 int logging_flash_init_state (const struct logging_flash *logging);
 void logging_flash_release (const struct logging_flash *logging);
 
+int logging_flash_enable_deferred_flush (const struct logging_flash *logging, uint8_t *buffer,
+	size_t length);
+int logging_flash_get_dropped_entries (const struct logging_flash *logging, uint32_t *count);
+
+int logging_flash_get_entry_offset (const struct logging_flash *logging, uint32_t entry_id,
+	uint32_t *offset);
+int logging_flash_read_entries_after (const struct logging_flash *logging, uint32_t entry_id,
+	uint8_t *contents, size_t length);
+
 
 #endif /* LOGGING_FLASH_H_ */
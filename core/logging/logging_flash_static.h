@@ -54,5 +54,33 @@ int logging_flash_read_contents (const struct logging *logging, uint32_t offset,
 		.base_addr = flash_base_addr \
 	}
 
+#ifndef LOGGING_DISABLE_FLUSH
+/**
+ * Initialize a static instance of a log that uses SPI flash and defers writing full sectors of
+ * entries to flash until the log is flushed.  This can be a constant instance.
+ *
+ * The log must be registered with a task that periodically flushes it, such as a log flush handler,
+ * since no entries will be written to flash until then.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the log.
+ * @param flash_ptr The flash device where log entries are stored.
+ * @param flash_base_addr The starting address for log entries.  This must be aligned to the
+ * beginning of an erase block.
+ * @param pending_ptr Buffer to hold full sectors of entries waiting to be written to flash.
+ * @param pending_len Length of the pending buffer.  This must be at least one flash sector.
+ */
+#define	logging_flash_static_init_with_deferred_flush(state_ptr, flash_ptr, flash_base_addr, \
+	pending_ptr, pending_len)	{ \
+		.base = LOGGING_FLASH_API_INIT, \
+		.state = state_ptr, \
+		.flash = flash_ptr, \
+		.base_addr = flash_base_addr, \
+		.pending_buffer = pending_ptr, \
+		.pending_length = pending_len \
+	}
+#endif
+
 
 #endif /* LOGGING_FLASH_STATIC_H_ */
@@ -9,6 +9,172 @@
 #include "common/unused.h"
 
 
+/**
+ * Maximum number of attempts to get a consistent view of a lock-free log while new entries are
+ * overwriting the oldest entries.
+ */
+#define	LOGGING_MEMORY_LOCK_FREE_READ_RETRIES	3
+
+
+/**
+ * Get the number of entries that can be held by the log.
+ *
+ * @param mem_log The log to query.
+ *
+ * @return The number of entry slots in the log buffer.
+ */
+static size_t logging_memory_entry_count (const struct logging_memory *mem_log)
+{
+	return mem_log->log_size / mem_log->entry_size;
+}
+
+/**
+ * Get the buffer location for an entry in a lock-free log.  Lock-free logs always have a power of
+ * two number of entries, so the mapping from sequence number to slot is preserved when the
+ * sequence number wraps.
+ *
+ * @param mem_log The log containing the entry.
+ * @param seq Sequence number of the entry.
+ *
+ * @return The entry slot in the log buffer.
+ */
+static uint8_t* logging_memory_lock_free_slot (const struct logging_memory *mem_log, uint32_t seq)
+{
+	return &mem_log->log_buffer[(seq & (logging_memory_entry_count (mem_log) - 1)) *
+		mem_log->entry_size];
+}
+
+/**
+ * Add an entry to a lock-free log.  An entry slot is reserved atomically, so multiple contexts can
+ * add entries concurrently.  The entry only becomes visible to readers once the start marker has
+ * been written.
+ *
+ * @param mem_log The log to update.
+ * @param entry The entry data to add.
+ * @param length Length of the entry data.
+ */
+static void logging_memory_lock_free_create_entry (const struct logging_memory *mem_log,
+	const uint8_t *entry, size_t length)
+{
+	struct logging_entry_header header;
+	uint8_t *slot;
+	uint32_t seq;
+
+	seq = __atomic_fetch_add (&mem_log->state->reserved, 1, __ATOMIC_RELAXED);
+	slot = logging_memory_lock_free_slot (mem_log, seq);
+
+	/* Invalidate the slot while it is being updated so readers ignore the partial entry. */
+	__atomic_store_n (&slot[0], 0, __ATOMIC_RELAXED);
+	__atomic_thread_fence (__ATOMIC_RELEASE);
+
+	header.log_magic = LOGGING_MAGIC_START;
+	header.length = sizeof (header) + length;
+	header.entry_id = seq + mem_log->state->id_offset;
+
+	memcpy (&slot[sizeof (header)], entry, length);
+	memcpy (&slot[offsetof (struct logging_entry_header, length)],
+		&((uint8_t*) &header)[offsetof (struct logging_entry_header, length)],
+		sizeof (header) - offsetof (struct logging_entry_header, length));
+
+	__atomic_store_n (&slot[0], header.log_magic, __ATOMIC_RELEASE);
+}
+
+/**
+ * Determine the range of complete entries in a lock-free log.  Entries are valid up to the first
+ * slot that is still being written.  The log lock must be held by the caller.
+ *
+ * @param mem_log The log to query.
+ * @param first Output for the sequence number of the oldest entry.
+ * @param end Output for the sequence number after the newest complete entry.
+ */
+static void logging_memory_lock_free_range (const struct logging_memory *mem_log, uint32_t *first,
+	uint32_t *end)
+{
+	uint32_t count = logging_memory_entry_count (mem_log);
+	uint32_t reserved;
+	uint32_t entry_id;
+	uint8_t *slot;
+
+	reserved = __atomic_load_n (&mem_log->state->reserved, __ATOMIC_ACQUIRE);
+
+	*first = mem_log->state->first;
+	if ((reserved - *first) > count) {
+		*first = reserved - count;
+	}
+
+	*end = *first;
+	while (*end != reserved) {
+		slot = logging_memory_lock_free_slot (mem_log, *end);
+		if (__atomic_load_n (&slot[0], __ATOMIC_ACQUIRE) != LOGGING_MAGIC_START) {
+			break;
+		}
+
+		memcpy (&entry_id, &slot[offsetof (struct logging_entry_header, entry_id)],
+			sizeof (entry_id));
+		if (entry_id != (*end + mem_log->state->id_offset)) {
+			break;
+		}
+
+		(*end)++;
+	}
+}
+
+/**
+ * Read the contents of a lock-free log.  The log lock must be held by the caller.
+ *
+ * @param mem_log The log to read.
+ * @param offset The offset within the log to start reading.
+ * @param contents Output buffer for the log contents.
+ * @param length The maximum length of the contents that should be read.
+ *
+ * @return The number of bytes read from the log or an error code.  If new entries kept
+ * overwriting the entries being read, LOGGING_INCONSISTENT_READ is returned.
+ */
+static int logging_memory_lock_free_read_contents (const struct logging_memory *mem_log,
+	uint32_t offset, uint8_t *contents, size_t length)
+{
+	size_t count = logging_memory_entry_count (mem_log);
+	size_t bytes_read = 0;
+	size_t copy_offset;
+	size_t copy_length;
+	size_t start;
+	size_t entries;
+	uint32_t first;
+	uint32_t end;
+	int retry = 0;
+
+	do {
+		logging_memory_lock_free_range (mem_log, &first, &end);
+
+		copy_offset = offset;
+		copy_length = length;
+		start = first & (count - 1);
+		entries = end - first;
+
+		bytes_read = buffer_copy (&mem_log->log_buffer[start * mem_log->entry_size],
+			((start + entries) > count) ?
+				((count - start) * mem_log->entry_size) : (entries * mem_log->entry_size),
+			&copy_offset, &copy_length, contents);
+
+		if ((start + entries) > count) {
+			bytes_read += buffer_copy (mem_log->log_buffer,
+				(start + entries - count) * mem_log->entry_size, &copy_offset, &copy_length,
+				&contents[bytes_read]);
+		}
+
+		/* If writers wrapped around to entries that were being copied, the data could be
+		 * inconsistent and needs to be read again.  The fence keeps the copy from being reordered
+		 * after the check, pairing with the release fence taken by writers before they update an
+		 * entry. */
+		__atomic_thread_fence (__ATOMIC_ACQUIRE);
+		if ((__atomic_load_n (&mem_log->state->reserved, __ATOMIC_RELAXED) - first) <= count) {
+			return bytes_read;
+		}
+	} while (++retry < LOGGING_MEMORY_LOCK_FREE_READ_RETRIES);
+
+	return LOGGING_INCONSISTENT_READ;
+}
+
 int logging_memory_create_entry (const struct logging *logging, uint8_t *entry, size_t length)
 {
 	const struct logging_memory *mem_log = (const struct logging_memory*) logging;
@@ -22,6 +188,11 @@ int logging_memory_create_entry (const struct logging *logging, uint8_t *entry,
 		return LOGGING_BAD_ENTRY_LENGTH;
 	}
 
+	if (mem_log->state->lock_free) {
+		logging_memory_lock_free_create_entry (mem_log, entry, length);
+		return 0;
+	}
+
 	platform_mutex_lock (&mem_log->state->lock);
 
 	header.log_magic = LOGGING_MAGIC_START;
@@ -66,6 +237,15 @@ int logging_memory_clear (const struct logging *logging)
 
 	platform_mutex_lock (&mem_log->state->lock);
 
+	if (mem_log->state->lock_free) {
+		/* Entries can't be safely removed while writers may be active, so just discard all entries
+		 * that have been added so far. */
+		mem_log->state->first = __atomic_load_n (&mem_log->state->reserved, __ATOMIC_ACQUIRE);
+		platform_mutex_unlock (&mem_log->state->lock);
+
+		return 0;
+	}
+
 	mem_log->state->log_start = 0;
 	mem_log->state->log_end = 0;
 	mem_log->state->is_full = false;
@@ -87,7 +267,14 @@ int logging_memory_get_size (const struct logging *logging)
 
 	platform_mutex_lock (&mem_log->state->lock);
 
-	if ((mem_log->state->log_end != mem_log->state->log_start) || mem_log->state->is_full) {
+	if (mem_log->state->lock_free) {
+		uint32_t first;
+		uint32_t end;
+
+		logging_memory_lock_free_range (mem_log, &first, &end);
+		log_size = (end - first) * mem_log->entry_size;
+	}
+	else if ((mem_log->state->log_end != mem_log->state->log_start) || mem_log->state->is_full) {
 		if (mem_log->state->log_end == mem_log->state->log_start) {
 			log_size = mem_log->log_size;
 		}
@@ -112,7 +299,10 @@ int logging_memory_read_contents (const struct logging *logging, uint32_t offset
 
 	platform_mutex_lock (&mem_log->state->lock);
 
-	if ((mem_log->state->log_end != mem_log->state->log_start) || mem_log->state->is_full) {
+	if (mem_log->state->lock_free) {
+		bytes_read = logging_memory_lock_free_read_contents (mem_log, offset, contents, length);
+	}
+	else if ((mem_log->state->log_end != mem_log->state->log_start) || mem_log->state->is_full) {
 		if (mem_log->state->log_end == mem_log->state->log_start) {
 			first_copy = buffer_copy (&mem_log->log_buffer[mem_log->state->log_start],
 				mem_log->log_size - mem_log->state->log_start, &copy_offset, &length, contents);
@@ -386,3 +576,88 @@ void logging_memory_release (struct logging_memory *logging)
 		}
 	}
 }
+
+/**
+ * Switch a log to allow entries to be added without taking the log lock.  Entry slots are
+ * reserved atomically, so any number of contexts can add entries concurrently without contending
+ * on the lock.  Reading the log still takes the lock, so there can effectively only be a single
+ * reader at a time.
+ *
+ * Existing entries in the log are kept, and the log contents and size are reported in the same
+ * way.  While an entry is being written, it and all newer entries will not be reported by the log.
+ *
+ * Lock-free mode requires the log to hold a power of two number of entries.  The existing entries
+ * must also be aligned to entry boundaries and have consecutive entry IDs, ending with the most
+ * recent entry.  The log is left unchanged if these requirements are not met.
+ *
+ * Once enabled, lock-free mode cannot be disabled.  This must be called before any contexts start
+ * adding entries to the log.
+ *
+ * @param logging The log to update.
+ *
+ * @return 0 if the log was switched to lock-free mode or an error code.
+ */
+int logging_memory_enable_lock_free (const struct logging_memory *logging)
+{
+	const struct logging_entry_header *header;
+	uint32_t count;
+	uint32_t used;
+	uint32_t entries;
+	uint32_t entry_id;
+	uint32_t slot;
+	uint32_t i;
+	int status = 0;
+
+	if (logging == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&logging->state->lock);
+
+	if (!logging->state->lock_free) {
+		count = logging_memory_entry_count (logging);
+		used = logging->state->log_end / logging->entry_size;
+
+		if ((count == 0) || ((count & (count - 1)) != 0) ||
+			((logging->state->log_end % logging->entry_size) != 0) ||
+			((logging->state->log_start % logging->entry_size) != 0)) {
+			status = LOGGING_LOCK_FREE_UNSUPPORTED;
+			goto exit;
+		}
+
+		/* Existing entries get mapped to sequence numbers based on the entry IDs, so the IDs must
+		 * be consecutive from the oldest entry to the newest. */
+		entries = (logging->state->is_full) ? count : used;
+		entry_id = logging->state->next_entry_id - entries;
+		slot = logging->state->log_start / logging->entry_size;
+		for (i = 0; i < entries; i++) {
+			header = (const struct logging_entry_header*)
+				&logging->log_buffer[slot * logging->entry_size];
+			if (!LOGGING_IS_ENTRY_START (header->log_magic) || (header->entry_id != entry_id++)) {
+				status = LOGGING_LOCK_FREE_UNSUPPORTED;
+				goto exit;
+			}
+
+			slot = (slot + 1) & (count - 1);
+		}
+
+		/* Assign sequence numbers to existing entries such that each one maps to its current slot
+		 * in the log buffer. */
+		if (logging->state->is_full) {
+			logging->state->reserved = count + used;
+			logging->state->first = used;
+		}
+		else {
+			logging->state->reserved = used;
+			logging->state->first = 0;
+		}
+
+		logging->state->id_offset = logging->state->next_entry_id - logging->state->reserved;
+		logging->state->lock_free = true;
+	}
+
+exit:
+	platform_mutex_unlock (&logging->state->lock);
+
+	return status;
+}
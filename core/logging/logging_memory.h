@@ -20,6 +20,10 @@ struct logging_memory_state {
 	size_t log_end;						/**< The end of the log where new entries will be added. */
 	uint32_t next_entry_id;				/**< Next ID to assign to a log entry. */
 	bool is_full;						/**< Flag indicating when the log is full. */
+	bool lock_free;						/**< Flag indicating entries are added without locking. */
+	uint32_t reserved;					/**< Number of entry slots reserved by lock-free writers. */
+	uint32_t first;						/**< Sequence number of the oldest lock-free entry. */
+	uint32_t id_offset;					/**< Difference between entry IDs and sequence numbers. */
 };
 
 /**
@@ -48,5 +52,7 @@ int logging_memory_init_state_append_existing (const struct logging_memory *logg
 
 void logging_memory_release (struct logging_memory *logging);
 
+int logging_memory_enable_lock_free (const struct logging_memory *logging);
+
 
 #endif /* LOGGING_MEMORY_H_ */
@@ -1447,6 +1447,14 @@ int cfm_flash_init (struct cfm_flash *cfm, const struct flash *flash, struct has
 		return status;
 	}
 
+#if CFM_FLASH_TOC_CACHE_ENTRIES
+	status = manifest_flash_enable_toc_cache (&cfm->base_flash, cfm->toc_cache,
+		sizeof (cfm->toc_cache));
+	if (status != 0) {
+		return status;
+	}
+#endif
+
 	cfm->base.base.verify = cfm_flash_verify;
 	cfm->base.base.get_id = cfm_flash_get_id;
 	cfm->base.base.get_platform_id = cfm_flash_get_platform_id;
@@ -10,12 +10,31 @@
 #include "flash/flash.h"
 
 
+/**
+ * The number of table of contents entries and SHA-256 element hashes that can be cached for a CFM.
+ * When this is not 0, every CFM instance contains a cache of this size that is enabled during
+ * initialization.  Manifests with a larger table of contents, or that use larger hashes, will read
+ * the table of contents from flash for every element lookup.  The cache is disabled by default.
+ */
+#ifndef CFM_FLASH_TOC_CACHE_ENTRIES
+#define	CFM_FLASH_TOC_CACHE_ENTRIES		0
+#endif
+
+#if CFM_FLASH_TOC_CACHE_ENTRIES
+#define	CFM_FLASH_TOC_CACHE_SIZE	\
+	MANIFEST_FLASH_TOC_CACHE_SIZE (CFM_FLASH_TOC_CACHE_ENTRIES, CFM_FLASH_TOC_CACHE_ENTRIES, \
+		SHA256_HASH_LENGTH)
+#endif
+
 /**
  * Defines a CFM that is stored in flash memory.
  */
 struct cfm_flash {
 	struct cfm base;							/**< The base CFM instance. */
 	struct manifest_flash base_flash;			/**< The base CFM flash instance. */
+#if CFM_FLASH_TOC_CACHE_ENTRIES
+	uint8_t toc_cache[CFM_FLASH_TOC_CACHE_SIZE];	/**< Cache for the verified table of contents. */
+#endif
 };
 
 
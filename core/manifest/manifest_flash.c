@@ -116,6 +116,50 @@ void manifest_flash_release (struct manifest_flash *manifest)
 	}
 }
 
+/**
+ * Provide a buffer to cache the table of contents of a version 2 manifest.  When the table of
+ * contents fits in the cache, it will be read and validated once during manifest verification.
+ * Subsequent element lookups will use the cached entries and element hashes instead of reading and
+ * hashing the table of contents from flash.
+ *
+ * If the table of contents is larger than the cache, or if it fails validation, element lookups
+ * will continue to read the table of contents from flash.
+ *
+ * @param manifest The manifest that should cache the table of contents.
+ * @param toc_cache Buffer to use for the cached table of contents.  Use
+ * MANIFEST_FLASH_TOC_CACHE_SIZE to determine the necessary size.  This buffer must remain valid
+ * for the lifetime of the manifest instance.
+ * @param max_toc_cache Length of the cache buffer.
+ *
+ * @return 0 if the cache was configured successfully or an error code.
+ */
+int manifest_flash_enable_toc_cache (struct manifest_flash *manifest, uint8_t *toc_cache,
+	size_t max_toc_cache)
+{
+	if ((manifest == NULL) || (toc_cache == NULL) || (max_toc_cache == 0)) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+
+	manifest->toc_cache = toc_cache;
+	manifest->max_toc_cache = max_toc_cache;
+	manifest->toc_cache_valid = false;
+
+	return 0;
+}
+
+/**
+ * Discard any cached table of contents data.  This must be called whenever the flash region
+ * containing the manifest is modified.  The cache will be reloaded on the next verification.
+ *
+ * @param manifest The manifest whose cache should be invalidated.
+ */
+void manifest_flash_invalidate_toc_cache (struct manifest_flash *manifest)
+{
+	if (manifest) {
+		manifest->toc_cache_valid = false;
+	}
+}
+
 /**
  * Read the manifest header and run validity checking on the contents:
  * - Check the magic number.
@@ -183,6 +227,50 @@ static int manifest_flash_verify_v1 (struct manifest_flash *manifest, struct has
 	return status;
 }
 
+/**
+ * Check the cached table of contents against the table of contents hash.  The cache is only used
+ * for element lookups if this check passes.  Otherwise, the table of contents will be read from
+ * flash, which will report the validation failure when elements are accessed.
+ *
+ * @param manifest The manifest with the cached table of contents.
+ * @param hash The hash engine to use for validation.
+ * @param toc_length Length of the cached table of contents data.
+ *
+ * @return true if the cached table of contents is valid or false if not.
+ */
+static bool manifest_flash_validate_toc_cache (struct manifest_flash *manifest,
+	struct hash_engine *hash, size_t toc_length)
+{
+	uint8_t validate_hash[SHA512_HASH_LENGTH];
+	int status;
+
+	status = hash_start_new_hash (hash, manifest->toc_hash_type);
+	if (status != 0) {
+		return false;
+	}
+
+	status = hash->update (hash, (uint8_t*) &manifest->toc_header, sizeof (manifest->toc_header));
+	if (status != 0) {
+		goto error;
+	}
+
+	status = hash->update (hash, manifest->toc_cache, toc_length);
+	if (status != 0) {
+		goto error;
+	}
+
+	status = hash->finish (hash, validate_hash, sizeof (validate_hash));
+	if (status != 0) {
+		goto error;
+	}
+
+	return (memcmp (validate_hash, manifest->toc_hash, manifest->toc_hash_length) == 0);
+
+error:
+	hash->cancel (hash);
+	return false;
+}
+
 /**
  * Validate the signature on a version 2 manifest.
  *
@@ -202,6 +290,8 @@ static int manifest_flash_verify_v2 (struct manifest_flash *manifest, struct has
 	uint32_t next_addr;
 	uint32_t toc_end;
 	uint32_t sig_addr = manifest->addr + manifest->header.length - manifest->header.sig_length;
+	size_t toc_length;
+	bool use_cache;
 	int i;
 	int status;
 
@@ -250,37 +340,68 @@ static int manifest_flash_verify_v2 (struct manifest_flash *manifest, struct has
 		goto error;
 	}
 
-	/* Find the platform ID element, hashing each entry as it is read in. */
 	next_addr += sizeof (manifest->toc_header);
-	i = 0;
-	do {
-		status = manifest->flash->read (manifest->flash, next_addr, (uint8_t*) &entry,
-			sizeof (entry));
+	toc_length = MANIFEST_FLASH_TOC_CACHE_SIZE (manifest->toc_header.entry_count,
+		manifest->toc_header.hash_count, manifest->toc_hash_length);
+	toc_end = next_addr + toc_length;
+	use_cache = (manifest->toc_cache != NULL) && (toc_length <= manifest->max_toc_cache);
+
+	if (use_cache) {
+		/* Read the entire table of contents into the cache and find the platform ID element. */
+		status = manifest->flash->read (manifest->flash, next_addr, manifest->toc_cache,
+			toc_length);
 		if (status != 0) {
 			goto error;
 		}
 
-		status = hash->update (hash, (uint8_t*) &entry, sizeof (entry));
+		status = hash->update (hash, manifest->toc_cache, toc_length);
 		if (status != 0) {
 			goto error;
 		}
 
-		next_addr += sizeof (entry);
-		i++;
-	} while ((entry.type_id != MANIFEST_PLATFORM_ID) && (i < manifest->toc_header.entry_count));
+		for (i = 0; i < manifest->toc_header.entry_count; i++) {
+			memcpy (&entry, &manifest->toc_cache[i * sizeof (entry)], sizeof (entry));
+			if (entry.type_id == MANIFEST_PLATFORM_ID) {
+				break;
+			}
+		}
 
-	if (entry.type_id != MANIFEST_PLATFORM_ID) {
-		status = MANIFEST_NO_PLATFORM_ID;
-		goto error;
+		if (i == manifest->toc_header.entry_count) {
+			status = MANIFEST_NO_PLATFORM_ID;
+			goto error;
+		}
 	}
+	else {
+		/* Find the platform ID element, hashing each entry as it is read in. */
+		i = 0;
+		do {
+			status = manifest->flash->read (manifest->flash, next_addr, (uint8_t*) &entry,
+				sizeof (entry));
+			if (status != 0) {
+				goto error;
+			}
 
-	/* Hash the flash contents for the rest of the table of contents. */
-	toc_end = manifest->addr + sizeof (manifest->header) + sizeof (manifest->toc_header) +
-		(manifest->toc_header.entry_count * sizeof (entry)) +
-		(manifest->toc_header.hash_count * manifest->toc_hash_length);
-	status = flash_hash_update_contents (manifest->flash, next_addr, toc_end - next_addr, hash);
-	if (status != 0) {
-		goto error;
+			status = hash->update (hash, (uint8_t*) &entry, sizeof (entry));
+			if (status != 0) {
+				goto error;
+			}
+
+			next_addr += sizeof (entry);
+			i++;
+		} while ((entry.type_id != MANIFEST_PLATFORM_ID) &&
+			(i < manifest->toc_header.entry_count));
+
+		if (entry.type_id != MANIFEST_PLATFORM_ID) {
+			status = MANIFEST_NO_PLATFORM_ID;
+			goto error;
+		}
+
+		/* Hash the flash contents for the rest of the table of contents. */
+		status = flash_hash_update_contents (manifest->flash, next_addr, toc_end - next_addr,
+			hash);
+		if (status != 0) {
+			goto error;
+		}
 	}
 
 	/* Read and hash the table of contents hash. */
@@ -354,8 +475,14 @@ static int manifest_flash_verify_v2 (struct manifest_flash *manifest, struct has
 		memcpy (hash_out, manifest->hash_cache, manifest->hash_length);
 	}
 
-	return verification->verify_signature (verification, manifest->hash_cache,
+	status = verification->verify_signature (verification, manifest->hash_cache,
 		manifest->hash_length, manifest->signature, manifest->header.sig_length);
+	if ((status == 0) && use_cache) {
+		manifest->toc_cache_valid = manifest_flash_validate_toc_cache (manifest, hash,
+			toc_length);
+	}
+
+	return status;
 
 error:
 	hash->cancel (hash);
@@ -391,6 +518,7 @@ int manifest_flash_verify (struct manifest_flash *manifest, struct hash_engine *
 
 	manifest->manifest_valid = false;
 	manifest->cache_valid = false;
+	manifest->toc_cache_valid = false;
 	if (hash_out != NULL) {
 		/* Clear the output hash buffer to indicate no hash was calculated. */
 		memset (hash_out, 0, hash_length);
@@ -637,61 +765,33 @@ int manifest_flash_get_signature (struct manifest_flash *manifest, uint8_t *sign
 }
 
 /**
- * Find the first element of a specified type in the manifest and read the element data.
- * Everything about the operation will be validated, as appropriate.  This includes table of
- * contents and entry data hashing.
+ * Find the table of contents entry for an element by reading the table of contents from flash.  The
+ * complete table of contents will be validated against the table of contents hash.
  *
- * @param manifest The manifest to read.
- * @param hash The hash engine to use for element validation.
+ * @param manifest The manifest to search.
+ * @param hash The hash engine to use for table of contents validation.
  * @param type Identifier for the type of element to find.
  * @param start Index of the table of contents entry to start searching for the element.
- * @param parent_type Identifier for the type of the parent element.  If the element has no parent,
- * MANIFEST_NO_PARENT must be provided.
- * @param read_offset Offset into the element data to start reading.  The entire element is still
- * validated, but the buffer will only contain element data starting at the offset.
- * @param found Optional output indicating which TOC entry was used for the element.
- * @param format Optional output for the format version of the element data.
- * @param total_len Optional output for the total length of the element data.
- * @param element Optional pointer to the output buffer for the element data.  If the output buffer
- * is null, a buffer will by dynamically allocated to fit the entire element.  This buffer must be
- * freed by the caller.  If the pointer is null, no element data will be read.
- * @param length Length of the element output buffer, if the buffer is not null.  If the actual
- * element data is longer than the specified length, only the specified length will be read back and
- * no error is generated.  This parameter is ignored when the output buffer is dynamically
- * allocated.
+ * @param parent_type Identifier for the type of the parent element.
+ * @param entry Output for the table of contents entry for the element.
+ * @param entry_hash Output for the element hash, if the element has one.
+ * @param index Output for the index of the table of contents entry following the element.
  *
- * @return The amount of element data read or an error code.  Use ROT_IS_ERROR to check the return
- * value.
+ * @return 0 if the element was found and the table of contents is valid or an error code.
  */
-int manifest_flash_read_element_data (struct manifest_flash *manifest, struct hash_engine *hash,
-	uint8_t type, int start, uint8_t parent_type, uint32_t read_offset, uint8_t *found,
-	uint8_t *format, size_t *total_len, uint8_t **element, size_t length)
+static int manifest_flash_find_toc_entry (struct manifest_flash *manifest,
+	struct hash_engine *hash, uint8_t type, int start, uint8_t parent_type,
+	struct manifest_toc_entry *entry, uint8_t *entry_hash, int *index)
 {
-	struct manifest_toc_entry entry;
-	uint8_t entry_hash[SHA512_HASH_LENGTH];
 	uint8_t validate_hash[SHA512_HASH_LENGTH];
 	uint32_t entry_addr;
 	uint32_t hash_addr;
 	uint32_t toc_end;
-	int i;
 	int status;
 
-	if ((manifest == NULL) || (hash == NULL)) {
-		return MANIFEST_INVALID_ARGUMENT;
-	}
-
-	if (!manifest->manifest_valid) {
-		return MANIFEST_NO_MANIFEST;
-	}
-
-	if (start >= manifest->toc_header.entry_count) {
-		return (parent_type == MANIFEST_NO_PARENT) ?
-			MANIFEST_ELEMENT_NOT_FOUND : MANIFEST_CHILD_NOT_FOUND;
-	}
-
 	entry_addr =
 		manifest->addr + sizeof (struct manifest_header) + sizeof (struct manifest_toc_header);
-	hash_addr = entry_addr + (sizeof (entry) * manifest->toc_header.entry_count);
+	hash_addr = entry_addr + (sizeof (*entry) * manifest->toc_header.entry_count);
 	toc_end = hash_addr + (manifest->toc_hash_length * manifest->toc_header.hash_count);
 
 	/* Start hashing to verify the TOC contents. */
@@ -706,46 +806,47 @@ int manifest_flash_read_element_data (struct manifest_flash *manifest, struct ha
 	}
 
 	/* Hash the TOC data before the first entry that will be read. */
-	status = flash_hash_update_contents (manifest->flash, entry_addr, sizeof (entry) * start, hash);
+	status = flash_hash_update_contents (manifest->flash, entry_addr, sizeof (*entry) * start,
+		hash);
 	if (status != 0) {
 		goto error;
 	}
 
 	/* Find the TOC entry for the requested element. */
-	entry_addr += sizeof (entry) * start;
-	i = start;
+	entry_addr += sizeof (*entry) * start;
+	*index = start;
 	do {
-		status = manifest->flash->read (manifest->flash, entry_addr, (uint8_t*) &entry,
-			sizeof (entry));
+		status = manifest->flash->read (manifest->flash, entry_addr, (uint8_t*) entry,
+			sizeof (*entry));
 		if (status != 0) {
 			goto error;
 		}
 
 		/* As soon as we see an element that is not a child, we fail because we have left the
 		 * context of the expected parent. */
-		if ((parent_type != MANIFEST_NO_PARENT) && (entry.parent == MANIFEST_NO_PARENT)) {
+		if ((parent_type != MANIFEST_NO_PARENT) && (entry->parent == MANIFEST_NO_PARENT)) {
 			status = MANIFEST_CHILD_NOT_FOUND;
 			goto error;
 		}
 
-		status = hash->update (hash, (uint8_t*) &entry, sizeof (entry));
+		status = hash->update (hash, (uint8_t*) entry, sizeof (*entry));
 		if (status != 0) {
 			goto error;
 		}
 
-		i++;
-		entry_addr += sizeof (entry);
-	} while ((entry.type_id != type) && (i < manifest->toc_header.entry_count));
+		(*index)++;
+		entry_addr += sizeof (*entry);
+	} while ((entry->type_id != type) && (*index < manifest->toc_header.entry_count));
 
-	if (entry.type_id != type) {
+	if (entry->type_id != type) {
 		status = (parent_type == MANIFEST_NO_PARENT) ?
 			MANIFEST_ELEMENT_NOT_FOUND : MANIFEST_CHILD_NOT_FOUND;
 		goto error;
 	}
 
-	if (entry.hash_id < manifest->toc_header.hash_count) {
+	if (entry->hash_id < manifest->toc_header.hash_count) {
 		/* Find the address of the entry hash. */
-		hash_addr += (manifest->toc_hash_length * entry.hash_id);
+		hash_addr += (manifest->toc_hash_length * entry->hash_id);
 
 		/* Hash the unneeded TOC data until the entry hash. */
 		status = flash_hash_update_contents (manifest->flash, entry_addr, hash_addr - entry_addr,
@@ -791,6 +892,124 @@ int manifest_flash_read_element_data (struct manifest_flash *manifest, struct ha
 		return MANIFEST_TOC_INVALID;
 	}
 
+	return 0;
+
+error:
+	hash->cancel (hash);
+	return status;
+}
+
+/**
+ * Find the table of contents entry for an element using the cached table of contents.  The cache
+ * was validated when the manifest was verified, so no additional flash accesses are necessary.
+ *
+ * @param manifest The manifest to search.
+ * @param type Identifier for the type of element to find.
+ * @param start Index of the table of contents entry to start searching for the element.
+ * @param parent_type Identifier for the type of the parent element.
+ * @param entry Output for the table of contents entry for the element.
+ * @param entry_hash Output for the element hash, if the element has one.
+ * @param index Output for the index of the table of contents entry following the element.
+ *
+ * @return 0 if the element was found or an error code.
+ */
+static int manifest_flash_find_cached_toc_entry (struct manifest_flash *manifest, uint8_t type,
+	int start, uint8_t parent_type, struct manifest_toc_entry *entry, uint8_t *entry_hash,
+	int *index)
+{
+	size_t hash_offset;
+
+	for (*index = start; *index < manifest->toc_header.entry_count; (*index)++) {
+		memcpy (entry, &manifest->toc_cache[*index * sizeof (*entry)], sizeof (*entry));
+
+		/* As soon as we see an element that is not a child, we fail because we have left the
+		 * context of the expected parent. */
+		if ((parent_type != MANIFEST_NO_PARENT) && (entry->parent == MANIFEST_NO_PARENT)) {
+			return MANIFEST_CHILD_NOT_FOUND;
+		}
+
+		if (entry->type_id == type) {
+			break;
+		}
+	}
+
+	if (*index == manifest->toc_header.entry_count) {
+		return (parent_type == MANIFEST_NO_PARENT) ?
+			MANIFEST_ELEMENT_NOT_FOUND : MANIFEST_CHILD_NOT_FOUND;
+	}
+
+	(*index)++;
+	if (entry->hash_id < manifest->toc_header.hash_count) {
+		hash_offset = (sizeof (*entry) * manifest->toc_header.entry_count) +
+			(manifest->toc_hash_length * entry->hash_id);
+		memcpy (entry_hash, &manifest->toc_cache[hash_offset], manifest->toc_hash_length);
+	}
+
+	return 0;
+}
+
+/**
+ * Find the first element of a specified type in the manifest and read the element data.
+ * Everything about the operation will be validated, as appropriate.  This includes table of
+ * contents and entry data hashing.
+ *
+ * @param manifest The manifest to read.
+ * @param hash The hash engine to use for element validation.
+ * @param type Identifier for the type of element to find.
+ * @param start Index of the table of contents entry to start searching for the element.
+ * @param parent_type Identifier for the type of the parent element.  If the element has no parent,
+ * MANIFEST_NO_PARENT must be provided.
+ * @param read_offset Offset into the element data to start reading.  The entire element is still
+ * validated, but the buffer will only contain element data starting at the offset.
+ * @param found Optional output indicating which TOC entry was used for the element.
+ * @param format Optional output for the format version of the element data.
+ * @param total_len Optional output for the total length of the element data.
+ * @param element Optional pointer to the output buffer for the element data.  If the output buffer
+ * is null, a buffer will by dynamically allocated to fit the entire element.  This buffer must be
+ * freed by the caller.  If the pointer is null, no element data will be read.
+ * @param length Length of the element output buffer, if the buffer is not null.  If the actual
+ * element data is longer than the specified length, only the specified length will be read back and
+ * no error is generated.  This parameter is ignored when the output buffer is dynamically
+ * allocated.
+ *
+ * @return The amount of element data read or an error code.  Use ROT_IS_ERROR to check the return
+ * value.
+ */
+int manifest_flash_read_element_data (struct manifest_flash *manifest, struct hash_engine *hash,
+	uint8_t type, int start, uint8_t parent_type, uint32_t read_offset, uint8_t *found,
+	uint8_t *format, size_t *total_len, uint8_t **element, size_t length)
+{
+	struct manifest_toc_entry entry;
+	uint8_t entry_hash[SHA512_HASH_LENGTH];
+	uint8_t validate_hash[SHA512_HASH_LENGTH];
+	int i;
+	int status;
+
+	if ((manifest == NULL) || (hash == NULL)) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+
+	if (!manifest->manifest_valid) {
+		return MANIFEST_NO_MANIFEST;
+	}
+
+	if (start >= manifest->toc_header.entry_count) {
+		return (parent_type == MANIFEST_NO_PARENT) ?
+			MANIFEST_ELEMENT_NOT_FOUND : MANIFEST_CHILD_NOT_FOUND;
+	}
+
+	if (manifest->toc_cache_valid) {
+		status = manifest_flash_find_cached_toc_entry (manifest, type, start, parent_type, &entry,
+			entry_hash, &i);
+	}
+	else {
+		status = manifest_flash_find_toc_entry (manifest, hash, type, start, parent_type, &entry,
+			entry_hash, &i);
+	}
+	if (status != 0) {
+		return status;
+	}
+
 	/* Read the element data. */
 	if ((entry.parent != MANIFEST_NO_PARENT) && (entry.parent != parent_type)) {
 		return MANIFEST_WRONG_PARENT;
@@ -878,6 +1097,56 @@ error:
 	return status;
 }
 
+/**
+ * Process a single table of contents entry while gathering information about child elements.
+ *
+ * @param toc_entry The table of contents entry to process.
+ * @param entry Index of the table of contents entry.
+ * @param type Type of requested parent element.
+ * @param parent_type Type of parent to requested parent element.
+ * @param child_type Type of child element to get information for.
+ * @param child_len Optional output buffer with total length of child elements.
+ * @param child_count Optional output buffer with number of child elements found.
+ * @param first_entry Optional output buffer with entry of first child.
+ *
+ * @return 0 if processing should continue with the next entry, 1 if processing is complete, or an
+ * error code.
+ */
+static int manifest_flash_check_child_element (const struct manifest_toc_entry *toc_entry,
+	int entry, uint8_t type, uint8_t parent_type, uint8_t child_type, size_t *child_len,
+	int *child_count, int *first_entry)
+{
+	bool only_entry = ((child_len == NULL) && (child_count == NULL));
+
+	if ((toc_entry->parent == parent_type) || (toc_entry->type_id == parent_type)) {
+		if (only_entry) {
+			return MANIFEST_CHILD_NOT_FOUND;
+		}
+
+		return 1;
+	}
+
+	if ((toc_entry->parent == type) && (toc_entry->type_id == child_type)) {
+		if ((first_entry != NULL) && (*first_entry == 0)) {
+			*first_entry = entry;
+
+			if (only_entry) {
+				return 1;
+			}
+		}
+
+		if (child_count != NULL) {
+			*child_count = *child_count + 1;
+		}
+
+		if (child_len != NULL) {
+			*child_len = *child_len + toc_entry->length;
+		}
+	}
+
+	return 0;
+}
+
 /**
  * Get requested information of child elements or requested entry.
  *
@@ -937,6 +1206,28 @@ int manifest_flash_get_child_elements_info (struct manifest_flash *manifest,
 		return 0;
 	}
 
+	if (manifest->toc_cache_valid) {
+		for (; entry < manifest->toc_header.entry_count; ++entry) {
+			memcpy (&toc_entry, &manifest->toc_cache[entry * sizeof (struct manifest_toc_entry)],
+				sizeof (struct manifest_toc_entry));
+
+			status = manifest_flash_check_child_element (&toc_entry, entry, type, parent_type,
+				child_type, child_len, child_count, first_entry);
+			if (status == 1) {
+				break;
+			}
+			else if (status != 0) {
+				return status;
+			}
+		}
+
+		if (only_entry && (*first_entry == 0)) {
+			return MANIFEST_CHILD_NOT_FOUND;
+		}
+
+		return 0;
+	}
+
 	entry_addr = manifest->addr + sizeof (struct manifest_header) +
 		sizeof (struct manifest_toc_header);
 	hash_addr = entry_addr + ((sizeof (struct manifest_toc_entry) + manifest->toc_hash_length) *
@@ -976,32 +1267,14 @@ int manifest_flash_get_child_elements_info (struct manifest_flash *manifest,
 			goto error;
 		}
 
-		if ((toc_entry.parent == parent_type) || (toc_entry.type_id == parent_type)) {
-			if (only_entry) {
-				status = MANIFEST_CHILD_NOT_FOUND;
-				goto error;
-			}
-
+		status = manifest_flash_check_child_element (&toc_entry, entry, type, parent_type,
+			child_type, child_len, child_count, first_entry);
+		if (status == 1) {
 			entry_addr += sizeof (struct manifest_toc_entry);
 			break;
 		}
-		if ((toc_entry.parent == type) && (toc_entry.type_id == child_type)) {
-			if ((first_entry != NULL) && (*first_entry == 0)) {
-				*first_entry = entry;
-
-				if (only_entry) {
-					entry_addr += sizeof (struct manifest_toc_entry);
-					break;
-				}
-			}
-
-			if (child_count != NULL) {
-				*child_count = *child_count + 1;
-			}
-
-			if (child_len != NULL) {
-				*child_len = *child_len + toc_entry.length;
-			}
+		else if (status != 0) {
+			goto error;
 		}
 	}
 
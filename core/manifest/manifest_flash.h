@@ -39,8 +39,23 @@ struct manifest_flash {
 	bool cache_valid;							/**< Flag indicating if the cached hash is valid. */
 	bool free_signature;						/**< Flag indicating the signature buffer should be freed. */
 	bool manifest_valid;						/**< Flag indicating there is a validated manifest. */
+	uint8_t *toc_cache;							/**< Optional buffer to hold a verified copy of the table of contents. */
+	size_t max_toc_cache;						/**< Length of the table of contents cache buffer. */
+	bool toc_cache_valid;						/**< Flag indicating the table of contents cache is valid. */
 };
 
+/**
+ * Get the size of the buffer necessary to cache the table of contents for a manifest.  This is the
+ * size of the table of contents entries and element hashes, not including the table of contents
+ * header or hash.
+ *
+ * @param entries The maximum number of table of contents entries.
+ * @param hashes The maximum number of element hashes.
+ * @param hash_len The length of each element hash.
+ */
+#define	MANIFEST_FLASH_TOC_CACHE_SIZE(entries, hashes, hash_len)	\
+	(((entries) * sizeof (struct manifest_toc_entry)) + ((hashes) * (hash_len)))
+
 
 int manifest_flash_init (struct manifest_flash *manifest, const struct flash *flash,
 	uint32_t base_addr, uint16_t magic_num_v1);
@@ -50,6 +65,10 @@ int manifest_flash_v2_init (struct manifest_flash *manifest, const struct flash
 	size_t max_platform_id);
 void manifest_flash_release (struct manifest_flash *manifest);
 
+int manifest_flash_enable_toc_cache (struct manifest_flash *manifest, uint8_t *toc_cache,
+	size_t max_toc_cache);
+void manifest_flash_invalidate_toc_cache (struct manifest_flash *manifest);
+
 int manifest_flash_read_header (struct manifest_flash *manifest, struct manifest_header *header);
 
 int manifest_flash_verify (struct manifest_flash *manifest, struct hash_engine *hash,
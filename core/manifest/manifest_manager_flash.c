@@ -390,6 +390,7 @@ int manifest_manager_flash_clear_pending_region (struct manifest_manager_flash *
 
 		manager->updating = &region->updater;
 		region->is_valid = false;
+		manifest_flash_invalidate_toc_cache (region->flash);
 	}
 	else {
 		platform_mutex_unlock (&manager->lock);
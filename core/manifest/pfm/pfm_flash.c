@@ -9,11 +9,19 @@
 #include "pfm_flash.h"
 #include "pfm_format.h"
 #include "common/buffer_util.h"
+#include "common/common_math.h"
 #include "common/unused.h"
 #include "flash/flash_util.h"
 #include "manifest/manifest_flash.h"
 
 
+/**
+ * The maximum number of flash region definitions that will be read from flash in a single
+ * operation.  The definitions are read into a buffer on the stack.
+ */
+#define	PFM_FLASH_REGION_READ_MAX		8
+
+
 /**
  * Static array indicating the manifest contains no firmware identifiers.
  */
@@ -807,33 +815,8 @@ error:
 }
 
 /**
- * Read a flash region definition from flash.
- *
- * @param pfm The PFM instance to read.
- * @param addr The address of the region definition in flash.
- * @param region The region information that will be updated from flash.
- *
- * @return 0 if the region was read successfully or an error code.
- */
-static int pfm_flash_read_region_v1 (struct manifest_flash *pfm, uint32_t addr,
-	struct flash_region *region)
-{
-	struct pfm_flash_region rw_region;
-	int status;
-
-	status = pfm->flash->read (pfm->flash, addr, (uint8_t*) &rw_region, sizeof (rw_region));
-	if (status != 0) {
-		return status;
-	}
-
-	region->start_addr = rw_region.start_addr;
-	region->length = (rw_region.end_addr - rw_region.start_addr) + 1;
-
-	return 0;
-}
-
-/**
- * Read multiple flash region definitions from flash.
+ * Read multiple flash region definitions from flash.  Region definitions are stored contiguously,
+ * so groups of definitions are read from flash in a single operation.
  *
  * @param pfm The PFM instance to read.
  * @param count The number of regions to read.
@@ -846,16 +829,28 @@ static int pfm_flash_read_region_v1 (struct manifest_flash *pfm, uint32_t addr,
 static int pfm_flash_read_multiple_regions_v1 (struct manifest_flash *pfm, size_t count,
 	struct flash_region *region_list, uint32_t *addr)
 {
+	struct pfm_flash_region rw_region[PFM_FLASH_REGION_READ_MAX];
+	size_t batch;
 	size_t i;
 	int status;
 
-	for (i = 0; i < count; i++) {
-		status = pfm_flash_read_region_v1 (pfm, *addr, &region_list[i]);
+	while (count != 0) {
+		batch = min (count, PFM_FLASH_REGION_READ_MAX);
+
+		status = pfm->flash->read (pfm->flash, *addr, (uint8_t*) rw_region,
+			sizeof (struct pfm_flash_region) * batch);
 		if (status != 0) {
 			return status;
 		}
 
-		*addr += sizeof (struct pfm_flash_region);
+		for (i = 0; i < batch; i++) {
+			region_list[i].start_addr = rw_region[i].start_addr;
+			region_list[i].length = (rw_region[i].end_addr - rw_region[i].start_addr) + 1;
+		}
+
+		*addr += sizeof (struct pfm_flash_region) * batch;
+		region_list += batch;
+		count -= batch;
 	}
 
 	return 0;
@@ -1547,6 +1542,14 @@ int pfm_flash_init (struct pfm_flash *pfm, const struct flash *flash, struct has
 		return status;
 	}
 
+#if PFM_FLASH_TOC_CACHE_ENTRIES
+	status = manifest_flash_enable_toc_cache (&pfm->base_flash, pfm->toc_cache,
+		sizeof (pfm->toc_cache));
+	if (status != 0) {
+		return status;
+	}
+#endif
+
 	pfm->base.base.verify = pfm_flash_verify;
 	pfm->base.base.get_id = pfm_flash_get_id;
 	pfm->base.base.get_platform_id = pfm_flash_get_platform_id;
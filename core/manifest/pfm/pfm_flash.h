@@ -11,12 +11,31 @@
 #include "flash/flash.h"
 
 
+/**
+ * The number of table of contents entries and SHA-256 element hashes that can be cached for a PFM.
+ * When this is not 0, every PFM instance contains a cache of this size that is enabled during
+ * initialization.  Manifests with a larger table of contents, or that use larger hashes, will read
+ * the table of contents from flash for every element lookup.  The cache is disabled by default.
+ */
+#ifndef PFM_FLASH_TOC_CACHE_ENTRIES
+#define	PFM_FLASH_TOC_CACHE_ENTRIES		0
+#endif
+
+#if PFM_FLASH_TOC_CACHE_ENTRIES
+#define	PFM_FLASH_TOC_CACHE_SIZE	\
+	MANIFEST_FLASH_TOC_CACHE_SIZE (PFM_FLASH_TOC_CACHE_ENTRIES, PFM_FLASH_TOC_CACHE_ENTRIES, \
+		SHA256_HASH_LENGTH)
+#endif
+
 /**
  * Defines a PFM that is stored in flash memory.
  */
 struct pfm_flash {
 	struct pfm base;							/**< The base PFM instance. */
 	struct manifest_flash base_flash;			/**< The base PFM flash instance. */
+#if PFM_FLASH_TOC_CACHE_ENTRIES
+	uint8_t toc_cache[PFM_FLASH_TOC_CACHE_SIZE];	/**< Cache for the verified table of contents. */
+#endif
 	struct pfm_flash_device_element flash_dev;	/**< Flash device element for the PFM. */
 	int flash_dev_format;						/**< Format of the flash device element. */
 };
@@ -225,6 +225,140 @@ int mctp_base_protocol_i3c_interpret (uint8_t *buf, size_t buf_len, uint8_t dest
 
 	return 0;
 }
+
+/**
+ * Construct the header and PEC for an MCTP packet without copying the packet payload.  The complete
+ * packet is the header, followed by the payload, followed by the PEC.
+ *
+ * @param payload Payload for the packet.
+ * @param payload_len Length of the payload.
+ * @param header Output for the constructed packet header.  This must not overlap the payload.
+ * @param header_len Length of the header buffer.
+ * @param pec Output for the packet PEC.
+ * @param source_addr Source SMBus address.
+ * @param dest_eid Destination EID for the packet.
+ * @param source_eid Source EID of the packet.
+ * @param som Boolean indicating that packet will be the start of a message.
+ * @param eom Boolean indicating that packet will be the end of a message.
+ * @param packet_seq Packet sequence number.
+ * @param msg_tag Message tag.
+ * @param tag_owner Initiator of the MCTP transaction.
+ * @param dest_addr Destination SMBUS address.
+ *
+ * @return Header length if completed successfully or an error code.
+ */
+int mctp_base_protocol_construct_header (const uint8_t *payload, size_t payload_len,
+	uint8_t *header, size_t header_len, uint8_t *pec, uint8_t source_addr, uint8_t dest_eid,
+	uint8_t source_eid, bool som, bool eom, uint8_t packet_seq, uint8_t msg_tag,
+	uint8_t tag_owner, uint8_t dest_addr)
+{
+	struct mctp_base_protocol_transport_header *smbus_header =
+		(struct mctp_base_protocol_transport_header*) header;
+	uint8_t crc;
+
+	if ((payload == NULL) || (header == NULL) || (pec == NULL)) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	if ((payload_len == 0) || (payload_len > MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT)) {
+		return MCTP_BASE_PROTOCOL_BAD_BUFFER_LENGTH;
+	}
+
+	if (header_len < sizeof (struct mctp_base_protocol_transport_header)) {
+		return MCTP_BASE_PROTOCOL_BUF_TOO_SMALL;
+	}
+
+	memset (smbus_header, 0, sizeof (struct mctp_base_protocol_transport_header));
+
+	smbus_header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	smbus_header->byte_count =
+		mctp_protocol_packet_len (payload_len) - MCTP_BASE_PROTOCOL_SMBUS_OVERHEAD;
+	smbus_header->source_addr = (source_addr << 1) | 0x01;
+	smbus_header->header_version = MCTP_BASE_PROTOCOL_SUPPORTED_HDR_VERSION;
+	smbus_header->destination_eid = dest_eid;
+	smbus_header->source_eid = source_eid;
+	smbus_header->som = (som ? 1 : 0);
+	smbus_header->eom = (eom ? 1 : 0);
+	smbus_header->packet_seq = packet_seq;
+	smbus_header->msg_tag = msg_tag;
+	smbus_header->tag_owner = tag_owner;
+
+	crc = checksum_init_smbus_crc8 (dest_addr << 1);
+	crc = checksum_update_smbus_crc8 (crc, header,
+		sizeof (struct mctp_base_protocol_transport_header));
+	*pec = checksum_update_smbus_crc8 (crc, payload, payload_len);
+
+	return sizeof (struct mctp_base_protocol_transport_header);
+}
+
+/**
+ * Construct the header and PEC for an MCTP over I3C packet without copying the packet payload.  The
+ * complete packet is the header, followed by the payload, followed by the PEC.
+ *
+ * @param payload Payload for the packet.
+ * @param payload_len Length of the payload.
+ * @param header Output for the constructed packet header.  This must not overlap the payload.
+ * @param header_len Length of the header buffer.
+ * @param pec Output for the packet PEC.
+ * @param source_addr Source I3C address.
+ * @param dest_eid Destination EID for the packet.
+ * @param source_eid Source EID of the packet.
+ * @param som Boolean indicating that packet will be the start of a message.
+ * @param eom Boolean indicating that packet will be the end of a message.
+ * @param packet_seq Packet sequence number.
+ * @param msg_tag Message tag.
+ * @param tag_owner Initiator of the MCTP transaction.
+ * @param dest_addr Destination I3C address.
+ * @param is_target Flag indicating if the packet is being sent by an I3C target.
+ *
+ * @return Header length if completed successfully or an error code.
+ */
+int mctp_base_protocol_construct_header_i3c (const uint8_t *payload, size_t payload_len,
+	uint8_t *header, size_t header_len, uint8_t *pec, uint8_t source_addr, uint8_t dest_eid,
+	uint8_t source_eid, bool som, bool eom, uint8_t packet_seq, uint8_t msg_tag,
+	uint8_t tag_owner, uint8_t dest_addr, bool is_target)
+{
+	struct mctp_base_protocol_transport_i3c_header *i3c_header =
+		(struct mctp_base_protocol_transport_i3c_header*) header;
+	uint8_t crc;
+
+	if ((payload == NULL) || (header == NULL) || (pec == NULL)) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	if ((payload_len == 0) || (payload_len > MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT)) {
+		return MCTP_BASE_PROTOCOL_BAD_BUFFER_LENGTH;
+	}
+
+	if (header_len < sizeof (struct mctp_base_protocol_transport_i3c_header)) {
+		return MCTP_BASE_PROTOCOL_BUF_TOO_SMALL;
+	}
+
+	memset (i3c_header, 0, sizeof (struct mctp_base_protocol_transport_i3c_header));
+
+	i3c_header->header_version = MCTP_BASE_PROTOCOL_SUPPORTED_HDR_VERSION;
+	i3c_header->destination_eid = dest_eid;
+	i3c_header->source_eid = source_eid;
+	i3c_header->som = (som ? 1 : 0);
+	i3c_header->eom = (eom ? 1 : 0);
+	i3c_header->packet_seq = packet_seq;
+	i3c_header->msg_tag = msg_tag;
+	i3c_header->tag_owner = tag_owner;
+
+	if (is_target) {
+		crc = checksum_init_smbus_crc8 (dest_addr << 1 | 1);
+	}
+	else {
+		crc = checksum_init_smbus_crc8 (dest_addr << 1);
+	}
+
+	crc = checksum_update_smbus_crc8 (crc, header,
+		sizeof (struct mctp_base_protocol_transport_i3c_header));
+	*pec = checksum_update_smbus_crc8 (crc, payload, payload_len);
+
+	return sizeof (struct mctp_base_protocol_transport_i3c_header);
+}
+
 /**
  * Construct an MCTP packet.
  *
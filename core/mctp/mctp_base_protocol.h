@@ -226,6 +226,16 @@ int mctp_base_protocol_construct_i3c (uint8_t *buf, size_t buf_len, uint8_t *out
 	size_t out_buf_len, uint8_t source_addr, uint8_t dest_eid, uint8_t source_eid, bool som,
 	bool eom, uint8_t packet_seq, uint8_t msg_tag, uint8_t tag_owner, uint8_t dest_addr, bool is_target);
 
+int mctp_base_protocol_construct_header (const uint8_t *payload, size_t payload_len,
+	uint8_t *header, size_t header_len, uint8_t *pec, uint8_t source_addr, uint8_t dest_eid,
+	uint8_t source_eid, bool som, bool eom, uint8_t packet_seq, uint8_t msg_tag,
+	uint8_t tag_owner, uint8_t dest_addr);
+
+int mctp_base_protocol_construct_header_i3c (const uint8_t *payload, size_t payload_len,
+	uint8_t *header, size_t header_len, uint8_t *pec, uint8_t source_addr, uint8_t dest_eid,
+	uint8_t source_eid, bool som, bool eom, uint8_t packet_seq, uint8_t msg_tag,
+	uint8_t tag_owner, uint8_t dest_addr, bool is_target);
+
 #define	MCTP_BASE_PROTOCOL_ERROR(code)						ROT_ERROR (ROT_MODULE_MCTP_BASE_PROTOCOL, code)
 
 /**
@@ -250,6 +260,7 @@ enum {
 	MCTP_BASE_PROTOCOL_UNSUPPORTED_OPERATION = MCTP_BASE_PROTOCOL_ERROR (0x0f),	/**< Requested operation not supported by device. */
 	MCTP_BASE_PROTOCOL_ERROR_RESPONSE = MCTP_BASE_PROTOCOL_ERROR (0x10),		/**< Error response received. */
 	MCTP_BASE_PROTOCOL_FAIL_RESPONSE = MCTP_BASE_PROTOCOL_ERROR (0x11),			/**< Response processing failed. */
+	MCTP_BASE_PROTOCOL_NO_REASSEMBLY_CONTEXT = MCTP_BASE_PROTOCOL_ERROR (0x12),	/**< No context is available to receive a new message. */
 };
 
 
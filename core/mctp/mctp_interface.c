@@ -102,6 +102,374 @@ int mctp_interface_set_channel_id (struct mctp_interface *mctp, int channel_id)
 	return 0;
 }
 
+/**
+ * Provide a pool of reassembly contexts to the MCTP interface.  With a context pool, multi-packet
+ * messages from different endpoints, or with different message tags, can be received concurrently
+ * instead of each new message discarding the one currently in progress.
+ *
+ * The buffer provides the fixed amount of memory that will be used for message reassembly.  It is
+ * divided evenly between all contexts in the pool, which limits the largest message that can be
+ * received.
+ *
+ * @param mctp The MCTP interface to update.
+ * @param contexts The pool of reassembly contexts to use.
+ * @param count The number of contexts in the pool.
+ * @param buffer Memory to use for storing messages during reassembly.
+ * @param length Length of the reassembly buffer.
+ * @param timeout_ms The amount of time allowed to receive all packets for a single message.  Any
+ * partial message that exceeds this time will be discarded.
+ *
+ * @return 0 if the context pool was successfully configured or an error code.
+ */
+int mctp_interface_enable_reassembly_contexts (struct mctp_interface *mctp,
+	struct mctp_interface_reassembly_context *contexts, size_t count, uint8_t *buffer,
+	size_t length, uint32_t timeout_ms)
+{
+	size_t max_length;
+	size_t i;
+
+	if ((mctp == NULL) || (contexts == NULL) || (count == 0) || (buffer == NULL) ||
+		(timeout_ms == 0)) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	max_length = min (length / count, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY);
+	if (max_length < MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT) {
+		return MCTP_BASE_PROTOCOL_BUF_TOO_SMALL;
+	}
+
+	memset (contexts, 0, sizeof (struct mctp_interface_reassembly_context) * count);
+	for (i = 0; i < count; i++) {
+		contexts[i].data = &buffer[i * max_length];
+	}
+
+	mctp->contexts = contexts;
+	mctp->context_count = count;
+	mctp->context_max_length = max_length;
+	mctp->context_timeout_ms = timeout_ms;
+
+	return 0;
+}
+
+/**
+ * Provide a list of scatter/gather packet descriptors to the MCTP interface.  When descriptors are
+ * available, responses can be packetized by generating only the packet headers, with each packet
+ * payload referencing the response data directly.  This avoids copying the response into a
+ * contiguous packet buffer before transmission.
+ *
+ * Responses that require more packets than there are descriptors will be packetized into the
+ * contiguous buffer.
+ *
+ * @param mctp The MCTP interface to update.
+ * @param packets The list of packet descriptors to use for responses.
+ * @param count The number of packet descriptors in the list.
+ *
+ * @return 0 if the descriptors were successfully configured or an error code.
+ */
+int mctp_interface_enable_scatter_gather (struct mctp_interface *mctp,
+	struct cmd_packet_sg *packets, size_t count)
+{
+	if ((mctp == NULL) || (packets == NULL) || (count == 0)) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	mctp->sg_packets = packets;
+	mctp->sg_max_packets = count;
+
+	return 0;
+}
+
+/**
+ * Execute Cerberus protocol requests from a pool of worker contexts instead of the context
+ * receiving packets.  Complete request messages are copied into the dispatch queue, and the
+ * responses are sent on the command channel by the worker that completes them.  Responses are
+ * always sent in the same order the requests were received.
+ *
+ * MCTP control and SPDM messages are still processed by the receiving context.
+ *
+ * @param mctp The MCTP interface to update.
+ * @param dispatch The dispatch queue that will execute requests.
+ * @param channel The command channel that receives packets for this MCTP interface.  Responses to
+ * dispatched requests will be sent on this channel.
+ * @param reentrant Flag indicating the command handlers can safely process requests from multiple
+ * worker contexts at the same time, including requests to any other handlers using the same
+ * dispatch queue.  If this is false, requests are executed one at a time with all other handlers
+ * on the queue that are not reentrant.
+ *
+ * @return 0 if the dispatch queue was successfully configured or an error code.
+ */
+int mctp_interface_enable_dispatch (struct mctp_interface *mctp, struct cmd_dispatch *dispatch,
+	struct cmd_channel *channel, bool reentrant)
+{
+	if (dispatch == NULL) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	return mctp_interface_enable_dispatch_with_lock (mctp, dispatch, channel,
+		(reentrant) ? NULL : &dispatch->execute);
+}
+
+/**
+ * Execute Cerberus protocol requests from a pool of worker contexts, serializing requests only
+ * with the other channels that use the same execution lock.  This allows channels whose command
+ * handlers do not share any components to execute requests at the same time, so a long-running
+ * command on one channel does not hold up requests for independent handlers.
+ *
+ * All channels whose handlers share state or components must use the same execution lock.
+ *
+ * @param mctp The MCTP interface to update.
+ * @param dispatch The dispatch queue that will execute requests.
+ * @param channel The command channel that receives packets for this MCTP interface.  Responses to
+ * dispatched requests will be sent on this channel.
+ * @param execute The lock used to serialize request execution for the channel.  This must be
+ * initialized by the caller and remain valid while the channel is using the dispatch queue.  Set
+ * this to null if the command handlers are reentrant.
+ *
+ * @return 0 if the dispatch queue was successfully configured or an error code.
+ */
+int mctp_interface_enable_dispatch_with_lock (struct mctp_interface *mctp,
+	struct cmd_dispatch *dispatch, struct cmd_channel *channel, platform_mutex *execute)
+{
+	if ((mctp == NULL) || (dispatch == NULL) || (channel == NULL)) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	memset (&mctp->dispatch, 0, sizeof (mctp->dispatch));
+	mctp->dispatch.dispatch = dispatch;
+	mctp->dispatch.channel = channel;
+	mctp->dispatch.execute = execute;
+
+	return 0;
+}
+
+/**
+ * Find the reassembly context for an in-progress message.  Contexts for messages that have timed
+ * out will be released and not returned.
+ *
+ * @param mctp The MCTP interface to query.
+ * @param src_eid EID of the message source.
+ * @param msg_tag Message tag for the message.
+ * @param tag_owner Tag owner for the message.
+ *
+ * @return The reassembly context for the message or null if there is no active context.
+ */
+static struct mctp_interface_reassembly_context* mctp_interface_find_reassembly_context (
+	struct mctp_interface *mctp, uint8_t src_eid, uint8_t msg_tag, uint8_t tag_owner)
+{
+	struct mctp_interface_reassembly_context *context;
+	size_t i;
+
+	for (i = 0; i < mctp->context_count; i++) {
+		context = &mctp->contexts[i];
+
+		if ((context->start_packet_len != 0) && (context->src_eid == src_eid) &&
+			(context->msg_tag == msg_tag) && (context->tag_owner == tag_owner)) {
+			if (platform_has_timeout_expired (&context->timeout) == 1) {
+				context->start_packet_len = 0;
+				return NULL;
+			}
+
+			return context;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Get an unused reassembly context for a new message.  If all contexts are in use, a context whose
+ * message has timed out will be reused.
+ *
+ * @param mctp The MCTP interface to query.
+ *
+ * @return An available reassembly context or null if all contexts are in use.
+ */
+static struct mctp_interface_reassembly_context* mctp_interface_get_free_reassembly_context (
+	struct mctp_interface *mctp)
+{
+	struct mctp_interface_reassembly_context *expired = NULL;
+	size_t i;
+
+	for (i = 0; i < mctp->context_count; i++) {
+		if (mctp->contexts[i].start_packet_len == 0) {
+			return &mctp->contexts[i];
+		}
+		else if ((expired == NULL) &&
+			(platform_has_timeout_expired (&mctp->contexts[i].timeout) == 1)) {
+			expired = &mctp->contexts[i];
+		}
+	}
+
+	return expired;
+}
+
+/**
+ * Load the message type for a non-SOM packet from the reassembly context for its message.  The
+ * message type is only present in the SOM packet, but is needed to interpret every packet.
+ *
+ * @param mctp The MCTP interface that will process the packet.
+ * @param rx_packet The received packet.
+ */
+static void mctp_interface_load_reassembly_msg_type (struct mctp_interface *mctp,
+	struct cmd_packet *rx_packet)
+{
+	struct mctp_interface_reassembly_context *context;
+	struct mctp_base_protocol_transport_header *header;
+	struct mctp_base_protocol_transport_i3c_header *i3c_header;
+
+	if (mctp->channel_id & CMD_CHANNEL_I3C_BASE) {
+		if (rx_packet->pkt_size < sizeof (struct mctp_base_protocol_transport_i3c_header)) {
+			return;
+		}
+
+		i3c_header = (struct mctp_base_protocol_transport_i3c_header*) rx_packet->data;
+		if (i3c_header->som) {
+			return;
+		}
+
+		context = mctp_interface_find_reassembly_context (mctp, i3c_header->source_eid,
+			i3c_header->msg_tag, i3c_header->tag_owner);
+	}
+	else {
+		if (rx_packet->pkt_size < sizeof (struct mctp_base_protocol_transport_header)) {
+			return;
+		}
+
+		header = (struct mctp_base_protocol_transport_header*) rx_packet->data;
+		if (header->som) {
+			return;
+		}
+
+		context = mctp_interface_find_reassembly_context (mctp, header->source_eid,
+			header->msg_tag, header->tag_owner);
+	}
+
+	if (context != NULL) {
+		mctp->msg_type = context->msg_type;
+	}
+}
+
+/**
+ * Add a received packet to the reassembly context for its message.  When the last packet of the
+ * message is received, the previously received packets are moved to the request buffer, leaving
+ * only the final packet to be added before the message is processed.
+ *
+ * @param mctp The MCTP interface processing the packet.
+ * @param payload The packet payload.
+ * @param payload_len Length of the packet payload.
+ * @param som Flag indicating the packet is the start of a message.
+ * @param eom Flag indicating the packet is the end of a message.
+ * @param packet_seq Sequence number of the packet.
+ * @param src_eid EID of the message source.
+ * @param source_addr SMBUS address of the message source.
+ * @param dest_eid EID the message was sent to.
+ * @param msg_tag Message tag for the message.
+ * @param tag_owner Tag owner for the message.
+ * @param error_code Output for the error to report for an invalid packet.  This will be
+ * CERBERUS_PROTOCOL_NO_ERROR if the packet was accepted.
+ * @param error_data Output for additional data about the reported error.
+ *
+ * @return 0 if the packet was processed or an error code.
+ */
+static int mctp_interface_reassemble_packet (struct mctp_interface *mctp, const uint8_t *payload,
+	size_t payload_len, bool som, bool eom, uint8_t packet_seq, uint8_t src_eid,
+	uint8_t source_addr, uint8_t dest_eid, uint8_t msg_tag, uint8_t tag_owner, uint8_t *error_code,
+	uint32_t *error_data)
+{
+	struct mctp_interface_reassembly_context *context;
+
+	*error_code = CERBERUS_PROTOCOL_NO_ERROR;
+	*error_data = 0;
+
+	context = mctp_interface_find_reassembly_context (mctp, src_eid, msg_tag, tag_owner);
+
+	if (som) {
+		if (eom) {
+			/* Single packet messages don't need a context.  Just discard any partial message that
+			 * is being replaced. */
+			if (context != NULL) {
+				context->start_packet_len = 0;
+				context = NULL;
+			}
+		}
+		else {
+			if (context == NULL) {
+				context = mctp_interface_get_free_reassembly_context (mctp);
+				if (context == NULL) {
+					return MCTP_BASE_PROTOCOL_NO_REASSEMBLY_CONTEXT;
+				}
+			}
+
+			context->length = 0;
+			context->start_packet_len = payload_len;
+			context->src_eid = src_eid;
+			context->msg_tag = msg_tag;
+			context->tag_owner = tag_owner;
+			context->msg_type = mctp->msg_type;
+			context->packet_seq = 0;
+
+			platform_init_timeout (mctp->context_timeout_ms, &context->timeout);
+		}
+	}
+	else if (context == NULL) {
+		*error_code = CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG;
+		return 0;
+	}
+	else if (packet_seq != context->packet_seq) {
+		context->start_packet_len = 0;
+		*error_code = CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW;
+		return 0;
+	}
+	else if (((int) payload_len != context->start_packet_len) &&
+		!(eom && ((int) payload_len < context->start_packet_len))) {
+		context->start_packet_len = 0;
+		*error_code = CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN;
+		*error_data = payload_len;
+		return 0;
+	}
+
+	if (!eom) {
+		if ((payload_len + context->length) > mctp->context_max_length) {
+			context->start_packet_len = 0;
+			*error_code = CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW;
+			*error_data = payload_len + context->length;
+			return 0;
+		}
+
+		memcpy (&context->data[context->length], payload, payload_len);
+		context->length += payload_len;
+		context->packet_seq = (context->packet_seq + 1) % 4;
+
+		return 0;
+	}
+
+	mctp->req_buffer.length = 0;
+	if (context != NULL) {
+		memcpy (mctp->req_buffer.data, context->data, context->length);
+		mctp->req_buffer.length = context->length;
+		context->start_packet_len = 0;
+	}
+
+	mctp->req_buffer.source_eid = src_eid;
+	mctp->req_buffer.source_addr = source_addr;
+	mctp->req_buffer.target_eid = dest_eid;
+	mctp->req_buffer.channel_id = mctp->channel_id;
+	mctp->msg_tag = msg_tag;
+
+	return 0;
+}
+
+/**
+ * Discard any partially received message in the request buffer.
+ *
+ * @param mctp The MCTP interface to reset.
+ */
+static void mctp_interface_reset_request_buffer (struct mctp_interface *mctp)
+{
+	mctp->req_buffer.length = 0;
+	mctp->start_packet_len = 0;
+}
+
 /**
  * Generate packets for full MCTP message from payload
  *
@@ -179,6 +547,105 @@ static int mctp_interface_generate_packets_from_payload (struct mctp_interface *
 	return i_buf;
 }
 
+/**
+ * Generate a list of scatter/gather packets for a full MCTP message.  Only the packet headers and
+ * PECs are generated.  The payload for each packet references the message data, so the payload
+ * buffer must not be modified until all packets have been sent.
+ *
+ * @param mctp MCTP interface instance
+ * @param payload Buffer with payload bytes
+ * @param payload_len Length of payload bytes
+ * @param dest_eid EID to address packets to
+ * @param dest_addr SMBus address to address packets to
+ * @param src_eid EID of source device
+ * @param src_addr SMBus address of source device
+ * @param msg_tag MCTP message tag to utilize
+ * @param tag_owner MCTP tag owner to utilize
+ *
+ * @return 0 if the packet list was generated successfully or an error code.
+ */
+static int mctp_interface_generate_packet_list (struct mctp_interface *mctp,
+	const uint8_t *payload, size_t payload_len, uint8_t dest_eid, uint8_t dest_addr,
+	uint8_t src_eid, uint8_t src_addr, uint8_t msg_tag, uint8_t tag_owner)
+{
+	struct cmd_packet_sg *packet;
+	size_t max_packet_payload;
+	size_t packet_payload_len;
+	size_t num_packets;
+	size_t i;
+	bool is_target = false;
+	int status;
+
+	max_packet_payload = device_manager_get_max_transmission_unit_by_eid (mctp->device_manager,
+		dest_eid);
+
+	num_packets = MCTP_BASE_PROTOCOL_PACKETS_IN_MESSAGE (payload_len, max_packet_payload);
+	if (num_packets > mctp->sg_max_packets) {
+		return MCTP_BASE_PROTOCOL_BUF_TOO_SMALL;
+	}
+
+	if ((mctp->channel_id & CMD_CHANNEL_I3C_BASE) && (mctp->channel_id & CMD_CHANNEL_I3C_TARGET)) {
+		is_target = true;
+	}
+
+	for (i = 0; i < num_packets; i++) {
+		packet = &mctp->sg_packets[i];
+		packet_payload_len = min (payload_len, max_packet_payload);
+
+		if (mctp->channel_id & CMD_CHANNEL_I3C_BASE) {
+			status = mctp_base_protocol_construct_header_i3c (payload, packet_payload_len,
+				packet->header, sizeof (packet->header), packet->trailer, src_addr, dest_eid,
+				src_eid, (i == 0), (i == (num_packets - 1)), i % 4, msg_tag, tag_owner, dest_addr,
+				is_target);
+		}
+		else {
+			status = mctp_base_protocol_construct_header (payload, packet_payload_len,
+				packet->header, sizeof (packet->header), packet->trailer, src_addr, dest_eid,
+				src_eid, (i == 0), (i == (num_packets - 1)), i % 4, msg_tag, tag_owner, dest_addr);
+		}
+
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		packet->header_len = status;
+		packet->payload = payload;
+		packet->payload_len = packet_payload_len;
+		packet->trailer_len = MCTP_BASE_PROTOCOL_PEC_SIZE;
+		packet->dest_addr = dest_addr;
+
+		payload += packet_payload_len;
+		payload_len -= packet_payload_len;
+	}
+
+	mctp->sg_message.packets = mctp->sg_packets;
+	mctp->sg_message.num_packets = num_packets;
+
+	return 0;
+}
+
+/**
+ * Log a protocol error that will be reported in an error response.
+ *
+ * @param mctp MCTP interface instance.
+ * @param error_code Identifier for the error.
+ * @param error_data Data for the error condition.
+ * @param src_eid EID of the original message source.
+ * @param dest_eid EID of the original message destination.
+ * @param msg_tag Tag of the original message.
+ */
+static void mctp_interface_log_protocol_error (struct mctp_interface *mctp, uint8_t error_code,
+	uint32_t error_data, uint8_t src_eid, uint8_t dest_eid, uint8_t msg_tag)
+{
+	if (error_code != CERBERUS_PROTOCOL_NO_ERROR) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_MCTP,
+			MCTP_LOGGING_CHANNEL, mctp->channel_id, 0);
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
+			MCTP_LOGGING_PROTOCOL_ERROR,
+			(error_code << 24 | src_eid << 16 | dest_eid << 8 | msg_tag), error_data);
+	}
+}
+
 /**
  * Construct an MCTP packet for an error response.
  *
@@ -205,19 +672,13 @@ static int mctp_interface_generate_error_packet (struct mctp_interface *mctp, in
 	int status;
 	bool is_target = false;
 
-	if (error_code != CERBERUS_PROTOCOL_NO_ERROR) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_MCTP,
-			MCTP_LOGGING_CHANNEL, mctp->channel_id, 0);
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP,
-			MCTP_LOGGING_PROTOCOL_ERROR,
-			(error_code << 24 | src_eid << 16 | dest_eid << 8 | msg_tag), error_data);
-	}
+	mctp_interface_log_protocol_error (mctp, error_code, error_data, src_eid, dest_eid, msg_tag);
 
 	if ((dest_eid != cerberus_eid) || (tag_owner == MCTP_BASE_PROTOCOL_TO_RESPONSE)) {
 		return 0;
 	}
 
-	mctp_interface_reset_message_processing (mctp);
+	mctp_interface_reset_request_buffer (mctp);
 
 	mctp->req_buffer.max_response = MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT;
 	status = mctp->cmd_cerberus->generate_error_packet (mctp->cmd_cerberus, &mctp->req_buffer,
@@ -264,11 +725,13 @@ static int mctp_interface_generate_error_packet (struct mctp_interface *mctp, in
  * @param rx_packet The received packet to process
  * @param tx_message Output for a response message to send.  This pointer MUST NOT be freed by the
  * caller.
+ * @param tx_sg Optional output for a response message that has been packetized as scatter/gather
+ * packets.  Set to null to always generate contiguous packets.
  *
  * @return Completion status, 0 if success or an error code.
  */
-int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packet *rx_packet,
-	struct cmd_message **tx_message)
+static int mctp_interface_handle_packet (struct mctp_interface *mctp, struct cmd_packet *rx_packet,
+	struct cmd_message **tx_message, struct cmd_message_sg **tx_sg)
 {
 	struct cerberus_protocol_header *header;
 	uint32_t msg1 = 0;
@@ -284,6 +747,8 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 	uint8_t response_addr;
 	uint8_t cmd_set = 0;
 	uint8_t tag_owner;
+	uint8_t error_code;
+	uint32_t error_data;
 	size_t payload_len;
 	bool som;
 	bool eom;
@@ -303,6 +768,10 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 
 	*tx_message = NULL;
 
+	if (mctp->contexts != NULL) {
+		mctp_interface_load_reassembly_msg_type (mctp, rx_packet);
+	}
+
 	if (mctp->channel_id & CMD_CHANNEL_I3C_BASE) {
 		if (mctp->channel_id & CMD_CHANNEL_I3C_TARGET)
 			is_target = true;
@@ -346,7 +815,7 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 				response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
 		}
 		else {
-			mctp_interface_reset_message_processing (mctp);
+			mctp_interface_reset_request_buffer (mctp);
 			return status;
 		}
 	}
@@ -362,7 +831,22 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 		}
 	}
 
-	if (som) {
+	if (mctp->contexts != NULL) {
+		status = mctp_interface_reassemble_packet (mctp, payload, payload_len, som, eom, packet_seq,
+			src_eid, source_addr, dest_eid, msg_tag, tag_owner, &error_code, &error_data);
+		if (status != 0) {
+			return status;
+		}
+		else if (error_code != CERBERUS_PROTOCOL_NO_ERROR) {
+			return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message, error_code,
+				error_data, src_eid, dest_eid, msg_tag, response_addr, rx_packet->dest_addr,
+				cmd_set, tag_owner);
+		}
+		else if (!eom) {
+			return 0;
+		}
+	}
+	else if (som) {
 		mctp->req_buffer.length = 0;
 		mctp->req_buffer.source_eid = src_eid;
 		mctp->req_buffer.source_addr = source_addr;
@@ -488,6 +972,21 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 
 			mctp->req_buffer.max_response = device_manager_get_max_message_len_by_eid (
 				mctp->device_manager, src_eid);
+
+			if (mctp->dispatch.dispatch != NULL) {
+				status = cmd_dispatch_submit (mctp->dispatch.dispatch, mctp, &mctp->req_buffer,
+					response_addr, rx_packet->dest_addr, mctp->msg_tag, cmd_set);
+				if (status != 0) {
+					return mctp_interface_generate_error_packet (mctp, cerberus_eid, tx_message,
+						CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status, src_eid, dest_eid, msg_tag,
+						response_addr, rx_packet->dest_addr, cmd_set, tag_owner);
+				}
+
+				/* The response will be sent by the worker that executes the request. */
+				mctp->req_buffer.length = 0;
+				return 0;
+			}
+
 			status = mctp->cmd_cerberus->process_request (mctp->cmd_cerberus, &mctp->req_buffer);
 
 			/* Regardless of the processing status, check to see if the timeout needs adjusting. */
@@ -626,6 +1125,19 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 		}
 
 		if (mctp->req_buffer.length > 0) {
+			if ((tx_sg != NULL) && (mctp->sg_packets != NULL)) {
+				status = mctp_interface_generate_packet_list (mctp, mctp->req_buffer.data,
+					mctp->req_buffer.length, mctp->req_buffer.source_eid, response_addr,
+					mctp->req_buffer.target_eid, rx_packet->dest_addr, mctp->msg_tag,
+					MCTP_BASE_PROTOCOL_TO_RESPONSE);
+				if (status == 0) {
+					mctp->req_buffer.length = 0;
+
+					*tx_sg = &mctp->sg_message;
+					return 0;
+				}
+			}
+
 			status = mctp_interface_generate_packets_from_payload (mctp,
 				mctp->req_buffer.data, mctp->req_buffer.length, mctp->resp_buffer.data,
 				sizeof (mctp->msg_buffer), mctp->req_buffer.source_eid, response_addr,
@@ -656,6 +1168,178 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
 	return 0;
 }
 
+/**
+ * MCTP interface message processing function
+ *
+ * @param mctp MCTP interface instance
+ * @param rx_packet The received packet to process
+ * @param tx_message Output for a response message to send.  This pointer MUST NOT be freed by the
+ * caller.
+ *
+ * @return Completion status, 0 if success or an error code.
+ */
+int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packet *rx_packet,
+	struct cmd_message **tx_message)
+{
+	return mctp_interface_handle_packet (mctp, rx_packet, tx_message, NULL);
+}
+
+/**
+ * MCTP interface message processing function that supports scatter/gather responses.  Only one
+ * of the response outputs will be set when there is a response to send.  Scatter/gather responses
+ * are only generated if packet descriptors have been provided to the MCTP interface.
+ *
+ * @param mctp MCTP interface instance
+ * @param rx_packet The received packet to process
+ * @param tx_message Output for a response message to send.  This pointer MUST NOT be freed by the
+ * caller.
+ * @param tx_sg Output for a response message to send as scatter/gather packets.  The packets
+ * reference data in the MCTP interface, so they must be sent before the next packet is processed.
+ * This pointer MUST NOT be freed by the caller.
+ *
+ * @return Completion status, 0 if success or an error code.
+ */
+int mctp_interface_process_packet_sg (struct mctp_interface *mctp, struct cmd_packet *rx_packet,
+	struct cmd_message **tx_message, struct cmd_message_sg **tx_sg)
+{
+	if (tx_sg == NULL) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	*tx_sg = NULL;
+	return mctp_interface_handle_packet (mctp, rx_packet, tx_message, tx_sg);
+}
+
+/**
+ * Packetize the response for a dispatched request.  The packets are generated in the request
+ * message buffer.
+ *
+ * @param mctp MCTP interface instance.
+ * @param request The dispatched request containing the response message.
+ * @param src_eid EID of the original message source.
+ * @param dest_eid EID of the original message destination.
+ *
+ * @return 0 if the response was packetized successfully or an error code.
+ */
+static int mctp_interface_packetize_dispatched_response (struct mctp_interface *mctp,
+	struct cmd_dispatch_request *request, uint8_t src_eid, uint8_t dest_eid)
+{
+	int status;
+
+	status = mctp_interface_generate_packets_from_payload (mctp, request->request.data,
+		request->request.length, request->msg_buffer, sizeof (request->msg_buffer), src_eid,
+		request->response_addr, dest_eid, request->source_addr, request->msg_tag,
+		MCTP_BASE_PROTOCOL_TO_RESPONSE, &request->response.pkt_size);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	request->response.data = request->msg_buffer;
+	request->response.msg_size = status;
+	request->response.dest_addr = request->response_addr;
+
+	return 0;
+}
+
+/**
+ * Generate an error response for a dispatched request.
+ *
+ * @param mctp MCTP interface instance.
+ * @param request The dispatched request that generated the error.
+ * @param src_eid EID of the original message source.
+ * @param dest_eid EID of the original message destination.
+ * @param error_code Identifier for the error.
+ * @param error_data Data for the error condition.
+ *
+ * @return 0 if the error response was generated successfully or an error code.
+ */
+static int mctp_interface_generate_dispatched_error (struct mctp_interface *mctp,
+	struct cmd_dispatch_request *request, uint8_t src_eid, uint8_t dest_eid, uint8_t error_code,
+	uint32_t error_data)
+{
+	int cerberus_eid;
+	int status;
+
+	mctp_interface_log_protocol_error (mctp, error_code, error_data, src_eid, dest_eid,
+		request->msg_tag);
+
+	cerberus_eid = device_manager_get_device_eid (mctp->device_manager,
+		DEVICE_MANAGER_SELF_DEVICE_NUM);
+	if (ROT_IS_ERROR (cerberus_eid)) {
+		return cerberus_eid;
+	}
+
+	if (dest_eid != cerberus_eid) {
+		return 0;
+	}
+
+	request->request.length = 0;
+	request->request.max_response = MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT;
+	status = mctp->cmd_cerberus->generate_error_packet (mctp->cmd_cerberus, &request->request,
+		error_code, error_data, request->cmd_set);
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	if (request->request.length > MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT) {
+		return MCTP_BASE_PROTOCOL_MSG_TOO_LARGE;
+	}
+
+	return mctp_interface_packetize_dispatched_response (mctp, request, src_eid, dest_eid);
+}
+
+/**
+ * Execute a Cerberus protocol request that was queued for a dispatch worker and generate the
+ * packets for the response.  This is called by the dispatch queue and should not be called
+ * directly.
+ *
+ * @param mctp The MCTP interface that received the request.
+ * @param request The request to execute.  The packetized response will be stored in the request
+ * response message.  A response with no data indicates there is nothing to send.
+ *
+ * @return 0 if the request was processed successfully or an error code.
+ */
+int mctp_interface_process_dispatched_request (struct mctp_interface *mctp,
+	struct cmd_dispatch_request *request)
+{
+	size_t max_response;
+	uint8_t src_eid;
+	uint8_t dest_eid;
+	int status;
+
+	if ((mctp == NULL) || (request == NULL)) {
+		return MCTP_BASE_PROTOCOL_INVALID_ARGUMENT;
+	}
+
+	src_eid = request->request.source_eid;
+	dest_eid = request->request.target_eid;
+	request->response.msg_size = 0;
+
+	status = mctp->cmd_cerberus->process_request (mctp->cmd_cerberus, &request->request);
+	if (status != 0) {
+		return mctp_interface_generate_dispatched_error (mctp, request, src_eid, dest_eid,
+			CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status);
+	}
+	else if (request->request.length == 0) {
+		return mctp_interface_generate_dispatched_error (mctp, request, src_eid, dest_eid,
+			CERBERUS_PROTOCOL_NO_ERROR, status);
+	}
+
+	max_response = device_manager_get_max_message_len_by_eid (mctp->device_manager, src_eid);
+	if (request->request.length > max_response) {
+		return mctp_interface_generate_dispatched_error (mctp, request, src_eid, dest_eid,
+			CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, MCTP_BASE_PROTOCOL_MSG_TOO_LARGE);
+	}
+
+	status = mctp_interface_packetize_dispatched_response (mctp, request, src_eid, dest_eid);
+	if (status != 0) {
+		return mctp_interface_generate_dispatched_error (mctp, request, src_eid, dest_eid,
+			CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, status);
+	}
+
+	return 0;
+}
+
 /**
  * Reset the MCTP layer.  This discards previously received packets and begins looking for a new
  * message.
@@ -664,8 +1348,13 @@ int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packe
  */
 void mctp_interface_reset_message_processing (struct mctp_interface *mctp)
 {
-	mctp->req_buffer.length = 0;
-	mctp->start_packet_len = 0;
+	size_t i;
+
+	mctp_interface_reset_request_buffer (mctp);
+
+	for (i = 0; i < mctp->context_count; i++) {
+		mctp->contexts[i].start_packet_len = 0;
+	}
 }
 
 #ifdef CMD_ENABLE_ISSUE_REQUEST
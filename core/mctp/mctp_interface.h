@@ -10,6 +10,7 @@
 #include "cmd_interface/cmd_channel.h"
 #include "cmd_interface/device_manager.h"
 #include "cmd_interface/cmd_interface.h"
+#include "cmd_interface/cmd_dispatch.h"
 #include "mctp_base_protocol.h"
 
 
@@ -24,6 +25,23 @@ enum mctp_interface_response_state {
 	MCTP_INTERFACE_RESPONSE_SUCCESS,						/**< Successfully received response from target. */
 };
 
+/**
+ * Context for reassembling a single multi-packet message.  When a pool of these contexts is
+ * provided to the MCTP interface, messages from different endpoints can be received concurrently.
+ * Each context is identified by the source EID, message tag, and tag owner of the message.
+ */
+struct mctp_interface_reassembly_context {
+	uint8_t *data;											/**< Buffer for the message being reassembled. */
+	size_t length;											/**< Number of message bytes received so far. */
+	int start_packet_len;									/**< Payload length of the SOM packet.  0 if the context is free. */
+	platform_clock timeout;									/**< Time after which a partial message will be discarded. */
+	uint8_t src_eid;										/**< MCTP EID of the message source. */
+	uint8_t msg_tag;										/**< MCTP message tag for the message. */
+	uint8_t tag_owner;										/**< MCTP tag owner for the message. */
+	uint8_t msg_type;										/**< MCTP message type from the SOM packet. */
+	uint8_t packet_seq;										/**< Next expected MCTP packet sequence. */
+};
+
 /**
  * MCTP interface context
  */
@@ -43,6 +61,14 @@ struct mctp_interface {
 	uint8_t response_eid;									/**< MCTP EID for device we expect a response from */
 	uint8_t response_msg_tag;								/**< MCTP message tag for transaction we expect response for */
 	enum mctp_interface_response_state rsp_state;			/**< State of transactions started by device */
+	struct mctp_interface_reassembly_context *contexts;		/**< Optional pool of contexts for concurrent message reassembly. */
+	size_t context_count;									/**< Number of reassembly contexts in the pool. */
+	size_t context_max_length;								/**< Maximum message length for each reassembly context. */
+	uint32_t context_timeout_ms;							/**< Time allowed to receive all packets of a message. */
+	struct cmd_packet_sg *sg_packets;						/**< Optional packet descriptors for scatter/gather responses. */
+	size_t sg_max_packets;									/**< Number of scatter/gather packet descriptors. */
+	struct cmd_message_sg sg_message;						/**< Scatter/gather response message. */
+	struct cmd_dispatch_channel dispatch;					/**< Optional queue for executing requests from worker contexts. */
 #ifdef CMD_ENABLE_ISSUE_REQUEST
 	platform_semaphore wait_for_response;					/**< Semaphore used by requester to wait for response. */
 	platform_mutex lock;									/**< Synchronization for shared interfaces */
@@ -56,11 +82,25 @@ int mctp_interface_init (struct mctp_interface *mctp, struct cmd_interface *cmd_
 void mctp_interface_deinit (struct mctp_interface *mctp);
 
 int mctp_interface_set_channel_id (struct mctp_interface *mctp, int channel_id);
+int mctp_interface_enable_reassembly_contexts (struct mctp_interface *mctp,
+	struct mctp_interface_reassembly_context *contexts, size_t count, uint8_t *buffer,
+	size_t length, uint32_t timeout_ms);
+int mctp_interface_enable_scatter_gather (struct mctp_interface *mctp,
+	struct cmd_packet_sg *packets, size_t count);
+int mctp_interface_enable_dispatch (struct mctp_interface *mctp, struct cmd_dispatch *dispatch,
+	struct cmd_channel *channel, bool reentrant);
+int mctp_interface_enable_dispatch_with_lock (struct mctp_interface *mctp,
+	struct cmd_dispatch *dispatch, struct cmd_channel *channel, platform_mutex *execute);
 
 int mctp_interface_process_packet (struct mctp_interface *mctp, struct cmd_packet *rx_packet,
 	struct cmd_message **tx_message);
+int mctp_interface_process_packet_sg (struct mctp_interface *mctp, struct cmd_packet *rx_packet,
+	struct cmd_message **tx_message, struct cmd_message_sg **tx_sg);
 void mctp_interface_reset_message_processing (struct mctp_interface *mctp);
 
+int mctp_interface_process_dispatched_request (struct mctp_interface *mctp,
+	struct cmd_dispatch_request *request);
+
 #ifdef CMD_ENABLE_ISSUE_REQUEST
 int mctp_interface_issue_request (struct mctp_interface *mctp, struct cmd_channel *channel,
 	uint8_t dest_addr, uint8_t dest_eid, uint8_t *request, size_t length, uint8_t *msg_buffer,
@@ -0,0 +1,467 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "state_journal.h"
+#include "crypto/checksum.h"
+#include "flash/flash_util.h"
+
+
+/**
+ * Calculate the CRC for a journal record.
+ *
+ * @param record The record to calculate the CRC for.
+ *
+ * @return The record CRC.
+ */
+static uint8_t state_journal_record_crc (const struct state_journal_record *record)
+{
+	return checksum_update_smbus_crc8 (0, (const uint8_t*) record,
+		offsetof (struct state_journal_record, crc));
+}
+
+/**
+ * Check if a journal record has not been written.
+ *
+ * @param record The record to check.
+ *
+ * @return true if the record is blank or false if it has been written.
+ */
+static bool state_journal_is_blank (const struct state_journal_record *record)
+{
+	const uint8_t *raw = (const uint8_t*) record;
+	size_t i;
+
+	for (i = 0; i < sizeof (*record); i++) {
+		if (raw[i] != 0xff) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check if a journal record contains valid state.
+ *
+ * @param record The record to check.
+ *
+ * @return true if the record is valid or false if not.
+ */
+static bool state_journal_is_valid (const struct state_journal_record *record)
+{
+	return (record->sequence != 0xffffffff) && (record->count <= STATE_JOURNAL_MAX_STATES) &&
+		(record->crc == state_journal_record_crc (record));
+}
+
+/**
+ * Get the address of a record in the journal.
+ *
+ * @param journal The journal to query.
+ * @param sector_size The flash sector size.
+ * @param sector The sector that contains the record.
+ * @param index Index of the record in the sector.
+ *
+ * @return The record address.
+ */
+static uint32_t state_journal_record_addr (const struct state_journal *journal,
+	uint32_t sector_size, size_t sector, size_t index)
+{
+	return journal->base_addr + (sector * sector_size) +
+		(index * sizeof (struct state_journal_record));
+}
+
+/**
+ * Determine the address of the record that follows a specified record.  Records that don't fit
+ * completely within a sector are skipped, and the journal wraps to the first sector once the last
+ * one is full.
+ *
+ * @param journal The journal to query.
+ * @param sector_size The flash sector size.
+ * @param addr Address of the current record.
+ *
+ * @return Address of the next record.
+ */
+static uint32_t state_journal_next_addr (const struct state_journal *journal,
+	uint32_t sector_size, uint32_t addr)
+{
+	uint32_t sector = FLASH_REGION_BASE (addr, sector_size);
+
+	addr += sizeof (struct state_journal_record);
+
+	if ((addr - sector + sizeof (struct state_journal_record)) > sector_size) {
+		addr = sector + sector_size;
+		if (addr == (journal->base_addr + (journal->sector_count * sector_size))) {
+			addr = journal->base_addr;
+		}
+	}
+
+	return addr;
+}
+
+/**
+ * Find the latest state stored in the journal and determine where the next record should be
+ * written.
+ *
+ * @param journal The journal to initialize.
+ * @param sector_size The flash sector size.
+ *
+ * @return 0 if the journal was scanned successfully or an error code.
+ */
+static int state_journal_find_latest (const struct state_journal *journal, uint32_t sector_size)
+{
+	struct state_journal_state *state = journal->state;
+	struct state_journal_record newest;
+	struct state_journal_record record;
+	size_t records = sector_size / sizeof (struct state_journal_record);
+	size_t newest_sector = journal->sector_count;
+	size_t low;
+	size_t high;
+	size_t mid;
+	size_t i;
+	int status;
+
+	/* Every sector starts with a record as soon as it gets erased, so the first record in each
+	 * sector determines which one holds the latest state. */
+	for (i = 0; i < journal->sector_count; i++) {
+		status = journal->flash->read (journal->flash,
+			state_journal_record_addr (journal, sector_size, i, 0), (uint8_t*) &record,
+			sizeof (record));
+		if (status != 0) {
+			return status;
+		}
+
+		if (state_journal_is_valid (&record) &&
+			((newest_sector == journal->sector_count) || (record.sequence > newest.sequence))) {
+			newest_sector = i;
+			memcpy (&newest, &record, sizeof (newest));
+		}
+	}
+
+	if (newest_sector == journal->sector_count) {
+		/* There is no state stored in the journal. */
+		state->next_addr = journal->base_addr;
+		return 0;
+	}
+
+	/* Records are written sequentially, so find the last one in the sector with a binary search
+	 * for the first blank record.  A failed write never leaves a blank record before a written
+	 * one, so there are no blank records until the end of the written records. */
+	low = 0;
+	high = records;
+	while ((high - low) > 1) {
+		mid = low + ((high - low) / 2);
+
+		status = journal->flash->read (journal->flash,
+			state_journal_record_addr (journal, sector_size, newest_sector, mid),
+			(uint8_t*) &record, sizeof (record));
+		if (status != 0) {
+			return status;
+		}
+
+		if (state_journal_is_blank (&record)) {
+			high = mid;
+		}
+		else {
+			low = mid;
+		}
+	}
+
+	state->next_addr = state_journal_next_addr (journal, sector_size,
+		state_journal_record_addr (journal, sector_size, newest_sector, low));
+
+	/* The last record may not have been completely written or may have been corrupted.  Use the
+	 * most recent valid record and make sure the state gets written again. */
+	for (i = low; i > 0; i--) {
+		status = journal->flash->read (journal->flash,
+			state_journal_record_addr (journal, sector_size, newest_sector, i),
+			(uint8_t*) &record, sizeof (record));
+		if (status != 0) {
+			return status;
+		}
+
+		if (state_journal_is_valid (&record)) {
+			memcpy (&newest, &record, sizeof (newest));
+			break;
+		}
+
+		state->force_write = true;
+	}
+
+	memcpy (state->stored, newest.state, sizeof (state->stored));
+	state->stored_count = newest.count;
+	state->sequence = newest.sequence;
+
+	return 0;
+}
+
+/**
+ * Initialize journaled storage for non-volatile state.
+ *
+ * @param journal The state journal to initialize.
+ * @param state Variable context for the journal.  This must be uninitialized.
+ * @param flash The flash that will contain the journal.
+ * @param base_addr The starting address for the journal.  This must be aligned to the start of a
+ * flash sector.
+ * @param sector_count The number of contiguous flash sectors to use for the journal.  Using more
+ * sectors reduces the number of erase cycles for each sector.
+ *
+ * @return 0 if the journal was successfully initialized or an error code.
+ */
+int state_journal_init (struct state_journal *journal, struct state_journal_state *state,
+	const struct flash *flash, uint32_t base_addr, size_t sector_count)
+{
+	if (journal == NULL) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
+	}
+
+	memset (journal, 0, sizeof (struct state_journal));
+
+	journal->state = state;
+	journal->flash = flash;
+	journal->base_addr = base_addr;
+	journal->sector_count = sector_count;
+
+	return state_journal_init_state (journal);
+}
+
+/**
+ * Initialize only the variable state for a state journal.  The rest of the journal is assumed to
+ * have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param journal The state journal that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int state_journal_init_state (const struct state_journal *journal)
+{
+	uint32_t sector_size;
+	int status;
+
+	if ((journal == NULL) || (journal->state == NULL) || (journal->flash == NULL)) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
+	}
+
+	if (journal->sector_count < STATE_JOURNAL_MIN_SECTORS) {
+		return STATE_MANAGER_OUT_OF_RANGE;
+	}
+
+	status = journal->flash->get_sector_size (journal->flash, &sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	if (FLASH_REGION_BASE (journal->base_addr, sector_size) != journal->base_addr) {
+		return STATE_MANAGER_NOT_SECTOR_ALIGNED;
+	}
+
+	memset (journal->state, 0, sizeof (struct state_journal_state));
+
+	status = state_journal_find_latest (journal, sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	return platform_mutex_init (&journal->state->lock);
+}
+
+/**
+ * Release the resources used by a state journal.
+ *
+ * @param journal The state journal to release.
+ */
+void state_journal_release (const struct state_journal *journal)
+{
+	if (journal) {
+		platform_mutex_free (&journal->state->lock);
+	}
+}
+
+/**
+ * Register a state manager to use the journal for non-volatile storage.  The non-volatile state for
+ * the manager will be initialized from the latest record in the journal.
+ *
+ * @param journal The journal to update.
+ * @param manager The state manager that will use the journal.
+ * @param index Index for the manager state in the journal records.  This must be the same every
+ * time the manager is attached to the journal and cannot be used by any other attached manager.
+ *
+ * @return 0 if the manager was successfully attached or an error code.
+ */
+int state_journal_attach (const struct state_journal *journal, struct state_manager *manager,
+	uint8_t index)
+{
+	if ((journal == NULL) || (manager == NULL)) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
+	}
+
+	if (index >= STATE_JOURNAL_MAX_STATES) {
+		return STATE_MANAGER_OUT_OF_RANGE;
+	}
+
+	platform_mutex_lock (&journal->state->lock);
+
+	if ((journal->state->managers[index] != NULL) && (journal->state->managers[index] != manager)) {
+		platform_mutex_unlock (&journal->state->lock);
+		return STATE_MANAGER_INDEX_IN_USE;
+	}
+
+	journal->state->managers[index] = manager;
+	if (index < journal->state->stored_count) {
+		manager->nv_state = journal->state->stored[index];
+	}
+	else {
+		manager->nv_state = 0xffff;
+	}
+	manager->last_nv_stored = manager->nv_state;
+
+	platform_mutex_unlock (&journal->state->lock);
+
+	return 0;
+}
+
+/**
+ * Remove a state manager from the journal.  The last state stored for the manager will be retained
+ * in subsequent journal records.
+ *
+ * @param journal The journal to update.
+ * @param index Index of the manager state to remove.
+ */
+void state_journal_detach (const struct state_journal *journal, uint8_t index)
+{
+	if ((journal != NULL) && (index < STATE_JOURNAL_MAX_STATES)) {
+		platform_mutex_lock (&journal->state->lock);
+		journal->state->managers[index] = NULL;
+		platform_mutex_unlock (&journal->state->lock);
+	}
+}
+
+/**
+ * Store the current non-volatile state for all attached state managers.  A new record is only
+ * written to flash if the state has changed since the last record.
+ *
+ * This could result in the need to erase flash, so it could take an extended time for the operation
+ * to complete.
+ *
+ * @param journal The journal to update.
+ *
+ * @return 0 if the state was successfully stored or an error code.
+ */
+int state_journal_store (const struct state_journal *journal)
+{
+	struct state_journal_state *state;
+	struct state_journal_record record;
+	struct state_journal_record existing;
+	struct state_manager *manager;
+	uint32_t sector_size;
+	uint32_t addr;
+	int i;
+	int status;
+
+	if (journal == NULL) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
+	}
+
+	state = journal->state;
+
+	status = journal->flash->get_sector_size (journal->flash, &sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&state->lock);
+
+	memset (&record, 0xff, sizeof (record));
+	record.count = 0;
+
+	for (i = 0; i < STATE_JOURNAL_MAX_STATES; i++) {
+		manager = state->managers[i];
+		if (manager != NULL) {
+			/* A manager that has storage blocked may be in the middle of updating its state, so
+			 * keep the last value stored for it until storage is unblocked. */
+			platform_mutex_lock (&manager->state_lock);
+			if (manager->store_blocked) {
+				record.state[i] = manager->last_nv_stored;
+			}
+			else {
+				record.state[i] = manager->nv_state;
+			}
+			platform_mutex_unlock (&manager->state_lock);
+
+			record.count = i + 1;
+		}
+		else if (i < state->stored_count) {
+			/* Keep the stored state for managers that are not currently attached. */
+			record.state[i] = state->stored[i];
+			record.count = i + 1;
+		}
+	}
+
+	if (!state->force_write && (record.count == state->stored_count) &&
+		(memcmp (record.state, state->stored, sizeof (record.state[0]) * record.count) == 0)) {
+		goto exit;
+	}
+
+	/* If the previous write to this location failed, the location must be skipped if anything was
+	 * written.  A blank location is used again so there are no gaps in the written records. */
+	addr = state->next_addr;
+	if (state->check_blank && (FLASH_REGION_OFFSET (addr, sector_size) != 0)) {
+		status = journal->flash->read (journal->flash, addr, (uint8_t*) &existing,
+			sizeof (existing));
+		if (status != 0) {
+			goto exit;
+		}
+
+		if (!state_journal_is_blank (&existing)) {
+			addr = state_journal_next_addr (journal, sector_size, addr);
+			state->next_addr = addr;
+		}
+	}
+
+	/* The first record in a sector needs the sector to be erased.  The sector will only contain
+	 * older records, since the latest state is always in the previous sector.  This also handles a
+	 * failed write of the first record, since that will cause the sector to be erased again. */
+	if (FLASH_REGION_OFFSET (addr, sector_size) == 0) {
+		status = flash_sector_erase_region_and_verify (journal->flash, addr, sector_size);
+		if (status != 0) {
+			goto exit;
+		}
+	}
+
+	record.sequence = state->sequence + 1;
+	record.crc = state_journal_record_crc (&record);
+
+	status = journal->flash->write (journal->flash, addr, (uint8_t*) &record, sizeof (record));
+	if (status != sizeof (record)) {
+		/* The location may not be blank, so it needs to be checked before the next attempt. */
+		state->check_blank = true;
+		if (!ROT_IS_ERROR (status)) {
+			status = STATE_MANAGER_INCOMPLETE_WRITE;
+		}
+
+		goto exit;
+	}
+
+	state->next_addr = state_journal_next_addr (journal, sector_size, addr);
+	state->check_blank = false;
+
+	for (i = 0; i < STATE_JOURNAL_MAX_STATES; i++) {
+		if (state->managers[i] != NULL) {
+			state->managers[i]->last_nv_stored = record.state[i];
+		}
+	}
+
+	memcpy (state->stored, record.state, sizeof (state->stored));
+	state->stored_count = record.count;
+	state->sequence = record.sequence;
+	state->force_write = false;
+	status = 0;
+
+exit:
+	platform_mutex_unlock (&state->lock);
+	return status;
+}
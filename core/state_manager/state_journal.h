@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef STATE_JOURNAL_H_
+#define STATE_JOURNAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "state_manager.h"
+#include "flash/flash.h"
+
+
+/**
+ * The maximum number of state managers that can be stored in a single journal.  This is fixed to
+ * keep the journal records a constant size.
+ */
+#define	STATE_JOURNAL_MAX_STATES			5
+
+/**
+ * The minimum number of flash sectors that can be used for a journal.  There must always be one
+ * sector that contains the latest state while another is being erased.
+ */
+#define	STATE_JOURNAL_MIN_SECTORS			2
+
+
+#pragma pack(push, 1)
+/**
+ * A single record in the state journal.  Each record contains the non-volatile state for every
+ * state manager that uses the journal.
+ */
+struct state_journal_record {
+	uint32_t sequence;							/**< Sequence number of the record. */
+	uint16_t state[STATE_JOURNAL_MAX_STATES];	/**< Non-volatile state for each state manager. */
+	uint8_t count;								/**< The number of valid states in the record. */
+	uint8_t crc;								/**< CRC-8 of the rest of the record. */
+};
+#pragma pack(pop)
+
+
+/**
+ * Variable context for a state journal.
+ */
+struct state_journal_state {
+	platform_mutex lock;									/**< Synchronization for journal updates. */
+	struct state_manager *managers[STATE_JOURNAL_MAX_STATES];	/**< State managers using the journal. */
+	uint16_t stored[STATE_JOURNAL_MAX_STATES];				/**< The state values last stored in flash. */
+	uint8_t stored_count;									/**< The number of states in the last record. */
+	uint32_t sequence;										/**< Sequence number of the last record. */
+	uint32_t next_addr;										/**< Flash address for the next record. */
+	bool force_write;										/**< Flag to write a record even without changes. */
+	bool check_blank;										/**< Flag to check the next record location before writing. */
+};
+
+/**
+ * Journaled storage for non-volatile state that is shared between multiple state managers.  Each
+ * update writes a new record to flash, and records are written sequentially across a configurable
+ * number of sectors so erase cycles are spread evenly across all of them.
+ */
+struct state_journal {
+	struct state_journal_state *state;	/**< Variable context for the journal. */
+	const struct flash *flash;			/**< Flash device that contains the journal. */
+	uint32_t base_addr;					/**< First address of the journal storage. */
+	size_t sector_count;				/**< The number of flash sectors used by the journal. */
+};
+
+
+int state_journal_init (struct state_journal *journal, struct state_journal_state *state,
+	const struct flash *flash, uint32_t base_addr, size_t sector_count);
+int state_journal_init_state (const struct state_journal *journal);
+void state_journal_release (const struct state_journal *journal);
+
+int state_journal_attach (const struct state_journal *journal, struct state_manager *manager,
+	uint8_t index);
+void state_journal_detach (const struct state_journal *journal, uint8_t index);
+
+int state_journal_store (const struct state_journal *journal);
+
+
+/* This module will be treated as an extension of the state manager module and use STATE_MANAGER_*
+ * error codes. */
+
+
+#endif /* STATE_JOURNAL_H_ */
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef STATE_JOURNAL_STATIC_H_
+#define STATE_JOURNAL_STATIC_H_
+
+#include "state_journal.h"
+
+
+/**
+ * Initialize a static instance of a state journal.  This does not initialize the journal state.
+ * This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the journal.
+ * @param flash_ptr The flash that contains the journal.
+ * @param base The starting address for the journal.  This must be aligned to the start of a flash
+ * sector.
+ * @param sectors The number of contiguous flash sectors to use for the journal.
+ */
+#define	state_journal_static_init(state_ptr, flash_ptr, base, sectors)	{ \
+		.state = state_ptr, \
+		.flash = flash_ptr, \
+		.base_addr = base, \
+		.sector_count = sectors, \
+	}
+
+
+#endif /* STATE_JOURNAL_STATIC_H_ */
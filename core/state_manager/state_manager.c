@@ -6,6 +6,7 @@
 #include <string.h>
 #include "state_manager.h"
 #include "state_logging.h"
+#include "state_journal.h"
 #include "flash/flash_common.h"
 #include "flash/flash_util.h"
 #include "platform_io.h"
@@ -307,6 +308,55 @@ int state_manager_init (struct state_manager *manager, const struct flash *state
 	return 0;
 }
 
+/**
+ * Initialize the manager for state information that is stored in a journal shared with other state
+ * managers.
+ *
+ * @param manager The state manager to initialize.
+ * @param journal The journal that contains the non-volatile state information.
+ * @param index Index of the state in the journal records.  Each state manager using the journal
+ * must use a unique index, and the index must not change between boots.
+ *
+ * @return 0 if the state manager was successfully initialized or an error code.
+ */
+int state_manager_init_journal (struct state_manager *manager, const struct state_journal *journal,
+	uint8_t index)
+{
+	int status;
+
+	if ((manager == NULL) || (journal == NULL)) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
+	}
+
+	memset (manager, 0, sizeof (struct state_manager));
+
+	status = platform_mutex_init (&manager->state_lock);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_mutex_init (&manager->store_lock);
+	if (status != 0) {
+		goto free_state_lock;
+	}
+
+	status = state_journal_attach (journal, manager, index);
+	if (status != 0) {
+		goto free_store_lock;
+	}
+
+	manager->journal = journal;
+	manager->journal_index = index;
+
+	return 0;
+
+free_store_lock:
+	platform_mutex_free (&manager->store_lock);
+free_state_lock:
+	platform_mutex_free (&manager->state_lock);
+	return status;
+}
+
 /**
  * Release the resources used by the host state manager.
  *
@@ -315,6 +365,10 @@ int state_manager_init (struct state_manager *manager, const struct flash *state
 void state_manager_release (struct state_manager *manager)
 {
 	if (manager != NULL) {
+		if (manager->journal) {
+			state_journal_detach (manager->journal, manager->journal_index);
+		}
+
 		platform_mutex_free (&manager->state_lock);
 		platform_mutex_free (&manager->store_lock);
 	}
@@ -330,6 +384,9 @@ void state_manager_release (struct state_manager *manager)
  * Calling this function has the same semantics as a mutex.  Meaning, calling this twice to block
  * stores without calling to block in between will cause deadlock.
  *
+ * For a manager that uses a state journal, stores triggered through other managers attached to the
+ * same journal will continue to write the last stored state for this manager while it is blocked.
+ *
  * @param manager The manager whose state storage should be prevented or allowed.
  * @param block True to prevent state storage or false to allow it.
  */
@@ -338,8 +395,16 @@ void state_manager_block_non_volatile_state_storage (struct state_manager *manag
 	if (manager != NULL) {
 		if (block) {
 			platform_mutex_lock (&manager->store_lock);
+
+			platform_mutex_lock (&manager->state_lock);
+			manager->store_blocked = true;
+			platform_mutex_unlock (&manager->state_lock);
 		}
 		else {
+			platform_mutex_lock (&manager->state_lock);
+			manager->store_blocked = false;
+			platform_mutex_unlock (&manager->state_lock);
+
 			platform_mutex_unlock (&manager->store_lock);
 		}
 	}
@@ -372,6 +437,16 @@ int state_manager_store_non_volatile_state (struct state_manager *manager)
 		return STATE_MANAGER_INVALID_ARGUMENT;
 	}
 
+	if (manager->journal) {
+		/* The journal stores the state for all attached managers and only writes when something
+		 * has changed, so there is no need to read back the current state from flash. */
+		platform_mutex_lock (&manager->store_lock);
+		status = state_journal_store (manager->journal);
+		platform_mutex_unlock (&manager->store_lock);
+
+		return status;
+	}
+
 	status = manager->nv_store->get_sector_size (manager->nv_store, &sector_size);
 	if (status != 0) {
 		return status;
@@ -500,6 +575,34 @@ int state_manager_store_non_volatile_state (struct state_manager *manager)
 	return status;
 }
 
+/**
+ * Determine if the current non-volatile state has changed since it was last stored to flash.  This
+ * only checks the state in memory and does not access flash.
+ *
+ * @param manager The state manager to query.
+ *
+ * @return true if there is state that needs to be stored or false if not.
+ */
+bool state_manager_has_unstored_state (struct state_manager *manager)
+{
+	uint16_t store_state;
+
+	if (manager == NULL) {
+		return false;
+	}
+
+	platform_mutex_lock (&manager->state_lock);
+	store_state = manager->nv_state;
+	platform_mutex_unlock (&manager->state_lock);
+
+	if (!manager->journal) {
+		store_state &= ~SINGLE_BYTE_STATE;
+		store_state |= MULTI_BYTE_STATE;
+	}
+
+	return (store_state != manager->last_nv_stored);
+}
+
 /**
  * Save the setting for the manifest region that contains the active manifest.
  * This setting will be stored in non-volatile memory on the next call to store state.
@@ -20,6 +20,8 @@ enum manifest_region {
 };
 
 
+struct state_journal;
+
 /**
  * Manager for state information.
  */
@@ -32,6 +34,9 @@ struct state_manager {
 	uint8_t volatile_state;			/**< The current volatile state. */
 	platform_mutex state_lock;		/**< Synchronization lock for state. */
 	platform_mutex store_lock;		/**< Synchronization lock for store actions. */
+	const struct state_journal *journal;	/**< Journal used to store the non-volatile state. */
+	uint8_t journal_index;			/**< Index of the state in the journal records. */
+	bool store_blocked;				/**< Flag indicating non-volatile state storage is blocked. */
 
 	/**
 	 * Save the setting for the manifest region that contains the active manifest.
@@ -81,9 +86,12 @@ struct state_manager {
 
 int state_manager_init (struct state_manager *manager, const struct flash *state_flash,
 	uint32_t store_addr);
+int state_manager_init_journal (struct state_manager *manager, const struct state_journal *journal,
+	uint8_t index);
 void state_manager_release (struct state_manager *manager);
 
 int state_manager_store_non_volatile_state (struct state_manager *manager);
+bool state_manager_has_unstored_state (struct state_manager *manager);
 void state_manager_block_non_volatile_state_storage (struct state_manager *manager, bool block);
 
 /* Internal functions for use by derived types. */
@@ -104,6 +112,7 @@ enum {
 	STATE_MANAGER_NOT_BLANK = STATE_MANAGER_ERROR (0x03),			/**< The next flash block was not blank for saving state. */
 	STATE_MANAGER_OUT_OF_RANGE = STATE_MANAGER_ERROR (0x04),		/**< Argument is not within the valid range. */
 	STATE_MANAGER_INCOMPLETE_WRITE = STATE_MANAGER_ERROR (0x05),	/**< The state was not completely written to flash. */
+	STATE_MANAGER_INDEX_IN_USE = STATE_MANAGER_ERROR (0x06),		/**< The journal index is used by a different state manager. */
 };
 
 
@@ -6,7 +6,7 @@
 #include <string.h>
 #include "state_persistence_handler.h"
 #include "state_logging.h"
-#include "common/unused.h"
+#include "common/type_cast.h"
 
 
 void state_persistence_handler_prepare (const struct periodic_task_handler *handler)
@@ -22,37 +22,178 @@ void state_persistence_handler_prepare (const struct periodic_task_handler *hand
 	}
 }
 
+/**
+ * Start the deadline for storing state changes, if it is not already running.  The handler lock
+ * must be held by the caller.
+ *
+ * @param persist The handler to update.
+ */
+static void state_persistence_handler_start_deadline (
+	const struct state_persistence_handler *persist)
+{
+	if (!persist->state->pending) {
+		if (platform_init_timeout (persist->deadline, &persist->state->deadline) == 0) {
+			persist->state->pending = true;
+		}
+	}
+}
+
+/**
+ * Check the state managers for changes that have not been stored.  If there are any, start the
+ * deadline for storing them.  This only checks the state in memory and does not access flash.  The
+ * handler lock must be held by the caller.
+ *
+ * @param persist The handler to check.
+ */
+static void state_persistence_handler_check_for_changes (
+	const struct state_persistence_handler *persist)
+{
+	size_t i;
+
+	if (!persist->state->pending) {
+		for (i = 0; i < persist->manager_count; i++) {
+			if (state_manager_has_unstored_state (persist->managers[i])) {
+				state_persistence_handler_start_deadline (persist);
+				break;
+			}
+		}
+	}
+}
+
 const platform_clock* state_persistence_handler_get_next_execution (
 	const struct periodic_task_handler *handler)
 {
 	const struct state_persistence_handler *persist =
 		(const struct state_persistence_handler*) handler;
+	const platform_clock *next = &persist->state->next;
+	const platform_clock *early;
+	uint32_t next_wait;
+	uint32_t early_wait;
 
-	if (persist->state->next_valid) {
-		return &persist->state->next;
-	}
-	else {
+	if (!persist->state->next_valid) {
 		/* If the next timeout is not valid, just indicate immediate execution. */
 		return NULL;
 	}
+
+	if (persist->deadline != 0) {
+		platform_mutex_lock (&persist->state->lock);
+
+		state_persistence_handler_check_for_changes (persist);
+
+		if (persist->state->pending) {
+			early = &persist->state->deadline;
+		}
+		else if (platform_init_timeout (persist->deadline, &persist->state->poll) == 0) {
+			/* The task can't be woken up when a change is made, so don't let it wait longer than
+			 * the deadline.  A change made while the task is waiting will then be stored by the
+			 * deadline started at the time of the change. */
+			early = &persist->state->poll;
+		}
+		else {
+			early = NULL;
+		}
+
+		/* Report whichever time comes first so the task can sleep until the handler actually
+		 * needs to run. */
+		if (early &&
+			((platform_get_timeout_remaining (&persist->state->next, &next_wait) != 0) ||
+			(platform_get_timeout_remaining (early, &early_wait) != 0) ||
+			(early_wait < next_wait))) {
+			next = early;
+		}
+
+		platform_mutex_unlock (&persist->state->lock);
+	}
+
+	return next;
 }
 
-void state_persistence_handler_execute (const struct periodic_task_handler *handler)
+/**
+ * Store the state for a list of state managers.
+ *
+ * @param persist The handler with the state managers to store.
+ * @param changed_only Flag to only store the state for managers that have changes that have not
+ * been stored.  This avoids any flash access for managers without changes.
+ */
+static void state_persistence_handler_store (const struct state_persistence_handler *persist,
+	bool changed_only)
 {
-	const struct state_persistence_handler *persist =
-		(const struct state_persistence_handler*) handler;
 	size_t i;
 	int status;
 
 	for (i = 0; i < persist->manager_count; i++) {
+		/* Managers sharing storage will be stored together, so they will not need to be stored
+		 * again after the first one. */
+		if (changed_only && !state_manager_has_unstored_state (persist->managers[i])) {
+			continue;
+		}
+
 		status = state_manager_store_non_volatile_state (persist->managers[i]);
 		if (status != 0) {
 			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_STATE_MGR,
 				STATE_LOGGING_PERSIST_FAIL, i, status);
 		}
 	}
+}
+
+void state_persistence_handler_execute (const struct periodic_task_handler *handler)
+{
+	const struct state_persistence_handler *persist =
+		(const struct state_persistence_handler*) handler;
+	bool full_store = true;
+
+	if (persist->deadline != 0) {
+		platform_mutex_lock (&persist->state->lock);
+
+		/* Clear the pending changes before storing so any new changes will start a new deadline.
+		 * If the periodic timeout has not expired, only store managers that have changed. */
+		persist->state->pending = false;
+		if (persist->state->next_valid &&
+			(platform_has_timeout_expired (&persist->state->next) == 0)) {
+			full_store = false;
+		}
+
+		platform_mutex_unlock (&persist->state->lock);
+	}
+
+	state_persistence_handler_store (persist, !full_store);
+
+	if (full_store) {
+		state_persistence_handler_prepare (handler);
+	}
+}
+
+void state_persistence_handler_on_shutdown (struct system_observer *observer)
+{
+	const struct state_persistence_handler *persist =
+		TO_DERIVED_TYPE (observer, const struct state_persistence_handler, base_system);
+
+	/* Don't wait for any deadline, since the device is about to reset. */
+	platform_mutex_lock (&persist->state->lock);
+	persist->state->pending = false;
+	platform_mutex_unlock (&persist->state->lock);
 
-	state_persistence_handler_prepare (handler);
+	state_persistence_handler_store (persist, true);
+}
+
+/**
+ * Notify the handler that the state for one of the state managers has changed.  When the handler
+ * is using a deadline for storing changes, this starts the deadline if one is not already running.
+ * Otherwise, this does nothing.
+ *
+ * Calling this is not required to have state changes get stored, but it ensures the deadline is
+ * measured from the time of the change.  Without a notification, a change may not be detected
+ * until the deadline after it was made, delaying storage by up to twice the deadline.
+ *
+ * @param handler The handler to notify.
+ */
+void state_persistence_handler_notify_change (const struct state_persistence_handler *handler)
+{
+	if ((handler != NULL) && (handler->deadline != 0)) {
+		platform_mutex_lock (&handler->state->lock);
+		state_persistence_handler_start_deadline (handler);
+		platform_mutex_unlock (&handler->state->lock);
+	}
 }
 
 /**
@@ -80,6 +221,8 @@ int state_persistence_handler_init (struct state_persistence_handler *handler,
 	handler->base.get_next_execution = state_persistence_handler_get_next_execution;
 	handler->base.execute = state_persistence_handler_execute;
 
+	handler->base_system.on_shutdown = state_persistence_handler_on_shutdown;
+
 	handler->state = state;
 	handler->managers = managers;
 	handler->manager_count = manager_count;
@@ -88,6 +231,43 @@ int state_persistence_handler_init (struct state_persistence_handler *handler,
 	return state_persistence_handler_init_state (handler);
 }
 
+/**
+ * Initialize a handler to persist state to flash within a deadline of any state change.  In
+ * addition to storing changes as they happen, the state of all managers will be stored
+ * periodically, which allows for detection and correction of errors in the stored state.
+ *
+ * The handler will also store any outstanding changes when notified of a system shutdown.
+ *
+ * @param handler The state handler to initialize.
+ * @param state Variable context for the handler.  This must be uninitialized.
+ * @param managers The list of states that should be stored.
+ * @param manager_count The number of state managers in the list.
+ * @param period_ms The amount of time between storage requests for all states, in milliseconds.
+ * @param deadline_ms The maximum amount of time to wait after a state change before storing it, in
+ * milliseconds.  This should be less than the period.
+ *
+ * @return 0 if the handler was successfully initialized or an error code.
+ */
+int state_persistence_handler_init_with_deadline (struct state_persistence_handler *handler,
+	struct state_persistence_handler_state *state, struct state_manager **managers,
+	size_t manager_count, uint32_t period_ms, uint32_t deadline_ms)
+{
+	int status;
+
+	if (deadline_ms == 0) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
+	}
+
+	status = state_persistence_handler_init (handler, state, managers, manager_count, period_ms);
+	if (status != 0) {
+		return status;
+	}
+
+	handler->deadline = deadline_ms;
+
+	return 0;
+}
+
 /**
  * Initialize only the variable state for a state persistence handler.  The rest of the handler is
  * assumed to have already been initialized.
@@ -107,7 +287,7 @@ int state_persistence_handler_init_state (const struct state_persistence_handler
 
 	memset (handler->state, 0, sizeof (struct state_persistence_handler_state));
 
-	return 0;
+	return platform_mutex_init (&handler->state->lock);
 }
 
 /**
@@ -117,5 +297,7 @@ int state_persistence_handler_init_state (const struct state_persistence_handler
  */
 void state_persistence_handler_release (const struct state_persistence_handler *handler)
 {
-	UNUSED (handler);
+	if (handler) {
+		platform_mutex_free (&handler->state->lock);
+	}
 }
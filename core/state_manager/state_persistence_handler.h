@@ -10,6 +10,7 @@
 #include "platform_api.h"
 #include "state_manager.h"
 #include "system/periodic_task.h"
+#include "system/system_observer.h"
 
 
 /**
@@ -18,6 +19,10 @@
 struct state_persistence_handler_state {
 	platform_clock next;				/**< Time at which the next execution should run. */
 	bool next_valid;					/**< Indicate if the next timeout has been initialized. */
+	platform_clock deadline;			/**< Time by which pending state changes must be stored. */
+	platform_clock poll;				/**< Time at which to check for new state changes. */
+	bool pending;						/**< Indicate if there are state changes waiting to be stored. */
+	platform_mutex lock;				/**< Synchronization for pending state changes. */
 };
 
 /**
@@ -25,19 +30,26 @@ struct state_persistence_handler_state {
  */
 struct state_persistence_handler {
 	struct periodic_task_handler base;				/**< Base interface for task integration. */
+	struct system_observer base_system;				/**< Base observer for system notifications. */
 	struct state_persistence_handler_state *state;	/**< Variable context for the handler. */
 	struct state_manager **managers;				/**< List of states to persist. */
 	size_t manager_count;							/**< Number of state managers in the list. */
 	uint32_t period;								/**< Required time between state persistence. */
+	uint32_t deadline;								/**< Maximum time to wait before storing changes. */
 };
 
 
 int state_persistence_handler_init (struct state_persistence_handler *handler,
 	struct state_persistence_handler_state *state, struct state_manager **managers,
 	size_t manager_count, uint32_t period_ms);
+int state_persistence_handler_init_with_deadline (struct state_persistence_handler *handler,
+	struct state_persistence_handler_state *state, struct state_manager **managers,
+	size_t manager_count, uint32_t period_ms, uint32_t deadline_ms);
 int state_persistence_handler_init_state (const struct state_persistence_handler *handler);
 void state_persistence_handler_release (const struct state_persistence_handler *handler);
 
+void state_persistence_handler_notify_change (const struct state_persistence_handler *handler);
+
 
 /* This module will be treated as an extension of the state manager module and use STATE_MANAGER_*
  * error codes. */
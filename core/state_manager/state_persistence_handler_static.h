@@ -13,6 +13,8 @@ const platform_clock* state_persistence_handler_get_next_execution (
 	const struct periodic_task_handler *handler);
 void state_persistence_handler_execute (const struct periodic_task_handler *handler);
 
+void state_persistence_handler_on_shutdown (struct system_observer *observer);
+
 
 /**
  * Constant initializer for the state persistence API.
@@ -23,6 +25,13 @@ void state_persistence_handler_execute (const struct periodic_task_handler *hand
 		.execute = state_persistence_handler_execute, \
 	}
 
+/**
+ * Constant initializer for the system observer API.
+ */
+#define	STATE_PERSISTENCE_HANDLER_SYSTEM_OBSERVER_API_INIT  { \
+		.on_shutdown = state_persistence_handler_on_shutdown, \
+	}
+
 
 /**
  * Initialize a static instance of a state persistence handler.  This does not initialize the
@@ -37,10 +46,37 @@ void state_persistence_handler_execute (const struct periodic_task_handler *hand
  */
 #define	state_persistence_handler_static_init(state_ptr, managers_ptr, num_managers, period_ms)	{ \
 		.base = STATE_PERSISTENCE_HANDLER_API_INIT, \
+		.base_system = STATE_PERSISTENCE_HANDLER_SYSTEM_OBSERVER_API_INIT, \
+		.state = state_ptr, \
+		.managers = managers_ptr, \
+		.manager_count = num_managers, \
+		.period = period_ms, \
+		.deadline = 0, \
+	}
+
+/**
+ * Initialize a static instance of a state persistence handler that stores state changes within a
+ * deadline of the change.  This does not initialize the handler state.  This can be a constant
+ * instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state Variable context for the handler.
+ * @param managers_ptr The list of states that should be flushed.
+ * @param num_managers The number of state managers in the list.
+ * @param period_ms The amount of time between full state storage requests, in milliseconds.
+ * @param deadline_ms The maximum amount of time to wait before storing a state change, in
+ * milliseconds.
+ */
+#define	state_persistence_handler_static_init_with_deadline(state_ptr, managers_ptr, num_managers, \
+	period_ms, deadline_ms)	{ \
+		.base = STATE_PERSISTENCE_HANDLER_API_INIT, \
+		.base_system = STATE_PERSISTENCE_HANDLER_SYSTEM_OBSERVER_API_INIT, \
 		.state = state_ptr, \
 		.managers = managers_ptr, \
 		.manager_count = num_managers, \
 		.period = period_ms, \
+		.deadline = deadline_ms, \
 	}
 
 
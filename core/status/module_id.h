@@ -124,6 +124,8 @@ enum {
 	ROT_MODULE_DICE_UEID_EXTENSION = 0x0070,			/**< Extension handler for TCG DICE Ueid extensions. */
 	ROT_MODULE_DME_EXTENSION = 0x0071,					/**< Extension handler for DME extensions. */
 	ROT_MODULE_DME_STRUCTURE = 0x0072,					/**< Parsing and management of the DME structure. */
+	ROT_MODULE_FLASH_QUEUE = 0x0073,					/**< Asynchronous queue of flash operations. */
+	ROT_MODULE_CMD_DISPATCH = 0x0074,					/**< Worker pool for executing received commands. */
 	ROT_MODULE_I2C_FILTER = 0x0010,
 };
 
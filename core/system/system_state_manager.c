@@ -70,6 +70,19 @@ static int system_state_manager_restore_default_state (struct state_manager *man
 	return 0;
 }
 
+/**
+ * Initialize the system state manager API.
+ *
+ * @param manager The state manager to initialize.
+ */
+static void system_state_manager_init_api (struct state_manager *manager)
+{
+	manager->get_active_manifest = system_state_manager_get_active_manifest;
+	manager->save_active_manifest = system_state_manager_save_active_manifest;
+	manager->restore_default_state = system_state_manager_restore_default_state;
+	manager->is_manifest_valid = system_state_manager_is_manifest_valid;
+}
+
 /**
  * Initialize the manager for system state information.
  *
@@ -93,10 +106,34 @@ int system_state_manager_init (struct state_manager *manager, const struct flash
 	status = state_manager_init (manager, state_flash, store_addr);
 
 	if (status == 0) {
-		manager->get_active_manifest = system_state_manager_get_active_manifest;
-		manager->save_active_manifest = system_state_manager_save_active_manifest;
-		manager->restore_default_state = system_state_manager_restore_default_state;
-		manager->is_manifest_valid = system_state_manager_is_manifest_valid;
+		system_state_manager_init_api (manager);
+	}
+
+	return status;
+}
+
+/**
+ * Initialize the manager for system state information that is stored in a state journal.
+ *
+ * @param manager The state manager to initialize.
+ * @param journal The journal that contains the non-volatile state information.
+ * @param index Index of the system state in the journal records.
+ *
+ * @return 0 if the state manager was successfully initialized or an error code.
+ */
+int system_state_manager_init_journal (struct state_manager *manager,
+	const struct state_journal *journal, uint8_t index)
+{
+	int status;
+
+	if (manager == NULL) {
+		return STATE_MANAGER_INVALID_ARGUMENT;
+	}
+
+	status = state_manager_init_journal (manager, journal, index);
+
+	if (status == 0) {
+		system_state_manager_init_api (manager);
 	}
 
 	return status;
@@ -22,6 +22,8 @@ enum {
 
 int system_state_manager_init (struct state_manager *manager, const struct flash *state_flash,
 	uint32_t store_addr);
+int system_state_manager_init_journal (struct state_manager *manager,
+	const struct state_journal *journal, uint8_t index);
 void system_state_manager_release (struct state_manager *manager);
 
 
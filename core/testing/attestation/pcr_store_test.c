@@ -54,6 +54,57 @@ static void complete_pcr_store_mock_test (CuTest *test, struct pcr_store *store,
 	pcr_store_release (store);
 }
 
+/**
+ * Set up expectations for computing a PCR bank that contains a single measurement.
+ *
+ * @param test The test framework.
+ * @param hash The mock hash engine to update.
+ * @param digest The digest stored as the measurement.
+ * @param result The computed PCR value to report.
+ */
+static void pcr_store_test_expect_single_measurement (CuTest *test, struct hash_engine_mock *hash,
+	const uint8_t *digest, const uint8_t *result)
+{
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	int status;
+
+	status = mock_expect (&hash->mock, hash->base.start_sha256, hash, 0);
+	status |= mock_expect (&hash->mock, hash->base.update, hash, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (buffer0, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash->mock, hash->base.update, hash, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (digest, PCR_DIGEST_LENGTH), MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect (&hash->mock, hash->base.finish, hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output_tmp (&hash->mock, 0, result, PCR_DIGEST_LENGTH, -1);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Build the expected attestation log entry for a single measurement.
+ *
+ * @param entry The log entry to populate.
+ * @param entry_id ID of the log entry.
+ * @param measurement_type The measurement reported by the entry.
+ * @param digest The digest stored as the measurement.
+ * @param result The computed measurement value.
+ */
+static void pcr_store_test_build_log_entry (struct pcr_store_attestation_log_entry *entry,
+	uint32_t entry_id, uint16_t measurement_type, const uint8_t *digest, const uint8_t *result)
+{
+	memset (entry, 0, sizeof (struct pcr_store_attestation_log_entry));
+
+	entry->header.log_magic = 0xCB;
+	entry->header.length = sizeof (struct pcr_store_attestation_log_entry);
+	entry->header.entry_id = entry_id;
+	entry->entry.digest_algorithm_id = 0x0B;
+	entry->entry.digest_count = 1;
+	entry->entry.measurement_size = 32;
+	entry->entry.measurement_type = measurement_type;
+
+	memcpy (entry->entry.digest, digest, sizeof (entry->entry.digest));
+	memcpy (entry->entry.measurement, result, sizeof (entry->entry.measurement));
+}
+
 /*******************
  * Test cases
  *******************/
@@ -2466,6 +2517,432 @@ static void pcr_store_test_get_attestation_log_compute_fail (CuTest *test)
 	complete_pcr_store_mock_test (test, &store, &hash);
 }
 
+static void pcr_store_test_enable_attestation_log_snapshot (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	CuAssertIntEquals (test, 0, store.log_snapshot_timeout);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 100);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 100, store.log_snapshot_timeout);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, store.log_snapshot_timeout);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_enable_attestation_log_snapshot_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = pcr_store_enable_attestation_log_snapshot (NULL, 100);
+	CuAssertIntEquals (test, PCR_INVALID_ARGUMENT, status);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	struct pcr_store_attestation_log_entry exp_buf[2];
+	uint8_t digest[3][PCR_DIGEST_LENGTH];
+	uint8_t result[2][PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digest[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (digest[2], 0x33, PCR_DIGEST_LENGTH);
+	memset (result[0], 0xaa, PCR_DIGEST_LENGTH);
+	memset (result[1], 0xbb, PCR_DIGEST_LENGTH);
+
+	pcr_store_test_build_log_entry (&exp_buf[0], 0, PCR_MEASUREMENT (0, 0), digest[0], result[0]);
+	pcr_store_test_build_log_entry (&exp_buf[1], 1, PCR_MEASUREMENT (1, 0), digest[1], result[1]);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_test_expect_single_measurement (test, &hash, digest[0], result[0]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[1], result[1]);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest[0], PCR_DIGEST_LENGTH);
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[1], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+	CuAssertPtrNotNull (test, store.log_snapshot);
+
+	status = testing_validate_array ((uint8_t*) &exp_buf[0], (uint8_t*) buf, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Changes after the start of the read must not be visible in the remaining log data. */
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[2], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base,
+		sizeof (struct pcr_store_attestation_log_entry), (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	status = testing_validate_array ((uint8_t*) &exp_buf[1], (uint8_t*) buf, status);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot_not_entry_aligned (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	struct pcr_store_attestation_log_entry exp_buf[2];
+	uint8_t digest[2][PCR_DIGEST_LENGTH];
+	uint8_t result[2][PCR_DIGEST_LENGTH];
+	size_t first = sizeof (struct pcr_store_attestation_log_entry) + 10;
+	int status;
+
+	TEST_START;
+
+	memset (digest[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digest[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (result[0], 0xaa, PCR_DIGEST_LENGTH);
+	memset (result[1], 0xbb, PCR_DIGEST_LENGTH);
+
+	pcr_store_test_build_log_entry (&exp_buf[0], 0, PCR_MEASUREMENT (0, 0), digest[0], result[0]);
+	pcr_store_test_build_log_entry (&exp_buf[1], 1, PCR_MEASUREMENT (1, 0), digest[1], result[1]);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_test_expect_single_measurement (test, &hash, digest[0], result[0]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[1], result[1]);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest[0], PCR_DIGEST_LENGTH);
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[1], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf, first);
+	CuAssertIntEquals (test, first, status);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, first, &((uint8_t*) buf)[first],
+		sizeof (buf) - first);
+	CuAssertIntEquals (test, sizeof (buf) - first, status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	status = testing_validate_array ((uint8_t*) exp_buf, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot_restart (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	struct pcr_store_attestation_log_entry exp_buf[2];
+	uint8_t digest[3][PCR_DIGEST_LENGTH];
+	uint8_t result[3][PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digest[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (digest[2], 0x33, PCR_DIGEST_LENGTH);
+	memset (result[0], 0xaa, PCR_DIGEST_LENGTH);
+	memset (result[1], 0xbb, PCR_DIGEST_LENGTH);
+	memset (result[2], 0xcc, PCR_DIGEST_LENGTH);
+
+	pcr_store_test_build_log_entry (&exp_buf[0], 0, PCR_MEASUREMENT (0, 0), digest[0], result[0]);
+	pcr_store_test_build_log_entry (&exp_buf[1], 1, PCR_MEASUREMENT (1, 0), digest[2], result[2]);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_test_expect_single_measurement (test, &hash, digest[0], result[0]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[1], result[1]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[2], result[2]);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest[0], PCR_DIGEST_LENGTH);
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[1], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[2], PCR_DIGEST_LENGTH);
+
+	/* A new read from the start of the log captures a new snapshot. */
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base,
+		sizeof (struct pcr_store_attestation_log_entry), (uint8_t*) &buf[1],
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+
+	status = testing_validate_array ((uint8_t*) exp_buf, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot_complete_read (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	struct pcr_store_attestation_log_entry exp_buf[2];
+	uint8_t digest[3][PCR_DIGEST_LENGTH];
+	uint8_t result[3][PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digest[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (digest[2], 0x33, PCR_DIGEST_LENGTH);
+	memset (result[0], 0xaa, PCR_DIGEST_LENGTH);
+	memset (result[1], 0xbb, PCR_DIGEST_LENGTH);
+	memset (result[2], 0xcc, PCR_DIGEST_LENGTH);
+
+	pcr_store_test_build_log_entry (&exp_buf[0], 0, PCR_MEASUREMENT (0, 0), digest[0], result[0]);
+	pcr_store_test_build_log_entry (&exp_buf[1], 1, PCR_MEASUREMENT (1, 0), digest[2], result[2]);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_test_expect_single_measurement (test, &hash, digest[0], result[0]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[1], result[1]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[2], result[2]);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest[0], PCR_DIGEST_LENGTH);
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[1], PCR_DIGEST_LENGTH);
+
+	/* Reading the entire log in one request does not hold a snapshot. */
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, sizeof (buf), status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[2], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base,
+		sizeof (struct pcr_store_attestation_log_entry), (uint8_t*) &buf[1],
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	status = testing_validate_array ((uint8_t*) exp_buf, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot_timeout (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	struct pcr_store_attestation_log_entry exp_buf[2];
+	uint8_t digest[3][PCR_DIGEST_LENGTH];
+	uint8_t result[3][PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digest[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (digest[2], 0x33, PCR_DIGEST_LENGTH);
+	memset (result[0], 0xaa, PCR_DIGEST_LENGTH);
+	memset (result[1], 0xbb, PCR_DIGEST_LENGTH);
+	memset (result[2], 0xcc, PCR_DIGEST_LENGTH);
+
+	pcr_store_test_build_log_entry (&exp_buf[0], 0, PCR_MEASUREMENT (0, 0), digest[0], result[0]);
+	pcr_store_test_build_log_entry (&exp_buf[1], 1, PCR_MEASUREMENT (1, 0), digest[2], result[2]);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_test_expect_single_measurement (test, &hash, digest[0], result[0]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[1], result[1]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[2], result[2]);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest[0], PCR_DIGEST_LENGTH);
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[1], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+	CuAssertPtrNotNull (test, store.log_snapshot);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[2], PCR_DIGEST_LENGTH);
+
+	platform_msleep (20);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base,
+		sizeof (struct pcr_store_attestation_log_entry), (uint8_t*) &buf[1],
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	status = testing_validate_array ((uint8_t*) exp_buf, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot_released (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	struct pcr_store_attestation_log_entry exp_buf[2];
+	uint8_t digest[3][PCR_DIGEST_LENGTH];
+	uint8_t result[3][PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digest[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (digest[2], 0x33, PCR_DIGEST_LENGTH);
+	memset (result[0], 0xaa, PCR_DIGEST_LENGTH);
+	memset (result[1], 0xbb, PCR_DIGEST_LENGTH);
+	memset (result[2], 0xcc, PCR_DIGEST_LENGTH);
+
+	pcr_store_test_build_log_entry (&exp_buf[0], 0, PCR_MEASUREMENT (0, 0), digest[0], result[0]);
+	pcr_store_test_build_log_entry (&exp_buf[1], 1, PCR_MEASUREMENT (1, 0), digest[2], result[2]);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_test_expect_single_measurement (test, &hash, digest[0], result[0]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[1], result[1]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[2], result[2]);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest[0], PCR_DIGEST_LENGTH);
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[1], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[2], PCR_DIGEST_LENGTH);
+
+	pcr_store_release_attestation_log_snapshot (&store);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base,
+		sizeof (struct pcr_store_attestation_log_entry), (uint8_t*) &buf[1],
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+
+	status = testing_validate_array ((uint8_t*) exp_buf, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot_disabled (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	uint8_t digest[2][PCR_DIGEST_LENGTH];
+	uint8_t result[2][PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest[0], 0x11, PCR_DIGEST_LENGTH);
+	memset (digest[1], 0x22, PCR_DIGEST_LENGTH);
+	memset (result[0], 0xaa, PCR_DIGEST_LENGTH);
+	memset (result[1], 0xbb, PCR_DIGEST_LENGTH);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_test_expect_single_measurement (test, &hash, digest[0], result[0]);
+	pcr_store_test_expect_single_measurement (test, &hash, digest[1], result[1]);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest[0], PCR_DIGEST_LENGTH);
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (1, 0), digest[1], PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+	CuAssertPtrNotNull (test, store.log_snapshot);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_snapshot_compute_fail (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[2];
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest, 0x11, PCR_DIGEST_LENGTH);
+
+	setup_pcr_store_mock_test (test, &store, &hash, 1, 1);
+
+	status = pcr_store_enable_attestation_log_snapshot (&store, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, HASH_ENGINE_NO_MEMORY);
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest, PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+	CuAssertPtrEquals (test, NULL, store.log_snapshot);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
 static void pcr_store_test_invalidate_measurement (CuTest *test)
 {
 	struct pcr_store store;
@@ -3883,6 +4360,16 @@ TEST (pcr_store_test_get_attestation_log_small_buffer_nonzero_offset);
 TEST (pcr_store_test_get_attestation_log_invalid_offset);
 TEST (pcr_store_test_get_attestation_log_invalid_arg);
 TEST (pcr_store_test_get_attestation_log_compute_fail);
+TEST (pcr_store_test_enable_attestation_log_snapshot);
+TEST (pcr_store_test_enable_attestation_log_snapshot_null);
+TEST (pcr_store_test_get_attestation_log_snapshot);
+TEST (pcr_store_test_get_attestation_log_snapshot_not_entry_aligned);
+TEST (pcr_store_test_get_attestation_log_snapshot_restart);
+TEST (pcr_store_test_get_attestation_log_snapshot_complete_read);
+TEST (pcr_store_test_get_attestation_log_snapshot_timeout);
+TEST (pcr_store_test_get_attestation_log_snapshot_released);
+TEST (pcr_store_test_get_attestation_log_snapshot_disabled);
+TEST (pcr_store_test_get_attestation_log_snapshot_compute_fail);
 TEST (pcr_store_test_invalidate_measurement);
 TEST (pcr_store_test_invalidate_measurement_explicit);
 TEST (pcr_store_test_invalidate_measurement_null);
@@ -1777,6 +1777,360 @@ static void pcr_test_compute_finish_hash_fail (CuTest *test)
 	complete_pcr_mock_test (test, &pcr, &hash);
 }
 
+static void pcr_test_compute_cached (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint32_t saved;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_hashes_saved (&pcr, &saved);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, saved);
+
+	memset (measurement, 0, sizeof (measurement));
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, NULL, false);
+	CuAssertIntEquals (test, 2, status);
+
+	status = pcr_get_hashes_saved (&pcr, &saved);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 4, saved);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_update_after_compute (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t buffer2[] = {
+		0xe6,0xe6,0x91,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint8_t digest3[] = {
+		0x7f,0xe6,0x9c,0x6f,0x7f,0x38,0x9d,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe9,0x4f,0x48,0x1a,0x4f,0x8d,0x1d,0x3d,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint32_t saved;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only the updated measurement needs to be extended again. */
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer2, sizeof (buffer2)), MOCK_ARG (sizeof (buffer2)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest3, sizeof (digest3), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 1, buffer2, sizeof (buffer2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest3, measurement, sizeof (digest3));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_hashes_saved (&pcr, &saved);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, saved);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_invalidate_after_compute (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint8_t digest3[] = {
+		0x7f,0xe6,0x9c,0x6f,0x7f,0x38,0x9d,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe9,0x4f,0x48,0x1a,0x4f,0x8d,0x1d,0x3d,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint32_t saved;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 1);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 1, status);
+
+	status = testing_validate_array (digest1, measurement, sizeof (digest1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_invalidate_measurement_index (&pcr, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 1, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Updating a measurement with a buffer also requires recomputation. */
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest3, sizeof (digest3), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_buffer (&pcr, &hash.base, 0, buffer1, sizeof (buffer1), false);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 1, status);
+
+	status = testing_validate_array (digest3, measurement, sizeof (digest3));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_hashes_saved (&pcr, &saved);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, saved);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_resume_after_hash_fail (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	uint8_t buffer0[PCR_DIGEST_LENGTH] = {0};
+	uint8_t buffer1[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f
+	};
+	uint8_t digest1[] = {
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e
+	};
+	uint8_t digest2[] = {
+		0x7f,0xe6,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x9c,0x4f,0x7f,0x38,0x7f,0x6e,
+		0x91,0xe6,0xe6,0x4f,0x38,0x13,0x4f,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e
+	};
+	uint32_t saved;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer1, sizeof (buffer1)), MOCK_ARG (sizeof (buffer1)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest1, sizeof (digest1), -1);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash,
+		HASH_ENGINE_START_SHA256_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_update_digest (&pcr, 0, buffer1, sizeof (buffer1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	/* The first measurement was computed successfully and does not need to be extended again. */
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (digest1, sizeof (digest1)), MOCK_ARG (sizeof (digest1)));
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (buffer0, sizeof (buffer0)), MOCK_ARG (sizeof (buffer0)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (PCR_DIGEST_LENGTH));
+	status |= mock_expect_output (&hash.mock, 0, digest2, sizeof (digest2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute (&pcr, &hash.base, measurement, true);
+	CuAssertIntEquals (test, 2, status);
+
+	status = testing_validate_array (digest2, measurement, sizeof (digest2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_get_hashes_saved (&pcr, &saved);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, saved);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_get_hashes_saved_null (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	uint32_t saved;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 2);
+
+	status = pcr_get_hashes_saved (NULL, &saved);
+	CuAssertIntEquals (test, PCR_INVALID_ARGUMENT, status);
+
+	status = pcr_get_hashes_saved (&pcr, NULL);
+	CuAssertIntEquals (test, PCR_INVALID_ARGUMENT, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
 static void pcr_test_get_measurement (CuTest *test)
 {
 	struct pcr_bank pcr;
@@ -16577,6 +16931,11 @@ TEST (pcr_test_compute_start_hash_fail);
 TEST (pcr_test_compute_hash_fail);
 TEST (pcr_test_compute_extend_hash_fail);
 TEST (pcr_test_compute_finish_hash_fail);
+TEST (pcr_test_compute_cached);
+TEST (pcr_test_compute_update_after_compute);
+TEST (pcr_test_compute_invalidate_after_compute);
+TEST (pcr_test_compute_resume_after_hash_fail);
+TEST (pcr_test_get_hashes_saved_null);
 TEST (pcr_test_get_measurement);
 TEST (pcr_test_get_measurement_explicit);
 TEST (pcr_test_get_measurement_invalid_arg);
@@ -24,21 +24,20 @@ struct cmd_channel_testing {
 	struct cmd_interface_mock cmd_mctp;				/**< MCTP control protocol command interface mock instance. */
 	struct device_manager device_mgr;				/**< Device manager. */
 	struct mctp_interface mctp;						/**< MCTP interface instance */
+	struct cmd_packet_sg sg_packets[2];				/**< Scatter/gather packets for responses. */
 };
 
 /**
- * Helper function to setup the command channel to use a mock interfaces
+ * Helper function to setup the dependencies for command channel testing.
  *
  * @param test The test framework
  * @param channel The instances to initialize for testing
  */
-static void setup_mock_cmd_channel_test (CuTest *test, struct cmd_channel_testing *channel)
+static void setup_mock_cmd_channel_test_dependencies (CuTest *test,
+	struct cmd_channel_testing *channel)
 {
 	int status;
 
-	status = cmd_channel_mock_init (&channel->test, 0);
-	CuAssertIntEquals (test, 0, status);
-
 	status = cmd_interface_mock_init (&channel->cmd_cerberus);
 	CuAssertIntEquals (test, 0, status);
 
@@ -58,6 +57,50 @@ static void setup_mock_cmd_channel_test (CuTest *test, struct cmd_channel_testin
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Helper function to setup the command channel to use a mock interfaces
+ *
+ * @param test The test framework
+ * @param channel The instances to initialize for testing
+ */
+static void setup_mock_cmd_channel_test (CuTest *test, struct cmd_channel_testing *channel)
+{
+	int status;
+
+	status = cmd_channel_mock_init (&channel->test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_mock_cmd_channel_test_dependencies (test, channel);
+}
+
+/**
+ * Helper function to setup the command channel to use mock interfaces with scatter/gather
+ * responses.
+ *
+ * @param test The test framework
+ * @param channel The instances to initialize for testing
+ * @param channel_sg Flag to indicate if the channel supports scatter/gather packets.
+ */
+static void setup_mock_cmd_channel_scatter_gather_test (CuTest *test,
+	struct cmd_channel_testing *channel, bool channel_sg)
+{
+	int status;
+
+	if (channel_sg) {
+		status = cmd_channel_mock_init_scatter_gather (&channel->test, 0);
+	}
+	else {
+		status = cmd_channel_mock_init (&channel->test, 0);
+	}
+	CuAssertIntEquals (test, 0, status);
+
+	setup_mock_cmd_channel_test_dependencies (test, channel);
+
+	status = mctp_interface_enable_scatter_gather (&channel->mctp, channel->sg_packets,
+		sizeof (channel->sg_packets) / sizeof (channel->sg_packets[0]));
+	CuAssertIntEquals (test, 0, status);
+}
+
 /**
  * Helper function to complete command channel test
  *
@@ -448,31 +491,25 @@ static void cmd_channel_test_receive_and_process_multi_packet_response (CuTest *
 	complete_mock_cmd_channel_test (test, &channel);
 }
 
-static void cmd_channel_test_receive_and_process_max_response (CuTest *test)
+static void cmd_channel_test_receive_and_process_scatter_gather (CuTest *test)
 {
 	struct cmd_channel_testing channel;
 	struct cmd_packet rx_packet;
-	struct cmd_packet tx_packet[MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE];
+	struct cmd_packet tx_packet[2];
 	uint8_t data[10];
 	struct cmd_interface_msg request;
+	const int msg_size = 300;
+	uint8_t response_data[msg_size + 4];
 	struct cmd_interface_msg response;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx_packet.data;
-	uint8_t payload[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	uint8_t payload[msg_size];
 	int status;
-	size_t i;
-	size_t remain = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY -
-		(MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT *
-		(MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1));
-	size_t last_pkt_len = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+	int i;
 
 	TEST_START;
 
-	payload[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	payload[1] = 0;
-	payload[2] = 0;
-	payload[3] = 0;
-	for (i = 4; i < sizeof (payload); i++) {
+	for (i = 0; i < (int) sizeof (payload); i++) {
 		payload[i] = i;
 	}
 
@@ -508,33 +545,55 @@ static void cmd_channel_test_receive_and_process_max_response (CuTest *test)
 
 	memset (tx_packet, 0, sizeof (tx_packet));
 
-	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
-		uint8_t len = (i == (MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1)) ?
-			last_pkt_len : MCTP_BASE_PROTOCOL_MAX_PACKET_LEN;
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
 
-		header = (struct mctp_base_protocol_transport_header*) tx_packet[i].data;
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
 
-		header->cmd_code = SMBUS_CMD_CODE_MCTP;
-		header->byte_count = len - 3;
-		header->source_addr = 0xBB;
-		header->rsvd = 0;
-		header->header_version = 1;
-		header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-		header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-		header->som = !i;
-		header->eom = (len == last_pkt_len);
-		header->tag_owner = 0;
-		header->msg_tag = 0x00;
-		header->packet_seq = i % 4;
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
 
-		memcpy (&tx_packet[i].data[7], &payload[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT], len);
-		tx_packet[i].data[len - 1] = checksum_crc8 (0xAA, tx_packet[i].data, len - 1);
-		tx_packet[i].pkt_size = len;
-		tx_packet[i].state = CMD_VALID_PACKET;
-		tx_packet[i].dest_addr = 0x55;
-	}
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
 
-	setup_mock_cmd_channel_test (test, &channel);
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+
+	setup_mock_cmd_channel_scatter_gather_test (test, &channel, true);
 
 	request.data = data;
 	request.length = sizeof (data);
@@ -545,8 +604,13 @@ static void cmd_channel_test_receive_and_process_max_response (CuTest *test)
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	response.data = payload;
-	response.length = sizeof (payload);
+	response.data = response_data;
+	response.length = sizeof (response_data);
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	memcpy (&response.data[4], payload, msg_size);
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	response.crypto_timeout = false;
@@ -561,11 +625,12 @@ static void cmd_channel_test_receive_and_process_max_response (CuTest *test)
 			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
 	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
-		status |= mock_expect (&channel.test.mock, channel.test.base.send_packet, &channel.test, 0,
-			MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[i],
-				sizeof (struct cmd_packet)));
-	}
+	status |= mock_expect (&channel.test.mock, channel.test.base.send_packet_sg, &channel.test, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg, &tx_packet[0],
+			sizeof (struct cmd_packet)));
+	status |= mock_expect (&channel.test.mock, channel.test.base.send_packet_sg, &channel.test, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg, &tx_packet[1],
+			sizeof (struct cmd_packet)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -575,21 +640,18 @@ static void cmd_channel_test_receive_and_process_max_response (CuTest *test)
 	complete_mock_cmd_channel_test (test, &channel);
 }
 
-static void cmd_channel_test_receive_and_process_multi_packet_message (CuTest *test)
+static void cmd_channel_test_receive_and_process_scatter_gather_channel_no_support (CuTest *test)
 {
 	struct cmd_channel_testing channel;
-	struct cmd_packet rx_packet[2];
-	struct cmd_packet tx_packet;
-	const int msg_size = 300;
-	uint8_t data[msg_size + 4];
+	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet[2];
+	uint8_t data[10];
 	struct cmd_interface_msg request;
+	const int msg_size = 300;
+	uint8_t response_data[msg_size + 4];
 	struct cmd_interface_msg response;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx_packet[0].data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
-	uint16_t pci_vid = 0x1414;
+		(struct mctp_base_protocol_transport_header*) rx_packet.data;
 	uint8_t payload[msg_size];
 	int status;
 	int i;
@@ -603,136 +665,108 @@ static void cmd_channel_test_receive_and_process_multi_packet_message (CuTest *t
 	memset (&rx_packet, 0, sizeof (rx_packet));
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 252;
+	header->byte_count = 15;
 	header->source_addr = 0xAB;
 	header->rsvd = 0;
 	header->header_version = 1;
 	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
-	header->eom = 0;
+	header->eom = 1;
 	header->tag_owner = 1;
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	rx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	rx_packet[0].data[8] = 0x00;
-	rx_packet[0].data[9] = 0x00;
-	rx_packet[0].data[10] = 0x00;
-	memcpy (&rx_packet[0].data[11], payload, 255 - 12);
-	rx_packet[0].data[254] = checksum_crc8 (0xBA, rx_packet[0].data, 254);
-	rx_packet[0].pkt_size = 255;
-	rx_packet[0].state = CMD_VALID_PACKET;
-	rx_packet[0].dest_addr = 0x5D;
+	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = 0x0B;
+	rx_packet.data[12] = 0x0A;
+	rx_packet.data[13] = 0x01;
+	rx_packet.data[14] = 0x02;
+	rx_packet.data[15] = 0x03;
+	rx_packet.data[16] = 0x04;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.state = CMD_VALID_PACKET;
+	rx_packet.dest_addr = 0x5D;
 
-	header = (struct mctp_base_protocol_transport_header*) rx_packet[1].data;
+	memset (tx_packet, 0, sizeof (tx_packet));
 
-	i = msg_size - (255 - 12) + 7;
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = i - 2;
-	header->source_addr = 0xAB;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
 	header->rsvd = 0;
 	header->header_version = 1;
-	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	header->som = 0;
-	header->eom = 1;
-	header->tag_owner = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
 	header->msg_tag = 0x00;
-	header->packet_seq = 1;
+	header->packet_seq = 0;
 
-	memcpy (&rx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
-	rx_packet[1].data[i] = checksum_crc8 (0xBA, rx_packet[1].data, i);
-	rx_packet[1].pkt_size = i + 1;
-	rx_packet[1].state = CMD_VALID_PACKET;
-	rx_packet[1].dest_addr = 0x5D;
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
 
-	memset (&tx_packet, 0, sizeof (tx_packet));
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
 
-	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
+	i = msg_size - (255 - 12) + 7;
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 15;
+	header->byte_count = i - 2;
 	header->source_addr = 0xBB;
 	header->rsvd = 0;
 	header->header_version = 1;
 	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	header->som = 1;
+	header->som = 0;
 	header->eom = 1;
 	header->tag_owner = 0;
 	header->msg_tag = 0x00;
-	header->packet_seq = 0;
-
-	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	header->packet_seq = 1;
 
-	memcpy (&tx_packet.data[8], &pci_vid, sizeof (pci_vid));
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
 
-	tx_packet.data[10] = 0x00;
-	tx_packet.data[11] = 0x7F;
-	tx_packet.data[12] = 0x00;
-	tx_packet.data[13] = 0x00;
-	tx_packet.data[14] = 0x00;
-	tx_packet.data[15] = 0x00;
-	tx_packet.data[16] = 0x00;
-	tx_packet.data[17] = checksum_crc8 (0xAA, tx_packet.data, 17);
-	tx_packet.pkt_size = 18;
-	tx_packet.state = CMD_VALID_PACKET;
-	tx_packet.dest_addr = 0x55;
+	setup_mock_cmd_channel_scatter_gather_test (test, &channel, false);
 
-	error_packet.data = error_data;
-	error_packet.length = sizeof (error_data);
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	error->header.msg_type = 0x7E;
-	error->header.pci_vendor_id = 0x1414;
-	error->header.crypt = 0;
-	error->header.reserved2 = 0;
-	error->header.integrity_check = 0;
-	error->header.reserved1 = 0;
-	error->header.rq = 0;
-	error->header.command = 0x7F;
-	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
-	error->error_data = 0;
-
-	setup_mock_cmd_channel_test (test, &channel);
-
-	request.data = data;
-	request.length = sizeof (data);
-	request.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	request.data[1] = 0;
-	request.data[2] = 0;
-	request.data[3] = 0;
-	memcpy (&request.data[4], payload, request.length);
-	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	request.crypto_timeout = false;
-	request.channel_id = 0;
-	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
-
-	memset (&response, 0, sizeof (response));
-	response.data = data;
-
-	status = mock_expect (&channel.test.mock, channel.test.base.receive_packet, &channel.test, 0,
-		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
-	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet[0],
-		sizeof (struct cmd_packet), -1);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = mock_validate (&channel.test.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = mock_validate (&channel.cmd_cerberus.mock);
-	CuAssertIntEquals (test, 0, status);
+	response.data = response_data;
+	response.length = sizeof (response_data);
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	memcpy (&response.data[4], payload, msg_size);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
 
 	status = mock_expect (&channel.test.mock, channel.test.base.receive_packet, &channel.test, 0,
 		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
-	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet[1],
-		sizeof (struct cmd_packet), -1);
+	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet, sizeof (rx_packet), -1);
 
 	status |= mock_expect (&channel.cmd_cerberus.mock, channel.cmd_cerberus.base.process_request,
 		&channel.cmd_cerberus, 0,
@@ -740,14 +774,12 @@ static void cmd_channel_test_receive_and_process_multi_packet_message (CuTest *t
 			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
 	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	status |= mock_expect (&channel.cmd_cerberus.mock,
-		channel.cmd_cerberus.base.generate_error_packet, &channel.cmd_cerberus, 0,
-		MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR), MOCK_ARG (0), MOCK_ARG (0));
-	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &error_packet,
-		sizeof (error_packet), -1);
-
 	status |= mock_expect (&channel.test.mock, channel.test.base.send_packet, &channel.test, 0,
-		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+			sizeof (struct cmd_packet)));
+	status |= mock_expect (&channel.test.mock, channel.test.base.send_packet, &channel.test, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
+			sizeof (struct cmd_packet)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -757,20 +789,34 @@ static void cmd_channel_test_receive_and_process_multi_packet_message (CuTest *t
 	complete_mock_cmd_channel_test (test, &channel);
 }
 
-static void cmd_channel_test_receive_and_process_request_processing_timeout (CuTest *test)
+static void cmd_channel_test_receive_and_process_max_response (CuTest *test)
 {
 	struct cmd_channel_testing channel;
-	int status;
 	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet[MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE];
 	uint8_t data[10];
 	struct cmd_interface_msg request;
-	uint8_t response_data[6];
 	struct cmd_interface_msg response;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+	uint8_t payload[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	int status;
+	size_t i;
+	size_t remain = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY -
+		(MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT *
+		(MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1));
+	size_t last_pkt_len = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
 
 	TEST_START;
 
+	payload[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	payload[1] = 0;
+	payload[2] = 0;
+	payload[3] = 0;
+	for (i = 4; i < sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
 	memset (&rx_packet, 0, sizeof (rx_packet));
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
@@ -800,8 +846,34 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout (CuT
 	rx_packet.pkt_size = 18;
 	rx_packet.state = CMD_VALID_PACKET;
 	rx_packet.dest_addr = 0x5D;
-	rx_packet.timeout_valid = true;
-	platform_init_timeout (10, &rx_packet.pkt_timeout);
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
+		uint8_t len = (i == (MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1)) ?
+			last_pkt_len : MCTP_BASE_PROTOCOL_MAX_PACKET_LEN;
+
+		header = (struct mctp_base_protocol_transport_header*) tx_packet[i].data;
+
+		header->cmd_code = SMBUS_CMD_CODE_MCTP;
+		header->byte_count = len - 3;
+		header->source_addr = 0xBB;
+		header->rsvd = 0;
+		header->header_version = 1;
+		header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+		header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+		header->som = !i;
+		header->eom = (len == last_pkt_len);
+		header->tag_owner = 0;
+		header->msg_tag = 0x00;
+		header->packet_seq = i % 4;
+
+		memcpy (&tx_packet[i].data[7], &payload[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT], len);
+		tx_packet[i].data[len - 1] = checksum_crc8 (0xAA, tx_packet[i].data, len - 1);
+		tx_packet[i].pkt_size = len;
+		tx_packet[i].state = CMD_VALID_PACKET;
+		tx_packet[i].dest_addr = 0x55;
+	}
 
 	setup_mock_cmd_channel_test (test, &channel);
 
@@ -814,14 +886,8 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout (CuT
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	response.data = response_data;
-	response.length = sizeof (response_data);
-	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	response.data[1] = 0;
-	response.data[2] = 0;
-	response.data[3] = 0;
-	response.data[4] = 0x0B;
-	response.data[5] = 0x0A;
+	response.data = payload;
+	response.length = sizeof (payload);
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	response.crypto_timeout = false;
@@ -836,10 +902,13 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout (CuT
 			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
 	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	CuAssertIntEquals (test, 0, status);
+	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
+		status |= mock_expect (&channel.test.mock, channel.test.base.send_packet, &channel.test, 0,
+			MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[i],
+				sizeof (struct cmd_packet)));
+	}
 
-	platform_msleep (20);
-	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx_packet.pkt_timeout));
+	CuAssertIntEquals (test, 0, status);
 
 	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
 	CuAssertIntEquals (test, 0, status);
@@ -847,59 +916,85 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout (CuT
 	complete_mock_cmd_channel_test (test, &channel);
 }
 
-static void cmd_channel_test_receive_and_process_request_processing_timeout_not_valid (CuTest *test)
+static void cmd_channel_test_receive_and_process_multi_packet_message (CuTest *test)
 {
 	struct cmd_channel_testing channel;
-	int status;
-	struct cmd_packet rx_packet;
+	struct cmd_packet rx_packet[2];
 	struct cmd_packet tx_packet;
-	uint8_t data[10];
+	const int msg_size = 300;
+	uint8_t data[msg_size + 4];
 	struct cmd_interface_msg request;
-	uint8_t response_data[6];
 	struct cmd_interface_msg response;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+		(struct mctp_base_protocol_transport_header*) rx_packet[0].data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	uint16_t pci_vid = 0x1414;
+	uint8_t payload[msg_size];
+	int status;
+	int i;
 
 	TEST_START;
 
+	for (i = 0; i < (int) sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
 	memset (&rx_packet, 0, sizeof (rx_packet));
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 15;
+	header->byte_count = 252;
 	header->source_addr = 0xAB;
 	header->rsvd = 0;
 	header->header_version = 1;
 	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
-	header->eom = 1;
+	header->eom = 0;
 	header->tag_owner = 1;
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	rx_packet.data[8] = 0x00;
-	rx_packet.data[9] = 0x00;
-	rx_packet.data[10] = 0x00;
-	rx_packet.data[11] = 0x0B;
-	rx_packet.data[12] = 0x0A;
-	rx_packet.data[13] = 0x01;
-	rx_packet.data[14] = 0x02;
-	rx_packet.data[15] = 0x03;
-	rx_packet.data[16] = 0x04;
-	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
-	rx_packet.pkt_size = 18;
-	rx_packet.state = CMD_VALID_PACKET;
-	rx_packet.dest_addr = 0x5D;
-	rx_packet.timeout_valid = false;
-	platform_init_timeout (10, &rx_packet.pkt_timeout);
+	rx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet[0].data[8] = 0x00;
+	rx_packet[0].data[9] = 0x00;
+	rx_packet[0].data[10] = 0x00;
+	memcpy (&rx_packet[0].data[11], payload, 255 - 12);
+	rx_packet[0].data[254] = checksum_crc8 (0xBA, rx_packet[0].data, 254);
+	rx_packet[0].pkt_size = 255;
+	rx_packet[0].state = CMD_VALID_PACKET;
+	rx_packet[0].dest_addr = 0x5D;
+
+	header = (struct mctp_base_protocol_transport_header*) rx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&rx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	rx_packet[1].data[i] = checksum_crc8 (0xBA, rx_packet[1].data, i);
+	rx_packet[1].pkt_size = i + 1;
+	rx_packet[1].state = CMD_VALID_PACKET;
+	rx_packet[1].dest_addr = 0x5D;
 
 	memset (&tx_packet, 0, sizeof (tx_packet));
 
 	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 11;
+	header->byte_count = 15;
 	header->source_addr = 0xBB;
 	header->rsvd = 0;
 	header->header_version = 1;
@@ -912,34 +1007,280 @@ static void cmd_channel_test_receive_and_process_request_processing_timeout_not_
 	header->packet_seq = 0;
 
 	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	tx_packet.data[8] = 0x00;
-	tx_packet.data[9] = 0x00;
+
+	memcpy (&tx_packet.data[8], &pci_vid, sizeof (pci_vid));
+
 	tx_packet.data[10] = 0x00;
-	tx_packet.data[11] = 0x0B;
-	tx_packet.data[12] = 0x0A;
-	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
-	tx_packet.pkt_size = 14;
+	tx_packet.data[11] = 0x7F;
+	tx_packet.data[12] = 0x00;
+	tx_packet.data[13] = 0x00;
+	tx_packet.data[14] = 0x00;
+	tx_packet.data[15] = 0x00;
+	tx_packet.data[16] = 0x00;
+	tx_packet.data[17] = checksum_crc8 (0xAA, tx_packet.data, 17);
+	tx_packet.pkt_size = 18;
 	tx_packet.state = CMD_VALID_PACKET;
 	tx_packet.dest_addr = 0x55;
 
+	error_packet.data = error_data;
+	error_packet.length = sizeof (error_data);
+
+	error->header.msg_type = 0x7E;
+	error->header.pci_vendor_id = 0x1414;
+	error->header.crypt = 0;
+	error->header.reserved2 = 0;
+	error->header.integrity_check = 0;
+	error->header.reserved1 = 0;
+	error->header.rq = 0;
+	error->header.command = 0x7F;
+	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
+	error->error_data = 0;
+
 	setup_mock_cmd_channel_test (test, &channel);
 
 	request.data = data;
 	request.length = sizeof (data);
-	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	request.data[1] = 0;
+	request.data[2] = 0;
+	request.data[3] = 0;
+	memcpy (&request.data[4], payload, request.length);
 	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	request.crypto_timeout = false;
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	response.data = response_data;
-	response.length = sizeof (response_data);
-	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	response.data[1] = 0;
-	response.data[2] = 0;
-	response.data[3] = 0;
-	response.data[4] = 0x0B;
+	memset (&response, 0, sizeof (response));
+	response.data = data;
+
+	status = mock_expect (&channel.test.mock, channel.test.base.receive_packet, &channel.test, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
+	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet[0],
+		sizeof (struct cmd_packet), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&channel.test.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&channel.cmd_cerberus.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.test.mock, channel.test.base.receive_packet, &channel.test, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
+	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet[1],
+		sizeof (struct cmd_packet), -1);
+
+	status |= mock_expect (&channel.cmd_cerberus.mock, channel.cmd_cerberus.base.process_request,
+		&channel.cmd_cerberus, 0,
+		MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request, &request,
+			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
+	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+
+	status |= mock_expect (&channel.cmd_cerberus.mock,
+		channel.cmd_cerberus.base.generate_error_packet, &channel.cmd_cerberus, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR), MOCK_ARG (0), MOCK_ARG (0));
+	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &error_packet,
+		sizeof (error_packet), -1);
+
+	status |= mock_expect (&channel.test.mock, channel.test.base.send_packet, &channel.test, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mock_cmd_channel_test (test, &channel);
+}
+
+static void cmd_channel_test_receive_and_process_request_processing_timeout (CuTest *test)
+{
+	struct cmd_channel_testing channel;
+	int status;
+	struct cmd_packet rx_packet;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	uint8_t response_data[6];
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+
+	TEST_START;
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = 0x0B;
+	rx_packet.data[12] = 0x0A;
+	rx_packet.data[13] = 0x01;
+	rx_packet.data[14] = 0x02;
+	rx_packet.data[15] = 0x03;
+	rx_packet.data[16] = 0x04;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.state = CMD_VALID_PACKET;
+	rx_packet.dest_addr = 0x5D;
+	rx_packet.timeout_valid = true;
+	platform_init_timeout (10, &rx_packet.pkt_timeout);
+
+	setup_mock_cmd_channel_test (test, &channel);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	response.data = response_data;
+	response.length = sizeof (response_data);
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	response.data[4] = 0x0B;
+	response.data[5] = 0x0A;
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&channel.test.mock, channel.test.base.receive_packet, &channel.test, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
+	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet, sizeof (rx_packet), -1);
+
+	status |= mock_expect (&channel.cmd_cerberus.mock, channel.cmd_cerberus.base.process_request,
+		&channel.cmd_cerberus, 0,
+		MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request, &request,
+			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
+	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	platform_msleep (20);
+	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx_packet.pkt_timeout));
+
+	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mock_cmd_channel_test (test, &channel);
+}
+
+static void cmd_channel_test_receive_and_process_request_processing_timeout_not_valid (CuTest *test)
+{
+	struct cmd_channel_testing channel;
+	int status;
+	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	uint8_t response_data[6];
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+
+	TEST_START;
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = 0x0B;
+	rx_packet.data[12] = 0x0A;
+	rx_packet.data[13] = 0x01;
+	rx_packet.data[14] = 0x02;
+	rx_packet.data[15] = 0x03;
+	rx_packet.data[16] = 0x04;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.state = CMD_VALID_PACKET;
+	rx_packet.dest_addr = 0x5D;
+	rx_packet.timeout_valid = false;
+	platform_init_timeout (10, &rx_packet.pkt_timeout);
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet.data[8] = 0x00;
+	tx_packet.data[9] = 0x00;
+	tx_packet.data[10] = 0x00;
+	tx_packet.data[11] = 0x0B;
+	tx_packet.data[12] = 0x0A;
+	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x55;
+
+	setup_mock_cmd_channel_test (test, &channel);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	response.data = response_data;
+	response.length = sizeof (response_data);
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	response.data[4] = 0x0B;
 	response.data[5] = 0x0A;
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
@@ -1543,20 +1884,20 @@ static void cmd_channel_test_receive_and_process_send_failure (CuTest *test)
 	complete_mock_cmd_channel_test (test, &channel);
 }
 
-static void cmd_channel_test_receive_and_process_mctp_fatal_error (CuTest *test)
+static void cmd_channel_test_receive_and_process_scatter_gather_send_failure (CuTest *test)
 {
 	struct cmd_channel_testing channel;
-	int status;
-	struct cmd_packet rx_packet[3];
-	struct cmd_packet tx_packet;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
-	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx_packet[0].data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet[2];
+	uint8_t data[10];
+	struct cmd_interface_msg request;
 	const int msg_size = 300;
-	uint16_t pci_vid = 0x1414;
+	uint8_t response_data[msg_size + 4];
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx_packet.data;
 	uint8_t payload[msg_size];
+	int status;
 	int i;
 
 	TEST_START;
@@ -1568,21 +1909,167 @@ static void cmd_channel_test_receive_and_process_mctp_fatal_error (CuTest *test)
 	memset (&rx_packet, 0, sizeof (rx_packet));
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 252;
+	header->byte_count = 15;
 	header->source_addr = 0xAB;
 	header->rsvd = 0;
 	header->header_version = 1;
 	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
-	header->eom = 0;
+	header->eom = 1;
 	header->tag_owner = 1;
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	rx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	rx_packet[0].data[8] = 0x00;
-	rx_packet[0].data[9] = 0x00;
+	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x00;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = 0x0B;
+	rx_packet.data[12] = 0x0A;
+	rx_packet.data[13] = 0x01;
+	rx_packet.data[14] = 0x02;
+	rx_packet.data[15] = 0x03;
+	rx_packet.data[16] = 0x04;
+	rx_packet.data[17] = checksum_crc8 (0xBA, rx_packet.data, 17);
+	rx_packet.pkt_size = 18;
+	rx_packet.state = CMD_VALID_PACKET;
+	rx_packet.dest_addr = 0x5D;
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+
+	setup_mock_cmd_channel_scatter_gather_test (test, &channel, true);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx_packet.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	response.data = response_data;
+	response.length = sizeof (response_data);
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0;
+	response.data[2] = 0;
+	response.data[3] = 0;
+	memcpy (&response.data[4], payload, msg_size);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+
+	status = mock_expect (&channel.test.mock, channel.test.base.receive_packet, &channel.test, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (-1));
+	status |= mock_expect_output (&channel.test.mock, 0, &rx_packet, sizeof (rx_packet), -1);
+
+	status |= mock_expect (&channel.cmd_cerberus.mock, channel.cmd_cerberus.base.process_request,
+		&channel.cmd_cerberus, 0,
+		MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request, &request,
+			sizeof (request), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
+	status |= mock_expect_output (&channel.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+
+	status |= mock_expect (&channel.test.mock, channel.test.base.send_packet_sg, &channel.test,
+		CMD_CHANNEL_TX_FAILED, MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg,
+			&tx_packet[0], sizeof (struct cmd_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
+
+	complete_mock_cmd_channel_test (test, &channel);
+}
+
+static void cmd_channel_test_receive_and_process_mctp_fatal_error (CuTest *test)
+{
+	struct cmd_channel_testing channel;
+	int status;
+	struct cmd_packet rx_packet[3];
+	struct cmd_packet tx_packet;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx_packet[0].data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	const int msg_size = 300;
+	uint16_t pci_vid = 0x1414;
+	uint8_t payload[msg_size];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 1;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx_packet[0].data[8] = 0x00;
+	rx_packet[0].data[9] = 0x00;
 	rx_packet[0].data[10] = 0x00;
 	memcpy (&rx_packet[0].data[11], payload, 255 - 12);
 	rx_packet[0].data[254] = checksum_crc8 (0xBA, rx_packet[0].data, 254);
@@ -2583,17 +3070,537 @@ static void cmd_channel_test_receive_and_process_multiple_overflow_packet (CuTes
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
-	CuAssertIntEquals (test, 0, status);
+	status = cmd_channel_receive_and_process (&channel.test.base, &channel.mctp, -1);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mock_cmd_channel_test (test, &channel);
+}
+
+static void cmd_channel_test_send_message_single_packet (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet;
+	struct cmd_message tx_message;
+	struct mctp_base_protocol_transport_header *header;
+	int status;
+
+	TEST_START;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet.data[8] = 0x00;
+	tx_packet.data[9] = 0x00;
+	tx_packet.data[10] = 0x00;
+	tx_packet.data[11] = 0x0B;
+	tx_packet.data[12] = 0x0A;
+	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x55;
+	tx_packet.timeout_valid = false;
+
+	tx_message.data = tx_packet.data;
+	tx_message.msg_size = tx_packet.pkt_size;
+	tx_message.pkt_size = tx_packet.pkt_size;
+	tx_message.dest_addr = tx_packet.dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_multiple_packets (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet[2];
+	struct cmd_message tx_message;
+	const int msg_size = 300;
+	uint8_t msg_data[msg_size + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * 2) + 4];
+	struct mctp_base_protocol_transport_header *header;
+	uint8_t payload[msg_size];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
+	tx_packet[0].timeout_valid = false;
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+	tx_packet[1].timeout_valid = false;
+
+	memcpy (msg_data, tx_packet[0].data, tx_packet[0].pkt_size);
+	memcpy (&msg_data[tx_packet[0].pkt_size], tx_packet[1].data, tx_packet[1].pkt_size);
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = sizeof (msg_data);
+	tx_message.pkt_size = tx_packet[0].pkt_size;
+	tx_message.dest_addr = tx_packet[0].dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+			sizeof (struct cmd_packet)));
+	status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
+			sizeof (struct cmd_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_multiple_messages (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet[2];
+	struct cmd_message tx_message[2];
+	const int msg_size = 300;
+	struct mctp_base_protocol_transport_header *header;
+	uint8_t payload[msg_size];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
+	tx_packet[0].timeout_valid = false;
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+	tx_packet[1].timeout_valid = false;
+
+	tx_message[0].data = tx_packet[0].data;
+	tx_message[0].msg_size = tx_packet[0].pkt_size;
+	tx_message[0].pkt_size = tx_packet[0].pkt_size;
+	tx_message[0].dest_addr = tx_packet[0].dest_addr;
+
+	tx_message[1].data = tx_packet[1].data;
+	tx_message[1].msg_size = tx_packet[1].pkt_size;
+	tx_message[1].pkt_size = tx_packet[1].pkt_size;
+	tx_message[1].dest_addr = tx_packet[1].dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+			sizeof (struct cmd_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&channel.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
+			sizeof (struct cmd_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_max_message (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet[MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE];
+	struct cmd_message tx_message;
+	struct mctp_base_protocol_transport_header *header;
+	uint8_t payload[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	uint8_t msg_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY +
+		(MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE)];
+	int status;
+	size_t i;
+	size_t remain = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY -
+		(MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT *
+		(MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1));
+	size_t last_pkt_len = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+
+	TEST_START;
+
+	payload[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	payload[1] = 0;
+	payload[2] = 0;
+	payload[3] = 0;
+	for (i = 4; i < sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
+		uint8_t len = (i == (MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1)) ?
+			last_pkt_len : MCTP_BASE_PROTOCOL_MAX_PACKET_LEN;
+
+		header = (struct mctp_base_protocol_transport_header*) tx_packet[i].data;
+
+		header->cmd_code = SMBUS_CMD_CODE_MCTP;
+		header->byte_count = len - 3;
+		header->source_addr = 0xBB;
+		header->rsvd = 0;
+		header->header_version = 1;
+		header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+		header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+		header->som = !i;
+		header->eom = (len == last_pkt_len);
+		header->tag_owner = 0;
+		header->msg_tag = 0x00;
+		header->packet_seq = i % 4;
+
+		memcpy (&tx_packet[i].data[7], &payload[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT], len);
+		tx_packet[i].data[len - 1] = checksum_crc8 (0xAA, tx_packet[i].data, len - 1);
+		tx_packet[i].pkt_size = len;
+		tx_packet[i].state = CMD_VALID_PACKET;
+		tx_packet[i].dest_addr = 0x55;
+		tx_packet[1].timeout_valid = false;
+
+		memcpy (&msg_data[i * MCTP_BASE_PROTOCOL_MAX_PACKET_LEN], tx_packet[i].data,
+			tx_packet[i].pkt_size);
+	}
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = sizeof (msg_data);
+	tx_message.pkt_size = tx_packet[0].pkt_size;
+	tx_message.dest_addr = tx_packet[0].dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
+		status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+			MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[i],
+				sizeof (struct cmd_packet)));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_null (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_message tx_message;
+	int status;
+
+	TEST_START;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (NULL, &tx_message);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_send_message (&channel.base, NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_send_failure (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet;
+	struct cmd_message tx_message;
+	struct mctp_base_protocol_transport_header *header;
+	int status;
+
+	TEST_START;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet.data[8] = 0x00;
+	tx_packet.data[9] = 0x00;
+	tx_packet.data[10] = 0x00;
+	tx_packet.data[11] = 0x0B;
+	tx_packet.data[12] = 0x0A;
+	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x55;
+	tx_packet.timeout_valid = false;
+
+	tx_message.data = tx_packet.data;
+	tx_message.msg_size = tx_packet.pkt_size;
+	tx_message.pkt_size = tx_packet.pkt_size;
+	tx_message.dest_addr = tx_packet.dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, CMD_CHANNEL_TX_FAILED,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_multiple_packets_send_failure (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet[2];
+	struct cmd_message tx_message;
+	const int msg_size = 300;
+	uint8_t msg_data[msg_size + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * 2) + 4];
+	struct mctp_base_protocol_transport_header *header;
+	uint8_t payload[msg_size];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (payload); i++) {
+		payload[i] = i;
+	}
+
+	memset (tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[0].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 252;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet[0].data[8] = 0x00;
+	tx_packet[0].data[9] = 0x00;
+	tx_packet[0].data[10] = 0x00;
+	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
+	tx_packet[0].pkt_size = 255;
+	tx_packet[0].state = CMD_VALID_PACKET;
+	tx_packet[0].dest_addr = 0x55;
+	tx_packet[0].timeout_valid = false;
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
+
+	i = msg_size - (255 - 12) + 7;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = i - 2;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 1;
+
+	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
+	tx_packet[1].pkt_size = i + 1;
+	tx_packet[1].state = CMD_VALID_PACKET;
+	tx_packet[1].dest_addr = 0x55;
+	tx_packet[1].timeout_valid = false;
+
+	memcpy (msg_data, tx_packet[0].data, tx_packet[0].pkt_size);
+	memcpy (&msg_data[tx_packet[0].pkt_size], tx_packet[1].data, tx_packet[1].pkt_size);
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = sizeof (msg_data);
+	tx_message.pkt_size = tx_packet[0].pkt_size;
+	tx_message.dest_addr = tx_packet[0].dest_addr;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, CMD_CHANNEL_TX_FAILED,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+			sizeof (struct cmd_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
 
-	complete_mock_cmd_channel_test (test, &channel);
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void cmd_channel_test_send_message_single_packet (CuTest *test)
+
+static void cmd_channel_test_send_message_sg_single_packet (CuTest *test)
 {
 	struct cmd_channel_mock channel;
 	struct cmd_packet tx_packet;
-	struct cmd_message tx_message;
+	struct cmd_packet_sg tx_sg;
+	struct cmd_message_sg tx_message;
 	struct mctp_base_protocol_transport_header *header;
 	int status;
 
@@ -2628,33 +3635,40 @@ static void cmd_channel_test_send_message_single_packet (CuTest *test)
 	tx_packet.dest_addr = 0x55;
 	tx_packet.timeout_valid = false;
 
-	tx_message.data = tx_packet.data;
-	tx_message.msg_size = tx_packet.pkt_size;
-	tx_message.pkt_size = tx_packet.pkt_size;
-	tx_message.dest_addr = tx_packet.dest_addr;
+	memcpy (tx_sg.header, tx_packet.data, 7);
+	tx_sg.header_len = 7;
+	tx_sg.payload = &tx_packet.data[7];
+	tx_sg.payload_len = 6;
+	tx_sg.trailer[0] = tx_packet.data[13];
+	tx_sg.trailer_len = 1;
+	tx_sg.dest_addr = tx_packet.dest_addr;
 
-	status = cmd_channel_mock_init (&channel, 0);
+	tx_message.packets = &tx_sg;
+	tx_message.num_packets = 1;
+
+	status = cmd_channel_mock_init_scatter_gather (&channel, 0);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
-		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+	status = mock_expect (&channel.mock, channel.base.send_packet_sg, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg, &tx_packet,
+			sizeof (struct cmd_packet)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = cmd_channel_send_message (&channel.base, &tx_message);
+	status = cmd_channel_send_message_sg (&channel.base, &tx_message);
 	CuAssertIntEquals (test, 0, status);
 
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void cmd_channel_test_send_message_multiple_packets (CuTest *test)
+static void cmd_channel_test_send_message_sg_multiple_packets (CuTest *test)
 {
 	struct cmd_channel_mock channel;
 	struct cmd_packet tx_packet[2];
-	struct cmd_message tx_message;
+	struct cmd_packet_sg tx_sg[2];
+	struct cmd_message_sg tx_message;
 	const int msg_size = 300;
-	uint8_t msg_data[msg_size + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * 2) + 4];
 	struct mctp_base_protocol_transport_header *header;
 	uint8_t payload[msg_size];
 	int status;
@@ -2683,11 +3697,7 @@ static void cmd_channel_test_send_message_multiple_packets (CuTest *test)
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	tx_packet[0].data[8] = 0x00;
-	tx_packet[0].data[9] = 0x00;
-	tx_packet[0].data[10] = 0x00;
-	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	memcpy (&tx_packet[0].data[7], payload, 255 - 8);
 	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
 	tx_packet[0].pkt_size = 255;
 	tx_packet[0].state = CMD_VALID_PACKET;
@@ -2696,7 +3706,7 @@ static void cmd_channel_test_send_message_multiple_packets (CuTest *test)
 
 	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
 
-	i = msg_size - (255 - 12) + 7;
+	i = msg_size - (255 - 8) + 7;
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
 	header->byte_count = i - 2;
@@ -2711,45 +3721,57 @@ static void cmd_channel_test_send_message_multiple_packets (CuTest *test)
 	header->msg_tag = 0x00;
 	header->packet_seq = 1;
 
-	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	memcpy (&tx_packet[1].data[7], &payload[255 - 8], msg_size - (255 - 8));
 	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
 	tx_packet[1].pkt_size = i + 1;
 	tx_packet[1].state = CMD_VALID_PACKET;
 	tx_packet[1].dest_addr = 0x55;
 	tx_packet[1].timeout_valid = false;
 
-	memcpy (msg_data, tx_packet[0].data, tx_packet[0].pkt_size);
-	memcpy (&msg_data[tx_packet[0].pkt_size], tx_packet[1].data, tx_packet[1].pkt_size);
-
-	tx_message.data = msg_data;
-	tx_message.msg_size = sizeof (msg_data);
-	tx_message.pkt_size = tx_packet[0].pkt_size;
-	tx_message.dest_addr = tx_packet[0].dest_addr;
-
-	status = cmd_channel_mock_init (&channel, 0);
+	memcpy (tx_sg[0].header, tx_packet[0].data, 7);
+	tx_sg[0].header_len = 7;
+	tx_sg[0].payload = payload;
+	tx_sg[0].payload_len = 255 - 8;
+	tx_sg[0].trailer[0] = tx_packet[0].data[254];
+	tx_sg[0].trailer_len = 1;
+	tx_sg[0].dest_addr = tx_packet[0].dest_addr;
+
+	memcpy (tx_sg[1].header, tx_packet[1].data, 7);
+	tx_sg[1].header_len = 7;
+	tx_sg[1].payload = &payload[255 - 8];
+	tx_sg[1].payload_len = msg_size - (255 - 8);
+	tx_sg[1].trailer[0] = tx_packet[1].data[i];
+	tx_sg[1].trailer_len = 1;
+	tx_sg[1].dest_addr = tx_packet[1].dest_addr;
+
+	tx_message.packets = tx_sg;
+	tx_message.num_packets = 2;
+
+	status = cmd_channel_mock_init_scatter_gather (&channel, 0);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
-		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+	status = mock_expect (&channel.mock, channel.base.send_packet_sg, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg, &tx_packet[0],
 			sizeof (struct cmd_packet)));
-	status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
-		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
+	status |= mock_expect (&channel.mock, channel.base.send_packet_sg, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg, &tx_packet[1],
 			sizeof (struct cmd_packet)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = cmd_channel_send_message (&channel.base, &tx_message);
+	status = cmd_channel_send_message_sg (&channel.base, &tx_message);
 	CuAssertIntEquals (test, 0, status);
 
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void cmd_channel_test_send_message_multiple_messages (CuTest *test)
+static void cmd_channel_test_send_message_sg_channel_no_support (CuTest *test)
 {
 	struct cmd_channel_mock channel;
 	struct cmd_packet tx_packet[2];
-	struct cmd_message tx_message[2];
+	struct cmd_packet_sg tx_sg[2];
+	struct cmd_message_sg tx_message;
 	const int msg_size = 300;
 	struct mctp_base_protocol_transport_header *header;
 	uint8_t payload[msg_size];
@@ -2779,11 +3801,7 @@ static void cmd_channel_test_send_message_multiple_messages (CuTest *test)
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	tx_packet[0].data[8] = 0x00;
-	tx_packet[0].data[9] = 0x00;
-	tx_packet[0].data[10] = 0x00;
-	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	memcpy (&tx_packet[0].data[7], payload, 255 - 8);
 	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
 	tx_packet[0].pkt_size = 255;
 	tx_packet[0].state = CMD_VALID_PACKET;
@@ -2792,7 +3810,7 @@ static void cmd_channel_test_send_message_multiple_messages (CuTest *test)
 
 	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
 
-	i = msg_size - (255 - 12) + 7;
+	i = msg_size - (255 - 8) + 7;
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
 	header->byte_count = i - 2;
@@ -2807,22 +3825,31 @@ static void cmd_channel_test_send_message_multiple_messages (CuTest *test)
 	header->msg_tag = 0x00;
 	header->packet_seq = 1;
 
-	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	memcpy (&tx_packet[1].data[7], &payload[255 - 8], msg_size - (255 - 8));
 	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
 	tx_packet[1].pkt_size = i + 1;
 	tx_packet[1].state = CMD_VALID_PACKET;
 	tx_packet[1].dest_addr = 0x55;
 	tx_packet[1].timeout_valid = false;
 
-	tx_message[0].data = tx_packet[0].data;
-	tx_message[0].msg_size = tx_packet[0].pkt_size;
-	tx_message[0].pkt_size = tx_packet[0].pkt_size;
-	tx_message[0].dest_addr = tx_packet[0].dest_addr;
-
-	tx_message[1].data = tx_packet[1].data;
-	tx_message[1].msg_size = tx_packet[1].pkt_size;
-	tx_message[1].pkt_size = tx_packet[1].pkt_size;
-	tx_message[1].dest_addr = tx_packet[1].dest_addr;
+	memcpy (tx_sg[0].header, tx_packet[0].data, 7);
+	tx_sg[0].header_len = 7;
+	tx_sg[0].payload = payload;
+	tx_sg[0].payload_len = 255 - 8;
+	tx_sg[0].trailer[0] = tx_packet[0].data[254];
+	tx_sg[0].trailer_len = 1;
+	tx_sg[0].dest_addr = tx_packet[0].dest_addr;
+
+	memcpy (tx_sg[1].header, tx_packet[1].data, 7);
+	tx_sg[1].header_len = 7;
+	tx_sg[1].payload = &payload[255 - 8];
+	tx_sg[1].payload_len = msg_size - (255 - 8);
+	tx_sg[1].trailer[0] = tx_packet[1].data[i];
+	tx_sg[1].trailer_len = 1;
+	tx_sg[1].dest_addr = tx_packet[1].dest_addr;
+
+	tx_message.packets = tx_sg;
+	tx_message.num_packets = 2;
 
 	status = cmd_channel_mock_init (&channel, 0);
 	CuAssertIntEquals (test, 0, status);
@@ -2830,135 +3857,46 @@ static void cmd_channel_test_send_message_multiple_messages (CuTest *test)
 	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
 		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
 			sizeof (struct cmd_packet)));
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = cmd_channel_send_message (&channel.base, &tx_message[0]);
-	CuAssertIntEquals (test, 0, status);
-
-	status = mock_validate (&channel.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+	status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
 		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
 			sizeof (struct cmd_packet)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = cmd_channel_send_message (&channel.base, &tx_message[1]);
-	CuAssertIntEquals (test, 0, status);
-
-	status = cmd_channel_mock_validate_and_release (&channel);
-	CuAssertIntEquals (test, 0, status);
-}
-
-static void cmd_channel_test_send_message_max_message (CuTest *test)
-{
-	struct cmd_channel_mock channel;
-	struct cmd_packet tx_packet[MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE];
-	struct cmd_message tx_message;
-	struct mctp_base_protocol_transport_header *header;
-	uint8_t payload[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
-	uint8_t msg_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY +
-		(MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE)];
-	int status;
-	size_t i;
-	size_t remain = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY -
-		(MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT *
-		(MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1));
-	size_t last_pkt_len = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
-
-	TEST_START;
-
-	payload[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	payload[1] = 0;
-	payload[2] = 0;
-	payload[3] = 0;
-	for (i = 4; i < sizeof (payload); i++) {
-		payload[i] = i;
-	}
-
-	memset (tx_packet, 0, sizeof (tx_packet));
-
-	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
-		uint8_t len = (i == (MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE - 1)) ?
-			last_pkt_len : MCTP_BASE_PROTOCOL_MAX_PACKET_LEN;
-
-		header = (struct mctp_base_protocol_transport_header*) tx_packet[i].data;
-
-		header->cmd_code = SMBUS_CMD_CODE_MCTP;
-		header->byte_count = len - 3;
-		header->source_addr = 0xBB;
-		header->rsvd = 0;
-		header->header_version = 1;
-		header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-		header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-		header->som = !i;
-		header->eom = (len == last_pkt_len);
-		header->tag_owner = 0;
-		header->msg_tag = 0x00;
-		header->packet_seq = i % 4;
-
-		memcpy (&tx_packet[i].data[7], &payload[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT], len);
-		tx_packet[i].data[len - 1] = checksum_crc8 (0xAA, tx_packet[i].data, len - 1);
-		tx_packet[i].pkt_size = len;
-		tx_packet[i].state = CMD_VALID_PACKET;
-		tx_packet[i].dest_addr = 0x55;
-		tx_packet[1].timeout_valid = false;
-
-		memcpy (&msg_data[i * MCTP_BASE_PROTOCOL_MAX_PACKET_LEN], tx_packet[i].data,
-			tx_packet[i].pkt_size);
-	}
-
-	tx_message.data = msg_data;
-	tx_message.msg_size = sizeof (msg_data);
-	tx_message.pkt_size = tx_packet[0].pkt_size;
-	tx_message.dest_addr = tx_packet[0].dest_addr;
-
-	status = cmd_channel_mock_init (&channel, 0);
-	CuAssertIntEquals (test, 0, status);
-
-	for (i = 0; i < MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE; i++) {
-		status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
-			MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[i],
-				sizeof (struct cmd_packet)));
-	}
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = cmd_channel_send_message (&channel.base, &tx_message);
+	status = cmd_channel_send_message_sg (&channel.base, &tx_message);
 	CuAssertIntEquals (test, 0, status);
 
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void cmd_channel_test_send_message_null (CuTest *test)
+static void cmd_channel_test_send_message_sg_null (CuTest *test)
 {
 	struct cmd_channel_mock channel;
-	struct cmd_message tx_message;
+	struct cmd_message_sg tx_message;
 	int status;
 
 	TEST_START;
 
-	status = cmd_channel_mock_init (&channel, 0);
+	status = cmd_channel_mock_init_scatter_gather (&channel, 0);
 	CuAssertIntEquals (test, 0, status);
 
-	status = cmd_channel_send_message (NULL, &tx_message);
+	status = cmd_channel_send_message_sg (NULL, &tx_message);
 	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
 
-	status = cmd_channel_send_message (&channel.base, NULL);
+	status = cmd_channel_send_message_sg (&channel.base, NULL);
 	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
 
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void cmd_channel_test_send_message_send_failure (CuTest *test)
+static void cmd_channel_test_send_message_sg_send_failure (CuTest *test)
 {
 	struct cmd_channel_mock channel;
 	struct cmd_packet tx_packet;
-	struct cmd_message tx_message;
+	struct cmd_packet_sg tx_sg;
+	struct cmd_message_sg tx_message;
 	struct mctp_base_protocol_transport_header *header;
 	int status;
 
@@ -2993,33 +3931,40 @@ static void cmd_channel_test_send_message_send_failure (CuTest *test)
 	tx_packet.dest_addr = 0x55;
 	tx_packet.timeout_valid = false;
 
-	tx_message.data = tx_packet.data;
-	tx_message.msg_size = tx_packet.pkt_size;
-	tx_message.pkt_size = tx_packet.pkt_size;
-	tx_message.dest_addr = tx_packet.dest_addr;
+	memcpy (tx_sg.header, tx_packet.data, 7);
+	tx_sg.header_len = 7;
+	tx_sg.payload = &tx_packet.data[7];
+	tx_sg.payload_len = 6;
+	tx_sg.trailer[0] = tx_packet.data[13];
+	tx_sg.trailer_len = 1;
+	tx_sg.dest_addr = tx_packet.dest_addr;
 
-	status = cmd_channel_mock_init (&channel, 0);
+	tx_message.packets = &tx_sg;
+	tx_message.num_packets = 1;
+
+	status = cmd_channel_mock_init_scatter_gather (&channel, 0);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, CMD_CHANNEL_TX_FAILED,
-		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+	status = mock_expect (&channel.mock, channel.base.send_packet_sg, &channel,
+		CMD_CHANNEL_TX_FAILED, MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg, &tx_packet,
+			sizeof (struct cmd_packet)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = cmd_channel_send_message (&channel.base, &tx_message);
+	status = cmd_channel_send_message_sg (&channel.base, &tx_message);
 	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
 
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void cmd_channel_test_send_message_multiple_packets_send_failure (CuTest *test)
+static void cmd_channel_test_send_message_sg_multiple_packets_send_failure (CuTest *test)
 {
 	struct cmd_channel_mock channel;
 	struct cmd_packet tx_packet[2];
-	struct cmd_message tx_message;
+	struct cmd_packet_sg tx_sg[2];
+	struct cmd_message_sg tx_message;
 	const int msg_size = 300;
-	uint8_t msg_data[msg_size + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * 2) + 4];
 	struct mctp_base_protocol_transport_header *header;
 	uint8_t payload[msg_size];
 	int status;
@@ -3048,11 +3993,7 @@ static void cmd_channel_test_send_message_multiple_packets_send_failure (CuTest
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	tx_packet[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	tx_packet[0].data[8] = 0x00;
-	tx_packet[0].data[9] = 0x00;
-	tx_packet[0].data[10] = 0x00;
-	memcpy (&tx_packet[0].data[11], payload, 255 - 12);
+	memcpy (&tx_packet[0].data[7], payload, 255 - 8);
 	tx_packet[0].data[254] = checksum_crc8 (0xAA, tx_packet[0].data, 254);
 	tx_packet[0].pkt_size = 255;
 	tx_packet[0].state = CMD_VALID_PACKET;
@@ -3061,7 +4002,7 @@ static void cmd_channel_test_send_message_multiple_packets_send_failure (CuTest
 
 	header = (struct mctp_base_protocol_transport_header*) tx_packet[1].data;
 
-	i = msg_size - (255 - 12) + 7;
+	i = msg_size - (255 - 8) + 7;
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
 	header->byte_count = i - 2;
@@ -3076,37 +4017,147 @@ static void cmd_channel_test_send_message_multiple_packets_send_failure (CuTest
 	header->msg_tag = 0x00;
 	header->packet_seq = 1;
 
-	memcpy (&tx_packet[1].data[7], &payload[255 - 12], msg_size - (255 - 12));
+	memcpy (&tx_packet[1].data[7], &payload[255 - 8], msg_size - (255 - 8));
 	tx_packet[1].data[i] = checksum_crc8 (0xAA, tx_packet[1].data, i);
 	tx_packet[1].pkt_size = i + 1;
 	tx_packet[1].state = CMD_VALID_PACKET;
 	tx_packet[1].dest_addr = 0x55;
 	tx_packet[1].timeout_valid = false;
 
-	memcpy (msg_data, tx_packet[0].data, tx_packet[0].pkt_size);
-	memcpy (&msg_data[tx_packet[0].pkt_size], tx_packet[1].data, tx_packet[1].pkt_size);
+	memcpy (tx_sg[0].header, tx_packet[0].data, 7);
+	tx_sg[0].header_len = 7;
+	tx_sg[0].payload = payload;
+	tx_sg[0].payload_len = 255 - 8;
+	tx_sg[0].trailer[0] = tx_packet[0].data[254];
+	tx_sg[0].trailer_len = 1;
+	tx_sg[0].dest_addr = tx_packet[0].dest_addr;
+
+	memcpy (tx_sg[1].header, tx_packet[1].data, 7);
+	tx_sg[1].header_len = 7;
+	tx_sg[1].payload = &payload[255 - 8];
+	tx_sg[1].payload_len = msg_size - (255 - 8);
+	tx_sg[1].trailer[0] = tx_packet[1].data[i];
+	tx_sg[1].trailer_len = 1;
+	tx_sg[1].dest_addr = tx_packet[1].dest_addr;
+
+	tx_message.packets = tx_sg;
+	tx_message.num_packets = 2;
+
+	status = cmd_channel_mock_init_scatter_gather (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
 
-	tx_message.data = msg_data;
-	tx_message.msg_size = sizeof (msg_data);
-	tx_message.pkt_size = tx_packet[0].pkt_size;
-	tx_message.dest_addr = tx_packet[0].dest_addr;
+	status = mock_expect (&channel.mock, channel.base.send_packet_sg, &channel,
+		CMD_CHANNEL_TX_FAILED, MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet_sg,
+			&tx_packet[0], sizeof (struct cmd_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message_sg (&channel.base, &tx_message);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_sg_channel_no_support_send_failure (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet;
+	struct cmd_packet_sg tx_sg;
+	struct cmd_message_sg tx_message;
+	struct mctp_base_protocol_transport_header *header;
+	int status;
+
+	TEST_START;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet.data[8] = 0x00;
+	tx_packet.data[9] = 0x00;
+	tx_packet.data[10] = 0x00;
+	tx_packet.data[11] = 0x0B;
+	tx_packet.data[12] = 0x0A;
+	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x55;
+	tx_packet.timeout_valid = false;
+
+	memcpy (tx_sg.header, tx_packet.data, 7);
+	tx_sg.header_len = 7;
+	tx_sg.payload = &tx_packet.data[7];
+	tx_sg.payload_len = 6;
+	tx_sg.trailer[0] = tx_packet.data[13];
+	tx_sg.trailer_len = 1;
+	tx_sg.dest_addr = tx_packet.dest_addr;
+
+	tx_message.packets = &tx_sg;
+	tx_message.num_packets = 1;
 
 	status = cmd_channel_mock_init (&channel, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&channel.mock, channel.base.send_packet, &channel, CMD_CHANNEL_TX_FAILED,
-		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet,
 			sizeof (struct cmd_packet)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = cmd_channel_send_message (&channel.base, &tx_message);
+	status = cmd_channel_send_message_sg (&channel.base, &tx_message);
 	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
 
 	status = cmd_channel_mock_validate_and_release (&channel);
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void cmd_channel_test_send_message_sg_channel_no_support_packet_too_large (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet_sg tx_sg;
+	struct cmd_message_sg tx_message;
+	uint8_t payload[CMD_MAX_PACKET_SIZE];
+	int status;
+
+	TEST_START;
+
+	memset (&tx_sg, 0, sizeof (tx_sg));
+	memset (payload, 0, sizeof (payload));
+
+	tx_sg.header_len = 7;
+	tx_sg.payload = payload;
+	tx_sg.payload_len = sizeof (payload);
+	tx_sg.trailer_len = 1;
+	tx_sg.dest_addr = 0x55;
+
+	tx_message.packets = &tx_sg;
+	tx_message.num_packets = 1;
+
+	status = cmd_channel_mock_init (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message_sg (&channel.base, &tx_message);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_PKT_SIZE, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
 
 TEST_SUITE_START (cmd_channel);
 
@@ -3121,6 +4172,8 @@ TEST (cmd_channel_test_validate_packet_for_send_empty);
 TEST (cmd_channel_test_validate_packet_for_send_overflow);
 TEST (cmd_channel_test_receive_and_process_single_packet_response);
 TEST (cmd_channel_test_receive_and_process_multi_packet_response);
+TEST (cmd_channel_test_receive_and_process_scatter_gather);
+TEST (cmd_channel_test_receive_and_process_scatter_gather_channel_no_support);
 TEST (cmd_channel_test_receive_and_process_max_response);
 TEST (cmd_channel_test_receive_and_process_multi_packet_message);
 TEST (cmd_channel_test_receive_and_process_request_processing_timeout);
@@ -3132,6 +4185,7 @@ TEST (cmd_channel_test_receive_and_process_receive_failure);
 TEST (cmd_channel_test_receive_and_process_receive_timeout);
 TEST (cmd_channel_test_receive_and_process_mctp_fatal_error);
 TEST (cmd_channel_test_receive_and_process_send_failure);
+TEST (cmd_channel_test_receive_and_process_scatter_gather_send_failure);
 TEST (cmd_channel_test_receive_and_process_overflow_packet);
 TEST (cmd_channel_test_receive_and_process_multiple_overflow_packet);
 TEST (cmd_channel_test_send_message_single_packet);
@@ -3141,5 +4195,13 @@ TEST (cmd_channel_test_send_message_max_message);
 TEST (cmd_channel_test_send_message_null);
 TEST (cmd_channel_test_send_message_send_failure);
 TEST (cmd_channel_test_send_message_multiple_packets_send_failure);
+TEST (cmd_channel_test_send_message_sg_single_packet);
+TEST (cmd_channel_test_send_message_sg_multiple_packets);
+TEST (cmd_channel_test_send_message_sg_channel_no_support);
+TEST (cmd_channel_test_send_message_sg_null);
+TEST (cmd_channel_test_send_message_sg_send_failure);
+TEST (cmd_channel_test_send_message_sg_multiple_packets_send_failure);
+TEST (cmd_channel_test_send_message_sg_channel_no_support_send_failure);
+TEST (cmd_channel_test_send_message_sg_channel_no_support_packet_too_large);
 
 TEST_SUITE_END;
@@ -0,0 +1,978 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "cmd_interface/cmd_dispatch.h"
+#include "cmd_interface/cerberus_protocol.h"
+#include "mctp/mctp_interface.h"
+#include "mctp/mctp_base_protocol.h"
+#include "testing/mock/cmd_interface/cmd_interface_mock.h"
+#include "testing/mock/cmd_interface/cmd_channel_mock.h"
+
+
+TEST_SUITE_LABEL ("cmd_dispatch");
+
+
+/**
+ * Number of requests available to the dispatch queue for testing.
+ */
+#define	CMD_DISPATCH_TESTING_REQUESTS		2
+
+/**
+ * Address the test requests are received from.
+ */
+#define	CMD_DISPATCH_TESTING_RESPONSE_ADDR	0x55
+
+/**
+ * Address the test requests are received on.
+ */
+#define	CMD_DISPATCH_TESTING_SOURCE_ADDR	0x5D
+
+
+/**
+ * Command handler that executes a second request while processing the first one.  This simulates
+ * requests completing out of order on different workers.
+ */
+struct cmd_dispatch_testing_interface {
+	struct cmd_interface base;			/**< The base command interface. */
+	struct cmd_dispatch *dispatch;		/**< The dispatch queue to process nested requests. */
+	int calls;							/**< The number of requests that have been processed. */
+	int nested_status;					/**< Status of processing the nested request. */
+};
+
+/**
+ * Dependencies for testing the dispatch queue.
+ */
+struct cmd_dispatch_testing {
+	struct cmd_channel_mock channel;									/**< Command channel mock. */
+	struct cmd_interface_mock cmd_cerberus;								/**< Cerberus protocol handler mock. */
+	struct cmd_interface_mock cmd_mctp;									/**< MCTP control protocol handler mock. */
+	struct device_manager device_mgr;									/**< Device manager. */
+	struct mctp_interface mctp;											/**< MCTP layer for the channel. */
+	struct cmd_dispatch_request requests[CMD_DISPATCH_TESTING_REQUESTS];	/**< Dispatch requests. */
+	struct cmd_dispatch test;											/**< Dispatch queue under test. */
+};
+
+
+/**
+ * Process a request by returning the first byte of the request followed by the number of the
+ * call.  The first request will also process the next request in the queue before completing.
+ *
+ * @param intf The command handler.
+ * @param request The request to process.
+ *
+ * @return Status of processing the nested request.
+ */
+static int cmd_dispatch_testing_process_request (struct cmd_interface *intf,
+	struct cmd_interface_msg *request)
+{
+	struct cmd_dispatch_testing_interface *handler = (struct cmd_dispatch_testing_interface*) intf;
+	int call = ++handler->calls;
+
+	if (call == 1) {
+		handler->nested_status = cmd_dispatch_process_next (handler->dispatch);
+	}
+
+	request->length = 2;
+	request->data[1] = call;
+
+	return 0;
+}
+
+/**
+ * Initialize the dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param dispatch The testing components to initialize.
+ */
+static void cmd_dispatch_testing_init_dependencies (CuTest *test,
+	struct cmd_dispatch_testing *dispatch)
+{
+	int status;
+
+	status = device_manager_init (&dispatch->device_mgr, 2, 0, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE, 1000, 1000, 1000, 0, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&dispatch->device_mgr, 0,
+		MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, CMD_DISPATCH_TESTING_SOURCE_ADDR,
+		DEVICE_MANAGER_NOT_PCD_COMPONENT);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&dispatch->device_mgr, 1,
+		MCTP_BASE_PROTOCOL_BMC_EID, CMD_DISPATCH_TESTING_RESPONSE_ADDR,
+		DEVICE_MANAGER_NOT_PCD_COMPONENT);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&dispatch->cmd_cerberus);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_init (&dispatch->cmd_mctp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_init (&dispatch->channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&dispatch->mctp, &dispatch->cmd_cerberus.base,
+		&dispatch->cmd_mctp.base, NULL, &dispatch->device_mgr);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a dispatch queue for testing.
+ *
+ * @param test The testing framework.
+ * @param dispatch The testing components to initialize.
+ */
+static void cmd_dispatch_testing_init (CuTest *test, struct cmd_dispatch_testing *dispatch)
+{
+	int status;
+
+	cmd_dispatch_testing_init_dependencies (test, dispatch);
+
+	status = cmd_dispatch_init (&dispatch->test, dispatch->requests,
+		CMD_DISPATCH_TESTING_REQUESTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_enable_dispatch (&dispatch->mctp, &dispatch->test,
+		&dispatch->channel.base, false);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param dispatch The testing components to release.
+ */
+static void cmd_dispatch_testing_release (CuTest *test, struct cmd_dispatch_testing *dispatch)
+{
+	int status;
+
+	status = cmd_interface_mock_validate_and_release (&dispatch->cmd_cerberus);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_interface_mock_validate_and_release (&dispatch->cmd_mctp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&dispatch->channel);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_deinit (&dispatch->mctp);
+	device_manager_release (&dispatch->device_mgr);
+
+	cmd_dispatch_release (&dispatch->test);
+}
+
+/**
+ * Build a vendor defined request received from the BMC.
+ *
+ * @param request The request message to build.
+ * @param data Buffer for the request data.
+ * @param length Length of the request data.
+ */
+static void cmd_dispatch_testing_build_request (struct cmd_interface_msg *request, uint8_t *data,
+	size_t length)
+{
+	size_t i;
+
+	memset (request, 0, sizeof (*request));
+
+	data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 1; i < length; i++) {
+		data[i] = i;
+	}
+
+	request->data = data;
+	request->length = length;
+	request->max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	request->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request->source_addr = CMD_DISPATCH_TESTING_RESPONSE_ADDR;
+	request->target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request->crypto_timeout = true;
+	request->channel_id = 0;
+}
+
+/**
+ * Build the packet expected to be sent for a single packet response.
+ *
+ * @param test The testing framework.
+ * @param packet The packet to build.
+ * @param response The response message data.
+ * @param length Length of the response.
+ * @param msg_tag The message tag for the response.
+ */
+static void cmd_dispatch_testing_build_response_packet (CuTest *test, struct cmd_packet *packet,
+	uint8_t *response, size_t length, uint8_t msg_tag)
+{
+	int status;
+
+	memset (packet, 0, sizeof (*packet));
+
+	status = mctp_base_protocol_construct (response, length, packet->data, sizeof (packet->data),
+		CMD_DISPATCH_TESTING_SOURCE_ADDR, MCTP_BASE_PROTOCOL_BMC_EID,
+		MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, true, true, 0, msg_tag,
+		MCTP_BASE_PROTOCOL_TO_RESPONSE, CMD_DISPATCH_TESTING_RESPONSE_ADDR);
+	CuAssertTrue (test, !ROT_IS_ERROR (status));
+
+	packet->pkt_size = status;
+	packet->state = CMD_VALID_PACKET;
+	packet->dest_addr = CMD_DISPATCH_TESTING_RESPONSE_ADDR;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void cmd_dispatch_test_init (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init_dependencies (test, &dispatch);
+
+	status = cmd_dispatch_init (&dispatch.test, dispatch.requests, CMD_DISPATCH_TESTING_REQUESTS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, dispatch.requests, dispatch.test.requests);
+	CuAssertIntEquals (test, CMD_DISPATCH_TESTING_REQUESTS, dispatch.test.count);
+	CuAssertPtrNotNull (test, dispatch.test.free);
+	CuAssertPtrEquals (test, NULL, dispatch.test.head);
+	CuAssertPtrEquals (test, NULL, dispatch.test.tail);
+	CuAssertPtrEquals (test, NULL, dispatch.test.waiters);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[0].state);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[1].state);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_init_null (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	int status;
+
+	TEST_START;
+
+	status = cmd_dispatch_init (NULL, dispatch.requests, CMD_DISPATCH_TESTING_REQUESTS);
+	CuAssertIntEquals (test, CMD_DISPATCH_INVALID_ARGUMENT, status);
+
+	status = cmd_dispatch_init (&dispatch.test, NULL, CMD_DISPATCH_TESTING_REQUESTS);
+	CuAssertIntEquals (test, CMD_DISPATCH_INVALID_ARGUMENT, status);
+
+	status = cmd_dispatch_init (&dispatch.test, dispatch.requests, 0);
+	CuAssertIntEquals (test, CMD_DISPATCH_INVALID_ARGUMENT, status);
+}
+
+static void cmd_dispatch_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_dispatch_release (NULL);
+}
+
+static void cmd_dispatch_test_submit (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 3, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The request data is copied, so the source buffer can be reused. */
+	memset (data, 0xff, sizeof (data));
+
+	CuAssertPtrNotNull (test, dispatch.test.head);
+	CuAssertPtrEquals (test, dispatch.test.head, dispatch.test.tail);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_QUEUED, dispatch.test.head->state);
+	CuAssertPtrEquals (test, &dispatch.mctp, dispatch.test.head->mctp);
+	CuAssertIntEquals (test, sizeof (data), dispatch.test.head->request.length);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF,
+		dispatch.test.head->request.data[0]);
+	CuAssertIntEquals (test, 9, dispatch.test.head->request.data[9]);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, dispatch.test.head->request.source_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID,
+		dispatch.test.head->request.target_eid);
+	CuAssertIntEquals (test, false, dispatch.test.head->request.crypto_timeout);
+	CuAssertIntEquals (test, CMD_DISPATCH_TESTING_RESPONSE_ADDR,
+		dispatch.test.head->response_addr);
+	CuAssertIntEquals (test, CMD_DISPATCH_TESTING_SOURCE_ADDR, dispatch.test.head->source_addr);
+	CuAssertIntEquals (test, 3, dispatch.test.head->msg_tag);
+	CuAssertIntEquals (test, 1, dispatch.test.head->cmd_set);
+	CuAssertIntEquals (test, 0, dispatch.test.head->sequence);
+	CuAssertIntEquals (test, 1, dispatch.mctp.dispatch.next_sequence);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_submit_null (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	status = cmd_dispatch_submit (NULL, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, CMD_DISPATCH_INVALID_ARGUMENT, status);
+
+	status = cmd_dispatch_submit (&dispatch.test, NULL, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, CMD_DISPATCH_INVALID_ARGUMENT, status);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, NULL,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, CMD_DISPATCH_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, dispatch.test.head);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_submit_message_too_large (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + 1];
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, CMD_DISPATCH_MSG_TOO_LARGE, status);
+
+	CuAssertPtrEquals (test, NULL, dispatch.test.head);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_submit_stopped (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	cmd_dispatch_stop (&dispatch.test);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, CMD_DISPATCH_STOPPED, status);
+
+	CuAssertPtrEquals (test, NULL, dispatch.test.head);
+	CuAssertIntEquals (test, 0, dispatch.mctp.dispatch.next_sequence);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	struct cmd_interface_msg expected;
+	struct cmd_interface_msg response;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x01, 0x02};
+	struct cmd_packet tx_packet;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet, response_data,
+		sizeof (response_data), 2);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	expected = request;
+	expected.crypto_timeout = false;
+
+	memset (&response, 0, sizeof (response));
+	response.data = response_data;
+	response.length = sizeof (response_data);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+
+	status = mock_expect (&dispatch.cmd_cerberus.mock, dispatch.cmd_cerberus.base.process_request,
+		&dispatch.cmd_cerberus, 0,
+		MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request, &expected,
+			sizeof (expected), cmd_interface_mock_save_request, cmd_interface_mock_free_request));
+	status |= mock_expect_output_deep_copy (&dispatch.cmd_cerberus.mock, 0, &response,
+		sizeof (response), cmd_interface_mock_copy_request);
+
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertPtrEquals (test, NULL, dispatch.test.head);
+	CuAssertPtrEquals (test, NULL, dispatch.test.tail);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[0].state);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[1].state);
+	CuAssertIntEquals (test, 1, dispatch.mctp.dispatch.send_sequence);
+	CuAssertIntEquals (test, false, dispatch.mctp.dispatch.sending);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next_empty (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = cmd_dispatch_process_next (NULL);
+	CuAssertIntEquals (test, CMD_DISPATCH_INVALID_ARGUMENT, status);
+}
+
+static void cmd_dispatch_test_process_next_request_error (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	struct cmd_interface_msg error_packet;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	struct cmd_packet tx_packet;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	memset (error, 0, sizeof (*error));
+	error->header.msg_type = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	error->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	error->header.command = CERBERUS_PROTOCOL_ERROR;
+	error->error_code = CERBERUS_PROTOCOL_ERROR_UNSPECIFIED;
+	error->error_data = CMD_HANDLER_PROCESS_FAILED;
+
+	memset (&error_packet, 0, sizeof (error_packet));
+	error_packet.data = error_data;
+	error_packet.length = sizeof (error_data);
+
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet, error_data, sizeof (error_data),
+		0);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&dispatch.cmd_cerberus.mock, dispatch.cmd_cerberus.base.process_request,
+		&dispatch.cmd_cerberus, CMD_HANDLER_PROCESS_FAILED, MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&dispatch.cmd_cerberus.mock,
+		dispatch.cmd_cerberus.base.generate_error_packet, &dispatch.cmd_cerberus, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_ERROR_UNSPECIFIED),
+		MOCK_ARG (CMD_HANDLER_PROCESS_FAILED), MOCK_ARG (1));
+	status |= mock_expect_output_deep_copy (&dispatch.cmd_cerberus.mock, 0, &error_packet,
+		sizeof (error_packet), cmd_interface_mock_copy_request);
+
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertIntEquals (test, 1, dispatch.mctp.dispatch.send_sequence);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next_send_error (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x01, 0x02};
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&response, 0, sizeof (response));
+	response.data = response_data;
+	response.length = sizeof (response_data);
+
+	status = mock_expect (&dispatch.cmd_cerberus.mock, dispatch.cmd_cerberus.base.process_request,
+		&dispatch.cmd_cerberus, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_deep_copy (&dispatch.cmd_cerberus.mock, 0, &response,
+		sizeof (response), cmd_interface_mock_copy_request);
+
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, CMD_CHANNEL_TX_FAILED, MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 1, status);
+
+	/* The request is released even if the response could not be sent. */
+	CuAssertIntEquals (test, 1, dispatch.mctp.dispatch.send_sequence);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[0].state);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[1].state);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next_response_order (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_dispatch_testing_interface handler;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	uint8_t response_data[2][2] = {
+		{MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 1},
+		{MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 2}
+	};
+	struct cmd_packet tx_packet[2];
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	/* The handler processes the second request while the first is still executing, which is only
+	 * allowed for reentrant handlers. */
+	status = mctp_interface_enable_dispatch (&dispatch.mctp, &dispatch.test,
+		&dispatch.channel.base, true);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&handler, 0, sizeof (handler));
+	handler.base.process_request = cmd_dispatch_testing_process_request;
+	handler.dispatch = &dispatch.test;
+
+	dispatch.mctp.cmd_cerberus = &handler.base;
+
+	/* The second request completes first, but its response is held until the first request has
+	 * completed and its response has been sent. */
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet[0], response_data[0],
+		sizeof (response_data[0]), 1);
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet[1], response_data[1],
+		sizeof (response_data[1]), 2);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[0],
+			sizeof (tx_packet[0])));
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet[1],
+			sizeof (tx_packet[1])));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertIntEquals (test, 2, handler.calls);
+	CuAssertIntEquals (test, 1, handler.nested_status);
+	CuAssertIntEquals (test, 2, dispatch.mctp.dispatch.send_sequence);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[0].state);
+	CuAssertIntEquals (test, CMD_DISPATCH_REQUEST_FREE, dispatch.requests[1].state);
+
+	dispatch.mctp.cmd_cerberus = &dispatch.cmd_cerberus.base;
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next_reentrant (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x01, 0x02};
+	struct cmd_packet tx_packet;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet, response_data,
+		sizeof (response_data), 0);
+
+	status = mctp_interface_enable_dispatch (&dispatch.mctp, &dispatch.test,
+		&dispatch.channel.base, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&response, 0, sizeof (response));
+	response.data = response_data;
+	response.length = sizeof (response_data);
+
+	status = mock_expect (&dispatch.cmd_cerberus.mock, dispatch.cmd_cerberus.base.process_request,
+		&dispatch.cmd_cerberus, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_deep_copy (&dispatch.cmd_cerberus.mock, 0, &response,
+		sizeof (response), cmd_interface_mock_copy_request);
+
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a handler that is not reentrant executing on another worker.  Requests for reentrant
+	 * handlers are not blocked by it. */
+	platform_mutex_lock (&dispatch.test.execute);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+
+	platform_mutex_unlock (&dispatch.test.execute);
+
+	CuAssertIntEquals (test, 1, status);
+	CuAssertIntEquals (test, 1, dispatch.mctp.dispatch.send_sequence);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next_separate_execution_lock (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_dispatch_testing_interface handler;
+	struct cmd_channel_mock channel;
+	struct mctp_interface mctp;
+	platform_mutex execute;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x01, 0x02};
+	uint8_t slow_response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 1};
+	struct cmd_packet tx_packet;
+	struct cmd_packet slow_tx_packet;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+
+	status = cmd_channel_mock_init (&channel, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_init (&mctp, &dispatch.cmd_cerberus.base, &dispatch.cmd_mctp.base,
+		NULL, &dispatch.device_mgr);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_mutex_init (&execute);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The second channel uses handlers that do not share components with the first channel, so it
+	 * has its own execution lock. */
+	status = mctp_interface_enable_dispatch_with_lock (&mctp, &dispatch.test, &channel.base,
+		&execute);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The slow handler on the first channel processes the request for the second channel while it
+	 * is still executing and holding the execution lock for the first channel. */
+	memset (&handler, 0, sizeof (handler));
+	handler.base.process_request = cmd_dispatch_testing_process_request;
+	handler.dispatch = &dispatch.test;
+
+	dispatch.mctp.cmd_cerberus = &handler.base;
+
+	cmd_dispatch_testing_build_response_packet (test, &slow_tx_packet, slow_response_data,
+		sizeof (slow_response_data), 1);
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet, response_data,
+		sizeof (response_data), 2);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 1, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_submit (&dispatch.test, &mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 2, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&response, 0, sizeof (response));
+	response.data = response_data;
+	response.length = sizeof (response_data);
+
+	status = mock_expect (&dispatch.cmd_cerberus.mock, dispatch.cmd_cerberus.base.process_request,
+		&dispatch.cmd_cerberus, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_deep_copy (&dispatch.cmd_cerberus.mock, 0, &response,
+		sizeof (response), cmd_interface_mock_copy_request);
+
+	status |= mock_expect (&channel.mock, channel.base.send_packet, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &slow_tx_packet,
+			sizeof (slow_tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertIntEquals (test, 1, handler.calls);
+	CuAssertIntEquals (test, 1, handler.nested_status);
+	CuAssertIntEquals (test, 1, mctp.dispatch.send_sequence);
+	CuAssertIntEquals (test, 1, dispatch.mctp.dispatch.send_sequence);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_deinit (&mctp);
+	platform_mutex_free (&execute);
+
+	dispatch.mctp.cmd_cerberus = &dispatch.cmd_cerberus.base;
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_process_next_notify_waiters (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_dispatch_waiter waiter[2];
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x01, 0x02};
+	struct cmd_packet tx_packet;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet, response_data,
+		sizeof (response_data), 0);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate two contexts blocked waiting for a free request. */
+	status = platform_semaphore_init (&waiter[0].available);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_semaphore_init (&waiter[1].available);
+	CuAssertIntEquals (test, 0, status);
+
+	waiter[1].next = NULL;
+	waiter[0].next = &waiter[1];
+	dispatch.test.waiters = &waiter[0];
+
+	memset (&response, 0, sizeof (response));
+	response.data = response_data;
+	response.length = sizeof (response_data);
+
+	status = mock_expect (&dispatch.cmd_cerberus.mock, dispatch.cmd_cerberus.base.process_request,
+		&dispatch.cmd_cerberus, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_deep_copy (&dispatch.cmd_cerberus.mock, 0, &response,
+		sizeof (response), cmd_interface_mock_copy_request);
+
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_dispatch_process_next (&dispatch.test);
+	CuAssertIntEquals (test, 1, status);
+
+	/* Every waiter gets its own notification. */
+	status = platform_semaphore_try_wait (&waiter[0].available);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_semaphore_try_wait (&waiter[1].available);
+	CuAssertIntEquals (test, 0, status);
+
+	dispatch.test.waiters = NULL;
+	platform_semaphore_free (&waiter[0].available);
+	platform_semaphore_free (&waiter[1].available);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_run_stopped (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_interface_msg request;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x01, 0x02};
+	struct cmd_packet tx_packet;
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+	cmd_dispatch_testing_build_request (&request, data, sizeof (data));
+	cmd_dispatch_testing_build_response_packet (test, &tx_packet, response_data,
+		sizeof (response_data), 0);
+
+	status = cmd_dispatch_submit (&dispatch.test, &dispatch.mctp, &request,
+		CMD_DISPATCH_TESTING_RESPONSE_ADDR, CMD_DISPATCH_TESTING_SOURCE_ADDR, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&response, 0, sizeof (response));
+	response.data = response_data;
+	response.length = sizeof (response_data);
+
+	status = mock_expect (&dispatch.cmd_cerberus.mock, dispatch.cmd_cerberus.base.process_request,
+		&dispatch.cmd_cerberus, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_deep_copy (&dispatch.cmd_cerberus.mock, 0, &response,
+		sizeof (response), cmd_interface_mock_copy_request);
+
+	status |= mock_expect (&dispatch.channel.mock, dispatch.channel.base.send_packet,
+		&dispatch.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	/* Requests accepted before the stop are still executed before the worker exits. */
+	cmd_dispatch_stop (&dispatch.test);
+	cmd_dispatch_run (&dispatch.test);
+
+	CuAssertPtrEquals (test, NULL, dispatch.test.head);
+	CuAssertIntEquals (test, 1, dispatch.mctp.dispatch.send_sequence);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_stop_notify_waiters (CuTest *test)
+{
+	struct cmd_dispatch_testing dispatch;
+	struct cmd_dispatch_waiter waiter[2];
+	int status;
+
+	TEST_START;
+
+	cmd_dispatch_testing_init (test, &dispatch);
+
+	/* Simulate two contexts blocked waiting for a free request. */
+	status = platform_semaphore_init (&waiter[0].available);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_semaphore_init (&waiter[1].available);
+	CuAssertIntEquals (test, 0, status);
+
+	waiter[1].next = NULL;
+	waiter[0].next = &waiter[1];
+	dispatch.test.waiters = &waiter[0];
+
+	cmd_dispatch_stop (&dispatch.test);
+
+	/* Every waiter gets its own notification. */
+	status = platform_semaphore_try_wait (&waiter[0].available);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_semaphore_try_wait (&waiter[1].available);
+	CuAssertIntEquals (test, 0, status);
+
+	dispatch.test.waiters = NULL;
+	platform_semaphore_free (&waiter[0].available);
+	platform_semaphore_free (&waiter[1].available);
+
+	cmd_dispatch_testing_release (test, &dispatch);
+}
+
+static void cmd_dispatch_test_stop_null (CuTest *test)
+{
+	TEST_START;
+
+	cmd_dispatch_stop (NULL);
+	cmd_dispatch_run (NULL);
+}
+
+
+TEST_SUITE_START (cmd_dispatch);
+
+TEST (cmd_dispatch_test_init);
+TEST (cmd_dispatch_test_init_null);
+TEST (cmd_dispatch_test_release_null);
+TEST (cmd_dispatch_test_submit);
+TEST (cmd_dispatch_test_submit_null);
+TEST (cmd_dispatch_test_submit_message_too_large);
+TEST (cmd_dispatch_test_submit_stopped);
+TEST (cmd_dispatch_test_process_next);
+TEST (cmd_dispatch_test_process_next_empty);
+TEST (cmd_dispatch_test_process_next_null);
+TEST (cmd_dispatch_test_process_next_request_error);
+TEST (cmd_dispatch_test_process_next_send_error);
+TEST (cmd_dispatch_test_process_next_response_order);
+TEST (cmd_dispatch_test_process_next_reentrant);
+TEST (cmd_dispatch_test_process_next_separate_execution_lock);
+TEST (cmd_dispatch_test_process_next_notify_waiters);
+TEST (cmd_dispatch_test_run_stopped);
+TEST (cmd_dispatch_test_stop_notify_waiters);
+TEST (cmd_dispatch_test_stop_null);
+
+TEST_SUITE_END;
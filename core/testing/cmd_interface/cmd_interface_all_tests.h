@@ -75,6 +75,12 @@ static void add_all_cmd_interface_tests (CuSuite *suite)
 	!defined TESTING_SKIP_CMD_CHANNEL_HANDLER_SUITE
 	TESTING_RUN_SUITE (cmd_channel_handler);
 #endif
+#if (defined TESTING_RUN_CMD_DISPATCH_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_CMD_DISPATCH_SUITE
+	TESTING_RUN_SUITE (cmd_dispatch);
+#endif
 #if (defined TESTING_RUN_CMD_INTERFACE_AC_ROT_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -10,6 +10,7 @@
 #include "cmd_interface/session_manager_ecc.h"
 #include "cmd_interface/cerberus_protocol_optional_commands.h"
 #include "common/common_math.h"
+#include "common/unused.h"
 #include "testing/mock/asn1/x509_mock.h"
 #include "testing/mock/crypto/aes_mock.h"
 #include "testing/mock/crypto/ecc_mock.h"
@@ -330,6 +331,26 @@ static void session_manager_ecc_establish_session (CuTest *test,
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Mock action to simulate an AES engine that does not update the key generation when a key is set.
+ *
+ * @param expected The expectation being executed.  The context is the AES engine.
+ * @param called The call made to the mock.
+ *
+ * @return Always 0.
+ */
+static int64_t session_manager_ecc_testing_no_key_generation (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct aes_engine *aes = expected->context;
+
+	UNUSED (called);
+
+	aes->key_generation--;
+
+	return 0;
+}
+
 /*******************
  * Test cases
  *******************/
@@ -3261,6 +3282,542 @@ static void session_manager_ecc_test_encrypt_message_invalid_arg (CuTest *test)
 	release_session_manager_ecc_test (test, &cmd);
 }
 
+static void session_manager_ecc_test_encrypt_message_key_already_set (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t data[] = {
+		0xA,0xB,0xC,0xD,0xE,0xF,0xAA,0xBB,0xCC,0xDD,0xEE,0xFF
+	};
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	int status;
+
+	TEST_START;
+
+	rq.data = rq_data;
+	memcpy (rq.data, data, sizeof (data));
+	memcpy (rq.data + sizeof (data), SESSION_AES_GCM_TAG, sizeof (SESSION_AES_GCM_TAG));
+	memcpy (rq.data + sizeof (data) + sizeof (SESSION_AES_GCM_TAG), SESSION_AES_IV,
+		sizeof (SESSION_AES_IV));
+
+	rq.length = sizeof (data) + SESSION_MANAGER_TRAILER_LEN;
+	rq.source_eid = 0x10;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data) - CERBERUS_PROTOCOL_HEADER_SIZE_NO_ID),
+		MOCK_ARG_PTR_CONTAINS (SESSION_AES_GCM_TAG, sizeof (SESSION_AES_GCM_TAG)),
+		MOCK_ARG_PTR_CONTAINS (SESSION_AES_IV, sizeof (SESSION_AES_IV)),
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), rq.length);
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.encrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data) - CERBERUS_PROTOCOL_HEADER_SIZE_NO_ID),
+		MOCK_ARG_PTR_CONTAINS (SESSION_AES_IV, sizeof (SESSION_AES_IV)),
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL,
+		MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.encrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data) + SESSION_MANAGER_TRAILER_LEN, rq.length);
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_decrypt_message_different_session (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t eid[] = {0x10, 0x11, 0x11, 0x10};
+	int expect_key[] = {1, 1, 0, 1};
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (rq_data, 0x55, sizeof (rq_data));
+	rq.data = rq_data;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	status = ecc_mock_validate_and_release (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_init (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x11);
+
+	for (i = 0; i < sizeof (eid); i++) {
+		rq.length = 40;
+		rq.source_eid = eid[i];
+
+		if (expect_key[i]) {
+			status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+				MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+			CuAssertIntEquals (test, 0, status);
+		}
+
+		status = mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+			MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+			MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+		CuAssertIntEquals (test, 0, status);
+
+		status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_decrypt_message_after_set_key_fail (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	int status;
+
+	TEST_START;
+
+	memset (rq_data, 0x55, sizeof (rq_data));
+	rq.data = rq_data;
+	rq.length = 40;
+	rq.source_eid = 0x10;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_validate_and_release (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_init (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x11);
+
+	rq.length = 40;
+	rq.source_eid = 0x11;
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, AES_ENGINE_NO_MEMORY,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, AES_ENGINE_NO_MEMORY, status);
+
+	rq.length = 40;
+	rq.source_eid = 0x10;
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_decrypt_message_key_set_by_other_module (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t other_key[AES256_KEY_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (rq_data, 0x55, sizeof (rq_data));
+	rq.data = rq_data;
+	rq.length = 40;
+	rq.source_eid = 0x10;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	memset (other_key, 0xaa, sizeof (other_key));
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Another module sharing the AES engine sets a different key. */
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (other_key, sizeof (other_key)), MOCK_ARG (sizeof (other_key)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.aes.base.set_key (&cmd.aes.base, other_key, sizeof (other_key));
+	CuAssertIntEquals (test, 0, status);
+
+	rq.length = 40;
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_decrypt_message_no_key_generation (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	int i;
+	int status;
+
+	TEST_START;
+
+	memset (rq_data, 0x55, sizeof (rq_data));
+	rq.data = rq_data;
+	rq.source_eid = 0x10;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	/* Key changes can't be detected on the engine, so the key is set for every message. */
+	for (i = 0; i < 2; i++) {
+		rq.length = 40;
+
+		status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+			MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+		status |= mock_expect_external_action (&cmd.aes.mock,
+			session_manager_ecc_testing_no_key_generation, &cmd.aes.base);
+		status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+			MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+			MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+		CuAssertIntEquals (test, 0, status);
+
+		status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_decrypt_message_after_session_restart (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	int status;
+
+	TEST_START;
+
+	memset (rq_data, 0x55, sizeof (rq_data));
+	rq.data = rq_data;
+	rq.length = 40;
+	rq.source_eid = 0x10;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.reset_session (&cmd.session.base, 0x10, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_validate_and_release (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_init (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	rq.length = 40;
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Establishing the session again replaces the key, even without a reset. */
+	status = ecc_mock_validate_and_release (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_init (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	rq.length = 40;
+
+	status = mock_expect (&cmd.aes.mock, cmd.aes.base.set_key, &cmd.aes, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)), MOCK_ARG (sizeof (aes_key)));
+	status |= mock_expect (&cmd.aes.mock, cmd.aes.base.decrypt_data, &cmd.aes, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+	CuAssertIntEquals (test, 0, status);
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_decrypt_message_key_slots_different_session (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	struct aes_engine_mock aes2;
+	struct aes_engine *engines[] = {&cmd.aes.base, &aes2.base};
+	struct aes_engine_mock *engine_mock[] = {&cmd.aes, &aes2};
+	struct session_manager_key_slot slots[2];
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t eid[] = {0x10, 0x11, 0x10, 0x11, 0x10, 0x11};
+	int slot[] = {0, 1, 0, 1, 0, 1};
+	int expect_key[] = {1, 1, 0, 0, 0, 0};
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (rq_data, 0x55, sizeof (rq_data));
+	rq.data = rq_data;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	status = aes_mock_init (&aes2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = session_manager_enable_key_slots (&cmd.session.base, slots, engines, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x10);
+
+	status = ecc_mock_validate_and_release (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_init (&cmd.ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	session_manager_ecc_establish_session (test, &cmd, 0x11);
+
+	/* Each session keeps its key loaded in a separate AES engine, so alternating between sessions
+	 * only sets each key once. */
+	for (i = 0; i < sizeof (eid); i++) {
+		rq.length = 40;
+		rq.source_eid = eid[i];
+
+		if (expect_key[i]) {
+			status = mock_expect (&engine_mock[slot[i]]->mock, engine_mock[slot[i]]->base.set_key,
+				engine_mock[slot[i]], 0, MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)),
+				MOCK_ARG (sizeof (aes_key)));
+			CuAssertIntEquals (test, 0, status);
+		}
+
+		status = mock_expect (&engine_mock[slot[i]]->mock, engine_mock[slot[i]]->base.decrypt_data,
+			engine_mock[slot[i]], 0, MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL,
+			MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+		CuAssertIntEquals (test, 0, status);
+
+		status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = aes_mock_validate_and_release (&aes2);
+	CuAssertIntEquals (test, 0, status);
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_decrypt_message_key_slots_least_recently_used (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	struct aes_engine_mock aes2;
+	struct aes_engine *engines[] = {&cmd.aes.base, &aes2.base};
+	struct aes_engine_mock *engine_mock[] = {&cmd.aes, &aes2};
+	struct session_manager_key_slot slots[2];
+	uint8_t rq_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg rq;
+	uint8_t aes_key[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t eid[] = {0x10, 0x11, 0x10, 0x12, 0x10, 0x11, 0x12};
+	int slot[] = {0, 1, 0, 1, 0, 1, 0};
+	int expect_key[] = {1, 1, 0, 1, 0, 1, 1};
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (rq_data, 0x55, sizeof (rq_data));
+	rq.data = rq_data;
+	rq.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	status = aes_mock_init (&aes2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = session_manager_enable_key_slots (&cmd.session.base, slots, engines, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0x10; i <= 0x12; i++) {
+		status = ecc_mock_validate_and_release (&cmd.ecc);
+		CuAssertIntEquals (test, 0, status);
+
+		status = ecc_mock_init (&cmd.ecc);
+		CuAssertIntEquals (test, 0, status);
+
+		session_manager_ecc_establish_session (test, &cmd, i);
+	}
+
+	/* There are more sessions than key slots, so the key slot that was least recently used gets
+	 * replaced when a key needs to be loaded. */
+	for (i = 0; i < sizeof (eid); i++) {
+		rq.length = 40;
+		rq.source_eid = eid[i];
+
+		if (expect_key[i]) {
+			status = mock_expect (&engine_mock[slot[i]]->mock, engine_mock[slot[i]]->base.set_key,
+				engine_mock[slot[i]], 0, MOCK_ARG_PTR_CONTAINS_TMP (aes_key, sizeof (aes_key)),
+				MOCK_ARG (sizeof (aes_key)));
+			CuAssertIntEquals (test, 0, status);
+		}
+
+		status = mock_expect (&engine_mock[slot[i]]->mock, engine_mock[slot[i]]->base.decrypt_data,
+			engine_mock[slot[i]], 0, MOCK_ARG_NOT_NULL, MOCK_ARG_ANY, MOCK_ARG_NOT_NULL,
+			MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (SESSION_AES_IV)), MOCK_ARG_NOT_NULL, MOCK_ARG_ANY);
+		CuAssertIntEquals (test, 0, status);
+
+		status = cmd.session.base.decrypt_message (&cmd.session.base, &rq);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = aes_mock_validate_and_release (&aes2);
+	CuAssertIntEquals (test, 0, status);
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
+static void session_manager_ecc_test_enable_key_slots_invalid_arg (CuTest *test)
+{
+	struct session_manager_ecc_testing cmd;
+	struct aes_engine *engines[] = {&cmd.aes.base, NULL};
+	struct session_manager_key_slot slots[2];
+	int status;
+
+	TEST_START;
+
+	setup_session_manager_ecc_test (test, &cmd);
+
+	status = session_manager_enable_key_slots (NULL, slots, engines, 1);
+	CuAssertIntEquals (test, SESSION_MANAGER_INVALID_ARGUMENT, status);
+
+	status = session_manager_enable_key_slots (&cmd.session.base, NULL, engines, 1);
+	CuAssertIntEquals (test, SESSION_MANAGER_INVALID_ARGUMENT, status);
+
+	status = session_manager_enable_key_slots (&cmd.session.base, slots, NULL, 1);
+	CuAssertIntEquals (test, SESSION_MANAGER_INVALID_ARGUMENT, status);
+
+	status = session_manager_enable_key_slots (&cmd.session.base, slots, engines, 0);
+	CuAssertIntEquals (test, SESSION_MANAGER_INVALID_ARGUMENT, status);
+
+	status = session_manager_enable_key_slots (&cmd.session.base, slots, engines, 2);
+	CuAssertIntEquals (test, SESSION_MANAGER_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, &cmd.session.base.default_slot, cmd.session.base.key_slots);
+	CuAssertIntEquals (test, 1, cmd.session.base.num_key_slots);
+
+	release_session_manager_ecc_test (test, &cmd);
+}
+
 static void session_manager_ecc_test_is_session_established (CuTest *test)
 {
 	struct session_manager_ecc_testing cmd;
@@ -4797,6 +5354,15 @@ TEST (session_manager_ecc_test_encrypt_message_fail);
 TEST (session_manager_ecc_test_encrypt_message_no_payload);
 TEST (session_manager_ecc_test_encrypt_message_buf_too_small);
 TEST (session_manager_ecc_test_encrypt_message_invalid_arg);
+TEST (session_manager_ecc_test_encrypt_message_key_already_set);
+TEST (session_manager_ecc_test_decrypt_message_different_session);
+TEST (session_manager_ecc_test_decrypt_message_after_set_key_fail);
+TEST (session_manager_ecc_test_decrypt_message_key_set_by_other_module);
+TEST (session_manager_ecc_test_decrypt_message_no_key_generation);
+TEST (session_manager_ecc_test_decrypt_message_after_session_restart);
+TEST (session_manager_ecc_test_decrypt_message_key_slots_different_session);
+TEST (session_manager_ecc_test_decrypt_message_key_slots_least_recently_used);
+TEST (session_manager_ecc_test_enable_key_slots_invalid_arg);
 TEST (session_manager_ecc_test_is_session_established);
 TEST (session_manager_ecc_test_is_session_established_unexpected_eid);
 TEST (session_manager_ecc_test_is_session_established_invalid_arg);
@@ -30,6 +30,7 @@ static void aes_mbedtls_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.set_key);
 	CuAssertPtrNotNull (test, engine.base.encrypt_data);
 	CuAssertPtrNotNull (test, engine.base.decrypt_data);
+	CuAssertIntEquals (test, 0, engine.base.key_generation);
 
 	aes_mbedtls_release (&engine);
 }
@@ -243,6 +244,32 @@ static void aes_mbedtls_test_encrypt_data_no_key (CuTest *test)
 	aes_mbedtls_release (&engine);
 }
 
+static void aes_mbedtls_test_set_key_key_generation (CuTest *test)
+{
+	struct aes_engine_mbedtls engine;
+	int status;
+
+	TEST_START;
+
+	status = aes_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.set_key (&engine.base, AES_KEY, AES_KEY_LEN);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, engine.base.key_generation);
+
+	status = engine.base.set_key (&engine.base, AES_KEY, AES_KEY_LEN);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, engine.base.key_generation);
+
+	/* Every call updates the generation, even if the key was not set. */
+	status = engine.base.set_key (&engine.base, AES_KEY, 3);
+	CuAssertIntEquals (test, AES_ENGINE_INVALID_KEY_LENGTH, status);
+	CuAssertIntEquals (test, 3, engine.base.key_generation);
+
+	aes_mbedtls_release (&engine);
+}
+
 static void aes_mbedtls_test_set_key_null (CuTest *test)
 {
 	struct aes_engine_mbedtls engine;
@@ -676,6 +703,7 @@ TEST (aes_mbedtls_test_encrypt_data_no_key);
 TEST (aes_mbedtls_test_set_key_null);
 TEST (aes_mbedtls_test_set_key_bad_length);
 TEST (aes_mbedtls_test_set_key_unsupported_length);
+TEST (aes_mbedtls_test_set_key_key_generation);
 TEST (aes_mbedtls_test_decrypt_data);
 // TEST (aes_mbedtls_test_decrypt_data_no_tag);
 TEST (aes_mbedtls_test_decrypt_data_same_buffer);
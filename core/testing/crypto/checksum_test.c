@@ -12,6 +12,37 @@
 TEST_SUITE_LABEL ("checksum");
 
 
+/**
+ * Reference implementation of the SMBus CRC8 that processes one bit at a time.
+ *
+ * @param crc The initial CRC value.
+ * @param data The data to add to the CRC.
+ * @param len Length of the data.
+ *
+ * @return The updated CRC value.
+ */
+static uint8_t checksum_testing_bitwise_crc8 (uint8_t crc, const uint8_t *data, size_t len)
+{
+	size_t i;
+	int j;
+
+	for (i = 0; i < len; i++) {
+		crc ^= data[i];
+
+		for (j = 0; j < 8; j++) {
+			if ((crc & 0x80) != 0) {
+				crc = (uint8_t) ((crc << 1) ^ 0x07);
+			}
+			else {
+				crc <<= 1;
+			}
+		}
+	}
+
+	return crc;
+}
+
+
 /*******************
  * Test cases
  *******************/
@@ -125,6 +156,90 @@ static void checksum_test_update_smbus_crc8_zero_length (CuTest *test)
 	CuAssertIntEquals (test, 0xaa, crc);
 }
 
+static void checksum_test_update_smbus_crc8_all_lengths (CuTest *test)
+{
+	uint8_t buf[256 + 8];
+	uint8_t crc;
+	uint8_t expected;
+	size_t i;
+	int len;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (buf); i++) {
+		buf[i] = (uint8_t) ((i * 251) + 17);
+	}
+
+	for (i = 0; i < 8; i++) {
+		for (len = 0; len < 256; len++) {
+			expected = checksum_testing_bitwise_crc8 (len, &buf[i], len);
+
+			crc = checksum_update_smbus_crc8 (len, &buf[i], len);
+			CuAssertIntEquals (test, expected, crc);
+		}
+	}
+}
+
+static void checksum_test_update_smbus_crc8_multiple_calls (CuTest *test)
+{
+	uint8_t buf[255];
+	uint8_t crc;
+	uint8_t expected;
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (buf); i++) {
+		buf[i] = i;
+	}
+
+	expected = checksum_crc8 (0x2A, buf, sizeof (buf));
+
+	crc = checksum_init_smbus_crc8 (0x2A);
+	crc = checksum_update_smbus_crc8 (crc, buf, 7);
+	crc = checksum_update_smbus_crc8 (crc, &buf[7], 1);
+	crc = checksum_update_smbus_crc8 (crc, &buf[8], 100);
+	crc = checksum_update_smbus_crc8 (crc, &buf[108], sizeof (buf) - 108);
+	CuAssertIntEquals (test, expected, crc);
+}
+
+static void checksum_test_init_smbus_crc8_all_addresses (CuTest *test)
+{
+	uint8_t addr;
+	uint8_t crc;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < 256; i++) {
+		addr = i;
+
+		crc = checksum_init_smbus_crc8 (addr);
+		CuAssertIntEquals (test, checksum_testing_bitwise_crc8 (0, &addr, 1), crc);
+	}
+}
+
+static void checksum_test_sw_update_smbus_crc8 (CuTest *test)
+{
+	uint8_t crc;
+	uint8_t buf[3] = {0x01, 0x02, 0x03};
+
+	TEST_START;
+
+	crc = checksum_sw_update_smbus_crc8 (0, buf, sizeof (buf));
+	CuAssertIntEquals (test, 0x48, crc);
+}
+
+static void checksum_test_sw_update_smbus_crc8_null (CuTest *test)
+{
+	uint8_t crc;
+
+	TEST_START;
+
+	crc = checksum_sw_update_smbus_crc8 (0x55, NULL, 16);
+	CuAssertIntEquals (test, 0x55, crc);
+}
+
 
 TEST_SUITE_START (checksum);
 
@@ -135,5 +250,10 @@ TEST (checksum_test_init_smbus_crc8);
 TEST (checksum_test_update_smbus_crc8);
 TEST (checksum_test_update_smbus_crc8_null);
 TEST (checksum_test_update_smbus_crc8_zero_length);
+TEST (checksum_test_update_smbus_crc8_all_lengths);
+TEST (checksum_test_update_smbus_crc8_multiple_calls);
+TEST (checksum_test_init_smbus_crc8_all_addresses);
+TEST (checksum_test_sw_update_smbus_crc8);
+TEST (checksum_test_sw_update_smbus_crc8_null);
 
 TEST_SUITE_END;
@@ -27,6 +27,12 @@ static void add_all_flash_tests (CuSuite *suite)
 	!defined TESTING_SKIP_FLASH_COMMON_SUITE
 	TESTING_RUN_SUITE (flash_common);
 #endif
+#if (defined TESTING_RUN_FLASH_QUEUE_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_FLASH_QUEUE_SUITE
+	TESTING_RUN_SUITE (flash_queue);
+#endif
 #if (defined TESTING_RUN_FLASH_STORE_AGGREGATOR_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -0,0 +1,821 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "flash/flash_queue.h"
+#include "testing/mock/flash/flash_mock.h"
+
+
+TEST_SUITE_LABEL ("flash_queue");
+
+
+/**
+ * Context for tracking request completion callbacks.
+ */
+struct flash_queue_testing_callback {
+	int calls;			/**< The number of times the callback was called. */
+	int status;			/**< The request status at the time of the callback. */
+	bool done;			/**< The request completion flag at the time of the callback. */
+};
+
+/**
+ * Completion callback for test requests.
+ *
+ * @param request The request that completed.
+ */
+static void flash_queue_testing_complete (struct flash_queue_request *request)
+{
+	struct flash_queue_testing_callback *callback = request->context;
+
+	callback->calls++;
+	callback->status = request->status;
+	callback->done = request->done;
+}
+
+/**
+ * Initialize a flash queue for testing.
+ *
+ * @param test The testing framework.
+ * @param queue The queue to initialize.
+ * @param flash The flash mock to initialize.
+ */
+static void flash_queue_testing_init (CuTest *test, struct flash_queue *queue,
+	struct flash_mock *flash)
+{
+	int status;
+
+	status = flash_mock_init (flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_init (queue, &flash->base);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param queue The queue to release.
+ * @param flash The flash mock to release.
+ */
+static void flash_queue_testing_release (CuTest *test, struct flash_queue *queue,
+	struct flash_mock *flash)
+{
+	int status;
+
+	status = flash_mock_validate_and_release (flash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_release (queue);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_queue_test_init (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_init (&queue, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_init_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_init (NULL, &flash.base);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	status = flash_queue_init (&queue, NULL);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_queue_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_queue_release (NULL);
+}
+
+static void flash_queue_test_write (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_WRITE;
+	request.address = 0x10000;
+	request.data = data;
+	request.length = sizeof (data);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_is_complete (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_is_complete (&queue, &request);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_write_incomplete (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_WRITE;
+	request.address = 0x10000;
+	request.data = data;
+	request.length = sizeof (data);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data) - 1,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, FLASH_QUEUE_INCOMPLETE_WRITE, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_write_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_WRITE;
+	request.address = 0x10000;
+	request.data = data;
+	request.length = sizeof (data);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_read (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t data_in[sizeof (data)];
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_READ;
+	request.address = 0x20000;
+	request.data = data_in;
+	request.length = sizeof (data_in);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data_in)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, data_in, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_read_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	uint8_t data_in[4];
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_READ;
+	request.address = 0x20000;
+	request.data = data_in;
+	request.length = sizeof (data_in);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data_in)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_sector_erase (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_SECTOR_ERASE;
+	request.address = 0x11000;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_sector_erase_error (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_SECTOR_ERASE;
+	request.address = 0x11000;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x11000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_block_erase (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_BLOCK_ERASE;
+	request.address = 0x30000;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x30000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_multiple_requests (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request[3];
+	uint8_t data1[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t data2[] = {0x05, 0x06, 0x07, 0x08};
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (request, 0, sizeof (request));
+	request[0].op = FLASH_QUEUE_OP_SECTOR_ERASE;
+	request[0].address = 0x10000;
+
+	request[1].op = FLASH_QUEUE_OP_WRITE;
+	request[1].address = 0x10000;
+	request[1].data = data1;
+	request[1].length = sizeof (data1);
+
+	request[2].op = FLASH_QUEUE_OP_WRITE;
+	request[2].address = 0x10004;
+	request[2].data = data2;
+	request[2].length = sizeof (data2);
+
+	status = flash_queue_submit (&queue, &request[0]);
+	status |= flash_queue_submit (&queue, &request[1]);
+	status |= flash_queue_submit (&queue, &request[2]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data1),
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data1, sizeof (data1)),
+		MOCK_ARG (sizeof (data1)));
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data2),
+		MOCK_ARG (0x10004), MOCK_ARG_PTR_CONTAINS (data2, sizeof (data2)),
+		MOCK_ARG (sizeof (data2)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_is_complete (&queue, &request[0]);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_is_complete (&queue, &request[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_is_complete (&queue, &request[2]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_wait (&queue, &request[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_wait (&queue, &request[1], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_wait (&queue, &request[2], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_resubmit_after_complete (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_SECTOR_ERASE;
+	request.address = 0x10000;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+
+	request.address = 0x11000;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_is_complete (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_completion_callback (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	struct flash_queue_testing_callback callback;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&callback, 0, sizeof (callback));
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_BLOCK_ERASE;
+	request.address = 0x30000;
+	request.complete = flash_queue_testing_complete;
+	request.context = &callback;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.block_erase, &flash, FLASH_BLOCK_ERASE_FAILED,
+		MOCK_ARG (0x30000));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, callback.calls);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	CuAssertIntEquals (test, 1, callback.calls);
+	CuAssertIntEquals (test, FLASH_BLOCK_ERASE_FAILED, callback.status);
+	CuAssertIntEquals (test, false, callback.done);
+
+	status = flash_queue_wait (&queue, &request, 0);
+	CuAssertIntEquals (test, FLASH_BLOCK_ERASE_FAILED, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_submit_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_SECTOR_ERASE;
+
+	status = flash_queue_submit (NULL, &request);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	status = flash_queue_submit (&queue, NULL);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	request.op = FLASH_QUEUE_OP_READ;
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	request.op = FLASH_QUEUE_OP_WRITE;
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_submit_unknown_operation (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = NUM_FLASH_QUEUE_OPERATIONS;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, FLASH_QUEUE_UNKNOWN_OPERATION, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_is_complete_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+
+	status = flash_queue_is_complete (NULL, &request);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	status = flash_queue_is_complete (&queue, NULL);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_wait_timeout (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_SECTOR_ERASE;
+	request.address = 0x10000;
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_wait (&queue, &request, 10);
+	CuAssertIntEquals (test, FLASH_QUEUE_WAIT_TIMEOUT, status);
+	CuAssertPtrEquals (test, NULL, queue.waiters);
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 1, status);
+
+	status = flash_queue_wait (&queue, &request, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_wait_null (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+
+	status = flash_queue_wait (NULL, &request, 0);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	status = flash_queue_wait (&queue, NULL, 0);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_process_next_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = flash_queue_process_next (NULL);
+	CuAssertIntEquals (test, FLASH_QUEUE_INVALID_ARGUMENT, status);
+}
+
+static void flash_queue_test_run (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request[2];
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (request, 0, sizeof (request));
+	request[0].op = FLASH_QUEUE_OP_SECTOR_ERASE;
+	request[0].address = 0x10000;
+
+	request[1].op = FLASH_QUEUE_OP_WRITE;
+	request[1].address = 0x10000;
+	request[1].data = data;
+	request[1].length = sizeof (data);
+
+	status = flash_queue_submit (&queue, &request[0]);
+	status |= flash_queue_submit (&queue, &request[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data),
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Stop the queue first so the worker loop returns once all requests have been executed. */
+	flash_queue_stop (&queue);
+	flash_queue_run (&queue);
+
+	status = flash_queue_wait (&queue, &request[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_wait (&queue, &request[1], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_run_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_queue_run (NULL);
+}
+
+static void flash_queue_test_stop (CuTest *test)
+{
+	struct flash_mock flash;
+	struct flash_queue queue;
+	struct flash_queue_request request;
+	int status;
+
+	TEST_START;
+
+	flash_queue_testing_init (test, &queue, &flash);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_SECTOR_ERASE;
+	request.address = 0x10000;
+
+	flash_queue_stop (&queue);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, FLASH_QUEUE_STOPPED, status);
+
+	status = flash_queue_process_next (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_testing_release (test, &queue, &flash);
+}
+
+static void flash_queue_test_stop_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_queue_stop (NULL);
+}
+
+
+TEST_SUITE_START (flash_queue);
+
+TEST (flash_queue_test_init);
+TEST (flash_queue_test_init_null);
+TEST (flash_queue_test_release_null);
+TEST (flash_queue_test_write);
+TEST (flash_queue_test_write_incomplete);
+TEST (flash_queue_test_write_error);
+TEST (flash_queue_test_read);
+TEST (flash_queue_test_read_error);
+TEST (flash_queue_test_sector_erase);
+TEST (flash_queue_test_sector_erase_error);
+TEST (flash_queue_test_block_erase);
+TEST (flash_queue_test_multiple_requests);
+TEST (flash_queue_test_resubmit_after_complete);
+TEST (flash_queue_test_completion_callback);
+TEST (flash_queue_test_submit_null);
+TEST (flash_queue_test_submit_unknown_operation);
+TEST (flash_queue_test_is_complete_null);
+TEST (flash_queue_test_wait_timeout);
+TEST (flash_queue_test_wait_null);
+TEST (flash_queue_test_process_next_null);
+TEST (flash_queue_test_run);
+TEST (flash_queue_test_run_null);
+TEST (flash_queue_test_stop);
+TEST (flash_queue_test_stop_null);
+
+TEST_SUITE_END;
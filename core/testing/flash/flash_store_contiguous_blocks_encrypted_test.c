@@ -102,6 +102,27 @@ static void flash_store_contiguous_blocks_encrypted_testing_prepare_init (CuTest
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Helper to generate the IV used to encrypt a chunk of data.
+ *
+ * @param chunk_iv Output for the chunk IV.
+ * @param chunk The chunk number.
+ * @param last Flag indicating if the chunk is the last one in the data block.
+ */
+static void flash_store_contiguous_blocks_encrypted_testing_chunk_iv (uint8_t *chunk_iv,
+	uint32_t chunk, bool last)
+{
+	memcpy (chunk_iv, AES_IV, AES_IV_LEN);
+	if (last) {
+		chunk |= (1U << 31);
+	}
+
+	chunk_iv[8] ^= (chunk >> 24);
+	chunk_iv[9] ^= (chunk >> 16);
+	chunk_iv[10] ^= (chunk >> 8);
+	chunk_iv[11] ^= chunk;
+}
+
 /**
  * Helper to validate mocks and release all testing dependencies.
  *
@@ -15200,6 +15221,1245 @@ static void flash_store_contiguous_blocks_encrypted_test_read_variable_storage_d
 	flash_store_contiguous_blocks_encrypted_release (&store.test);
 }
 
+static void flash_store_contiguous_blocks_encrypted_test_init_variable_storage_chunked (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, store.test.base.base.write);
+	CuAssertPtrNotNull (test, store.test.base.base.read);
+	CuAssertPtrNotNull (test, store.test.base.base.erase);
+	CuAssertPtrNotNull (test, store.test.base.base.erase_all);
+	CuAssertPtrNotNull (test, store.test.base.base.get_data_length);
+	CuAssertPtrNotNull (test, store.test.base.base.has_data_stored);
+	CuAssertPtrNotNull (test, store.test.base.base.get_max_data_length);
+	CuAssertPtrNotNull (test, store.test.base.base.get_flash_size);
+	CuAssertPtrNotNull (test, store.test.base.base.get_num_blocks);
+
+	CuAssertIntEquals (test, 256, store.test.chunk_size);
+
+	/* 15 chunks of 256 bytes, each with a tag, fill the sector with the header and IV. */
+	status = store.test.base.base.get_max_data_length (&store.test.base.base);
+	CuAssertIntEquals (test, 15 * 256, status);
+
+	status = store.test.base.base.get_flash_size (&store.test.base.base);
+	CuAssertIntEquals (test, 3 * 0x1000, status);
+
+	status = store.test.base.base.get_num_blocks (&store.test.base.base);
+	CuAssertIntEquals (test, 3, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_init_variable_storage_chunked_partial_chunk_max_space (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 0x1000, &store.aes.base, &store.rng.base,
+		1000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Two sectors hold 8 full chunks and a partial chunk of 32 bytes. */
+	status = store.test.base.base.get_max_data_length (&store.test.base.base);
+	CuAssertIntEquals (test, (8 * 1000) + 32, status);
+
+	status = store.test.base.base.get_flash_size (&store.test.base.base);
+	CuAssertIntEquals (test, 3 * 0x2000, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_init_variable_storage_chunked_null (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_init_dependencies (test, &store);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (NULL,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		NULL, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, NULL, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, NULL, &store.rng.base, 256);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, NULL, 256);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 0);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_init_variable_storage_decreasing_chunked (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing_chunked (
+		&store.test, &store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 256, store.test.chunk_size);
+	CuAssertIntEquals (test, true, store.test.base.decreasing);
+
+	status = store.test.base.base.get_max_data_length (&store.test.base.base);
+	CuAssertIntEquals (test, 15 * 256, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_init_variable_storage_decreasing_chunked_null (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_init_dependencies (test, &store);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing_chunked (
+		NULL, &store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base,
+		256);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing_chunked (
+		&store.test, &store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base,
+		&store.rng.base, 0);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_static_init_variable_storage_chunked (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	struct flash_store_contiguous_blocks_encrypted test_static =
+		flash_store_contiguous_blocks_encrypted_static_init_variable_storage_chunked (&store.state,
+		0x10000, &store.flash.base, &store.aes.base, &store.rng.base, 256);
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	CuAssertIntEquals (test, 256, test_static.chunk_size);
+	CuAssertIntEquals (test, false, test_static.base.decreasing);
+
+	status = flash_store_contiguous_blocks_encrypted_init_state (&test_static, 3, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = test_static.base.base.get_max_data_length (&test_static.base.base);
+	CuAssertIntEquals (test, 15 * 256, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&test_static);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_static_init_variable_storage_decreasing_chunked (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	struct flash_store_contiguous_blocks_encrypted test_static =
+		flash_store_contiguous_blocks_encrypted_static_init_variable_storage_decreasing_chunked (
+		&store.state, 0x10000, &store.flash.base, &store.aes.base, &store.rng.base, 256);
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	CuAssertIntEquals (test, 256, test_static.chunk_size);
+	CuAssertIntEquals (test, true, test_static.base.decreasing);
+
+	status = flash_store_contiguous_blocks_encrypted_init_state (&test_static, 3, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = test_static.base.base.get_max_data_length (&test_static.base.base);
+	CuAssertIntEquals (test, 15 * 256, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&test_static);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t data[600];
+	uint8_t enc[sizeof (data)];
+	uint8_t iv[3][AES_IV_LEN];
+	uint8_t tag[3][AES_GCM_TAG_LEN];
+	size_t length[] = {256, 256, 88};
+	uint32_t data_addr = 0x10000 + sizeof (header);
+	uint32_t tag_addr = data_addr + sizeof (data) + AES_IV_LEN;
+	size_t offset;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (data); i++) {
+		data[i] = i;
+		enc[i] = ~i;
+	}
+
+	for (i = 0; i < 3; i++) {
+		flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv[i], i, (i == 2));
+		memset (tag[i], 0x10 + i, AES_GCM_TAG_LEN);
+	}
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.rng.mock, store.rng.base.generate_random_buffer, &store.rng, 0,
+		MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&store.rng.mock, 1, AES_IV, AES_IV_LEN, 0);
+
+	status |= flash_mock_expect_erase_flash_sector (&store.flash, 0x10000, 0x1000);
+
+	for (i = 0, offset = 0; i < 3; offset += length[i], i++) {
+		status |= mock_expect (&store.aes.mock, store.aes.base.encrypt_data, &store.aes, 0,
+			MOCK_ARG_PTR_CONTAINS (&data[offset], length[i]), MOCK_ARG (length[i]),
+			MOCK_ARG_PTR_CONTAINS (iv[i], AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (length[i]), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_GCM_TAG_LEN));
+		status |= mock_expect_output (&store.aes.mock, 4, &enc[offset], length[i], 5);
+		status |= mock_expect_output (&store.aes.mock, 6, tag[i], AES_GCM_TAG_LEN, 7);
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, length[i],
+			MOCK_ARG (data_addr + offset), MOCK_ARG_PTR_CONTAINS (&enc[offset], length[i]),
+			MOCK_ARG (length[i]));
+		status |= flash_mock_expect_verify_flash (&store.flash, data_addr + offset, &enc[offset],
+			length[i]);
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash,
+			AES_GCM_TAG_LEN, MOCK_ARG (tag_addr + (AES_GCM_TAG_LEN * i)),
+			MOCK_ARG_PTR_CONTAINS (tag[i], AES_GCM_TAG_LEN), MOCK_ARG (AES_GCM_TAG_LEN));
+		status |= flash_mock_expect_verify_flash (&store.flash, tag_addr + (AES_GCM_TAG_LEN * i),
+			tag[i], AES_GCM_TAG_LEN);
+	}
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, AES_IV_LEN,
+		MOCK_ARG (data_addr + sizeof (data)), MOCK_ARG_PTR_CONTAINS (AES_IV, AES_IV_LEN),
+		MOCK_ARG (AES_IV_LEN));
+	status |= flash_mock_expect_verify_flash (&store.flash, data_addr + sizeof (data), AES_IV,
+		AES_IV_LEN);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (header),
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (header, sizeof (header)),
+		MOCK_ARG (sizeof (header)));
+	status |= flash_mock_expect_verify_flash (&store.flash, 0x10000, header, sizeof (header));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.write (&store.test.base.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_single_chunk (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x80, 0x00};
+	uint8_t data[128];
+	uint8_t enc[sizeof (data)];
+	uint8_t iv[AES_IV_LEN];
+	uint32_t data_addr = 0xf000 + sizeof (header);
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (data); i++) {
+		data[i] = i;
+		enc[i] = ~i;
+	}
+
+	flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv, 0, true);
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_decreasing_chunked (
+		&store.test, &store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.rng.mock, store.rng.base.generate_random_buffer, &store.rng, 0,
+		MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&store.rng.mock, 1, AES_IV, AES_IV_LEN, 0);
+
+	status |= flash_mock_expect_erase_flash_sector (&store.flash, 0xf000, 0x1000);
+
+	status |= mock_expect (&store.aes.mock, store.aes.base.encrypt_data, &store.aes, 0,
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)),
+		MOCK_ARG_PTR_CONTAINS (iv, AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (data)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_GCM_TAG_LEN));
+	status |= mock_expect_output (&store.aes.mock, 4, enc, sizeof (enc), 5);
+	status |= mock_expect_output (&store.aes.mock, 6, AES_RSA_PRIVKEY_GCM_TAG, AES_GCM_TAG_LEN, 7);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (enc),
+		MOCK_ARG (data_addr), MOCK_ARG_PTR_CONTAINS (enc, sizeof (enc)), MOCK_ARG (sizeof (enc)));
+	status |= flash_mock_expect_verify_flash (&store.flash, data_addr, enc, sizeof (enc));
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash,
+		AES_GCM_TAG_LEN, MOCK_ARG (data_addr + sizeof (enc) + AES_IV_LEN),
+		MOCK_ARG_PTR_CONTAINS (AES_RSA_PRIVKEY_GCM_TAG, AES_GCM_TAG_LEN),
+		MOCK_ARG (AES_GCM_TAG_LEN));
+	status |= flash_mock_expect_verify_flash (&store.flash,
+		data_addr + sizeof (enc) + AES_IV_LEN, AES_RSA_PRIVKEY_GCM_TAG, AES_GCM_TAG_LEN);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, AES_IV_LEN,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_PTR_CONTAINS (AES_IV, AES_IV_LEN),
+		MOCK_ARG (AES_IV_LEN));
+	status |= flash_mock_expect_verify_flash (&store.flash, data_addr + sizeof (enc), AES_IV,
+		AES_IV_LEN);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (header),
+		MOCK_ARG (0xf000), MOCK_ARG_PTR_CONTAINS (header, sizeof (header)),
+		MOCK_ARG (sizeof (header)));
+	status |= flash_mock_expect_verify_flash (&store.flash, 0xf000, header, sizeof (header));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.write (&store.test.base.base, 1, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_min_write (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x40, 0x00};
+	uint8_t data[64];
+	uint8_t enc[sizeof (data)];
+	uint8_t iv[2][AES_IV_LEN];
+	uint8_t tag[2][AES_GCM_TAG_LEN];
+	uint8_t write[sizeof (header) + sizeof (enc) + AES_IV_LEN + sizeof (tag)];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (data); i++) {
+		data[i] = i;
+		enc[i] = ~i;
+	}
+
+	for (i = 0; i < 2; i++) {
+		flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv[i], i, (i == 1));
+		memset (tag[i], 0x20 + i, AES_GCM_TAG_LEN);
+	}
+
+	memcpy (write, header, sizeof (header));
+	memcpy (&write[sizeof (header)], enc, sizeof (enc));
+	memcpy (&write[sizeof (header) + sizeof (enc)], AES_IV, AES_IV_LEN);
+	memcpy (&write[sizeof (header) + sizeof (enc) + AES_IV_LEN], tag, sizeof (tag));
+
+	/* Flash that requires full page writes encrypts all chunks before writing. */
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 0x100);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 32);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.rng.mock, store.rng.base.generate_random_buffer, &store.rng, 0,
+		MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&store.rng.mock, 1, AES_IV, AES_IV_LEN, 0);
+
+	for (i = 0; i < 2; i++) {
+		status |= mock_expect (&store.aes.mock, store.aes.base.encrypt_data, &store.aes, 0,
+			MOCK_ARG_PTR_CONTAINS (&data[i * 32], 32), MOCK_ARG (32),
+			MOCK_ARG_PTR_CONTAINS (iv[i], AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (32), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_GCM_TAG_LEN));
+		status |= mock_expect_output (&store.aes.mock, 4, &enc[i * 32], 32, 5);
+		status |= mock_expect_output (&store.aes.mock, 6, tag[i], AES_GCM_TAG_LEN, 7);
+	}
+
+	status |= flash_mock_expect_erase_flash_sector (&store.flash, 0x10000, 0x1000);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (write),
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (write, sizeof (write)),
+		MOCK_ARG (sizeof (write)));
+	status |= flash_mock_expect_verify_flash (&store.flash, 0x10000, write, sizeof (write));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.write (&store.test.base.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_rng_error (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t data[600];
+
+	TEST_START;
+
+	memset (data, 0x55, sizeof (data));
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.rng.mock, store.rng.base.generate_random_buffer, &store.rng,
+		RNG_ENGINE_RANDOM_FAILED, MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.write (&store.test.base.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, RNG_ENGINE_RANDOM_FAILED, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_encrypt_error (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t data[600];
+	uint8_t enc[256];
+	uint8_t iv[AES_IV_LEN];
+	uint32_t data_addr = 0x10000 + FLASH_STORE_HEADER_LENGTH;
+
+	TEST_START;
+
+	memset (data, 0x55, sizeof (data));
+	memset (enc, 0xaa, sizeof (enc));
+
+	flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv, 1, false);
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.rng.mock, store.rng.base.generate_random_buffer, &store.rng, 0,
+		MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&store.rng.mock, 1, AES_IV, AES_IV_LEN, 0);
+
+	status |= flash_mock_expect_erase_flash_sector (&store.flash, 0x10000, 0x1000);
+
+	status |= mock_expect (&store.aes.mock, store.aes.base.encrypt_data, &store.aes, 0,
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (enc)), MOCK_ARG (sizeof (enc)),
+		MOCK_ARG_PTR_CONTAINS (AES_IV, AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_GCM_TAG_LEN));
+	status |= mock_expect_output (&store.aes.mock, 4, enc, sizeof (enc), 5);
+	status |= mock_expect_output (&store.aes.mock, 6, AES_RSA_PRIVKEY_GCM_TAG, AES_GCM_TAG_LEN, 7);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (enc),
+		MOCK_ARG (data_addr), MOCK_ARG_PTR_CONTAINS (enc, sizeof (enc)), MOCK_ARG (sizeof (enc)));
+	status |= flash_mock_expect_verify_flash (&store.flash, data_addr, enc, sizeof (enc));
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash,
+		AES_GCM_TAG_LEN, MOCK_ARG (data_addr + sizeof (data) + AES_IV_LEN),
+		MOCK_ARG_PTR_CONTAINS (AES_RSA_PRIVKEY_GCM_TAG, AES_GCM_TAG_LEN),
+		MOCK_ARG (AES_GCM_TAG_LEN));
+	status |= flash_mock_expect_verify_flash (&store.flash,
+		data_addr + sizeof (data) + AES_IV_LEN, AES_RSA_PRIVKEY_GCM_TAG, AES_GCM_TAG_LEN);
+
+	status |= mock_expect (&store.aes.mock, store.aes.base.encrypt_data, &store.aes,
+		AES_ENGINE_ENCRYPT_FAILED, MOCK_ARG_PTR_CONTAINS (&data[256], 256), MOCK_ARG (256),
+		MOCK_ARG_PTR_CONTAINS (iv, AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (256), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_GCM_TAG_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.write (&store.test.base.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, AES_ENGINE_ENCRYPT_FAILED, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_erase_error (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t data[600];
+
+	TEST_START;
+
+	memset (data, 0x55, sizeof (data));
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.rng.mock, store.rng.base.generate_random_buffer, &store.rng, 0,
+		MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&store.rng.mock, 1, AES_IV, AES_IV_LEN, 0);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.get_sector_size, &store.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.write (&store.test.base.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t data[600];
+	uint8_t enc[sizeof (data)];
+	uint8_t out[0x1000] = {0};
+	uint8_t iv[3][AES_IV_LEN];
+	uint8_t tag[3][AES_GCM_TAG_LEN];
+	size_t length[] = {256, 256, 88};
+	uint32_t data_addr = 0x10000 + sizeof (header);
+	uint32_t tag_addr = data_addr + sizeof (data) + AES_IV_LEN;
+	size_t offset;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (data); i++) {
+		data[i] = i;
+		enc[i] = ~i;
+	}
+
+	for (i = 0; i < 3; i++) {
+		flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv[i], i, (i == 2));
+		memset (tag[i], 0x10 + i, AES_GCM_TAG_LEN);
+	}
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (enc)));
+	status |= mock_expect_output (&store.flash.mock, 1, enc, sizeof (enc), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_IV_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, AES_IV, AES_IV_LEN, 2);
+
+	for (i = 0, offset = 0; i < 3; offset += length[i], i++) {
+		status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+			MOCK_ARG (tag_addr + (AES_GCM_TAG_LEN * i)), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (AES_GCM_TAG_LEN));
+		status |= mock_expect_output (&store.flash.mock, 1, tag[i], AES_GCM_TAG_LEN, 2);
+
+		status |= mock_expect (&store.aes.mock, store.aes.base.decrypt_data, &store.aes, 0,
+			MOCK_ARG_PTR_CONTAINS (&enc[offset], length[i]), MOCK_ARG (length[i]),
+			MOCK_ARG_PTR_CONTAINS (tag[i], AES_GCM_TAG_LEN),
+			MOCK_ARG_PTR_CONTAINS (iv[i], AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (length[i]));
+		status |= mock_expect_output (&store.aes.mock, 5, &data[offset], length[i], 6);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.read (&store.test.base.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = testing_validate_array (data, out, status);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_corrupt_data (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t enc[600];
+	uint8_t out[0x1000] = {0};
+	uint8_t tag[AES_GCM_TAG_LEN];
+	uint32_t data_addr = 0x10000 + sizeof (header);
+
+	TEST_START;
+
+	memset (enc, 0xaa, sizeof (enc));
+	memset (tag, 0x10, sizeof (tag));
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (enc), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (enc)));
+	status |= mock_expect_output (&store.flash.mock, 1, enc, sizeof (enc), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_IV_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, AES_IV, AES_IV_LEN, 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc) + AES_IV_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (AES_GCM_TAG_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, tag, AES_GCM_TAG_LEN, 2);
+
+	status |= mock_expect (&store.aes.mock, store.aes.base.decrypt_data, &store.aes,
+		AES_ENGINE_GCM_AUTH_FAILED, MOCK_ARG_PTR_CONTAINS (enc, 256), MOCK_ARG (256),
+		MOCK_ARG_PTR_CONTAINS (tag, AES_GCM_TAG_LEN), MOCK_ARG_PTR_CONTAINS (AES_IV, AES_IV_LEN),
+		MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (256));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.read (&store.test.base.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_CORRUPT_DATA, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_null (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t out[0x1000];
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.read (NULL, 0, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.base.read (&store.test.base.base, 0, NULL, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.base.read (&store.test.base.base, 3, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_small_buffer (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t out[0x258 - 1];
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.read (&store.test.base.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_BUFFER_TOO_SMALL, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_no_data (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0xff, 0xff, 0xff, 0xff};
+	uint8_t out[0x1000];
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.read (&store.test.base.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_tag_read_error (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x00, 0x01};
+	uint8_t enc[256];
+	uint8_t out[0x1000];
+	uint32_t data_addr = 0x10000 + sizeof (header);
+
+	TEST_START;
+
+	memset (enc, 0xaa, sizeof (enc));
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (enc)));
+	status |= mock_expect_output (&store.flash.mock, 1, enc, sizeof (enc), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_IV_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, AES_IV, AES_IV_LEN, 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash,
+		FLASH_READ_FAILED, MOCK_ARG (data_addr + sizeof (enc) + AES_IV_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (AES_GCM_TAG_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.base.read (&store.test.base.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_range_single_chunk (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t data[600];
+	uint8_t enc[sizeof (data)];
+	uint8_t out[0x1000];
+	uint8_t iv[3][AES_IV_LEN];
+	uint8_t tag[3][AES_GCM_TAG_LEN];
+	size_t length[] = {256, 256, 88};
+	uint32_t data_addr = 0x10000 + sizeof (header);
+	uint32_t tag_addr = data_addr + sizeof (data) + AES_IV_LEN;
+	size_t offset;
+	int first = 1;
+	int last = 1;
+	int i;
+
+	TEST_START;
+
+	memset (out, 0x55, sizeof (out));
+
+	for (i = 0; i < (int) sizeof (data); i++) {
+		data[i] = i;
+		enc[i] = ~i;
+	}
+
+	for (i = 0; i < 3; i++) {
+		flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv[i], i, (i == 2));
+		memset (tag[i], 0x10 + i, AES_GCM_TAG_LEN);
+	}
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_IV_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, AES_IV, AES_IV_LEN, 2);
+
+	for (i = first; i <= last; i++) {
+		offset = i * 256;
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+			MOCK_ARG (tag_addr + (AES_GCM_TAG_LEN * i)), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (AES_GCM_TAG_LEN));
+		status |= mock_expect_output (&store.flash.mock, 1, tag[i], AES_GCM_TAG_LEN, 2);
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+			MOCK_ARG (data_addr + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (length[i]));
+		status |= mock_expect_output (&store.flash.mock, 1, &enc[offset], length[i], 2);
+
+		status |= mock_expect (&store.aes.mock, store.aes.base.decrypt_data, &store.aes, 0,
+			MOCK_ARG_PTR_CONTAINS (&enc[offset], length[i]), MOCK_ARG (length[i]),
+			MOCK_ARG_PTR_CONTAINS (tag[i], AES_GCM_TAG_LEN),
+			MOCK_ARG_PTR_CONTAINS (iv[i], AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (length[i]));
+		status |= mock_expect_output (&store.aes.mock, 5, &data[offset], length[i], 6);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only the chunk containing the requested data is read and authenticated. */
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 0, 256, out,
+		256);
+	CuAssertIntEquals (test, 256, status);
+
+	status = testing_validate_array (&data[256], out, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0x55, out[256]);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_range_partial_chunks (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t data[600];
+	uint8_t enc[sizeof (data)];
+	uint8_t out[0x1000];
+	uint8_t iv[3][AES_IV_LEN];
+	uint8_t tag[3][AES_GCM_TAG_LEN];
+	size_t length[] = {256, 256, 88};
+	uint32_t data_addr = 0x10000 + sizeof (header);
+	uint32_t tag_addr = data_addr + sizeof (data) + AES_IV_LEN;
+	size_t offset;
+	int first = 0;
+	int last = 2;
+	int i;
+
+	TEST_START;
+
+	memset (out, 0x55, sizeof (out));
+
+	for (i = 0; i < (int) sizeof (data); i++) {
+		data[i] = i;
+		enc[i] = ~i;
+	}
+
+	for (i = 0; i < 3; i++) {
+		flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv[i], i, (i == 2));
+		memset (tag[i], 0x10 + i, AES_GCM_TAG_LEN);
+	}
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_IV_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, AES_IV, AES_IV_LEN, 2);
+
+	for (i = first; i <= last; i++) {
+		offset = i * 256;
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+			MOCK_ARG (tag_addr + (AES_GCM_TAG_LEN * i)), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (AES_GCM_TAG_LEN));
+		status |= mock_expect_output (&store.flash.mock, 1, tag[i], AES_GCM_TAG_LEN, 2);
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+			MOCK_ARG (data_addr + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (length[i]));
+		status |= mock_expect_output (&store.flash.mock, 1, &enc[offset], length[i], 2);
+
+		status |= mock_expect (&store.aes.mock, store.aes.base.decrypt_data, &store.aes, 0,
+			MOCK_ARG_PTR_CONTAINS (&enc[offset], length[i]), MOCK_ARG (length[i]),
+			MOCK_ARG_PTR_CONTAINS (tag[i], AES_GCM_TAG_LEN),
+			MOCK_ARG_PTR_CONTAINS (iv[i], AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (length[i]));
+		status |= mock_expect_output (&store.aes.mock, 5, &data[offset], length[i], 6);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	/* The first and last chunks only partially overlap the requested data. */
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 0, 200, out,
+		350);
+	CuAssertIntEquals (test, 350, status);
+
+	status = testing_validate_array (&data[200], out, 350);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0x55, out[350]);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_range_past_end (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t data[600];
+	uint8_t enc[sizeof (data)];
+	uint8_t out[0x1000];
+	uint8_t iv[3][AES_IV_LEN];
+	uint8_t tag[3][AES_GCM_TAG_LEN];
+	size_t length[] = {256, 256, 88};
+	uint32_t data_addr = 0x10000 + sizeof (header);
+	uint32_t tag_addr = data_addr + sizeof (data) + AES_IV_LEN;
+	size_t offset;
+	int first = 1;
+	int last = 2;
+	int i;
+
+	TEST_START;
+
+	memset (out, 0x55, sizeof (out));
+
+	for (i = 0; i < (int) sizeof (data); i++) {
+		data[i] = i;
+		enc[i] = ~i;
+	}
+
+	for (i = 0; i < 3; i++) {
+		flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv[i], i, (i == 2));
+		memset (tag[i], 0x10 + i, AES_GCM_TAG_LEN);
+	}
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (data), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_IV_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, AES_IV, AES_IV_LEN, 2);
+
+	for (i = first; i <= last; i++) {
+		offset = i * 256;
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+			MOCK_ARG (tag_addr + (AES_GCM_TAG_LEN * i)), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (AES_GCM_TAG_LEN));
+		status |= mock_expect_output (&store.flash.mock, 1, tag[i], AES_GCM_TAG_LEN, 2);
+
+		status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+			MOCK_ARG (data_addr + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (length[i]));
+		status |= mock_expect_output (&store.flash.mock, 1, &enc[offset], length[i], 2);
+
+		status |= mock_expect (&store.aes.mock, store.aes.base.decrypt_data, &store.aes, 0,
+			MOCK_ARG_PTR_CONTAINS (&enc[offset], length[i]), MOCK_ARG (length[i]),
+			MOCK_ARG_PTR_CONTAINS (tag[i], AES_GCM_TAG_LEN),
+			MOCK_ARG_PTR_CONTAINS (iv[i], AES_IV_LEN), MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL,
+			MOCK_ARG (length[i]));
+		status |= mock_expect_output (&store.aes.mock, 5, &data[offset], length[i], 6);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	/* The range is truncated to the end of the stored data. */
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 0, 500, out,
+		4096);
+	CuAssertIntEquals (test, 100, status);
+
+	status = testing_validate_array (&data[500], out, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0x55, out[100]);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_range_offset_at_end (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t out[0x1000];
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 600, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 0, 600, out,
+		sizeof (out));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_range_corrupt_data (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t header[] = {0x04, 0xa5, 0x58, 0x02};
+	uint8_t enc[600];
+	uint8_t out[0x1000];
+	uint8_t iv[AES_IV_LEN];
+	uint8_t tag[AES_GCM_TAG_LEN];
+	uint32_t data_addr = 0x10000 + sizeof (header);
+	uint32_t tag_addr = data_addr + sizeof (enc) + AES_IV_LEN;
+
+	TEST_START;
+
+	memset (enc, 0xaa, sizeof (enc));
+	memset (tag, 0x10, sizeof (tag));
+	flash_store_contiguous_blocks_encrypted_testing_chunk_iv (iv, 1, false);
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, sizeof (enc), &store.aes.base,
+		&store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + sizeof (enc)), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_IV_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, AES_IV, AES_IV_LEN, 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (tag_addr + AES_GCM_TAG_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (AES_GCM_TAG_LEN));
+	status |= mock_expect_output (&store.flash.mock, 1, tag, AES_GCM_TAG_LEN, 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (data_addr + 256), MOCK_ARG_NOT_NULL, MOCK_ARG (256));
+	status |= mock_expect_output (&store.flash.mock, 1, &enc[256], 256, 2);
+
+	status |= mock_expect (&store.aes.mock, store.aes.base.decrypt_data, &store.aes,
+		AES_ENGINE_GCM_AUTH_FAILED, MOCK_ARG_PTR_CONTAINS (&enc[256], 256), MOCK_ARG (256),
+		MOCK_ARG_PTR_CONTAINS (tag, AES_GCM_TAG_LEN), MOCK_ARG_PTR_CONTAINS (iv, AES_IV_LEN),
+		MOCK_ARG (AES_IV_LEN), MOCK_ARG_NOT_NULL, MOCK_ARG (256));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 0, 300, out, 10);
+	CuAssertIntEquals (test, FLASH_STORE_CORRUPT_DATA, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_range_null (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t out[0x1000];
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage_chunked (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_encrypted_read_range (NULL, 0, 0, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 0, 0, NULL,
+		sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 3, 0, out,
+		sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_encrypted_test_read_range_not_chunked (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_encrypted_testing store;
+	int status;
+	uint8_t out[0x1000];
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_encrypted_testing_prepare_init (test, &store, 0x100, 0x1000,
+		0x100000, 1);
+
+	status = flash_store_contiguous_blocks_encrypted_init_variable_storage (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, &store.aes.base, &store.rng.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_encrypted_read_range (&store.test, 0, 0, out,
+		sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_contiguous_blocks_encrypted_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_encrypted_release (&store.test);
+}
 
 TEST_SUITE_START (flash_store_contiguous_blocks_encrypted);
 
@@ -15486,5 +16746,31 @@ TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_old_for
 TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_read_error);
 TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_read_tag_error);
 TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_decrypt_error);
+TEST (flash_store_contiguous_blocks_encrypted_test_init_variable_storage_chunked);
+TEST (flash_store_contiguous_blocks_encrypted_test_init_variable_storage_chunked_partial_chunk_max_space);
+TEST (flash_store_contiguous_blocks_encrypted_test_init_variable_storage_chunked_null);
+TEST (flash_store_contiguous_blocks_encrypted_test_init_variable_storage_decreasing_chunked);
+TEST (flash_store_contiguous_blocks_encrypted_test_init_variable_storage_decreasing_chunked_null);
+TEST (flash_store_contiguous_blocks_encrypted_test_static_init_variable_storage_chunked);
+TEST (flash_store_contiguous_blocks_encrypted_test_static_init_variable_storage_decreasing_chunked);
+TEST (flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked);
+TEST (flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_single_chunk);
+TEST (flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_min_write);
+TEST (flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_rng_error);
+TEST (flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_encrypt_error);
+TEST (flash_store_contiguous_blocks_encrypted_test_write_variable_storage_chunked_erase_error);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_corrupt_data);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_null);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_small_buffer);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_no_data);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_variable_storage_chunked_tag_read_error);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_range_single_chunk);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_range_partial_chunks);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_range_past_end);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_range_offset_at_end);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_range_corrupt_data);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_range_null);
+TEST (flash_store_contiguous_blocks_encrypted_test_read_range_not_chunked);
 
 TEST_SUITE_END;
@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <string.h>
 #include "testing.h"
+#include "flash/flash_common.h"
 #include "flash/flash_store_contiguous_blocks.h"
 #include "flash/flash_store_contiguous_blocks_static.h"
 #include "testing/mock/crypto/hash_mock.h"
@@ -90,6 +91,39 @@ static void flash_store_contiguous_blocks_testing_prepare_init (CuTest *test,
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Helper to enable the block index on a variable storage instance with three blocks.
+ *
+ * @param test The test framework.
+ * @param store Testing dependencies with an initialized flash store.
+ * @param index The block index to use.
+ * @param count The number of entries in the block index.
+ * @param addr List of flash addresses for each block header.
+ * @param headers List of header data stored in each block.
+ */
+static void flash_store_contiguous_blocks_testing_enable_block_index (CuTest *test,
+	struct flash_store_contiguous_blocks_testing *store, struct flash_store_block_index *index,
+	size_t count, const uint32_t addr[3], uint8_t headers[3][4])
+{
+	int status;
+	int i;
+
+	status = 0;
+	for (i = 0; i < 3; i++) {
+		status |= mock_expect (&store->flash.mock, store->flash.base.read, &store->flash, 0,
+			MOCK_ARG (addr[i]), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+		status |= mock_expect_output (&store->flash.mock, 1, headers[i], 4, 2);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_enable_block_index (&store->test, index, count);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&store->flash.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
 /**
  * Helper to validate mocks and release all testing dependencies.
  *
@@ -17171,7 +17205,7 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage (CuTest *
 		&store.flash.base, 0x10000, 3, 256, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0x10000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0x10000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17197,8 +17231,8 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage_multiple_
 		&store.flash.base, 0x10000, 3, 512, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0x10000,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0x10000,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17224,8 +17258,8 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage_extra_sec
 		&store.flash.base, 0x10000, 3, 512, &store.hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0x10000,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0x10000,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17252,7 +17286,7 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage_static_in
 	status = flash_store_contiguous_blocks_init_state (&test_static, 3, 256);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0x10000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0x10000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = test_static.base.erase_all (&test_static.base);
@@ -17276,7 +17310,7 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage_decreasin
 		&store.flash.base, 0x10000, 3, 256, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0xe000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0xe000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17302,8 +17336,8 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage_decreasin
 		&store.flash.base, 0x10000, 3, 512, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0xfc00,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0xfc00,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17329,8 +17363,8 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage_decreasin
 		&store.flash.base, 0x10000, 3, 512, &store.hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0xf800,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0xf800,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17358,7 +17392,7 @@ static void flash_store_contiguous_blocks_test_erase_all_fixed_storage_decreasin
 	status = flash_store_contiguous_blocks_init_state (&test_static, 3, 256);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0xe000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0xe000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = test_static.base.erase_all (&test_static.base);
@@ -17382,7 +17416,7 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage (CuTes
 		&store.flash.base, 0x10000, 3, 256, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0x10000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0x10000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17408,8 +17442,8 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_multip
 		&store.flash.base, 0x10000, 3, 508, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0x10000,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0x10000,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17435,8 +17469,8 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_extra_
 		&store.flash.base, 0x10000, 3, 512, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0x10000,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0x10000,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17462,8 +17496,8 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_extra_
 		&store.flash.base, 0x10000, 3, 508, &store.hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0x10000,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0x10000,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17490,7 +17524,7 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_static
 	status = flash_store_contiguous_blocks_init_state (&test_static, 3, 256);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0x10000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0x10000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = test_static.base.erase_all (&test_static.base);
@@ -17514,7 +17548,7 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_decrea
 		&store.state, &store.flash.base, 0x10000, 3, 256, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0xe000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0xe000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17540,8 +17574,8 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_decrea
 		&store.state, &store.flash.base, 0x10000, 3, 508, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0xfc00,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0xfc00,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17567,8 +17601,8 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_decrea
 		&store.state, &store.flash.base, 0x10000, 3, 512, NULL);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0xf800,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0xf800,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17594,8 +17628,8 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_decrea
 		&store.state, &store.flash.base, 0x10000, 3, 508, &store.hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify_ext (&store.flash, 0xf800,
-		(sector * 2) * 3, sector);
+	status = flash_mock_expect_erase_flash_optimal_verify_ext (&store.flash, 0xf800,
+		(sector * 2) * 3, sector, FLASH_BLOCK_SIZE, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = store.test.base.erase_all (&store.test.base);
@@ -17623,7 +17657,7 @@ static void flash_store_contiguous_blocks_test_erase_all_variable_storage_decrea
 	status = flash_store_contiguous_blocks_init_state (&test_static, 3, 256);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0xe000, 0x1000 * 3);
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0xe000, 0x1000 * 3);
 	CuAssertIntEquals (test, 0, status);
 
 	status = test_static.base.erase_all (&test_static.base);
@@ -20006,6 +20040,722 @@ static void flash_store_contiguous_blocks_test_has_data_stored_variable_storage_
 	flash_store_contiguous_blocks_release (&store.test);
 }
 
+static void flash_store_contiguous_blocks_test_enable_block_index (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0xff, 0xff, 0xff, 0xff},
+		{0x80, 0x00, 0xff, 0xff}
+	};
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	/* No flash accesses are necessary to query the stored data. */
+	status = store.test.base.get_data_length (&store.test.base, 0);
+	CuAssertIntEquals (test, 0x100, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 1);
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 2);
+	CuAssertIntEquals (test, 0x80, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 0);
+	CuAssertIntEquals (test, 1, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 2);
+	CuAssertIntEquals (test, 1, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_enable_block_index_decreasing (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[4];
+	const uint32_t addr[] = {0x10000, 0xf000, 0xe000};
+	uint8_t headers[3][4] = {
+		{0xff, 0xff, 0xff, 0xff},
+		{0x04, 0xa5, 0x20, 0x00},
+		{0x04, 0xa5, 0x40, 0x00}
+	};
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage_decreasing (&store.test,
+		&store.state, &store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 4, addr,
+		headers);
+
+	status = store.test.base.get_data_length (&store.test.base, 0);
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 1);
+	CuAssertIntEquals (test, 0x20, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 2);
+	CuAssertIntEquals (test, 0x40, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_enable_block_index_static_init (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_contiguous_blocks test_static =
+		flash_store_contiguous_blocks_static_init_variable_storage (
+		FLASH_STORE_CONTIGUOUS_BLOCKS_NO_HASH_API_INIT, &store.state, 0x10000, &store.flash.base,
+		NULL);
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x10, 0x00},
+		{0xff, 0xff, 0xff, 0xff}
+	};
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_state (&test_static, 3, 256);
+	CuAssertIntEquals (test, 0, status);
+
+	store.test = test_static;
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = test_static.base.has_data_stored (&test_static.base, 0);
+	CuAssertIntEquals (test, 1, status);
+
+	status = test_static.base.get_data_length (&test_static.base, 1);
+	CuAssertIntEquals (test, 0x10, status);
+
+	status = test_static.base.has_data_stored (&test_static.base, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&test_static);
+}
+
+static void flash_store_contiguous_blocks_test_enable_block_index_fixed_storage (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_fixed_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_enable_block_index (&store.test, index, 3);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, store.state.index);
+
+	status = store.test.base.get_data_length (&store.test.base, 0);
+	CuAssertIntEquals (test, 256, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_enable_block_index_null (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_enable_block_index (NULL, index, 3);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_contiguous_blocks_enable_block_index (&store.test, NULL, 3);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, store.state.index);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_enable_block_index_too_small (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_enable_block_index (&store.test, index, 2);
+	CuAssertIntEquals (test, FLASH_STORE_INSUFFICIENT_STORAGE, status);
+
+	CuAssertPtrEquals (test, NULL, store.state.index);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_enable_block_index_read_error (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	uint8_t header0[] = {0x04, 0xa5, 0x00, 0x01};
+	uint8_t header2[] = {0xff, 0xff, 0xff, 0xff};
+	uint8_t header1[] = {0x04, 0xa5, 0x30, 0x00};
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&store.flash.mock, 1, header0, sizeof (header0), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash,
+		FLASH_READ_FAILED, MOCK_ARG (0x11000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x12000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&store.flash.mock, 1, header2, sizeof (header2), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_contiguous_blocks_enable_block_index (&store.test, index, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The block that could not be read will be read on the next access. */
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x11000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&store.flash.mock, 1, header1, sizeof (header1), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 1);
+	CuAssertIntEquals (test, 0x30, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 1);
+	CuAssertIntEquals (test, 1, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 0);
+	CuAssertIntEquals (test, 0x100, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_read_with_block_index (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0xff, 0xff, 0xff, 0xff},
+		{0x00, 0x01, 0xff, 0xff}
+	};
+	uint8_t data[256];
+	uint8_t out[0x1000] = {0};
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, sizeof (data), NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	/* Only the data is read from flash. */
+	status = mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000 + 4), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&store.flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x12000 + 2), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&store.flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.read (&store.test.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = testing_validate_array (data, out, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.read (&store.test.base, 1, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	memset (out, 0, sizeof (out));
+
+	status = store.test.base.read (&store.test.base, 2, out, sizeof (out));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = testing_validate_array (data, out, status);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_read_with_block_index_buffer_too_small (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0xff, 0xff, 0xff, 0xff},
+		{0xff, 0xff, 0xff, 0xff}
+	};
+	uint8_t out[0x100 - 1];
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = store.test.base.read (&store.test.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_BUFFER_TOO_SMALL, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_write_with_block_index (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0xff, 0xff, 0xff, 0xff},
+		{0xff, 0xff, 0xff, 0xff},
+		{0xff, 0xff, 0xff, 0xff}
+	};
+	uint8_t header[] = {0x04, 0xa5, 0x80, 0x00};
+	uint8_t data[0x80];
+	uint8_t out[0x1000] = {0};
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = flash_mock_expect_erase_flash_sector (&store.flash, 0x11000, 0x1000);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (data),
+		MOCK_ARG (0x11000 + sizeof (header)), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)),
+		MOCK_ARG (sizeof (data)));
+	status |= flash_mock_expect_verify_flash (&store.flash, 0x11000 + sizeof (header), data,
+		sizeof (data));
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (header),
+		MOCK_ARG (0x11000), MOCK_ARG_PTR_CONTAINS (header, sizeof (header)),
+		MOCK_ARG (sizeof (header)));
+	status |= flash_mock_expect_verify_flash (&store.flash, 0x11000, header, sizeof (header));
+
+	/* Reading the data back does not need to read the header. */
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x11000 + sizeof (header)), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&store.flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 1, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 1);
+	CuAssertIntEquals (test, 1, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 1);
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = store.test.base.read (&store.test.base, 1, out, sizeof (out));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = testing_validate_array (data, out, status);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_write_with_block_index_old_header (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0xff, 0xff, 0xff, 0xff},
+		{0xff, 0xff, 0xff, 0xff},
+		{0xff, 0xff, 0xff, 0xff}
+	};
+	uint8_t header[] = {0x80, 0x00};
+	uint8_t data[0x80];
+	uint8_t out[0x1000] = {0};
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (data); i++) {
+		data[i] = i;
+	}
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_use_length_only_header (&store.test);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = flash_mock_expect_erase_flash_sector (&store.flash, 0x10000, 0x1000);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (data),
+		MOCK_ARG (0x10000 + sizeof (header)), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)),
+		MOCK_ARG (sizeof (data)));
+	status |= flash_mock_expect_verify_flash (&store.flash, 0x10000 + sizeof (header), data,
+		sizeof (data));
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.write, &store.flash, sizeof (header),
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (header, sizeof (header)),
+		MOCK_ARG (sizeof (header)));
+	status |= flash_mock_expect_verify_flash (&store.flash, 0x10000, header, sizeof (header));
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000 + sizeof (header)), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&store.flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.read (&store.test.base, 0, out, sizeof (out));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = testing_validate_array (data, out, status);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_write_with_block_index_erase_error (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0xff, 0xff, 0xff, 0xff},
+		{0xff, 0xff, 0xff, 0xff}
+	};
+	uint8_t header[] = {0x04, 0xa5, 0x00, 0x01};
+	uint8_t data[256];
+	int status;
+
+	TEST_START;
+
+	memset (data, 0x55, sizeof (data));
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, sizeof (data), NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.get_sector_size, &store.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+
+	/* The state of the block is unknown, so it must be read from flash. */
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 0);
+	CuAssertIntEquals (test, 0x100, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 0);
+	CuAssertIntEquals (test, 0x100, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_erase_with_block_index (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01}
+	};
+	uint8_t out[0x1000];
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = flash_mock_expect_erase_flash_sector_verify (&store.flash, 0x12000, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.erase (&store.test.base, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.read (&store.test.base, 2, out, sizeof (out));
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 1);
+	CuAssertIntEquals (test, 1, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_erase_with_block_index_erase_error (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01}
+	};
+	uint8_t header[] = {0xff, 0xff, 0xff, 0xff};
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.get_sector_size, &store.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.erase (&store.test.base, 0);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_erase_all_with_block_index (CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01}
+	};
+	int status;
+	int i;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = flash_mock_expect_erase_flash_optimal_verify (&store.flash, 0x10000, 0x1000 * 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.erase_all (&store.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 3; i++) {
+		status = store.test.base.has_data_stored (&store.test.base, i);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
+static void flash_store_contiguous_blocks_test_erase_all_with_block_index_erase_error (
+	CuTest *test)
+{
+	struct flash_store_contiguous_blocks_testing store;
+	struct flash_store_block_index index[3];
+	const uint32_t addr[] = {0x10000, 0x11000, 0x12000};
+	uint8_t headers[3][4] = {
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01},
+		{0x04, 0xa5, 0x00, 0x01}
+	};
+	uint8_t header[] = {0x04, 0xa5, 0x10, 0x00};
+	int status;
+
+	TEST_START;
+
+	flash_store_contiguous_blocks_testing_prepare_init (test, &store, 0x100, 0x1000, 0x100000, 1);
+
+	status = flash_store_contiguous_blocks_init_variable_storage (&store.test, &store.state,
+		&store.flash.base, 0x10000, 3, 256, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_contiguous_blocks_testing_enable_block_index (test, &store, index, 3, addr,
+		headers);
+
+	status = mock_expect (&store.flash.mock, store.flash.base.get_sector_size, &store.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&store.flash.mock, store.flash.base.read, &store.flash, 0,
+		MOCK_ARG (0x11000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (header)));
+	status |= mock_expect_output (&store.flash.mock, 1, header, sizeof (header), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.erase_all (&store.test.base);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 1);
+	CuAssertIntEquals (test, 0x10, status);
+
+	flash_store_contiguous_blocks_testing_release_dependencies (test, &store);
+
+	flash_store_contiguous_blocks_release (&store.test);
+}
+
 
 TEST_SUITE_START (flash_store_contiguous_blocks);
 
@@ -20502,5 +21252,21 @@ TEST (flash_store_contiguous_blocks_test_has_data_stored_variable_storage_invali
 TEST (flash_store_contiguous_blocks_test_has_data_stored_variable_storage_short_header);
 TEST (flash_store_contiguous_blocks_test_has_data_stored_variable_storage_invalid_data_length);
 TEST (flash_store_contiguous_blocks_test_has_data_stored_variable_storage_old_format_invalid_data_length);
+TEST (flash_store_contiguous_blocks_test_enable_block_index);
+TEST (flash_store_contiguous_blocks_test_enable_block_index_decreasing);
+TEST (flash_store_contiguous_blocks_test_enable_block_index_static_init);
+TEST (flash_store_contiguous_blocks_test_enable_block_index_fixed_storage);
+TEST (flash_store_contiguous_blocks_test_enable_block_index_null);
+TEST (flash_store_contiguous_blocks_test_enable_block_index_too_small);
+TEST (flash_store_contiguous_blocks_test_enable_block_index_read_error);
+TEST (flash_store_contiguous_blocks_test_read_with_block_index);
+TEST (flash_store_contiguous_blocks_test_read_with_block_index_buffer_too_small);
+TEST (flash_store_contiguous_blocks_test_write_with_block_index);
+TEST (flash_store_contiguous_blocks_test_write_with_block_index_old_header);
+TEST (flash_store_contiguous_blocks_test_write_with_block_index_erase_error);
+TEST (flash_store_contiguous_blocks_test_erase_with_block_index);
+TEST (flash_store_contiguous_blocks_test_erase_with_block_index_erase_error);
+TEST (flash_store_contiguous_blocks_test_erase_all_with_block_index);
+TEST (flash_store_contiguous_blocks_test_erase_all_with_block_index_erase_error);
 
 TEST_SUITE_END;
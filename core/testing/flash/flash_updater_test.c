@@ -219,7 +219,7 @@ static void flash_updater_test_prepare_for_update_sector (CuTest *test)
 	status = flash_updater_init_sector (&updater, &flash.base, 0x20000, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&flash, 0x20000, 10);
+	status = flash_mock_expect_erase_flash_optimal_verify (&flash, 0x20000, 10);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_updater_prepare_for_update (&updater, 10);
@@ -478,7 +478,7 @@ static void flash_updater_test_prepare_for_update_erase_all_sector (CuTest *test
 	status = flash_updater_init_sector (&updater, &flash.base, 0x20000, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_expect_erase_flash_sector_verify (&flash, 0x20000, 0x10000);
+	status = flash_mock_expect_erase_flash_optimal_verify (&flash, 0x20000, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_updater_prepare_for_update_erase_all (&updater, 10);
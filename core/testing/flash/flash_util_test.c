@@ -7,9 +7,12 @@
 #include "testing.h"
 #include "flash/flash_util.h"
 #include "flash/flash_common.h"
+#include "flash/flash_virtual_ram.h"
+#include "flash/spi_flash.h"
 #include "crypto/ecc.h"
 #include "testing/mock/crypto/hash_mock.h"
 #include "testing/mock/crypto/signature_verification_mock.h"
+#include "testing/mock/flash/flash_master_mock.h"
 #include "testing/mock/flash/flash_mock.h"
 #include "testing/engines/hash_testing_engine.h"
 #include "testing/engines/rsa_testing_engine.h"
@@ -22,6 +25,144 @@
 TEST_SUITE_LABEL ("flash_util");
 
 
+/**
+ * Amount of flash data used to exercise hashing across multiple block buffers.  This is enough to
+ * cycle through every buffer in the hashing pipeline more than once.
+ */
+#define	FLASH_UTIL_TESTING_HASH_DATA_LEN	\
+	((FLASH_HASH_BLOCK_SIZE * (FLASH_HASH_PIPELINE_DEPTH + 2)) + 0x80)
+
+/**
+ * A hash engine that fails after a set number of successful updates.  Updates before the failure
+ * are passed through to a real hash engine.
+ */
+struct flash_util_testing_failing_hash {
+	struct hash_engine base;			/**< The base hash engine. */
+	struct hash_engine *engine;			/**< The hash engine to pass successful updates to. */
+	int fail_after;						/**< Number of updates that should succeed. */
+	int updates;						/**< Number of updates that have been requested. */
+};
+
+/**
+ * Hash update handler that fails once the expected number of updates have been executed.
+ */
+static int flash_util_testing_failing_hash_update (struct hash_engine *engine,
+	const uint8_t *data, size_t length)
+{
+	struct flash_util_testing_failing_hash *hash = (struct flash_util_testing_failing_hash*) engine;
+
+	if (hash->updates++ >= hash->fail_after) {
+		return HASH_ENGINE_UPDATE_FAILED;
+	}
+
+	return hash->engine->update (hash->engine, data, length);
+}
+
+/**
+ * Initialize a hash engine that will fail after a set number of updates.
+ *
+ * @param hash The hash engine to initialize.
+ * @param engine The hash engine to pass successful updates to.
+ * @param fail_after The number of updates that should succeed.
+ */
+static void flash_util_testing_init_failing_hash (struct flash_util_testing_failing_hash *hash,
+	struct hash_engine *engine, int fail_after)
+{
+	memset (hash, 0, sizeof (*hash));
+
+	hash->base.update = flash_util_testing_failing_hash_update;
+	hash->engine = engine;
+	hash->fail_after = fail_after;
+}
+
+/**
+ * A hash engine that starts a second flash hashing request the first time it is updated.  Updates
+ * are passed through to a real hash engine.
+ */
+struct flash_util_testing_nested_hash {
+	struct hash_engine base;				/**< The base hash engine. */
+	struct hash_engine *engine;				/**< The hash engine to pass updates to. */
+	struct flash_hash_pipeline *pipeline;	/**< The pipeline the nested request should use. */
+	const struct flash *flash;				/**< The flash for the nested request. */
+	struct flash_region region;				/**< The flash region for the nested request. */
+	struct hash_engine *nested;				/**< The hash engine for the nested request. */
+	struct flash_hash_pipeline *check;		/**< Pipeline to check for an active request. */
+	bool check_busy;						/**< Active request state of the checked pipeline. */
+	int status;								/**< Result of the nested request. */
+	int updates;							/**< Number of updates that have been requested. */
+};
+
+/**
+ * Hash update handler that hashes flash data with a nested request before passing the update
+ * through.
+ */
+static int flash_util_testing_nested_hash_update (struct hash_engine *engine,
+	const uint8_t *data, size_t length)
+{
+	struct flash_util_testing_nested_hash *hash = (struct flash_util_testing_nested_hash*) engine;
+
+	if (hash->updates++ == 0) {
+		if (hash->check) {
+			hash->check_busy = hash->check->busy;
+		}
+
+		hash->status = flash_hash_update_noncontiguous_contents_pipelined (hash->pipeline,
+			hash->flash, 0, &hash->region, 1, hash->nested);
+	}
+
+	return hash->engine->update (hash->engine, data, length);
+}
+
+/**
+ * Initialize a hash engine that will run a nested flash hashing request.
+ *
+ * @param hash The hash engine to initialize.
+ * @param engine The hash engine to pass updates to.
+ * @param pipeline The pipeline the nested request should use.  Null to use the default pipeline.
+ * @param flash The flash for the nested request.
+ * @param start_addr Start of the flash region for the nested request.
+ * @param length Length of the flash region for the nested request.
+ * @param nested The hash engine for the nested request.  It must already be started.
+ */
+static void flash_util_testing_init_nested_hash (struct flash_util_testing_nested_hash *hash,
+	struct hash_engine *engine, struct flash_hash_pipeline *pipeline, const struct flash *flash,
+	uint32_t start_addr, size_t length, struct hash_engine *nested)
+{
+	memset (hash, 0, sizeof (*hash));
+
+	hash->base.update = flash_util_testing_nested_hash_update;
+	hash->engine = engine;
+	hash->pipeline = pipeline;
+	hash->flash = flash;
+	hash->region.start_addr = start_addr;
+	hash->region.length = length;
+	hash->nested = nested;
+}
+
+/**
+ * Initialize a virtual flash device containing data to hash.
+ *
+ * @param test The test framework.
+ * @param flash The virtual flash device to initialize.
+ * @param state Variable context for the flash device.
+ * @param data Buffer to use for flash contents.  It will be filled with test data.
+ * @param length Length of the flash buffer.
+ */
+static void flash_util_testing_init_hash_data_flash (CuTest *test, struct flash_virtual_ram *flash,
+	struct flash_virtual_ram_state *state, uint8_t *data, size_t length)
+{
+	size_t i;
+	int status;
+
+	for (i = 0; i < length; i++) {
+		data[i] = (uint8_t) (i * 7);
+	}
+
+	status = flash_virtual_ram_init (flash, state, data, length);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
 /*******************
  * Test cases
  *******************/
@@ -1805,6 +1946,88 @@ static void flash_blank_check_test_not_blank (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void flash_blank_check_test_unaligned_length (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff
+	};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_blank_check (&flash.base, 0x10000, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_blank_check_test_not_blank_word (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff
+	};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_blank_check (&flash.base, 0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_blank_check_test_not_blank_unaligned_tail (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0x00
+	};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_blank_check (&flash.base, 0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
 static void flash_blank_check_test_null (CuTest *test)
 {
 	struct flash_mock flash;
@@ -6844,147 +7067,1178 @@ static void flash_copy_ext_to_blank_and_verify_test (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_erase_region_and_verify_test (CuTest *test)
+static void flash_sector_copy_ext_differences_test (CuTest *test)
 {
-	struct flash_mock flash;
+	struct flash_mock flash1;
+	struct flash_mock flash2;
 	int status;
-	uint32_t bytes = FLASH_BLOCK_SIZE;
-	uint8_t data[] = {0xff, 0xff, 0xff, 0xff};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x01, 0x02, 0x13, 0x04};
+	uint8_t blank[sizeof (data)];
+	size_t rewritten;
 
 	TEST_START;
 
-	status = flash_mock_init (&flash);
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
 
-	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
 
-	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &rewritten);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), rewritten);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_erase_region_and_verify_test_not_blank (CuTest *test)
+static void flash_sector_copy_ext_differences_test_no_differences (CuTest *test)
 {
-	struct flash_mock flash;
+	struct flash_mock flash1;
+	struct flash_mock flash2;
 	int status;
-	uint32_t bytes = FLASH_BLOCK_SIZE;
-	uint8_t data[] = {0xff, 0xff, 0xff, 0x00};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	size_t rewritten;
 
 	TEST_START;
 
-	status = flash_mock_init (&flash);
+	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
 
-	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
 
-	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &rewritten);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, rewritten);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_erase_region_and_verify_test_null (CuTest *test)
+static void flash_sector_copy_ext_differences_test_across_erase_blocks (CuTest *test)
 {
-	struct flash_mock flash;
+	struct flash_mock flash1;
+	struct flash_mock flash2;
 	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x03, 0x14};
+	uint8_t blank[2];
+	size_t rewritten;
 
 	TEST_START;
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_erase_region_and_verify (NULL, 0x10000, 4);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	memset (blank, 0xff, sizeof (blank));
 
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_mock_init (&flash1);
 	CuAssertIntEquals (test, 0, status);
-}
+	flash1.mock.name = "flash1";
 
-static void flash_erase_region_and_verify_test_block_check_error (CuTest *test)
-{
-	struct flash_mock flash;
-	int status;
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
 
-	TEST_START;
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
 
-	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, FLASH_BLOCK_SIZE_FAILED,
-		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
 
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x11ffe),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
 
-	status = flash_erase_region_and_verify (&flash.base, 0x10000, 4);
-	CuAssertIntEquals (test, FLASH_BLOCK_SIZE_FAILED, status);
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10002),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash1.mock, 1, data + 2, sizeof (data) - 2, 2);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
-}
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x12000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
 
-static void flash_erase_region_and_verify_test_erase_error (CuTest *test)
-{
-	struct flash_mock flash;
-	int status;
-	uint32_t bytes = FLASH_BLOCK_SIZE;
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x12000));
 
-	TEST_START;
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x12000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10002),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash1.mock, 1, data + 2, sizeof (data) - 2, 2);
 
-	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 2, MOCK_ARG (0x12000),
+		MOCK_ARG_PTR_CONTAINS (data + 2, 2), MOCK_ARG (2));
 
-	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, FLASH_BLOCK_ERASE_FAILED,
-		MOCK_ARG (0x10000));
+	CuAssertIntEquals (test, 0, status);
 
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x11ffe, &flash1.base, 0x10000,
+		sizeof (data), &rewritten);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, rewritten);
 
-	status = flash_erase_region_and_verify (&flash.base, 0x10000, 4);
-	CuAssertIntEquals (test, FLASH_BLOCK_ERASE_FAILED, status);
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_mock_validate_and_release (&flash2);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_test_sha256 (CuTest *test)
+static void flash_sector_copy_ext_differences_test_no_rewritten_output (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
+	struct flash_mock flash1;
+	struct flash_mock flash2;
 	int status;
-	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t blank[sizeof (data)];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_differences_test_no_length (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	size_t rewritten = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x20000, &flash1.base, 0x10000, 0,
+		&rewritten);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, rewritten);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_differences_test_null (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	size_t rewritten = 1;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = flash_sector_copy_ext_differences (NULL, 0x20000, &flash1.base, 0x10000, 4,
+		&rewritten);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, rewritten);
+
+	rewritten = 1;
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x20000, NULL, 0x10000, 4,
+		&rewritten);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, rewritten);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_differences_test_same_erase_block (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	size_t rewritten;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_differences (&flash.base, 0x10800, &flash.base, 0x10000, 4,
+		&rewritten);
+	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
+	CuAssertIntEquals (test, 0, rewritten);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_differences_test_read_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	size_t rewritten;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x20000, &flash1.base, 0x10000, 4,
+		&rewritten);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	CuAssertIntEquals (test, 0, rewritten);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_differences_test_erase_error (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x01, 0x02, 0x13, 0x04};
+	size_t rewritten;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2,
+		FLASH_SECTOR_ERASE_FAILED, MOCK_ARG (0x20000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_differences (&flash2.base, 0x20000, &flash1.base, 0x10000,
+		sizeof (data), &rewritten);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+	CuAssertIntEquals (test, 0, rewritten);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_differences_and_verify_test (CuTest *test)
+{
+	struct flash_mock flash1;
+	struct flash_mock flash2;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t page = FLASH_PAGE_SIZE;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t old[] = {0x01, 0x02, 0x13, 0x04};
+	uint8_t blank[sizeof (data)];
+	size_t rewritten;
+
+	TEST_START;
+
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, old, sizeof (old), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x20000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data),
+		MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x20000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_differences_and_verify (&flash2.base, 0x20000, &flash1.base,
+		0x10000, sizeof (data), &rewritten);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (data), rewritten);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_erase_region_and_verify_test (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_BLOCK_SIZE;
+	uint8_t data[] = {0xff, 0xff, 0xff, 0xff};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_erase_region_and_verify_test_not_blank (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_BLOCK_SIZE;
+	uint8_t data[] = {0xff, 0xff, 0xff, 0x00};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_erase_region_and_verify_test_null (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_erase_region_and_verify (NULL, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_erase_region_and_verify_test_block_check_error (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, FLASH_BLOCK_SIZE_FAILED,
+		MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_erase_region_and_verify (&flash.base, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_BLOCK_SIZE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_erase_region_and_verify_test_erase_error (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_BLOCK_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, FLASH_BLOCK_ERASE_FAILED,
+		MOCK_ARG (0x10000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_erase_region_and_verify (&flash.base, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_BLOCK_ERASE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_noncontiguous_contents_test_sha256 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_sha1 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
+		0x0d,0x2c,0x02,0x20
+	};
+	uint8_t hash_actual[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x12345;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA1, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_sha384 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
+		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
+		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+	};
+	uint8_t hash_actual[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA384, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_sha512 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
+		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
+		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
+		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
+	};
+	uint8_t hash_actual[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA512, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_unknown (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		(enum hash_type) 10, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_multiple_blocks (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t hash_expected[] = {
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_multiple_regions (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, regions, 3, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (NULL, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents (&flash.base, NULL, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 0, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, NULL,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, NULL, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_noncontiguous_contents_test_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x1122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_noncontiguous_contents_test_multiple_blocks_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);\
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
+		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x1222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_noncontiguous_contents_test_multiple_regions_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
+		MOCK_ARG (1));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x3344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, regions, 3, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_noncontiguous_contents_test_hash_start_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash,
+		HASH_ENGINE_START_SHA256_FAILED);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_noncontiguous_contents_test_hash_update_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
@@ -6994,6 +8248,11 @@ static void flash_hash_noncontiguous_contents_test_sha256 (CuTest *test)
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
@@ -7001,1186 +8260,1224 @@ static void flash_hash_noncontiguous_contents_test_sha256 (CuTest *test)
 
 	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
 		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_noncontiguous_contents_test_hash_finish_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
+		MOCK_ARG_PTR (hash_actual), MOCK_ARG (SHA256_HASH_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_verify_noncontiguous_contents_test_sha256 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_sha1 (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_sha256_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
-		0x0d,0x2c,0x02,0x20
-	};
-	uint8_t hash_actual[SHA1_HASH_LENGTH];
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x12345;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA1, hash_actual, sizeof (hash_actual));
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
+		sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_sha384 (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_sha256_no_match_signature (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
-		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
-		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
-	};
-	uint8_t hash_actual[SHA384_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA384, hash_actual, sizeof (hash_actual));
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void flash_verify_noncontiguous_contents_test_sha256_no_match_signature_with_hash_out (
+	CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memset (hash_out, 0, sizeof (hash_out));
+
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_sha512 (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
-		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
-		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
-		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
-	};
-	uint8_t hash_actual[SHA512_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA1, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void flash_verify_noncontiguous_contents_test_sha384 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	char *data = "Test";
+
+	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA512, hash_actual, sizeof (hash_actual));
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA384, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_unknown (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		(enum hash_type) 10, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA512, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_multiple_blocks (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_expected[] = {
-		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
-		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
-	};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
-
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		(enum hash_type) 10, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY,
+		NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNKNOWN_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_multiple_regions (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	struct flash_region regions[2];
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x8765),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
+	regions[0].start_addr = 0x4321;
 	regions[0].length = 1;
 
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
-
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
-
-	status = flash_hash_noncontiguous_contents (&flash.base, regions, 3, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
+	regions[1].start_addr = 0x8765;
+	regions[1].length = 3;
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	status = flash_verify_noncontiguous_contents (&flash.base, regions, 2, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_null (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents (NULL, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	status = flash_verify_noncontiguous_contents (NULL, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, NULL, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	status = flash_verify_noncontiguous_contents (&flash.base, NULL, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 0, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 0, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, NULL,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, NULL,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, NULL, sizeof (hash_actual));
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, 0);
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, NULL, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, 0, &RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, NULL, 0);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_read_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_hash_buffer_too_small (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x1122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_test_multiple_blocks_read_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_test_read_error_with_hash_out (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);\
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
-		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
-		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memcpy (hash_out, empty, sizeof (hash_out));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x1222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void flash_value_check_test (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x55, 0x55, 0x55, 0x55};
+
+	TEST_START;
 
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_value_check (&flash.base, 0x10000, sizeof (data), 0x55);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_test_multiple_regions_read_error (CuTest *test)
+static void flash_value_check_test_mismatch (CuTest *test)
 {
-	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t data[] = {0x55, 0x55, 0xaa, 0x55};
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
-		MOCK_ARG (1));
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x3344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
-
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
-
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
-
-	status = flash_hash_noncontiguous_contents (&flash.base, regions, 3, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_value_check (&flash.base, 0x10000, sizeof (data), 0x55);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_test_hash_start_error (CuTest *test)
+static void flash_value_check_test_multiple_words (CuTest *test)
 {
-	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t data[] = {
+		0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+		0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+		0x55, 0x55, 0x55, 0x55, 0x55
+	};
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash,
-		HASH_ENGINE_START_SHA256_FAILED);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
-
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_value_check (&flash.base, 0x10000, sizeof (data), 0x55);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_test_hash_update_error (CuTest *test)
+static void flash_value_check_test_mismatch_word (CuTest *test)
 {
-	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t data[] = {
+		0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+		0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+		0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xff
+	};
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+	status = flash_value_check (&flash.base, 0x10000, sizeof (data), 0x55);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_test_hash_finish_error (CuTest *test)
+static void flash_value_check_test_mismatch_unaligned_tail (CuTest *test)
 {
-	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t data[] = {
+		0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+		0x55, 0x54
+	};
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
-		MOCK_ARG (sizeof (data)));
-	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
-		MOCK_ARG_PTR (hash_actual), MOCK_ARG (SHA256_HASH_LENGTH));
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
+	status = flash_value_check (&flash.base, 0x10000, sizeof (data), 0x55);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_verify_noncontiguous_contents_test_sha256 (CuTest *test)
+static void flash_value_check_test_null (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = flash_value_check (NULL, 0x10000, 4, 0x55);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+static void flash_value_check_test_error (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
 
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_value_check (&flash.base, 0x10000, 4, 0x55);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_sha256_with_hash_out (CuTest *test)
+static void flash_sector_erase_region_test (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_sector_erase_region (&flash.base, 0x10000, 256);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_erase_region_test_multiple_sectors (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
 
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
-		sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4 * 3));
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_sha256_no_match_signature (CuTest *test)
+static void flash_sector_erase_region_test_offset_start (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10200));
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	status = flash_sector_erase_region (&flash.base, 0x10200, 256);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_sha256_no_match_signature_with_hash_out (
-	CuTest *test)
+static void flash_sector_erase_region_test_offset_end (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-	memset (hash_out, 0, sizeof (hash_out));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4) + 15);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_sha1 (CuTest *test)
+static void flash_sector_erase_region_test_multiple_sectors_offset (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10200));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x13000));
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA1, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+	status = flash_sector_erase_region (&flash.base, 0x10200, (1024 * 4 * 3));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_sha384 (CuTest *test)
+static void flash_sector_erase_region_test_multiple_sectors_offset_end_aligned (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10f00));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA384, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+	status = flash_sector_erase_region (&flash.base, 0x10f00, (1024 * 4 * 2) + 0x100);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_sha512 (CuTest *test)
+static void flash_sector_erase_region_test_no_length (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA512, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+	status = flash_sector_erase_region (&flash.base, 0x10000, 0);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_unknown (CuTest *test)
+static void flash_sector_erase_region_test_multiple_sectors_not_4k (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint32_t bytes = 1024 * 2;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10800));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11800));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12800));
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		(enum hash_type) 10, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY,
-		NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNKNOWN_SIG_HASH, status);
+	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4 * 3));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_multiple_regions (CuTest *test)
+static void flash_sector_erase_region_test_multiple_sectors_offset_not_4k (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[2];
-	char *data = "Test";
+	uint32_t bytes = 1024 * 2;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10200));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10800));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11800));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12800));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x13000));
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x8765),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+	status = flash_sector_erase_region (&flash.base, 0x10200, (1024 * 4 * 3));
+	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	regions[0].start_addr = 0x4321;
-	regions[0].length = 1;
+static void flash_sector_erase_region_test_null (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
 
-	regions[1].start_addr = 0x8765;
-	regions[1].length = 3;
+	TEST_START;
 
-	status = flash_verify_noncontiguous_contents (&flash.base, regions, 2, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_sector_erase_region (NULL, 0x10000, 256);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_null (CuTest *test)
+static void flash_sector_erase_region_test_sector_size_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	struct flash_region regions;
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, FLASH_SECTOR_SIZE_FAILED,
+		MOCK_ARG_NOT_NULL);
 
-	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_sector_erase_region (&flash.base, 0x10000, 256);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
 
-	status = flash_verify_noncontiguous_contents (NULL, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, NULL, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+}
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 0, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+static void flash_sector_erase_region_test_error (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, NULL,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	TEST_START;
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, NULL, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x10000));
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, 0, &RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_sector_erase_region (&flash.base, 0x10000, 256);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_hash_buffer_too_small (CuTest *test)
+static void flash_sector_erase_region_test_multiple_sectors_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x11000));
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4 * 3));
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_test_read_error_with_hash_out (CuTest *test)
+static void flash_sector_erase_region_and_verify_test (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint8_t data[] = {0xff, 0xff, 0xff, 0xff};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
 
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-	memcpy (hash_out, empty, sizeof (hash_out));
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status = flash_verify_noncontiguous_contents (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_value_check_test (CuTest *test)
+static void flash_sector_erase_region_and_verify_test_not_blank (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x55, 0x55, 0x55, 0x55};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint8_t data[] = {0xff, 0xff, 0xff, 0x00};
 
 	TEST_START;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_value_check (&flash.base, 0x10000, sizeof (data), 0x55);
+	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_erase_region_and_verify_test_null (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_sector_erase_region_and_verify (NULL, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_value_check_test_mismatch (CuTest *test)
+static void flash_sector_erase_region_and_verify_test_sector_check_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x55, 0x55, 0xaa, 0x55};
 
 	TEST_START;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, FLASH_SECTOR_SIZE_FAILED,
+		MOCK_ARG_NOT_NULL);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_value_check (&flash.base, 0x10000, sizeof (data), 0x55);
-	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_value_check_test_null (CuTest *test)
+static void flash_sector_erase_region_and_verify_test_erase_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_value_check (NULL, 0x10000, 4, 0x55);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x10000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_value_check_test_error (CuTest *test)
+static void flash_optimal_erase_region_test (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_value_check (&flash.base, 0x10000, 4, 0x55);
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 256);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test (CuTest *test)
+static void flash_optimal_erase_region_test_single_block (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8188,24 +9485,28 @@ static void flash_sector_erase_region_test (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, 256);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_multiple_sectors (CuTest *test)
+static void flash_optimal_erase_region_test_multiple_blocks (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8213,26 +9514,30 @@ static void flash_sector_erase_region_test_multiple_sectors (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x30000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4 * 3));
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 0x30000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_offset_start (CuTest *test)
+static void flash_optimal_erase_region_test_sectors_and_blocks (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8240,24 +9545,32 @@ static void flash_sector_erase_region_test_offset_start (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10200));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0xe000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0xf000));
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x20000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x30000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10200, 256);
+	status = flash_optimal_erase_region (&flash.base, 0xe000, 0x23000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_offset_end (CuTest *test)
+static void flash_optimal_erase_region_test_offset_start (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8265,25 +9578,30 @@ static void flash_sector_erase_region_test_offset_end (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
 
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4) + 15);
+	status = flash_optimal_erase_region (&flash.base, 0x10010, 0x2000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_multiple_sectors_offset (CuTest *test)
+static void flash_optimal_erase_region_test_offset_start_block_aligned_end (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8291,27 +9609,29 @@ static void flash_sector_erase_region_test_multiple_sectors_offset (CuTest *test
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10200));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x13000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x20000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10200, (1024 * 4 * 3));
+	status = flash_optimal_erase_region (&flash.base, 0x10010, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_multiple_sectors_offset_end_aligned (CuTest *test)
+static void flash_optimal_erase_region_test_partial_block (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8319,26 +9639,43 @@ static void flash_sector_erase_region_test_multiple_sectors_offset_end_aligned (
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10f00));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x13000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x14000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x15000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x16000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x17000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x18000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x19000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x1a000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x1b000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x1c000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x1d000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x1e000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10f00, (1024 * 4 * 2) + 0x100);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 0xf000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_no_length (CuTest *test)
+static void flash_optimal_erase_region_test_start_of_flash (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
+	uint32_t device = 0x100000;
 
 	TEST_START;
 
@@ -8346,22 +9683,33 @@ static void flash_sector_erase_region_test_no_length (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_device_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &device, sizeof (device), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, 0);
+	status = flash_optimal_erase_region (&flash.base, 0, 0x10100);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_multiple_sectors_not_4k (CuTest *test)
+static void flash_optimal_erase_region_test_whole_device (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = 1024 * 2;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
+	uint32_t device = 0x100000;
 
 	TEST_START;
 
@@ -8369,29 +9717,31 @@ static void flash_sector_erase_region_test_multiple_sectors_not_4k (CuTest *test
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10800));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11800));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12800));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_device_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &device, sizeof (device), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.chip_erase, &flash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4 * 3));
+	status = flash_optimal_erase_region (&flash.base, 0, 0x100000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_multiple_sectors_offset_not_4k (CuTest *test)
+static void flash_optimal_erase_region_test_not_4k (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = 1024 * 2;
+	uint32_t sector = 0x400;
+	uint32_t block = 0x8000;
 
 	TEST_START;
 
@@ -8399,26 +9749,25 @@ static void flash_sector_erase_region_test_multiple_sectors_offset_not_4k (CuTes
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10200));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10400));
 	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10800));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x11800));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x12800));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x13000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10200, (1024 * 4 * 3));
+	status = flash_optimal_erase_region (&flash.base, 0x10100, 0x800);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_null (CuTest *test)
+static void flash_optimal_erase_region_test_no_length (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
@@ -8428,14 +9777,24 @@ static void flash_sector_erase_region_test_null (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (NULL, 0x10000, 256);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 0);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_sector_size_error (CuTest *test)
+static void flash_optimal_erase_region_test_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = flash_optimal_erase_region (NULL, 0x10000, 256);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+}
+
+static void flash_optimal_erase_region_test_sector_size_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
@@ -8450,19 +9809,18 @@ static void flash_sector_erase_region_test_sector_size_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, 256);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 256);
 	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-
 }
 
-static void flash_sector_erase_region_test_error (CuTest *test)
+static void flash_optimal_erase_region_test_block_size_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
 
 	TEST_START;
 
@@ -8470,25 +9828,26 @@ static void flash_sector_erase_region_test_error (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
-		MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, FLASH_BLOCK_SIZE_FAILED,
+		MOCK_ARG_NOT_NULL);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, 256);
-	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 256);
+	CuAssertIntEquals (test, FLASH_BLOCK_SIZE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_test_multiple_sectors_error (CuTest *test)
+static void flash_optimal_erase_region_test_device_size_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8496,27 +9855,29 @@ static void flash_sector_erase_region_test_multiple_sectors_error (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
-		MOCK_ARG (0x11000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_device_size, &flash,
+		FLASH_DEVICE_SIZE_FAILED, MOCK_ARG_NOT_NULL);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region (&flash.base, 0x10000, (1024 * 4 * 3));
-	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+	status = flash_optimal_erase_region (&flash.base, 0, 256);
+	CuAssertIntEquals (test, FLASH_DEVICE_SIZE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_and_verify_test (CuTest *test)
+static void flash_optimal_erase_region_test_block_erase_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
-	uint8_t data[] = {0xff, 0xff, 0xff, 0xff};
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8524,29 +9885,29 @@ static void flash_sector_erase_region_and_verify_test (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, FLASH_BLOCK_ERASE_FAILED,
+		MOCK_ARG (0x10000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 0x20000);
+	CuAssertIntEquals (test, FLASH_BLOCK_ERASE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_and_verify_test_not_blank (CuTest *test)
+static void flash_optimal_erase_region_test_sector_erase_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
-	uint8_t data[] = {0xff, 0xff, 0xff, 0x00};
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
 
 	TEST_START;
 
@@ -8554,67 +9915,98 @@ static void flash_sector_erase_region_and_verify_test_not_blank (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&flash.mock, flash.base.block_erase, &flash, 0, MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
+		MOCK_ARG (0x20000));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, 4);
-	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
+	status = flash_optimal_erase_region (&flash.base, 0x10000, 0x11000);
+	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_and_verify_test_null (CuTest *test)
+static void flash_optimal_erase_region_test_chip_erase_error (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
+	uint32_t device = 0x100000;
 
 	TEST_START;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region_and_verify (NULL, 0x10000, 4);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_device_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &device, sizeof (device), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.chip_erase, &flash, FLASH_CHIP_ERASE_FAILED);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_optimal_erase_region (&flash.base, 0, 0x100000);
+	CuAssertIntEquals (test, FLASH_CHIP_ERASE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_and_verify_test_sector_check_error (CuTest *test)
+static void flash_optimal_erase_region_and_verify_test (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
+	uint8_t data[] = {0xff, 0xff, 0xff, 0xff};
 
 	TEST_START;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, FLASH_SECTOR_SIZE_FAILED,
-		MOCK_ARG_NOT_NULL);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, 4);
-	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+	status = flash_optimal_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_sector_erase_region_and_verify_test_erase_error (CuTest *test)
+static void flash_optimal_erase_region_and_verify_test_not_blank (CuTest *test)
 {
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	uint32_t sector = FLASH_SECTOR_SIZE;
+	uint32_t block = FLASH_BLOCK_SIZE;
+	uint8_t data[] = {0xff, 0xff, 0x00, 0xff};
 
 	TEST_START;
 
@@ -8622,20 +10014,36 @@ static void flash_sector_erase_region_and_verify_test_erase_error (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status |= mock_expect_output (&flash.mock, 0, &sector, sizeof (sector), -1);
 
-	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, FLASH_SECTOR_ERASE_FAILED,
-		MOCK_ARG (0x10000));
+	status |= mock_expect (&flash.mock, flash.base.get_block_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &block, sizeof (block), -1);
+
+	status |= mock_expect (&flash.mock, flash.base.sector_erase, &flash, 0, MOCK_ARG (0x10000));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_erase_region_and_verify (&flash.base, 0x10000, 4);
-	CuAssertIntEquals (test, FLASH_SECTOR_ERASE_FAILED, status);
+	status = flash_optimal_erase_region_and_verify (&flash.base, 0x10000, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_NOT_BLANK, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void flash_optimal_erase_region_and_verify_test_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = flash_optimal_erase_region_and_verify (NULL, 0x10000, 4);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+}
+
 static void flash_sector_program_data_test (CuTest *test)
 {
 	struct flash_mock flash;
@@ -13118,186 +14526,463 @@ static void flash_sector_copy_ext_and_verify_test_partial_write (CuTest *test)
 
 	TEST_START;
 
-	memset (blank, 0xff, sizeof (blank));
-
-	status = flash_mock_init (&flash1);
+	memset (blank, 0xff, sizeof (blank));
+
+	status = flash_mock_init (&flash1);
+	CuAssertIntEquals (test, 0, status);
+	flash1.mock.name = "flash1";
+
+	status = flash_mock_init (&flash2);
+	CuAssertIntEquals (test, 0, status);
+	flash2.mock.name = "flash2";
+
+	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x11fff));
+	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x12000));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x11fff),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 1, MOCK_ARG (0x11fff),
+		MOCK_ARG_PTR_CONTAINS (data, 1), MOCK_ARG (1));
+
+	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x11fff),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10001),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data) - 1));
+	status |= mock_expect_output (&flash1.mock, 1, data + 1, sizeof (data) - 1, 2);
+
+	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data) - 2,
+		MOCK_ARG (0x12000), MOCK_ARG_PTR_CONTAINS (data + 1, sizeof (data) - 1),
+		MOCK_ARG (sizeof (data) - 1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_and_verify (&flash2.base, 0x11fff, &flash1.base, 0x10000,
+		sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INCOMPLETE_WRITE, status);
+
+	status = flash_mock_validate_and_release (&flash1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash2);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_and_verify_test_same_flash_overlapping_regions (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_and_verify (&flash.base, 0x11000, &flash.base, 0x10000, 0x1001);
+	CuAssertIntEquals (test, FLASH_UTIL_COPY_OVERLAP, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_and_verify_test_same_flash_overlapping_source_higher (
+	CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_and_verify (&flash.base, 0x10000, &flash.base, 0x11000, 0x1001);
+	CuAssertIntEquals (test, FLASH_UTIL_COPY_OVERLAP, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_and_verify (&flash.base, 0x10100, &flash.base, 0x10000, 0x10);
+	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block_at_source_end (
+	CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_sector_copy_ext_and_verify (&flash.base, 0x10000, &flash.base, 0x11100, 0x1001);
+	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block_at_destination_end (
+	CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
-	flash1.mock.name = "flash1";
 
-	status = flash_mock_init (&flash2);
+	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+
 	CuAssertIntEquals (test, 0, status);
-	flash2.mock.name = "flash2";
 
-	status = mock_expect (&flash2.mock, flash2.base.get_sector_size, &flash2, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash2.mock, 0, &bytes, sizeof (bytes), -1);
+	status = flash_sector_copy_ext_and_verify (&flash.base, 0x11100, &flash.base, 0x10000, 0x1001);
+	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
 
-	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x11fff));
-	status |= mock_expect (&flash2.mock, flash2.base.sector_erase, &flash2, 0, MOCK_ARG (0x12000));
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x11fff),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash2.mock, 1, blank, sizeof (blank), 2);
+static void flash_contents_verification_test_sha256 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	int status;
+	char *data = "Test";
 
-	status |= mock_expect (&flash2.mock, flash2.base.get_page_size, &flash2, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash2.mock, 0, &page, sizeof (page), -1);
+	TEST_START;
 
-	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash1.mock, 1, data, sizeof (data), 2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, 1, MOCK_ARG (0x11fff),
-		MOCK_ARG_PTR_CONTAINS (data, 1), MOCK_ARG (1));
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&flash2.mock, flash2.base.read, &flash2, 0, MOCK_ARG (0x11fff),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash2.mock, 1, data, sizeof (data), 2);
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&flash1.mock, flash1.base.read, &flash1, 0, MOCK_ARG (0x10001),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data) - 1));
-	status |= mock_expect_output (&flash1.mock, 1, data + 1, sizeof (data) - 1, 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status |= mock_expect (&flash2.mock, flash2.base.write, &flash2, sizeof (data) - 2,
-		MOCK_ARG (0x12000), MOCK_ARG_PTR_CONTAINS (data + 1, sizeof (data) - 1),
-		MOCK_ARG (sizeof (data) - 1));
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_copy_ext_and_verify (&flash2.base, 0x11fff, &flash1.base, 0x10000,
-		sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_INCOMPLETE_WRITE, status);
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash1);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash2);
+	status = signature_verification_mock_validate_and_release (&verification);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_sector_copy_ext_and_verify_test_same_flash_overlapping_regions (CuTest *test)
+static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_copy_ext_and_verify (&flash.base, 0x11000, &flash.base, 0x10000, 0x1001);
-	CuAssertIntEquals (test, FLASH_UTIL_COPY_OVERLAP, status);
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_sector_copy_ext_and_verify_test_same_flash_overlapping_source_higher (
-	CuTest *test)
+static void flash_contents_verification_test_sha256_no_match_signature (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	char *data = "Test";
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_copy_ext_and_verify (&flash.base, 0x10000, &flash.base, 0x11000, 0x1001);
-	CuAssertIntEquals (test, FLASH_UTIL_COPY_OVERLAP, status);
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block (CuTest *test)
+static void flash_contents_verification_test_sha256_no_match_signature_with_hash_out (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_copy_ext_and_verify (&flash.base, 0x10100, &flash.base, 0x10000, 0x10);
-	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
+	memset (hash_out, 0, sizeof (hash_out));
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block_at_source_end (
-	CuTest *test)
+static void flash_contents_verification_test_sha1 (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	char *data = "Test";
+	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_copy_ext_and_verify (&flash.base, 0x10000, &flash.base, 0x11100, 0x1001);
-	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_sector_copy_ext_and_verify_test_same_flash_same_erase_block_at_destination_end (
-	CuTest *test)
+static void flash_contents_verification_test_sha384 (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	uint32_t bytes = FLASH_SECTOR_SIZE;
+	char *data = "Test";
+	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.get_sector_size, &flash, 0, MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&flash.mock, 0, &bytes, sizeof (bytes), -1);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_sector_copy_ext_and_verify (&flash.base, 0x11100, &flash.base, 0x10000, 0x1001);
-	CuAssertIntEquals (test, FLASH_UTIL_SAME_ERASE_BLOCK, status);
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha256 (CuTest *test)
+static void flash_contents_verification_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	char *data = "Test";
+	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13315,13 +15000,17 @@ static void flash_contents_verification_test_sha256 (CuTest *test)
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13333,14 +15022,13 @@ static void flash_contents_verification_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
+static void flash_contents_verification_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13353,23 +15041,9 @@ static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13380,7 +15054,7 @@ static void flash_contents_verification_test_sha256_with_hash_out (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha256_no_match_signature (CuTest *test)
+static void flash_contents_verification_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -13399,20 +15073,29 @@ static void flash_contents_verification_test_sha256_no_match_signature (CuTest *
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	status = flash_contents_verification (NULL, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = flash_contents_verification (&flash.base, 0x4321, 0, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), NULL,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13423,14 +15106,14 @@ static void flash_contents_verification_test_sha256_no_match_signature (CuTest *
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha256_no_match_signature_with_hash_out (CuTest *test)
+static void flash_contents_verification_test_small_hash_buffer (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13443,26 +15126,10 @@ static void flash_contents_verification_test_sha256_no_match_signature_with_hash
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
-	memset (hash_out, 0, sizeof (hash_out));
-
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13473,14 +15140,14 @@ static void flash_contents_verification_test_sha256_no_match_signature_with_hash
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha1 (CuTest *test)
+static void flash_contents_verification_test_small_hash_buffer_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
+	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13493,23 +15160,10 @@ static void flash_contents_verification_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
 		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13520,14 +15174,14 @@ static void flash_contents_verification_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha384 (CuTest *test)
+static void flash_contents_verification_test_small_hash_buffer_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
+	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13540,24 +15194,45 @@ static void flash_contents_verification_test_sha384 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_contents_verification_test_small_hash_buffer_sha512 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
+		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
@@ -13567,14 +15242,15 @@ static void flash_contents_verification_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_sha512 (CuTest *test)
+static void flash_contents_verification_test_read_error_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA512_HASH_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -13587,22 +15263,19 @@ static void flash_contents_verification_test_sha512 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
+	memcpy (hash_out, empty, sizeof (hash_out));
+
 	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
-	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13614,12 +15287,13 @@ static void flash_contents_verification_test_sha512 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_unknown (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
 
 	TEST_START;
@@ -13633,9 +15307,22 @@ static void flash_contents_verification_test_unknown (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13646,13 +15333,15 @@ static void flash_contents_verification_test_unknown (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_null (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13665,29 +15354,26 @@ static void flash_contents_verification_test_null (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (NULL, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_contents_verification (&flash.base, 0x4321, 0, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), NULL,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13698,13 +15384,13 @@ static void flash_contents_verification_test_null (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_small_hash_buffer (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
 
 	TEST_START;
@@ -13718,10 +15404,23 @@ static void flash_contents_verification_test_small_hash_buffer (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13732,14 +15431,16 @@ static void flash_contents_verification_test_small_hash_buffer (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_small_hash_buffer_sha1 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13752,10 +15453,28 @@ static void flash_contents_verification_test_small_hash_buffer_sha1 (CuTest *tes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memset (hash_out, 0, sizeof (hash_out));
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13766,14 +15485,15 @@ static void flash_contents_verification_test_small_hash_buffer_sha1 (CuTest *tes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_small_hash_buffer_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13786,10 +15506,26 @@ static void flash_contents_verification_test_small_hash_buffer_sha384 (CuTest *t
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13800,14 +15536,15 @@ static void flash_contents_verification_test_small_hash_buffer_sha384 (CuTest *t
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_small_hash_buffer_sha512 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13820,10 +15557,26 @@ static void flash_contents_verification_test_small_hash_buffer_sha512 (CuTest *t
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13834,15 +15587,15 @@ static void flash_contents_verification_test_small_hash_buffer_sha512 (CuTest *t
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_contents_verification_test_read_error_with_hash_out (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
+	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13855,19 +15608,25 @@ static void flash_contents_verification_test_read_error_with_hash_out (CuTest *t
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	memcpy (hash_out, empty, sizeof (hash_out));
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_contents_verification (&flash.base, 0x4321, strlen (data), &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13879,7 +15638,7 @@ static void flash_contents_verification_test_read_error_with_hash_out (CuTest *t
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -13899,22 +15658,12 @@ static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, 0, status);
+		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -13925,15 +15674,14 @@ static void flash_noncontiguous_contents_verification_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[2];
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -13947,24 +15695,27 @@ static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x8765),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
 		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions[0].start_addr = 0x4321;
+	regions[0].length = 1;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
+	regions[1].start_addr = 0x8765;
+	regions[1].length = 3;
 
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_noncontiguous_contents_verification (&flash.base, regions, 2, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -13976,13 +15727,13 @@ static void flash_noncontiguous_contents_verification_test_sha256_with_hash_out
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	int status;
 	char *data = "Test";
 
 	TEST_START;
@@ -13996,23 +15747,36 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = flash_noncontiguous_contents_verification (NULL, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_noncontiguous_contents_verification (&flash.base, NULL, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 0, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, NULL,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14023,16 +15787,15 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha256_no_match_signature_with_hash_out (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14045,28 +15808,13 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memset (hash_out, 0, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, hash_out,
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14077,15 +15825,15 @@ static void flash_noncontiguous_contents_verification_test_sha256_no_match_signa
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14098,26 +15846,13 @@ static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
 		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14128,35 +15863,26 @@ static void flash_noncontiguous_contents_verification_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha384 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x4321;
@@ -14165,10 +15891,7 @@ static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
 		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14179,15 +15902,16 @@ static void flash_noncontiguous_contents_verification_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha512 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14200,26 +15924,13 @@ static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
 		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
 		sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14230,7 +15941,7 @@ static void flash_noncontiguous_contents_verification_test_sha512 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test)
+static void flash_noncontiguous_contents_verification_test_read_error_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -14238,6 +15949,8 @@ static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -14250,12 +15963,22 @@ static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
+	memcpy (hash_out, empty, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		(enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
+		sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14266,322 +15989,318 @@ static void flash_noncontiguous_contents_verification_test_unknown (CuTest *test
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_multiple_regions (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[2];
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x8765),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x4321;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x8765;
-	regions[1].length = 3;
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, regions, 2, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_null (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
+		0x0d,0x2c,0x02,0x20
+	};
+	uint8_t hash_actual[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_noncontiguous_contents_verification (NULL, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification (&flash.base, NULL, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 0, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, NULL,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x12345;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA1, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
+		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
+		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+	};
+	uint8_t hash_actual[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA384, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha1 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
+		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
+		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
+		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
+	};
+	uint8_t hash_actual[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA512, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha384 (
-	CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x10000, &regions, 1,
+		&hash.base, (enum hash_type) 10, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_hash_buffer_too_small_sha512 (
-	CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	struct flash_region regions;
+	uint8_t hash_expected[] = {
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_test_read_error_with_hash_out (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x4321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-	memcpy (hash_out, empty, sizeof (hash_out));
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
 
-	status = flash_noncontiguous_contents_verification (&flash.base, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, hash_out,
-		sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -14602,7 +16321,7 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *tes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -14611,8 +16330,8 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *tes
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
@@ -14624,18 +16343,13 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha256 (CuTest *tes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
-		0x0d,0x2c,0x02,0x20
-	};
-	uint8_t hash_actual[SHA1_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -14645,21 +16359,32 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions.start_addr = 0x12345;
-	regions.length = 4;
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA1, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		NULL, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, NULL, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -14667,31 +16392,28 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
-		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
-		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
-	};
-	uint8_t hash_actual[SHA384_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -14699,66 +16421,121 @@ static void flash_hash_noncontiguous_contents_at_offset_test_sha384 (CuTest *tes
 	regions.length = 4;
 
 	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA384, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
+	CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
-		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
-		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
-		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
-	};
-	uint8_t hash_actual[SHA512_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
+		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
 	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA512, hash_actual, sizeof (hash_actual));
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
+	CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
+		MOCK_ARG (1));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
 	CuAssertIntEquals (test, 0, status);
 
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_hash_start_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
@@ -14766,493 +16543,439 @@ static void flash_hash_noncontiguous_contents_at_offset_test_unknown (CuTest *te
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash,
+		HASH_ENGINE_START_SHA256_FAILED);
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x10000, &regions, 1,
-		&hash.base, (enum hash_type) 10, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_expected[] = {
-		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
-		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
-	};
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
 		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
+static void flash_hash_noncontiguous_contents_at_offset_test_hash_finish_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (data)));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
+		MOCK_ARG_PTR (hash_actual), MOCK_ARG (SHA256_HASH_LENGTH));
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
-
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
 		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_null (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_out (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		NULL, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, NULL, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature (
+	CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
+static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature_with_hash_out (
 	CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
-
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
-		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
-		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memset (hash_out, 0, sizeof (hash_out));
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
-	CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	struct flash_region regions;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
-		MOCK_ARG (1));
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
-
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
-
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA1, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY,
+		NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_hash_start_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash,
-		HASH_ENGINE_START_SHA256_FAILED);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA384, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA512, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_hash_noncontiguous_contents_at_offset_test_hash_finish_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
-		MOCK_ARG (sizeof (data)));
-	status |= mock_expect (&hash.mock, hash.base.finish, &hash, HASH_ENGINE_FINISH_FAILED,
-		MOCK_ARG_PTR (hash_actual), MOCK_ARG (SHA256_HASH_LENGTH));
-	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
-
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
-	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, (enum hash_type) 10, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNKNOWN_SIG_HASH, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[2];
 	char *data = "Test";
 
 	TEST_START;
@@ -15266,16 +16989,23 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *t
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions[0].start_addr = 0x4321;
+	regions[0].length = 1;
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+	regions[1].start_addr = 0x8765;
+	regions[1].length = 3;
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x90000, regions, 2,
 		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		&RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
@@ -15287,7 +17017,7 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *t
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_out (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
@@ -15295,7 +17025,6 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15308,7 +17037,7 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
@@ -15317,12 +17046,8 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
+		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -15332,14 +17057,13 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature (
-	CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	int status;
 	char *data = "Test";
 
 	TEST_START;
@@ -15353,19 +17077,48 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
+	status = flash_verify_noncontiguous_contents_at_offset (NULL, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, NULL, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 0,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		NULL, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, NULL, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, 0,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
 	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		NULL, NULL, 0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15374,16 +17127,15 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature_with_hash_out (
-	CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_hash_buffer_too_small (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15396,23 +17148,13 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memset (hash_out, 0, sizeof (hash_out));
 
 	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15421,7 +17163,8 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_s
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
+static void flash_verify_noncontiguous_contents_at_offset_test_read_error_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
@@ -15429,6 +17172,8 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *tes
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -15441,13 +17186,22 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *tes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
+	memcpy (hash_out, empty, sizeof (hash_out));
 
 	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA1, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY,
-		NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15456,10 +17210,10 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha1 (CuTest *tes
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
@@ -15470,66 +17224,96 @@ static void flash_verify_noncontiguous_contents_at_offset_test_sha384 (CuTest *t
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA384, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA512, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNSUPPORTED_SIG_HASH, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_unknown (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
@@ -15540,275 +17324,291 @@ static void flash_verify_noncontiguous_contents_at_offset_test_unknown (CuTest *
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, (enum hash_type) 10, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_UNKNOWN_SIG_HASH, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[2];
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
+		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
+		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
+		MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x4321;
-	regions[0].length = 1;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+	memset (hash_out, 0, sizeof (hash_out));
 
-	regions[1].start_addr = 0x8765;
-	regions[1].length = 3;
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x90000, regions, 2,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
+	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1, &hash.base,
-		HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, &RSA_PUBLIC_KEY, NULL, 0);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_null (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_verify_noncontiguous_contents_at_offset (NULL, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, NULL, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 0,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		NULL, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, NULL, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, 0,
-		&RSA_PUBLIC_KEY, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		NULL, NULL, 0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_hash_buffer_too_small (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
+	struct flash_region regions;
 	char *data = "Test";
+	uint8_t hash_out[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+
+	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
+		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
+		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_verify_noncontiguous_contents_at_offset_test_read_error_with_hash_out (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_unknown (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
+	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	status = signature_verification_mock_init (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-
-	CuAssertIntEquals (test, 0, status);
-
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memcpy (hash_out, empty, sizeof (hash_out));
 
-	status = flash_verify_noncontiguous_contents_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		&RSA_PUBLIC_KEY, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, (enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		NULL, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = signature_verification_mock_validate_and_release (&verification);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
+	struct flash_region regions[2];
 	char *data = "Test";
 
 	TEST_START;
@@ -15822,20 +17622,27 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuT
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
+
 	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
 		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
 		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	regions[0].start_addr = 0x4321;
+	regions[0].length = 1;
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+	regions[1].start_addr = 0x8765;
+	regions[1].length = 3;
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x90000, regions, 2,
 		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
 		0);
 	CuAssertIntEquals (test, 0, status);
@@ -15849,8 +17656,7 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256 (CuT
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with_hash_out (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_no_offset (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -15858,7 +17664,6 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15871,7 +17676,7 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
@@ -15884,12 +17689,9 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -15901,14 +17703,13 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_with
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature (
-	CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	int status;
 	char *data = "Test";
 
 	TEST_START;
@@ -15922,24 +17723,43 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = flash_noncontiguous_contents_verification_at_offset (NULL, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, NULL, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 0,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN, NULL,
+		NULL, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
 		0);
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL,
+		0);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -15950,16 +17770,16 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_match_signature_with_hash_out (
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small (
 	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -15972,28 +17792,52 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification,
-		SIG_VERIFICATION_BAD_SIGNATURE, MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN),
-		MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN),
-		MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha1 (
+	CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	struct flash_region regions;
+	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
+	int status;
+	char *data = "Test";
+
+	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
-	memset (hash_out, 0, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN,
+		&hash.base, HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, SIG_VERIFICATION_BAD_SIGNATURE, status);
-
-	status = testing_validate_array (SIG_HASH_TEST, hash_out, SIG_HASH_LEN);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -16004,15 +17848,16 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha256_no_m
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha384 (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	int status;
 	struct flash_region regions;
+	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
+	int status;
 	char *data = "Test";
-	uint8_t hash_out[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16025,26 +17870,52 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
+
+	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
+		&hash.base, HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		hash_out, sizeof (hash_out));
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_mock_validate_and_release (&verification);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha512 (
+	CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct signature_verification_mock verification;
+	struct flash_mock flash;
+	struct flash_region regions;
+	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA1_TEST_HASH, SHA1_HASH_LENGTH), MOCK_ARG (SHA1_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = signature_verification_mock_init (&verification);
+	CuAssertIntEquals (test, 0, status);
 
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&hash.base, HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
-	status = testing_validate_array (SHA1_TEST_HASH, hash_out, SHA1_HASH_LENGTH);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
@@ -16055,7 +17926,8 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha1 (CuTes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuTest *test)
+static void flash_noncontiguous_contents_verification_at_offset_test_read_error_with_hash_out (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct signature_verification_mock verification;
@@ -16063,7 +17935,8 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuT
 	int status;
 	struct flash_region regions;
 	char *data = "Test";
-	uint8_t hash_out[SHA384_HASH_LENGTH];
+	uint8_t hash_out[SHA256_HASH_LENGTH];
+	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
@@ -16076,25 +17949,21 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuT
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA384_TEST_HASH, SHA384_HASH_LENGTH), MOCK_ARG (SHA384_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x4321;
 	regions.length = strlen (data);
+	memcpy (hash_out, empty, sizeof (hash_out));
 
 	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
 		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
-	status = testing_validate_array (SHA384_TEST_HASH, hash_out, SHA384_HASH_LENGTH);
+	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -16106,626 +17975,704 @@ static void flash_noncontiguous_contents_verification_at_offset_test_sha384 (CuT
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_sha512 (CuTest *test)
+static void flash_write_and_verify_test (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA512_HASH_LENGTH];
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+}
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SHA512_TEST_HASH, SHA512_HASH_LENGTH), MOCK_ARG (SHA512_HASH_LENGTH),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+static void flash_write_and_verify_test_mismatch (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t check[] = {0x01, 0x02, 0x13, 0x04};
+
+	TEST_START;
 
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status |= mock_expect_output (&flash.mock, 1, check, sizeof (check), 2);
 
-	status = testing_validate_array (SHA512_TEST_HASH, hash_out, SHA512_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	status = signature_verification_mock_validate_and_release (&verification);
+static void flash_write_and_verify_test_null (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = flash_write_and_verify (NULL, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_write_and_verify (&flash.base, 0x10000, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_unknown (CuTest *test)
+static void flash_write_and_verify_test_write_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_write_and_verify_test_incomplete_write (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data) - 1,
+		MOCK_ARG (0x100fe), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, (enum hash_type) 10, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		NULL, 0);
-	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_write_and_verify (&flash.base, 0x100fe, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_UTIL_INCOMPLETE_WRITE, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+}
 
-	status = signature_verification_mock_validate_and_release (&verification);
+static void flash_write_and_verify_test_verify_error (CuTest *test)
+{
+	struct flash_mock flash;
+	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
+		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_multiple_regions (CuTest *test)
+static void flash_hash_update_contents_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions[2];
-	char *data = "Test";
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x94321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x98765),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, strlen (data), 2);
-
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x4321;
-	regions[0].length = 1;
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	regions[1].start_addr = 0x8765;
-	regions[1].length = 3;
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x90000, regions, 2,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_no_offset (CuTest *test)
+static void flash_hash_update_contents_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
+		0x0d,0x2c,0x02,0x20
+	};
+	uint8_t hash_actual[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x4321),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&verification.mock, verification.base.verify_signature, &verification, 0,
-		MOCK_ARG_PTR_CONTAINS (SIG_HASH_TEST, SIG_HASH_LEN), MOCK_ARG (SIG_HASH_LEN),
-		MOCK_ARG_PTR_CONTAINS (RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN), MOCK_ARG (RSA_ENCRYPT_LEN));
+	CuAssertIntEquals (test, 0, status);
 
+	status = hash.base.start_sha1 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_hash_update_contents (&flash.base, 0x12345, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_null (CuTest *test)
+static void flash_hash_update_contents_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
 	int status;
-	char *data = "Test";
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
+		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
+		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+	};
+	uint8_t hash_actual[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-
-	status = flash_noncontiguous_contents_verification_at_offset (NULL, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, NULL, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 0,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		NULL, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, NULL, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = hash.base.start_sha384 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, NULL, RSA_ENCRYPT_LEN, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, 0, NULL,
-		0);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small (
-	CuTest *test)
+static void flash_hash_update_contents_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA256_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
+		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
+		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
+		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
+	};
+	uint8_t hash_actual[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = hash.base.start_sha512 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha1 (
-	CuTest *test)
+static void flash_hash_update_contents_test_multiple_blocks (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA1_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint8_t hash_expected[] = {
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA1, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
+		&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha384 (
-	CuTest *test)
+static void flash_hash_update_contents_test_zero_length (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA384_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
+	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 0, &hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA384, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash_actual, SHA256_HASH_LENGTH);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_hash_buffer_too_small_sha512 (
-	CuTest *test)
+static void flash_hash_update_contents_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
 	struct flash_mock flash;
-	struct flash_region regions;
-	uint8_t hash_out[SHA512_HASH_LENGTH - 1];
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_init (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
+	status = flash_hash_update_contents (NULL, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA512, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
-	CuAssertIntEquals (test, 0, status);
-
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_noncontiguous_contents_verification_at_offset_test_read_error_with_hash_out (
-	CuTest *test)
+static void flash_hash_update_contents_test_read_error (CuTest *test)
 {
-	HASH_TESTING_ENGINE hash;
-	struct signature_verification_mock verification;
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	struct flash_region regions;
-	char *data = "Test";
-	uint8_t hash_out[SHA256_HASH_LENGTH];
-	uint8_t empty[sizeof (hash_out)] = {0};
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = signature_verification_mock_init (&verification);
+	status = hash_mock_init (&hash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x54321), MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+		MOCK_ARG (0x1122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x4321;
-	regions.length = strlen (data);
-	memcpy (hash_out, empty, sizeof (hash_out));
-
-	status = flash_noncontiguous_contents_verification_at_offset (&flash.base, 0x50000, &regions, 1,
-		&hash.base, HASH_TYPE_SHA256, &verification.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
-		hash_out, sizeof (hash_out));
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
-	status = testing_validate_array (empty, hash_out, sizeof (hash_out));
-	CuAssertIntEquals (test, 0, status);
-
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = signature_verification_mock_validate_and_release (&verification);
+	status = hash_mock_validate_and_release (&hash);
 	CuAssertIntEquals (test, 0, status);
-
-	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_write_and_verify_test (CuTest *test)
+static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *test)
 {
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
-		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
+		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
+		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x1222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
+		&hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_write_and_verify_test_mismatch (CuTest *test)
+static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
 {
+	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t check[] = {0x01, 0x02, 0x13, 0x04};
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 
 	TEST_START;
 
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
-		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x10000),
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
 		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
-	status |= mock_expect_output (&flash.mock, 1, check, sizeof (check), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_DATA_MISMATCH, status);
+	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_write_and_verify_test_null (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
-	status = flash_mock_init (&flash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (NULL, 0x10000, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, NULL, sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
-}
 
-static void flash_write_and_verify_test_write_error (CuTest *test)
-{
-	struct flash_mock flash;
-	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	TEST_START;
+	regions.start_addr = 0x1122;
+	regions.length = 4;
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, FLASH_WRITE_FAILED,
-		MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
-
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_write_and_verify_test_incomplete_write (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
+		0x0d,0x2c,0x02,0x20
+	};
+	uint8_t hash_actual[SHA1_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data) - 1,
-		MOCK_ARG (0x100fe), MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x100fe, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_UTIL_INCOMPLETE_WRITE, status);
+	status = hash.base.start_sha1 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x12345;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_write_and_verify_test_verify_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 {
+	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
+		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
+		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+	};
+	uint8_t hash_actual[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.write, &flash, sizeof (data), MOCK_ARG (0x10000),
-		MOCK_ARG_PTR_CONTAINS (data, sizeof (data)), MOCK_ARG (sizeof (data)));
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x10000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	CuAssertIntEquals (test, 0, status);
 
+	status = hash.base.start_sha384 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_write_and_verify (&flash.base, 0x10000, data, sizeof (data));
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_sha256 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
+		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
+		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
+		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
 	};
-	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16741,10 +18688,13 @@ static void flash_hash_update_contents_test_sha256 (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha256 (&hash.base);
+	status = hash.base.start_sha512 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16759,17 +18709,17 @@ static void flash_hash_update_contents_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_sha1 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	struct flash_region regions;
 	uint8_t hash_expected[] = {
-		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
-		0x0d,0x2c,0x02,0x20
+		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
+		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
 	};
-	uint8_t hash_actual[SHA1_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16779,16 +18729,27 @@ static void flash_hash_update_contents_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
+	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha1 (&hash.base);
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x12345, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16803,18 +18764,18 @@ static void flash_hash_update_contents_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_sha384 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions[3];
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
-		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
-		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
-		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
 	};
-	uint8_t hash_actual[SHA384_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
 
@@ -16825,15 +18786,32 @@ static void flash_hash_update_contents_test_sha384 (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
+
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha384 (&hash.base);
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16848,38 +18826,67 @@ static void flash_hash_update_contents_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_sha512 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_regions (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
 	int status;
+	struct flash_region regions[3];
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 	uint8_t hash_expected[] = {
-		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
-		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
-		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
-		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
 	};
-	uint8_t hash_actual[SHA512_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	uint8_t wip_status = 0;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = flash_master_mock_enable_xfer_batch (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* All regions fit in a single block, so they are read with one batched transfer. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= mock_expect (&flash_mock.mock, flash_mock.base.xfer_batch, &flash_mock, 0,
+		MOCK_ARG (3));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, data, 1,
+		FLASH_EXP_READ_CMD (0x03, 0x1122, 0, -1, 1));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, data + 1, 2,
+		FLASH_EXP_READ_CMD (0x03, 0x3344, 0, -1, 2));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, data + 3, 1,
+		FLASH_EXP_READ_CMD (0x03, 0x5566, 0, -1, 1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
 
-	CuAssertIntEquals (test, 0, status);
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
 
-	status = hash.base.start_sha512 (&hash.base);
-	CuAssertIntEquals (test, 0, status);
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16888,50 +18895,56 @@ static void flash_hash_update_contents_test_sha512 (CuTest *test)
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_multiple_blocks (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_many_small_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
-	uint8_t hash_expected[] = {
-		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
-		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
-	};
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
+	struct flash_region regions[(FLASH_HASH_READ_REGIONS_MAX * 2) + 3];
+	size_t count = sizeof (regions) / sizeof (regions[0]);
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+	/* More regions than can be combined into a single read, with the last region spanning
+	 * multiple blocks. */
+	for (i = 0; i < count; i++) {
+		regions[i].start_addr = i * 0x20;
+		regions[i].length = 0x10 + i;
+	}
+	regions[count - 1].length = sizeof (data) - regions[count - 1].start_addr;
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+	for (i = 0; i < count; i++) {
+		status = hash.base.update (&hash.base, &data[regions[i].start_addr], regions[i].length);
+		CuAssertIntEquals (test, 0, status);
+	}
 
+	status = hash.base.finish (&hash.base, hash_expected, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
-		&hash.base);
+	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, count, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16940,17 +18953,16 @@ static void flash_hash_update_contents_test_multiple_blocks (CuTest *test)
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
-
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_zero_length (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
 
 	TEST_START;
@@ -16964,7 +18976,10 @@ static void flash_hash_update_contents_test_zero_length (CuTest *test)
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 0, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 0;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -16979,11 +18994,12 @@ static void flash_hash_update_contents_test_zero_length (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_null (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 
 	TEST_START;
 
@@ -16993,10 +19009,19 @@ static void flash_hash_update_contents_test_null (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (NULL, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (NULL, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, NULL);
+	status = flash_hash_update_noncontiguous_contents (&flash.base, NULL, 1, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 0, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, NULL);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17005,11 +19030,12 @@ static void flash_hash_update_contents_test_null (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_contents_test_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 
 	TEST_START;
 
@@ -17024,7 +19050,10 @@ static void flash_hash_update_contents_test_read_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17034,11 +19063,12 @@ static void flash_hash_update_contents_test_read_error (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 
 	TEST_START;
 
@@ -17061,8 +19091,10 @@ static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, (FLASH_VERIFICATION_BLOCK * 2) + 16,
-		&hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17072,11 +19104,59 @@ static void flash_hash_update_contents_test_multiple_blocks_read_error (CuTest *
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
+		MOCK_ARG (1));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x3344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 1;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 1;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
 	int status;
+	struct flash_region regions;
 	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 
 	TEST_START;
@@ -17096,7 +19176,10 @@ static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_contents (&flash.base, 0x1122, 4, &hash.base);
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17106,7 +19189,7 @@ static void flash_hash_update_contents_test_hash_update_error (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17127,7 +19210,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17139,7 +19222,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17154,7 +19238,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha256 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17175,7 +19259,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x12345),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17187,7 +19271,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 	regions.start_addr = 0x12345;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17202,7 +19287,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha1 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17224,7 +19309,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17236,7 +19321,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17251,7 +19337,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha384 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17274,7 +19360,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17286,7 +19372,8 @@ static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17301,7 +19388,7 @@ static void flash_hash_update_noncontiguous_contents_test_sha512 (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17321,15 +19408,15 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTes
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1222),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1322),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
 
@@ -17341,7 +19428,8 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTes
 	regions.start_addr = 0x1122;
 	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17356,7 +19444,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks (CuTes
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17377,15 +19465,15 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTe
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
 	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
 
@@ -17403,7 +19491,8 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTe
 	regions[2].start_addr = 0x5566;
 	regions[2].length = 1;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17418,7 +19507,56 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions (CuTe
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
+		&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_update_noncontiguous_contents_at_offset_test_zero_length (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17440,7 +19578,8 @@ static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *t
 	regions.start_addr = 0x1122;
 	regions.length = 0;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17455,7 +19594,7 @@ static void flash_hash_update_noncontiguous_contents_test_zero_length (CuTest *t
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
 	struct flash_mock flash;
@@ -17473,16 +19612,20 @@ static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (NULL, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, NULL, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 0, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, NULL);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		NULL);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17491,7 +19634,7 @@ static void flash_hash_update_noncontiguous_contents_test_null (CuTest *test)
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17507,14 +19650,15 @@ static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *te
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x1122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17524,7 +19668,8 @@ static void flash_hash_update_noncontiguous_contents_test_read_error (CuTest *te
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
+	CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17539,7 +19684,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_e
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
 
@@ -17548,14 +19693,15 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_e
 		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x1222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
 
 	CuAssertIntEquals (test, 0, status);
 
 	regions.start_addr = 0x1122;
 	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17565,7 +19711,8 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_blocks_read_e
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
+	CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17581,7 +19728,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17589,7 +19736,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 		MOCK_ARG (1));
 
 	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x3344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -17602,7 +19749,8 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 	regions[2].start_addr = 0x5566;
 	regions[2].length = 1;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, regions, 3, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
+		&hash.base);
 	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17612,7 +19760,7 @@ static void flash_hash_update_noncontiguous_contents_test_multiple_regions_read_
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
 {
 	struct hash_engine_mock hash;
 	struct flash_mock flash;
@@ -17628,7 +19776,7 @@ static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuT
 	status = flash_mock_init (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
 		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
 	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
 
@@ -17640,7 +19788,8 @@ static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuT
 	regions.start_addr = 0x1122;
 	regions.length = 4;
 
-	status = flash_hash_update_noncontiguous_contents (&flash.base, &regions, 1, &hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+		&hash.base);
 	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
 
 	status = flash_mock_validate_and_release (&flash);
@@ -17650,40 +19799,46 @@ static void flash_hash_update_noncontiguous_contents_test_hash_update_error (CuT
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_buffers (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
-	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
+	struct flash_region regions[2];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
+
+	regions[0].start_addr = 0x10;
+	regions[0].length = FLASH_HASH_BLOCK_SIZE + 0x20;
+	regions[1].start_addr = regions[0].start_addr + regions[0].length + 0x10;
+	regions[1].length = sizeof (data) - regions[1].start_addr - 0x10;
+
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = hash.base.update (&hash.base, &data[regions[0].start_addr], regions[0].length);
+	CuAssertIntEquals (test, 0, status);
 
+	status = hash.base.update (&hash.base, &data[regions[1].start_addr], regions[1].length);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha256 (&hash.base);
+	status = hash.base.finish (&hash.base, hash_expected, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, regions, 2,
 		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
@@ -17693,46 +19848,112 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha256 (CuTe
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_buffers_read_error (
+	CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
+	struct flash_region regions;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
+
+	/* The region extends past the end of flash, so the read of the last block will fail after
+	 * several blocks have already been hashed. */
+	regions.start_addr = 0;
+	regions.length = sizeof (data) + FLASH_HASH_BLOCK_SIZE;
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
+		&hash.base);
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	hash.base.cancel (&hash.base);
+
+	/* The failure must not affect the next operation. */
+	regions.length = sizeof (data);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
+		&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha1 (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_buffers_hash_error (
+	CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
+	struct flash_util_testing_failing_hash failing;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x71,0x10,0xed,0xa4,0xd0,0x9e,0x06,0x2a,0xa5,0xe4,0xa3,0x90,0xb0,0xa5,0x72,0xac,
-		0x0d,0x2c,0x02,0x20
-	};
-	uint8_t hash_actual[SHA1_HASH_LENGTH];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
-	CuAssertIntEquals (test, 0, status);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x612345),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	/* Fail the update for the second block, while other blocks are still being processed. */
+	flash_util_testing_init_failing_hash (&failing, &hash.base, 1);
+
+	regions.start_addr = 0;
+	regions.length = sizeof (data);
 
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha1 (&hash.base);
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
+		&failing.base);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+	CuAssertTrue (test, (failing.updates >= 2));
+
+	hash.base.cancel (&hash.base);
+
+	/* The failure must not be reported to the next operation. */
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x12345;
-	regions.length = 4;
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x600000, &regions, 1,
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
 		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
@@ -17742,48 +19963,98 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha1 (CuTest
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_test_init (CuTest *test)
+{
+	struct flash_hash_pipeline pipeline;
+	int status;
+
+	TEST_START;
+
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	CuAssertIntEquals (test, 0, pipeline.queued);
+	CuAssertIntEquals (test, false, pipeline.busy);
+	CuAssertIntEquals (test, false, pipeline.running);
+
+	flash_hash_pipeline_release (&pipeline);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha384 (CuTest *test)
+static void flash_hash_pipeline_test_init_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = flash_hash_pipeline_init (NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+}
+
+static void flash_hash_pipeline_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_hash_pipeline_release (NULL);
+}
+
+static void flash_hash_pipeline_test_run_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_hash_pipeline_run (NULL);
+	flash_hash_pipeline_stop (NULL);
+}
+
+static void flash_hash_pipeline_test_update (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
+	struct flash_region regions[2];
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 	int status;
-	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x50,0x4f,0x00,0x8c,0x8f,0xcf,0x8b,0x2e,0xd5,0xdf,0xcd,0xe7,0x52,0xfc,0x54,0x64,
-		0xab,0x8b,0xa0,0x64,0x21,0x5d,0x9c,0x5b,0x5f,0xc4,0x86,0xaf,0x3d,0x9a,0xb8,0xc8,
-		0x1b,0x14,0x78,0x51,0x80,0xd2,0xad,0x7c,0xee,0x1a,0xb7,0x92,0xad,0x44,0x79,0x8c
-	};
-	uint8_t hash_actual[SHA384_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
+
+	regions[0].start_addr = 0;
+	regions[0].length = FLASH_HASH_BLOCK_SIZE + 0x20;
+	regions[1].start_addr = regions[0].start_addr + regions[0].length + 0x10;
+	regions[1].length = sizeof (data) - regions[1].start_addr - 0x20;
 
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha384 (&hash.base);
+	status = hash.base.update (&hash.base, &data[regions[0].start_addr + 0x10],
+		regions[0].length);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	status = hash.base.update (&hash.base, &data[regions[1].start_addr + 0x10],
+		regions[1].length);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
+	status = hash.base.finish (&hash.base, hash_expected, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No context is running the hashing stage, so blocks are hashed by the caller. */
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0x10, regions, 2, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17792,48 +20063,60 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha384 (CuTe
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, pipeline.queued);
+	CuAssertIntEquals (test, false, pipeline.busy);
 
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_sha512 (CuTest *test)
+static void flash_hash_pipeline_test_update_many_small_regions (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
+	struct flash_region regions[(FLASH_HASH_READ_REGIONS_MAX * 2) + 3];
+	size_t count = sizeof (regions) / sizeof (regions[0]);
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	size_t i;
 	int status;
-	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0xd4,0x04,0x55,0x9f,0x60,0x2e,0xab,0x6f,0xd6,0x02,0xac,0x76,0x80,0xda,0xcb,0xfa,
-		0xad,0xd1,0x36,0x30,0x33,0x5e,0x95,0x1f,0x09,0x7a,0xf3,0x90,0x0e,0x9d,0xe1,0x76,
-		0xb6,0xdb,0x28,0x51,0x2f,0x2e,0x00,0x0b,0x9d,0x04,0xfb,0xa5,0x13,0x3e,0x8b,0x1c,
-		0x6e,0x8d,0xf5,0x9d,0xb3,0xa8,0xab,0x9d,0x60,0xbe,0x4b,0x97,0xcc,0x9e,0x81,0xdb
-	};
-	uint8_t hash_actual[SHA512_HASH_LENGTH];
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
+
+	for (i = 0; i < count; i++) {
+		regions[i].start_addr = i * 0x20;
+		regions[i].length = 0x10 + i;
+	}
+	regions[count - 1].length = sizeof (data) - regions[count - 1].start_addr - 0x10;
 
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha512 (&hash.base);
+	for (i = 0; i < count; i++) {
+		status = hash.base.update (&hash.base, &data[regions[i].start_addr + 0x10],
+			regions[i].length);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = hash.base.finish (&hash.base, hash_expected, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0x10, regions, count,
 		&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
@@ -17843,54 +20126,105 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_sha512 (CuTe
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_test_update_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	uint8_t data[0x100];
+	struct flash_region regions;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
+
+	regions.start_addr = 0;
+	regions.length = sizeof (data);
+
+	status = flash_hash_pipeline_update (NULL, &flash.base, 0, &regions, 1, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_update (&pipeline, NULL, 0, &regions, 1, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, NULL, 1, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, &regions, 0, &hash.base);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, &regions, 1, NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, false, pipeline.busy);
+
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks (CuTest *test)
+static void flash_hash_pipeline_test_update_read_error (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
 	struct flash_region regions;
-	uint8_t hash_expected[] = {
-		0x66,0x74,0x48,0xad,0x7b,0x51,0x35,0xd0,0xbc,0xbf,0xb4,0xbd,0x15,0x6f,0x5b,0x9b,
-		0x64,0xa0,0xd8,0xab,0x68,0x71,0xa7,0xb8,0x2a,0x8c,0x68,0x0c,0x46,0xb8,0xe4,0x62
-	};
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
+
+	/* The region extends past the end of flash, so the read of the last block will fail after
+	 * several blocks have already been queued. */
+	regions.start_addr = 0;
+	regions.length = sizeof (data) + FLASH_HASH_BLOCK_SIZE;
+
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41222),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST2, RSA_ENCRYPT_LEN, 2);
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, &regions, 1, &hash.base);
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x41322),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (16));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_NOPE, RSA_ENCRYPT_LEN, 2);
+	CuAssertIntEquals (test, 0, pipeline.queued);
+	CuAssertIntEquals (test, false, pipeline.busy);
+
+	hash.base.cancel (&hash.base);
+
+	/* The failure must not affect the next request. */
+	regions.length = sizeof (data);
 
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
-
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x40000, &regions, 1,
-		&hash.base);
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
@@ -17899,111 +20233,120 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blo
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
-
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions (CuTest *test)
+static void flash_hash_pipeline_test_update_hash_error (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
+	struct flash_util_testing_failing_hash failing;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
+	struct flash_region regions;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x73344),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
-	status |= mock_expect_output (&flash.mock, 1, data + 1, sizeof (data), 2);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x75566),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data + 3, sizeof (data), 2);
+	flash_util_testing_init_failing_hash (&failing, &hash.base, 1);
 
-	CuAssertIntEquals (test, 0, status);
+	regions.start_addr = 0;
+	regions.length = sizeof (data);
 
 	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, &regions, 1, &failing.base);
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+	CuAssertIntEquals (test, 2, failing.updates);
 
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
+	CuAssertIntEquals (test, 0, pipeline.queued);
+	CuAssertIntEquals (test, false, pipeline.busy);
 
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
+	hash.base.cancel (&hash.base);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
-		&hash.base);
+	/* The failure must not be reported to the next request. */
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, &regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_no_offset (CuTest *test)
+static void flash_hash_pipeline_test_update_busy (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
+	HASH_TESTING_ENGINE nested_hash;
+	struct flash_util_testing_nested_hash nested;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	uint8_t data[0x100];
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
-	uint8_t hash_expected[] = {
-		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
-		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
-	};
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = HASH_TESTING_ENGINE_INIT (&nested_hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = flash_hash_pipeline_init (&pipeline);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
+
+	/* The nested request uses the same pipeline while the first request is hashing data. */
+	flash_util_testing_init_nested_hash (&nested, &hash.base, &pipeline, &flash.base, 0,
+		sizeof (data), &nested_hash.base);
 
+	regions.start_addr = 0;
+	regions.length = sizeof (data);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha256 (&hash.base);
+	status = nested_hash.base.start_sha256 (&nested_hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
-		&hash.base);
+	status = flash_hash_pipeline_update (&pipeline, &flash.base, 0, &regions, 1, &nested.base);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_UTIL_PIPELINE_BUSY, nested.status);
 
 	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
@@ -18011,256 +20354,274 @@ static void flash_hash_update_noncontiguous_contents_at_offset_test_no_offset (C
 	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
+	nested_hash.base.cancel (&nested_hash.base);
 
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
+	HASH_TESTING_ENGINE_RELEASE (&nested_hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_zero_length (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_pipelined_test (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
 	struct flash_region regions;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
 	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.start_sha256 (&hash.base);
-	CuAssertIntEquals (test, 0, status);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
 
-	regions.start_addr = 0x1122;
-	regions.length = 0;
+	regions.start_addr = 0x10;
+	regions.length = sizeof (data) - 0x20;
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
+	status = hash.base.calculate_sha256 (&hash.base, &data[0x20], regions.length, hash_expected,
+		sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	status = hash.base.start_sha256 (&hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash_actual, SHA256_HASH_LENGTH);
+	status = flash_hash_update_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0x10,
+		&regions, 1, &hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_null (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_pipelined_test_null (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
-	struct flash_mock flash;
-	int status;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	uint8_t data[0x100];
 	struct flash_region regions;
+	int status;
 
 	TEST_START;
 
 	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (NULL, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+	regions.start_addr = 0;
+	regions.length = sizeof (data);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, NULL, 1,
+	status = flash_hash_update_noncontiguous_contents_pipelined (&pipeline, NULL, 0, &regions, 1,
 		&hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 0,
-		&hash.base);
+	status = flash_hash_update_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0, NULL,
+		1, &hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		NULL);
+	status = flash_hash_update_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0,
+		&regions, 0, &hash.base);
 	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status = flash_hash_update_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0,
+		&regions, 1, NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
 
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_read_error (CuTest *test)
+static void flash_hash_update_noncontiguous_contents_at_offset_test_default_pipeline (
+	CuTest *test)
 {
-	struct hash_engine_mock hash;
-	struct flash_mock flash;
-	int status;
+	HASH_TESTING_ENGINE hash;
+	HASH_TESTING_ENGINE nested_hash;
+	struct flash_util_testing_nested_hash nested;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
 	struct flash_region regions;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t nested_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = HASH_TESTING_ENGINE_INIT (&nested_hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31122), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
-
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
 
-	status = flash_mock_validate_and_release (&flash);
-	CuAssertIntEquals (test, 0, status);
+	flash_hash_set_default_pipeline (&pipeline);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
-}
+	/* The nested request must not wait for the default pipeline while the first request is using
+	 * it.  It hashes the flash data directly instead. */
+	flash_util_testing_init_nested_hash (&nested, &hash.base, NULL, &flash.base, 0x100,
+		(FLASH_HASH_BLOCK_SIZE * 2) + 0x10, &nested_hash.base);
+	nested.check = &pipeline;
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks_read_error (
-	CuTest *test)
-{
-	struct hash_engine_mock hash;
-	struct flash_mock flash;
-	int status;
-	struct flash_region regions;
+	regions.start_addr = 0;
+	regions.length = sizeof (data);
 
-	TEST_START;
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_init (&hash);
+	status = hash.base.calculate_sha256 (&hash.base, &data[nested.region.start_addr],
+		nested.region.length, nested_expected, sizeof (nested_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = nested_hash.base.start_sha256 (&nested_hash.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
-	status |= mock_expect_output (&flash.mock, 1, RSA_ENCRYPT_TEST, RSA_ENCRYPT_LEN, 2);
+	status = hash.base.start_sha256 (&hash.base);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0,
-		MOCK_ARG_PTR_CONTAINS (RSA_ENCRYPT_TEST, FLASH_VERIFICATION_BLOCK),
-		MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0, &regions, 1,
+		&nested.base);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, nested.status);
+	CuAssertIntEquals (test, true, nested.check_busy);
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x31222), MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_VERIFICATION_BLOCK));
+	flash_hash_set_default_pipeline (NULL);
 
+	status = hash.base.finish (&hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = (FLASH_VERIFICATION_BLOCK * 2) + 16;
-
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_validate_and_release (&flash);
+	status = nested_hash.base.finish (&nested_hash.base, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
+	status = testing_validate_array (nested_expected, hash_actual, sizeof (nested_expected));
 	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, pipeline.busy);
+
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	HASH_TESTING_ENGINE_RELEASE (&nested_hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions_read_error (
-	CuTest *test)
+static void flash_hash_noncontiguous_contents_pipelined_test (CuTest *test)
 {
-	struct hash_engine_mock hash;
-	struct flash_mock flash;
+	HASH_TESTING_ENGINE hash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_UTIL_TESTING_HASH_DATA_LEN];
+	struct flash_region regions;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
 	int status;
-	struct flash_region regions[3];
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = flash_hash_pipeline_init (&pipeline);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x71122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
-
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_PTR_CONTAINS (data, 1),
-		MOCK_ARG (1));
+	flash_util_testing_init_hash_data_flash (test, &flash, &state, data, sizeof (data));
 
-	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
-		MOCK_ARG (0x73344), MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	regions.start_addr = 0;
+	regions.length = sizeof (data) - 0x40;
 
+	status = hash.base.calculate_sha256 (&hash.base, &data[0x40], regions.length, hash_expected,
+		sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
 
-	regions[0].start_addr = 0x1122;
-	regions[0].length = 1;
-
-	regions[1].start_addr = 0x3344;
-	regions[1].length = 2;
-
-	regions[2].start_addr = 0x5566;
-	regions[2].length = 1;
-
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x70000, regions, 3,
-		&hash.base);
-	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
-
-	status = flash_mock_validate_and_release (&flash);
+	status = flash_hash_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0x40, &regions, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
 	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
-static void flash_hash_update_noncontiguous_contents_at_offset_test_hash_update_error (CuTest *test)
+static void flash_verify_noncontiguous_contents_pipelined_test (CuTest *test)
 {
-	struct hash_engine_mock hash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct flash_hash_pipeline pipeline;
 	struct flash_mock flash;
 	int status;
 	struct flash_region regions;
-	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	char *data = "Test";
 
 	TEST_START;
 
-	status = hash_mock_init (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_mock_init (&flash);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x31122),
-		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
-	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status = flash_hash_pipeline_init (&pipeline);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&hash.mock, hash.base.update, &hash, HASH_ENGINE_UPDATE_FAILED,
-		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (data)));
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x54321),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (strlen (data)));
+	status |= mock_expect_output (&flash.mock, 1, data, strlen (data), 2);
 
 	CuAssertIntEquals (test, 0, status);
 
-	regions.start_addr = 0x1122;
-	regions.length = 4;
+	regions.start_addr = 0x4321;
+	regions.length = strlen (data);
 
-	status = flash_hash_update_noncontiguous_contents_at_offset (&flash.base, 0x30000, &regions, 1,
-		&hash.base);
-	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+	status = flash_verify_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0x50000,
+		&regions, 1, &hash.base, HASH_TYPE_SHA256, &rsa.base, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN,
+		&RSA_PUBLIC_KEY, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_mock_validate_and_release (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = hash_mock_validate_and_release (&hash);
-	CuAssertIntEquals (test, 0, status);
+	flash_hash_pipeline_release (&pipeline);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-
 TEST_SUITE_START  (flash_util);
 
 TEST (flash_hash_contents_test_sha256);
@@ -18319,6 +20680,9 @@ TEST (flash_program_and_verify_test_error);
 TEST (flash_program_and_verify_test_verify_error);
 TEST (flash_blank_check_test);
 TEST (flash_blank_check_test_not_blank);
+TEST (flash_blank_check_test_unaligned_length);
+TEST (flash_blank_check_test_not_blank_word);
+TEST (flash_blank_check_test_not_blank_unaligned_tail);
 TEST (flash_blank_check_test_null);
 TEST (flash_blank_check_test_error);
 TEST (flash_copy_test);
@@ -18426,6 +20790,16 @@ TEST (flash_copy_to_blank_test);
 TEST (flash_copy_to_blank_and_verify_test);
 TEST (flash_copy_ext_to_blank_test);
 TEST (flash_copy_ext_to_blank_and_verify_test);
+TEST (flash_sector_copy_ext_differences_test);
+TEST (flash_sector_copy_ext_differences_test_no_differences);
+TEST (flash_sector_copy_ext_differences_test_across_erase_blocks);
+TEST (flash_sector_copy_ext_differences_test_no_rewritten_output);
+TEST (flash_sector_copy_ext_differences_test_no_length);
+TEST (flash_sector_copy_ext_differences_test_null);
+TEST (flash_sector_copy_ext_differences_test_same_erase_block);
+TEST (flash_sector_copy_ext_differences_test_read_error);
+TEST (flash_sector_copy_ext_differences_test_erase_error);
+TEST (flash_sector_copy_ext_differences_and_verify_test);
 TEST (flash_erase_region_and_verify_test);
 TEST (flash_erase_region_and_verify_test_not_blank);
 TEST (flash_erase_region_and_verify_test_null);
@@ -18459,6 +20833,9 @@ TEST (flash_verify_noncontiguous_contents_test_hash_buffer_too_small);
 TEST (flash_verify_noncontiguous_contents_test_read_error_with_hash_out);
 TEST (flash_value_check_test);
 TEST (flash_value_check_test_mismatch);
+TEST (flash_value_check_test_multiple_words);
+TEST (flash_value_check_test_mismatch_word);
+TEST (flash_value_check_test_mismatch_unaligned_tail);
 TEST (flash_value_check_test_null);
 TEST (flash_value_check_test_error);
 TEST (flash_sector_erase_region_test);
@@ -18479,6 +20856,27 @@ TEST (flash_sector_erase_region_and_verify_test_not_blank);
 TEST (flash_sector_erase_region_and_verify_test_null);
 TEST (flash_sector_erase_region_and_verify_test_sector_check_error);
 TEST (flash_sector_erase_region_and_verify_test_erase_error);
+TEST (flash_optimal_erase_region_test);
+TEST (flash_optimal_erase_region_test_single_block);
+TEST (flash_optimal_erase_region_test_multiple_blocks);
+TEST (flash_optimal_erase_region_test_sectors_and_blocks);
+TEST (flash_optimal_erase_region_test_offset_start);
+TEST (flash_optimal_erase_region_test_offset_start_block_aligned_end);
+TEST (flash_optimal_erase_region_test_partial_block);
+TEST (flash_optimal_erase_region_test_start_of_flash);
+TEST (flash_optimal_erase_region_test_whole_device);
+TEST (flash_optimal_erase_region_test_not_4k);
+TEST (flash_optimal_erase_region_test_no_length);
+TEST (flash_optimal_erase_region_test_null);
+TEST (flash_optimal_erase_region_test_sector_size_error);
+TEST (flash_optimal_erase_region_test_block_size_error);
+TEST (flash_optimal_erase_region_test_device_size_error);
+TEST (flash_optimal_erase_region_test_block_erase_error);
+TEST (flash_optimal_erase_region_test_sector_erase_error);
+TEST (flash_optimal_erase_region_test_chip_erase_error);
+TEST (flash_optimal_erase_region_and_verify_test);
+TEST (flash_optimal_erase_region_and_verify_test_not_blank);
+TEST (flash_optimal_erase_region_and_verify_test_null);
 TEST (flash_sector_program_data_test);
 TEST (flash_sector_program_data_test_offset);
 TEST (flash_sector_program_data_test_null);
@@ -18673,6 +21071,8 @@ TEST (flash_hash_update_noncontiguous_contents_test_sha384);
 TEST (flash_hash_update_noncontiguous_contents_test_sha512);
 TEST (flash_hash_update_noncontiguous_contents_test_multiple_blocks);
 TEST (flash_hash_update_noncontiguous_contents_test_multiple_regions);
+TEST (flash_hash_update_noncontiguous_contents_test_multiple_regions_read_regions);
+TEST (flash_hash_update_noncontiguous_contents_test_many_small_regions);
 TEST (flash_hash_update_noncontiguous_contents_test_zero_length);
 TEST (flash_hash_update_noncontiguous_contents_test_null);
 TEST (flash_hash_update_noncontiguous_contents_test_read_error);
@@ -18692,5 +21092,23 @@ TEST (flash_hash_update_noncontiguous_contents_at_offset_test_read_error);
 TEST (flash_hash_update_noncontiguous_contents_at_offset_test_multiple_blocks_read_error);
 TEST (flash_hash_update_noncontiguous_contents_at_offset_test_multiple_regions_read_error);
 TEST (flash_hash_update_noncontiguous_contents_at_offset_test_hash_update_error);
+TEST (flash_hash_update_noncontiguous_contents_at_offset_test_multiple_buffers);
+TEST (flash_hash_update_noncontiguous_contents_at_offset_test_multiple_buffers_read_error);
+TEST (flash_hash_update_noncontiguous_contents_at_offset_test_multiple_buffers_hash_error);
+TEST (flash_hash_pipeline_test_init);
+TEST (flash_hash_pipeline_test_init_null);
+TEST (flash_hash_pipeline_test_release_null);
+TEST (flash_hash_pipeline_test_run_null);
+TEST (flash_hash_pipeline_test_update);
+TEST (flash_hash_pipeline_test_update_many_small_regions);
+TEST (flash_hash_pipeline_test_update_null);
+TEST (flash_hash_pipeline_test_update_read_error);
+TEST (flash_hash_pipeline_test_update_hash_error);
+TEST (flash_hash_pipeline_test_update_busy);
+TEST (flash_hash_update_noncontiguous_contents_pipelined_test);
+TEST (flash_hash_update_noncontiguous_contents_pipelined_test_null);
+TEST (flash_hash_update_noncontiguous_contents_at_offset_test_default_pipeline);
+TEST (flash_hash_noncontiguous_contents_pipelined_test);
+TEST (flash_verify_noncontiguous_contents_pipelined_test);
 
 TEST_SUITE_END;
@@ -46,6 +46,7 @@ static void flash_virtual_ram_test_init (CuTest *test)
 
 	CuAssertPtrNotNull (test, virtual_flash.base.get_device_size);
 	CuAssertPtrNotNull (test, virtual_flash.base.read);
+	CuAssertPtrNotNull (test, virtual_flash.base.read_regions);
 	CuAssertPtrNotNull (test, virtual_flash.base.get_page_size);
 	CuAssertPtrNotNull (test, virtual_flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, virtual_flash.base.write);
@@ -69,6 +70,7 @@ static void flash_virtual_ram_test_init_static (CuTest *test)
 
 	CuAssertPtrNotNull (test, virtual_flash.base.get_device_size);
 	CuAssertPtrNotNull (test, virtual_flash.base.read);
+	CuAssertPtrNotNull (test, virtual_flash.base.read_regions);
 	CuAssertPtrNotNull (test, virtual_flash.base.get_page_size);
 	CuAssertPtrNotNull (test, virtual_flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, virtual_flash.base.write);
@@ -693,6 +695,166 @@ static void flash_virtual_ram_test_read_length_too_long (CuTest *test)
 	flash_virtual_ram_release (&virtual_flash);
 }
 
+static void flash_virtual_ram_test_read_regions (CuTest *test)
+{
+	struct flash_virtual_ram virtual_flash;
+	struct flash_virtual_ram_state state;
+	struct flash_region regions[3];
+	uint8_t read_data[32 + 16 + 64];
+	int status;
+
+	TEST_START;
+
+	status = flash_virtual_ram_init (&virtual_flash, &state, flash_virtual_ram_testing_buffer,
+		FLASH_VIRTUAL_RAM_TESTING_BUF_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	memcpy (flash_virtual_ram_testing_buffer, RSA_PRIVKEY_DER, (VIRTUAL_FLASH_BLOCK_SIZE * 4));
+
+	regions[0].start_addr = 0x100;
+	regions[0].length = 32;
+	regions[1].start_addr = 0x10;
+	regions[1].length = 16;
+	regions[2].start_addr = 0x200;
+	regions[2].length = 64;
+
+	status = virtual_flash.base.read_regions (&virtual_flash.base, regions, 3, read_data,
+		sizeof (read_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (&RSA_PRIVKEY_DER[0x100], read_data, 32);
+	status |= testing_validate_array (&RSA_PRIVKEY_DER[0x10], &read_data[32], 16);
+	status |= testing_validate_array (&RSA_PRIVKEY_DER[0x200], &read_data[48], 64);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_ram_release (&virtual_flash);
+}
+
+static void flash_virtual_ram_test_read_regions_static (CuTest *test)
+{
+	struct flash_virtual_ram_state state;
+	struct flash_virtual_ram virtual_flash =
+		flash_virtual_ram_static_init (&state, flash_virtual_ram_testing_buffer,
+		FLASH_VIRTUAL_RAM_TESTING_BUF_SIZE);
+	struct flash_region regions[2];
+	uint8_t read_data[8 + 24];
+	int status;
+
+	TEST_START;
+
+	status = flash_virtual_ram_init_state (&virtual_flash);
+	CuAssertIntEquals (test, 0, status);
+
+	memcpy (flash_virtual_ram_testing_buffer, RSA_PRIVKEY_DER, (VIRTUAL_FLASH_BLOCK_SIZE * 4));
+
+	regions[0].start_addr = 0x20;
+	regions[0].length = 8;
+	regions[1].start_addr = 0x80;
+	regions[1].length = 24;
+
+	status = virtual_flash.base.read_regions (&virtual_flash.base, regions, 2, read_data,
+		sizeof (read_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (&RSA_PRIVKEY_DER[0x20], read_data, 8);
+	status |= testing_validate_array (&RSA_PRIVKEY_DER[0x80], &read_data[8], 24);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_virtual_ram_release (&virtual_flash);
+}
+
+static void flash_virtual_ram_test_read_regions_null (CuTest *test)
+{
+	struct flash_virtual_ram virtual_flash;
+	struct flash_virtual_ram_state state;
+	struct flash_region regions[1];
+	uint8_t read_data[4];
+	int status;
+
+	TEST_START;
+
+	status = flash_virtual_ram_init (&virtual_flash, &state, flash_virtual_ram_testing_buffer,
+		FLASH_VIRTUAL_RAM_TESTING_BUF_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0;
+	regions[0].length = sizeof (read_data);
+
+	status = virtual_flash.base.read_regions (NULL, regions, 1, read_data, sizeof (read_data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = virtual_flash.base.read_regions (&virtual_flash.base, NULL, 1, read_data,
+		sizeof (read_data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = virtual_flash.base.read_regions (&virtual_flash.base, regions, 0, read_data,
+		sizeof (read_data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	status = virtual_flash.base.read_regions (&virtual_flash.base, regions, 1, NULL,
+		sizeof (read_data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_virtual_ram_release (&virtual_flash);
+}
+
+static void flash_virtual_ram_test_read_regions_out_of_range (CuTest *test)
+{
+	struct flash_virtual_ram virtual_flash;
+	struct flash_virtual_ram_state state;
+	struct flash_region regions[2];
+	uint8_t read_data[8];
+	int status;
+
+	TEST_START;
+
+	status = flash_virtual_ram_init (&virtual_flash, &state, flash_virtual_ram_testing_buffer,
+		FLASH_VIRTUAL_RAM_TESTING_BUF_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (read_data, 0x55, sizeof (read_data));
+
+	regions[0].start_addr = 0;
+	regions[0].length = 4;
+	regions[1].start_addr = FLASH_VIRTUAL_RAM_TESTING_BUF_SIZE - 2;
+	regions[1].length = 4;
+
+	status = virtual_flash.base.read_regions (&virtual_flash.base, regions, 2, read_data,
+		sizeof (read_data));
+	CuAssertIntEquals (test, FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	/* No data should be copied when any region is invalid. */
+	CuAssertIntEquals (test, 0x55, read_data[0]);
+
+	flash_virtual_ram_release (&virtual_flash);
+}
+
+static void flash_virtual_ram_test_read_regions_small_buffer (CuTest *test)
+{
+	struct flash_virtual_ram virtual_flash;
+	struct flash_virtual_ram_state state;
+	struct flash_region regions[2];
+	uint8_t read_data[8];
+	int status;
+
+	TEST_START;
+
+	status = flash_virtual_ram_init (&virtual_flash, &state, flash_virtual_ram_testing_buffer,
+		FLASH_VIRTUAL_RAM_TESTING_BUF_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0;
+	regions[0].length = 4;
+	regions[1].start_addr = 0x100;
+	regions[1].length = 5;
+
+	status = virtual_flash.base.read_regions (&virtual_flash.base, regions, 2, read_data,
+		sizeof (read_data));
+	CuAssertIntEquals (test, FLASH_INVALID_ARGUMENT, status);
+
+	flash_virtual_ram_release (&virtual_flash);
+}
+
 static void flash_virtual_ram_test_write (CuTest *test)
 {
 	struct flash_virtual_ram virtual_flash;
@@ -1355,6 +1517,11 @@ TEST (flash_virtual_ram_test_read_out_of_range_address_zero);
 TEST (flash_virtual_ram_test_read_out_of_range_address_non_zero);
 TEST (flash_virtual_ram_test_read_address_too_large);
 TEST (flash_virtual_ram_test_read_length_too_long);
+TEST (flash_virtual_ram_test_read_regions);
+TEST (flash_virtual_ram_test_read_regions_static);
+TEST (flash_virtual_ram_test_read_regions_null);
+TEST (flash_virtual_ram_test_read_regions_out_of_range);
+TEST (flash_virtual_ram_test_read_regions_small_buffer);
 
 // Write Tests
 TEST (flash_virtual_ram_test_write);
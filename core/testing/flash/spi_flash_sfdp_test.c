@@ -10249,6 +10249,215 @@ static void spi_flash_sfdp_test_get_deep_powerdown_commands_null (CuTest *test)
 	spi_flash_sfdp_release (&sfdp);
 }
 
+static void spi_flash_sfdp_test_get_operation_timing_w25q256jv (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_timing timing;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_W25Q256JV,
+		FLASH_ID_W25Q256JV);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_W25Q256JV,
+		SFDP_PARAMS_W25Q256JV_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_W25Q256JV, 1, -1,
+			SFDP_PARAMS_W25Q256JV_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_operation_timing (&table, &timing);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 704, timing.page_program_us);
+	CuAssertIntEquals (test, 4224, timing.page_program_max_us);
+	CuAssertIntEquals (test, 64, timing.sector_erase_ms);
+	CuAssertIntEquals (test, 896, timing.sector_erase_max_ms);
+	CuAssertIntEquals (test, 160, timing.block_erase_ms);
+	CuAssertIntEquals (test, 2240, timing.block_erase_max_ms);
+	CuAssertIntEquals (test, 80000, timing.chip_erase_ms);
+	CuAssertIntEquals (test, 1120000, timing.chip_erase_max_ms);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
+static void spi_flash_sfdp_test_get_operation_timing_mx25l25645g (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_timing timing;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_MX25L25645G,
+		FLASH_ID_MX25L25645G);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_MX25L25645G,
+		SFDP_PARAMS_MX25L25645G_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_MX25L25645G, 1, -1,
+			SFDP_PARAMS_MX25L25645G_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_operation_timing (&table, &timing);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 256, timing.page_program_us);
+	CuAssertIntEquals (test, 1536, timing.page_program_max_us);
+	CuAssertIntEquals (test, 30, timing.sector_erase_ms);
+	CuAssertIntEquals (test, 420, timing.sector_erase_max_ms);
+	CuAssertIntEquals (test, 384, timing.block_erase_ms);
+	CuAssertIntEquals (test, 5376, timing.block_erase_max_ms);
+	CuAssertIntEquals (test, 112000, timing.chip_erase_ms);
+	CuAssertIntEquals (test, 1568000, timing.chip_erase_max_ms);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
+static void spi_flash_sfdp_test_get_operation_timing_mx25l25635f (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_timing timing;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_MX25L25635F,
+		FLASH_ID_MX25L25635F);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_MX25L25635F,
+		SFDP_PARAMS_MX25L25635F_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_MX25L25635F, 1, -1,
+			SFDP_PARAMS_MX25L25635F_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&timing, 0x55, sizeof (timing));
+
+	status = spi_flash_sfdp_get_operation_timing (&table, &timing);
+	CuAssertIntEquals (test, SPI_FLASH_SFDP_TIMING_UNKNOWN, status);
+	CuAssertIntEquals (test, 0, timing.page_program_us);
+	CuAssertIntEquals (test, 0, timing.page_program_max_us);
+	CuAssertIntEquals (test, 0, timing.sector_erase_ms);
+	CuAssertIntEquals (test, 0, timing.sector_erase_max_ms);
+	CuAssertIntEquals (test, 0, timing.block_erase_ms);
+	CuAssertIntEquals (test, 0, timing.block_erase_max_ms);
+	CuAssertIntEquals (test, 0, timing.chip_erase_ms);
+	CuAssertIntEquals (test, 0, timing.chip_erase_max_ms);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
+static void spi_flash_sfdp_test_get_operation_timing_null (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_timing timing;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_W25Q256JV,
+		FLASH_ID_W25Q256JV);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_W25Q256JV,
+		SFDP_PARAMS_W25Q256JV_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_W25Q256JV, 1, -1,
+			SFDP_PARAMS_W25Q256JV_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_operation_timing (NULL, &timing);
+	CuAssertIntEquals (test, SPI_FLASH_SFDP_INVALID_ARGUMENT, status);
+
+	status = spi_flash_sfdp_get_operation_timing (&table, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_SFDP_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
 
 TEST_SUITE_START (spi_flash_sfdp);
 
@@ -10444,5 +10653,9 @@ TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_non_standard);
 TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_not_supported);
 TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_old_table_version);
 TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_null);
+TEST (spi_flash_sfdp_test_get_operation_timing_w25q256jv);
+TEST (spi_flash_sfdp_test_get_operation_timing_mx25l25645g);
+TEST (spi_flash_sfdp_test_get_operation_timing_mx25l25635f);
+TEST (spi_flash_sfdp_test_get_operation_timing_null);
 
 TEST_SUITE_END;
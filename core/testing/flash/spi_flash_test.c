@@ -175,6 +175,7 @@ static void spi_flash_test_init (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -243,6 +244,7 @@ static void spi_flash_test_init_fast_read (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -305,6 +307,7 @@ static void spi_flash_test_static_init (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -349,6 +352,7 @@ static void spi_flash_test_static_init_read_only (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -8527,14 +8531,21 @@ static void spi_flash_test_read_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write (CuTest *test)
+static void spi_flash_test_read_regions (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
+	uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t wip_status = 0;
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x10000, .length = 2},
+		{.start_addr = 0x200, .length = 3}
+	};
 
 	TEST_START;
 
@@ -8547,145 +8558,170 @@ static void spi_flash_test_write (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, 4,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, 4));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &data[4], 2,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, &data_in[4], 2));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &data[6], 3,
+		FLASH_EXP_READ_CMD (0x03, 0x200, 0, &data_in[6], 3));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_read_regions (&flash, regions, 3, data_in, length);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = testing_validate_array (data, data_in, length);
+	CuAssertIntEquals (test, 0, status);
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_across_page (CuTest *test)
+static void spi_flash_test_read_regions_batch (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t data[] = {1, 2, 3, 4};
-	uint8_t cmd_expected[] = {0x01};
-	uint8_t cmd2_expected[] = {0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
+	uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t wip_status = 0;
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x10000, .length = 2},
+		{.start_addr = 0x200, .length = 3}
+	};
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_master_mock_enable_xfer_batch (&mock);
+	CuAssertIntEquals (test, 0, status);
+
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x12ff, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
+	status |= mock_expect (&mock.mock, mock.base.xfer_batch, &mock, 0, MOCK_ARG (3));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, 4,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, 4));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &data[4], 2,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, &data_in[4], 2));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &data[6], 3,
+		FLASH_EXP_READ_CMD (0x03, 0x200, 0, &data_in[6], 3));
 
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1300, 0, cmd2_expected, sizeof (cmd2_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_read_regions (&flash, regions, 3, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x12ff, data, sizeof (data));
-	CuAssertIntEquals (test, sizeof (data), status);
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
+	status = testing_validate_array (data, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_multiple_pages (CuTest *test)
+static void spi_flash_test_read_regions_batch_multiple_batches (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t data[FLASH_PAGE_SIZE * 2];
-	uint8_t page1_expected[FLASH_PAGE_SIZE];
-	uint8_t page2_expected[FLASH_PAGE_SIZE];
-	uint8_t read_status = 0;
-	int i;
+	const size_t count = SPI_FLASH_READ_BATCH_SIZE + 2;
+	uint8_t data[count];
+	uint8_t data_in[count];
+	uint8_t wip_status = 0;
+	struct flash_region regions[count];
+	size_t i;
 
 	TEST_START;
 
+	for (i = 0; i < count; i++) {
+		data[i] = i;
+		regions[i].start_addr = 0x1000 * i;
+		regions[i].length = 1;
+	}
+
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash_master_mock_enable_xfer_batch (&mock);
+	CuAssertIntEquals (test, 0, status);
+
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	for (i = 0; i < FLASH_PAGE_SIZE; i++) {
-		data[i] = i;
-		page1_expected[i] = i;
-	}
-	for (i = FLASH_PAGE_SIZE - 1; i >= 0; i--) {
-		data[FLASH_PAGE_SIZE + i] = i;
-		page2_expected[i] = i;
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= mock_expect (&mock.mock, mock.base.xfer_batch, &mock, 0,
+		MOCK_ARG (SPI_FLASH_READ_BATCH_SIZE));
+	for (i = 0; i < SPI_FLASH_READ_BATCH_SIZE; i++) {
+		status |= flash_master_mock_expect_rx_xfer (&mock, 0, &data[i], 1,
+			FLASH_EXP_READ_CMD (0x03, 0x1000 * i, 0, &data_in[i], 1));
 	}
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1200, 0, page1_expected, sizeof (page1_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	status |= mock_expect (&mock.mock, mock.base.xfer_batch, &mock, 0, MOCK_ARG (2));
+	for (; i < count; i++) {
+		status |= flash_master_mock_expect_rx_xfer (&mock, 0, &data[i], 1,
+			FLASH_EXP_READ_CMD (0x03, 0x1000 * i, 0, &data_in[i], 1));
+	}
 
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1300, 0, page2_expected, sizeof (page2_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_read_regions (&flash, regions, count, data_in, sizeof (data_in));
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1200, data, sizeof (data));
-	CuAssertIntEquals (test, sizeof (data), status);
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
+	status = testing_validate_array (data, data_in, count);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_multiple_pages_not_aligned (CuTest *test)
+static void spi_flash_test_read_regions_empty_region (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t data[FLASH_PAGE_SIZE * 2];
-	uint8_t page1_expected[0x10] = {0x02, 0x00, 0x12, 0xf0};
-	uint8_t page2_expected[FLASH_PAGE_SIZE] = {0x02, 0x00, 0x13, 0x00};
-	uint8_t page3_expected[FLASH_PAGE_SIZE - 0x10] = {0x02, 0x00, 0x14, 0x00};
-	uint8_t read_status = 0;
-	int i;
-	uint8_t *pos;
+	uint8_t data[] = {1, 2, 3, 4, 5, 6};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t wip_status = 0;
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x10000, .length = 0},
+		{.start_addr = 0x200, .length = 2}
+	};
 
 	TEST_START;
 
@@ -8698,63 +8734,41 @@ static void spi_flash_test_write_multiple_pages_not_aligned (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	for (i = 0; i < FLASH_PAGE_SIZE; i++) {
-		data[i] = i;
-	}
-	for (i = FLASH_PAGE_SIZE - 1; i >= 0; i--) {
-		data[FLASH_PAGE_SIZE + i] = i;
-	}
-
-	pos = data;
-	for (i = 0; i < 0x10; i++, pos++) {
-		page1_expected[i] = *pos;
-	}
-	for (i = 0; i < FLASH_PAGE_SIZE; i++, pos++) {
-		page2_expected[i] = *pos;
-	}
-	for (i = 0; i < FLASH_PAGE_SIZE - 0x10; i++, pos++) {
-		page3_expected[i] = *pos;
-	}
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x12f0, 0, page1_expected, sizeof (page1_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1300, 0, page2_expected, sizeof (page2_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, 4,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, 4));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &data[4], 2,
+		FLASH_EXP_READ_CMD (0x03, 0x200, 0, &data_in[4], 2));
 
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1400, 0, page3_expected, sizeof (page3_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_read_regions (&flash, regions, 3, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x12f0, data, sizeof (data));
-	CuAssertIntEquals (test, sizeof (data), status);
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
+	status = testing_validate_array (data, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_max_address (CuTest *test)
+static void spi_flash_test_read_regions_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01};
-	uint8_t read_status = 0;
+	uint8_t data_in[4];
+	size_t length = sizeof (data_in);
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4}
+	};
 
 	TEST_START;
 
@@ -8767,36 +8781,36 @@ static void spi_flash_test_write_max_address (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0xffffff, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	status = spi_flash_read_regions (NULL, regions, 1, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_read_regions (&flash, NULL, 1, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = spi_flash_write (&flash, 0xffffff, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_read_regions (&flash, regions, 0, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_read_regions (&flash, regions, 1, NULL, length);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	spi_flash_is_write_in_progress (&flash);
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
 
-	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_4byte (CuTest *test)
+static void spi_flash_test_read_regions_out_of_range (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
+	uint8_t data_in[8];
+	size_t length = sizeof (data_in);
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x1000000, .length = 4}
+	};
 
 	TEST_START;
 
@@ -8806,39 +8820,30 @@ static void spi_flash_test_write_4byte (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x2000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_read_regions (&flash, regions, 2, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_ADDRESS_OUT_OF_RANGE, status);
 
-	status = mock_validate (&mock.mock);
+	status = flash_master_mock_validate_and_release (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_api (CuTest *test)
+static void spi_flash_test_read_regions_too_long (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
+	uint8_t data_in[8];
+	size_t length = sizeof (data_in);
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0xfffffd, .length = 4}
+	};
 
 	TEST_START;
 
@@ -8851,36 +8856,27 @@ static void spi_flash_test_write_flash_api (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash.base.write (&flash.base, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_read_regions (&flash, regions, 2, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_OPERATION_OUT_OF_RANGE, status);
 
-	status = mock_validate (&mock.mock);
+	status = flash_master_mock_validate_and_release (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_switch_4byte_address (CuTest *test)
+static void spi_flash_test_read_regions_small_buffer (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
+	uint8_t data_in[7];
+	size_t length = sizeof (data_in);
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x10000, .length = 4}
+	};
 
 	TEST_START;
 
@@ -8893,27 +8889,8 @@ static void spi_flash_test_write_switch_4byte_address (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	/* A small device that supports switching address modes is not a normal scenario.  Override the
-	 * internal capabilities to allow it to happen.  If the device size was just increased, the
-	 * native 4 byte commands would be used. */
-	state.capabilities = (FLASH_CAP_3BYTE_ADDR | FLASH_CAP_4BYTE_ADDR);
-
-	status = flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xb7));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_enable_4byte_address_mode (&flash, 1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, 4, status);
+	status = spi_flash_read_regions (&flash, regions, 2, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_SMALL_BUFFER, status);
 
 	status = flash_master_mock_validate_and_release (&mock);
 	CuAssertIntEquals (test, 0, status);
@@ -8921,13 +8898,1833 @@ static void spi_flash_test_write_switch_4byte_address (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_1_1_1_3byte_only (CuTest *test)
+static void spi_flash_test_read_regions_error_in_progress (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data_in[8];
+	size_t length = sizeof (data_in);
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x10000, .length = 4}
+	};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read_regions (&flash, regions, 2, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_read_regions_error (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[8];
+	size_t length = sizeof (data_in);
+	uint8_t wip_status = 0;
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x10000, .length = 4},
+		{.start_addr = 0x20000, .length = 0}
+	};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, 4,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, 4));
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, &data_in[4], 4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read_regions (&flash, regions, 3, data_in, length);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_read_regions_batch_error (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data_in[8];
+	size_t length = sizeof (data_in);
+	uint8_t wip_status = 0;
+	struct flash_region regions[] = {
+		{.start_addr = 0x1234, .length = 4},
+		{.start_addr = 0x10000, .length = 4}
+	};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_enable_xfer_batch (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= mock_expect (&mock.mock, mock.base.xfer_batch, &mock, FLASH_MASTER_XFER_DMA_ERROR,
+		MOCK_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read_regions (&flash, regions, 2, data_in, length);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_DMA_ERROR, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_across_page (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t cmd_expected[] = {0x01};
+	uint8_t cmd2_expected[] = {0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x12ff, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1300, 0, cmd2_expected, sizeof (cmd2_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x12ff, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_multiple_pages (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[FLASH_PAGE_SIZE * 2];
+	uint8_t page1_expected[FLASH_PAGE_SIZE];
+	uint8_t page2_expected[FLASH_PAGE_SIZE];
+	uint8_t read_status = 0;
+	int i;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < FLASH_PAGE_SIZE; i++) {
+		data[i] = i;
+		page1_expected[i] = i;
+	}
+	for (i = FLASH_PAGE_SIZE - 1; i >= 0; i--) {
+		data[FLASH_PAGE_SIZE + i] = i;
+		page2_expected[i] = i;
+	}
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1200, 0, page1_expected, sizeof (page1_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1300, 0, page2_expected, sizeof (page2_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1200, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_multiple_pages_not_aligned (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[FLASH_PAGE_SIZE * 2];
+	uint8_t page1_expected[0x10] = {0x02, 0x00, 0x12, 0xf0};
+	uint8_t page2_expected[FLASH_PAGE_SIZE] = {0x02, 0x00, 0x13, 0x00};
+	uint8_t page3_expected[FLASH_PAGE_SIZE - 0x10] = {0x02, 0x00, 0x14, 0x00};
+	uint8_t read_status = 0;
+	int i;
+	uint8_t *pos;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < FLASH_PAGE_SIZE; i++) {
+		data[i] = i;
+	}
+	for (i = FLASH_PAGE_SIZE - 1; i >= 0; i--) {
+		data[FLASH_PAGE_SIZE + i] = i;
+	}
+
+	pos = data;
+	for (i = 0; i < 0x10; i++, pos++) {
+		page1_expected[i] = *pos;
+	}
+	for (i = 0; i < FLASH_PAGE_SIZE; i++, pos++) {
+		page2_expected[i] = *pos;
+	}
+	for (i = 0; i < FLASH_PAGE_SIZE - 0x10; i++, pos++) {
+		page3_expected[i] = *pos;
+	}
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x12f0, 0, page1_expected, sizeof (page1_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1300, 0, page2_expected, sizeof (page2_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1400, 0, page3_expected, sizeof (page3_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x12f0, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_max_address (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0xffffff, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0xffffff, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x2000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_api (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash.base.write (&flash.base, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_switch_4byte_address (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* A small device that supports switching address modes is not a normal scenario.  Override the
+	 * internal capabilities to allow it to happen.  If the device size was just increased, the
+	 * native 4 byte commands would be used. */
+	state.capabilities = (FLASH_CAP_3BYTE_ADDR | FLASH_CAP_4BYTE_ADDR);
+
+	status = flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xb7));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_4byte_address_mode (&flash, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, 4, status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_1_1_1_3byte_only (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8020e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff088000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_1_1_1_3byte_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8220e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff088000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_1_1_1_4byte_only (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8420e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff088000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_1_1_2_3byte_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8320e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff003b08,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff088000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_1_2_2_3byte_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff9320e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xbb043b08,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff088000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_2_2_2_3byte_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff9320e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xbb043b08,
+		0xffffffef,
+		0xbb04ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff088000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_1_1_4_3byte_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xffd320e5,
+		0x00ffffff,
+		0x6b08ff00,
+		0xbb043b08,
+		0xffffffef,
+		0xbb04ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff288000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_1_4_4_3byte_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xfff320e5,
+		0x00ffffff,
+		0x6b08eb44,
+		0xbb043b08,
+		0xffffffef,
+		0xbb04ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff288000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flash_4_4_4_3byte_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xfff320e5,
+		0x00ffffff,
+		0x6b08eb44,
+		0xbb043b08,
+		0xffffffff,
+		0xbb04ffff,
+		0xeb44ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff288000,
+		0xa1f860e9
+	};
+	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
+		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
+		FLASH_CAP_4BYTE_ADDR;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, capabilities);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_flag_status_register (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = FLASH_FLAG_STATUS_READY;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8020e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2fb,
+		0xff088000,
+		0x80f820e9
+	};
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, FULL_CAPABILITIES);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_static (CuTest *test)
+{
+	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_API_INIT, &state, &mock.base);
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init_state (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_static_read_only (CuTest *test)
+{
+	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
+		&mock.base);
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init_state (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash.base.write (&flash.base, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_null (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (NULL, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = spi_flash_write (&flash, 0x1234, NULL, sizeof (cmd_expected));
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_out_of_range (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1000000, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, SPI_FLASH_ADDRESS_OUT_OF_RANGE, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_too_long (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0xfffffd, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, SPI_FLASH_OPERATION_OUT_OF_RANGE, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_error_enable (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_WRITE_ENABLE);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_error_write (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_error_second_page (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t cmd_expected[] = {0x01};
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x12ff, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_WRITE_ENABLE);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x12ff, data, sizeof (data));
+	CuAssertIntEquals (test, 1, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_error_in_progress (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t wip_status = FLASH_STATUS_WIP;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_error_in_progress_flag_status_register (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t wip_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8020e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2fb,
+		0xff088000,
+		0x80f820e9
+	};
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, FULL_CAPABILITIES);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_write_status_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
 	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase_offset_address (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1200);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase_max_address (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0xfff000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0xffffff);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase_4byte (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x2000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase_flash_api (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash.base.sector_erase (&flash.base, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase_switch_4byte_address (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* A small device that supports switching address modes is not a normal scenario.  Override the
+	 * internal capabilities to allow it to happen.  If the device size was just increased, the
+	 * native 4 byte commands would be used. */
+	state.capabilities = (FLASH_CAP_3BYTE_ADDR | FLASH_CAP_4BYTE_ADDR);
+
+	status = flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xb7));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_4byte_address_mode (&flash, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase_flash_1_1_1_3byte_only (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -8965,15 +10762,14 @@ static void spi_flash_test_write_flash_1_1_1_3byte_only (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -8984,13 +10780,12 @@ static void spi_flash_test_write_flash_1_1_1_3byte_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_1_1_1_3byte_4byte (CuTest *test)
+static void spi_flash_test_sector_erase_flash_1_1_1_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9028,15 +10823,14 @@ static void spi_flash_test_write_flash_1_1_1_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9047,13 +10841,12 @@ static void spi_flash_test_write_flash_1_1_1_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_1_1_1_4byte_only (CuTest *test)
+static void spi_flash_test_sector_erase_flash_1_1_1_4byte_only (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9091,15 +10884,14 @@ static void spi_flash_test_write_flash_1_1_1_4byte_only (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x20, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9110,13 +10902,12 @@ static void spi_flash_test_write_flash_1_1_1_4byte_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_1_1_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_sector_erase_flash_1_1_2_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9154,15 +10945,14 @@ static void spi_flash_test_write_flash_1_1_2_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9173,13 +10963,12 @@ static void spi_flash_test_write_flash_1_1_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_1_2_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_sector_erase_flash_1_2_2_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9217,15 +11006,14 @@ static void spi_flash_test_write_flash_1_2_2_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9236,13 +11024,12 @@ static void spi_flash_test_write_flash_1_2_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_2_2_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_sector_erase_flash_2_2_2_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9280,15 +11067,14 @@ static void spi_flash_test_write_flash_2_2_2_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9299,13 +11085,12 @@ static void spi_flash_test_write_flash_2_2_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_1_1_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_sector_erase_flash_1_1_4_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9343,15 +11128,14 @@ static void spi_flash_test_write_flash_1_1_4_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9362,13 +11146,12 @@ static void spi_flash_test_write_flash_1_1_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_1_4_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_sector_erase_flash_1_4_4_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9406,15 +11189,14 @@ static void spi_flash_test_write_flash_1_4_4_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9425,13 +11207,12 @@ static void spi_flash_test_write_flash_1_4_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flash_4_4_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_sector_erase_flash_4_4_4_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9469,15 +11250,14 @@ static void spi_flash_test_write_flash_4_4_4_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_4B_CMD (0x12, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9488,13 +11268,12 @@ static void spi_flash_test_write_flash_4_4_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_flag_status_register (CuTest *test)
+static void spi_flash_test_sector_erase_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t read_status = FLASH_FLAG_STATUS_READY;
 	uint32_t header[] = {
 		0x50444653,
@@ -9529,151 +11308,54 @@ static void spi_flash_test_write_flag_status_register (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_FLAG_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_FLAG_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_write_static (CuTest *test)
-{
-	struct flash_master_mock mock;
-	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_API_INIT, &state, &mock.base);
-	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init_state (&flash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, sizeof (cmd_expected), status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_write_static_read_only (CuTest *test)
-{
-	struct flash_master_mock mock;
-	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
-		&mock.base);
-	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init_state (&flash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash.base.write (&flash.base, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_write_null (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
+	status = spi_flash_sector_erase (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (NULL, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
-
-	status = spi_flash_write (&flash, 0x1234, NULL, sizeof (cmd_expected));
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
-
-	status = flash_master_mock_validate_and_release (&mock);
+	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_out_of_range (CuTest *test)
+static void spi_flash_test_sector_erase_static (CuTest *test)
 {
-	struct spi_flash_state state;
-	struct spi_flash flash;
 	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_API_INIT, &state, &mock.base);
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash, &state, &mock.base);
+	status = spi_flash_init_state (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1000000, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, SPI_FLASH_ADDRESS_OUT_OF_RANGE, status);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9684,27 +11366,27 @@ static void spi_flash_test_write_out_of_range (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_too_long (CuTest *test)
+static void spi_flash_test_sector_erase_static_read_only (CuTest *test)
 {
-	struct spi_flash_state state;
-	struct spi_flash flash;
 	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
+		&mock.base);
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash, &state, &mock.base);
+	status = spi_flash_init_state (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0xfffffd, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, SPI_FLASH_OPERATION_OUT_OF_RANGE, status);
+	status = flash.base.sector_erase (&flash.base, 0x1000);
+	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9715,14 +11397,12 @@ static void spi_flash_test_write_too_long (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_error_enable (CuTest *test)
+static void spi_flash_test_sector_erase_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -9735,33 +11415,21 @@ static void spi_flash_test_write_error_enable (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_WRITE_ENABLE);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_sector_erase (NULL, 0x1000);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = mock_validate (&mock.mock);
+	status = flash_master_mock_validate_and_release (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_error_write (CuTest *test)
+static void spi_flash_test_sector_erase_out_of_range (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
-	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -9774,16 +11442,8 @@ static void spi_flash_test_write_error_write (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_sector_erase (&flash, 0x1000000);
+	CuAssertIntEquals (test, SPI_FLASH_ADDRESS_OUT_OF_RANGE, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9794,14 +11454,12 @@ static void spi_flash_test_write_error_write (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_error_second_page (CuTest *test)
+static void spi_flash_test_sector_erase_error_enable (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t data[] = {1, 2, 3, 4};
-	uint8_t cmd_expected[] = {0x01};
 	uint8_t read_status = 0;
 
 	TEST_START;
@@ -9817,19 +11475,13 @@ static void spi_flash_test_write_error_second_page (CuTest *test)
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
-		FLASH_EXP_WRITE_CMD (0x02, 0x12ff, 0, cmd_expected, sizeof (cmd_expected)));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
 	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_WRITE_ENABLE);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x12ff, data, sizeof (data));
-	CuAssertIntEquals (test, 1, status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -9840,13 +11492,12 @@ static void spi_flash_test_write_error_second_page (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_error_in_progress (CuTest *test)
+static void spi_flash_test_sector_erase_error_in_progress (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t wip_status = FLASH_STATUS_WIP;
 
 	TEST_START;
@@ -9865,7 +11516,7 @@ static void spi_flash_test_write_error_in_progress (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	status = spi_flash_sector_erase (&flash, 0x1000);
 	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
 
 	status = mock_validate (&mock.mock);
@@ -9877,13 +11528,12 @@ static void spi_flash_test_write_error_in_progress (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_error_in_progress_flag_status_register (CuTest *test)
+static void spi_flash_test_sector_erase_error_in_progress_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 	uint8_t wip_status = 0;
 	uint32_t header[] = {
 		0x50444653,
@@ -9920,7 +11570,7 @@ static void spi_flash_test_write_error_in_progress_flag_status_register (CuTest
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	status = spi_flash_sector_erase (&flash, 0x1000);
 	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
 
 	status = mock_validate (&mock.mock);
@@ -9932,13 +11582,12 @@ static void spi_flash_test_write_error_in_progress_flag_status_register (CuTest
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_write_status_error (CuTest *test)
+static void spi_flash_test_sector_erase_status_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
 
 	TEST_START;
 
@@ -9956,7 +11605,7 @@ static void spi_flash_test_write_status_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	status = spi_flash_sector_erase (&flash, 0x1000);
 	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
@@ -9968,7 +11617,46 @@ static void spi_flash_test_write_status_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase (CuTest *test)
+static void spi_flash_test_sector_erase_error (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_sector_erase_wait_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -9991,12 +11679,52 @@ static void spi_flash_test_sector_erase (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_block_erase (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10008,7 +11736,7 @@ static void spi_flash_test_sector_erase (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_offset_address (CuTest *test)
+static void spi_flash_test_block_erase_offset_address (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10030,13 +11758,13 @@ static void spi_flash_test_sector_erase_offset_address (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1200);
+	status = spi_flash_block_erase (&flash, 0x12000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&mock);
@@ -10045,7 +11773,7 @@ static void spi_flash_test_sector_erase_offset_address (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_max_address (CuTest *test)
+static void spi_flash_test_block_erase_max_address (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10067,13 +11795,13 @@ static void spi_flash_test_sector_erase_max_address (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0xfff000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0xff0000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0xffffff);
+	status = spi_flash_block_erase (&flash, 0xffffff);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10085,7 +11813,7 @@ static void spi_flash_test_sector_erase_max_address (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_4byte (CuTest *test)
+static void spi_flash_test_block_erase_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10107,13 +11835,13 @@ static void spi_flash_test_sector_erase_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10125,7 +11853,7 @@ static void spi_flash_test_sector_erase_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_api (CuTest *test)
+static void spi_flash_test_block_erase_flash_api (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10147,13 +11875,13 @@ static void spi_flash_test_sector_erase_flash_api (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.sector_erase (&flash.base, 0x1000);
+	status = flash.base.block_erase (&flash.base, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10165,7 +11893,7 @@ static void spi_flash_test_sector_erase_flash_api (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_switch_4byte_address (CuTest *test)
+static void spi_flash_test_block_erase_switch_4byte_address (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10193,7 +11921,7 @@ static void spi_flash_test_sector_erase_switch_4byte_address (CuTest *test)
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
@@ -10202,7 +11930,7 @@ static void spi_flash_test_sector_erase_switch_4byte_address (CuTest *test)
 	status = spi_flash_enable_4byte_address_mode (&flash, 1);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&mock);
@@ -10211,7 +11939,7 @@ static void spi_flash_test_sector_erase_switch_4byte_address (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_1_1_1_3byte_only (CuTest *test)
+static void spi_flash_test_block_erase_flash_1_1_1_3byte_only (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10254,13 +11982,13 @@ static void spi_flash_test_sector_erase_flash_1_1_1_3byte_only (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10272,7 +12000,7 @@ static void spi_flash_test_sector_erase_flash_1_1_1_3byte_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_1_1_1_3byte_4byte (CuTest *test)
+static void spi_flash_test_block_erase_flash_1_1_1_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10315,13 +12043,13 @@ static void spi_flash_test_sector_erase_flash_1_1_1_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10333,7 +12061,7 @@ static void spi_flash_test_sector_erase_flash_1_1_1_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_1_1_1_4byte_only (CuTest *test)
+static void spi_flash_test_block_erase_flash_1_1_1_4byte_only (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10376,13 +12104,13 @@ static void spi_flash_test_sector_erase_flash_1_1_1_4byte_only (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10394,7 +12122,7 @@ static void spi_flash_test_sector_erase_flash_1_1_1_4byte_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_1_1_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_block_erase_flash_1_1_2_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10437,13 +12165,13 @@ static void spi_flash_test_sector_erase_flash_1_1_2_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10455,7 +12183,7 @@ static void spi_flash_test_sector_erase_flash_1_1_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_1_2_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_block_erase_flash_1_2_2_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10498,13 +12226,13 @@ static void spi_flash_test_sector_erase_flash_1_2_2_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10516,7 +12244,7 @@ static void spi_flash_test_sector_erase_flash_1_2_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_2_2_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_block_erase_flash_2_2_2_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10559,13 +12287,13 @@ static void spi_flash_test_sector_erase_flash_2_2_2_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10577,7 +12305,7 @@ static void spi_flash_test_sector_erase_flash_2_2_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_1_1_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_block_erase_flash_1_1_4_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10620,13 +12348,13 @@ static void spi_flash_test_sector_erase_flash_1_1_4_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10638,7 +12366,7 @@ static void spi_flash_test_sector_erase_flash_1_1_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_1_4_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_block_erase_flash_1_4_4_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10681,13 +12409,13 @@ static void spi_flash_test_sector_erase_flash_1_4_4_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10699,7 +12427,7 @@ static void spi_flash_test_sector_erase_flash_1_4_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flash_4_4_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_block_erase_flash_4_4_4_3byte_4byte (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10742,13 +12470,13 @@ static void spi_flash_test_sector_erase_flash_4_4_4_3byte_4byte (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0x21, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10760,7 +12488,7 @@ static void spi_flash_test_sector_erase_flash_4_4_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_flag_status_register (CuTest *test)
+static void spi_flash_test_block_erase_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10800,13 +12528,13 @@ static void spi_flash_test_sector_erase_flag_status_register (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_FLAG_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_FLAG_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10818,7 +12546,7 @@ static void spi_flash_test_sector_erase_flag_status_register (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_static (CuTest *test)
+static void spi_flash_test_block_erase_static (CuTest *test)
 {
 	struct flash_master_mock mock;
 	struct spi_flash_state state;
@@ -10840,13 +12568,13 @@ static void spi_flash_test_sector_erase_static (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -10858,7 +12586,7 @@ static void spi_flash_test_sector_erase_static (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_static_read_only (CuTest *test)
+static void spi_flash_test_block_erase_static_read_only (CuTest *test)
 {
 	struct flash_master_mock mock;
 	struct spi_flash_state state;
@@ -10877,7 +12605,7 @@ static void spi_flash_test_sector_erase_static_read_only (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.sector_erase (&flash.base, 0x1000);
+	status = flash.base.block_erase (&flash.base, 0x10000);
 	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
 
 	status = mock_validate (&mock.mock);
@@ -10889,7 +12617,7 @@ static void spi_flash_test_sector_erase_static_read_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_null (CuTest *test)
+static void spi_flash_test_block_erase_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10907,7 +12635,7 @@ static void spi_flash_test_sector_erase_null (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (NULL, 0x1000);
+	status = spi_flash_block_erase (NULL, 0x10000);
 	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&mock);
@@ -10916,7 +12644,7 @@ static void spi_flash_test_sector_erase_null (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_out_of_range (CuTest *test)
+static void spi_flash_test_block_erase_out_of_range (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10934,7 +12662,7 @@ static void spi_flash_test_sector_erase_out_of_range (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000000);
+	status = spi_flash_block_erase (&flash, 0x1000000);
 	CuAssertIntEquals (test, SPI_FLASH_ADDRESS_OUT_OF_RANGE, status);
 
 	status = mock_validate (&mock.mock);
@@ -10946,7 +12674,7 @@ static void spi_flash_test_sector_erase_out_of_range (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_error_enable (CuTest *test)
+static void spi_flash_test_block_erase_error_enable (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -10972,7 +12700,7 @@ static void spi_flash_test_sector_erase_error_enable (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
@@ -10984,7 +12712,7 @@ static void spi_flash_test_sector_erase_error_enable (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_error_in_progress (CuTest *test)
+static void spi_flash_test_block_erase_error_in_progress (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -11008,7 +12736,7 @@ static void spi_flash_test_sector_erase_error_in_progress (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_sector_erase (&flash, 0x1000);
+	status = spi_flash_block_erase (&flash, 0x10000);
 	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
 
 	status = mock_validate (&mock.mock);
@@ -11020,7 +12748,7 @@ static void spi_flash_test_sector_erase_error_in_progress (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_sector_erase_error_in_progress_flag_status_register (CuTest *test)
+static void spi_flash_test_block_erase_error_in_progress_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -11058,220 +12786,28 @@ static void spi_flash_test_sector_erase_error_in_progress_flag_status_register (
 		sizeof (params), 0x000030, FULL_CAPABILITIES);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_sector_erase (&flash, 0x1000);
-	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_sector_erase_status_error (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_sector_erase (&flash, 0x1000);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_sector_erase_error (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-	uint8_t read_status = 0;
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_ERASE_CMD (0x20, 0x1000));
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_sector_erase (&flash, 0x1000);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_sector_erase_wait_error (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-	uint8_t read_status = 0;
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_sector_erase (&flash, 0x1000);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_block_erase (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-	uint8_t read_status = 0;
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_block_erase_offset_address (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-	uint8_t read_status = 0;
-
-	TEST_START;
-
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+		FLASH_EXP_READ_FLAG_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x12000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_block_erase (&flash, 0x10000);
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
+	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_max_address (CuTest *test)
+static void spi_flash_test_block_erase_status_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -11284,17 +12820,13 @@ static void spi_flash_test_block_erase_max_address (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0xff0000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0xffffff);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_block_erase (&flash, 0x10000);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11305,7 +12837,7 @@ static void spi_flash_test_block_erase_max_address (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_4byte (CuTest *test)
+static void spi_flash_test_block_erase_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -11321,20 +12853,19 @@ static void spi_flash_test_block_erase_4byte (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x2000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11345,7 +12876,7 @@ static void spi_flash_test_block_erase_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_api (CuTest *test)
+static void spi_flash_test_block_erase_wait_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -11368,13 +12899,13 @@ static void spi_flash_test_block_erase_flash_api (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.block_erase (&flash.base, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_block_erase (&flash, 0x10000);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11385,7 +12916,7 @@ static void spi_flash_test_block_erase_flash_api (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_switch_4byte_address (CuTest *test)
+static void spi_flash_test_chip_erase (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -11401,86 +12932,53 @@ static void spi_flash_test_block_erase_switch_4byte_address (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	/* A small device that supports switching address modes is not a normal scenario.  Override the
-	 * internal capabilities to allow it to happen.  If the device size was just increased, the
-	 * native 4 byte commands would be used. */
-	state.capabilities = (FLASH_CAP_3BYTE_ADDR | FLASH_CAP_4BYTE_ADDR);
-
-	status = flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xb7));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xd8, 0x10000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_enable_4byte_address_mode (&flash, 1);
+	status = spi_flash_chip_erase (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
+	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
-	CuAssertIntEquals (test, 0, status);
+	spi_flash_is_write_in_progress (&flash);
 
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_1_1_1_3byte_only (CuTest *test)
+static void spi_flash_test_chip_erase_flash_api (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
 	uint8_t read_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8020e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2f7,
-		0xff088000,
-		0xa1f860e9
-	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
+	status = flash.base.chip_erase (&flash.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -11492,13 +12990,13 @@ static void spi_flash_test_block_erase_flash_1_1_1_3byte_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_1_1_1_3byte_4byte (CuTest *test)
+static void spi_flash_test_chip_erase_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint8_t read_status = FLASH_FLAG_STATUS_READY;
 	uint32_t header[] = {
 		0x50444653,
 		0xff010106,
@@ -11506,7 +13004,7 @@ static void spi_flash_test_block_erase_flash_1_1_1_3byte_4byte (CuTest *test)
 		0xff000030
 	};
 	uint32_t params[] = {
-		0xff8220e5,
+		0xff8020e5,
 		0x00ffffff,
 		0xff00ff00,
 		0xff00ff00,
@@ -11519,29 +13017,26 @@ static void spi_flash_test_block_erase_flash_1_1_1_3byte_4byte (CuTest *test)
 		0xb314ea82,
 		0x337663e9,
 		0x757a757a,
-		0x5cd5a2f7,
+		0x5cd5a2fb,
 		0xff088000,
-		0xa1f860e9
+		0x80f820e9
 	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
 	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+		sizeof (params), 0x000030, FULL_CAPABILITIES);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+		FLASH_EXP_READ_FLAG_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+		FLASH_EXP_READ_FLAG_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
+	status = spi_flash_chip_erase (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -11553,56 +13048,32 @@ static void spi_flash_test_block_erase_flash_1_1_1_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_1_1_1_4byte_only (CuTest *test)
+static void spi_flash_test_chip_erase_static (CuTest *test)
 {
-	struct spi_flash_state state;
-	struct spi_flash flash;
 	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_API_INIT, &state, &mock.base);
 	int status;
 	uint8_t read_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8420e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2f7,
-		0xff088000,
-		0xa1f860e9
-	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init_state (&flash);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xd8, 0x10000));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
+	status = spi_flash_chip_erase (&flash);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
@@ -11614,58 +13085,25 @@ static void spi_flash_test_block_erase_flash_1_1_1_4byte_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_1_1_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_chip_erase_static_read_only (CuTest *test)
 {
-	struct spi_flash_state state;
-	struct spi_flash flash;
 	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
+		&mock.base);
 	int status;
-	uint8_t read_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8320e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff003b08,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2f7,
-		0xff088000,
-		0xa1f860e9
-	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
+	status = spi_flash_init_state (&flash);
 	CuAssertIntEquals (test, 0, status);
 
+	status = flash.base.chip_erase (&flash.base);
+	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
+
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
@@ -11675,57 +13113,55 @@ static void spi_flash_test_block_erase_flash_1_1_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_1_2_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_chip_erase_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff9320e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xbb043b08,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2f7,
-		0xff088000,
-		0xa1f860e9
-	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_chip_erase (NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_chip_erase_error_enable (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_WRITE_ENABLE);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11736,57 +13172,29 @@ static void spi_flash_test_block_erase_flash_1_2_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_2_2_2_3byte_4byte (CuTest *test)
+static void spi_flash_test_chip_erase_error_in_progress (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff9320e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xbb043b08,
-		0xffffffef,
-		0xbb04ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2f7,
-		0xff088000,
-		0xa1f860e9
-	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
+	uint8_t wip_status = FLASH_STATUS_WIP;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11797,13 +13205,13 @@ static void spi_flash_test_block_erase_flash_2_2_2_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_1_1_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_chip_erase_error_in_progress_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint8_t wip_status = 0;
 	uint32_t header[] = {
 		0x50444653,
 		0xff010106,
@@ -11811,12 +13219,12 @@ static void spi_flash_test_block_erase_flash_1_1_4_3byte_4byte (CuTest *test)
 		0xff000030
 	};
 	uint32_t params[] = {
-		0xffd320e5,
+		0xff8020e5,
 		0x00ffffff,
-		0x6b08ff00,
-		0xbb043b08,
-		0xffffffef,
-		0xbb04ffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
 		0xff00ffff,
 		0xd810200c,
 		0xff00ff00,
@@ -11824,30 +13232,23 @@ static void spi_flash_test_block_erase_flash_1_1_4_3byte_4byte (CuTest *test)
 		0xb314ea82,
 		0x337663e9,
 		0x757a757a,
-		0x5cd5a2f7,
-		0xff288000,
-		0xa1f860e9
+		0x5cd5a2fb,
+		0xff088000,
+		0x80f820e9
 	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
 	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+		sizeof (params), 0x000030, FULL_CAPABILITIES);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11858,57 +13259,28 @@ static void spi_flash_test_block_erase_flash_1_1_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_1_4_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_chip_erase_status_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xfff320e5,
-		0x00ffffff,
-		0x6b08eb44,
-		0xbb043b08,
-		0xffffffef,
-		0xbb04ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2f7,
-		0xff288000,
-		0xa1f860e9
-	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11919,57 +13291,32 @@ static void spi_flash_test_block_erase_flash_1_4_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flash_4_4_4_3byte_4byte (CuTest *test)
+static void spi_flash_test_chip_erase_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
 	uint8_t read_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xfff320e5,
-		0x00ffffff,
-		0x6b08eb44,
-		0xbb043b08,
-		0xffffffff,
-		0xbb04ffff,
-		0xeb44ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2f7,
-		0xff288000,
-		0xa1f860e9
-	};
-	uint32_t capabilities = FLASH_CAP_DUAL_2_2_2 | FLASH_CAP_DUAL_1_2_2 | FLASH_CAP_DUAL_1_1_2 |
-		FLASH_CAP_QUAD_4_4_4 | FLASH_CAP_QUAD_1_4_4 | FLASH_CAP_QUAD_1_1_4 | FLASH_CAP_3BYTE_ADDR |
-		FLASH_CAP_4BYTE_ADDR;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, capabilities);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_4B_CMD (0xdc, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_OPCODE (0xc7));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -11980,54 +13327,33 @@ static void spi_flash_test_block_erase_flash_4_4_4_3byte_4byte (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_flag_status_register (CuTest *test)
+static void spi_flash_test_chip_erase_wait_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = FLASH_FLAG_STATUS_READY;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8020e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2fb,
-		0xff088000,
-		0x80f820e9
-	};
+	uint8_t read_status = 0;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, FULL_CAPABILITIES);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12038,36 +13364,25 @@ static void spi_flash_test_block_erase_flag_status_register (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_static (CuTest *test)
+static void spi_flash_test_get_sector_size (CuTest *test)
 {
-	struct flash_master_mock mock;
 	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_API_INIT, &state, &mock.base);
+	struct spi_flash flash;
+	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint32_t out;
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init_state (&flash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
+	status = spi_flash_get_sector_size (&flash, &out);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12078,27 +13393,25 @@ static void spi_flash_test_block_erase_static (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_static_read_only (CuTest *test)
+static void spi_flash_test_get_sector_size_flash_api (CuTest *test)
 {
-	struct flash_master_mock mock;
 	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
-		&mock.base);
+	struct spi_flash flash;
+	struct flash_master_mock mock;
 	int status;
+	uint32_t out;
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init_state (&flash);
+	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
+	status = flash.base.get_sector_size (&flash.base, &out);
 	CuAssertIntEquals (test, 0, status);
-
-	status = flash.base.block_erase (&flash.base, 0x10000);
-	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12109,39 +13422,42 @@ static void spi_flash_test_block_erase_static_read_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_null (CuTest *test)
+static void spi_flash_test_get_sector_size_static_read_only (CuTest *test)
 {
-	struct spi_flash_state state;
-	struct spi_flash flash;
 	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
+		&mock.base);
 	int status;
+	uint32_t out;
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
+	status = spi_flash_init_state (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (NULL, 0x10000);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	status = flash.base.get_sector_size (&flash.base, &out);
+	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
+	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_out_of_range (CuTest *test)
+static void spi_flash_test_get_sector_size_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12151,11 +13467,11 @@ static void spi_flash_test_block_erase_out_of_range (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_get_sector_size (NULL, &out);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = spi_flash_block_erase (&flash, 0x1000000);
-	CuAssertIntEquals (test, SPI_FLASH_ADDRESS_OUT_OF_RANGE, status);
+	status = spi_flash_get_sector_size (&flash, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12166,13 +13482,13 @@ static void spi_flash_test_block_erase_out_of_range (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_error_enable (CuTest *test)
+static void spi_flash_test_get_block_size (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12182,18 +13498,9 @@ static void spi_flash_test_block_erase_error_enable (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_WRITE_ENABLE);
-
+	status = spi_flash_get_block_size (&flash, &out);
 	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, FLASH_BLOCK_SIZE, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12204,13 +13511,13 @@ static void spi_flash_test_block_erase_error_enable (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_error_in_progress (CuTest *test)
+static void spi_flash_test_get_block_size_flash_api (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = FLASH_STATUS_WIP;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12220,16 +13527,9 @@ static void spi_flash_test_block_erase_error_in_progress (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = flash.base.get_block_size (&flash.base, &out);
 	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+	CuAssertIntEquals (test, FLASH_BLOCK_SIZE, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12240,50 +13540,25 @@ static void spi_flash_test_block_erase_error_in_progress (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_error_in_progress_flag_status_register (CuTest *test)
+static void spi_flash_test_get_block_size_static_read_only (CuTest *test)
 {
-	struct spi_flash_state state;
-	struct spi_flash flash;
 	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
+		&mock.base);
 	int status;
-	uint8_t wip_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8020e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2fb,
-		0xff088000,
-		0x80f820e9
-	};
+	uint32_t out;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, FULL_CAPABILITIES);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_init_state (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+	status = flash.base.get_block_size (&flash.base, &out);
+	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12294,12 +13569,13 @@ static void spi_flash_test_block_erase_error_in_progress_flag_status_register (C
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_status_error (CuTest *test)
+static void spi_flash_test_get_block_size_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12309,16 +13585,11 @@ static void spi_flash_test_block_erase_status_error (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_get_block_size (NULL, &out);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_get_block_size (&flash, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12329,13 +13600,13 @@ static void spi_flash_test_block_erase_status_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_error (CuTest *test)
+static void spi_flash_test_get_page_size (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12345,19 +13616,9 @@ static void spi_flash_test_block_erase_error (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
-
+	status = spi_flash_get_page_size (&flash, &out);
 	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, FLASH_PAGE_SIZE, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12368,13 +13629,13 @@ static void spi_flash_test_block_erase_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_block_erase_wait_error (CuTest *test)
+static void spi_flash_test_get_page_size_flash_api (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12384,20 +13645,9 @@ static void spi_flash_test_block_erase_wait_error (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = flash.base.get_page_size (&flash.base, &out);
 	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_block_erase (&flash, 0x10000);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	CuAssertIntEquals (test, FLASH_PAGE_SIZE, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12408,33 +13658,25 @@ static void spi_flash_test_block_erase_wait_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase (CuTest *test)
+static void spi_flash_test_get_page_size_static_read_only (CuTest *test)
 {
-	struct spi_flash_state state;
-	struct spi_flash flash;
 	struct flash_master_mock mock;
+	struct spi_flash_state state;
+	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
+		&mock.base);
 	int status;
-	uint8_t read_status = 0;
+	uint32_t out;
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_init_state (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
-	CuAssertIntEquals (test, 0, status);
+	status = flash.base.get_page_size (&flash.base, &out);
+	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12445,13 +13687,13 @@ static void spi_flash_test_chip_erase (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_flash_api (CuTest *test)
+static void spi_flash_test_get_page_size_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12461,17 +13703,11 @@ static void spi_flash_test_chip_erase_flash_api (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_get_block_size (NULL, &out);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = flash.base.chip_erase (&flash.base);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_get_block_size (&flash, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12482,54 +13718,25 @@ static void spi_flash_test_chip_erase_flash_api (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_flag_status_register (CuTest *test)
+static void spi_flash_test_minimum_write_per_page (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = FLASH_FLAG_STATUS_READY;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8020e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2fb,
-		0xff088000,
-		0x80f820e9
-	};
+	uint32_t out;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, FULL_CAPABILITIES);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
+	status = spi_flash_minimum_write_per_page (&flash, &out);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12540,33 +13747,25 @@ static void spi_flash_test_chip_erase_flag_status_register (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_static (CuTest *test)
+static void spi_flash_test_minimum_write_per_page_flash_api (CuTest *test)
 {
-	struct flash_master_mock mock;
 	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_API_INIT, &state, &mock.base);
+	struct spi_flash flash;
+	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint32_t out;
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init_state (&flash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
+	status = flash.base.minimum_write_per_page (&flash.base, &out);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12577,13 +13776,14 @@ static void spi_flash_test_chip_erase_static (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_static_read_only (CuTest *test)
+static void spi_flash_test_minimum_write_per_page_static_read_only (CuTest *test)
 {
 	struct flash_master_mock mock;
 	struct spi_flash_state state;
 	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
 		&mock.base);
 	int status;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12593,7 +13793,7 @@ static void spi_flash_test_chip_erase_static_read_only (CuTest *test)
 	status = spi_flash_init_state (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.chip_erase (&flash.base);
+	status = flash.base.minimum_write_per_page (&flash.base, &out);
 	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
 
 	status = mock_validate (&mock.mock);
@@ -12605,12 +13805,13 @@ static void spi_flash_test_chip_erase_static_read_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_null (CuTest *test)
+static void spi_flash_test_minimum_write_per_page_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint32_t out;
 
 	TEST_START;
 
@@ -12620,22 +13821,28 @@ static void spi_flash_test_chip_erase_null (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (NULL);
+	status = spi_flash_minimum_write_per_page (NULL, &out);
 	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
+	status = spi_flash_minimum_write_per_page (&flash, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	spi_flash_is_write_in_progress (&flash);
+
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_error_enable (CuTest *test)
+static void spi_flash_test_is_write_in_progress (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint8_t wip_status = FLASH_STATUS_WIP;
 
 	TEST_START;
 
@@ -12645,15 +13852,13 @@ static void spi_flash_test_chip_erase_error_enable (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_WRITE_ENABLE);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_is_write_in_progress (&flash);
+	CuAssertIntEquals (test, 1, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12664,13 +13869,13 @@ static void spi_flash_test_chip_erase_error_enable (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_error_in_progress (CuTest *test)
+static void spi_flash_test_is_write_in_progress_no_write (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = FLASH_STATUS_WIP;
+	uint8_t wip_status = 0;
 
 	TEST_START;
 
@@ -12685,8 +13890,59 @@ static void spi_flash_test_chip_erase_error_in_progress (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
-	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+	status = spi_flash_is_write_in_progress (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_is_write_in_progress_flag_status_register (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t wip_status = 0;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8020e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2fb,
+		0xff088000,
+		0x80f820e9
+	};
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, FULL_CAPABILITIES);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_is_write_in_progress (&flash);
+	CuAssertIntEquals (test, 1, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12697,13 +13953,13 @@ static void spi_flash_test_chip_erase_error_in_progress (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_error_in_progress_flag_status_register (CuTest *test)
+static void spi_flash_test_is_write_in_progress_no_write_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = 0;
+	uint8_t wip_status = FLASH_FLAG_STATUS_READY;
 	uint32_t header[] = {
 		0x50444653,
 		0xff010106,
@@ -12739,8 +13995,8 @@ static void spi_flash_test_chip_erase_error_in_progress_flag_status_register (Cu
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
-	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+	status = spi_flash_is_write_in_progress (&flash);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12751,7 +14007,7 @@ static void spi_flash_test_chip_erase_error_in_progress_flag_status_register (Cu
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_status_error (CuTest *test)
+static void spi_flash_test_is_write_in_progress_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
@@ -12771,7 +14027,7 @@ static void spi_flash_test_chip_erase_status_error (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
+	status = spi_flash_is_write_in_progress (&flash);
 	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
@@ -12783,12 +14039,23 @@ static void spi_flash_test_chip_erase_status_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_error (CuTest *test)
+static void spi_flash_test_is_write_in_progress_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = spi_flash_is_write_in_progress (NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+}
+
+static void spi_flash_test_wait_for_write (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint8_t wip_status = FLASH_STATUS_WIP;
 	uint8_t read_status = 0;
 
 	TEST_START;
@@ -12799,16 +14066,17 @@ static void spi_flash_test_chip_erase_error (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_OPCODE (0xc7));
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_wait_for_write (&flash, 100);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12819,33 +14087,55 @@ static void spi_flash_test_chip_erase_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_chip_erase_wait_error (CuTest *test)
+static void spi_flash_test_wait_for_write_flag_status_register (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t read_status = 0;
+	uint8_t wip_status = 0;
+	uint8_t read_status = FLASH_FLAG_STATUS_READY;
+	uint32_t header[] = {
+		0x50444653,
+		0xff010106,
+		0x10010600,
+		0xff000030
+	};
+	uint32_t params[] = {
+		0xff8020e5,
+		0x00ffffff,
+		0xff00ff00,
+		0xff00ff00,
+		0xffffffee,
+		0xff00ffff,
+		0xff00ffff,
+		0xd810200c,
+		0xff00ff00,
+		0x00a60236,
+		0xb314ea82,
+		0x337663e9,
+		0x757a757a,
+		0x5cd5a2fb,
+		0xff088000,
+		0x80f820e9
+	};
 
 	TEST_START;
 
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &mock.base);
-	CuAssertIntEquals (test, 0, status);
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
+		sizeof (params), 0x000030, FULL_CAPABILITIES);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
-	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
-	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_FLAG_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_chip_erase (&flash);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_wait_for_write (&flash, 100);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12856,13 +14146,12 @@ static void spi_flash_test_chip_erase_wait_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_sector_size (CuTest *test)
+static void spi_flash_test_wait_for_write_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
 
 	TEST_START;
 
@@ -12872,26 +14161,22 @@ static void spi_flash_test_get_sector_size (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_get_sector_size (&flash, &out);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, FLASH_SECTOR_SIZE, out);
+	status = spi_flash_wait_for_write (NULL, 100);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = mock_validate (&mock.mock);
+	status = flash_master_mock_validate_and_release (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_sector_size_flash_api (CuTest *test)
+static void spi_flash_test_wait_for_write_timeout (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t wip_status = FLASH_STATUS_WIP;
 
 	TEST_START;
 
@@ -12901,38 +14186,52 @@ static void spi_flash_test_get_sector_size_flash_api (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.get_sector_size (&flash.base, &out);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, FLASH_SECTOR_SIZE, out);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
 
-	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_wait_for_write (&flash, 35);
+	CuAssertIntEquals (test, SPI_FLASH_WIP_TIMEOUT, status);
+	CuAssertTrue (test, ((mock.mock.call_count >= 3) && (mock.mock.call_count <= 5)));
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_sector_size_static_read_only (CuTest *test)
+static void spi_flash_test_wait_for_write_immediate_timeout (CuTest *test)
 {
-	struct flash_master_mock mock;
 	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
-		&mock.base);
+	struct spi_flash flash;
+	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t wip_status = FLASH_STATUS_WIP;
 
 	TEST_START;
 
 	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init_state (&flash);
+	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.get_sector_size (&flash.base, &out);
-	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_wait_for_write (&flash, 0);
+	CuAssertIntEquals (test, SPI_FLASH_WIP_TIMEOUT, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -12943,13 +14242,14 @@ static void spi_flash_test_get_sector_size_static_read_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_sector_size_null (CuTest *test)
+static void spi_flash_test_wait_for_write_no_timeout (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -12959,28 +14259,33 @@ static void spi_flash_test_get_sector_size_null (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_get_sector_size (NULL, &out);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
 
-	status = spi_flash_get_sector_size (&flash, NULL);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, status);
 
-	status = mock_validate (&mock.mock);
+	status = spi_flash_wait_for_write (&flash, -1);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
+	status = flash_master_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
 
-	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_block_size (CuTest *test)
+static void spi_flash_test_wait_for_write_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t wip_status = FLASH_STATUS_WIP;
 
 	TEST_START;
 
@@ -12990,9 +14295,17 @@ static void spi_flash_test_get_block_size (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_get_block_size (&flash, &out);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, FLASH_MASTER_XFER_FAILED, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
 	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, FLASH_BLOCK_SIZE, out);
+
+	status = spi_flash_wait_for_write (&flash, 100);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13003,13 +14316,16 @@ static void spi_flash_test_get_block_size (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_block_size_flash_api (CuTest *test)
+static void spi_flash_test_write_state_tracking_read (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t data[] = {1, 2, 3, 4};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -13019,38 +14335,34 @@ static void spi_flash_test_get_block_size_flash_api (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.get_block_size (&flash.base, &out);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, FLASH_BLOCK_SIZE, out);
 
-	status = mock_validate (&mock.mock);
+	status = spi_flash_enable_write_state_tracking (&flash, true);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x5678, 0, data_in, length));
 
-static void spi_flash_test_get_block_size_static_read_only (CuTest *test)
-{
-	struct flash_master_mock mock;
-	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
-		&mock.base);
-	int status;
-	uint32_t out;
+	CuAssertIntEquals (test, 0, status);
 
-	TEST_START;
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&mock);
+	status = testing_validate_array (data, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init_state (&flash);
+	memset (data_in, 0, length);
+
+	status = spi_flash_read (&flash, 0x5678, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.get_block_size (&flash.base, &out);
-	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
+	status = testing_validate_array (data, data_in, length);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13061,13 +14373,17 @@ static void spi_flash_test_get_block_size_static_read_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_block_size_null (CuTest *test)
+static void spi_flash_test_write_state_tracking_read_write_in_progress (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t data[] = {1, 2, 3, 4};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t read_status = 0;
+	uint8_t wip_status = FLASH_STATUS_WIP;
 
 	TEST_START;
 
@@ -13077,11 +14393,31 @@ static void spi_flash_test_get_block_size_null (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_get_block_size (NULL, &out);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_get_block_size (&flash, NULL);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	status = spi_flash_enable_write_state_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x5678, 0, data_in, length));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x5678, data_in, length);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13092,13 +14428,16 @@ static void spi_flash_test_get_block_size_null (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_page_size (CuTest *test)
+static void spi_flash_test_write_state_tracking_write (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t data[] = {1, 2, 3, 4};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -13108,9 +14447,36 @@ static void spi_flash_test_get_page_size (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_get_page_size (&flash, &out);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_write_state_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
+
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, data, length));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, data, length);
+	CuAssertIntEquals (test, length, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, FLASH_PAGE_SIZE, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13121,13 +14487,16 @@ static void spi_flash_test_get_page_size (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_page_size_flash_api (CuTest *test)
+static void spi_flash_test_write_state_tracking_write_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t data[] = {1, 2, 3, 4};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -13137,38 +14506,36 @@ static void spi_flash_test_get_page_size_flash_api (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.get_page_size (&flash.base, &out);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, FLASH_PAGE_SIZE, out);
 
-	status = mock_validate (&mock.mock);
+	status = spi_flash_enable_write_state_tracking (&flash, true);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
 
-static void spi_flash_test_get_page_size_static_read_only (CuTest *test)
-{
-	struct flash_master_mock mock;
-	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
-		&mock.base);
-	int status;
-	uint32_t out;
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, data, length));
 
-	TEST_START;
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
 
-	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init_state (&flash);
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.get_page_size (&flash.base, &out);
-	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
+	status = spi_flash_write (&flash, 0x1234, data, length);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13179,27 +14546,48 @@ static void spi_flash_test_get_page_size_static_read_only (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_get_page_size_null (CuTest *test)
+static void spi_flash_test_write_state_tracking_sector_erase (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t data[] = {1, 2, 3, 4};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_write_state_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
 
-	TEST_START;
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
 
-	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash, &state, &mock.base);
+	status = spi_flash_sector_erase (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_get_block_size (NULL, &out);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
-
-	status = spi_flash_get_block_size (&flash, NULL);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13210,13 +14598,16 @@ static void spi_flash_test_get_page_size_null (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_minimum_write_per_page (CuTest *test)
+static void spi_flash_test_write_state_tracking_disable (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	uint8_t data[] = {1, 2, 3, 4};
+	const size_t length = sizeof (data);
+	uint8_t data_in[length];
+	uint8_t read_status = 0;
 
 	TEST_START;
 
@@ -13226,38 +14617,40 @@ static void spi_flash_test_minimum_write_per_page (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_minimum_write_per_page (&flash, &out);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, 1, out);
 
-	status = mock_validate (&mock.mock);
+	status = spi_flash_enable_write_state_tracking (&flash, true);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_is_write_in_progress (&flash);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
 
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
-}
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
 
-static void spi_flash_test_minimum_write_per_page_flash_api (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-	uint32_t out;
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, length));
 
-	TEST_START;
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&mock);
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash, &state, &mock.base);
+	status = spi_flash_enable_write_state_tracking (&flash, false);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash.base.minimum_write_per_page (&flash.base, &out);
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, length);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertIntEquals (test, 1, out);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13268,42 +14661,24 @@ static void spi_flash_test_minimum_write_per_page_flash_api (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_minimum_write_per_page_static_read_only (CuTest *test)
+static void spi_flash_test_enable_write_state_tracking_null (CuTest *test)
 {
-	struct flash_master_mock mock;
-	struct spi_flash_state state;
-	struct spi_flash flash = spi_flash_static_init (SPI_FLASH_READ_ONLY_API_INIT, &state,
-		&mock.base);
 	int status;
-	uint32_t out;
 
 	TEST_START;
 
-	status = flash_master_mock_init (&mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init_state (&flash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash.base.minimum_write_per_page (&flash.base, &out);
-	CuAssertIntEquals (test, SPI_FLASH_READ_ONLY_INTERFACE, status);
-
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_is_write_in_progress (&flash);
-
-	flash_master_mock_release (&mock);
-	spi_flash_release (&flash);
+	status = spi_flash_enable_write_state_tracking (NULL, true);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 }
 
-static void spi_flash_test_minimum_write_per_page_null (CuTest *test)
+static void spi_flash_test_get_write_latency_no_operations (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint32_t out;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
@@ -13313,14 +14688,43 @@ static void spi_flash_test_minimum_write_per_page_null (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_minimum_write_per_page (NULL, &out);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_minimum_write_per_page (&flash, NULL);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_PAGE_PROGRAM, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
 
-	status = mock_validate (&mock.mock);
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_REGISTER_WRITE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_SECTOR_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_BLOCK_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_CHIP_ERASE, &latency);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
 
 	spi_flash_is_write_in_progress (&flash);
 
@@ -13328,13 +14732,17 @@ static void spi_flash_test_minimum_write_per_page_null (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_is_write_in_progress (CuTest *test)
+static void spi_flash_test_get_write_latency_page_program (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t read_status = 0;
 	uint8_t wip_status = FLASH_STATUS_WIP;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
@@ -13344,30 +14752,58 @@ static void spi_flash_test_is_write_in_progress (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, data, sizeof (data)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_is_write_in_progress (&flash);
-	CuAssertIntEquals (test, 1, status);
+	status = spi_flash_write (&flash, 0x1234, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_PAGE_PROGRAM, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, latency.polls);
+	CuAssertIntEquals (test, 1, latency.bucket[0]);
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_SECTOR_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_is_write_in_progress_no_write (CuTest *test)
+static void spi_flash_test_get_write_latency_sector_erase (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = 0;
+	uint32_t total = 0;
+	uint8_t read_status = 0;
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
@@ -13377,121 +14813,149 @@ static void spi_flash_test_is_write_in_progress_no_write (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_is_write_in_progress (&flash);
+	status = spi_flash_sector_erase (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_SECTOR_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, latency.polls);
+
+	/* Without device timing information, the first delay is 1 ms. */
+	CuAssertIntEquals (test, 0, latency.bucket[0]);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		total += latency.bucket[i];
+	}
+	CuAssertIntEquals (test, 1, total);
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_BLOCK_ERASE, &latency);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
+	spi_flash_is_write_in_progress (&flash);
 
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_is_write_in_progress_flag_status_register (CuTest *test)
+static void spi_flash_test_get_write_latency_sector_erase_typical_time (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = 0;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8020e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2fb,
-		0xff088000,
-		0x80f820e9
-	};
+	uint32_t total = 0;
+	uint8_t read_status = 0;
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, FULL_CAPABILITIES);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_is_write_in_progress (&flash);
-	CuAssertIntEquals (test, 1, status);
+	/* Report a typical erase time of 40 ms, so the first status check is delayed by 20 ms. */
+	state.timing.sector_erase_ms = 40;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_SECTOR_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, latency.polls);
+
+	for (i = 0; i < 5; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		total += latency.bucket[i];
+	}
+	CuAssertIntEquals (test, 1, total);
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_is_write_in_progress_no_write_flag_status_register (CuTest *test)
+static void spi_flash_test_sector_erase_max_time_timeout (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = FLASH_FLAG_STATUS_READY;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8020e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2fb,
-		0xff088000,
-		0x80f820e9
-	};
+	uint8_t read_status = 0;
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	int i;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, FULL_CAPABILITIES);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The device reports a maximum erase time of 10 ms, but never finishes the erase. */
+	state.timing.sector_erase_max_ms = 10;
 
-	CuAssertIntEquals (test, 0, status);
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	for (i = 0; i < 8; i++) {
+		status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+			FLASH_EXP_READ_STATUS_REG);
+	}
 
-	status = spi_flash_is_write_in_progress (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mock_validate (&mock.mock);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, SPI_FLASH_WIP_TIMEOUT, status);
+	CuAssertTrue (test, ((mock.mock.call_count >= 5) && (mock.mock.call_count <= 9)));
 
 	spi_flash_is_write_in_progress (&flash);
 
@@ -13499,12 +14963,15 @@ static void spi_flash_test_is_write_in_progress_no_write_flag_status_register (C
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_is_write_in_progress_error (CuTest *test)
+static void spi_flash_test_block_erase_max_time_timeout (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint8_t read_status = 0;
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	int i;
 
 	TEST_START;
 
@@ -13514,41 +14981,43 @@ static void spi_flash_test_is_write_in_progress_error (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_is_write_in_progress (&flash);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	/* Only the block erase time applies to block erase operations. */
+	state.timing.sector_erase_max_ms = 1;
+	state.timing.block_erase_max_ms = 10;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
+	for (i = 0; i < 8; i++) {
+		status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+			FLASH_EXP_READ_STATUS_REG);
+	}
 
-	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_block_erase (&flash, 0x10000);
+	CuAssertIntEquals (test, SPI_FLASH_WIP_TIMEOUT, status);
+	CuAssertTrue (test, ((mock.mock.call_count >= 5) && (mock.mock.call_count <= 9)));
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_is_write_in_progress_null (CuTest *test)
-{
-	int status;
-
-	TEST_START;
-
-	status = spi_flash_is_write_in_progress (NULL);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
-}
-
-static void spi_flash_test_wait_for_write (CuTest *test)
+static void spi_flash_test_chip_erase_max_time_timeout (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = FLASH_STATUS_WIP;
 	uint8_t read_status = 0;
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	int i;
 
 	TEST_START;
 
@@ -13558,92 +15027,112 @@ static void spi_flash_test_wait_for_write (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_wait_for_write (&flash, 100);
-	CuAssertIntEquals (test, 0, status);
+	state.timing.chip_erase_max_ms = 10;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
+	for (i = 0; i < 8; i++) {
+		status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+			FLASH_EXP_READ_STATUS_REG);
+	}
 
-	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, SPI_FLASH_WIP_TIMEOUT, status);
+	CuAssertTrue (test, ((mock.mock.call_count >= 5) && (mock.mock.call_count <= 9)));
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_wait_for_write_flag_status_register (CuTest *test)
+static void spi_flash_test_get_write_latency_block_erase (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = 0;
-	uint8_t read_status = FLASH_FLAG_STATUS_READY;
-	uint32_t header[] = {
-		0x50444653,
-		0xff010106,
-		0x10010600,
-		0xff000030
-	};
-	uint32_t params[] = {
-		0xff8020e5,
-		0x00ffffff,
-		0xff00ff00,
-		0xff00ff00,
-		0xffffffee,
-		0xff00ffff,
-		0xff00ffff,
-		0xd810200c,
-		0xff00ff00,
-		0x00a60236,
-		0xb314ea82,
-		0x337663e9,
-		0x757a757a,
-		0x5cd5a2fb,
-		0xff088000,
-		0x80f820e9
-	};
+	uint8_t read_status = 0;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
-	spi_flash_testing_discover_params (test, &flash, &state, &mock, TEST_ID, header, params,
-		sizeof (params), 0x000030, FULL_CAPABILITIES);
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x10000));
 	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_FLAG_STATUS_REG);
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0xd8, 0x20000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_wait_for_write (&flash, 100);
+	status = spi_flash_block_erase (&flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_block_erase (&flash, 0x20000);
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_BLOCK_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, latency.polls);
+	CuAssertIntEquals (test, 2, latency.bucket[0]);
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_SECTOR_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_CHIP_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_wait_for_write_null (CuTest *test)
+static void spi_flash_test_get_write_latency_chip_erase (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint8_t read_status = 0;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
@@ -13653,47 +15142,35 @@ static void spi_flash_test_wait_for_write_null (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_wait_for_write (NULL, 100);
-	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
-
-	status = flash_master_mock_validate_and_release (&mock);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash);
-}
-
-static void spi_flash_test_wait_for_write_timeout (CuTest *test)
-{
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	struct flash_master_mock mock;
-	int status;
-	uint8_t wip_status = FLASH_STATUS_WIP;
-
-	TEST_START;
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
 
-	status = flash_master_mock_init (&mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash, &state, &mock.base);
+	status = spi_flash_chip_erase (&flash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_CHIP_ERASE, &latency);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, latency.polls);
+	CuAssertIntEquals (test, 1, latency.bucket[0]);
 
-	status = spi_flash_wait_for_write (&flash, 35);
-	CuAssertIntEquals (test, SPI_FLASH_WIP_TIMEOUT, status);
-	CuAssertTrue (test, ((mock.mock.call_count >= 3) && (mock.mock.call_count <= 5)));
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_BLOCK_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
 
 	spi_flash_is_write_in_progress (&flash);
 
@@ -13701,13 +15178,16 @@ static void spi_flash_test_wait_for_write_timeout (CuTest *test)
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_wait_for_write_immediate_timeout (CuTest *test)
+static void spi_flash_test_get_write_latency_erase_error (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
+	uint8_t read_status = 0;
 	uint8_t wip_status = FLASH_STATUS_WIP;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
@@ -13717,31 +15197,44 @@ static void spi_flash_test_wait_for_write_immediate_timeout (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, FLASH_MASTER_XFER_FAILED, &wip_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_wait_for_write (&flash, 0);
-	CuAssertIntEquals (test, SPI_FLASH_WIP_TIMEOUT, status);
+	status = spi_flash_sector_erase (&flash, 0x1000);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_SECTOR_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_wait_for_write_no_timeout (CuTest *test)
+static void spi_flash_test_get_write_latency_null (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = FLASH_STATUS_WIP;
-	uint8_t read_status = 0;
+	struct spi_flash_latency_histogram latency;
 
 	TEST_START;
 
@@ -13751,33 +15244,33 @@ static void spi_flash_test_wait_for_write_no_timeout (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_wait_for_write (&flash, -1);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_get_write_latency (NULL, SPI_FLASH_OP_PAGE_PROGRAM, &latency);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
 
-	status = flash_master_mock_validate_and_release (&mock);
-	CuAssertIntEquals (test, 0, status);
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_PAGE_PROGRAM, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = spi_flash_get_write_latency (&flash, NUM_SPI_FLASH_WRITE_OPERATIONS, &latency);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	spi_flash_is_write_in_progress (&flash);
 
+	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
-static void spi_flash_test_wait_for_write_error (CuTest *test)
+static void spi_flash_test_clear_write_latency (CuTest *test)
 {
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	struct flash_master_mock mock;
 	int status;
-	uint8_t wip_status = FLASH_STATUS_WIP;
+	uint8_t read_status = 0;
+	struct spi_flash_latency_histogram latency;
+	int i;
 
 	TEST_START;
 
@@ -13787,27 +15280,50 @@ static void spi_flash_test_wait_for_write_error (CuTest *test)
 	status = spi_flash_init (&flash, &state, &mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&mock, FLASH_MASTER_XFER_FAILED, &wip_status, 1,
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xc7));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
 		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_wait_for_write (&flash, 100);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = spi_flash_chip_erase (&flash);
+	CuAssertIntEquals (test, 0, status);
 
 	status = mock_validate (&mock.mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_clear_write_latency (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_write_latency (&flash, SPI_FLASH_OP_CHIP_ERASE, &latency);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, latency.polls);
+	for (i = 0; i < SPI_FLASH_LATENCY_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, latency.bucket[i]);
+	}
+
 	spi_flash_is_write_in_progress (&flash);
 
 	flash_master_mock_release (&mock);
 	spi_flash_release (&flash);
 }
 
+static void spi_flash_test_clear_write_latency_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = spi_flash_clear_write_latency (NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+}
+
 static void spi_flash_test_enable_quad_spi_no_quad_enable (CuTest *test)
 {
 	struct spi_flash_state state;
@@ -17533,6 +19049,7 @@ static void spi_flash_test_initialize_device_3byte_only (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -18230,6 +19747,7 @@ static void spi_flash_test_initialize_device_fast_read (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -20013,6 +21531,7 @@ static void spi_flash_test_initialize_device_state_3byte_only (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -20704,6 +22223,7 @@ static void spi_flash_test_initialize_device_state_fast_read (CuTest *test)
 
 	CuAssertPtrNotNull (test, flash.base.get_device_size);
 	CuAssertPtrNotNull (test, flash.base.read);
+	CuAssertPtrNotNull (test, flash.base.read_regions);
 	CuAssertPtrNotNull (test, flash.base.get_page_size);
 	CuAssertPtrNotNull (test, flash.base.minimum_write_per_page);
 	CuAssertPtrNotNull (test, flash.base.write);
@@ -27049,6 +28569,17 @@ TEST (spi_flash_test_read_error_in_progress);
 TEST (spi_flash_test_read_error_in_progress_flag_status_register);
 TEST (spi_flash_test_read_status_error);
 TEST (spi_flash_test_read_error);
+TEST (spi_flash_test_read_regions);
+TEST (spi_flash_test_read_regions_batch);
+TEST (spi_flash_test_read_regions_batch_multiple_batches);
+TEST (spi_flash_test_read_regions_empty_region);
+TEST (spi_flash_test_read_regions_null);
+TEST (spi_flash_test_read_regions_out_of_range);
+TEST (spi_flash_test_read_regions_too_long);
+TEST (spi_flash_test_read_regions_small_buffer);
+TEST (spi_flash_test_read_regions_error_in_progress);
+TEST (spi_flash_test_read_regions_error);
+TEST (spi_flash_test_read_regions_batch_error);
 TEST (spi_flash_test_write);
 TEST (spi_flash_test_write_across_page);
 TEST (spi_flash_test_write_multiple_pages);
@@ -27171,6 +28702,26 @@ TEST (spi_flash_test_wait_for_write_timeout);
 TEST (spi_flash_test_wait_for_write_immediate_timeout);
 TEST (spi_flash_test_wait_for_write_no_timeout);
 TEST (spi_flash_test_wait_for_write_error);
+TEST (spi_flash_test_write_state_tracking_read);
+TEST (spi_flash_test_write_state_tracking_read_write_in_progress);
+TEST (spi_flash_test_write_state_tracking_write);
+TEST (spi_flash_test_write_state_tracking_write_error);
+TEST (spi_flash_test_write_state_tracking_sector_erase);
+TEST (spi_flash_test_write_state_tracking_disable);
+TEST (spi_flash_test_enable_write_state_tracking_null);
+TEST (spi_flash_test_get_write_latency_no_operations);
+TEST (spi_flash_test_get_write_latency_page_program);
+TEST (spi_flash_test_get_write_latency_sector_erase);
+TEST (spi_flash_test_get_write_latency_sector_erase_typical_time);
+TEST (spi_flash_test_sector_erase_max_time_timeout);
+TEST (spi_flash_test_block_erase_max_time_timeout);
+TEST (spi_flash_test_chip_erase_max_time_timeout);
+TEST (spi_flash_test_get_write_latency_block_erase);
+TEST (spi_flash_test_get_write_latency_chip_erase);
+TEST (spi_flash_test_get_write_latency_erase_error);
+TEST (spi_flash_test_get_write_latency_null);
+TEST (spi_flash_test_clear_write_latency);
+TEST (spi_flash_test_clear_write_latency_null);
 TEST (spi_flash_test_enable_quad_spi_no_quad_enable);
 TEST (spi_flash_test_enable_quad_spi_no_quad_enable_hold_disable_flag_status_register);
 TEST (spi_flash_test_enable_quad_spi_no_quad_enable_hold_disable_volatile_write_enable);
@@ -17,6 +17,105 @@
 TEST_SUITE_LABEL ("host_fw_util");
 
 
+/**
+ * A hash engine for a verification worker.  Hashing is passed through to a real hash engine, but
+ * the worker can be configured to fail or to run a second worker while it is verifying an image.
+ * Running a second worker from inside the hash operation interleaves the workers the same way
+ * concurrent execution would, but in a deterministic order.
+ */
+struct host_fw_util_testing_worker_hash {
+	struct hash_engine base;						/**< The base hash engine. */
+	struct hash_engine *engine;						/**< The hash engine to pass requests to. */
+	int fail;										/**< Error to return when starting a hash. */
+	int started;									/**< Number of hashes started by the worker. */
+	struct host_fw_verify_work *work;				/**< Work for the nested worker. */
+	const struct host_fw_verify_engines *nested;	/**< Engines for the nested worker. */
+	int nested_status;								/**< Result of running the nested worker. */
+};
+
+/**
+ * Start a SHA-256 hash for the worker.  The nested worker runs during the first hash.
+ */
+static int host_fw_util_testing_worker_hash_start_sha256 (struct hash_engine *engine)
+{
+	struct host_fw_util_testing_worker_hash *hash =
+		(struct host_fw_util_testing_worker_hash*) engine;
+
+	if (hash->started++ == 0) {
+		if (hash->nested) {
+			hash->nested_status = host_fw_verify_work_run (hash->work, hash->nested);
+		}
+	}
+
+	if (hash->fail) {
+		return hash->fail;
+	}
+
+	return hash->engine->start_sha256 (hash->engine);
+}
+
+/**
+ * Pass a hash update to the real hash engine.
+ */
+static int host_fw_util_testing_worker_hash_update (struct hash_engine *engine,
+	const uint8_t *data, size_t length)
+{
+	struct host_fw_util_testing_worker_hash *hash =
+		(struct host_fw_util_testing_worker_hash*) engine;
+
+	return hash->engine->update (hash->engine, data, length);
+}
+
+/**
+ * Get the final hash from the real hash engine.
+ */
+static int host_fw_util_testing_worker_hash_finish (struct hash_engine *engine, uint8_t *digest,
+	size_t length)
+{
+	struct host_fw_util_testing_worker_hash *hash =
+		(struct host_fw_util_testing_worker_hash*) engine;
+
+	return hash->engine->finish (hash->engine, digest, length);
+}
+
+/**
+ * Cancel the hash in the real hash engine.
+ */
+static void host_fw_util_testing_worker_hash_cancel (struct hash_engine *engine)
+{
+	struct host_fw_util_testing_worker_hash *hash =
+		(struct host_fw_util_testing_worker_hash*) engine;
+
+	hash->engine->cancel (hash->engine);
+}
+
+/**
+ * Initialize a hash engine for a verification worker.
+ *
+ * @param hash The worker hash engine to initialize.
+ * @param engine The hash engine to pass requests to.
+ * @param fail Error to return when starting a hash or 0 to pass the request through.
+ * @param work Work that should be processed by a nested worker.  Null for no nested worker.
+ * @param nested Engines to use for the nested worker.
+ */
+static void host_fw_util_testing_init_worker_hash (struct host_fw_util_testing_worker_hash *hash,
+	struct hash_engine *engine, int fail, struct host_fw_verify_work *work,
+	const struct host_fw_verify_engines *nested)
+{
+	memset (hash, 0, sizeof (*hash));
+
+	hash->base.start_sha256 = host_fw_util_testing_worker_hash_start_sha256;
+	hash->base.update = host_fw_util_testing_worker_hash_update;
+	hash->base.finish = host_fw_util_testing_worker_hash_finish;
+	hash->base.cancel = host_fw_util_testing_worker_hash_cancel;
+
+	hash->engine = engine;
+	hash->fail = fail;
+	hash->work = work;
+	hash->nested = nested;
+}
+
+
 /*******************
  * Test cases
  *******************/
@@ -1410,19 +1509,10 @@ static void host_fw_verify_images_test_not_contiguous (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 1, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x20000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 2, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 3, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x40000, 0, -1, 1));
 
@@ -2173,19 +2263,10 @@ static void host_fw_verify_images_test_hashes_not_contiguous (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 1, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x20000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 2, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 3, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x40000, 0, -1, 1));
 
@@ -2827,19 +2908,10 @@ static void host_fw_verify_offset_images_test_not_contiguous (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 1, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 2, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 3, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x440000, 0, -1, 1));
 
@@ -3652,19 +3724,10 @@ static void host_fw_verify_offset_images_test_hashes_not_contiguous (CuTest *tes
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 1, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 2, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data + 3, strlen (data),
 		FLASH_EXP_READ_CMD (0x03, 0x440000, 0, -1, 1));
 
@@ -4844,14 +4907,8 @@ static void host_fw_full_flash_verification_test_multipart_image (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
 		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 1, 3,
 		FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, 2));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 3, 1,
 		FLASH_EXP_READ_CMD (0x03, 0xe00, 0, -1, 1));
 
@@ -5544,14 +5601,8 @@ static void host_fw_full_flash_verification_test_hashes_multipart_image (CuTest
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
 		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, 1));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 1, 3,
 		FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, 2));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1 + 3, 1,
 		FLASH_EXP_READ_CMD (0x03, 0xe00, 0, -1, 1));
 
@@ -8459,7 +8510,7 @@ static void host_fw_restore_flash_device_test_null (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
+static void host_fw_restore_flash_device_differences_test (CuTest *test)
 {
 	struct flash_region img_region;
 	struct pfm_image_signature sig;
@@ -8475,9 +8526,18 @@ static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
 	struct spi_flash flash2;
 	int status;
 	char *data = "Test";
+	uint8_t good[0x1000];
+	uint8_t bad[0x1000];
+	size_t rewritten;
 
 	TEST_START;
 
+	memset (good, 0xff, sizeof (good));
+	memcpy (good, data, strlen (data));
+
+	memcpy (bad, good, sizeof (bad));
+	bad[2] = 0x00;
+
 	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
@@ -8493,11 +8553,17 @@ static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
 	status = spi_flash_set_device_size (&flash1, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
+	status = spi_flash_set_device_size (&flash2, 0x3000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	status = flash_master_mock_expect_verify_flash (&flash_mock1, 0, (uint8_t*) data,
+		strlen (data));
+	status |= flash_master_mock_expect_verify_flash (&flash_mock2, 0, bad, sizeof (bad));
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock2, 0);
+	status |= flash_master_mock_expect_copy_flash (&flash_mock2, &flash_mock1, 0, 0,
+		(uint8_t*) data, strlen (data), 0);
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock2, 0x2000, 0x1000);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -8515,8 +8581,8 @@ static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
 	img_list.images_hash = NULL;
 	img_list.count = 1;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	rw_region.start_addr = 0x1000;
+	rw_region.length = 0x1000;
 
 	rw_prop.on_failure = PFM_RW_DO_NOTHING;
 
@@ -8524,8 +8590,10 @@ static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = host_fw_restore_flash_device_differences (&flash2, &flash1, &img_list, &rw_list,
+		&rewritten);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x1000, rewritten);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -8537,7 +8605,7 @@ static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
+static void host_fw_restore_flash_device_differences_test_no_differences (CuTest *test)
 {
 	struct flash_region img_region;
 	struct pfm_image_signature sig;
@@ -8553,9 +8621,14 @@ static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
 	struct spi_flash flash2;
 	int status;
 	char *data = "Test";
+	uint8_t good[0x1000];
+	size_t rewritten;
 
 	TEST_START;
 
+	memset (good, 0xff, sizeof (good));
+	memcpy (good, data, strlen (data));
+
 	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
@@ -8571,12 +8644,14 @@ static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
 	status = spi_flash_set_device_size (&flash1, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
+	status = spi_flash_set_device_size (&flash2, 0x3000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	status = flash_master_mock_expect_verify_flash (&flash_mock1, 0, (uint8_t*) data,
+		strlen (data));
+	status |= flash_master_mock_expect_verify_flash (&flash_mock2, 0, good, sizeof (good));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock2, 0x2000, 0x1000);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -8594,8 +8669,8 @@ static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
 	img_list.images_hash = NULL;
 	img_list.count = 1;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	rw_region.start_addr = 0x1000;
+	rw_region.length = 0x1000;
 
 	rw_prop.on_failure = PFM_RW_DO_NOTHING;
 
@@ -8603,8 +8678,10 @@ static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = host_fw_restore_flash_device_differences (&flash2, &flash1, &img_list, &rw_list,
+		&rewritten);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, rewritten);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -8616,7 +8693,7 @@ static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
+static void host_fw_restore_flash_device_differences_test_unused_region_not_blank (CuTest *test)
 {
 	struct flash_region img_region;
 	struct pfm_image_signature sig;
@@ -8632,9 +8709,18 @@ static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
 	struct spi_flash flash2;
 	int status;
 	char *data = "Test";
+	uint8_t good[0x1000];
+	uint8_t bad[0x1000];
+	size_t rewritten;
 
 	TEST_START;
 
+	memset (good, 0xff, sizeof (good));
+	memcpy (good, data, strlen (data));
+
+	memset (bad, 0xff, sizeof (bad));
+	bad[0x800] = 0x00;
+
 	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
@@ -8650,14 +8736,15 @@ static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
 	status = spi_flash_set_device_size (&flash1, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
+	status = spi_flash_set_device_size (&flash2, 0x3000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+	status = flash_master_mock_expect_verify_flash (&flash_mock1, 0, (uint8_t*) data,
+		strlen (data));
+	status |= flash_master_mock_expect_verify_flash (&flash_mock2, 0, good, sizeof (good));
 
-	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_verify_flash (&flash_mock2, 0x2000, bad, sizeof (bad));
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock2, 0x2000);
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -8675,8 +8762,8 @@ static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
 	img_list.images_hash = NULL;
 	img_list.count = 1;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	rw_region.start_addr = 0x1000;
+	rw_region.length = 0x1000;
 
 	rw_prop.on_failure = PFM_RW_DO_NOTHING;
 
@@ -8684,8 +8771,10 @@ static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = host_fw_restore_flash_device_differences (&flash2, &flash1, &img_list, &rw_list,
+		&rewritten);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x1000, rewritten);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -8697,10 +8786,10 @@ static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_restore_flash_device_test_hashes_copy_error (CuTest *test)
+static void host_fw_restore_flash_device_differences_test_null (CuTest *test)
 {
 	struct flash_region img_region;
-	struct pfm_image_hash img_hash;
+	struct pfm_image_signature sig;
 	struct pfm_image_list img_list;
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
@@ -8713,6 +8802,7 @@ static void host_fw_restore_flash_device_test_hashes_copy_error (CuTest *test)
 	struct spi_flash flash2;
 	int status;
 	char *data = "Test";
+	size_t rewritten;
 
 	TEST_START;
 
@@ -8731,33 +8821,25 @@ static void host_fw_restore_flash_device_test_hashes_copy_error (CuTest *test)
 	status = spi_flash_set_device_size (&flash1, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x30000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
-	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
-
-	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-
+	status = spi_flash_set_device_size (&flash2, 0x3000);
 	CuAssertIntEquals (test, 0, status);
 
 	img_region.start_addr = 0;
 	img_region.length = strlen (data);
 
-	img_hash.regions = &img_region;
-	img_hash.count = 1;
-	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
-	img_hash.hash_length = SHA256_HASH_LENGTH;
-	img_hash.hash_type = HASH_TYPE_SHA256;
-	img_hash.always_validate = 1;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	img_list.images_hash = &img_hash;
-	img_list.images_sig = NULL;
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
 	img_list.count = 1;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	rw_region.start_addr = 0x1000;
+	rw_region.length = 0x1000;
 
 	rw_prop.on_failure = PFM_RW_DO_NOTHING;
 
@@ -8765,8 +8847,23 @@ static void host_fw_restore_flash_device_test_hashes_copy_error (CuTest *test)
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	rewritten = 1;
+	status = host_fw_restore_flash_device_differences (NULL, &flash1, &img_list, &rw_list,
+		&rewritten);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, 0, rewritten);
+
+	status = host_fw_restore_flash_device_differences (&flash2, NULL, &img_list, &rw_list,
+		&rewritten);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_restore_flash_device_differences (&flash2, &flash1, NULL, &rw_list,
+		&rewritten);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_restore_flash_device_differences (&flash2, &flash1, &img_list, NULL,
+		&rewritten);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
@@ -8778,19 +8875,62 @@ static void host_fw_restore_flash_device_test_hashes_copy_error (CuTest *test)
 	spi_flash_release (&flash2);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test (CuTest *test)
+static void host_fw_restore_flash_device_test_erase_error (CuTest *test)
 {
-	struct spi_filter_interface_mock filter;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
 	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = spi_filter_interface_mock_init (&filter);
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
 
@@ -8800,79 +8940,157 @@ static void host_fw_config_spi_filter_read_write_regions_test (CuTest *test)
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
+	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
+	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
+	status = flash_master_mock_validate_and_release (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
-	CuAssertIntEquals (test, 0, status);
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test_multiple_regions (CuTest *test)
+static void host_fw_restore_flash_device_test_last_erase_error (CuTest *test)
 {
-	struct spi_filter_interface_mock filter;
-	struct flash_region rw_region[3];
-	struct pfm_read_write rw_prop[3];
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
 	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = spi_filter_interface_mock_init (&filter);
+	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = 0x10000;
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x20000;
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region[2].start_addr = 0x60000;
-	rw_region[2].length = 0x30000;
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list.regions = rw_region;
-	rw_list.properties = rw_prop;
-	rw_list.count = 3;
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
 
-	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
-		MOCK_ARG (3), MOCK_ARG (0x60000), MOCK_ARG (0x90000));
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
 
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
+	status = flash_master_mock_validate_and_release (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test_null (CuTest *test)
+static void host_fw_restore_flash_device_test_copy_error (CuTest *test)
 {
-	struct spi_filter_interface_mock filter;
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
 	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = spi_filter_interface_mock_init (&filter);
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+
+	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
 	CuAssertIntEquals (test, 0, status);
 
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
 
@@ -8882,62 +9100,136 @@ static void host_fw_config_spi_filter_read_write_regions_test_null (CuTest *test
 	rw_list.properties = &rw_prop;
 	rw_list.count = 1;
 
-	status = host_fw_config_spi_filter_read_write_regions (NULL, &rw_list);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
 
-	status = host_fw_config_spi_filter_read_write_regions (&filter.base, NULL);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
 
-	status = spi_filter_interface_mock_validate_and_release (&filter);
+	status = flash_master_mock_validate_and_release (&flash_mock2);
 	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test_filter_error (CuTest *test)
+static void host_fw_restore_flash_device_test_hashes_copy_error (CuTest *test)
 {
-	struct spi_filter_interface_mock filter;
-	struct flash_region rw_region[3];
-	struct pfm_read_write rw_prop[3];
+	struct flash_region img_region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
 	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = spi_filter_interface_mock_init (&filter);
+	status = flash_master_mock_init (&flash_mock1);
 	CuAssertIntEquals (test, 0, status);
 
-	rw_region[0].start_addr = 0x10000;
-	rw_region[0].length = 0x10000;
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region[1].start_addr = 0x30000;
-	rw_region[1].length = 0x20000;
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_region[2].start_addr = 0x60000;
-	rw_region[2].length = 0x30000;
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list.regions = rw_region;
-	rw_list.properties = rw_prop;
-	rw_list.count = 3;
+	status = spi_flash_set_device_size (&flash2, 0x30000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock2, 0);
+	status |= flash_master_mock_expect_erase_flash (&flash_mock2, 0x20000);
+
+	status |= flash_master_mock_expect_xfer (&flash_mock1, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	img_hash.regions = &img_region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	img_list.images_hash = &img_hash;
+	img_list.images_sig = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_restore_flash_device (&flash2, &flash1, &img_list, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_config_spi_filter_read_write_regions_test (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
 
 	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
 	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
 		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
-	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter,
-		SPI_FILTER_SET_RW_FAILED, MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
-	CuAssertIntEquals (test, SPI_FILTER_SET_RW_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
 	status = spi_filter_interface_mock_validate_and_release (&filter);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void host_fw_config_spi_filter_read_write_regions_test_clear_error (CuTest *test)
+static void host_fw_config_spi_filter_read_write_regions_test_multiple_regions (CuTest *test)
 {
 	struct spi_filter_interface_mock filter;
 	struct flash_region rw_region[3];
@@ -8967,39 +9259,163 @@ static void host_fw_config_spi_filter_read_write_regions_test_clear_error (CuTes
 	rw_list.properties = rw_prop;
 	rw_list.count = 3;
 
-	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter,
-		SPI_FILTER_CLEAR_RW_FAILED);
+	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (3), MOCK_ARG (0x60000), MOCK_ARG (0x90000));
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
-	CuAssertIntEquals (test, SPI_FILTER_CLEAR_RW_FAILED, status);
+	CuAssertIntEquals (test, 0, status);
 
 	status = spi_filter_interface_mock_validate_and_release (&filter);
 	CuAssertIntEquals (test, 0, status);
 }
 
-static void host_fw_are_images_different_test (CuTest *test)
+static void host_fw_config_spi_filter_read_write_regions_test_null (CuTest *test)
 {
-	struct flash_region region1;
-	struct pfm_image_signature sig1;
-	struct pfm_image_list list1;
-	struct flash_region region2;
-	struct pfm_image_signature sig2;
-	struct pfm_image_list list2;
-	bool status;
+	struct spi_filter_interface_mock filter;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	int status;
 
 	TEST_START;
 
-	region1.start_addr = 0x10000;
-	region1.length = 0x100;
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
 
-	sig1.regions = &region1;
-	sig1.count = 1;
-	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig1.sig_length = RSA_ENCRYPT_LEN;
-	sig1.always_validate = 1;
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_config_spi_filter_read_write_regions (NULL, &rw_list);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void host_fw_config_spi_filter_read_write_regions_test_filter_error (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	struct flash_region rw_region[3];
+	struct pfm_read_write rw_prop[3];
+	struct pfm_read_write_regions rw_list;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = 0x10000;
+
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 0x20000;
+
+	rw_region[2].start_addr = 0x60000;
+	rw_region[2].length = 0x30000;
+
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = rw_region;
+	rw_list.properties = rw_prop;
+	rw_list.count = 3;
+
+	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter, 0);
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter, 0,
+		MOCK_ARG (1), MOCK_ARG (0x10000), MOCK_ARG (0x20000));
+	status |= mock_expect (&filter.mock, filter.base.set_filter_rw_region, &filter,
+		SPI_FILTER_SET_RW_FAILED, MOCK_ARG (2), MOCK_ARG (0x30000), MOCK_ARG (0x50000));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
+	CuAssertIntEquals (test, SPI_FILTER_SET_RW_FAILED, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void host_fw_config_spi_filter_read_write_regions_test_clear_error (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	struct flash_region rw_region[3];
+	struct pfm_read_write rw_prop[3];
+	struct pfm_read_write_regions rw_list;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region[0].start_addr = 0x10000;
+	rw_region[0].length = 0x10000;
+
+	rw_region[1].start_addr = 0x30000;
+	rw_region[1].length = 0x20000;
+
+	rw_region[2].start_addr = 0x60000;
+	rw_region[2].length = 0x30000;
+
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = rw_region;
+	rw_list.properties = rw_prop;
+	rw_list.count = 3;
+
+	status = mock_expect (&filter.mock, filter.base.clear_filter_rw_regions, &filter,
+		SPI_FILTER_CLEAR_RW_FAILED);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_config_spi_filter_read_write_regions (&filter.base, &rw_list);
+	CuAssertIntEquals (test, SPI_FILTER_CLEAR_RW_FAILED, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void host_fw_are_images_different_test (CuTest *test)
+{
+	struct flash_region region1;
+	struct pfm_image_signature sig1;
+	struct pfm_image_list list1;
+	struct flash_region region2;
+	struct pfm_image_signature sig2;
+	struct pfm_image_list list2;
+	bool status;
+
+	TEST_START;
+
+	region1.start_addr = 0x10000;
+	region1.length = 0x100;
+
+	sig1.regions = &region1;
+	sig1.count = 1;
+	memcpy (&sig1.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig1.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig1.sig_length = RSA_ENCRYPT_LEN;
+	sig1.always_validate = 1;
 
 	list1.images_sig = &sig1;
 	list1.images_hash = NULL;
@@ -12072,153 +12488,728 @@ static void host_fw_restore_read_write_data_test_erase_flash_error (CuTest *test
 	rw_region.start_addr = 0x10000;
 	rw_region.length = 0x10000;
 
-	rw_prop.on_failure = PFM_RW_ERASE;
+	rw_prop.on_failure = PFM_RW_ERASE;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_read_write_data_test_restore_flash_error (CuTest *test)
+{
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region.start_addr = 0x10000;
+	rw_region.length = 0x10000;
+
+	rw_prop.on_failure = PFM_RW_RESTORE;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_restore_read_write_data_test_multiple_regions_error (CuTest *test)
+{
+	struct flash_region rw_region[4];
+	struct pfm_read_write rw_prop[4];
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock1;
+	struct spi_flash_state state1;
+	struct spi_flash flash1;
+	struct flash_master_mock flash_mock2;
+	struct spi_flash_state state2;
+	struct spi_flash flash2;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	rw_region[0].start_addr = 0;
+	rw_region[0].length = 0x10000;
+	rw_region[1].start_addr = 0x40000;
+	rw_region[1].length = 0x30000;
+	rw_region[2].start_addr = 0x100000;
+	rw_region[2].length = 0x10000;
+	rw_region[3].start_addr = 0x500000;
+	rw_region[3].length = 0x100000;
+
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_ERASE;
+	rw_prop[2].on_failure = PFM_RW_RESTORE;
+	rw_prop[3].on_failure = PFM_RW_RESERVED;
+
+	rw_list.regions = rw_region;
+	rw_list.properties = rw_prop;
+	rw_list.count = 4;
+
+	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock2);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1);
+	spi_flash_release (&flash2);
+}
+
+static void host_fw_verify_images_multiple_fw_test (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_test_invalid (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_test_multiple (CuTest *test)
+{
+	struct flash_region region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list list[3];
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x20000, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, strlen (data3)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
+
+	sig[0].regions = &region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	sig[2].regions = &region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
+
+	list[0].images_sig = &sig[0];
+	list[0].images_hash = NULL;
+	list[0].count = 1;
+
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	list[2].images_sig = &sig[2];
+	list[2].images_hash = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_images_multiple_fw (&flash, list, 3, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_test_hashes (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_test_hashes_invalid (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_test_hashes_multiple (CuTest *test)
+{
+	struct flash_region region[3];
+	struct pfm_image_hash img_hash[3];
+	struct pfm_image_list list[3];
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x20000, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, strlen (data3)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
+
+	img_hash[0].regions = &region[0];
+	img_hash[0].count = 1;
+	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[0].hash_length = SHA256_HASH_LENGTH;
+	img_hash[0].hash_type = HASH_TYPE_SHA256;
+	img_hash[0].always_validate = 1;
+
+	img_hash[1].regions = &region[1];
+	img_hash[1].count = 1;
+	memcpy (img_hash[1].hash, SHA384_TEST2_HASH, SHA384_HASH_LENGTH);
+	img_hash[1].hash_length = SHA384_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA384;
+	img_hash[1].always_validate = 1;
+
+	img_hash[2].regions = &region[2];
+	img_hash[2].count = 1;
+	memcpy (img_hash[2].hash, SHA512_NOPE_HASH, SHA512_HASH_LENGTH);
+	img_hash[2].hash_length = SHA512_HASH_LENGTH;
+	img_hash[2].hash_type = HASH_TYPE_SHA512;
+	img_hash[2].always_validate = 1;
+
+	list[0].images_hash = &img_hash[0];
+	list[0].images_sig = NULL;
+	list[0].count = 1;
 
-	rw_list.regions = &rw_region;
-	rw_list.properties = &rw_prop;
-	rw_list.count = 1;
+	list[1].images_hash = &img_hash[1];
+	list[1].images_sig = NULL;
+	list[1].count = 1;
 
-	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	list[2].images_hash = &img_hash[2];
+	list[2].images_sig = NULL;
+	list[2].count = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_images_multiple_fw (&flash, list, 3, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_restore_read_write_data_test_restore_flash_error (CuTest *test)
+static void host_fw_verify_images_multiple_fw_test_null (CuTest *test)
 {
-	struct flash_region rw_region;
-	struct pfm_read_write rw_prop;
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash_state state1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash_state state2;
-	struct spi_flash flash2;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_init (&flash_mock2);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
-		FLASH_EXP_READ_STATUS_REG);
-	CuAssertIntEquals (test, 0, status);
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_region.start_addr = 0x10000;
-	rw_region.length = 0x10000;
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
 
-	rw_prop.on_failure = PFM_RW_RESTORE;
+	status = host_fw_verify_images_multiple_fw (NULL, &list, 1, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	rw_list.regions = &rw_region;
-	rw_list.properties = &rw_prop;
-	rw_list.count = 1;
+	status = host_fw_verify_images_multiple_fw (&flash, NULL, 1, &hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, NULL, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
+	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_restore_read_write_data_test_multiple_regions_error (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test (CuTest *test)
 {
-	struct flash_region rw_region[4];
-	struct pfm_read_write rw_prop[4];
-	struct pfm_read_write_regions rw_list;
-	struct flash_master_mock flash_mock1;
-	struct spi_flash_state state1;
-	struct spi_flash flash1;
-	struct flash_master_mock flash_mock2;
-	struct spi_flash_state state2;
-	struct spi_flash flash2;
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
 	int status;
+	char *data = "Test";
 
 	TEST_START;
 
-	status = flash_master_mock_init (&flash_mock1);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock2);
+	status = HASH_TESTING_ENGINE_INIT (&hash);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash1, &state1, &flash_mock1.base);
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_init (&flash2, &state2, &flash_mock2.base);
+	status = flash_master_mock_init (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash1, 0x1000000);
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = spi_flash_set_device_size (&flash2, 0x1000000);
+	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_xfer (&flash_mock2, FLASH_MASTER_XFER_FAILED,
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	CuAssertIntEquals (test, 0, status);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
 
-	rw_region[0].start_addr = 0;
-	rw_region[0].length = 0x10000;
-	rw_region[1].start_addr = 0x40000;
-	rw_region[1].length = 0x30000;
-	rw_region[2].start_addr = 0x100000;
-	rw_region[2].length = 0x10000;
-	rw_region[3].start_addr = 0x500000;
-	rw_region[3].length = 0x100000;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_ERASE;
-	rw_prop[2].on_failure = PFM_RW_RESTORE;
-	rw_prop[3].on_failure = PFM_RW_RESERVED;
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
 
-	rw_list.regions = rw_region;
-	rw_list.properties = rw_prop;
-	rw_list.count = 4;
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	status = host_fw_restore_read_write_data (&flash2, &flash1, &rw_list);
-	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
 
-	status = flash_master_mock_validate_and_release (&flash_mock1);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_validate_and_release (&flash_mock2);
+	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash1);
-	spi_flash_release (&flash2);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_multiple_fw_test (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test_no_offset (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
@@ -12269,7 +13260,7 @@ static void host_fw_verify_images_multiple_fw_test (CuTest *test)
 	list.images_hash = NULL;
 	list.count = 1;
 
-	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -12280,7 +13271,7 @@ static void host_fw_verify_images_multiple_fw_test (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_multiple_fw_test_invalid (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test_invalid (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
@@ -12313,7 +13304,7 @@ static void host_fw_verify_images_multiple_fw_test_invalid (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -12331,7 +13322,8 @@ static void host_fw_verify_images_multiple_fw_test_invalid (CuTest *test)
 	list.images_hash = NULL;
 	list.count = 1;
 
-	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -12342,7 +13334,7 @@ static void host_fw_verify_images_multiple_fw_test_invalid (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_multiple_fw_test_multiple (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test)
 {
 	struct flash_region region[3];
 	struct pfm_image_signature sig[3];
@@ -12377,17 +13369,17 @@ static void host_fw_verify_images_multiple_fw_test_multiple (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data1)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x20000, 0, -1, strlen (data2)));
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, strlen (data3)));
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -12423,15 +13415,79 @@ static void host_fw_verify_images_multiple_fw_test_multiple (CuTest *test)
 	list[0].images_hash = NULL;
 	list[0].count = 1;
 
-	list[1].images_sig = &sig[1];
-	list[1].images_hash = NULL;
-	list[1].count = 1;
+	list[1].images_sig = &sig[1];
+	list[1].images_hash = NULL;
+	list[1].count = 1;
+
+	list[2].images_sig = &sig[2];
+	list[2].images_hash = NULL;
+	list[2].count = 1;
+
+	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
+		&rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_offset_images_multiple_fw_test_hashes (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
 
-	list[2].images_sig = &sig[2];
-	list[2].images_hash = NULL;
-	list[2].count = 1;
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
 
-	status = host_fw_verify_images_multiple_fw (&flash, list, 3, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -12442,7 +13498,7 @@ static void host_fw_verify_images_multiple_fw_test_multiple (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_multiple_fw_test_hashes (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_hash img_hash;
@@ -12493,7 +13549,7 @@ static void host_fw_verify_images_multiple_fw_test_hashes (CuTest *test)
 	list.images_sig = NULL;
 	list.count = 1;
 
-	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0, &hash.base, &rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -12504,7 +13560,7 @@ static void host_fw_verify_images_multiple_fw_test_hashes (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_multiple_fw_test_hashes_invalid (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test_hashes_invalid (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_hash img_hash;
@@ -12537,7 +13593,7 @@ static void host_fw_verify_images_multiple_fw_test_hashes_invalid (CuTest *test)
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -12555,7 +13611,8 @@ static void host_fw_verify_images_multiple_fw_test_hashes_invalid (CuTest *test)
 	list.images_sig = NULL;
 	list.count = 1;
 
-	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -12566,7 +13623,7 @@ static void host_fw_verify_images_multiple_fw_test_hashes_invalid (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_multiple_fw_test_hashes_multiple (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTest *test)
 {
 	struct flash_region region[3];
 	struct pfm_image_hash img_hash[3];
@@ -12601,17 +13658,17 @@ static void host_fw_verify_images_multiple_fw_test_hashes_multiple (CuTest *test
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data1)));
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x20000, 0, -1, strlen (data2)));
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x30000, 0, -1, strlen (data3)));
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -12655,7 +13712,8 @@ static void host_fw_verify_images_multiple_fw_test_hashes_multiple (CuTest *test
 	list[2].images_sig = NULL;
 	list[2].count = 1;
 
-	status = host_fw_verify_images_multiple_fw (&flash, list, 3, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -12666,7 +13724,7 @@ static void host_fw_verify_images_multiple_fw_test_hashes_multiple (CuTest *test
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_images_multiple_fw_test_null (CuTest *test)
+static void host_fw_verify_offset_images_multiple_fw_test_null (CuTest *test)
 {
 	struct flash_region region;
 	struct pfm_image_signature sig;
@@ -12710,16 +13768,20 @@ static void host_fw_verify_images_multiple_fw_test_null (CuTest *test)
 	list.images_hash = NULL;
 	list.count = 1;
 
-	status = host_fw_verify_images_multiple_fw (NULL, &list, 1, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (NULL, &list, 1, 0x400000, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_images_multiple_fw (&flash, NULL, 1, &hash.base, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, NULL, 1, 0x400000, &hash.base,
+		&rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, NULL, &rsa.base);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, NULL,
+		&rsa.base);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_images_multiple_fw (&flash, &list, 1, &hash.base, NULL);
+	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
+		NULL);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
@@ -12730,18 +13792,22 @@ static void host_fw_verify_images_multiple_fw_test_null (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test (CuTest *test)
+static void host_fw_verify_work_test (CuTest *test)
 {
-	struct flash_region region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list list;
+	struct flash_region region[3];
+	struct pfm_image_hash img_hash[3];
+	struct pfm_image_list list[2];
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
+	struct host_fw_verify_engines engines;
+	struct host_fw_verify_work work;
 	int status;
-	char *data = "Test";
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
@@ -12762,111 +13828,85 @@ static void host_fw_verify_offset_images_multiple_fw_test (CuTest *test)
 
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
-
-	CuAssertIntEquals (test, 0, status);
-
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
-
-	sig.regions = &region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
-
-	list.images_sig = &sig;
-	list.images_hash = NULL;
-	list.count = 1;
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
 
-	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
-	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
-}
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
 
-static void host_fw_verify_offset_images_multiple_fw_test_no_offset (CuTest *test)
-{
-	struct flash_region region;
-	struct pfm_image_signature sig;
-	struct pfm_image_list list;
-	struct flash_master_mock flash_mock;
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
-	int status;
-	char *data = "Test";
+	img_hash[0].regions = &region[0];
+	img_hash[0].count = 1;
+	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[0].hash_length = SHA256_HASH_LENGTH;
+	img_hash[0].hash_type = HASH_TYPE_SHA256;
+	img_hash[0].always_validate = 1;
 
-	TEST_START;
+	img_hash[1].regions = &region[1];
+	img_hash[1].count = 1;
+	memcpy (img_hash[1].hash, SHA384_BAD_HASH, SHA384_HASH_LENGTH);
+	img_hash[1].hash_length = SHA384_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA384;
+	img_hash[1].always_validate = 0;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
+	img_hash[2].regions = &region[2];
+	img_hash[2].count = 1;
+	memcpy (img_hash[2].hash, SHA512_NOPE_HASH, SHA512_HASH_LENGTH);
+	img_hash[2].hash_length = SHA512_HASH_LENGTH;
+	img_hash[2].hash_type = HASH_TYPE_SHA512;
+	img_hash[2].always_validate = 1;
 
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
+	list[0].images_hash = &img_hash[0];
+	list[0].images_sig = NULL;
+	list[0].count = 2;
 
-	status = flash_master_mock_init (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
+	list[1].images_hash = &img_hash[2];
+	list[1].images_sig = NULL;
+	list[1].count = 1;
 
-	status = spi_flash_init (&flash, &state, &flash_mock.base);
-	CuAssertIntEquals (test, 0, status);
+	engines.hash = &hash.base;
+	engines.rsa = &rsa.base;
+	engines.pipeline = NULL;
 
-	status = spi_flash_set_device_size (&flash, 0x1000000);
+	status = host_fw_verify_work_init (&work, &flash, list, 2, 0x400000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
-
+	status = host_fw_verify_work_run (&work, &engines);
 	CuAssertIntEquals (test, 0, status);
 
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
-
-	sig.regions = &region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
-
-	list.images_sig = &sig;
-	list.images_hash = NULL;
-	list.count = 1;
-
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0, &hash.base, &rsa.base);
+	status = host_fw_verify_work_get_status (&work);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_verify_work_release (&work);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_invalid (CuTest *test)
+static void host_fw_verify_work_test_no_images (CuTest *test)
 {
-	struct flash_region region;
-	struct pfm_image_signature sig;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
+	struct host_fw_verify_engines engines;
+	struct host_fw_verify_work work;
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
@@ -12885,40 +13925,33 @@ static void host_fw_verify_offset_images_multiple_fw_test_invalid (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
-
-	CuAssertIntEquals (test, 0, status);
+	list.images_sig = NULL;
+	list.images_hash = NULL;
+	list.count = 0;
 
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
+	engines.hash = &hash.base;
+	engines.rsa = &rsa.base;
+	engines.pipeline = NULL;
 
-	sig.regions = &region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	status = host_fw_verify_work_init (&work, &flash, &list, 1, 0);
+	CuAssertIntEquals (test, 0, status);
 
-	list.images_sig = &sig;
-	list.images_hash = NULL;
-	list.count = 1;
+	status = host_fw_verify_work_run (&work, &engines);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	status = host_fw_verify_work_get_status (&work);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_verify_work_release (&work);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test)
+static void host_fw_verify_work_test_invalid (CuTest *test)
 {
 	struct flash_region region[3];
 	struct pfm_image_signature sig[3];
@@ -12928,6 +13961,8 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
+	struct host_fw_verify_engines engines;
+	struct host_fw_verify_work work;
 	int status;
 	char *data1 = "Test";
 	char *data2 = "Test2";
@@ -12953,17 +13988,12 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data1)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
+		FLASH_EXP_READ_CMD (0x03, 0x20000, 0, -1, strlen (data2)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -12984,7 +14014,7 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 	sig[1].regions = &region[1];
 	sig[1].count = 1;
 	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	memcpy (&sig[1].signature, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN);
 	sig[1].sig_length = RSA_ENCRYPT_LEN;
 	sig[1].always_validate = 1;
 
@@ -13007,93 +14037,47 @@ static void host_fw_verify_offset_images_multiple_fw_test_multiple (CuTest *test
 	list[2].images_hash = NULL;
 	list[2].count = 1;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_validate_and_release (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
-
-	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
-	RSA_TESTING_ENGINE_RELEASE (&rsa);
-}
-
-static void host_fw_verify_offset_images_multiple_fw_test_hashes (CuTest *test)
-{
-	struct flash_region region;
-	struct pfm_image_hash img_hash;
-	struct pfm_image_list list;
-	struct flash_master_mock flash_mock;
-	struct spi_flash_state state;
-	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
-	RSA_TESTING_ENGINE rsa;
-	int status;
-	char *data = "Test";
-
-	TEST_START;
-
-	status = HASH_TESTING_ENGINE_INIT (&hash);
-	CuAssertIntEquals (test, 0, status);
-
-	status = RSA_TESTING_ENGINE_INIT (&rsa);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_init (&flash_mock);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_init (&flash, &state, &flash_mock.base);
-	CuAssertIntEquals (test, 0, status);
-
-	status = spi_flash_set_device_size (&flash, 0x1000000);
-	CuAssertIntEquals (test, 0, status);
-
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
-
-	CuAssertIntEquals (test, 0, status);
+	engines.hash = &hash.base;
+	engines.rsa = &rsa.base;
+	engines.pipeline = NULL;
 
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
+	status = host_fw_verify_work_init (&work, &flash, list, 3, 0);
+	CuAssertIntEquals (test, 0, status);
 
-	img_hash.regions = &region;
-	img_hash.count = 1;
-	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
-	img_hash.hash_length = SHA256_HASH_LENGTH;
-	img_hash.hash_type = HASH_TYPE_SHA256;
-	img_hash.always_validate = 1;
+	status = host_fw_verify_work_run (&work, &engines);
+	CuAssertIntEquals (test, 0, status);
 
-	list.images_hash = &img_hash;
-	list.images_sig = NULL;
-	list.count = 1;
+	status = host_fw_verify_work_get_status (&work);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
+	/* No more images are verified after a failure. */
+	status = host_fw_verify_work_run (&work, &engines);
 	CuAssertIntEquals (test, 0, status);
 
+	status = host_fw_verify_work_get_status (&work);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_verify_work_release (&work);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTest *test)
+static void host_fw_verify_work_test_null (CuTest *test)
 {
-	struct flash_region region;
-	struct pfm_image_hash img_hash;
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
+	struct host_fw_verify_engines engines;
+	struct host_fw_verify_engines bad_engines;
+	struct host_fw_verify_work work;
 	int status;
-	char *data = "Test";
 
 	TEST_START;
 
@@ -13112,54 +14096,84 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset (CuTe
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+	list.images_sig = NULL;
+	list.images_hash = NULL;
+	list.count = 0;
 
-	CuAssertIntEquals (test, 0, status);
+	engines.hash = &hash.base;
+	engines.rsa = &rsa.base;
+	engines.pipeline = NULL;
 
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
+	status = host_fw_verify_work_init (NULL, &flash, &list, 1, 0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	img_hash.regions = &region;
-	img_hash.count = 1;
-	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
-	img_hash.hash_length = SHA256_HASH_LENGTH;
-	img_hash.hash_type = HASH_TYPE_SHA256;
-	img_hash.always_validate = 1;
+	status = host_fw_verify_work_init (&work, NULL, &list, 1, 0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	list.images_hash = &img_hash;
-	list.images_sig = NULL;
-	list.count = 1;
+	status = host_fw_verify_work_init (&work, &flash, NULL, 1, 0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0, &hash.base, &rsa.base);
+	status = host_fw_verify_work_init (&work, &flash, &list, 1, 0);
 	CuAssertIntEquals (test, 0, status);
 
+	status = host_fw_verify_work_run (NULL, &engines);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_work_run (&work, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	bad_engines.hash = NULL;
+	bad_engines.rsa = &rsa.base;
+	bad_engines.pipeline = NULL;
+	status = host_fw_verify_work_run (&work, &bad_engines);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	bad_engines.hash = &hash.base;
+	bad_engines.rsa = NULL;
+	bad_engines.pipeline = NULL;
+	status = host_fw_verify_work_run (&work, &bad_engines);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_work_get_status (NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_verify_work_release (&work);
+	host_fw_verify_work_release (NULL);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_hashes_invalid (CuTest *test)
+static void host_fw_verify_work_test_multiple_workers (CuTest *test)
 {
-	struct flash_region region;
-	struct pfm_image_hash img_hash;
+	struct flash_region region[4];
+	struct pfm_image_hash img_hash[4];
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
+	HASH_TESTING_ENGINE hash[3];
 	RSA_TESTING_ENGINE rsa;
+	struct host_fw_util_testing_worker_hash worker_hash[3];
+	struct host_fw_verify_engines engines[3];
+	struct host_fw_verify_work work;
 	int status;
-	char *data = "Test";
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash[2]);
 	CuAssertIntEquals (test, 0, status);
 
 	status = RSA_TESTING_ENGINE_INIT (&rsa);
@@ -13176,47 +14190,125 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_invalid (CuTest
 
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data)));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x440000, 0, -1, strlen (data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	CuAssertIntEquals (test, 0, status);
 
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
+	region[3].start_addr = 0x40000;
+	region[3].length = strlen (data1);
 
-	img_hash.regions = &region;
-	img_hash.count = 1;
-	memcpy (img_hash.hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
-	img_hash.hash_length = SHA256_HASH_LENGTH;
-	img_hash.hash_type = HASH_TYPE_SHA256;
-	img_hash.always_validate = 1;
+	img_hash[0].regions = &region[0];
+	img_hash[0].count = 1;
+	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[0].hash_length = SHA256_HASH_LENGTH;
+	img_hash[0].hash_type = HASH_TYPE_SHA256;
+	img_hash[0].always_validate = 1;
 
-	list.images_hash = &img_hash;
+	img_hash[1].regions = &region[1];
+	img_hash[1].count = 1;
+	memcpy (img_hash[1].hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+	img_hash[1].hash_length = SHA256_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA256;
+	img_hash[1].always_validate = 1;
+
+	img_hash[2].regions = &region[2];
+	img_hash[2].count = 1;
+	memcpy (img_hash[2].hash, SHA256_NOPE_HASH, SHA256_HASH_LENGTH);
+	img_hash[2].hash_length = SHA256_HASH_LENGTH;
+	img_hash[2].hash_type = HASH_TYPE_SHA256;
+	img_hash[2].always_validate = 1;
+
+	img_hash[3].regions = &region[3];
+	img_hash[3].count = 1;
+	memcpy (img_hash[3].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[3].hash_length = SHA256_HASH_LENGTH;
+	img_hash[3].hash_type = HASH_TYPE_SHA256;
+	img_hash[3].always_validate = 1;
+
+	list.images_hash = img_hash;
 	list.images_sig = NULL;
-	list.count = 1;
+	list.count = 4;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
+	status = host_fw_verify_work_init (&work, &flash, &list, 1, 0x400000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Each worker starts the next one while it is verifying its first image.  The first worker
+	 * verifies image 0, the second worker verifies image 1, and the last worker verifies the
+	 * remaining images. */
+	host_fw_util_testing_init_worker_hash (&worker_hash[2], &hash[2].base, 0, NULL, NULL);
+	engines[2].hash = &worker_hash[2].base;
+	engines[2].rsa = &rsa.base;
+	engines[2].pipeline = NULL;
+
+	host_fw_util_testing_init_worker_hash (&worker_hash[1], &hash[1].base, 0, &work, &engines[2]);
+	engines[1].hash = &worker_hash[1].base;
+	engines[1].rsa = &rsa.base;
+	engines[1].pipeline = NULL;
+
+	host_fw_util_testing_init_worker_hash (&worker_hash[0], &hash[0].base, 0, &work, &engines[1]);
+	engines[0].hash = &worker_hash[0].base;
+	engines[0].rsa = &rsa.base;
+	engines[0].pipeline = NULL;
+
+	status = host_fw_verify_work_run (&work, &engines[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, worker_hash[0].nested_status);
+	CuAssertIntEquals (test, 0, worker_hash[1].nested_status);
+
+	CuAssertIntEquals (test, 1, worker_hash[0].started);
+	CuAssertIntEquals (test, 1, worker_hash[1].started);
+	CuAssertIntEquals (test, 2, worker_hash[2].started);
+
+	status = host_fw_verify_work_get_status (&work);
+	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_verify_work_release (&work);
 	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	HASH_TESTING_ENGINE_RELEASE (&hash[0]);
+	HASH_TESTING_ENGINE_RELEASE (&hash[1]);
+	HASH_TESTING_ENGINE_RELEASE (&hash[2]);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTest *test)
+static void host_fw_verify_work_test_multiple_workers_error (CuTest *test)
 {
-	struct flash_region region[3];
-	struct pfm_image_hash img_hash[3];
-	struct pfm_image_list list[3];
+	struct flash_region region[4];
+	struct pfm_image_hash img_hash[4];
+	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
+	HASH_TESTING_ENGINE hash[3];
 	RSA_TESTING_ENGINE rsa;
+	struct host_fw_util_testing_worker_hash worker_hash[3];
+	struct host_fw_verify_engines engines[3];
+	struct host_fw_verify_work work;
 	int status;
 	char *data1 = "Test";
 	char *data2 = "Test2";
@@ -13224,7 +14316,13 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTes
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash[2]);
 	CuAssertIntEquals (test, 0, status);
 
 	status = RSA_TESTING_ENGINE_INIT (&rsa);
@@ -13241,18 +14339,13 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTes
 
 	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
-
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
 		FLASH_EXP_READ_CMD (0x03, 0x420000, 0, -1, strlen (data2)));
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x430000, 0, -1, strlen (data3)));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -13262,6 +14355,8 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTes
 	region[1].length = strlen (data2);
 	region[2].start_addr = 0x30000;
 	region[2].length = strlen (data3);
+	region[3].start_addr = 0x40000;
+	region[3].length = strlen (data1);
 
 	img_hash[0].regions = &region[0];
 	img_hash[0].count = 1;
@@ -13272,58 +14367,98 @@ static void host_fw_verify_offset_images_multiple_fw_test_hashes_multiple (CuTes
 
 	img_hash[1].regions = &region[1];
 	img_hash[1].count = 1;
-	memcpy (img_hash[1].hash, SHA384_TEST2_HASH, SHA384_HASH_LENGTH);
-	img_hash[1].hash_length = SHA384_HASH_LENGTH;
-	img_hash[1].hash_type = HASH_TYPE_SHA384;
+	memcpy (img_hash[1].hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+	img_hash[1].hash_length = SHA256_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA256;
 	img_hash[1].always_validate = 1;
 
 	img_hash[2].regions = &region[2];
 	img_hash[2].count = 1;
-	memcpy (img_hash[2].hash, SHA512_NOPE_HASH, SHA512_HASH_LENGTH);
-	img_hash[2].hash_length = SHA512_HASH_LENGTH;
-	img_hash[2].hash_type = HASH_TYPE_SHA512;
+	memcpy (img_hash[2].hash, SHA256_NOPE_HASH, SHA256_HASH_LENGTH);
+	img_hash[2].hash_length = SHA256_HASH_LENGTH;
+	img_hash[2].hash_type = HASH_TYPE_SHA256;
 	img_hash[2].always_validate = 1;
 
-	list[0].images_hash = &img_hash[0];
-	list[0].images_sig = NULL;
-	list[0].count = 1;
+	img_hash[3].regions = &region[3];
+	img_hash[3].count = 1;
+	memcpy (img_hash[3].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[3].hash_length = SHA256_HASH_LENGTH;
+	img_hash[3].hash_type = HASH_TYPE_SHA256;
+	img_hash[3].always_validate = 1;
 
-	list[1].images_hash = &img_hash[1];
-	list[1].images_sig = NULL;
-	list[1].count = 1;
+	list.images_hash = img_hash;
+	list.images_sig = NULL;
+	list.count = 4;
 
-	list[2].images_hash = &img_hash[2];
-	list[2].images_sig = NULL;
-	list[2].count = 1;
+	status = host_fw_verify_work_init (&work, &flash, &list, 1, 0x400000);
+	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, list, 3, 0x400000, &hash.base,
-		&rsa.base);
+	/* The last worker fails on image 2.  Image 3 is never verified, but the images already assigned
+	 * to the other workers are completed. */
+	host_fw_util_testing_init_worker_hash (&worker_hash[2], &hash[2].base,
+		HASH_ENGINE_START_SHA256_FAILED, NULL, NULL);
+	engines[2].hash = &worker_hash[2].base;
+	engines[2].rsa = &rsa.base;
+	engines[2].pipeline = NULL;
+
+	host_fw_util_testing_init_worker_hash (&worker_hash[1], &hash[1].base, 0, &work, &engines[2]);
+	engines[1].hash = &worker_hash[1].base;
+	engines[1].rsa = &rsa.base;
+	engines[1].pipeline = NULL;
+
+	host_fw_util_testing_init_worker_hash (&worker_hash[0], &hash[0].base, 0, &work, &engines[1]);
+	engines[0].hash = &worker_hash[0].base;
+	engines[0].rsa = &rsa.base;
+	engines[0].pipeline = NULL;
+
+	status = host_fw_verify_work_run (&work, &engines[0]);
 	CuAssertIntEquals (test, 0, status);
 
+	CuAssertIntEquals (test, 0, worker_hash[0].nested_status);
+	CuAssertIntEquals (test, 0, worker_hash[1].nested_status);
+
+	CuAssertIntEquals (test, 1, worker_hash[0].started);
+	CuAssertIntEquals (test, 1, worker_hash[1].started);
+	CuAssertIntEquals (test, 1, worker_hash[2].started);
+
+	status = host_fw_verify_work_get_status (&work);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_verify_work_release (&work);
 	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	HASH_TESTING_ENGINE_RELEASE (&hash[0]);
+	HASH_TESTING_ENGINE_RELEASE (&hash[1]);
+	HASH_TESTING_ENGINE_RELEASE (&hash[2]);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_verify_offset_images_multiple_fw_test_null (CuTest *test)
+static void host_fw_verify_work_test_multiple_workers_first_error_reported (CuTest *test)
 {
-	struct flash_region region;
-	struct pfm_image_signature sig;
+	struct flash_region region[3];
+	struct pfm_image_hash img_hash[3];
 	struct pfm_image_list list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
-	HASH_TESTING_ENGINE hash;
+	HASH_TESTING_ENGINE hash[2];
 	RSA_TESTING_ENGINE rsa;
+	struct host_fw_util_testing_worker_hash worker_hash[2];
+	struct host_fw_verify_engines engines[2];
+	struct host_fw_verify_work work;
 	int status;
-	char *data = "Test";
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
 
 	TEST_START;
 
-	status = HASH_TESTING_ENGINE_INIT (&hash);
+	status = HASH_TESTING_ENGINE_INIT (&hash[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&hash[1]);
 	CuAssertIntEquals (test, 0, status);
 
 	status = RSA_TESTING_ENGINE_INIT (&rsa);
@@ -13338,41 +14473,79 @@ static void host_fw_verify_offset_images_multiple_fw_test_null (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000000);
 	CuAssertIntEquals (test, 0, status);
 
-	region.start_addr = 0x10000;
-	region.length = strlen (data);
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x410000, 0, -1, strlen (data1)));
 
-	sig.regions = &region;
-	sig.count = 1;
-	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig.sig_length = RSA_ENCRYPT_LEN;
-	sig.always_validate = 1;
+	CuAssertIntEquals (test, 0, status);
 
-	list.images_sig = &sig;
-	list.images_hash = NULL;
-	list.count = 1;
+	region[0].start_addr = 0x10000;
+	region[0].length = strlen (data1);
+	region[1].start_addr = 0x20000;
+	region[1].length = strlen (data2);
+	region[2].start_addr = 0x30000;
+	region[2].length = strlen (data3);
 
-	status = host_fw_verify_offset_images_multiple_fw (NULL, &list, 1, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	img_hash[0].regions = &region[0];
+	img_hash[0].count = 1;
+	memcpy (img_hash[0].hash, SHA256_NOPE_HASH, SHA256_HASH_LENGTH);
+	img_hash[0].hash_length = SHA256_HASH_LENGTH;
+	img_hash[0].hash_type = HASH_TYPE_SHA256;
+	img_hash[0].always_validate = 1;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, NULL, 1, 0x400000, &hash.base,
-		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	img_hash[1].regions = &region[1];
+	img_hash[1].count = 1;
+	memcpy (img_hash[1].hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+	img_hash[1].hash_length = SHA256_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA256;
+	img_hash[1].always_validate = 1;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, NULL,
-		&rsa.base);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	img_hash[2].regions = &region[2];
+	img_hash[2].count = 1;
+	memcpy (img_hash[2].hash, SHA256_NOPE_HASH, SHA256_HASH_LENGTH);
+	img_hash[2].hash_length = SHA256_HASH_LENGTH;
+	img_hash[2].hash_type = HASH_TYPE_SHA256;
+	img_hash[2].always_validate = 1;
 
-	status = host_fw_verify_offset_images_multiple_fw (&flash, &list, 1, 0x400000, &hash.base,
-		NULL);
-	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+	list.images_hash = img_hash;
+	list.images_sig = NULL;
+	list.count = 3;
+
+	status = host_fw_verify_work_init (&work, &flash, &list, 1, 0x400000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The second worker fails on image 1 before the first worker fails on image 0.  The failure for
+	 * image 0 is reported, which is the same result as serial verification. */
+	host_fw_util_testing_init_worker_hash (&worker_hash[1], &hash[1].base,
+		HASH_ENGINE_START_SHA256_FAILED, NULL, NULL);
+	engines[1].hash = &worker_hash[1].base;
+	engines[1].rsa = &rsa.base;
+	engines[1].pipeline = NULL;
+
+	host_fw_util_testing_init_worker_hash (&worker_hash[0], &hash[0].base, 0, &work, &engines[1]);
+	engines[0].hash = &worker_hash[0].base;
+	engines[0].rsa = &rsa.base;
+	engines[0].pipeline = NULL;
+
+	status = host_fw_verify_work_run (&work, &engines[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, worker_hash[0].nested_status);
+
+	CuAssertIntEquals (test, 1, worker_hash[0].started);
+	CuAssertIntEquals (test, 1, worker_hash[1].started);
+
+	status = host_fw_verify_work_get_status (&work);
+	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	host_fw_verify_work_release (&work);
 	spi_flash_release (&flash);
-	HASH_TESTING_ENGINE_RELEASE (&hash);
+	HASH_TESTING_ENGINE_RELEASE (&hash[0]);
+	HASH_TESTING_ENGINE_RELEASE (&hash[1]);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
@@ -15483,6 +16656,10 @@ TEST (host_fw_restore_flash_device_test_hashes);
 TEST (host_fw_restore_flash_device_test_hashes_multipart_image);
 TEST (host_fw_restore_flash_device_test_hashes_multiple_images);
 TEST (host_fw_restore_flash_device_test_null);
+TEST (host_fw_restore_flash_device_differences_test);
+TEST (host_fw_restore_flash_device_differences_test_no_differences);
+TEST (host_fw_restore_flash_device_differences_test_unused_region_not_blank);
+TEST (host_fw_restore_flash_device_differences_test_null);
 TEST (host_fw_restore_flash_device_test_erase_error);
 TEST (host_fw_restore_flash_device_test_last_erase_error);
 TEST (host_fw_restore_flash_device_test_copy_error);
@@ -15559,6 +16736,13 @@ TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset);
 TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_invalid);
 TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_multiple);
 TEST (host_fw_verify_offset_images_multiple_fw_test_null);
+TEST (host_fw_verify_work_test);
+TEST (host_fw_verify_work_test_no_images);
+TEST (host_fw_verify_work_test_invalid);
+TEST (host_fw_verify_work_test_null);
+TEST (host_fw_verify_work_test_multiple_workers);
+TEST (host_fw_verify_work_test_multiple_workers_error);
+TEST (host_fw_verify_work_test_multiple_workers_first_error_reported);
 TEST (host_fw_full_flash_verification_multiple_fw_test);
 TEST (host_fw_full_flash_verification_multiple_fw_test_multiple);
 TEST (host_fw_full_flash_verification_multiple_fw_test_hashes);
@@ -0,0 +1,472 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "logging/debug_log_compact_format.h"
+
+
+TEST_SUITE_LABEL ("debug_log_compact_format");
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void debug_log_compact_format_test_encode_varint (CuTest *test)
+{
+	uint8_t data[10];
+	uint8_t one_byte[] = {0x7f};
+	uint8_t two_byte[] = {0x80, 0x01};
+	uint8_t max_32[] = {0xff, 0xff, 0xff, 0xff, 0x0f};
+	uint8_t max_64[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01};
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_encode_varint (0, data, sizeof (data));
+	CuAssertIntEquals (test, 1, status);
+	CuAssertIntEquals (test, 0, data[0]);
+
+	status = debug_log_compact_encode_varint (0x7f, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (one_byte), status);
+
+	status = testing_validate_array (one_byte, data, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_compact_encode_varint (0x80, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (two_byte), status);
+
+	status = testing_validate_array (two_byte, data, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_compact_encode_varint (0xffffffff, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (max_32), status);
+
+	status = testing_validate_array (max_32, data, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_compact_encode_varint (0xffffffffffffffffULL, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (max_64), status);
+
+	status = testing_validate_array (max_64, data, status);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void debug_log_compact_format_test_encode_varint_small_buffer (CuTest *test)
+{
+	uint8_t data[10];
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_encode_varint (0x80, data, 1);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+
+	status = debug_log_compact_encode_varint (0, data, 0);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+}
+
+static void debug_log_compact_format_test_decode_varint (CuTest *test)
+{
+	uint8_t two_byte[] = {0x80, 0x01, 0x55};
+	uint8_t max_32[] = {0xff, 0xff, 0xff, 0xff, 0x0f};
+	uint8_t max_64[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01};
+	uint64_t value;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_decode_varint (two_byte, sizeof (two_byte), &value);
+	CuAssertIntEquals (test, 2, status);
+	CuAssertTrue (test, (value == 0x80));
+
+	status = debug_log_compact_decode_varint (max_32, sizeof (max_32), &value);
+	CuAssertIntEquals (test, sizeof (max_32), status);
+	CuAssertTrue (test, (value == 0xffffffff));
+
+	status = debug_log_compact_decode_varint (max_64, sizeof (max_64), &value);
+	CuAssertIntEquals (test, sizeof (max_64), status);
+	CuAssertTrue (test, (value == 0xffffffffffffffffULL));
+}
+
+static void debug_log_compact_format_test_decode_varint_malformed (CuTest *test)
+{
+	uint8_t truncated[] = {0x80, 0x81};
+	uint8_t too_long[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01};
+	uint64_t value;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_decode_varint (truncated, sizeof (truncated), &value);
+	CuAssertIntEquals (test, LOGGING_MALFORMED_ENTRY, status);
+
+	status = debug_log_compact_decode_varint (too_long, sizeof (too_long), &value);
+	CuAssertIntEquals (test, LOGGING_MALFORMED_ENTRY, status);
+
+	status = debug_log_compact_decode_varint (truncated, 0, &value);
+	CuAssertIntEquals (test, LOGGING_MALFORMED_ENTRY, status);
+}
+
+static void debug_log_compact_format_test_encode_record (CuTest *test)
+{
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 0x1234,
+		.time = 110
+	};
+	struct debug_log_entry_info prev;
+	uint8_t expected[] = {0x01, 0x02, 0x03, 0x04, 0xb4, 0x24, 0x0a};
+	uint8_t data[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	TEST_START;
+
+	memset (&prev, 0, sizeof (prev));
+	prev.time = 100;
+
+	status = debug_log_compact_encode_record (&entry, &prev, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (expected), status);
+
+	status = testing_validate_array (expected, data, status);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void debug_log_compact_format_test_encode_record_same_component (CuTest *test)
+{
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 2,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 0x80,
+		.arg2 = 0,
+		.time = 100
+	};
+	struct debug_log_entry_info prev;
+	uint8_t expected[] = {0x06, 0x03, 0x80, 0x01, 0x00, 0x00};
+	uint8_t data[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	TEST_START;
+
+	memset (&prev, 0, sizeof (prev));
+	prev.component = 2;
+	prev.time = 100;
+
+	status = debug_log_compact_encode_record (&entry, &prev, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (expected), status);
+
+	status = testing_validate_array (expected, data, status);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void debug_log_compact_format_test_encode_record_time_before_previous (CuTest *test)
+{
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 0,
+		.component = 1,
+		.msg_index = 2,
+		.arg1 = 3,
+		.arg2 = 4,
+		.time = 50
+	};
+	struct debug_log_entry_info prev;
+	uint8_t expected[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x00};
+	uint8_t data[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	TEST_START;
+
+	memset (&prev, 0, sizeof (prev));
+	prev.time = 100;
+
+	status = debug_log_compact_encode_record (&entry, &prev, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (expected), status);
+
+	status = testing_validate_array (expected, data, status);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void debug_log_compact_format_test_encode_record_max_length (CuTest *test)
+{
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 0xffffffff,
+		.arg2 = 0xffffffff,
+		.time = 0xffffffffffffffffULL
+	};
+	struct debug_log_entry_info prev;
+	uint8_t data[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	TEST_START;
+
+	memset (&prev, 0, sizeof (prev));
+
+	status = debug_log_compact_encode_record (&entry, &prev, data, sizeof (data));
+	CuAssertIntEquals (test, DEBUG_LOG_COMPACT_MAX_RECORD_LEN, status);
+}
+
+static void debug_log_compact_format_test_encode_record_small_buffer (CuTest *test)
+{
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 0x1234,
+		.time = 110
+	};
+	struct debug_log_entry_info prev;
+	uint8_t data[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	TEST_START;
+
+	memset (&prev, 0, sizeof (prev));
+	prev.time = 100;
+
+	status = debug_log_compact_encode_record (&entry, &prev, data, 6);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+
+	status = debug_log_compact_encode_record (&entry, &prev, data, 2);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+
+	status = debug_log_compact_encode_record (&entry, &prev, data, 1);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+}
+
+static void debug_log_compact_format_test_encode_record_invalid_arg (CuTest *test)
+{
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5,
+		.time = 110
+	};
+	struct debug_log_entry_info prev;
+	uint8_t data[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	TEST_START;
+
+	memset (&prev, 0, sizeof (prev));
+
+	status = debug_log_compact_encode_record (NULL, &prev, data, sizeof (data));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_encode_record (&entry, NULL, data, sizeof (data));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_encode_record (&entry, &prev, NULL, sizeof (data));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	entry.severity = DEBUG_LOG_COMPACT_TAG_REPEAT;
+	status = debug_log_compact_encode_record (&entry, &prev, data, sizeof (data));
+	CuAssertIntEquals (test, LOGGING_UNSUPPORTED_SEVERITY, status);
+}
+
+static void debug_log_compact_format_test_encode_repeat (CuTest *test)
+{
+	uint8_t expected[] = {0x03, 0x05, 0xac, 0x02};
+	uint8_t data[DEBUG_LOG_COMPACT_MAX_RECORD_LEN];
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_encode_repeat (5, 300, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (expected), status);
+
+	status = testing_validate_array (expected, data, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_compact_encode_repeat (5, 300, data, 3);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+
+	status = debug_log_compact_encode_repeat (5, 300, data, 0);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+
+	status = debug_log_compact_encode_repeat (5, 300, NULL, sizeof (data));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void debug_log_compact_format_test_decode_header (CuTest *test)
+{
+	struct debug_log_compact_header header = {
+		.format = DEBUG_LOG_ENTRY_FORMAT_COMPACT,
+		.time = 0x123456789
+	};
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	memset (&entry, 0x55, sizeof (entry));
+
+	status = debug_log_compact_decode_header ((uint8_t*) &header, sizeof (header), &entry);
+	CuAssertIntEquals (test, sizeof (header), status);
+	CuAssertIntEquals (test, DEBUG_LOG_ENTRY_FORMAT, entry.format);
+	CuAssertIntEquals (test, 0, entry.severity);
+	CuAssertIntEquals (test, 0, entry.component);
+	CuAssertIntEquals (test, 0, entry.msg_index);
+	CuAssertIntEquals (test, 0, entry.arg1);
+	CuAssertIntEquals (test, 0, entry.arg2);
+	CuAssertTrue (test, (entry.time == 0x123456789));
+}
+
+static void debug_log_compact_format_test_decode_header_malformed (CuTest *test)
+{
+	struct debug_log_compact_header header = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.time = 0x123456789
+	};
+	struct debug_log_entry_info entry;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_decode_header ((uint8_t*) &header, sizeof (header), &entry);
+	CuAssertIntEquals (test, LOGGING_MALFORMED_ENTRY, status);
+
+	header.format = DEBUG_LOG_ENTRY_FORMAT_COMPACT;
+	status = debug_log_compact_decode_header ((uint8_t*) &header, sizeof (header) - 1, &entry);
+	CuAssertIntEquals (test, LOGGING_MALFORMED_ENTRY, status);
+
+	status = debug_log_compact_decode_header (NULL, sizeof (header), &entry);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_decode_header ((uint8_t*) &header, sizeof (header), NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void debug_log_compact_format_test_decode_record (CuTest *test)
+{
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0xb4, 0x24, 0x0a, 0x06, 0x07, 0x00, 0x01, 0x02};
+	struct debug_log_entry_info entry;
+	uint32_t repeat;
+	int status;
+
+	TEST_START;
+
+	memset (&entry, 0, sizeof (entry));
+	entry.format = DEBUG_LOG_ENTRY_FORMAT;
+	entry.time = 100;
+
+	status = debug_log_compact_decode_record (data, sizeof (data), &entry, &repeat);
+	CuAssertIntEquals (test, 7, status);
+	CuAssertIntEquals (test, DEBUG_LOG_ENTRY_FORMAT, entry.format);
+	CuAssertIntEquals (test, 1, entry.severity);
+	CuAssertIntEquals (test, 2, entry.component);
+	CuAssertIntEquals (test, 3, entry.msg_index);
+	CuAssertIntEquals (test, 4, entry.arg1);
+	CuAssertIntEquals (test, 0x1234, entry.arg2);
+	CuAssertTrue (test, (entry.time == 110));
+	CuAssertIntEquals (test, 0, repeat);
+
+	status = debug_log_compact_decode_record (&data[7], sizeof (data) - 7, &entry, &repeat);
+	CuAssertIntEquals (test, 5, status);
+	CuAssertIntEquals (test, 2, entry.severity);
+	CuAssertIntEquals (test, 2, entry.component);
+	CuAssertIntEquals (test, 7, entry.msg_index);
+	CuAssertIntEquals (test, 0, entry.arg1);
+	CuAssertIntEquals (test, 1, entry.arg2);
+	CuAssertTrue (test, (entry.time == 112));
+	CuAssertIntEquals (test, 0, repeat);
+}
+
+static void debug_log_compact_format_test_decode_record_repeat (CuTest *test)
+{
+	uint8_t data[] = {0x03, 0x05, 0xac, 0x02};
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5,
+		.time = 100
+	};
+	uint32_t repeat;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_decode_record (data, sizeof (data), &entry, &repeat);
+	CuAssertIntEquals (test, sizeof (data), status);
+	CuAssertIntEquals (test, 1, entry.severity);
+	CuAssertIntEquals (test, 2, entry.component);
+	CuAssertIntEquals (test, 3, entry.msg_index);
+	CuAssertIntEquals (test, 4, entry.arg1);
+	CuAssertIntEquals (test, 5, entry.arg2);
+	CuAssertTrue (test, (entry.time == 400));
+	CuAssertIntEquals (test, 5, repeat);
+}
+
+static void debug_log_compact_format_test_decode_record_malformed (CuTest *test)
+{
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0xb4, 0x24, 0x0a};
+	uint8_t repeat_data[] = {0x03, 0x85};
+	struct debug_log_entry_info entry;
+	uint32_t repeat;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (&entry, 0, sizeof (entry));
+
+	for (i = 0; i < sizeof (data); i++) {
+		status = debug_log_compact_decode_record (data, i, &entry, &repeat);
+		CuAssertIntEquals (test, LOGGING_MALFORMED_ENTRY, status);
+	}
+
+	status = debug_log_compact_decode_record (repeat_data, sizeof (repeat_data), &entry, &repeat);
+	CuAssertIntEquals (test, LOGGING_MALFORMED_ENTRY, status);
+
+	status = debug_log_compact_decode_record (NULL, sizeof (data), &entry, &repeat);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_decode_record (data, sizeof (data), NULL, &repeat);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_decode_record (data, sizeof (data), &entry, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+
+TEST_SUITE_START (debug_log_compact_format);
+
+TEST (debug_log_compact_format_test_encode_varint);
+TEST (debug_log_compact_format_test_encode_varint_small_buffer);
+TEST (debug_log_compact_format_test_decode_varint);
+TEST (debug_log_compact_format_test_decode_varint_malformed);
+TEST (debug_log_compact_format_test_encode_record);
+TEST (debug_log_compact_format_test_encode_record_same_component);
+TEST (debug_log_compact_format_test_encode_record_time_before_previous);
+TEST (debug_log_compact_format_test_encode_record_max_length);
+TEST (debug_log_compact_format_test_encode_record_small_buffer);
+TEST (debug_log_compact_format_test_encode_record_invalid_arg);
+TEST (debug_log_compact_format_test_encode_repeat);
+TEST (debug_log_compact_format_test_decode_header);
+TEST (debug_log_compact_format_test_decode_header_malformed);
+TEST (debug_log_compact_format_test_decode_record);
+TEST (debug_log_compact_format_test_decode_record_repeat);
+TEST (debug_log_compact_format_test_decode_record_malformed);
+
+TEST_SUITE_END;
@@ -0,0 +1,1379 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "common/array_size.h"
+#include "logging/debug_log_compact.h"
+#include "logging/debug_log_compact_static.h"
+#include "logging/debug_log_compact_format.h"
+#include "testing/mock/logging/logging_mock.h"
+
+
+TEST_SUITE_LABEL ("debug_log_compact");
+
+
+/**
+ * Size of the batch buffer used for testing.
+ */
+#define	DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE	256
+
+/**
+ * Smallest batch buffer supported by the log.
+ */
+#define	DEBUG_LOG_COMPACT_TESTING_MIN_BATCH		\
+	(sizeof (struct debug_log_compact_header) + DEBUG_LOG_COMPACT_MAX_RECORD_LEN)
+
+
+/**
+ * Dependencies for testing the compact debug log.
+ */
+struct debug_log_compact_testing {
+	struct logging_mock log;						/**< Mock for the target log. */
+	uint8_t batch[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];	/**< Buffer for batched entries. */
+	struct debug_log_compact_state state;			/**< Variable context for the log. */
+	struct debug_log_compact test;					/**< The log under test. */
+};
+
+
+/**
+ * Initialize the dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param log Testing dependencies to initialize.
+ */
+static void debug_log_compact_testing_init_dependencies (CuTest *test,
+	struct debug_log_compact_testing *log)
+{
+	int status;
+
+	status = logging_mock_init (&log->log);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a compact debug log for testing.
+ *
+ * @param test The testing framework.
+ * @param log Testing components to initialize.
+ * @param batch_size Size of the batch buffer to use.
+ */
+static void debug_log_compact_testing_init (CuTest *test, struct debug_log_compact_testing *log,
+	size_t batch_size)
+{
+	int status;
+
+	debug_log_compact_testing_init_dependencies (test, log);
+
+	status = debug_log_compact_init (&log->test, &log->state, &log->log.base, log->batch,
+		batch_size);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param log Testing components to release.
+ */
+static void debug_log_compact_testing_release (CuTest *test, struct debug_log_compact_testing *log)
+{
+	int status;
+
+	status = logging_mock_validate_and_release (&log->log);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_release (&log->test);
+}
+
+/**
+ * Add a debug log entry to the log under test.
+ *
+ * @param test The testing framework.
+ * @param log The log to update.
+ * @param severity Severity of the entry.
+ * @param component Component for the entry.
+ * @param msg_index Message identifier for the entry.
+ * @param arg1 First entry argument.
+ * @param arg2 Second entry argument.
+ * @param time Timestamp for the entry.
+ */
+static void debug_log_compact_testing_add_entry (CuTest *test, struct debug_log_compact *log,
+	uint8_t severity, uint8_t component, uint8_t msg_index, uint32_t arg1, uint32_t arg2,
+	uint64_t time)
+{
+	struct debug_log_entry_info entry;
+	int status;
+
+	entry.format = DEBUG_LOG_ENTRY_FORMAT;
+	entry.severity = severity;
+	entry.component = component;
+	entry.msg_index = msg_index;
+	entry.arg1 = arg1;
+	entry.arg2 = arg2;
+	entry.time = time;
+
+	status = log->base.create_entry (&log->base, (uint8_t*) &entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Build the expected data for a batch of encoded entries.
+ *
+ * @param data Output for the batch data.
+ * @param time Base time for the batch.
+ * @param records The encoded records in the batch.
+ * @param length Length of the encoded records.
+ *
+ * @return Total length of the batch data.
+ */
+static size_t debug_log_compact_testing_build_batch (uint8_t *data, uint64_t time,
+	const uint8_t *records, size_t length)
+{
+	struct debug_log_compact_header header;
+
+	header.format = DEBUG_LOG_ENTRY_FORMAT_COMPACT;
+	header.time = time;
+
+	memcpy (data, &header, sizeof (header));
+	memcpy (&data[sizeof (header)], records, length);
+
+	return sizeof (header) + length;
+}
+
+/**
+ * Build the expected log data for a batch that is reported as an entry in the log.
+ *
+ * @param data Output for the entry data.
+ * @param entry_id ID expected for the batch entry.
+ * @param batch The batch data.
+ * @param length Length of the batch data.
+ *
+ * @return Total length of the entry data.
+ */
+static size_t debug_log_compact_testing_build_batch_entry (uint8_t *data, uint32_t entry_id,
+	const uint8_t *batch, size_t length)
+{
+	struct logging_entry_header header;
+
+	header.log_magic = LOGGING_MAGIC_START;
+	header.length = sizeof (header) + length;
+	header.entry_id = entry_id;
+
+	memcpy (data, &header, sizeof (header));
+	memcpy (&data[sizeof (header)], batch, length);
+
+	return sizeof (header) + length;
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void debug_log_compact_test_init (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init_dependencies (test, &log);
+
+	status = debug_log_compact_init (&log.test, &log.state, &log.log.base, log.batch,
+		sizeof (log.batch));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, log.test.base.create_entry);
+#ifndef LOGGING_DISABLE_FLUSH
+	CuAssertPtrNotNull (test, log.test.base.flush);
+#endif
+	CuAssertPtrNotNull (test, log.test.base.clear);
+	CuAssertPtrNotNull (test, log.test.base.get_size);
+	CuAssertPtrNotNull (test, log.test.base.read_contents);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_init_minimum_batch (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init_dependencies (test, &log);
+
+	status = debug_log_compact_init (&log.test, &log.state, &log.log.base, log.batch,
+		DEBUG_LOG_COMPACT_TESTING_MIN_BATCH);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_init_null (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init_dependencies (test, &log);
+
+	status = debug_log_compact_init (NULL, &log.state, &log.log.base, log.batch,
+		sizeof (log.batch));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_init (&log.test, NULL, &log.log.base, log.batch,
+		sizeof (log.batch));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_init (&log.test, &log.state, NULL, log.batch, sizeof (log.batch));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_init (&log.test, &log.state, &log.log.base, NULL,
+		sizeof (log.batch));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_mock_validate_and_release (&log.log);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void debug_log_compact_test_init_small_batch (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init_dependencies (test, &log);
+
+	status = debug_log_compact_init (&log.test, &log.state, &log.log.base, log.batch,
+		DEBUG_LOG_COMPACT_TESTING_MIN_BATCH - 1);
+	CuAssertIntEquals (test, LOGGING_INSUFFICIENT_STORAGE, status);
+
+	status = logging_mock_validate_and_release (&log.log);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void debug_log_compact_test_static_init (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	struct debug_log_compact test_static = debug_log_compact_static_init (&log.state,
+		&log.log.base, log.batch, sizeof (log.batch));
+	int status;
+
+	TEST_START;
+
+	CuAssertPtrNotNull (test, test_static.base.create_entry);
+#ifndef LOGGING_DISABLE_FLUSH
+	CuAssertPtrNotNull (test, test_static.base.flush);
+#endif
+	CuAssertPtrNotNull (test, test_static.base.clear);
+	CuAssertPtrNotNull (test, test_static.base.get_size);
+	CuAssertPtrNotNull (test, test_static.base.read_contents);
+
+	debug_log_compact_testing_init_dependencies (test, &log);
+
+	status = debug_log_compact_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_mock_validate_and_release (&log.log);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_release (&test_static);
+}
+
+static void debug_log_compact_test_static_init_null (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	struct debug_log_compact null_state = debug_log_compact_static_init (NULL, &log.log.base,
+		log.batch, sizeof (log.batch));
+	struct debug_log_compact null_log = debug_log_compact_static_init (&log.state, NULL,
+		log.batch, sizeof (log.batch));
+	struct debug_log_compact null_batch = debug_log_compact_static_init (&log.state,
+		&log.log.base, NULL, sizeof (log.batch));
+	struct debug_log_compact small_batch = debug_log_compact_static_init (&log.state,
+		&log.log.base, log.batch, DEBUG_LOG_COMPACT_TESTING_MIN_BATCH - 1);
+	int status;
+
+	TEST_START;
+
+	status = debug_log_compact_init_state (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_init_state (&null_state);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_init_state (&null_log);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_init_state (&null_batch);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_compact_init_state (&small_batch);
+	CuAssertIntEquals (test, LOGGING_INSUFFICIENT_STORAGE, status);
+}
+
+static void debug_log_compact_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	debug_log_compact_release (NULL);
+}
+
+static void debug_log_compact_test_create_entry (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x02, 0x03, 0x04, 0xb4, 0x24, 0x00};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 100, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	/* Entries are held in the batch until it is saved. */
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 0x1234, 100);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_multiple (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x00,
+		0x06, 0x07, 0x80, 0x01, 0x00, 0x0a,
+		0x00, 0x10, 0x01, 0x00, 0x00, 0xe8, 0x07
+	};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 500, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 500);
+	debug_log_compact_testing_add_entry (test, &log.test, 2, 2, 7, 0x80, 0, 510);
+	debug_log_compact_testing_add_entry (test, &log.test, 0, 0x10, 1, 0, 0, 1510);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_repeated (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x00,
+		0x03, 0x02, 0x1e,
+		0x05, 0x03, 0x04, 0x06, 0x0a
+	};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 100, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 110);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 130);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 6, 140);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_repeated_many (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x00,
+		0x03, 0xc7, 0x01, 0xc7, 0x01
+	};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+	int i;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 0, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	for (i = 0; i < 200; i++) {
+		debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, i);
+	}
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_batch_full (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records1[] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x00,
+		0x05, 0x03, 0x04, 0x06, 0x01,
+		0x05, 0x03, 0x04, 0x07, 0x01,
+		0x05, 0x03, 0x04, 0x08, 0x01
+	};
+	uint8_t records2[] = {0x01, 0x02, 0x03, 0x04, 0x09, 0x00};
+	uint8_t expected1[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t expected2[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length1;
+	size_t length2;
+	int status;
+
+	TEST_START;
+
+	length1 = debug_log_compact_testing_build_batch (expected1, 100, records1, sizeof (records1));
+	length2 = debug_log_compact_testing_build_batch (expected2, 104, records2, sizeof (records2));
+
+	debug_log_compact_testing_init (test, &log, DEBUG_LOG_COMPACT_TESTING_MIN_BATCH);
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 6, 101);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 7, 102);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 8, 103);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The next entry doesn't fit, so the current batch gets saved. */
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected1, length1), MOCK_ARG (length1));
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 9, 104);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected2, length2), MOCK_ARG (length2));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_batch_full_repeat (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records1[] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x00,
+		0x05, 0x03, 0x80, 0x01, 0x80, 0x01, 0x01,
+		0x05, 0x03, 0x81, 0x01, 0x80, 0x01, 0x01,
+		0x03, 0x01, 0x7f
+	};
+	uint8_t records2[] = {0x01, 0x02, 0x03, 0x81, 0x01, 0x80, 0x01, 0x00};
+	uint8_t expected1[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t expected2[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length1;
+	size_t length2;
+	int status;
+
+	TEST_START;
+
+	length1 = debug_log_compact_testing_build_batch (expected1, 100, records1, sizeof (records1));
+	length2 = debug_log_compact_testing_build_batch (expected2, 231, records2, sizeof (records2));
+
+	debug_log_compact_testing_init (test, &log, DEBUG_LOG_COMPACT_TESTING_MIN_BATCH);
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 0x80, 0x80, 101);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 0x81, 0x80, 102);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 0x81, 0x80, 229);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The updated repeat record needs more space, so the current batch gets saved. */
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected1, length1), MOCK_ARG (length1));
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 0x81, 0x80, 231);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected2, length2), MOCK_ARG (length2));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_save_error (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 9,
+		.time = 104
+	};
+	uint8_t records[] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x00,
+		0x05, 0x03, 0x04, 0x06, 0x01,
+		0x05, 0x03, 0x04, 0x07, 0x01,
+		0x05, 0x03, 0x04, 0x08, 0x01
+	};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 100, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, DEBUG_LOG_COMPACT_TESTING_MIN_BATCH);
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 6, 101);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 7, 102);
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 8, 103);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log,
+		LOGGING_CREATE_ENTRY_FAILED, MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.create_entry (&log.test.base, (uint8_t*) &entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_CREATE_ENTRY_FAILED, status);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The batch is kept so it can be saved later. */
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_not_debug_entry (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x00};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t other[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 100, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	/* Batched entries are saved first to keep the entries in order. */
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (other, sizeof (other)), MOCK_ARG (sizeof (other)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.create_entry (&log.test.base, other, sizeof (other));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* There are no batched entries to save. */
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (other, sizeof (other)), MOCK_ARG (sizeof (other)));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.create_entry (&log.test.base, other, sizeof (other));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_unknown_format (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT + 10,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5,
+		.time = 100
+	};
+	struct debug_log_entry_info bad_severity = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = DEBUG_LOG_COMPACT_TAG_REPEAT,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5,
+		.time = 100
+	};
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (&entry, sizeof (entry)), MOCK_ARG (sizeof (entry)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.create_entry (&log.test.base, (uint8_t*) &entry, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (&bad_severity, sizeof (bad_severity)),
+		MOCK_ARG (sizeof (bad_severity)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.create_entry (&log.test.base, (uint8_t*) &bad_severity,
+		sizeof (bad_severity));
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_history_size (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int count = 0;
+	uint64_t time = 1000;
+	int i;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	/* A mix of entries with small arguments and some with full size arguments. */
+	for (i = 0; i < 8; i++) {
+		debug_log_compact_testing_add_entry (test, &log.test, DEBUG_LOG_SEVERITY_INFO,
+			DEBUG_LOG_COMPONENT_CMD_INTERFACE, 1, i, 0, time += 3);
+		debug_log_compact_testing_add_entry (test, &log.test, DEBUG_LOG_SEVERITY_ERROR,
+			DEBUG_LOG_COMPONENT_MCTP, 4, 0x7f000000 + i, 0x10, time += 20);
+		debug_log_compact_testing_add_entry (test, &log.test, DEBUG_LOG_SEVERITY_INFO,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 0, 0, time += 1);
+		debug_log_compact_testing_add_entry (test, &log.test, DEBUG_LOG_SEVERITY_INFO,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 0, 0, time += 1);
+		count += 4;
+	}
+
+	CuAssertTrue (test, ((log.state.batch_length + sizeof (struct logging_entry_header)) * 3) <=
+		(count * sizeof (struct debug_log_entry)));
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_decode (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	struct debug_log_entry_info expected[] = {
+		{DEBUG_LOG_ENTRY_FORMAT, 1, 2, 3, 4, 5, 100},
+		{DEBUG_LOG_ENTRY_FORMAT, 0, 2, 7, 0xffffffff, 0, 105},
+		{DEBUG_LOG_ENTRY_FORMAT, 0, 2, 7, 0xffffffff, 0, 107},
+		{DEBUG_LOG_ENTRY_FORMAT, 0, 2, 7, 0xffffffff, 0, 109},
+		{DEBUG_LOG_ENTRY_FORMAT, 2, 9, 1, 0x12345678, 0x80000000, 0x100000000ULL}
+	};
+	struct debug_log_entry_info entry;
+	size_t offset;
+	uint32_t repeat;
+	int status;
+	int i;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	for (i = 0; i < (int) ARRAY_SIZE (expected); i++) {
+		debug_log_compact_testing_add_entry (test, &log.test, expected[i].severity,
+			expected[i].component, expected[i].msg_index, expected[i].arg1, expected[i].arg2,
+			expected[i].time);
+	}
+
+	status = debug_log_compact_decode_header (log.batch, log.state.batch_length, &entry);
+	CuAssertIntEquals (test, sizeof (struct debug_log_compact_header), status);
+	offset = status;
+
+	status = debug_log_compact_decode_record (&log.batch[offset], log.state.batch_length - offset,
+		&entry, &repeat);
+	CuAssertTrue (test, (status > 0));
+	CuAssertIntEquals (test, 0, repeat);
+	CuAssertIntEquals (test, 0, memcmp (&expected[0], &entry, sizeof (entry)));
+	offset += status;
+
+	status = debug_log_compact_decode_record (&log.batch[offset], log.state.batch_length - offset,
+		&entry, &repeat);
+	CuAssertTrue (test, (status > 0));
+	CuAssertIntEquals (test, 0, repeat);
+	CuAssertIntEquals (test, 0, memcmp (&expected[1], &entry, sizeof (entry)));
+	offset += status;
+
+	/* Repeated entries are stored with the time of the last repeat. */
+	status = debug_log_compact_decode_record (&log.batch[offset], log.state.batch_length - offset,
+		&entry, &repeat);
+	CuAssertTrue (test, (status > 0));
+	CuAssertIntEquals (test, 2, repeat);
+	CuAssertIntEquals (test, 0, memcmp (&expected[3], &entry, sizeof (entry)));
+	offset += status;
+
+	status = debug_log_compact_decode_record (&log.batch[offset], log.state.batch_length - offset,
+		&entry, &repeat);
+	CuAssertTrue (test, (status > 0));
+	CuAssertIntEquals (test, 0, repeat);
+	CuAssertIntEquals (test, 0, memcmp (&expected[4], &entry, sizeof (entry)));
+	offset += status;
+
+	CuAssertIntEquals (test, log.state.batch_length, offset);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_create_entry_null (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = 1,
+		.component = 2,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5,
+		.time = 100
+	};
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = log.test.base.create_entry (NULL, (uint8_t*) &entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = log.test.base.create_entry (&log.test.base, NULL, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+#ifndef LOGGING_DISABLE_FLUSH
+static void debug_log_compact_test_flush_no_entries (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_flush_twice (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x00};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 100, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_flush_null (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = log.test.base.flush (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_flush_save_error (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x00};
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (expected, 100, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log,
+		LOGGING_CREATE_ENTRY_FAILED, MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, LOGGING_CREATE_ENTRY_FAILED, status);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&log.log.mock, log.log.base.create_entry, &log.log, 0,
+		MOCK_ARG_PTR_CONTAINS (expected, length), MOCK_ARG (length));
+	status |= mock_expect (&log.log.mock, log.log.base.flush, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.flush (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+#endif
+
+static void debug_log_compact_test_clear (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x04, 0x01, 0x00, 0x00, 0x00};
+	uint8_t batch[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (batch, 200, records, sizeof (records));
+	length = debug_log_compact_testing_build_batch_entry (expected, 0, batch, length);
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.clear, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.clear (&log.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Batched entries are discarded and a new batch is started. */
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 4, 1, 0, 0, 200);
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 0);
+	status |= mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.get_size (&log.test.base);
+	CuAssertIntEquals (test, length, status);
+
+	status = log.test.base.read_contents (&log.test.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, length, status);
+
+	status = testing_validate_array (expected, output, length);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_clear_error (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x00};
+	uint8_t batch[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (batch, 100, records, sizeof (records));
+	length = debug_log_compact_testing_build_batch_entry (expected, 0, batch, length);
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.clear, &log.log, LOGGING_CLEAR_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.clear (&log.test.base);
+	CuAssertIntEquals (test, LOGGING_CLEAR_FAILED, status);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The batch is not discarded if the log was not cleared. */
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, length, status);
+
+	status = testing_validate_array (expected, output, length);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_clear_null (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = log.test.base.clear (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_get_size (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x00};
+	uint8_t batch[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (batch, 100, records, sizeof (records));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	/* The batch is not saved to the target log. */
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 1024);
+	status |= mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 1024);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.get_size (&log.test.base);
+	CuAssertIntEquals (test, 1024 + sizeof (struct logging_entry_header) + length, status);
+
+	status = log.test.base.get_size (&log.test.base);
+	CuAssertIntEquals (test, 1024 + sizeof (struct logging_entry_header) + length, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_get_size_no_entries (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 1024);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.get_size (&log.test.base);
+	CuAssertIntEquals (test, 1024, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_get_size_null (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = log.test.base.get_size (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_get_size_error (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log,
+		LOGGING_GET_SIZE_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.get_size (&log.test.base);
+	CuAssertIntEquals (test, LOGGING_GET_SIZE_FAILED, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_read_contents (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t contents[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	int status;
+
+	TEST_START;
+
+	memset (contents, 0x55, sizeof (contents));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 1024);
+	status |= mock_expect (&log.log.mock, log.log.base.read_contents, &log.log, 32, MOCK_ARG (16),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (output)));
+	status |= mock_expect_output (&log.log.mock, 1, contents, sizeof (contents), 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, 16, output, sizeof (output));
+	CuAssertIntEquals (test, 32, status);
+
+	status = testing_validate_array (contents, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_read_contents_no_entries (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t contents[64];
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	int status;
+
+	TEST_START;
+
+	memset (contents, 0x55, sizeof (contents));
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, sizeof (contents));
+	status |= mock_expect (&log.log.mock, log.log.base.read_contents, &log.log, sizeof (contents),
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (output)));
+	status |= mock_expect_output (&log.log.mock, 1, contents, sizeof (contents), 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (contents), status);
+
+	status = testing_validate_array (contents, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_read_contents_batched_entries (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t records[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x00};
+	uint8_t batch[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t expected[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	uint8_t contents[64];
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	struct logging_entry_header *header;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	length = debug_log_compact_testing_build_batch (batch, 100, records, sizeof (records));
+	length = debug_log_compact_testing_build_batch_entry (expected, 7, batch, length);
+
+	/* The target log contains two entries, so the batch is reported as the next entry. */
+	memset (contents, 0x55, sizeof (contents));
+	header = (struct logging_entry_header*) contents;
+	header->log_magic = LOGGING_MAGIC_START;
+	header->length = 40;
+	header->entry_id = 5;
+
+	header = (struct logging_entry_header*) &contents[40];
+	header->log_magic = LOGGING_MAGIC_START;
+	header->length = 24;
+	header->entry_id = 6;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, sizeof (contents));
+	status |= mock_expect (&log.log.mock, log.log.base.read_contents, &log.log, sizeof (contents),
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (output)));
+	status |= mock_expect_output (&log.log.mock, 1, contents, sizeof (contents), 2);
+
+	status |= mock_expect (&log.log.mock, log.log.base.read_contents, &log.log,
+		sizeof (struct logging_entry_header), MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (struct logging_entry_header)));
+	status |= mock_expect_output (&log.log.mock, 1, contents, sizeof (contents), 2);
+
+	status |= mock_expect (&log.log.mock, log.log.base.read_contents, &log.log,
+		sizeof (struct logging_entry_header), MOCK_ARG (40), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (struct logging_entry_header)));
+	status |= mock_expect_output (&log.log.mock, 1, &contents[40], sizeof (contents) - 40, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (contents) + length, status);
+
+	status = testing_validate_array (contents, output, sizeof (contents));
+	status |= testing_validate_array (expected, &output[sizeof (contents)], length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&log.log.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Reading only the batch again doesn't read the target log or scan for the entry ID. */
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, sizeof (contents));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, sizeof (contents) + 3, output, 10);
+	CuAssertIntEquals (test, 10, status);
+
+	status = testing_validate_array (&expected[3], output, 10);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_read_contents_null (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	status = log.test.base.read_contents (NULL, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = log.test.base.read_contents (&log.test.base, 0, NULL, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_read_contents_get_size_error (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log,
+		LOGGING_GET_SIZE_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_GET_SIZE_FAILED, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_read_contents_read_error (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 64);
+	status |= mock_expect (&log.log.mock, log.log.base.read_contents, &log.log,
+		LOGGING_READ_CONTENTS_FAILED, MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (output)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_READ_CONTENTS_FAILED, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+static void debug_log_compact_test_read_contents_entry_id_error (CuTest *test)
+{
+	struct debug_log_compact_testing log;
+	uint8_t output[DEBUG_LOG_COMPACT_TESTING_BATCH_SIZE];
+	int status;
+
+	TEST_START;
+
+	debug_log_compact_testing_init (test, &log, sizeof (log.batch));
+
+	debug_log_compact_testing_add_entry (test, &log.test, 1, 2, 3, 4, 5, 100);
+
+	status = mock_expect (&log.log.mock, log.log.base.get_size, &log.log, 64);
+	status |= mock_expect (&log.log.mock, log.log.base.read_contents, &log.log,
+		LOGGING_READ_CONTENTS_FAILED, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (struct logging_entry_header)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = log.test.base.read_contents (&log.test.base, 64, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_READ_CONTENTS_FAILED, status);
+
+	debug_log_compact_testing_release (test, &log);
+}
+
+TEST_SUITE_START (debug_log_compact);
+
+TEST (debug_log_compact_test_init);
+TEST (debug_log_compact_test_init_minimum_batch);
+TEST (debug_log_compact_test_init_null);
+TEST (debug_log_compact_test_init_small_batch);
+TEST (debug_log_compact_test_static_init);
+TEST (debug_log_compact_test_static_init_null);
+TEST (debug_log_compact_test_release_null);
+TEST (debug_log_compact_test_create_entry);
+TEST (debug_log_compact_test_create_entry_multiple);
+TEST (debug_log_compact_test_create_entry_repeated);
+TEST (debug_log_compact_test_create_entry_repeated_many);
+TEST (debug_log_compact_test_create_entry_batch_full);
+TEST (debug_log_compact_test_create_entry_batch_full_repeat);
+TEST (debug_log_compact_test_create_entry_save_error);
+TEST (debug_log_compact_test_create_entry_not_debug_entry);
+TEST (debug_log_compact_test_create_entry_unknown_format);
+TEST (debug_log_compact_test_create_entry_history_size);
+TEST (debug_log_compact_test_create_entry_decode);
+TEST (debug_log_compact_test_create_entry_null);
+#ifndef LOGGING_DISABLE_FLUSH
+TEST (debug_log_compact_test_flush_no_entries);
+TEST (debug_log_compact_test_flush_twice);
+TEST (debug_log_compact_test_flush_null);
+TEST (debug_log_compact_test_flush_save_error);
+#endif
+TEST (debug_log_compact_test_clear);
+TEST (debug_log_compact_test_clear_error);
+TEST (debug_log_compact_test_clear_null);
+TEST (debug_log_compact_test_get_size);
+TEST (debug_log_compact_test_get_size_no_entries);
+TEST (debug_log_compact_test_get_size_null);
+TEST (debug_log_compact_test_get_size_error);
+TEST (debug_log_compact_test_read_contents);
+TEST (debug_log_compact_test_read_contents_no_entries);
+TEST (debug_log_compact_test_read_contents_batched_entries);
+TEST (debug_log_compact_test_read_contents_null);
+TEST (debug_log_compact_test_read_contents_get_size_error);
+TEST (debug_log_compact_test_read_contents_read_error);
+TEST (debug_log_compact_test_read_contents_entry_id_error);
+
+TEST_SUITE_END;
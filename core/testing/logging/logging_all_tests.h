@@ -27,6 +27,18 @@ static void add_all_logging_tests (CuSuite *suite)
 	!defined TESTING_SKIP_DEBUG_LOG_SUITE
 	TESTING_RUN_SUITE (debug_log);
 #endif
+#if (defined TESTING_RUN_DEBUG_LOG_COMPACT_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_DEBUG_LOG_COMPACT_SUITE
+	TESTING_RUN_SUITE (debug_log_compact);
+#endif
+#if (defined TESTING_RUN_DEBUG_LOG_COMPACT_FORMAT_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_DEBUG_LOG_COMPACT_FORMAT_SUITE
+	TESTING_RUN_SUITE (debug_log_compact_format);
+#endif
 #if (defined TESTING_RUN_LOG_FLUSH_HANDLER_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
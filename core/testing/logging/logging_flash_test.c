@@ -23,6 +23,174 @@ struct logging_entry_header_ca {
 } __attribute__ ((__packed__));
 
 
+/**
+ * Length of the entries used for testing deferred flushes, including the entry header.  This
+ * evenly divides a flash sector.
+ */
+#define	LOGGING_FLASH_TESTING_ENTRY_LEN		16
+
+/**
+ * Length of the entry data used for testing deferred flushes.
+ */
+#define	LOGGING_FLASH_TESTING_ENTRY_SIZE	\
+	(LOGGING_FLASH_TESTING_ENTRY_LEN - sizeof (struct logging_entry_header))
+
+/**
+ * Number of test entries that fill a flash sector.
+ */
+#define	LOGGING_FLASH_TESTING_SECTOR_ENTRIES	\
+	(FLASH_SECTOR_SIZE / LOGGING_FLASH_TESTING_ENTRY_LEN)
+
+
+/**
+ * Initialize a log on flash that contains no log entries.
+ *
+ * @param test The testing framework.
+ * @param flash_mock The mock for the flash device.
+ * @param flash The flash device to initialize.
+ * @param flash_state Variable context for the flash device.
+ * @param logging The log to initialize.
+ * @param state Variable context for the log.
+ */
+static void logging_flash_testing_init_empty (CuTest *test, struct flash_master_mock *flash_mock,
+	struct spi_flash *flash, struct spi_flash_state *flash_state, struct logging_flash *logging,
+	struct logging_flash_state *state)
+{
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	int status;
+	int i;
+
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	status = flash_master_mock_init (flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (flash, flash_state, &flash_mock->base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (logging, state, flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock->mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Generate the expected log data for a sequence of test entries.  The data for each entry is
+ * filled with the entry ID.
+ *
+ * @param data Output for the log data.
+ * @param first The ID of the first entry.
+ * @param count The number of entries to generate.
+ */
+static void logging_flash_testing_build_entries (uint8_t *data, int first, int count)
+{
+	struct logging_entry_header *header;
+	int i;
+
+	for (i = first; i < (first + count); ++i) {
+		header = (struct logging_entry_header*) data;
+		header->log_magic = 0xCB;
+		header->length = LOGGING_FLASH_TESTING_ENTRY_LEN;
+		header->entry_id = i;
+
+		memset (&data[sizeof (struct logging_entry_header)], i, LOGGING_FLASH_TESTING_ENTRY_SIZE);
+		data += LOGGING_FLASH_TESTING_ENTRY_LEN;
+	}
+}
+
+/**
+ * Add a sequence of test entries to a log.  The data for each entry is filled with the entry ID.
+ *
+ * @param test The testing framework.
+ * @param logging The log to update.
+ * @param first The ID of the first entry.
+ * @param count The number of entries to add.
+ */
+static void logging_flash_testing_add_entries (CuTest *test, struct logging_flash *logging,
+	int first, int count)
+{
+	uint8_t entry[LOGGING_FLASH_TESTING_ENTRY_SIZE];
+	int status;
+	int i;
+
+	for (i = first; i < (first + count); ++i) {
+		memset (entry, i, sizeof (entry));
+
+		status = logging->base.create_entry (&logging->base, entry, sizeof (entry));
+		CuAssertIntEquals (test, 0, status);
+	}
+}
+
+/**
+ * Set up expectations for reading log data from flash.
+ *
+ * @param flash_mock The mock for the flash device.
+ * @param addr The flash address that will be read.
+ * @param data The data that will be returned.
+ * @param length The number of bytes that will be read.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int logging_flash_testing_expect_read (struct flash_master_mock *flash_mock, uint32_t addr,
+	const uint8_t *data, size_t length)
+{
+	int status;
+
+	status = flash_master_mock_expect_rx_xfer (flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (flash_mock, 0, data, length,
+		FLASH_EXP_READ_CMD (0x03, addr, 0, -1, length));
+
+	return status;
+}
+
+/**
+ * Add test entries to an empty log until the specified number of sectors have been written to
+ * flash, followed by additional entries that remain buffered.
+ *
+ * @param test The testing framework.
+ * @param flash_mock The mock for the flash device.
+ * @param logging The log to update.
+ * @param entry_data The expected log data for all the entries being added.
+ * @param sectors The number of sectors that will be written to flash.
+ * @param buffered The number of entries to add after the last sector is written.
+ */
+static void logging_flash_testing_fill_sectors (CuTest *test, struct flash_master_mock *flash_mock,
+	struct logging_flash *logging, const uint8_t *entry_data, int sectors, int buffered)
+{
+	int status = 0;
+	int i;
+
+	for (i = 0; i < sectors; ++i) {
+		status |= flash_master_mock_expect_erase_flash_sector (flash_mock,
+			0x10000 + ((i % LOGGING_FLASH_SECTORS) * FLASH_SECTOR_SIZE));
+		status |= flash_master_mock_expect_write (flash_mock,
+			0x10000 + ((i % LOGGING_FLASH_SECTORS) * FLASH_SECTOR_SIZE),
+			&entry_data[i * FLASH_SECTOR_SIZE], FLASH_SECTOR_SIZE);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, logging, 0,
+		(sectors * LOGGING_FLASH_TESTING_SECTOR_ENTRIES) + buffered);
+
+	status = mock_validate (&flash_mock->mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
 /*******************
  * Test cases
  *******************/
@@ -21571,6 +21739,1252 @@ static void logging_flash_test_clear_erase_error (CuTest *test)
 }
 
 
+static void logging_flash_test_deferred_flush (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE * 2];
+	uint8_t entry_data[FLASH_SECTOR_SIZE + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Filling the entry buffer should not access flash. */
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, sizeof (entry_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_deferred_flush_multiple_sectors (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE * 2];
+	uint8_t entry_data[(FLASH_SECTOR_SIZE * 2) + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0,
+		(LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 2) + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 0,
+		(LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 2) + 1);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, FLASH_SECTOR_SIZE - 8, output,
+		sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data) - (FLASH_SECTOR_SIZE - 8), status);
+
+	status = testing_validate_array (&entry_data[FLASH_SECTOR_SIZE - 8], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x12000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x12000,
+		&entry_data[FLASH_SECTOR_SIZE * 2], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_deferred_flush_pending_full (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	uint8_t entry_data[(FLASH_SECTOR_SIZE * 2) + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	uint8_t entry[LOGGING_FLASH_TESTING_ENTRY_SIZE];
+	uint32_t dropped;
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0,
+		(LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 2) + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 2);
+
+	/* With no space left for deferring the entry buffer, the new entry is dropped instead of
+	 * writing to flash. */
+	memset (entry, 0x55, sizeof (entry));
+
+	status = logging.base.create_entry (&logging.base, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_ENTRY_DROPPED, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE * 2, status);
+
+	status = logging_flash_get_dropped_entries (&logging, &dropped);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, dropped);
+
+	/* The flush writes the pending sector before making room for the entry buffer. */
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x12000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The dropped entry doesn't use an entry ID, so the next entry gets the same ID. */
+	logging_flash_testing_add_entries (test, &logging, LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 2, 1);
+
+	status = flash_master_mock_expect_write (&flash_mock, 0x12000,
+		&entry_data[FLASH_SECTOR_SIZE * 2], LOGGING_FLASH_TESTING_ENTRY_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging_flash_get_dropped_entries (&logging, &dropped);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, dropped);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+/**
+ * Context for adding an entry to a log while the log is being flushed.
+ */
+struct logging_flash_testing_flush_context {
+	CuTest *test;						/**< The test framework. */
+	struct logging_flash *logging;		/**< The log being flushed. */
+	int id;								/**< ID of the entry to add. */
+	int size;							/**< Expected log size after adding the entry. */
+};
+
+/**
+ * Mock action to add an entry to a log while flash is being accessed for a flush.  This would
+ * deadlock if the log was locked for the flash access.
+ */
+static int64_t logging_flash_testing_add_entry_during_flush (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct logging_flash_testing_flush_context *context = expected->context;
+	int status;
+
+	logging_flash_testing_add_entries (context->test, context->logging, context->id, 1);
+
+	status = context->logging->base.get_size (&context->logging->base);
+	CuAssertIntEquals (context->test, context->size, status);
+
+	return 0;
+}
+
+static void logging_flash_test_deferred_flush_add_entry_during_flush (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE * 2];
+	uint8_t entry_data[FLASH_SECTOR_SIZE + (LOGGING_FLASH_TESTING_ENTRY_LEN * 2)];
+	uint8_t output[sizeof (entry_data)];
+	struct logging_flash_testing_flush_context context;
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 2);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	context.test = test;
+	context.logging = &logging;
+	context.id = LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1;
+	context.size = sizeof (entry_data);
+
+	/* Add an entry while the first sector is being erased. */
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= mock_expect_external_action (&flash_mock.mock,
+		logging_flash_testing_add_entry_during_flush, &context);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The entry added during the flush is still buffered. */
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging_flash_testing_expect_read (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= logging_flash_testing_expect_read (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, sizeof (entry_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_write (&flash_mock, 0x11000 + LOGGING_FLASH_TESTING_ENTRY_LEN,
+		&entry_data[FLASH_SECTOR_SIZE + LOGGING_FLASH_TESTING_ENTRY_LEN],
+		LOGGING_FLASH_TESTING_ENTRY_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_init_with_deferred_flush (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE * 2];
+	uint8_t entry_data[FLASH_SECTOR_SIZE + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	int status;
+	int i;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init_with_deferred_flush (&logging, &state, &flash, 0x10000, pending,
+		sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, logging.base.create_entry);
+	CuAssertPtrNotNull (test, logging.base.flush);
+	CuAssertPtrNotNull (test, logging.base.clear);
+	CuAssertPtrNotNull (test, logging.base.get_size);
+	CuAssertPtrNotNull (test, logging.base.read_contents);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Filling the entry buffer should not access flash. */
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_init_with_deferred_flush_invalid_arg (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init_with_deferred_flush (NULL, &state, &flash, 0x10000, pending,
+		sizeof (pending));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_init_with_deferred_flush (&logging, NULL, &flash, 0x10000, pending,
+		sizeof (pending));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_init_with_deferred_flush (&logging, &state, NULL, 0x10000, pending,
+		sizeof (pending));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_init_with_deferred_flush (&logging, &state, &flash, 0x10000, pending,
+		sizeof (pending) - 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_static_init_with_deferred_flush (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	uint8_t pending[FLASH_SECTOR_SIZE * 2];
+	struct logging_flash logging = logging_flash_static_init_with_deferred_flush (&state, &flash,
+		0x10000, pending, sizeof (pending));
+	uint8_t entry_data[FLASH_SECTOR_SIZE + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	uint8_t log_empty[FLASH_SECTOR_SIZE];
+	int status;
+	int i;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+	memset (log_empty, 0xff, sizeof (log_empty));
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_empty, FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Filling the entry buffer should not access flash. */
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_static_init_with_deferred_flush_short_buffer (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	struct logging_flash logging = logging_flash_static_init_with_deferred_flush (&state, &flash,
+		0x10000, pending, sizeof (pending) - 1);
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init_state (&logging);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_get_dropped_entries_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint32_t dropped;
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_get_dropped_entries (NULL, &dropped);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_get_dropped_entries (&logging, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_deferred_flush_erase_next_sector (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	uint8_t entry_data[FLASH_SECTOR_SIZE + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES);
+
+	/* The flush fills the sector, so the next sector gets erased. */
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Another flush should not erase the sector again. */
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, LOGGING_FLASH_TESTING_SECTOR_ENTRIES, 1);
+
+	status = flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_deferred_flush_write_error (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	uint8_t entry_data[FLASH_SECTOR_SIZE + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	status = flash_master_mock_expect_xfer (&flash_mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_READ_STATUS_REG);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The pending data is still available and will be written on the next flush. */
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+	status |= flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_deferred_flush_disable (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	uint8_t entry_data[FLASH_SECTOR_SIZE + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x10000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		FLASH_SECTOR_SIZE);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_enable_deferred_flush (&logging, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = flash_master_mock_expect_erase_flash_sector (&flash_mock, 0x11000);
+	status |= flash_master_mock_expect_write (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], LOGGING_FLASH_TESTING_ENTRY_LEN);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_deferred_flush_clear (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	uint8_t entry_data[LOGGING_FLASH_TESTING_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1, 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1);
+
+	status = flash_master_mock_expect_erase_flash (&flash_mock, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.clear (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The log was erased, so new entries can be written without erasing again. */
+	logging_flash_testing_add_entries (test, &logging, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 1, 1);
+
+	status = flash_master_mock_expect_write (&flash_mock, 0x10000, entry_data,
+		sizeof (entry_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_deferred_flush_invalid_arg (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t pending[FLASH_SECTOR_SIZE];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_enable_deferred_flush (NULL, pending, sizeof (pending));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_enable_deferred_flush (&logging, pending, sizeof (pending) - 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_read_contents_indexed_offset (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t entry_data[(FLASH_SECTOR_SIZE * 3) + LOGGING_FLASH_TESTING_ENTRY_LEN];
+	uint8_t output[LOGGING_FLASH_TESTING_ENTRY_LEN * 2];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0,
+		(LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 3) + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+	logging_flash_testing_fill_sectors (test, &flash_mock, &logging, entry_data, 3, 1);
+
+	/* Only the sector containing the requested data should be read. */
+	status = logging_flash_testing_expect_read (&flash_mock, 0x11000 + 16,
+		&entry_data[FLASH_SECTOR_SIZE + 16], sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, FLASH_SECTOR_SIZE + 16, output,
+		sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&entry_data[FLASH_SECTOR_SIZE + 16], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read across the last sector in flash into the buffered entries. */
+	status = logging_flash_testing_expect_read (&flash_mock, 0x13000 - 16,
+		&entry_data[(FLASH_SECTOR_SIZE * 3) - 16], 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, (FLASH_SECTOR_SIZE * 3) - 16, output,
+		sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&entry_data[(FLASH_SECTOR_SIZE * 3) - 16], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_get_entry_offset_buffered (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint32_t offset;
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+	logging_flash_testing_add_entries (test, &logging, 0, 5);
+
+	status = logging_flash_get_entry_offset (&logging, 0, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, offset);
+
+	status = logging_flash_get_entry_offset (&logging, 3, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 3, offset);
+
+	status = logging_flash_get_entry_offset (&logging, 4, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 4, offset);
+
+	status = logging_flash_get_entry_offset (&logging, 5, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 5, offset);
+
+	status = logging_flash_get_entry_offset (&logging, 100, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 5, offset);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_get_entry_offset_flash (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t entry_data[(FLASH_SECTOR_SIZE * 2) + (LOGGING_FLASH_TESTING_ENTRY_LEN * 3)];
+	uint32_t offset;
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0,
+		(LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 2) + 3);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+	logging_flash_testing_fill_sectors (test, &flash_mock, &logging, entry_data, 2, 3);
+
+	/* Entries at the start of a sector don't require any flash accesses. */
+	status = logging_flash_get_entry_offset (&logging, 0, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, offset);
+
+	status = logging_flash_get_entry_offset (&logging, LOGGING_FLASH_TESTING_SECTOR_ENTRIES,
+		&offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE, offset);
+
+	/* Buffered entries don't require any flash accesses. */
+	status = logging_flash_get_entry_offset (&logging,
+		(LOGGING_FLASH_TESTING_SECTOR_ENTRIES * 2) + 1, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, (FLASH_SECTOR_SIZE * 2) + LOGGING_FLASH_TESTING_ENTRY_LEN, offset);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Entries in the middle of a sector are found by reading entry headers in that sector. */
+	status = logging_flash_testing_expect_read (&flash_mock, 0x11000,
+		&entry_data[FLASH_SECTOR_SIZE], sizeof (struct logging_entry_header));
+	status |= logging_flash_testing_expect_read (&flash_mock, 0x11000 + 16,
+		&entry_data[FLASH_SECTOR_SIZE + 16], sizeof (struct logging_entry_header));
+	status |= logging_flash_testing_expect_read (&flash_mock, 0x11000 + 32,
+		&entry_data[FLASH_SECTOR_SIZE + 32], sizeof (struct logging_entry_header));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_get_entry_offset (&logging, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 2,
+		&offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE + 32, offset);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_get_entry_offset_log_wrap (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t entry_data[(FLASH_SECTOR_SIZE * (LOGGING_FLASH_SECTORS + 1)) +
+		LOGGING_FLASH_TESTING_ENTRY_LEN];
+	uint32_t offset;
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0,
+		(LOGGING_FLASH_TESTING_SECTOR_ENTRIES * (LOGGING_FLASH_SECTORS + 1)) + 1);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+	logging_flash_testing_fill_sectors (test, &flash_mock, &logging, entry_data,
+		LOGGING_FLASH_SECTORS + 1, 1);
+
+	/* The first sector was overwritten, so the oldest entries are in the second sector. */
+	status = logging_flash_get_entry_offset (&logging, 0, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, offset);
+
+	status = logging_flash_get_entry_offset (&logging, LOGGING_FLASH_TESTING_SECTOR_ENTRIES,
+		&offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, offset);
+
+	status = logging_flash_get_entry_offset (&logging,
+		LOGGING_FLASH_TESTING_SECTOR_ENTRIES * LOGGING_FLASH_SECTORS, &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE * (LOGGING_FLASH_SECTORS - 1), offset);
+
+	status = logging_flash_get_entry_offset (&logging,
+		LOGGING_FLASH_TESTING_SECTOR_ENTRIES * (LOGGING_FLASH_SECTORS + 1), &offset);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE * LOGGING_FLASH_SECTORS, offset);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_get_entry_offset_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint32_t offset;
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_get_entry_offset (NULL, 0, &offset);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_get_entry_offset (&logging, 0, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_read_entries_after (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t entry_data[LOGGING_FLASH_TESTING_ENTRY_LEN * 7];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, 7);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+	logging_flash_testing_add_entries (test, &logging, 0, 5);
+
+	status = logging_flash_read_entries_after (&logging, 1, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 3, status);
+
+	status = testing_validate_array (&entry_data[LOGGING_FLASH_TESTING_ENTRY_LEN * 2], output,
+		status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No new entries. */
+	status = logging_flash_read_entries_after (&logging, 4, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_testing_add_entries (test, &logging, 5, 2);
+
+	status = logging_flash_read_entries_after (&logging, 4, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 2, status);
+
+	status = testing_validate_array (&entry_data[LOGGING_FLASH_TESTING_ENTRY_LEN * 5], output,
+		status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_read_entries_after (&logging, 6, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_read_entries_after_partial_entry (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t entry_data[LOGGING_FLASH_TESTING_ENTRY_LEN * 5];
+	uint8_t output[(LOGGING_FLASH_TESTING_ENTRY_LEN * 2) + 8];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, 5);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+	logging_flash_testing_add_entries (test, &logging, 0, 5);
+
+	/* Only complete entries are returned. */
+	status = logging_flash_read_entries_after (&logging, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 2, status);
+
+	status = testing_validate_array (&entry_data[LOGGING_FLASH_TESTING_ENTRY_LEN], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_read_entries_after (&logging, 2, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_FLASH_TESTING_ENTRY_LEN * 2, status);
+
+	status = testing_validate_array (&entry_data[LOGGING_FLASH_TESTING_ENTRY_LEN * 3], output,
+		status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_read_entries_after (&logging, 0, output,
+		LOGGING_FLASH_TESTING_ENTRY_LEN - 1);
+	CuAssertIntEquals (test, LOGGING_BUFFER_TOO_SMALL, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_read_entries_after_flash (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t entry_data[FLASH_SECTOR_SIZE + (LOGGING_FLASH_TESTING_ENTRY_LEN * 3)];
+	uint8_t output[LOGGING_FLASH_TESTING_ENTRY_LEN * 3];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_build_entries (entry_data, 0, LOGGING_FLASH_TESTING_SECTOR_ENTRIES + 3);
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+	logging_flash_testing_fill_sectors (test, &flash_mock, &logging, entry_data, 1, 3);
+
+	status = logging_flash_testing_expect_read (&flash_mock, 0x10000, entry_data,
+		sizeof (struct logging_entry_header));
+	status |= logging_flash_testing_expect_read (&flash_mock, 0x10000 + 16, &entry_data[16],
+		sizeof (struct logging_entry_header));
+	status |= logging_flash_testing_expect_read (&flash_mock, 0x10000 + 32, &entry_data[32],
+		sizeof (struct logging_entry_header));
+	status |= logging_flash_testing_expect_read (&flash_mock, 0x10000 + 32, &entry_data[32],
+		sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_read_entries_after (&logging, 1, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&entry_data[32], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Reading the next entries doesn't need to search for the starting entry. */
+	status = logging_flash_testing_expect_read (&flash_mock, 0x10000 + 80, &entry_data[80],
+		sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_read_entries_after (&logging, 4, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&entry_data[80], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Buffered entries don't require any flash accesses. */
+	status = logging_flash_read_entries_after (&logging, LOGGING_FLASH_TESTING_SECTOR_ENTRIES - 1,
+		output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&entry_data[FLASH_SECTOR_SIZE], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_read_entries_after_null (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	uint8_t output[LOGGING_FLASH_TESTING_ENTRY_LEN];
+	int status;
+
+	TEST_START;
+
+	logging_flash_testing_init_empty (test, &flash_mock, &flash, &flash_state, &logging, &state);
+
+	status = logging_flash_read_entries_after (NULL, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_flash_read_entries_after (&logging, 0, NULL, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+
 TEST_SUITE_START (logging_flash);
 
 TEST (logging_flash_test_init_empty);
@@ -21786,5 +23200,28 @@ TEST (logging_flash_test_clear_full_buffer_flush_after_incomplete_flush_unused_b
 TEST (logging_flash_test_clear_static_init);
 TEST (logging_flash_test_clear_null);
 TEST (logging_flash_test_clear_erase_error);
+TEST (logging_flash_test_deferred_flush);
+TEST (logging_flash_test_deferred_flush_multiple_sectors);
+TEST (logging_flash_test_deferred_flush_pending_full);
+TEST (logging_flash_test_deferred_flush_add_entry_during_flush);
+TEST (logging_flash_test_deferred_flush_erase_next_sector);
+TEST (logging_flash_test_deferred_flush_write_error);
+TEST (logging_flash_test_deferred_flush_disable);
+TEST (logging_flash_test_deferred_flush_clear);
+TEST (logging_flash_test_deferred_flush_invalid_arg);
+TEST (logging_flash_test_init_with_deferred_flush);
+TEST (logging_flash_test_init_with_deferred_flush_invalid_arg);
+TEST (logging_flash_test_static_init_with_deferred_flush);
+TEST (logging_flash_test_static_init_with_deferred_flush_short_buffer);
+TEST (logging_flash_test_get_dropped_entries_null);
+TEST (logging_flash_test_read_contents_indexed_offset);
+TEST (logging_flash_test_get_entry_offset_buffered);
+TEST (logging_flash_test_get_entry_offset_flash);
+TEST (logging_flash_test_get_entry_offset_log_wrap);
+TEST (logging_flash_test_get_entry_offset_null);
+TEST (logging_flash_test_read_entries_after);
+TEST (logging_flash_test_read_entries_after_partial_entry);
+TEST (logging_flash_test_read_entries_after_flash);
+TEST (logging_flash_test_read_entries_after_null);
 
 TEST_SUITE_END;
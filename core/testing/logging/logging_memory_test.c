@@ -13,6 +13,66 @@
 TEST_SUITE_LABEL ("logging_memory");
 
 
+/**
+ * Length of the entry data used for testing lock-free logs.
+ */
+#define	LOGGING_MEMORY_TESTING_ENTRY_SIZE	11
+
+/**
+ * Length of the entries used for testing lock-free logs, including the entry header.
+ */
+#define	LOGGING_MEMORY_TESTING_ENTRY_LEN	\
+	(LOGGING_MEMORY_TESTING_ENTRY_SIZE + sizeof (struct logging_entry_header))
+
+
+/**
+ * Generate the expected log data for a sequence of test entries.  The data for each entry is
+ * filled with the entry ID.
+ *
+ * @param data Output for the log data.
+ * @param first The ID of the first entry.
+ * @param count The number of entries to generate.
+ */
+static void logging_memory_testing_build_entries (uint8_t *data, int first, int count)
+{
+	struct logging_entry_header *header;
+	int i;
+
+	for (i = first; i < (first + count); ++i) {
+		header = (struct logging_entry_header*) data;
+		header->log_magic = 0xCB;
+		header->length = LOGGING_MEMORY_TESTING_ENTRY_LEN;
+		header->entry_id = i;
+
+		memset (&data[sizeof (struct logging_entry_header)], i, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+		data += LOGGING_MEMORY_TESTING_ENTRY_LEN;
+	}
+}
+
+/**
+ * Add a sequence of test entries to a log.  The data for each entry is filled with the entry ID.
+ *
+ * @param test The testing framework.
+ * @param logging The log to update.
+ * @param first The ID of the first entry.
+ * @param count The number of entries to add.
+ */
+static void logging_memory_testing_add_entries (CuTest *test, struct logging_memory *logging,
+	int first, int count)
+{
+	uint8_t entry[LOGGING_MEMORY_TESTING_ENTRY_SIZE];
+	int status;
+	int i;
+
+	for (i = first; i < (first + count); ++i) {
+		memset (entry, i, sizeof (entry));
+
+		status = logging->base.create_entry (&logging->base, entry, sizeof (entry));
+		CuAssertIntEquals (test, 0, status);
+	}
+}
+
+
 /*******************
  * Test cases
  *******************/
@@ -2629,6 +2689,488 @@ static void logging_memory_test_clear_null (CuTest *test)
 }
 
 
+static void logging_memory_test_lock_free_create_entry (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 5];
+	uint8_t output[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 0, 5);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 5);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_full_log (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 0, 32);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 32);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_log_wrap (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 5, 32);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 37);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_log_wrap_read_offset (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	uint8_t output[LOGGING_MEMORY_TESTING_ENTRY_LEN * 2];
+	size_t offset = (LOGGING_MEMORY_TESTING_ENTRY_LEN * 26) + 3;
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 5, 32);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 37);
+
+	/* Read across the end of the log buffer. */
+	status = logging.base.read_contents (&logging.base, offset, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&entry_data[offset], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, sizeof (entry_data) - 5, output,
+		sizeof (output));
+	CuAssertIntEquals (test, 5, status);
+
+	status = testing_validate_array (&entry_data[sizeof (entry_data) - 5], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_existing_entries (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 5];
+	uint8_t output[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 0, 5);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 3);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, LOGGING_MEMORY_TESTING_ENTRY_LEN * 3, status);
+
+	logging_memory_testing_add_entries (test, &logging, 3, 2);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_existing_entries_log_wrap (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 6, 32);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 35);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	logging_memory_testing_add_entries (test, &logging, 35, 3);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_entry_in_progress (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 5];
+	uint8_t output[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 0, 5);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 3);
+
+	/* Reserve an entry slot without writing the entry, then add another entry after it. */
+	state.reserved++;
+	logging_memory_testing_add_entries (test, &logging, 4, 1);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, LOGGING_MEMORY_TESTING_ENTRY_LEN * 3, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_MEMORY_TESTING_ENTRY_LEN * 3, status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_clear (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 2];
+	uint8_t output[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 5, 2);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 5);
+
+	status = logging.base.clear (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 5, 2);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_enable_twice (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 4];
+	uint8_t output[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 0, 4);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 2);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 2, 2);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_sequence_wrap (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 5, 32);
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Start the sequence close to wrapping so new entries cross the boundary. */
+	state.reserved = 0xfffffff0;
+	state.first = state.reserved;
+	state.id_offset = 0x10;
+
+	logging_memory_testing_add_entries (test, &logging, 0, 37);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_existing_entries_from_buffer (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t log_buffer[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	uint8_t output[sizeof (entry_data)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (log_buffer, 32, 10);
+	logging_memory_testing_build_entries (&log_buffer[LOGGING_MEMORY_TESTING_ENTRY_LEN * 10], 10,
+		22);
+	logging_memory_testing_build_entries (entry_data, 12, 32);
+
+	status = logging_memory_init_append_existing (&logging, &state, log_buffer,
+		sizeof (log_buffer), LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 42, 2);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_enable_not_power_of_two (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t entry_data[LOGGING_MEMORY_TESTING_ENTRY_LEN * 2];
+	uint8_t output[LOGGING_MEMORY_TESTING_ENTRY_LEN * 30];
+	int status;
+
+	TEST_START;
+
+	logging_memory_testing_build_entries (entry_data, 0, 2);
+
+	status = logging_memory_init (&logging, &state, 30, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, LOGGING_LOCK_FREE_UNSUPPORTED, status);
+	CuAssertIntEquals (test, false, state.lock_free);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 2);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_enable_non_consecutive_ids (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	uint8_t log_buffer[LOGGING_MEMORY_TESTING_ENTRY_LEN * 32];
+	int status;
+
+	TEST_START;
+
+	/* The log is full, but the oldest entries are not followed by the newest ones. */
+	logging_memory_testing_build_entries (log_buffer, 32, 10);
+	logging_memory_testing_build_entries (&log_buffer[LOGGING_MEMORY_TESTING_ENTRY_LEN * 10], 0,
+		22);
+
+	status = logging_memory_init_append_existing (&logging, &state, log_buffer,
+		sizeof (log_buffer), LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, LOGGING_LOCK_FREE_UNSUPPORTED, status);
+	CuAssertIntEquals (test, false, state.lock_free);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_enable_unaligned_end (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_init (&logging, &state, 32, LOGGING_MEMORY_TESTING_ENTRY_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_testing_add_entries (test, &logging, 0, 2);
+	state.log_end++;
+
+	status = logging_memory_enable_lock_free (&logging);
+	CuAssertIntEquals (test, LOGGING_LOCK_FREE_UNSUPPORTED, status);
+	CuAssertIntEquals (test, false, state.lock_free);
+
+	logging_memory_release (&logging);
+}
+
+static void logging_memory_test_lock_free_enable_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_enable_lock_free (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+
 TEST_SUITE_START (logging_memory);
 
 TEST (logging_memory_test_init);
@@ -2690,5 +3232,20 @@ TEST (logging_memory_test_clear_log_wrap);
 TEST (logging_memory_test_clear_add_after_clear);
 TEST (logging_memory_test_clear_static_init);
 TEST (logging_memory_test_clear_null);
+TEST (logging_memory_test_lock_free_create_entry);
+TEST (logging_memory_test_lock_free_full_log);
+TEST (logging_memory_test_lock_free_log_wrap);
+TEST (logging_memory_test_lock_free_log_wrap_read_offset);
+TEST (logging_memory_test_lock_free_existing_entries);
+TEST (logging_memory_test_lock_free_existing_entries_log_wrap);
+TEST (logging_memory_test_lock_free_entry_in_progress);
+TEST (logging_memory_test_lock_free_clear);
+TEST (logging_memory_test_lock_free_enable_twice);
+TEST (logging_memory_test_lock_free_sequence_wrap);
+TEST (logging_memory_test_lock_free_existing_entries_from_buffer);
+TEST (logging_memory_test_lock_free_enable_not_power_of_two);
+TEST (logging_memory_test_lock_free_enable_non_consecutive_ids);
+TEST (logging_memory_test_lock_free_enable_unaligned_end);
+TEST (logging_memory_test_lock_free_enable_null);
 
 TEST_SUITE_END;
@@ -1906,6 +1906,43 @@ static void cfm_flash_testing_init_and_verify (CuTest *test, struct cfm_flash_te
 }
 
 
+/**
+ * Initialize a CFM for testing with a table of contents cache.  Run verification to load the CFM
+ * information.
+ *
+ * @param test The testing framework.
+ * @param cfm The testing components to initialize.
+ * @param address The base address for the CFM data.
+ * @param testing_data Container with testing data.
+ * @param toc_cache Buffer to use for the table of contents cache.
+ * @param cache_length Length of the table of contents cache.
+ */
+static void cfm_flash_testing_init_and_verify_toc_cache (CuTest *test,
+	struct cfm_flash_testing *cfm, uint32_t address, const struct cfm_testing_data *testing_data,
+	uint8_t *toc_cache, size_t cache_length)
+{
+	int status;
+
+	cfm_flash_testing_init (test, cfm, address);
+
+	status = manifest_flash_enable_toc_cache (&cfm->test.base_flash, toc_cache, cache_length);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_verify_manifest_toc_cache (test, &cfm->manifest,
+		&testing_data->manifest, 0);
+
+	status = cfm->test.base.base.verify (&cfm->test.base.base, &cfm->manifest.hash.base,
+		&cfm->manifest.verification.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, cfm->test.base_flash.toc_cache_valid);
+
+	status = mock_validate (&cfm->manifest.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&cfm->manifest.verification.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
 /*******************
  * Test cases
  *******************/
@@ -3768,6 +3805,52 @@ static void cfm_flash_test_get_component_device (CuTest *test)
 	cfm_flash_testing_validate_and_release (test, &cfm);
 }
 
+static void cfm_flash_test_get_component_device_toc_cache (CuTest *test)
+{
+	struct cfm_component_device component;
+	struct cfm_flash_testing cfm;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (MANIFEST_MAX_ENTRIES, MANIFEST_MAX_ENTRIES,
+		SHA512_HASH_LENGTH)];
+	int status;
+	int i;
+
+	TEST_START;
+
+	cfm_flash_testing_init_and_verify_toc_cache (test, &cfm, 0x10000, &CFM_TESTING, toc_cache,
+		sizeof (toc_cache));
+
+	/* Each lookup only reads the element data.  The table of contents is not read again. */
+	for (i = 0; i < 2; i++) {
+		manifest_flash_v2_testing_read_element_toc_cache (test, &cfm.manifest,
+			&CFM_TESTING.manifest, CFM_TESTING.component_device1_hash,
+			CFM_TESTING.component_device1_offset, CFM_TESTING.component_device1_len,
+			CFM_TESTING.component_device1_len, 0);
+
+		manifest_flash_v2_testing_read_element_toc_cache (test, &cfm.manifest,
+			&CFM_TESTING.manifest, 5, 0x6e4, 0x44, sizeof (struct cfm_pmr_digest_element), 0);
+		manifest_flash_v2_testing_read_element_toc_cache (test, &cfm.manifest,
+			&CFM_TESTING.manifest, 6, 0x728, 0x24, sizeof (struct cfm_pmr_digest_element), 0);
+
+		status = cfm.test.base.get_component_device (&cfm.test.base, 3, &component);
+		CuAssertIntEquals (test, 0, status);
+		CuAssertIntEquals (test, 1, component.cert_slot);
+		CuAssertIntEquals (test, 0, component.attestation_protocol);
+		CuAssertIntEquals (test, HASH_TYPE_SHA384, component.transcript_hash_type);
+		CuAssertIntEquals (test, HASH_TYPE_SHA256, component.measurement_hash_type);
+		CuAssertIntEquals (test, 3, component.component_id);
+		CuAssertIntEquals (test, 0, component.pmr_id_list[0]);
+		CuAssertIntEquals (test, 4, component.pmr_id_list[1]);
+		CuAssertIntEquals (test, 2, component.num_pmr_ids);
+
+		cfm.test.base.free_component_device (&cfm.test.base, &component);
+
+		status = mock_validate (&cfm.manifest.flash.mock);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	cfm_flash_testing_validate_and_release (test, &cfm);
+}
+
 static void cfm_flash_test_get_component_device_second_component (CuTest *test)
 {
 	struct cfm_component_device component;
@@ -11025,6 +11108,7 @@ TEST (cfm_flash_test_buffer_supported_components_verify_never_run);
 TEST (cfm_flash_test_buffer_supported_components_component_read_fail);
 TEST (cfm_flash_test_buffer_supported_components_malformed_component_device);
 TEST (cfm_flash_test_get_component_device);
+TEST (cfm_flash_test_get_component_device_toc_cache);
 TEST (cfm_flash_test_get_component_device_second_component);
 TEST (cfm_flash_test_get_component_device_null);
 TEST (cfm_flash_test_get_component_device_component_read_fail);
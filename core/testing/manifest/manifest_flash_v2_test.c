@@ -1098,6 +1098,177 @@ void manifest_flash_v2_testing_iterate_manifest_toc_mocked_hash (CuTest *test,
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Set expectations on mocks for v2 manifest verification when the table of contents will be cached.
+ *
+ * @param test The testing framework.
+ * @param manifest The components for the test.
+ * @param data Manifest data for the test.
+ * @param sig_result Result of the signature verification call.
+ */
+void manifest_flash_v2_testing_verify_manifest_toc_cache (CuTest *test,
+	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
+	int sig_result)
+{
+	uint32_t toc_entry_offset = MANIFEST_V2_TOC_ENTRY_OFFSET;
+	const uint8_t *plat_id = data->raw + data->plat_id_offset + MANIFEST_V2_PLATFORM_HEADER_SIZE;
+	uint32_t validate_start = data->toc_hash_offset + data->toc_hash_len;
+	uint32_t validate_end = data->plat_id_offset;
+	uint32_t validate_resume =
+		data->plat_id_offset + MANIFEST_V2_PLATFORM_HEADER_SIZE + data->plat_id_str_len;
+	int status;
+
+	/* Read manifest header. */
+	status = mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr), MOCK_ARG_NOT_NULL, MOCK_ARG (MANIFEST_V2_HEADER_SIZE));
+	status |= mock_expect_output (&manifest->flash.mock, 1, data->raw, data->length, 2);
+
+	/* Read manifest signature. */
+	status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr + data->sig_offset), MOCK_ARG_NOT_NULL, MOCK_ARG (data->sig_len));
+	status |= mock_expect_output (&manifest->flash.mock, 1, data->signature, data->sig_len, 2);
+
+	/* Read table of contents header. */
+	status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr + MANIFEST_V2_TOC_HDR_OFFSET), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (MANIFEST_V2_TOC_HEADER_SIZE));
+	status |= mock_expect_output (&manifest->flash.mock, 1, data->toc,
+		data->length - MANIFEST_V2_TOC_HDR_OFFSET, 2);
+
+	/* Read the entire table of contents into the cache. */
+	status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr + toc_entry_offset), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (data->toc_hash_offset - toc_entry_offset));
+	status |= mock_expect_output (&manifest->flash.mock, 1, data->raw + toc_entry_offset,
+		data->length - toc_entry_offset, 2);
+
+	/* Read table of contents hash. */
+	status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr + data->toc_hash_offset), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (data->toc_hash_len));
+	status |= mock_expect_output (&manifest->flash.mock, 1, data->toc_hash,
+		data->length - data->toc_hash_offset, 2);
+
+	status |= flash_mock_expect_verify_flash (&manifest->flash, manifest->addr + validate_start,
+		data->raw + validate_start, validate_end - validate_start);
+
+	/* Read the platform ID header. */
+	status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr + data->plat_id_offset), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (MANIFEST_V2_PLATFORM_HEADER_SIZE));
+	status |= mock_expect_output (&manifest->flash.mock, 1, data->plat_id,
+		data->length - data->plat_id_offset, 2);
+
+	/* Read the platform ID string. */
+	status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr + data->plat_id_offset + MANIFEST_V2_PLATFORM_HEADER_SIZE),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (data->plat_id_str_len));
+	status |= mock_expect_output (&manifest->flash.mock, 1, plat_id,
+		data->length - data->plat_id_offset + MANIFEST_V2_PLATFORM_HEADER_SIZE, 2);
+
+	status |= flash_mock_expect_verify_flash (&manifest->flash, manifest->addr + validate_resume,
+		data->raw + validate_resume, data->sig_offset - validate_resume);
+
+	status |= mock_expect (&manifest->verification.mock,
+		manifest->verification.base.verify_signature, &manifest->verification, sig_result,
+		MOCK_ARG_PTR_CONTAINS (data->hash, data->hash_len), MOCK_ARG (data->hash_len),
+		MOCK_ARG_PTR_CONTAINS (data->signature, data->sig_len), MOCK_ARG (data->sig_len));
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set expectations on mocks for reading an element from a v2 manifest when the table of contents
+ * has been cached.  Only the element data will be read from flash.
+ *
+ * @param test The testing framework.
+ * @param manifest The components for the test.
+ * @param data Manifest data for the test.
+ * @param hash_id The hash index of the element.
+ * @param offset Address offset of the element to read.
+ * @param length Length of the element data.
+ * @param read_len Maximum length of the element data to read.
+ * @param read_offset Offset to starting reading the element data.
+ */
+void manifest_flash_v2_testing_read_element_toc_cache (CuTest *test,
+	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
+	int hash_id, uint32_t offset, size_t length, size_t read_len, uint32_t read_offset)
+{
+	int status = 0;
+
+	if ((read_offset >= length) || (read_len == 0)) {
+		return;
+	}
+
+	if (read_offset != 0) {
+		if (hash_id >= 0) {
+			status |= flash_mock_expect_verify_flash (&manifest->flash, manifest->addr + offset,
+				data->raw + offset, read_offset);
+		}
+
+		length -= read_offset;
+		offset += read_offset;
+	}
+	if (length < read_len) {
+		read_len = length;
+	}
+
+	status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash, 0,
+		MOCK_ARG (manifest->addr + offset), MOCK_ARG_NOT_NULL, MOCK_ARG (read_len));
+	status |= mock_expect_output (&manifest->flash.mock, 1, data->raw + offset,
+		data->length - offset, 2);
+
+	if ((hash_id >= 0) && (read_len < length)) {
+		status |= flash_mock_expect_verify_flash (&manifest->flash,
+			manifest->addr + offset + read_len, data->raw + offset + read_len, length - read_len);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a manifest for testing with a table of contents cache and run verification.
+ *
+ * @param test The testing framework.
+ * @param manifest The testing components to initialize.
+ * @param address The base address for the manifest data.
+ * @param magic_v1 The manifest v1 type identifier.
+ * @param magic_v2 The manifest v2 type identifier.
+ * @param data Manifest data for the test.
+ * @param toc_cache Buffer to use for the table of contents cache.
+ * @param cache_length Length of the table of contents cache.
+ * @param sig_result Result of the signature verification call.
+ */
+static void manifest_flash_v2_testing_init_and_verify_toc_cache (CuTest *test,
+	struct manifest_flash_v2_testing *manifest, uint32_t address, uint16_t magic_v1,
+	uint16_t magic_v2, const struct manifest_v2_testing_data *data, uint8_t *toc_cache,
+	size_t cache_length, int sig_result)
+{
+	int status;
+
+	manifest_flash_v2_testing_init (test, manifest, address, magic_v1, magic_v2);
+
+	status = manifest_flash_enable_toc_cache (&manifest->test, toc_cache, cache_length);
+	CuAssertIntEquals (test, 0, status);
+
+	if (cache_length >= (data->toc_hash_offset - MANIFEST_V2_TOC_ENTRY_OFFSET)) {
+		manifest_flash_v2_testing_verify_manifest_toc_cache (test, manifest, data, sig_result);
+	}
+	else {
+		manifest_flash_v2_testing_verify_manifest (test, manifest, data, sig_result);
+	}
+
+	status = manifest_flash_verify (&manifest->test, &manifest->hash.base,
+		&manifest->verification.base, NULL, 0);
+	CuAssertIntEquals (test, sig_result, status);
+
+	status = mock_validate (&manifest->flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manifest->verification.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
 /*******************
  * Test cases
  *******************/
@@ -7756,6 +7927,186 @@ static void manifest_flash_v2_test_read_element_data_finish_element_hash_error (
 	manifest_flash_v2_testing_validate_and_release (test, &manifest);
 }
 
+static void manifest_flash_v2_test_enable_toc_cache_null (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (4, 4, SHA256_HASH_LENGTH)];
+	int status;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init (test, &manifest, 0x10000, PFM_MAGIC_NUM, PFM_V2_MAGIC_NUM);
+
+	status = manifest_flash_enable_toc_cache (NULL, toc_cache, sizeof (toc_cache));
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	status = manifest_flash_enable_toc_cache (&manifest.test, NULL, sizeof (toc_cache));
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	status = manifest_flash_enable_toc_cache (&manifest.test, toc_cache, 0);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_cache (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (MANIFEST_MAX_ENTRIES, MANIFEST_MAX_ENTRIES,
+		SHA512_HASH_LENGTH)];
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	size_t total = 0;
+	uint8_t format = 0xff;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify_toc_cache (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, toc_cache, sizeof (toc_cache), 0);
+
+	/* Only the element data should be read from flash. */
+	status = mock_expect (&manifest.flash.mock, manifest.flash.base.read, &manifest.flash, 0,
+		MOCK_ARG (manifest.addr + PFM_V2.manifest.plat_id_offset), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (buffer)));
+	status |= mock_expect_output (&manifest.flash.mock, 1,
+		PFM_V2.manifest.raw + PFM_V2.manifest.plat_id_offset,
+		PFM_V2.manifest.length - PFM_V2.manifest.plat_id_offset, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, 0, MANIFEST_NO_PARENT, 0, &found, &format, &total, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+	CuAssertIntEquals (test, 1, format);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, total);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_cache_not_found (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (MANIFEST_MAX_ENTRIES, MANIFEST_MAX_ENTRIES,
+		SHA512_HASH_LENGTH)];
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify_toc_cache (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, toc_cache, sizeof (toc_cache), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry + 1, MANIFEST_NO_PARENT, 0, NULL,
+		NULL, NULL, &element, sizeof (buffer));
+	CuAssertIntEquals (test, MANIFEST_ELEMENT_NOT_FOUND, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_cache_too_small (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	uint8_t toc_cache[MANIFEST_V2_TOC_ENTRY_SIZE];
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	size_t total = 0;
+	uint8_t format = 0xff;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify_toc_cache (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, toc_cache, sizeof (toc_cache), 0);
+
+	manifest_flash_v2_testing_read_element (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, 0, MANIFEST_NO_PARENT, 0, &found, &format, &total, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+	CuAssertIntEquals (test, 1, format);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, total);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_cache_invalidated (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (MANIFEST_MAX_ENTRIES, MANIFEST_MAX_ENTRIES,
+		SHA512_HASH_LENGTH)];
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	size_t total = 0;
+	uint8_t format = 0xff;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify_toc_cache (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, toc_cache, sizeof (toc_cache), 0);
+
+	manifest_flash_invalidate_toc_cache (&manifest.test);
+
+	manifest_flash_v2_testing_read_element (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, 0, MANIFEST_NO_PARENT, 0, &found, &format, &total, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+	CuAssertIntEquals (test, 1, format);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, total);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_cache_bad_signature (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (MANIFEST_MAX_ENTRIES, MANIFEST_MAX_ENTRIES,
+		SHA512_HASH_LENGTH)];
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify_toc_cache (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, toc_cache, sizeof (toc_cache),
+		SIG_VERIFICATION_BAD_SIGNATURE);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, 0, MANIFEST_NO_PARENT, 0, NULL, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, MANIFEST_NO_MANIFEST, status);
+	CuAssertIntEquals (test, false, manifest.test.toc_cache_valid);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
 static void manifest_flash_v2_test_compare_platform_id_equal (CuTest *test)
 {
 	struct manifest_flash_v2_testing manifest1;
@@ -8735,6 +9086,31 @@ static void manifest_flash_v2_test_get_child_elements_info_toc_invalid (CuTest *
 	manifest_flash_v2_testing_validate_and_release (test, &manifest);
 }
 
+static void manifest_flash_v2_test_get_child_elements_info_toc_cache (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (MANIFEST_MAX_ENTRIES, MANIFEST_MAX_ENTRIES,
+		SHA512_HASH_LENGTH)];
+	size_t child_len;
+	int num_child;
+	int entry;
+	int status;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify_toc_cache (test, &manifest, 0x10000, CFM_MAGIC_NUM,
+		CFM_V2_MAGIC_NUM, &CFM_TESTING.manifest, toc_cache, sizeof (toc_cache), 0);
+
+	status = manifest_flash_get_child_elements_info (&manifest.test, &manifest.hash.base, 2,
+		CFM_COMPONENT_DEVICE, MANIFEST_NO_PARENT, CFM_PMR_DIGEST, &child_len, &num_child, &entry);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, num_child);
+	CuAssertIntEquals (test, 5, entry);
+	CuAssertIntEquals (test, 0x68, child_len);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
 
 TEST_SUITE_START (manifest_flash_v2);
 
@@ -8903,6 +9279,12 @@ TEST (manifest_flash_v2_test_read_element_data_element_read_error);
 TEST (manifest_flash_v2_test_read_element_data_element_hash_error);
 TEST (manifest_flash_v2_test_read_element_data_extra_element_data_read_error);
 TEST (manifest_flash_v2_test_read_element_data_finish_element_hash_error);
+TEST (manifest_flash_v2_test_enable_toc_cache_null);
+TEST (manifest_flash_v2_test_read_element_data_toc_cache);
+TEST (manifest_flash_v2_test_read_element_data_toc_cache_not_found);
+TEST (manifest_flash_v2_test_read_element_data_toc_cache_too_small);
+TEST (manifest_flash_v2_test_read_element_data_toc_cache_invalidated);
+TEST (manifest_flash_v2_test_read_element_data_toc_cache_bad_signature);
 TEST (manifest_flash_v2_test_compare_platform_id_equal);
 TEST (manifest_flash_v2_test_compare_platform_id_sku_upgrade);
 TEST (manifest_flash_v2_test_compare_platform_id_sku_upgrade_not_permitted);
@@ -8940,5 +9322,6 @@ TEST (manifest_flash_v2_test_get_child_elements_info_hash_update_entry_fail);
 TEST (manifest_flash_v2_test_get_child_elements_info_toc_after_last_entry_hash_update_fail);
 TEST (manifest_flash_v2_test_get_child_elements_info_hash_finish_fail);
 TEST (manifest_flash_v2_test_get_child_elements_info_toc_invalid);
+TEST (manifest_flash_v2_test_get_child_elements_info_toc_cache);
 
 TEST_SUITE_END;
@@ -43,6 +43,9 @@ void manifest_flash_v2_testing_verify_manifest (CuTest *test,
 void manifest_flash_v2_testing_verify_manifest_mocked_hash (CuTest *test,
 	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
 	int sig_result, int hash_result);
+void manifest_flash_v2_testing_verify_manifest_toc_cache (CuTest *test,
+	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
+	int sig_result);
 
 void manifest_flash_v2_testing_read_element (CuTest *test,
 	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
@@ -60,6 +63,9 @@ void manifest_flash_v2_testing_read_element_mocked_hash_bad_entry (CuTest *test,
 	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
 	int entry, int start, int hash_id, uint32_t offset, size_t length, size_t read_len,
 	uint32_t read_offset, struct manifest_toc_entry *element_entry, uint8_t *element_data);
+void manifest_flash_v2_testing_read_element_toc_cache (CuTest *test,
+	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
+	int hash_id, uint32_t offset, size_t length, size_t read_len, uint32_t read_offset);
 
 void manifest_flash_v2_testing_iterate_manifest_toc (CuTest *test,
 	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
@@ -3384,19 +3384,7 @@ static void pfm_flash_test_get_read_write_regions_multiple_regions (CuTest *test
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset1,
 		sizeof (pfm_data) - reg_offset1,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset1, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset2,
-		sizeof (pfm_data) - reg_offset2,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset2, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset3,
-		sizeof (pfm_data) - reg_offset3,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset3, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset1, 0, -1, PFM_REGION_SIZE * 3));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -3914,12 +3902,6 @@ static void pfm_flash_test_get_read_write_regions_region_read_error (CuTest *tes
 		FLASH_EXP_READ_CMD (0x03, 0x10000 + ver_offset + PFM_FW_HEADER_SIZE, 0, -1,
 			strlen (version)));
 
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset1,
-		sizeof (pfm_data) - reg_offset1,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset1, 0, -1, PFM_REGION_SIZE));
-
 	status |= flash_master_mock_expect_xfer (&pfm.flash_mock, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
@@ -4802,19 +4784,7 @@ static void pfm_flash_test_get_firmware_images_multiple_regions (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset1,
 		sizeof (pfm_data) - reg_offset1,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset1, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset2,
-		sizeof (pfm_data) - reg_offset2,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset2, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset3,
-		sizeof (pfm_data) - reg_offset3,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset3, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset1, 0, -1, PFM_REGION_SIZE * 3));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5039,19 +5009,7 @@ static void pfm_flash_test_get_firmware_images_multiple_images (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset11,
 		sizeof (pfm_data) - reg_offset11,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset12,
-		sizeof (pfm_data) - reg_offset12,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset12, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset13,
-		sizeof (pfm_data) - reg_offset13,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset13, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE * 3));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5069,13 +5027,7 @@ static void pfm_flash_test_get_firmware_images_multiple_images (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset21,
 		sizeof (pfm_data) - reg_offset21,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset22,
-		sizeof (pfm_data) - reg_offset22,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset22, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE * 2));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5093,25 +5045,7 @@ static void pfm_flash_test_get_firmware_images_multiple_images (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset31,
 		sizeof (pfm_data) - reg_offset31,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset32,
-		sizeof (pfm_data) - reg_offset32,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset32, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset33,
-		sizeof (pfm_data) - reg_offset33,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset33, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset34,
-		sizeof (pfm_data) - reg_offset34,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset34, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE * 4));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5384,19 +5318,7 @@ static void pfm_flash_test_get_firmware_images_multiple_keys (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset11,
 		sizeof (pfm_data) - reg_offset11,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset12,
-		sizeof (pfm_data) - reg_offset12,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset12, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset13,
-		sizeof (pfm_data) - reg_offset13,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset13, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE * 3));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5414,13 +5336,7 @@ static void pfm_flash_test_get_firmware_images_multiple_keys (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset21,
 		sizeof (pfm_data) - reg_offset21,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset22,
-		sizeof (pfm_data) - reg_offset22,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset22, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE * 2));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5438,25 +5354,7 @@ static void pfm_flash_test_get_firmware_images_multiple_keys (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset31,
 		sizeof (pfm_data) - reg_offset31,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset32,
-		sizeof (pfm_data) - reg_offset32,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset32, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset33,
-		sizeof (pfm_data) - reg_offset33,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset33, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset34,
-		sizeof (pfm_data) - reg_offset34,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset34, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE * 4));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5753,19 +5651,7 @@ static void pfm_flash_test_get_firmware_images_key_id_matches_length (CuTest *te
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset11,
 		sizeof (pfm_data) - reg_offset11,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset12,
-		sizeof (pfm_data) - reg_offset12,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset12, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset13,
-		sizeof (pfm_data) - reg_offset13,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset13, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE * 3));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5783,13 +5669,7 @@ static void pfm_flash_test_get_firmware_images_key_id_matches_length (CuTest *te
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset21,
 		sizeof (pfm_data) - reg_offset21,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset22,
-		sizeof (pfm_data) - reg_offset22,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset22, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE * 2));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -5807,25 +5687,7 @@ static void pfm_flash_test_get_firmware_images_key_id_matches_length (CuTest *te
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset31,
 		sizeof (pfm_data) - reg_offset31,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset32,
-		sizeof (pfm_data) - reg_offset32,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset32, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset33,
-		sizeof (pfm_data) - reg_offset33,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset33, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset34,
-		sizeof (pfm_data) - reg_offset34,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset34, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE * 4));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -6122,19 +5984,7 @@ static void pfm_flash_test_get_firmware_images_unused_key (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset11,
 		sizeof (pfm_data) - reg_offset11,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset12,
-		sizeof (pfm_data) - reg_offset12,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset12, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset13,
-		sizeof (pfm_data) - reg_offset13,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset13, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE * 3));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -6152,13 +6002,7 @@ static void pfm_flash_test_get_firmware_images_unused_key (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset21,
 		sizeof (pfm_data) - reg_offset21,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset22,
-		sizeof (pfm_data) - reg_offset22,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset22, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE * 2));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -6176,25 +6020,7 @@ static void pfm_flash_test_get_firmware_images_unused_key (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset31,
 		sizeof (pfm_data) - reg_offset31,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset32,
-		sizeof (pfm_data) - reg_offset32,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset32, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset33,
-		sizeof (pfm_data) - reg_offset33,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset33, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset34,
-		sizeof (pfm_data) - reg_offset34,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset34, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE * 4));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -6479,19 +6305,7 @@ static void pfm_flash_test_get_firmware_images_no_matching_key (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset11,
 		sizeof (pfm_data) - reg_offset11,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset12,
-		sizeof (pfm_data) - reg_offset12,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset12, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset13,
-		sizeof (pfm_data) - reg_offset13,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset13, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE * 3));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -6509,13 +6323,7 @@ static void pfm_flash_test_get_firmware_images_no_matching_key (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset21,
 		sizeof (pfm_data) - reg_offset21,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset22,
-		sizeof (pfm_data) - reg_offset22,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset22, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE * 2));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -6533,25 +6341,7 @@ static void pfm_flash_test_get_firmware_images_no_matching_key (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset31,
 		sizeof (pfm_data) - reg_offset31,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset32,
-		sizeof (pfm_data) - reg_offset32,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset32, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset33,
-		sizeof (pfm_data) - reg_offset33,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset33, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset34,
-		sizeof (pfm_data) - reg_offset34,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset34, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE * 4));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -7251,19 +7041,7 @@ static void pfm_flash_test_get_firmware_images_key_read_error (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset11,
 		sizeof (pfm_data) - reg_offset11,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset12,
-		sizeof (pfm_data) - reg_offset12,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset12, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset13,
-		sizeof (pfm_data) - reg_offset13,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset13, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset11, 0, -1, PFM_REGION_SIZE * 3));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -7281,13 +7059,7 @@ static void pfm_flash_test_get_firmware_images_key_read_error (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset21,
 		sizeof (pfm_data) - reg_offset21,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset22,
-		sizeof (pfm_data) - reg_offset22,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset22, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset21, 0, -1, PFM_REGION_SIZE * 2));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
@@ -7305,25 +7077,7 @@ static void pfm_flash_test_get_firmware_images_key_read_error (CuTest *test)
 		FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset31,
 		sizeof (pfm_data) - reg_offset31,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset32,
-		sizeof (pfm_data) - reg_offset32,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset32, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset33,
-		sizeof (pfm_data) - reg_offset33,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset33, 0, -1, PFM_REGION_SIZE));
-
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, pfm_data + reg_offset34,
-		sizeof (pfm_data) - reg_offset34,
-		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset34, 0, -1, PFM_REGION_SIZE));
+		FLASH_EXP_READ_CMD (0x03, 0x10000 + reg_offset31, 0, -1, PFM_REGION_SIZE * 4));
 
 	status |= flash_master_mock_expect_rx_xfer (&pfm.flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
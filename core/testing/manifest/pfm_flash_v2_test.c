@@ -6059,6 +6059,44 @@ static void pfm_flash_v2_testing_init_and_verify (CuTest *test, struct pfm_flash
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Initialize a PFM for testing with a table of contents cache.  Run verification to load the PFM
+ * information.
+ *
+ * @param test The testing framework.
+ * @param pfm The testing components to initialize.
+ * @param address The base address for the manifest data.
+ * @param data Manifest data for the test.
+ * @param toc_cache Buffer to use for the table of contents cache.
+ * @param cache_length Length of the table of contents cache.
+ */
+static void pfm_flash_v2_testing_init_and_verify_toc_cache (CuTest *test,
+	struct pfm_flash_v2_testing *pfm, uint32_t address, const struct pfm_v2_testing_data *data,
+	uint8_t *toc_cache, size_t cache_length)
+{
+	int status;
+
+	pfm_flash_v2_testing_init (test, pfm, address);
+
+	status = manifest_flash_enable_toc_cache (&pfm->test.base_flash, toc_cache, cache_length);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_verify_manifest_toc_cache (test, &pfm->manifest, &data->manifest, 0);
+	manifest_flash_v2_testing_read_element_toc_cache (test, &pfm->manifest, &data->manifest,
+		data->flash_dev_hash, data->flash_dev_offset, data->flash_dev_len, PFM_V2_FLASH_DEV_SIZE, 0);
+
+	status = pfm->test.base.base.verify (&pfm->test.base.base, &pfm->manifest.hash.base,
+		&pfm->manifest.verification.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, pfm->test.base_flash.toc_cache_valid);
+
+	status = mock_validate (&pfm->manifest.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&pfm->manifest.verification.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
 /**
  * Set up expectations for searching a manifest for a specific firmware element.
  *
@@ -6938,6 +6976,51 @@ static void pfm_flash_v2_test_get_firmware_multiple (CuTest *test)
 	pfm_flash_v2_testing_validate_and_release (test, &pfm);
 }
 
+static void pfm_flash_v2_test_get_firmware_multiple_toc_cache (CuTest *test)
+{
+	struct pfm_flash_v2_testing pfm;
+	const struct pfm_v2_testing_data *test_pfm = &PFM_V2_THREE_FW_NO_VER;
+	uint8_t toc_cache[MANIFEST_FLASH_TOC_CACHE_SIZE (MANIFEST_MAX_ENTRIES, MANIFEST_MAX_ENTRIES,
+		SHA512_HASH_LENGTH)];
+	int status;
+	struct pfm_firmware fw;
+	int i;
+	int j;
+
+	TEST_START;
+
+	pfm_flash_v2_testing_init_and_verify_toc_cache (test, &pfm, 0x10000, test_pfm, toc_cache,
+		sizeof (toc_cache));
+
+	/* Each lookup only reads the element data.  The table of contents is not read again. */
+	for (j = 0; j < 2; j++) {
+		for (i = 0; i < test_pfm->fw_count; i++) {
+			manifest_flash_v2_testing_read_element_toc_cache (test, &pfm.manifest,
+				&test_pfm->manifest, test_pfm->fw[i].fw_hash, test_pfm->fw[i].fw_offset,
+				test_pfm->fw[i].fw_len, test_pfm->fw[i].fw_len, 0);
+		}
+
+		memset (&fw, 0, sizeof (fw));
+
+		status = pfm.test.base.get_firmware (&pfm.test.base, &fw);
+		CuAssertIntEquals (test, 0, status);
+		CuAssertIntEquals (test, test_pfm->fw_count, fw.count);
+		CuAssertPtrNotNull (test, fw.ids);
+
+		for (i = 0; i < test_pfm->fw_count; i++) {
+			CuAssertPtrNotNull (test, fw.ids[i]);
+			CuAssertStrEquals (test, test_pfm->fw[i].fw_id_str, fw.ids[i]);
+		}
+
+		pfm.test.base.free_firmware (&pfm.test.base, &fw);
+
+		status = mock_validate (&pfm.manifest.flash.mock);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	pfm_flash_v2_testing_validate_and_release (test, &pfm);
+}
+
 static void pfm_flash_v2_test_get_firmware_no_flash_dev_element (CuTest *test)
 {
 	struct pfm_flash_v2_testing pfm;
@@ -12501,6 +12584,7 @@ TEST (pfm_flash_v2_test_get_signature);
 TEST (pfm_flash_v2_test_get_signature_null);
 TEST (pfm_flash_v2_test_get_firmware);
 TEST (pfm_flash_v2_test_get_firmware_multiple);
+TEST (pfm_flash_v2_test_get_firmware_multiple_toc_cache);
 TEST (pfm_flash_v2_test_get_firmware_no_flash_dev_element);
 TEST (pfm_flash_v2_test_get_firmware_no_firmware_entries);
 TEST (pfm_flash_v2_test_get_firmware_null);
@@ -1943,6 +1943,226 @@ static void mctp_base_protocol_test_construct_invalid_buf_len (CuTest *test)
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BAD_BUFFER_LENGTH, status);
 }
 
+static void mctp_base_protocol_test_construct_header (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_header)];
+	uint8_t pec;
+	uint8_t expected[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+	int expected_len;
+
+	TEST_START;
+
+	buf[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	buf[1] = 0xAA;
+	buf[2] = 0xBB;
+	buf[3] = 0xCC;
+	buf[4] = 0xDD;
+	buf[5] = 0xEE;
+
+	expected_len = mctp_base_protocol_construct (buf, sizeof (buf), expected, sizeof (expected),
+		0x55, 0x0A, 0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PACKET_OVERHEAD + sizeof (buf), expected_len);
+
+	status = mctp_base_protocol_construct_header (buf, sizeof (buf), header, sizeof (header), &pec,
+		0x55, 0x0A, 0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, sizeof (header), status);
+	CuAssertIntEquals (test, expected[expected_len - 1], pec);
+
+	status = testing_validate_array (expected, header, sizeof (header));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The payload must not be modified. */
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, buf[0]);
+	CuAssertIntEquals (test, 0xEE, buf[5]);
+}
+
+static void mctp_base_protocol_test_construct_header_eom (CuTest *test)
+{
+	int status;
+	uint8_t buf[MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_header)];
+	uint8_t pec;
+	uint8_t expected[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+	int expected_len;
+	size_t i;
+
+	TEST_START;
+
+	for (i = 0; i < sizeof (buf); i++) {
+		buf[i] = i;
+	}
+
+	expected_len = mctp_base_protocol_construct (buf, sizeof (buf), expected, sizeof (expected),
+		0x55, 0x0A, 0x0B, false, true, 3, 5, MCTP_BASE_PROTOCOL_TO_REQUEST, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN, expected_len);
+
+	status = mctp_base_protocol_construct_header (buf, sizeof (buf), header, sizeof (header), &pec,
+		0x55, 0x0A, 0x0B, false, true, 3, 5, MCTP_BASE_PROTOCOL_TO_REQUEST, 0x5D);
+	CuAssertIntEquals (test, sizeof (header), status);
+	CuAssertIntEquals (test, expected[expected_len - 1], pec);
+
+	status = testing_validate_array (expected, header, sizeof (header));
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void mctp_base_protocol_test_construct_header_buf_too_small (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_header)];
+	uint8_t pec;
+
+	TEST_START;
+
+	status = mctp_base_protocol_construct_header (buf, sizeof (buf), header, sizeof (header) - 1,
+		&pec, 0x55, 0x0A, 0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BUF_TOO_SMALL, status);
+}
+
+static void mctp_base_protocol_test_construct_header_null (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_header)];
+	uint8_t pec;
+
+	TEST_START;
+
+	status = mctp_base_protocol_construct_header (NULL, sizeof (buf), header, sizeof (header), &pec,
+		0x55, 0x0A, 0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_base_protocol_construct_header (buf, sizeof (buf), NULL, sizeof (header), &pec,
+		0x55, 0x0A, 0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_base_protocol_construct_header (buf, sizeof (buf), header, sizeof (header), NULL,
+		0x55, 0x0A, 0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+}
+
+static void mctp_base_protocol_test_construct_header_invalid_buf_len (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_header)];
+	uint8_t pec;
+
+	TEST_START;
+
+	status = mctp_base_protocol_construct_header (buf, 0, header, sizeof (header), &pec, 0x55, 0x0A,
+		0x0B, true, false, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BAD_BUFFER_LENGTH, status);
+
+	status = mctp_base_protocol_construct_header (buf, MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT + 1,
+		header, sizeof (header), &pec, 0x55, 0x0A, 0x0B, true, false, 1, 2,
+		MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BAD_BUFFER_LENGTH, status);
+}
+
+static void mctp_base_protocol_test_construct_header_i3c (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_i3c_header)];
+	uint8_t pec;
+	uint8_t expected[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+	int expected_len;
+
+	TEST_START;
+
+	buf[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	buf[1] = 0xAA;
+	buf[2] = 0xBB;
+	buf[3] = 0xCC;
+	buf[4] = 0xDD;
+	buf[5] = 0xEE;
+
+	expected_len = mctp_base_protocol_construct_i3c (buf, sizeof (buf), expected,
+		sizeof (expected), 0x55, 0x0A, 0x0B, true, true, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE,
+		0x5D, false);
+	CuAssertIntEquals (test, sizeof (header) + sizeof (buf) + 1, expected_len);
+
+	status = mctp_base_protocol_construct_header_i3c (buf, sizeof (buf), header, sizeof (header),
+		&pec, 0x55, 0x0A, 0x0B, true, true, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D, false);
+	CuAssertIntEquals (test, sizeof (header), status);
+	CuAssertIntEquals (test, expected[expected_len - 1], pec);
+
+	status = testing_validate_array (expected, header, sizeof (header));
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void mctp_base_protocol_test_construct_header_i3c_target (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_i3c_header)];
+	uint8_t pec;
+	uint8_t expected[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+	int expected_len;
+
+	TEST_START;
+
+	buf[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	buf[1] = 0xAA;
+	buf[2] = 0xBB;
+	buf[3] = 0xCC;
+	buf[4] = 0xDD;
+	buf[5] = 0xEE;
+
+	expected_len = mctp_base_protocol_construct_i3c (buf, sizeof (buf), expected,
+		sizeof (expected), 0x55, 0x0A, 0x0B, false, true, 2, 3, MCTP_BASE_PROTOCOL_TO_RESPONSE,
+		0x5D, true);
+	CuAssertIntEquals (test, sizeof (header) + sizeof (buf) + 1, expected_len);
+
+	status = mctp_base_protocol_construct_header_i3c (buf, sizeof (buf), header, sizeof (header),
+		&pec, 0x55, 0x0A, 0x0B, false, true, 2, 3, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D, true);
+	CuAssertIntEquals (test, sizeof (header), status);
+	CuAssertIntEquals (test, expected[expected_len - 1], pec);
+
+	status = testing_validate_array (expected, header, sizeof (header));
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void mctp_base_protocol_test_construct_header_i3c_null (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_i3c_header)];
+	uint8_t pec;
+
+	TEST_START;
+
+	status = mctp_base_protocol_construct_header_i3c (NULL, sizeof (buf), header, sizeof (header),
+		&pec, 0x55, 0x0A, 0x0B, true, true, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D, false);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_base_protocol_construct_header_i3c (buf, sizeof (buf), NULL, sizeof (header),
+		&pec, 0x55, 0x0A, 0x0B, true, true, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D, false);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_base_protocol_construct_header_i3c (buf, sizeof (buf), header, sizeof (header),
+		NULL, 0x55, 0x0A, 0x0B, true, true, 1, 2, MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D, false);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+}
+
+static void mctp_base_protocol_test_construct_header_i3c_buf_too_small (CuTest *test)
+{
+	int status;
+	uint8_t buf[6];
+	uint8_t header[sizeof (struct mctp_base_protocol_transport_i3c_header)];
+	uint8_t pec;
+
+	TEST_START;
+
+	status = mctp_base_protocol_construct_header_i3c (buf, sizeof (buf), header,
+		sizeof (header) - 1, &pec, 0x55, 0x0A, 0x0B, true, true, 1, 2,
+		MCTP_BASE_PROTOCOL_TO_RESPONSE, 0x5D, false);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BUF_TOO_SMALL, status);
+}
+
 
 TEST_SUITE_START (mctp_base_protocol);
 
@@ -1987,5 +2207,14 @@ TEST (mctp_base_protocol_test_construct_vendor_defined_message_buf_too_small);
 TEST (mctp_base_protocol_test_construct_spdm_response_buf_too_small);
 TEST (mctp_base_protocol_test_construct_null);
 TEST (mctp_base_protocol_test_construct_invalid_buf_len);
+TEST (mctp_base_protocol_test_construct_header);
+TEST (mctp_base_protocol_test_construct_header_eom);
+TEST (mctp_base_protocol_test_construct_header_buf_too_small);
+TEST (mctp_base_protocol_test_construct_header_null);
+TEST (mctp_base_protocol_test_construct_header_invalid_buf_len);
+TEST (mctp_base_protocol_test_construct_header_i3c);
+TEST (mctp_base_protocol_test_construct_header_i3c_target);
+TEST (mctp_base_protocol_test_construct_header_i3c_null);
+TEST (mctp_base_protocol_test_construct_header_i3c_buf_too_small);
 
 TEST_SUITE_END;
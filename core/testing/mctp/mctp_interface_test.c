@@ -35,6 +35,16 @@ TEST_SUITE_LABEL ("mctp_interface");
  */
 #define	MCTP_ERROR_MSG_LENGTH	(MCTP_HEADER_LENGTH + sizeof (struct cerberus_protocol_error) + 1)
 
+/**
+ * EID of an additional endpoint used for testing concurrent message reassembly.
+ */
+#define	MCTP_INTERFACE_TESTING_HOST_EID		0x20
+
+/**
+ * Number of reassembly contexts used for testing.
+ */
+#define	MCTP_INTERFACE_TESTING_CONTEXTS		2
+
 
 /**
  * Dependencies for testing the MCTP interface.
@@ -46,6 +56,11 @@ struct mctp_interface_testing {
 	struct cmd_interface_mock cmd_spdm;				/**< Command interface for SPDM protocol mock instance. */
 	struct device_manager device_mgr;				/**< Device manager. */
 	struct mctp_interface mctp;						/**< MCTP interface instance */
+	struct mctp_interface_reassembly_context contexts[MCTP_INTERFACE_TESTING_CONTEXTS];	/**< Reassembly contexts. */
+	uint8_t reassembly[MCTP_INTERFACE_TESTING_CONTEXTS * MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT];	/**< Reassembly buffer. */
+	struct cmd_packet_sg sg_packets[2];				/**< Scatter/gather packets for responses. */
+	struct cmd_dispatch dispatch;					/**< Queue for dispatched requests. */
+	struct cmd_dispatch_request dispatch_requests[1];	/**< Requests for the dispatch queue. */
 };
 
 /**
@@ -153,6 +168,173 @@ static void setup_mctp_interface_with_interface_mock_test_no_mctp_bridge (CuTest
 	setup_mctp_interface_with_interface_mock_test_common (test, mctp, spdm_supported);
 }
 
+/**
+ * Helper function to setup the MCTP interface to use mock instances and a pool of reassembly
+ * contexts.  The device manager contains an additional entry for a second requester.
+ *
+ * @param test The test framework.
+ * @param mctp The instances to initialize for testing.
+ * @param count The number of reassembly contexts to use.
+ * @param timeout_ms The reassembly timeout to use.
+ */
+static void setup_mctp_interface_with_reassembly_contexts_test (CuTest *test,
+	struct mctp_interface_testing *mctp, size_t count, uint32_t timeout_ms)
+{
+	int status;
+
+	status = device_manager_init (&mctp->device_mgr, 3, 0, DEVICE_MANAGER_AC_ROT_MODE,
+		DEVICE_MANAGER_SLAVE_BUS_ROLE, 1000, 1000, 1000, 0, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&mctp->device_mgr, 0,
+		MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, 0x5D, DEVICE_MANAGER_NOT_PCD_COMPONENT);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&mctp->device_mgr, 1,
+		MCTP_BASE_PROTOCOL_BMC_EID, 0x51, DEVICE_MANAGER_NOT_PCD_COMPONENT);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_update_not_attestable_device_entry (&mctp->device_mgr, 2,
+		MCTP_INTERFACE_TESTING_HOST_EID, 0x56, DEVICE_MANAGER_NOT_PCD_COMPONENT);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_mctp_interface_with_interface_mock_test_common (test, mctp, true);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp->mctp, mctp->contexts, count,
+		mctp->reassembly, count * MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT, timeout_ms);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper function to construct a vendor defined message packet sent to the device.
+ *
+ * @param rx The packet to construct.
+ * @param source_addr The 7-bit address of the packet source.
+ * @param src_eid EID of the packet source.
+ * @param msg_tag Message tag for the packet.
+ * @param som Flag indicating the packet is the start of a message.
+ * @param eom Flag indicating the packet is the end of a message.
+ * @param packet_seq Packet sequence number.
+ * @param payload Payload for the packet.
+ * @param length Length of the packet payload.
+ */
+static void mctp_interface_testing_build_packet (struct cmd_packet *rx, uint8_t source_addr,
+	uint8_t src_eid, uint8_t msg_tag, bool som, bool eom, uint8_t packet_seq,
+	const uint8_t *payload, size_t length)
+{
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx->data;
+
+	memset (rx, 0, sizeof (*rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = MCTP_HEADER_LENGTH + length - 2;
+	header->source_addr = (source_addr << 1) | 1;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = src_eid;
+	header->som = som;
+	header->eom = eom;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = msg_tag;
+	header->packet_seq = packet_seq;
+
+	memcpy (&rx->data[MCTP_HEADER_LENGTH], payload, length);
+	rx->data[MCTP_HEADER_LENGTH + length] = checksum_crc8 (0xBA, rx->data,
+		MCTP_HEADER_LENGTH + length);
+	rx->pkt_size = MCTP_HEADER_LENGTH + length + 1;
+	rx->dest_addr = 0x5D;
+}
+
+/**
+ * Helper function to set the expectation for processing a request received by the device.
+ *
+ * @param test The test framework.
+ * @param mctp The testing instances.
+ * @param request Buffer for the expected request.  This must remain valid until the request is
+ * processed.
+ * @param data The expected request data.
+ * @param length Length of the expected request data.
+ * @param src_eid EID of the request source.
+ * @param response Buffer for the response to the request.  This must remain valid until the
+ * request is processed.
+ * @param response_data Response data to return.  This must remain valid until the request is
+ * processed.
+ * @param response_length Length of the response data.
+ */
+static void mctp_interface_testing_expect_request (CuTest *test,
+	struct mctp_interface_testing *mctp, struct cmd_interface_msg *request, uint8_t *data,
+	size_t length, uint8_t src_eid, struct cmd_interface_msg *response, uint8_t *response_data,
+	size_t response_length)
+{
+	int status;
+
+	memset (request, 0, sizeof (*request));
+	request->data = data;
+	request->length = length;
+	request->source_eid = src_eid;
+	request->target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request->crypto_timeout = false;
+	request->channel_id = 0;
+	request->max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	memset (response, 0, sizeof (*response));
+	response->data = response_data;
+	response->length = response_length;
+	response->source_eid = src_eid;
+	response->target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response->crypto_timeout = false;
+
+	status = mock_expect (&mctp->cmd_cerberus.mock, mctp->cmd_cerberus.base.process_request,
+		&mctp->cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			request, sizeof (*request), cmd_interface_mock_save_request,
+			cmd_interface_mock_free_request));
+	status |= mock_expect_output_deep_copy (&mctp->cmd_cerberus.mock, 0, response,
+		sizeof (*response), cmd_interface_mock_copy_request);
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper function to set the expectation for generating an error message.
+ *
+ * @param test The test framework.
+ * @param mctp The testing instances.
+ * @param error_packet Buffer for the generated error message.  This must remain valid until the
+ * error is generated.
+ * @param error_buffer Buffer for the error message data.  This must remain valid until the error
+ * is generated.
+ * @param error_code The expected error code.
+ * @param error_data The expected error data.
+ */
+static void mctp_interface_testing_expect_error_packet (CuTest *test,
+	struct mctp_interface_testing *mctp, struct cmd_interface_msg *error_packet,
+	uint8_t *error_buffer, uint8_t error_code, uint32_t error_data)
+{
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_buffer;
+	int status;
+
+	memset (error_packet, 0, sizeof (*error_packet));
+	error_packet->data = error_buffer;
+	error_packet->length = sizeof (struct cerberus_protocol_error);
+
+	memset (error, 0, sizeof (*error));
+	error->header.msg_type = 0x7E;
+	error->header.pci_vendor_id = 0x1414;
+	error->header.command = 0x7F;
+	error->error_code = error_code;
+	error->error_data = error_data;
+
+	status = mock_expect (&mctp->cmd_cerberus.mock, mctp->cmd_cerberus.base.generate_error_packet,
+		&mctp->cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (error_code), MOCK_ARG (error_data),
+		MOCK_ARG (0));
+	status |= mock_expect_output_deep_copy (&mctp->cmd_cerberus.mock, 0, error_packet,
+		sizeof (*error_packet), cmd_interface_mock_copy_request);
+
+	CuAssertIntEquals (test, 0, status);
+}
+
 /**
  * Helper function to complete MCTP test
  *
@@ -401,6 +583,148 @@ static void mctp_interface_test_set_channel_id_null (CuTest *test)
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
 }
 
+static void mctp_interface_test_enable_reassembly_contexts (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp.mctp, mctp.contexts,
+		MCTP_INTERFACE_TESTING_CONTEXTS, mctp.reassembly, sizeof (mctp.reassembly), 100);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, mctp.contexts, mctp.mctp.contexts);
+	CuAssertIntEquals (test, MCTP_INTERFACE_TESTING_CONTEXTS, mctp.mctp.context_count);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT,
+		mctp.mctp.context_max_length);
+	CuAssertIntEquals (test, 100, mctp.mctp.context_timeout_ms);
+
+	CuAssertPtrEquals (test, mctp.reassembly, mctp.contexts[0].data);
+	CuAssertPtrEquals (test, &mctp.reassembly[MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT],
+		mctp.contexts[1].data);
+	CuAssertIntEquals (test, 0, mctp.contexts[0].start_packet_len);
+	CuAssertIntEquals (test, 0, mctp.contexts[1].start_packet_len);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_enable_reassembly_contexts_max_message_length (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	uint8_t reassembly[(MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY * 2) + 10];
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp.mctp, mctp.contexts, 1, reassembly,
+		sizeof (reassembly), 100);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, mctp.mctp.context_count);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY, mctp.mctp.context_max_length);
+	CuAssertPtrEquals (test, reassembly, mctp.contexts[0].data);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_enable_reassembly_contexts_null (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_enable_reassembly_contexts (NULL, mctp.contexts,
+		MCTP_INTERFACE_TESTING_CONTEXTS, mctp.reassembly, sizeof (mctp.reassembly), 100);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp.mctp, NULL,
+		MCTP_INTERFACE_TESTING_CONTEXTS, mctp.reassembly, sizeof (mctp.reassembly), 100);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp.mctp, mctp.contexts, 0,
+		mctp.reassembly, sizeof (mctp.reassembly), 100);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp.mctp, mctp.contexts,
+		MCTP_INTERFACE_TESTING_CONTEXTS, NULL, sizeof (mctp.reassembly), 100);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp.mctp, mctp.contexts,
+		MCTP_INTERFACE_TESTING_CONTEXTS, mctp.reassembly, sizeof (mctp.reassembly), 0);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, mctp.mctp.contexts);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_enable_reassembly_contexts_buffer_too_small (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_enable_reassembly_contexts (&mctp.mctp, mctp.contexts,
+		MCTP_INTERFACE_TESTING_CONTEXTS, mctp.reassembly, sizeof (mctp.reassembly) - 1, 100);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BUF_TOO_SMALL, status);
+
+	CuAssertPtrEquals (test, NULL, mctp.mctp.contexts);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_enable_scatter_gather (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_enable_scatter_gather (&mctp.mctp, mctp.sg_packets, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, mctp.sg_packets, mctp.mctp.sg_packets);
+	CuAssertIntEquals (test, 2, mctp.mctp.sg_max_packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_enable_scatter_gather_null (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_enable_scatter_gather (NULL, mctp.sg_packets, 2);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_scatter_gather (&mctp.mctp, NULL, 2);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_scatter_gather (&mctp.mctp, mctp.sg_packets, 0);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, mctp.mctp.sg_packets);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
 static void mctp_interface_test_process_packet_null (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
@@ -424,6 +748,33 @@ static void mctp_interface_test_process_packet_null (CuTest *test)
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
+static void mctp_interface_test_process_packet_sg_null (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	struct cmd_message_sg *tx_sg;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_process_packet_sg (NULL, &rx, &tx, &tx_sg);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_process_packet_sg (&mctp.mctp, NULL, &tx, &tx_sg);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_process_packet_sg (&mctp.mctp, &rx, NULL, &tx_sg);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_process_packet_sg (&mctp.mctp, &rx, &tx, NULL);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
 static void mctp_interface_test_process_packet_invalid_req (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
@@ -3237,20 +3588,25 @@ static void mctp_interface_test_process_packet_two_packet_response (CuTest *test
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_channel_id_reset_next_som (CuTest *test)
+static void mctp_interface_test_process_packet_sg_two_packet_response (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
+	struct cmd_message_sg *tx_sg;
+	uint8_t packet[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
 	uint8_t data[10];
 	struct cmd_interface_msg request;
+	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT + 48];
 	struct cmd_interface_msg response;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
 	int status;
+	int first_pkt = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	int second_pkt = 48;
+	int second_pkt_total = second_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+	int response_size = first_pkt + second_pkt;
+	int i;
 
 	TEST_START;
 
@@ -3283,28 +3639,9 @@ static void mctp_interface_test_process_packet_channel_id_reset_next_som (CuTest
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
 
-	error_packet.data = error_data;
-	error_packet.length = sizeof (error_data);
-	error_packet.source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	error_packet.target_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	error_packet.crypto_timeout = false;
-	error_packet.channel_id = 1;
-	error_packet.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
-
-	error->header.msg_type = 0x7E;
-	error->header.pci_vendor_id = 0x1414;
-	error->header.crypt = 0;
-	error->header.reserved2 = 0;
-	error->header.integrity_check = 0;
-	error->header.reserved1 = 0;
-	error->header.rq = 0;
-	error->header.command = 0x7F;
-	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
-	error->error_data = 0;
-
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	status = mctp_interface_set_channel_id (&mctp.mctp, 1);
+	status = mctp_interface_enable_scatter_gather (&mctp.mctp, mctp.sg_packets, 2);
 	CuAssertIntEquals (test, 0, status);
 
 	request.data = data;
@@ -3313,11 +3650,19 @@ static void mctp_interface_test_process_packet_channel_id_reset_next_som (CuTest
 	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	request.crypto_timeout = false;
-	request.channel_id = 1;
+	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	memset (&response, 0, sizeof (response));
-	response.data = data;
+	memset (&response_data, 0, sizeof (response_data));
+	response.data = response_data;
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 1; i < response_size; i++) {
+		response.data[i] = i;
+	}
+	response.length = response_size;
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
 
 	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
 		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
@@ -3325,76 +3670,94 @@ static void mctp_interface_test_process_packet_channel_id_reset_next_som (CuTest
 			cmd_interface_mock_free_request));
 	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
-		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR),
-		MOCK_ARG (0), MOCK_ARG (0));
-	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
-		-1);
-
 	CuAssertIntEquals (test, 0, status);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	status = mctp_interface_process_packet_sg (&mctp.mctp, &rx, &tx, &tx_sg);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrNotNull (test, tx);
+	CuAssertPtrEquals (test, NULL, tx);
+	CuAssertPtrNotNull (test, tx_sg);
 
-	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
-	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
-	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+	CuAssertPtrEquals (test, mctp.sg_packets, (void*) tx_sg->packets);
+	CuAssertIntEquals (test, 2, tx_sg->num_packets);
 
-	header = (struct mctp_base_protocol_transport_header*) tx->data;
-	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	/* The packet payloads reference the response data without copying it. */
+	CuAssertPtrEquals (test, mctp.mctp.req_buffer.data, (void*) tx_sg->packets[0].payload);
+	CuAssertIntEquals (test, first_pkt, tx_sg->packets[0].payload_len);
+	CuAssertIntEquals (test, MCTP_HEADER_LENGTH, tx_sg->packets[0].header_len);
+	CuAssertIntEquals (test, 1, tx_sg->packets[0].trailer_len);
+	CuAssertIntEquals (test, 0x55, tx_sg->packets[0].dest_addr);
 
-	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
-	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
-	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
-	CuAssertIntEquals (test, 0, header->rsvd);
-	CuAssertIntEquals (test, 1, header->header_version);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	header = (struct mctp_base_protocol_transport_header*) tx_sg->packets[0].header;
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
 	CuAssertIntEquals (test, 1, header->som);
-	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, 0, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
 	CuAssertIntEquals (test, 0, header->packet_seq);
-	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
-		tx->data[tx->pkt_size - 1]);
 
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
-	CuAssertIntEquals (test, 0, error->header.crypt);
-	CuAssertIntEquals (test, 0, error->header.reserved2);
-	CuAssertIntEquals (test, 0, error->header.integrity_check);
-	CuAssertIntEquals (test, 0, error->header.reserved1);
-	CuAssertIntEquals (test, 0, error->header.rq);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_NO_ERROR, error->error_code);
-	CuAssertIntEquals (test, 0, error->error_data);
+	memcpy (packet, tx_sg->packets[0].header, MCTP_HEADER_LENGTH);
+	memcpy (&packet[MCTP_HEADER_LENGTH], tx_sg->packets[0].payload, first_pkt);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, packet, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN - 1),
+		tx_sg->packets[0].trailer[0]);
 
-	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
-		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
-			&request, sizeof (request), cmd_interface_mock_save_request,
-			cmd_interface_mock_free_request));
+	status = testing_validate_array (response.data, tx_sg->packets[0].payload, first_pkt);
 	CuAssertIntEquals (test, 0, status);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertPtrEquals (test, &mctp.mctp.req_buffer.data[first_pkt],
+		(void*) tx_sg->packets[1].payload);
+	CuAssertIntEquals (test, second_pkt, tx_sg->packets[1].payload_len);
+	CuAssertIntEquals (test, MCTP_HEADER_LENGTH, tx_sg->packets[1].header_len);
+	CuAssertIntEquals (test, 1, tx_sg->packets[1].trailer_len);
+	CuAssertIntEquals (test, 0x55, tx_sg->packets[1].dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx_sg->packets[1].header;
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, second_pkt_total - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 1, header->packet_seq);
+
+	memcpy (packet, tx_sg->packets[1].header, MCTP_HEADER_LENGTH);
+	memcpy (&packet[MCTP_HEADER_LENGTH], tx_sg->packets[1].payload, second_pkt);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, packet, second_pkt_total - 1),
+		tx_sg->packets[1].trailer[0]);
+
+	status = testing_validate_array (&response.data[first_pkt], tx_sg->packets[1].payload,
+		second_pkt);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrNotNull (test, tx);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_normal_timeout (CuTest *test)
+static void mctp_interface_test_process_packet_sg_not_enough_packets (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
+	struct cmd_message_sg *tx_sg;
 	uint8_t data[10];
 	struct cmd_interface_msg request;
-	uint8_t response_data[2];
+	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT + 48];
 	struct cmd_interface_msg response;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
 	int status;
+	int first_pkt = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	int second_pkt = 48;
+	int second_pkt_total = second_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+	int response_size = first_pkt + second_pkt;
+	int i;
 
 	TEST_START;
 
@@ -3426,11 +3789,12 @@ static void mctp_interface_test_process_packet_normal_timeout (CuTest *test)
 	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
-	rx.timeout_valid = true;
-	platform_init_timeout (10, &rx.pkt_timeout);
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
+	status = mctp_interface_enable_scatter_gather (&mctp.mctp, mctp.sg_packets, 1);
+	CuAssertIntEquals (test, 0, status);
+
 	request.data = data;
 	request.length = sizeof (data);
 	memcpy (request.data, &rx.data[7], request.length);
@@ -3440,10 +3804,13 @@ static void mctp_interface_test_process_packet_normal_timeout (CuTest *test)
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
+	memset (&response_data, 0, sizeof (response_data));
 	response.data = response_data;
 	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	response.data[1] = 0x12;
-	response.length = sizeof (response_data);
+	for (i = 1; i < response_size; i++) {
+		response.data[i] = i;
+	}
+	response.length = response_size;
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	response.crypto_timeout = false;
@@ -3456,15 +3823,13 @@ static void mctp_interface_test_process_packet_normal_timeout (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	platform_msleep (20);
-	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx.pkt_timeout));
-
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	status = mctp_interface_process_packet_sg (&mctp.mctp, &rx, &tx, &tx_sg);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrNotNull (test, tx);
+	CuAssertPtrEquals (test, NULL, tx_sg);
 
-	CuAssertIntEquals (test, 10, tx->msg_size);
-	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + second_pkt_total, tx->msg_size);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN, tx->pkt_size);
 	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
 	header = (struct mctp_base_protocol_transport_header*) tx->data;
@@ -3475,32 +3840,56 @@ static void mctp_interface_test_process_packet_normal_timeout (CuTest *test)
 	CuAssertIntEquals (test, 0x0A, header->destination_eid);
 	CuAssertIntEquals (test, 0x0B, header->source_eid);
 	CuAssertIntEquals (test, 1, header->som);
-	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, 0, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
 	CuAssertIntEquals (test, 0, header->packet_seq);
 	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
 		tx->data[tx->pkt_size - 1]);
 
-	CuAssertIntEquals (test, 0x7E, tx->data[7]);
-	CuAssertIntEquals (test, 0x12, tx->data[8]);
-	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx.pkt_timeout));
+	status = testing_validate_array (response.data, &tx->data[MCTP_HEADER_LENGTH], first_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	header = (struct mctp_base_protocol_transport_header*) &tx->data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, second_pkt_total - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 1, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[tx->pkt_size], second_pkt_total - 1),
+		tx->data[tx->msg_size - 1]);
+
+	status = testing_validate_array (&response.data[first_pkt],
+		&tx->data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + MCTP_HEADER_LENGTH], second_pkt);
+	CuAssertIntEquals (test, 0, status);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_crypto_timeout (CuTest *test)
+static void mctp_interface_test_process_packet_sg_not_enabled (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
+	struct cmd_message_sg *tx_sg;
 	uint8_t data[10];
 	struct cmd_interface_msg request;
-	uint8_t response_data[2];
+	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT + 48];
 	struct cmd_interface_msg response;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
 	int status;
+	int first_pkt = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	int second_pkt = 48;
+	int second_pkt_total = second_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+	int response_size = first_pkt + second_pkt;
+	int i;
 
 	TEST_START;
 
@@ -3532,8 +3921,6 @@ static void mctp_interface_test_process_packet_crypto_timeout (CuTest *test)
 	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
-	rx.timeout_valid = true;
-	platform_init_timeout (10, &rx.pkt_timeout);
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
@@ -3546,13 +3933,16 @@ static void mctp_interface_test_process_packet_crypto_timeout (CuTest *test)
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
+	memset (&response_data, 0, sizeof (response_data));
 	response.data = response_data;
 	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	response.data[1] = 0x12;
-	response.length = sizeof (response_data);
+	for (i = 1; i < response_size; i++) {
+		response.data[i] = i;
+	}
+	response.length = response_size;
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	response.crypto_timeout = true;
+	response.crypto_timeout = false;
 
 	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
 		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
@@ -3562,255 +3952,348 @@ static void mctp_interface_test_process_packet_crypto_timeout (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
-	platform_msleep (20);
-	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx.pkt_timeout));
-
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	status = mctp_interface_process_packet_sg (&mctp.mctp, &rx, &tx, &tx_sg);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrNotNull (test, tx);
+	CuAssertPtrEquals (test, NULL, tx_sg);
 
-	CuAssertIntEquals (test, 10, tx->msg_size);
-	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + second_pkt_total, tx->msg_size);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MAX_PACKET_LEN, tx->pkt_size);
 	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
 	header = (struct mctp_base_protocol_transport_header*) tx->data;
 
 	CuAssertIntEquals (test, 0x0F, header->cmd_code);
-	CuAssertIntEquals (test, 7, header->byte_count);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
 	CuAssertIntEquals (test, 0xBB, header->source_addr);
 	CuAssertIntEquals (test, 0x0A, header->destination_eid);
 	CuAssertIntEquals (test, 0x0B, header->source_eid);
 	CuAssertIntEquals (test, 1, header->som);
-	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, 0, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
 	CuAssertIntEquals (test, 0, header->packet_seq);
 	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
 		tx->data[tx->pkt_size - 1]);
 
-	CuAssertIntEquals (test, 0x7E, tx->data[7]);
-	CuAssertIntEquals (test, 0x12, tx->data[8]);
-	CuAssertIntEquals (test, false, platform_has_timeout_expired (&rx.pkt_timeout));
+	status = testing_validate_array (response.data, &tx->data[MCTP_HEADER_LENGTH], first_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	header = (struct mctp_base_protocol_transport_header*) &tx->data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, second_pkt_total - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 1, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[tx->pkt_size], second_pkt_total - 1),
+		tx->data[tx->msg_size - 1]);
+
+	status = testing_validate_array (&response.data[first_pkt],
+		&tx->data[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN + MCTP_HEADER_LENGTH], second_pkt);
+	CuAssertIntEquals (test, 0, status);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_max_message (CuTest *test)
+static void mctp_interface_test_enable_dispatch (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
-	struct cmd_packet rx;
-	struct cmd_message *tx;
-	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
-	struct cmd_interface_msg request;
-	struct cmd_interface_msg response;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
-	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx.data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
-	uint8_t msg_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
 	int status;
-	int i;
 
 	TEST_START;
 
-	msg_data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	for (i = 1; i < (int) sizeof (msg_data); i++) {
-		msg_data[i] = i;
-	}
+	status = cmd_dispatch_init (&mctp.dispatch, mctp.dispatch_requests, 1);
+	CuAssertIntEquals (test, 0, status);
 
-	i = 0;
-	memset (&rx, 0, sizeof (rx));
+	status = mctp_interface_enable_dispatch (&mctp.mctp, &mctp.dispatch, &mctp.channel.base,
+		false);
+	CuAssertIntEquals (test, 0, status);
 
-	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 237;
-	header->source_addr = 0xAB;
-	header->rsvd = 0;
-	header->header_version = 1;
-	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	header->som = 1;
-	header->eom = 0;
-	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
-	header->msg_tag = 0x00;
-	header->packet_seq = 0;
+	CuAssertPtrEquals (test, &mctp.dispatch, mctp.mctp.dispatch.dispatch);
+	CuAssertPtrEquals (test, &mctp.channel.base, mctp.mctp.dispatch.channel);
+	CuAssertIntEquals (test, 0, mctp.mctp.dispatch.next_sequence);
+	CuAssertIntEquals (test, 0, mctp.mctp.dispatch.send_sequence);
+	CuAssertPtrEquals (test, &mctp.dispatch.execute, mctp.mctp.dispatch.execute);
 
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
-	rx.pkt_size = 240;
-	rx.dest_addr = 0x5D;
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+	cmd_dispatch_release (&mctp.dispatch);
+}
 
-	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+static void mctp_interface_test_enable_dispatch_reentrant (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	TEST_START;
 
-	i += 232;
-	header->som = 0;
-	header->packet_seq = 1;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	status = cmd_dispatch_init (&mctp.dispatch, mctp.dispatch_requests, 1);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
-
-	i += 232;
-	header->packet_seq = 2;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	status = mctp_interface_enable_dispatch (&mctp.mctp, &mctp.dispatch, &mctp.channel.base,
+		true);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
 
-	i += 232;
-	header->packet_seq = 3;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	CuAssertPtrEquals (test, &mctp.dispatch, mctp.mctp.dispatch.dispatch);
+	CuAssertPtrEquals (test, &mctp.channel.base, mctp.mctp.dispatch.channel);
+	CuAssertIntEquals (test, 0, mctp.mctp.dispatch.next_sequence);
+	CuAssertIntEquals (test, 0, mctp.mctp.dispatch.send_sequence);
+	CuAssertPtrEquals (test, NULL, mctp.mctp.dispatch.execute);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+	cmd_dispatch_release (&mctp.dispatch);
+}
 
-	i += 232;
-	header->packet_seq = 0;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+static void mctp_interface_test_enable_dispatch_null (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	int status;
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	TEST_START;
 
-	i += 232;
-	header->packet_seq = 1;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	status = mctp_interface_enable_dispatch (NULL, &mctp.dispatch, &mctp.channel.base, false);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
 
-	i += 232;
-	header->packet_seq = 2;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	status = mctp_interface_enable_dispatch (&mctp.mctp, NULL, &mctp.channel.base, false);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	status = mctp_interface_enable_dispatch (&mctp.mctp, &mctp.dispatch, NULL, false);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
 
-	i += 232;
-	header->packet_seq = 3;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	CuAssertPtrEquals (test, NULL, mctp.mctp.dispatch.dispatch);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
 
-	i += 232;
-	header->packet_seq = 0;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+static void mctp_interface_test_enable_dispatch_with_lock (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	platform_mutex execute;
+	int status;
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	TEST_START;
 
-	i += 232;
-	header->packet_seq = 1;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	status = cmd_dispatch_init (&mctp.dispatch, mctp.dispatch_requests, 1);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
 
-	i += 232;
-	header->packet_seq = 2;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	status = platform_mutex_init (&execute);
+	CuAssertIntEquals (test, 0, status);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	status = mctp_interface_enable_dispatch_with_lock (&mctp.mctp, &mctp.dispatch,
+		&mctp.channel.base, &execute);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
 
-	i += 232;
-	header->packet_seq = 3;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	CuAssertPtrEquals (test, &mctp.dispatch, mctp.mctp.dispatch.dispatch);
+	CuAssertPtrEquals (test, &mctp.channel.base, mctp.mctp.dispatch.channel);
+	CuAssertIntEquals (test, 0, mctp.mctp.dispatch.next_sequence);
+	CuAssertIntEquals (test, 0, mctp.mctp.dispatch.send_sequence);
+	CuAssertPtrEquals (test, &execute, mctp.mctp.dispatch.execute);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+	cmd_dispatch_release (&mctp.dispatch);
+	platform_mutex_free (&execute);
+}
 
-	i += 232;
-	header->packet_seq = 0;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+static void mctp_interface_test_enable_dispatch_with_lock_null (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	platform_mutex execute;
+	int status;
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_enable_dispatch_with_lock (NULL, &mctp.dispatch, &mctp.channel.base,
+		&execute);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_dispatch_with_lock (&mctp.mctp, NULL, &mctp.channel.base,
+		&execute);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	status = mctp_interface_enable_dispatch_with_lock (&mctp.mctp, &mctp.dispatch, NULL,
+		&execute);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_INVALID_ARGUMENT, status);
+
+	CuAssertPtrEquals (test, NULL, mctp.mctp.dispatch.dispatch);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_dispatch (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg[10] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x00, 0x01};
+	struct cmd_interface_msg request;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x00, 0x02};
+	struct cmd_interface_msg response;
+	struct cmd_packet tx_packet;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = cmd_dispatch_init (&mctp.dispatch, mctp.dispatch_requests, 1);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
 
-	i += 232;
-	header->packet_seq = 1;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	status = mctp_interface_enable_dispatch (&mctp.mctp, &mctp.dispatch, &mctp.channel.base,
+		false);
+	CuAssertIntEquals (test, 0, status);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 3, true, true, 0,
+		msg, sizeof (msg));
 
+	/* The request is queued without being processed. */
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrEquals (test, NULL, tx);
 
-	i += 232;
-	header->packet_seq = 2;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	CuAssertPtrEquals (test, &mctp.dispatch_requests[0], mctp.dispatch.head);
+	CuAssertIntEquals (test, 0, mctp.mctp.req_buffer.length);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	/* The response is sent by the worker that executes the request. */
+	mctp_interface_testing_expect_request (test, &mctp, &request, msg, sizeof (msg),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response, response_data, sizeof (response_data));
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+	status = mctp_base_protocol_construct (response_data, sizeof (response_data), tx_packet.data,
+		sizeof (tx_packet.data), 0x5D, MCTP_BASE_PROTOCOL_BMC_EID,
+		MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, true, true, 0, 3, MCTP_BASE_PROTOCOL_TO_RESPONSE,
+		0x55);
+	CuAssertIntEquals (test, MCTP_HEADER_LENGTH + sizeof (response_data) + 1, status);
+
+	tx_packet.pkt_size = status;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x55;
+
+	status = mock_expect (&mctp.channel.mock, mctp.channel.base.send_packet, &mctp.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
 
-	i += 232;
-	header->packet_seq = 3;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	status = cmd_dispatch_process_next (&mctp.dispatch);
+	CuAssertIntEquals (test, 1, status);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+	cmd_dispatch_release (&mctp.dispatch);
+}
+
+static void mctp_interface_test_process_packet_dispatch_stopped (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg[10] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x14, 0x14, 0x00, 0x01};
+	struct cmd_interface_msg error_packet;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cerberus_protocol_error *error;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = cmd_dispatch_init (&mctp.dispatch, mctp.dispatch_requests, 1);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
 
-	i += 232;
-	header->packet_seq = 0;
-	memcpy (&rx.data[7], &msg_data[i], 232);
-	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	status = mctp_interface_enable_dispatch (&mctp.mctp, &mctp.dispatch, &mctp.channel.base,
+		false);
+	CuAssertIntEquals (test, 0, status);
+
+	cmd_dispatch_stop (&mctp.dispatch);
+
+	mctp_interface_testing_expect_error_packet (test, &mctp, &error_packet, error_data,
+		CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, CMD_DISPATCH_STOPPED);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, true, 0,
+		msg, sizeof (msg));
 
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	CuAssertPtrNotNull (test, tx);
 
-	i += 232;
-	header->byte_count = 157;
-	header->packet_seq = 1;
+	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, error->error_code);
+	CuAssertIntEquals (test, CMD_DISPATCH_STOPPED, error->error_data);
+
+	CuAssertPtrEquals (test, NULL, mctp.dispatch.head);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+	cmd_dispatch_release (&mctp.dispatch);
+}
+
+static void mctp_interface_test_process_packet_channel_id_reset_next_som (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	struct cmd_interface_msg response;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
 	header->eom = 1;
-	memcpy (&rx.data[7], &msg_data[i], 152);
-	rx.data[159] = checksum_crc8 (0xBA, rx.data, 159);
-	rx.pkt_size = 160;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
 
-	request.data = data;
-	request.length = sizeof (msg_data);
-	memcpy (request.data, msg_data, request.length);
-	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	request.crypto_timeout = false;
-	request.channel_id = 0;
-	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
 
 	error_packet.data = error_data;
 	error_packet.length = sizeof (error_data);
+	error_packet.source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	error_packet.target_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	error_packet.crypto_timeout = false;
+	error_packet.channel_id = 1;
+	error_packet.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
 	error->header.msg_type = 0x7E;
 	error->header.pci_vendor_id = 0x1414;
@@ -3823,6 +4306,20 @@ static void mctp_interface_test_process_packet_max_message (CuTest *test)
 	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
 	error->error_data = 0;
 
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_set_channel_id (&mctp.mctp, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 1;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
 	memset (&response, 0, sizeof (response));
 	response.data = data;
 
@@ -3875,29 +4372,33 @@ static void mctp_interface_test_process_packet_max_message (CuTest *test)
 	CuAssertIntEquals (test, 0, error->header.rq);
 	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
 	CuAssertIntEquals (test, CERBERUS_PROTOCOL_NO_ERROR, error->error_code);
+	CuAssertIntEquals (test, 0, error->error_data);
+
+	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			&request, sizeof (request), cmd_interface_mock_save_request,
+			cmd_interface_mock_free_request));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_max_response (CuTest *test)
+static void mctp_interface_test_process_packet_normal_timeout (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
 	uint8_t data[10];
 	struct cmd_interface_msg request;
-	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	uint8_t response_data[2];
 	struct cmd_interface_msg response;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
-	size_t max_packets =
-		ceil ((MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY * 1.0) / MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT);
-	size_t remain =
-		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - (MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT * (max_packets - 1));
 	int status;
-	size_t i;
-	size_t pkt_size = MCTP_BASE_PROTOCOL_MAX_PACKET_LEN;
-	size_t last_pkt_size = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
 
 	TEST_START;
 
@@ -3929,6 +4430,8 @@ static void mctp_interface_test_process_packet_max_response (CuTest *test)
 	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
+	rx.timeout_valid = true;
+	platform_init_timeout (10, &rx.pkt_timeout);
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
@@ -3941,19 +4444,14 @@ static void mctp_interface_test_process_packet_max_response (CuTest *test)
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	memset (&response_data, 0, sizeof (response_data));
 	response.data = response_data;
 	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	for (i = 1; i < MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY; i++) {
-		response.data[i] = i;
-	}
-	response.length = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	response.data[1] = 0x12;
+	response.length = sizeof (response_data);
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	response.crypto_timeout = false;
 
-	CuAssertIntEquals (test, max_packets, MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE);
-
 	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
 		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
 			&request, sizeof (request), cmd_interface_mock_save_request,
@@ -3962,81 +4460,51 @@ static void mctp_interface_test_process_packet_max_response (CuTest *test)
 
 	CuAssertIntEquals (test, 0, status);
 
+	platform_msleep (20);
+	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx.pkt_timeout));
+
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrNotNull (test, tx);
 
-	CuAssertIntEquals (test,
-		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * max_packets),
-		tx->msg_size);
-	CuAssertIntEquals (test, pkt_size, tx->pkt_size);
+	CuAssertIntEquals (test, 10, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
 	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
-	for (i = 0; i < max_packets - 1; i++) {
-		header =
-			(struct mctp_base_protocol_transport_header*) &tx->data[i * MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
-
-		CuAssertIntEquals (test, 0x0F, header->cmd_code);
-		CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
-		CuAssertIntEquals (test, 0xBB, header->source_addr);
-		CuAssertIntEquals (test, 0x0A, header->destination_eid);
-		CuAssertIntEquals (test, 0x0B, header->source_eid);
-		CuAssertIntEquals (test, !i, header->som);
-		CuAssertIntEquals (test, 0, header->eom);
-		CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
-		CuAssertIntEquals (test, 0, header->msg_tag);
-		CuAssertIntEquals (test, i % 4, header->packet_seq);
-		CuAssertIntEquals (test,
-			checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], tx->pkt_size - 1),
-			tx->data[((i + 1) * tx->pkt_size) - 1]);
-
-		status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT],
-			&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT);
-		CuAssertIntEquals (test, 0, status);
-	}
-
-	header = (struct mctp_base_protocol_transport_header*) &tx->data[i * pkt_size];
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
 
 	CuAssertIntEquals (test, 0x0F, header->cmd_code);
-	CuAssertIntEquals (test, remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD - 3, header->byte_count);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
 	CuAssertIntEquals (test, 0xBB, header->source_addr);
 	CuAssertIntEquals (test, 0x0A, header->destination_eid);
 	CuAssertIntEquals (test, 0x0B, header->source_eid);
-	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->som);
 	CuAssertIntEquals (test, 1, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
-	CuAssertIntEquals (test, i % 4, header->packet_seq);
-	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], last_pkt_size - 1),
-		tx->data[tx->msg_size - 1]);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
 
-	status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT],
-		&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], remain);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x7E, tx->data[7]);
+	CuAssertIntEquals (test, 0x12, tx->data[8]);
+	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx.pkt_timeout));
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_max_response_min_packets (CuTest *test)
+static void mctp_interface_test_process_packet_crypto_timeout (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
 	uint8_t data[10];
 	struct cmd_interface_msg request;
-	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	uint8_t response_data[2];
 	struct cmd_interface_msg response;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
-	struct device_manager_full_capabilities remote;
-	size_t max_packets =
-		ceil ((MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY * 1.0) / MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT);
-	size_t remain =
-		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - (MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT * (max_packets - 1));
 	int status;
-	size_t i;
-	size_t pkt_size = MCTP_BASE_PROTOCOL_MIN_PACKET_LEN;
-	size_t last_pkt_size = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
 
 	TEST_START;
 
@@ -4068,21 +4536,11 @@ static void mctp_interface_test_process_packet_max_response_min_packets (CuTest
 	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
+	rx.timeout_valid = true;
+	platform_init_timeout (10, &rx.pkt_timeout);
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	memset (&remote, 0, sizeof (remote));
-	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
-	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT;
-	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
-	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
-	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
-	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
-	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
-
-	status = device_manager_update_device_capabilities (&mctp.device_mgr, 1, &remote);
-	CuAssertIntEquals (test, 0, status);
-
 	request.data = data;
 	request.length = sizeof (data);
 	memcpy (request.data, &rx.data[7], request.length);
@@ -4092,22 +4550,13 @@ static void mctp_interface_test_process_packet_max_response_min_packets (CuTest
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	memset (&response_data, 0, sizeof (response_data));
 	response.data = response_data;
 	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	for (i = 1; i < MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY; i++) {
-		response.data[i] = i;
-	}
-	response.length = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	response.data[1] = 0x12;
+	response.length = sizeof (response_data);
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	response.crypto_timeout = false;
-
-	CuAssertIntEquals (test, max_packets,
-		MCTP_BASE_PROTOCOL_PACKETS_IN_MESSAGE (MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY,
-			MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT));
-	CuAssertIntEquals (test, sizeof (mctp.mctp.msg_buffer),
-		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * max_packets));
+	response.crypto_timeout = true;
 
 	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
 		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
@@ -4117,76 +4566,69 @@ static void mctp_interface_test_process_packet_max_response_min_packets (CuTest
 
 	CuAssertIntEquals (test, 0, status);
 
+	platform_msleep (20);
+	CuAssertIntEquals (test, true, platform_has_timeout_expired (&rx.pkt_timeout));
+
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrNotNull (test, tx);
 
-	CuAssertIntEquals (test,
-		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * max_packets),
-		tx->msg_size);
-	CuAssertIntEquals (test, pkt_size, tx->pkt_size);
+	CuAssertIntEquals (test, 10, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
 	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
-	for (i = 0; i < max_packets - 1; i++) {
-		header =
-			(struct mctp_base_protocol_transport_header*) &tx->data[i * pkt_size];
-
-		CuAssertIntEquals (test, 0x0F, header->cmd_code);
-		CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
-		CuAssertIntEquals (test, 0xBB, header->source_addr);
-		CuAssertIntEquals (test, 0x0A, header->destination_eid);
-		CuAssertIntEquals (test, 0x0B, header->source_eid);
-		CuAssertIntEquals (test, !i, header->som);
-		CuAssertIntEquals (test, 0, header->eom);
-		CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
-		CuAssertIntEquals (test, 0, header->msg_tag);
-		CuAssertIntEquals (test, i % 4, header->packet_seq);
-		CuAssertIntEquals (test,
-			checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], tx->pkt_size - 1),
-			tx->data[((i + 1) * tx->pkt_size) - 1]);
-
-		status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT],
-			&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT);
-		CuAssertIntEquals (test, 0, status);
-	}
-
-	header = (struct mctp_base_protocol_transport_header*) &tx->data[i * pkt_size];
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
 
 	CuAssertIntEquals (test, 0x0F, header->cmd_code);
-	CuAssertIntEquals (test, remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD - 3, header->byte_count);
+	CuAssertIntEquals (test, 7, header->byte_count);
 	CuAssertIntEquals (test, 0xBB, header->source_addr);
 	CuAssertIntEquals (test, 0x0A, header->destination_eid);
 	CuAssertIntEquals (test, 0x0B, header->source_eid);
-	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->som);
 	CuAssertIntEquals (test, 1, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
-	CuAssertIntEquals (test, i % 4, header->packet_seq);
-	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], last_pkt_size - 1),
-		tx->data[tx->msg_size - 1]);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
 
-	status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT],
-		&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], remain);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x7E, tx->data[7]);
+	CuAssertIntEquals (test, 0x12, tx->data[8]);
+	CuAssertIntEquals (test, false, platform_has_timeout_expired (&rx.pkt_timeout));
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_no_eom (CuTest *test)
+static void mctp_interface_test_process_packet_max_message (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg request;
+	struct cmd_interface_msg response;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	uint8_t msg_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
 	int status;
+	int i;
 
 	TEST_START;
 
+	msg_data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+
+	for (i = 1; i < (int) sizeof (msg_data); i++) {
+		msg_data[i] = i;
+	}
+
+	i = 0;
 	memset (&rx, 0, sizeof (rx));
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 15;
+	header->byte_count = 237;
 	header->source_addr = 0xAB;
 	header->rsvd = 0;
 	header->header_version = 1;
@@ -4198,12 +4640,9 @@ static void mctp_interface_test_process_packet_no_eom (CuTest *test)
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	rx.data[8] = 0x00;
-	rx.data[9] = 0x00;
-	rx.data[10] = 0x00;
-	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
-	rx.pkt_size = 18;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+	rx.pkt_size = 240;
 	rx.dest_addr = 0x5D;
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
@@ -4212,185 +4651,167 @@ static void mctp_interface_test_process_packet_no_eom (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrEquals (test, NULL, tx);
 
-	complete_mctp_interface_with_interface_mock_test (test, &mctp);
-}
-
-static void mctp_interface_test_process_packet_reset_message_processing (CuTest *test)
-{
-	struct mctp_interface_testing mctp;
-	struct cmd_packet rx[2];
-	struct cmd_message *tx;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
-	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx[0].data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
-	int status;
+	i += 232;
+	header->som = 0;
+	header->packet_seq = 1;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	TEST_START;
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	memset (rx, 0, sizeof (rx));
+	i += 232;
+	header->packet_seq = 2;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 15;
-	header->source_addr = 0xAB;
-	header->rsvd = 0;
-	header->header_version = 1;
-	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	header->som = 1;
-	header->eom = 0;
-	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
-	header->msg_tag = 0x00;
-	header->packet_seq = 0;
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	rx[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	rx[0].data[8] = 0x00;
-	rx[0].data[9] = 0x00;
-	rx[0].data[10] = 0x00;
-	rx[0].data[17] = checksum_crc8 (0xBA, rx[0].data, 17);
-	rx[0].pkt_size = 18;
-	rx[0].dest_addr = 0x5D;
+	i += 232;
+	header->packet_seq = 3;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	header = (struct mctp_base_protocol_transport_header*) rx[1].data;
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 15;
-	header->source_addr = 0xAB;
-	header->rsvd = 0;
-	header->header_version = 1;
-	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	header->som = 0;
-	header->eom = 1;
-	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
-	header->msg_tag = 0x00;
+	i += 232;
 	header->packet_seq = 0;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	rx[1].data[7] = 0x00;
-	rx[1].data[8] = 0x00;
-	rx[1].data[9] = 0x00;
-	rx[1].data[10] = 0x00;
-	rx[1].data[17] = checksum_crc8 (0xBA, rx[1].data, 17);
-	rx[1].pkt_size = 18;
-	rx[1].dest_addr = 0x5D;
-
-	error_packet.data = error_data;
-	error_packet.length = sizeof (error_data);
-
-	error->header.msg_type = 0x7E;
-	error->header.pci_vendor_id = 0x1414;
-	error->header.crypt = 0;
-	error->header.reserved2 = 0;
-	error->header.integrity_check = 0;
-	error->header.reserved1 = 0;
-	error->header.rq = 0;
-	error->header.command = 0x7F;
-	error->error_code = CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG;
-	error->error_data = 0;
-
-	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
-
-	status = mctp_interface_process_packet (&mctp.mctp, &rx[0], &tx);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrEquals (test, NULL, tx);
 
-	mctp_interface_reset_message_processing (&mctp.mctp);
+	i += 232;
+	header->packet_seq = 1;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
-		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL,
-		MOCK_ARG (CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG), MOCK_ARG (0), MOCK_ARG (0));
-	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
-		-1);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	i += 232;
+	header->packet_seq = 2;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx[1], &tx);
+	i += 232;
+	header->packet_seq = 3;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrNotNull (test, tx);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
-	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
-	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+	i += 232;
+	header->packet_seq = 0;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	header = (struct mctp_base_protocol_transport_header*) tx->data;
-	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
-	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
-	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
-	CuAssertIntEquals (test, 0, header->rsvd);
-	CuAssertIntEquals (test, 1, header->header_version);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
-	CuAssertIntEquals (test, 1, header->som);
-	CuAssertIntEquals (test, 1, header->eom);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
-	CuAssertIntEquals (test, 0, header->msg_tag);
-	CuAssertIntEquals (test, 0, header->packet_seq);
-	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
-		tx->data[tx->pkt_size - 1]);
+	i += 232;
+	header->packet_seq = 1;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
-	CuAssertIntEquals (test, 0, error->header.crypt);
-	CuAssertIntEquals (test, 0, error->header.reserved2);
-	CuAssertIntEquals (test, 0, error->header.integrity_check);
-	CuAssertIntEquals (test, 0, error->header.reserved1);
-	CuAssertIntEquals (test, 0, error->header.rq);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, error->error_code);
-	CuAssertIntEquals (test, 0, error->error_data);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	complete_mctp_interface_with_interface_mock_test (test, &mctp);
-}
+	i += 232;
+	header->packet_seq = 2;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-static void mctp_interface_test_process_packet_response_length_limited (CuTest *test)
-{
-	struct mctp_interface_testing mctp;
-	struct cmd_packet rx;
-	struct cmd_message *tx;
-	uint8_t data[10];
-	struct cmd_interface_msg request;
-	struct cmd_interface_msg response;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
-	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx.data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
-	struct device_manager_full_capabilities remote;
-	int status;
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	TEST_START;
+	i += 232;
+	header->packet_seq = 3;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	memset (&rx, 0, sizeof (rx));
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 15;
-	header->source_addr = 0xAB;
-	header->rsvd = 0;
-	header->header_version = 1;
-	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	header->som = 1;
-	header->eom = 1;
-	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
-	header->msg_tag = 0x00;
+	i += 232;
 	header->packet_seq = 0;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
 
-	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	rx.data[8] = 0x00;
-	rx.data[9] = 0x00;
-	rx.data[10] = 0x00;
-	rx.data[11] = 0x01;
-	rx.data[12] = 0x02;
-	rx.data[13] = 0x03;
-	rx.data[14] = 0x04;
-	rx.data[15] = 0x05;
-	rx.data[16] = 0x06;
-	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
-	rx.pkt_size = 18;
-	rx.dest_addr = 0x5D;
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	i += 232;
+	header->packet_seq = 1;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	i += 232;
+	header->packet_seq = 2;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	i += 232;
+	header->packet_seq = 3;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	i += 232;
+	header->packet_seq = 0;
+	memcpy (&rx.data[7], &msg_data[i], 232);
+	rx.data[239] = checksum_crc8 (0xBA, rx.data, 239);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	i += 232;
+	header->byte_count = 157;
+	header->packet_seq = 1;
+	header->eom = 1;
+	memcpy (&rx.data[7], &msg_data[i], 152);
+	rx.data[159] = checksum_crc8 (0xBA, rx.data, 159);
+	rx.pkt_size = 160;
+
+	request.data = data;
+	request.length = sizeof (msg_data);
+	memcpy (request.data, msg_data, request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
 	error_packet.data = error_data;
 	error_packet.length = sizeof (error_data);
@@ -4406,29 +4827,6 @@ static void mctp_interface_test_process_packet_response_length_limited (CuTest *
 	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
 	error->error_data = 0;
 
-	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
-
-	memset (&remote, 0, sizeof (remote));
-	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
-	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
-	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
-	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
-	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
-	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
-	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
-
-	status = device_manager_update_device_capabilities (&mctp.device_mgr, 1, &remote);
-	CuAssertIntEquals (test, 0, status);
-
-	request.data = data;
-	request.length = sizeof (data);
-	memcpy (request.data, &rx.data[7], request.length);
-	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	request.crypto_timeout = false;
-	request.channel_id = 0;
-	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
-
 	memset (&response, 0, sizeof (response));
 	response.data = data;
 
@@ -4485,21 +4883,25 @@ static void mctp_interface_test_process_packet_response_length_limited (CuTest *
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_response_too_large (CuTest *test)
+static void mctp_interface_test_process_packet_max_response (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
 	uint8_t data[10];
 	struct cmd_interface_msg request;
-	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + 1];
+	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
 	struct cmd_interface_msg response;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	size_t max_packets =
+		ceil ((MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY * 1.0) / MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT);
+	size_t remain =
+		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - (MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT * (max_packets - 1));
 	int status;
+	size_t i;
+	size_t pkt_size = MCTP_BASE_PROTOCOL_MAX_PACKET_LEN;
+	size_t last_pkt_size = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
 
 	TEST_START;
 
@@ -4532,20 +4934,6 @@ static void mctp_interface_test_process_packet_response_too_large (CuTest *test)
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
 
-	error_packet.data = error_data;
-	error_packet.length = sizeof (error_data);
-
-	error->header.msg_type = 0x7E;
-	error->header.pci_vendor_id = 0x1414;
-	error->header.crypt = 0;
-	error->header.reserved2 = 0;
-	error->header.integrity_check = 0;
-	error->header.reserved1 = 0;
-	error->header.rq = 0;
-	error->header.command = 0x7F;
-	error->error_code = CERBERUS_PROTOCOL_ERROR_UNSPECIFIED;
-	error->error_data = 0x7F001605;
-
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
 	request.data = data;
@@ -4557,69 +4945,83 @@ static void mctp_interface_test_process_packet_response_too_large (CuTest *test)
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
+	memset (&response_data, 0, sizeof (response_data));
 	response.data = response_data;
 	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	response.data[1] = 0x12;
-	response.length = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + 1;
+	for (i = 1; i < MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY; i++) {
+		response.data[i] = i;
+	}
+	response.length = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	response.crypto_timeout = false;
 
+	CuAssertIntEquals (test, max_packets, MCTP_BASE_PROTOCOL_MAX_PACKET_PER_MAX_SIZED_MESSAGE);
+
 	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
 		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
 			&request, sizeof (request), cmd_interface_mock_save_request,
 			cmd_interface_mock_free_request));
 	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
-		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_ERROR_UNSPECIFIED),
-		MOCK_ARG (0x7F001605), MOCK_ARG (0));
-	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
-		-1);
-
 	CuAssertIntEquals (test, 0, status);
 
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrNotNull (test, tx);
 
-	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
-	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
-	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+	CuAssertIntEquals (test,
+		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * max_packets),
+		tx->msg_size);
+	CuAssertIntEquals (test, pkt_size, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
-	header = (struct mctp_base_protocol_transport_header*) tx->data;
-	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	for (i = 0; i < max_packets - 1; i++) {
+		header =
+			(struct mctp_base_protocol_transport_header*) &tx->data[i * MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
 
-	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
-	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
-	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
-	CuAssertIntEquals (test, 0, header->rsvd);
-	CuAssertIntEquals (test, 1, header->header_version);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
-	CuAssertIntEquals (test, 1, header->som);
+		CuAssertIntEquals (test, 0x0F, header->cmd_code);
+		CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+		CuAssertIntEquals (test, 0xBB, header->source_addr);
+		CuAssertIntEquals (test, 0x0A, header->destination_eid);
+		CuAssertIntEquals (test, 0x0B, header->source_eid);
+		CuAssertIntEquals (test, !i, header->som);
+		CuAssertIntEquals (test, 0, header->eom);
+		CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+		CuAssertIntEquals (test, 0, header->msg_tag);
+		CuAssertIntEquals (test, i % 4, header->packet_seq);
+		CuAssertIntEquals (test,
+			checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], tx->pkt_size - 1),
+			tx->data[((i + 1) * tx->pkt_size) - 1]);
+
+		status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT],
+			&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	header = (struct mctp_base_protocol_transport_header*) &tx->data[i * pkt_size];
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
 	CuAssertIntEquals (test, 1, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
-	CuAssertIntEquals (test, 0, header->packet_seq);
-	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
-		tx->data[tx->pkt_size - 1]);
+	CuAssertIntEquals (test, i % 4, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], last_pkt_size - 1),
+		tx->data[tx->msg_size - 1]);
 
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
-	CuAssertIntEquals (test, 0, error->header.crypt);
-	CuAssertIntEquals (test, 0, error->header.reserved2);
-	CuAssertIntEquals (test, 0, error->header.integrity_check);
-	CuAssertIntEquals (test, 0, error->header.reserved1);
-	CuAssertIntEquals (test, 0, error->header.rq);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, error->error_code);
-	CuAssertIntEquals (test, 0x7F001605, error->error_data);
+	status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT],
+		&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], remain);
+	CuAssertIntEquals (test, 0, status);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_response_too_large_length_limited (CuTest *test)
+static void mctp_interface_test_process_packet_max_response_min_packets (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
@@ -4628,13 +5030,17 @@ static void mctp_interface_test_process_packet_response_too_large_length_limited
 	struct cmd_interface_msg request;
 	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
 	struct cmd_interface_msg response;
-	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
-	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
-	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
 	struct device_manager_full_capabilities remote;
+	size_t max_packets =
+		ceil ((MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY * 1.0) / MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT);
+	size_t remain =
+		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - (MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT * (max_packets - 1));
 	int status;
+	size_t i;
+	size_t pkt_size = MCTP_BASE_PROTOCOL_MIN_PACKET_LEN;
+	size_t last_pkt_size = remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
 
 	TEST_START;
 
@@ -4667,25 +5073,11 @@ static void mctp_interface_test_process_packet_response_too_large_length_limited
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
 
-	error_packet.data = error_data;
-	error_packet.length = sizeof (error_data);
-
-	error->header.msg_type = 0x7E;
-	error->header.pci_vendor_id = 0x1414;
-	error->header.crypt = 0;
-	error->header.reserved2 = 0;
-	error->header.integrity_check = 0;
-	error->header.reserved1 = 0;
-	error->header.rq = 0;
-	error->header.command = 0x7F;
-	error->error_code = CERBERUS_PROTOCOL_ERROR_UNSPECIFIED;
-	error->error_data = 0x7F001605;
-
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
 	memset (&remote, 0, sizeof (remote));
-	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
-	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT;
 	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
 	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
 	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
@@ -4702,89 +5094,96 @@ static void mctp_interface_test_process_packet_response_too_large_length_limited
 	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	request.crypto_timeout = false;
 	request.channel_id = 0;
-	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
+	memset (&response_data, 0, sizeof (response_data));
 	response.data = response_data;
 	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	response.data[1] = 0x12;
-	response.length = remote.request.max_message_size + 1;
+	for (i = 1; i < MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY; i++) {
+		response.data[i] = i;
+	}
+	response.length = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	response.crypto_timeout = false;
 
+	CuAssertIntEquals (test, max_packets,
+		MCTP_BASE_PROTOCOL_PACKETS_IN_MESSAGE (MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY,
+			MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT));
+	CuAssertIntEquals (test, sizeof (mctp.mctp.msg_buffer),
+		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * max_packets));
+
 	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
 		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
 			&request, sizeof (request), cmd_interface_mock_save_request,
 			cmd_interface_mock_free_request));
 	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
-		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_ERROR_UNSPECIFIED),
-		MOCK_ARG (0x7F001605), MOCK_ARG (0));
-	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
-		-1);
-
 	CuAssertIntEquals (test, 0, status);
 
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
 	CuAssertPtrNotNull (test, tx);
 
-	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
-	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test,
+		MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + (MCTP_BASE_PROTOCOL_PACKET_OVERHEAD * max_packets),
+		tx->msg_size);
+	CuAssertIntEquals (test, pkt_size, tx->pkt_size);
 	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
-	header = (struct mctp_base_protocol_transport_header*) tx->data;
-	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	for (i = 0; i < max_packets - 1; i++) {
+		header =
+			(struct mctp_base_protocol_transport_header*) &tx->data[i * pkt_size];
 
-	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
-	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
-	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
-	CuAssertIntEquals (test, 0, header->rsvd);
-	CuAssertIntEquals (test, 1, header->header_version);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
-	CuAssertIntEquals (test, 1, header->som);
+		CuAssertIntEquals (test, 0x0F, header->cmd_code);
+		CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+		CuAssertIntEquals (test, 0xBB, header->source_addr);
+		CuAssertIntEquals (test, 0x0A, header->destination_eid);
+		CuAssertIntEquals (test, 0x0B, header->source_eid);
+		CuAssertIntEquals (test, !i, header->som);
+		CuAssertIntEquals (test, 0, header->eom);
+		CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+		CuAssertIntEquals (test, 0, header->msg_tag);
+		CuAssertIntEquals (test, i % 4, header->packet_seq);
+		CuAssertIntEquals (test,
+			checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], tx->pkt_size - 1),
+			tx->data[((i + 1) * tx->pkt_size) - 1]);
+
+		status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT],
+			&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	header = (struct mctp_base_protocol_transport_header*) &tx->data[i * pkt_size];
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, remain + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
 	CuAssertIntEquals (test, 1, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
-	CuAssertIntEquals (test, 0, header->packet_seq);
-	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
-		tx->data[tx->pkt_size - 1]);
+	CuAssertIntEquals (test, i % 4, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[i * tx->pkt_size], last_pkt_size - 1),
+		tx->data[tx->msg_size - 1]);
 
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
-	CuAssertIntEquals (test, 0, error->header.crypt);
-	CuAssertIntEquals (test, 0, error->header.reserved2);
-	CuAssertIntEquals (test, 0, error->header.integrity_check);
-	CuAssertIntEquals (test, 0, error->header.reserved1);
-	CuAssertIntEquals (test, 0, error->header.rq);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
-	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, error->error_code);
-	CuAssertIntEquals (test, 0x7F001605, error->error_data);
+	status = testing_validate_array (&response.data[i * MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT],
+		&tx->data[(i * pkt_size) + MCTP_HEADER_LENGTH], remain);
+	CuAssertIntEquals (test, 0, status);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_two_packet_response_length_limited (CuTest *test)
+static void mctp_interface_test_process_packet_no_eom (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
-	uint8_t data[10];
-	struct cmd_interface_msg request;
-	uint8_t response_data[48 + 10];
-	struct cmd_interface_msg response;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
-	struct device_manager_full_capabilities remote;
 	int status;
-	int first_pkt = 48;	// This is not a valid max packet size, but ensures test portability.
-	int first_pkt_total = first_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
-	int second_pkt = 10;
-	int second_pkt_total = second_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
-	int response_size = first_pkt + second_pkt;
-	int i;
 
 	TEST_START;
 
@@ -4798,7 +5197,7 @@ static void mctp_interface_test_process_packet_two_packet_response_length_limite
 	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
-	header->eom = 1;
+	header->eom = 0;
 	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
@@ -4807,107 +5206,150 @@ static void mctp_interface_test_process_packet_two_packet_response_length_limite
 	rx.data[8] = 0x00;
 	rx.data[9] = 0x00;
 	rx.data[10] = 0x00;
-	rx.data[11] = 0x01;
-	rx.data[12] = 0x02;
-	rx.data[13] = 0x03;
-	rx.data[14] = 0x04;
-	rx.data[15] = 0x05;
-	rx.data[16] = 0x06;
 	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	memset (&remote, 0, sizeof (remote));
-	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
-	remote.request.max_packet_size = first_pkt;
-	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
-	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
-	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
-	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
-	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
-
-	status = device_manager_update_device_capabilities (&mctp.device_mgr, 1, &remote);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
 	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
 
-	request.data = data;
-	request.length = sizeof (data);
-	memcpy (request.data, &rx.data[7], request.length);
-	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	request.crypto_timeout = false;
-	request.channel_id = 0;
-	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
-
-	memset (response_data, 0, sizeof (response_data));
-	response.data = response_data;
-	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
-	for (i = 1; i < response_size; i++) {
-		response.data[i] = i;
-	}
-	response.length = response_size;
-	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	response.crypto_timeout = false;
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
 
-	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
-		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
-			&request, sizeof (request), cmd_interface_mock_save_request,
-			cmd_interface_mock_free_request));
-	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+static void mctp_interface_test_process_packet_reset_message_processing (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx[2];
+	struct cmd_message *tx;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx[0].data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	int status;
 
-	CuAssertIntEquals (test, 0, status);
+	TEST_START;
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, 0, status);
-	CuAssertPtrNotNull (test, tx);
+	memset (rx, 0, sizeof (rx));
 
-	CuAssertIntEquals (test, first_pkt_total + second_pkt_total, tx->msg_size);
-	CuAssertIntEquals (test, first_pkt_total, tx->pkt_size);
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 0;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx[0].data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx[0].data[8] = 0x00;
+	rx[0].data[9] = 0x00;
+	rx[0].data[10] = 0x00;
+	rx[0].data[17] = checksum_crc8 (0xBA, rx[0].data, 17);
+	rx[0].pkt_size = 18;
+	rx[0].dest_addr = 0x5D;
+
+	header = (struct mctp_base_protocol_transport_header*) rx[1].data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 0;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx[1].data[7] = 0x00;
+	rx[1].data[8] = 0x00;
+	rx[1].data[9] = 0x00;
+	rx[1].data[10] = 0x00;
+	rx[1].data[17] = checksum_crc8 (0xBA, rx[1].data, 17);
+	rx[1].pkt_size = 18;
+	rx[1].dest_addr = 0x5D;
+
+	error_packet.data = error_data;
+	error_packet.length = sizeof (error_data);
+
+	error->header.msg_type = 0x7E;
+	error->header.pci_vendor_id = 0x1414;
+	error->header.crypt = 0;
+	error->header.reserved2 = 0;
+	error->header.integrity_check = 0;
+	error->header.reserved1 = 0;
+	error->header.rq = 0;
+	error->header.command = 0x7F;
+	error->error_code = CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG;
+	error->error_data = 0;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx[0], &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_reset_message_processing (&mctp.mctp);
+
+	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG), MOCK_ARG (0), MOCK_ARG (0));
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
+		-1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx[1], &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
 	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
 	header = (struct mctp_base_protocol_transport_header*) tx->data;
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
 
-	CuAssertIntEquals (test, 0x0F, header->cmd_code);
-	CuAssertIntEquals (test, first_pkt_total - 3, header->byte_count);
-	CuAssertIntEquals (test, 0xBB, header->source_addr);
-	CuAssertIntEquals (test, 0x0A, header->destination_eid);
-	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
+	CuAssertIntEquals (test, 0, header->rsvd);
+	CuAssertIntEquals (test, 1, header->header_version);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
 	CuAssertIntEquals (test, 1, header->som);
-	CuAssertIntEquals (test, 0, header->eom);
+	CuAssertIntEquals (test, 1, header->eom);
 	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
 	CuAssertIntEquals (test, 0, header->msg_tag);
 	CuAssertIntEquals (test, 0, header->packet_seq);
 	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
 		tx->data[tx->pkt_size - 1]);
 
-	status = testing_validate_array (response.data, &tx->data[MCTP_HEADER_LENGTH], first_pkt);
-	CuAssertIntEquals (test, 0, status);
-
-	header = (struct mctp_base_protocol_transport_header*) &tx->data[first_pkt_total];
-
-	CuAssertIntEquals (test, 0x0F, header->cmd_code);
-	CuAssertIntEquals (test, second_pkt_total - 3, header->byte_count);
-	CuAssertIntEquals (test, 0xBB, header->source_addr);
-	CuAssertIntEquals (test, 0x0A, header->destination_eid);
-	CuAssertIntEquals (test, 0x0B, header->source_eid);
-	CuAssertIntEquals (test, 0, header->som);
-	CuAssertIntEquals (test, 1, header->eom);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
-	CuAssertIntEquals (test, 0, header->msg_tag);
-	CuAssertIntEquals (test, 1, header->packet_seq);
-	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[first_pkt_total], second_pkt_total - 1),
-		tx->data[tx->msg_size - 1]);
-
-	status = testing_validate_array (&response.data[first_pkt],
-		&tx->data[first_pkt_total + MCTP_HEADER_LENGTH], second_pkt);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, error->header.crypt);
+	CuAssertIntEquals (test, 0, error->header.reserved2);
+	CuAssertIntEquals (test, 0, error->header.integrity_check);
+	CuAssertIntEquals (test, 0, error->header.reserved1);
+	CuAssertIntEquals (test, 0, error->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, error->error_code);
+	CuAssertIntEquals (test, 0, error->error_data);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_error_message_fail (CuTest *test)
+static void mctp_interface_test_process_packet_response_length_limited (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
@@ -4915,8 +5357,12 @@ static void mctp_interface_test_process_packet_error_message_fail (CuTest *test)
 	uint8_t data[10];
 	struct cmd_interface_msg request;
 	struct cmd_interface_msg response;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	struct device_manager_full_capabilities remote;
 	int status;
 
 	TEST_START;
@@ -4950,8 +5396,34 @@ static void mctp_interface_test_process_packet_error_message_fail (CuTest *test)
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
 
+	error_packet.data = error_data;
+	error_packet.length = sizeof (error_data);
+
+	error->header.msg_type = 0x7E;
+	error->header.pci_vendor_id = 0x1414;
+	error->header.crypt = 0;
+	error->header.reserved2 = 0;
+	error->header.integrity_check = 0;
+	error->header.reserved1 = 0;
+	error->header.rq = 0;
+	error->header.command = 0x7F;
+	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
+	error->error_data = 0;
+
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
+	memset (&remote, 0, sizeof (remote));
+	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
+	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
+	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
+	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
+	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
+	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
+
+	status = device_manager_update_device_capabilities (&mctp.device_mgr, 1, &remote);
+	CuAssertIntEquals (test, 0, status);
+
 	request.data = data;
 	request.length = sizeof (data);
 	memcpy (request.data, &rx.data[7], request.length);
@@ -4959,7 +5431,7 @@ static void mctp_interface_test_process_packet_error_message_fail (CuTest *test)
 	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	request.crypto_timeout = false;
 	request.channel_id = 0;
-	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
 
 	memset (&response, 0, sizeof (response));
 	response.data = data;
@@ -4971,27 +5443,62 @@ static void mctp_interface_test_process_packet_error_message_fail (CuTest *test)
 	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
 	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
-		&mctp.cmd_cerberus, CMD_HANDLER_ERROR_MSG_FAILED, MOCK_ARG_NOT_NULL,
-		MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR), MOCK_ARG (0), MOCK_ARG (0));
+		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR),
+		MOCK_ARG (0), MOCK_ARG (0));
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
+		-1);
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, CMD_HANDLER_ERROR_MSG_FAILED, status);
-	CuAssertPtrEquals (test, NULL, tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+
+	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
+	CuAssertIntEquals (test, 0, header->rsvd);
+	CuAssertIntEquals (test, 1, header->header_version);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
+
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, error->header.crypt);
+	CuAssertIntEquals (test, 0, error->header.reserved2);
+	CuAssertIntEquals (test, 0, error->header.integrity_check);
+	CuAssertIntEquals (test, 0, error->header.reserved1);
+	CuAssertIntEquals (test, 0, error->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_NO_ERROR, error->error_code);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_error_too_large (CuTest *test)
+static void mctp_interface_test_process_packet_response_too_large (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
 	struct cmd_packet rx;
 	struct cmd_message *tx;
 	uint8_t data[10];
 	struct cmd_interface_msg request;
+	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + 1];
 	struct cmd_interface_msg response;
-	uint8_t error_data[MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT + 1];
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
 	struct cmd_interface_msg error_packet;
 	struct mctp_base_protocol_transport_header *header =
 		(struct mctp_base_protocol_transport_header*) rx.data;
@@ -5040,8 +5547,8 @@ static void mctp_interface_test_process_packet_error_too_large (CuTest *test)
 	error->header.reserved1 = 0;
 	error->header.rq = 0;
 	error->header.command = 0x7F;
-	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
-	error->error_data = 0;
+	error->error_code = CERBERUS_PROTOCOL_ERROR_UNSPECIFIED;
+	error->error_data = 0x7F001605;
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
@@ -5054,8 +5561,13 @@ static void mctp_interface_test_process_packet_error_too_large (CuTest *test)
 	request.channel_id = 0;
 	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	memset (&response, 0, sizeof (response));
-	response.data = data;
+	response.data = response_data;
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0x12;
+	response.length = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY + 1;
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
 
 	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
 		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
@@ -5064,45 +5576,84 @@ static void mctp_interface_test_process_packet_error_too_large (CuTest *test)
 	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
 	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
-		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR),
-		MOCK_ARG (0), MOCK_ARG (0));
+		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_ERROR_UNSPECIFIED),
+		MOCK_ARG (0x7F001605), MOCK_ARG (0));
 	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
 		-1);
 
 	CuAssertIntEquals (test, 0, status);
 
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TOO_LARGE, status);
-	CuAssertPtrEquals (test, NULL, tx);
-
-	complete_mctp_interface_with_interface_mock_test (test, &mctp);
-}
-
-static void mctp_interface_test_process_packet_unexpected_response (CuTest *test)
-{
-	struct mctp_interface_testing mctp;
-	struct cmd_packet rx;
-	struct cmd_message *tx;
-	uint8_t data[10];
-	struct cmd_interface_msg response;
-	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx.data;
-	int status;
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
 
-	TEST_START;
+	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
-	memset (&rx, 0, sizeof (rx));
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
 
-	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 15;
-	header->source_addr = 0xAB;
-	header->rsvd = 0;
-	header->header_version = 1;
+	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
+	CuAssertIntEquals (test, 0, header->rsvd);
+	CuAssertIntEquals (test, 1, header->header_version);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
+
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, error->header.crypt);
+	CuAssertIntEquals (test, 0, error->header.reserved2);
+	CuAssertIntEquals (test, 0, error->header.integrity_check);
+	CuAssertIntEquals (test, 0, error->header.reserved1);
+	CuAssertIntEquals (test, 0, error->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, error->error_code);
+	CuAssertIntEquals (test, 0x7F001605, error->error_data);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_response_too_large_length_limited (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	uint8_t response_data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg response;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	struct device_manager_full_capabilities remote;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
 	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
 	header->eom = 1;
-	header->tag_owner = MCTP_BASE_PROTOCOL_TO_RESPONSE;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
@@ -5119,35 +5670,127 @@ static void mctp_interface_test_process_packet_unexpected_response (CuTest *test
 	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
-	rx.timeout_valid = true;
-	platform_init_timeout (10, &rx.pkt_timeout);
+
+	error_packet.data = error_data;
+	error_packet.length = sizeof (error_data);
+
+	error->header.msg_type = 0x7E;
+	error->header.pci_vendor_id = 0x1414;
+	error->header.crypt = 0;
+	error->header.reserved2 = 0;
+	error->header.integrity_check = 0;
+	error->header.reserved1 = 0;
+	error->header.rq = 0;
+	error->header.command = 0x7F;
+	error->error_code = CERBERUS_PROTOCOL_ERROR_UNSPECIFIED;
+	error->error_data = 0x7F001605;
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	response.data = data;
-	response.length = sizeof (data);
-	memcpy (response.data, &rx.data[7], response.length);
+	memset (&remote, 0, sizeof (remote));
+	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
+	remote.request.max_packet_size = MCTP_BASE_PROTOCOL_MAX_TRANSMISSION_UNIT;
+	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
+	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
+	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
+	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
+	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
+
+	status = device_manager_update_device_capabilities (&mctp.device_mgr, 1, &remote);
+	CuAssertIntEquals (test, 0, status);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - 128;
+
+	response.data = response_data;
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	response.data[1] = 0x12;
+	response.length = remote.request.max_message_size + 1;
 	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
 	response.crypto_timeout = false;
-	response.channel_id = 0;
-	response.max_response = 0;
+
+	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			&request, sizeof (request), cmd_interface_mock_save_request,
+			cmd_interface_mock_free_request));
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+
+	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_ERROR_UNSPECIFIED),
+		MOCK_ARG (0x7F001605), MOCK_ARG (0));
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
+		-1);
+
+	CuAssertIntEquals (test, 0, status);
 
 	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
-	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_UNEXPECTED_PKT, status);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+
+	CuAssertIntEquals (test, SMBUS_CMD_CODE_MCTP, header->cmd_code);
+	CuAssertIntEquals (test, tx->pkt_size - 3, header->byte_count);
+	CuAssertIntEquals (test, 0x5D << 1 | 1, header->source_addr);
+	CuAssertIntEquals (test, 0, header->rsvd);
+	CuAssertIntEquals (test, 1, header->header_version);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
+
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, error->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, error->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, error->header.crypt);
+	CuAssertIntEquals (test, 0, error->header.reserved2);
+	CuAssertIntEquals (test, 0, error->header.integrity_check);
+	CuAssertIntEquals (test, 0, error->header.reserved1);
+	CuAssertIntEquals (test, 0, error->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR, error->header.command);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_UNSPECIFIED, error->error_code);
+	CuAssertIntEquals (test, 0x7F001605, error->error_data);
 
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
-static void mctp_interface_test_process_packet_response_with_unexpected_msg_tag (CuTest *test)
+static void mctp_interface_test_process_packet_two_packet_response_length_limited (CuTest *test)
 {
 	struct mctp_interface_testing mctp;
-	struct mctp_interface_test_callback_context context;
 	struct cmd_packet rx;
-	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) rx.data;
+	struct cmd_message *tx;
 	uint8_t data[10];
+	struct cmd_interface_msg request;
+	uint8_t response_data[48 + 10];
 	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	struct device_manager_full_capabilities remote;
+	int status;
+	int first_pkt = 48;	// This is not a valid max packet size, but ensures test portability.
+	int first_pkt_total = first_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+	int second_pkt = 10;
+	int second_pkt_total = second_pkt + MCTP_BASE_PROTOCOL_PACKET_OVERHEAD;
+	int response_size = first_pkt + second_pkt;
+	int i;
+
+	TEST_START;
 
 	memset (&rx, 0, sizeof (rx));
 
@@ -5160,8 +5803,8 @@ static void mctp_interface_test_process_packet_response_with_unexpected_msg_tag
 	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
 	header->eom = 1;
-	header->tag_owner = MCTP_BASE_PROTOCOL_TO_RESPONSE;
-	header->msg_tag = 0x01;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
 	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
@@ -5177,83 +5820,194 @@ static void mctp_interface_test_process_packet_response_with_unexpected_msg_tag
 	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
 	rx.pkt_size = 18;
 	rx.dest_addr = 0x5D;
-	rx.timeout_valid = true;
-	platform_init_timeout (10, &rx.pkt_timeout);
-
-	response.data = data;
-	response.length = sizeof (data);
-	memcpy (response.data, &rx.data[7], response.length);
-	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	response.crypto_timeout = false;
-	response.channel_id = 0;
-	response.max_response = 0;
-
-	TEST_START;
 
 	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	context.expected_status = MCTP_BASE_PROTOCOL_UNEXPECTED_PKT;
-	context.rsp_packet = &rx;
-	context.test = test;
-	context.testing = &mctp;
+	memset (&remote, 0, sizeof (remote));
+	remote.request.max_message_size = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	remote.request.max_packet_size = first_pkt;
+	remote.request.security_mode = DEVICE_MANAGER_SECURITY_AUTHENTICATION;
+	remote.request.bus_role = DEVICE_MANAGER_SLAVE_BUS_ROLE;
+	remote.request.hierarchy_role = DEVICE_MANAGER_AC_ROT_MODE;
+	remote.max_timeout = MCTP_BASE_PROTOCOL_MAX_RESPONSE_TIMEOUT_MS / 10;
+	remote.max_sig = MCTP_BASE_PROTOCOL_MAX_CRYPTO_TIMEOUT_MS / 100;
 
-	mctp_interface_testing_generate_and_issue_request (test, &mctp, &context,
-		MCTP_BASE_PROTOCOL_RESPONSE_TIMEOUT, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0);
+	status = device_manager_update_device_capabilities (&mctp.device_mgr, 1, &remote);
+	CuAssertIntEquals (test, 0, status);
 
-	complete_mctp_interface_with_interface_mock_test (test, &mctp);
-}
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-static void mctp_interface_test_process_packet_discovery_notify_response (CuTest *test)
-{
-	struct mctp_interface_testing mctp;
-	struct cmd_packet rx_packet;
-	struct cmd_packet tx_packet;
-	struct cmd_message *tx;
-	uint8_t data[10];
-	struct cmd_interface_msg response;
-	struct mctp_base_protocol_transport_header *header =
-		(struct mctp_base_protocol_transport_header*) tx_packet.data;
-	int status;
+	memset (response_data, 0, sizeof (response_data));
+	response.data = response_data;
+	response.data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 1; i < response_size; i++) {
+		response.data[i] = i;
+	}
+	response.length = response_size;
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
 
-	TEST_START;
+	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			&request, sizeof (request), cmd_interface_mock_save_request,
+			cmd_interface_mock_free_request));
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+	CuAssertIntEquals (test, 0, status);
 
-	data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_CONTROL_MSG;
-	data[1] = 0x80;
-	data[2] = MCTP_CONTROL_PROTOCOL_DISCOVERY_NOTIFY;
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
 
-	memset (&tx_packet, 0, sizeof (tx_packet));
+	CuAssertIntEquals (test, first_pkt_total + second_pkt_total, tx->msg_size);
+	CuAssertIntEquals (test, first_pkt_total, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
 
-	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 8;
-	header->source_addr = 0xBB;
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, first_pkt_total - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 0, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, tx->data, tx->pkt_size - 1),
+		tx->data[tx->pkt_size - 1]);
+
+	status = testing_validate_array (response.data, &tx->data[MCTP_HEADER_LENGTH], first_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	header = (struct mctp_base_protocol_transport_header*) &tx->data[first_pkt_total];
+
+	CuAssertIntEquals (test, 0x0F, header->cmd_code);
+	CuAssertIntEquals (test, second_pkt_total - 3, header->byte_count);
+	CuAssertIntEquals (test, 0xBB, header->source_addr);
+	CuAssertIntEquals (test, 0x0A, header->destination_eid);
+	CuAssertIntEquals (test, 0x0B, header->source_eid);
+	CuAssertIntEquals (test, 0, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 1, header->packet_seq);
+	CuAssertIntEquals (test, checksum_crc8 (0xAA, &tx->data[first_pkt_total], second_pkt_total - 1),
+		tx->data[tx->msg_size - 1]);
+
+	status = testing_validate_array (&response.data[first_pkt],
+		&tx->data[first_pkt_total + MCTP_HEADER_LENGTH], second_pkt);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_error_message_fail (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
 	header->rsvd = 0;
 	header->header_version = 1;
-	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
 	header->eom = 1;
 	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	memcpy (&tx_packet.data[7], data, 3);
+	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
 
-	tx_packet.data[10] = checksum_crc8 (0xA2, tx_packet.data, 10);
-	tx_packet.pkt_size = 11;
-	tx_packet.state = CMD_VALID_PACKET;
-	tx_packet.dest_addr = 0x51;
-	tx_packet.timeout_valid = false;
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
 
-	header =
-		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
 
-	memset (&rx_packet, 0, sizeof (rx_packet));
+	memset (&response, 0, sizeof (response));
+	response.data = data;
+
+	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			&request, sizeof (request), cmd_interface_mock_save_request,
+			cmd_interface_mock_free_request));
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
+
+	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
+		&mctp.cmd_cerberus, CMD_HANDLER_ERROR_MSG_FAILED, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR), MOCK_ARG (0), MOCK_ARG (0));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, CMD_HANDLER_ERROR_MSG_FAILED, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_error_too_large (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t data[10];
+	struct cmd_interface_msg request;
+	struct cmd_interface_msg response;
+	uint8_t error_data[MCTP_BASE_PROTOCOL_MIN_TRANSMISSION_UNIT + 1];
+	struct cmd_interface_msg error_packet;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	struct cerberus_protocol_error *error = (struct cerberus_protocol_error*) error_data;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
 
 	header->cmd_code = SMBUS_CMD_CODE_MCTP;
-	header->byte_count = 9;
+	header->byte_count = 15;
 	header->source_addr = 0xAB;
 	header->rsvd = 0;
 	header->header_version = 1;
@@ -5261,45 +6015,1085 @@ static void mctp_interface_test_process_packet_discovery_notify_response (CuTest
 	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
 	header->som = 1;
 	header->eom = 1;
-	header->tag_owner = MCTP_BASE_PROTOCOL_TO_RESPONSE;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
 	header->msg_tag = 0x00;
 	header->packet_seq = 0;
 
-	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_CONTROL_MSG;
-	rx_packet.data[8] = 0x00;
-	rx_packet.data[9] = 0x0D;
-	rx_packet.data[10] = 0x00;
-	rx_packet.data[11] = checksum_crc8 (0xBA, rx_packet.data, 11);
-	rx_packet.pkt_size = 12;
-	rx_packet.dest_addr = 0x5D;
-	rx_packet.timeout_valid = true;
-	platform_init_timeout (10, &rx_packet.pkt_timeout);
+	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
 
-	response.data = data;
-	response.length = 4;
-	memcpy (response.data, &rx_packet.data[7], response.length);
-	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
-	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
-	response.crypto_timeout = false;
-	response.channel_id = 0;
-	response.max_response = 0;
+	error_packet.data = error_data;
+	error_packet.length = sizeof (error_data);
 
-	status = mock_expect (&mctp.channel.mock, mctp.channel.base.send_packet, &mctp.channel, 0,
-		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
-	CuAssertIntEquals (test, 0, status);
+	error->header.msg_type = 0x7E;
+	error->header.pci_vendor_id = 0x1414;
+	error->header.crypt = 0;
+	error->header.reserved2 = 0;
+	error->header.integrity_check = 0;
+	error->header.reserved1 = 0;
+	error->header.rq = 0;
+	error->header.command = 0x7F;
+	error->error_code = CERBERUS_PROTOCOL_NO_ERROR;
+	error->error_data = 0;
 
-	status = mock_expect (&mctp.cmd_mctp.mock, mctp.cmd_mctp.base.process_response,
-		&mctp.cmd_mctp, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
-			&response, sizeof (response), cmd_interface_mock_save_request,
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	request.data = data;
+	request.length = sizeof (data);
+	memcpy (request.data, &rx.data[7], request.length);
+	request.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	request.crypto_timeout = false;
+	request.channel_id = 0;
+	request.max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+
+	memset (&response, 0, sizeof (response));
+	response.data = data;
+
+	status = mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.process_request,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			&request, sizeof (request), cmd_interface_mock_save_request,
 			cmd_interface_mock_free_request));
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &response, sizeof (response), -1);
 
-	status = mctp_interface_send_discovery_notify (&mctp.mctp, &mctp.channel.base);
-	CuAssertIntEquals (test, 0, status);
+	status |= mock_expect (&mctp.cmd_cerberus.mock, mctp.cmd_cerberus.base.generate_error_packet,
+		&mctp.cmd_cerberus, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (CERBERUS_PROTOCOL_NO_ERROR),
+		MOCK_ARG (0), MOCK_ARG (0));
+	status |= mock_expect_output (&mctp.cmd_cerberus.mock, 0, &error_packet, sizeof (error_packet),
+		-1);
 
-	status = mctp_interface_process_packet (&mctp.mctp, &rx_packet, &tx);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TOO_LARGE, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_unexpected_response (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	int status;
+
+	TEST_START;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_RESPONSE;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
+	rx.timeout_valid = true;
+	platform_init_timeout (10, &rx.pkt_timeout);
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	response.data = data;
+	response.length = sizeof (data);
+	memcpy (response.data, &rx.data[7], response.length);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+	response.channel_id = 0;
+	response.max_response = 0;
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_UNEXPECTED_PKT, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_response_with_unexpected_msg_tag (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct mctp_interface_test_callback_context context;
+	struct cmd_packet rx;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) rx.data;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+
+	memset (&rx, 0, sizeof (rx));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 15;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_RESPONSE;
+	header->msg_tag = 0x01;
+	header->packet_seq = 0;
+
+	rx.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	rx.data[8] = 0x00;
+	rx.data[9] = 0x00;
+	rx.data[10] = 0x00;
+	rx.data[11] = 0x01;
+	rx.data[12] = 0x02;
+	rx.data[13] = 0x03;
+	rx.data[14] = 0x04;
+	rx.data[15] = 0x05;
+	rx.data[16] = 0x06;
+	rx.data[17] = checksum_crc8 (0xBA, rx.data, 17);
+	rx.pkt_size = 18;
+	rx.dest_addr = 0x5D;
+	rx.timeout_valid = true;
+	platform_init_timeout (10, &rx.pkt_timeout);
+
+	response.data = data;
+	response.length = sizeof (data);
+	memcpy (response.data, &rx.data[7], response.length);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+	response.channel_id = 0;
+	response.max_response = 0;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	context.expected_status = MCTP_BASE_PROTOCOL_UNEXPECTED_PKT;
+	context.rsp_packet = &rx;
+	context.test = test;
+	context.testing = &mctp;
+
+	mctp_interface_testing_generate_and_issue_request (test, &mctp, &context,
+		MCTP_BASE_PROTOCOL_RESPONSE_TIMEOUT, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_discovery_notify_response (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx_packet;
+	struct cmd_packet tx_packet;
+	struct cmd_message *tx;
+	uint8_t data[10];
+	struct cmd_interface_msg response;
+	struct mctp_base_protocol_transport_header *header =
+		(struct mctp_base_protocol_transport_header*) tx_packet.data;
+	int status;
+
+	TEST_START;
+
+	setup_mctp_interface_with_interface_mock_test (test, &mctp, true);
+
+	data[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_CONTROL_MSG;
+	data[1] = 0x80;
+	data[2] = MCTP_CONTROL_PROTOCOL_DISCOVERY_NOTIFY;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 8;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_REQUEST;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	memcpy (&tx_packet.data[7], data, 3);
+
+	tx_packet.data[10] = checksum_crc8 (0xA2, tx_packet.data, 10);
+	tx_packet.pkt_size = 11;
+	tx_packet.state = CMD_VALID_PACKET;
+	tx_packet.dest_addr = 0x51;
+	tx_packet.timeout_valid = false;
+
+	header =
+		(struct mctp_base_protocol_transport_header*) rx_packet.data;
+
+	memset (&rx_packet, 0, sizeof (rx_packet));
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 9;
+	header->source_addr = 0xAB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = MCTP_BASE_PROTOCOL_TO_RESPONSE;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	rx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_CONTROL_MSG;
+	rx_packet.data[8] = 0x00;
+	rx_packet.data[9] = 0x0D;
+	rx_packet.data[10] = 0x00;
+	rx_packet.data[11] = checksum_crc8 (0xBA, rx_packet.data, 11);
+	rx_packet.pkt_size = 12;
+	rx_packet.dest_addr = 0x5D;
+	rx_packet.timeout_valid = true;
+	platform_init_timeout (10, &rx_packet.pkt_timeout);
+
+	response.data = data;
+	response.length = 4;
+	memcpy (response.data, &rx_packet.data[7], response.length);
+	response.source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	response.target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	response.crypto_timeout = false;
+	response.channel_id = 0;
+	response.max_response = 0;
+
+	status = mock_expect (&mctp.channel.mock, mctp.channel.base.send_packet, &mctp.channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_packet, &tx_packet, sizeof (tx_packet)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mctp.cmd_mctp.mock, mctp.cmd_mctp.base.process_response,
+		&mctp.cmd_mctp, 0, MOCK_ARG_VALIDATOR_DEEP_COPY (cmd_interface_mock_validate_request,
+			&response, sizeof (response), cmd_interface_mock_save_request,
+			cmd_interface_mock_free_request));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_send_discovery_notify (&mctp.mctp, &mctp.channel.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mctp_interface_process_packet (&mctp.mctp, &rx_packet, &tx);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_interleaved_sources (
+	CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	struct cmd_interface_msg request_a;
+	struct cmd_interface_msg request_b;
+	uint8_t response_data_a[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x12};
+	uint8_t response_data_b[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x34};
+	struct cmd_interface_msg response_a;
+	struct cmd_interface_msg response_b;
+	struct mctp_base_protocol_transport_header *header;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_request (test, &mctp, &request_a, msg_a, sizeof (msg_a),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response_a, response_data_a, sizeof (response_data_a));
+	mctp_interface_testing_expect_request (test, &mctp, &request_b, msg_b, sizeof (msg_b),
+		MCTP_INTERFACE_TESTING_HOST_EID, &response_b, response_data_b, sizeof (response_data_b));
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, true,
+		false, 0, msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg_a[10], sizeof (msg_a) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 10, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0x12, tx->data[8]);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, false,
+		true, 1, &msg_b[10], sizeof (msg_b) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 10, tx->msg_size);
+	CuAssertIntEquals (test, tx->msg_size, tx->pkt_size);
+	CuAssertIntEquals (test, 0x56, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, MCTP_INTERFACE_TESTING_HOST_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID, header->source_eid);
+	CuAssertIntEquals (test, 1, header->som);
+	CuAssertIntEquals (test, 1, header->eom);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 0, header->msg_tag);
+	CuAssertIntEquals (test, 0x34, tx->data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_interleaved_msg_tags (
+	CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	struct cmd_interface_msg request_a;
+	struct cmd_interface_msg request_b;
+	uint8_t response_data_a[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x12};
+	uint8_t response_data_b[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x34};
+	struct cmd_interface_msg response_a;
+	struct cmd_interface_msg response_b;
+	struct mctp_base_protocol_transport_header *header;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_request (test, &mctp, &request_b, msg_b, sizeof (msg_b),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response_b, response_data_b, sizeof (response_data_b));
+	mctp_interface_testing_expect_request (test, &mctp, &request_a, msg_a, sizeof (msg_a),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response_a, response_data_a, sizeof (response_data_a));
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 1, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 2, true, false, 0,
+		msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 2, false, true, 1,
+		&msg_b[10], sizeof (msg_b) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 2, header->msg_tag);
+	CuAssertIntEquals (test, 0x34, tx->data[8]);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 1, false, true, 1,
+		&msg_a[10], sizeof (msg_a) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	header = (struct mctp_base_protocol_transport_header*) tx->data;
+
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_BMC_EID, header->destination_eid);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_TO_RESPONSE, header->tag_owner);
+	CuAssertIntEquals (test, 1, header->msg_tag);
+	CuAssertIntEquals (test, 0x12, tx->data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_single_packet_contexts_full (
+	CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	uint8_t msg_c[10];
+	struct cmd_interface_msg request_a;
+	struct cmd_interface_msg request_b;
+	struct cmd_interface_msg request_c;
+	uint8_t response_data_a[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x12};
+	uint8_t response_data_b[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x34};
+	uint8_t response_data_c[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x56};
+	struct cmd_interface_msg response_a;
+	struct cmd_interface_msg response_b;
+	struct cmd_interface_msg response_c;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	memset (msg_c, 0, sizeof (msg_c));
+	msg_c[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_c); i++) {
+		msg_c[i] = 0x40 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_request (test, &mctp, &request_c, msg_c, sizeof (msg_c),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response_c, response_data_c, sizeof (response_data_c));
+	mctp_interface_testing_expect_request (test, &mctp, &request_a, msg_a, sizeof (msg_a),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response_a, response_data_a, sizeof (response_data_a));
+	mctp_interface_testing_expect_request (test, &mctp, &request_b, msg_b, sizeof (msg_b),
+		MCTP_INTERFACE_TESTING_HOST_EID, &response_b, response_data_b, sizeof (response_data_b));
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, true,
+		false, 0, msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 3, true, true, 0,
+		msg_c, sizeof (msg_c));
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+	CuAssertIntEquals (test, 0x56, tx->data[8]);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg_a[10], sizeof (msg_a) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+	CuAssertIntEquals (test, 0x12, tx->data[8]);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, false,
+		true, 1, &msg_b[10], sizeof (msg_b) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x56, tx->dest_addr);
+	CuAssertIntEquals (test, 0x34, tx->data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_no_free_context (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	uint8_t msg_c[14];
+	struct cmd_interface_msg request_a;
+	struct cmd_interface_msg request_b;
+	struct cmd_interface_msg request_c;
+	uint8_t response_data_a[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x12};
+	uint8_t response_data_b[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x34};
+	uint8_t response_data_c[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x56};
+	struct cmd_interface_msg response_a;
+	struct cmd_interface_msg response_b;
+	struct cmd_interface_msg response_c;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	memset (msg_c, 0, sizeof (msg_c));
+	msg_c[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_c); i++) {
+		msg_c[i] = 0x40 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_request (test, &mctp, &request_a, msg_a, sizeof (msg_a),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response_a, response_data_a, sizeof (response_data_a));
+	mctp_interface_testing_expect_request (test, &mctp, &request_c, msg_c, sizeof (msg_c),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response_c, response_data_c, sizeof (response_data_c));
+	mctp_interface_testing_expect_request (test, &mctp, &request_b, msg_b, sizeof (msg_b),
+		MCTP_INTERFACE_TESTING_HOST_EID, &response_b, response_data_b, sizeof (response_data_b));
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, true,
+		false, 0, msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 3, true, false, 0,
+		msg_c, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_NO_REASSEMBLY_CONTEXT, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg_a[10], sizeof (msg_a) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x12, tx->data[8]);
+
+	/* The completed message released a context for the retried message. */
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 3, true, false, 0,
+		msg_c, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 3, false, true, 1,
+		&msg_c[10], sizeof (msg_c) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x56, tx->data[8]);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, false,
+		true, 1, &msg_b[10], sizeof (msg_b) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x34, tx->data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_restart_message (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	struct cmd_interface_msg request;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x12};
+	struct cmd_interface_msg response;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_request (test, &mctp, &request, msg_b, sizeof (msg_b),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response, response_data, sizeof (response_data));
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	CuAssertIntEquals (test, 0, mctp.contexts[1].start_packet_len);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg_b[10], sizeof (msg_b) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x12, tx->data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_timeout (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct cerberus_protocol_error *error;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 10);
+
+	mctp_interface_testing_expect_error_packet (test, &mctp, &error_packet, error_data,
+		CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, 0);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	platform_msleep (20);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg_a[10], sizeof (msg_a) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, MCTP_ERROR_MSG_LENGTH, tx->msg_size);
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, error->error_code);
+
+	CuAssertIntEquals (test, 0, mctp.contexts[0].start_packet_len);
+	CuAssertIntEquals (test, 0, mctp.contexts[1].start_packet_len);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_reuse_expired_context (
+	CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	uint8_t msg_c[14];
+	struct cmd_interface_msg request;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x56};
+	struct cmd_interface_msg response;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	memset (msg_c, 0, sizeof (msg_c));
+	msg_c[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_c); i++) {
+		msg_c[i] = 0x40 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 10);
+
+	mctp_interface_testing_expect_request (test, &mctp, &request, msg_c, sizeof (msg_c),
+		MCTP_BASE_PROTOCOL_BMC_EID, &response, response_data, sizeof (response_data));
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, true,
+		false, 0, msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	platform_msleep (20);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 3, true, false, 0,
+		msg_c, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 3, false, true, 1,
+		&msg_c[10], sizeof (msg_c) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+	CuAssertIntEquals (test, 0x56, tx->data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_invalid_packet_seq (
+	CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	struct cmd_interface_msg request;
+	uint8_t response_data[] = {MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, 0x34};
+	struct cmd_interface_msg response;
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct cerberus_protocol_error *error;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_error_packet (test, &mctp, &error_packet, error_data,
+		CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW, 0);
+	mctp_interface_testing_expect_request (test, &mctp, &request, msg_b, sizeof (msg_b),
+		MCTP_INTERFACE_TESTING_HOST_EID, &response, response_data, sizeof (response_data));
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, true,
+		false, 0, msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, true, 2,
+		&msg_a[10], sizeof (msg_a) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x55, tx->dest_addr);
+
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_SEQ_WINDOW, error->error_code);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, false,
+		true, 1, &msg_b[10], sizeof (msg_b) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	CuAssertIntEquals (test, 0x56, tx->dest_addr);
+	CuAssertIntEquals (test, 0x34, tx->data[8]);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_invalid_msg_size (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[30];
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct cerberus_protocol_error *error;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_error_packet (test, &mctp, &error_packet, error_data,
+		CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN, 8);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, false,
+		1, &msg_a[10], 8);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_INVALID_PACKET_LEN, error->error_code);
+
+	CuAssertIntEquals (test, 0, mctp.contexts[0].start_packet_len);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_msg_overflow (CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[80];
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct cerberus_protocol_error *error;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_error_packet (test, &mctp, &error_packet, error_data,
+		CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW, 70);
+
+	for (i = 0; i < 6; i++) {
+		mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, (i == 0),
+			false, i % 4, &msg_a[i * 10], 10);
+		status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+		CuAssertIntEquals (test, 0, status);
+		CuAssertPtrEquals (test, NULL, tx);
+	}
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, false,
+		6 % 4, &msg_a[60], 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_MSG_OVERFLOW, error->error_code);
+	CuAssertIntEquals (test, 70, error->error_data);
+
+	CuAssertIntEquals (test, 0, mctp.contexts[0].start_packet_len);
+
+	complete_mctp_interface_with_interface_mock_test (test, &mctp);
+}
+
+static void mctp_interface_test_process_packet_reassembly_contexts_reset_message_processing (
+	CuTest *test)
+{
+	struct mctp_interface_testing mctp;
+	struct cmd_packet rx;
+	struct cmd_message *tx;
+	uint8_t msg_a[16];
+	uint8_t msg_b[20];
+	uint8_t error_data[sizeof (struct cerberus_protocol_error)];
+	struct cmd_interface_msg error_packet;
+	struct cerberus_protocol_error *error;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (msg_a, 0, sizeof (msg_a));
+	msg_a[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_a); i++) {
+		msg_a[i] = i;
+	}
+
+	memset (msg_b, 0, sizeof (msg_b));
+	msg_b[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	for (i = 4; i < sizeof (msg_b); i++) {
+		msg_b[i] = 0x80 + i;
+	}
+
+	setup_mctp_interface_with_reassembly_contexts_test (test, &mctp,
+		MCTP_INTERFACE_TESTING_CONTEXTS, 100);
+
+	mctp_interface_testing_expect_error_packet (test, &mctp, &error_packet, error_data,
+		CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, 0);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, true, false, 0,
+		msg_a, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_testing_build_packet (&rx, 0x56, MCTP_INTERFACE_TESTING_HOST_EID, 0, true,
+		false, 0, msg_b, 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, tx);
+
+	mctp_interface_reset_message_processing (&mctp.mctp);
+
+	CuAssertIntEquals (test, 0, mctp.contexts[0].start_packet_len);
+	CuAssertIntEquals (test, 0, mctp.contexts[1].start_packet_len);
+
+	mctp_interface_testing_build_packet (&rx, 0x55, MCTP_BASE_PROTOCOL_BMC_EID, 0, false, true, 1,
+		&msg_a[10], sizeof (msg_a) - 10);
+	status = mctp_interface_process_packet (&mctp.mctp, &rx, &tx);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, tx);
+
+	error = (struct cerberus_protocol_error*) &tx->data[MCTP_HEADER_LENGTH];
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_ERROR_OUT_OF_ORDER_MSG, error->error_code);
+
 	complete_mctp_interface_with_interface_mock_test (test, &mctp);
 }
 
@@ -7551,7 +9345,14 @@ TEST (mctp_interface_test_init_null);
 TEST (mctp_interface_test_deinit_null);
 TEST (mctp_interface_test_set_channel_id);
 TEST (mctp_interface_test_set_channel_id_null);
+TEST (mctp_interface_test_enable_reassembly_contexts);
+TEST (mctp_interface_test_enable_reassembly_contexts_max_message_length);
+TEST (mctp_interface_test_enable_reassembly_contexts_null);
+TEST (mctp_interface_test_enable_reassembly_contexts_buffer_too_small);
+TEST (mctp_interface_test_enable_scatter_gather);
+TEST (mctp_interface_test_enable_scatter_gather_null);
 TEST (mctp_interface_test_process_packet_null);
+TEST (mctp_interface_test_process_packet_sg_null);
 TEST (mctp_interface_test_process_packet_invalid_req);
 TEST (mctp_interface_test_process_packet_unsupported_message);
 TEST (mctp_interface_test_process_packet_invalid_crc);
@@ -7580,6 +9381,16 @@ TEST (mctp_interface_test_process_packet_one_packet_request);
 TEST (mctp_interface_test_process_packet_one_packet_response);
 TEST (mctp_interface_test_process_packet_one_packet_response_non_zero_message_tag);
 TEST (mctp_interface_test_process_packet_two_packet_response);
+TEST (mctp_interface_test_process_packet_sg_two_packet_response);
+TEST (mctp_interface_test_process_packet_sg_not_enough_packets);
+TEST (mctp_interface_test_process_packet_sg_not_enabled);
+TEST (mctp_interface_test_enable_dispatch);
+TEST (mctp_interface_test_enable_dispatch_reentrant);
+TEST (mctp_interface_test_enable_dispatch_null);
+TEST (mctp_interface_test_enable_dispatch_with_lock);
+TEST (mctp_interface_test_enable_dispatch_with_lock_null);
+TEST (mctp_interface_test_process_packet_dispatch);
+TEST (mctp_interface_test_process_packet_dispatch_stopped);
 TEST (mctp_interface_test_process_packet_channel_id_reset_next_som);
 TEST (mctp_interface_test_process_packet_normal_timeout);
 TEST (mctp_interface_test_process_packet_crypto_timeout);
@@ -7597,6 +9408,17 @@ TEST (mctp_interface_test_process_packet_error_too_large);
 TEST (mctp_interface_test_process_packet_unexpected_response);
 TEST (mctp_interface_test_process_packet_response_with_unexpected_msg_tag);
 TEST (mctp_interface_test_process_packet_discovery_notify_response);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_interleaved_sources);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_interleaved_msg_tags);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_single_packet_contexts_full);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_no_free_context);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_restart_message);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_timeout);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_reuse_expired_context);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_invalid_packet_seq);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_invalid_msg_size);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_msg_overflow);
+TEST (mctp_interface_test_process_packet_reassembly_contexts_reset_message_processing);
 TEST (mctp_interface_test_issue_request_then_process_packet_response_from_unexpected_eid);
 TEST (mctp_interface_test_issue_request_then_process_packet_response);
 TEST (mctp_interface_test_issue_request_then_process_packet_multiple_response_for_same_request);
@@ -33,6 +33,19 @@ static int cmd_channel_mock_send_packet (struct cmd_channel *channel, struct cmd
 	MOCK_RETURN (&mock->mock, cmd_channel_mock_send_packet, channel, MOCK_ARG_PTR_CALL (packet));
 }
 
+static int cmd_channel_mock_send_packet_sg (struct cmd_channel *channel,
+	const struct cmd_packet_sg *packet)
+{
+	struct cmd_channel_mock *mock = (struct cmd_channel_mock*) channel;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, cmd_channel_mock_send_packet_sg, channel,
+		MOCK_ARG_PTR_CALL (packet));
+}
+
 static int cmd_channel_mock_func_arg_count (void *func)
 {
 	if (func == cmd_channel_mock_receive_packet) {
@@ -41,6 +54,9 @@ static int cmd_channel_mock_func_arg_count (void *func)
 	if (func == cmd_channel_mock_send_packet) {
 		return 1;
 	}
+	else if (func == cmd_channel_mock_send_packet_sg) {
+		return 1;
+	}
 	else {
 		return 0;
 	}
@@ -54,6 +70,9 @@ static const char* cmd_channel_mock_func_name_map (void *func)
 	else if (func == cmd_channel_mock_send_packet) {
 		return "send_packet";
 	}
+	else if (func == cmd_channel_mock_send_packet_sg) {
+		return "send_packet_sg";
+	}
 	else {
 		return "unknown";
 	}
@@ -75,6 +94,12 @@ static const char* cmd_channel_mock_arg_name_map (void *func, int arg)
 				return "packet";
 		}
 	}
+	else if (func == cmd_channel_mock_send_packet_sg) {
+		switch (arg) {
+			case 0:
+				return "packet";
+		}
+	}
 
 	return "unknown";
 }
@@ -120,6 +145,28 @@ int cmd_channel_mock_init (struct cmd_channel_mock *mock, int id)
 	return 0;
 }
 
+/**
+ * Initialize a mock for a command channel that supports scatter/gather packet transmission.
+ *
+ * @param mock The mock to initialize.
+ * @param id An ID for the command channel.
+ *
+ * @return 0 if the mock was successfully initialized or an error code.
+ */
+int cmd_channel_mock_init_scatter_gather (struct cmd_channel_mock *mock, int id)
+{
+	int status;
+
+	status = cmd_channel_mock_init (mock, id);
+	if (status != 0) {
+		return status;
+	}
+
+	mock->base.send_packet_sg = cmd_channel_mock_send_packet_sg;
+
+	return 0;
+}
+
 /**
  * Release the resources used by a command channel mock.
  *
@@ -195,3 +242,45 @@ int cmd_channel_mock_validate_packet (const char *arg_info, void *expected, void
 
 	return fail;
 }
+
+/**
+ * Custom validation routine for validating cmd_packet_sg arguments.  The expected packet is
+ * provided as a contiguous cmd_packet, which is compared against the combined segments of the
+ * actual packet.
+ *
+ * @param arg_info Argument information from the mock for error messages.
+ * @param expected The expected packet contents, as a cmd_packet.
+ * @param actual The actual packet contents, as a cmd_packet_sg.
+ *
+ * @return 0 if the packet contained the expected information or 1 if not.
+ */
+int cmd_channel_mock_validate_packet_sg (const char *arg_info, void *expected, void *actual)
+{
+	struct cmd_packet *pkt_expected = (struct cmd_packet*) expected;
+	struct cmd_packet_sg *pkt_actual = (struct cmd_packet_sg*) actual;
+	size_t actual_size;
+	int fail = 0;
+
+	if (pkt_expected->dest_addr != pkt_actual->dest_addr) {
+		platform_printf ("%sUnexpected destination address: expected=0x%x, actual=0x%x" NEWLINE,
+			arg_info, pkt_expected->dest_addr, pkt_actual->dest_addr);
+		fail |= 1;
+	}
+
+	actual_size = pkt_actual->header_len + pkt_actual->payload_len + pkt_actual->trailer_len;
+	if (pkt_expected->pkt_size != actual_size) {
+		platform_printf ("%sUnexpected packet length: expected=0x%lx, actual=0x%lx" NEWLINE, arg_info,
+			pkt_expected->pkt_size, actual_size);
+		return 1;
+	}
+
+	fail |= testing_validate_array_prefix (pkt_expected->data, pkt_actual->header,
+		pkt_actual->header_len, arg_info);
+	fail |= testing_validate_array_prefix (&pkt_expected->data[pkt_actual->header_len],
+		pkt_actual->payload, pkt_actual->payload_len, arg_info);
+	fail |= testing_validate_array_prefix (
+		&pkt_expected->data[pkt_actual->header_len + pkt_actual->payload_len], pkt_actual->trailer,
+		pkt_actual->trailer_len, arg_info);
+
+	return fail;
+}
@@ -15,6 +15,8 @@ static int aes_mock_set_key (struct aes_engine *engine, const uint8_t *key, size
 		return MOCK_INVALID_ARGUMENT;
 	}
 
+	engine->key_generation++;
+
 	MOCK_RETURN (&mock->mock, aes_mock_set_key, engine, MOCK_ARG_PTR_CALL (key),
 		MOCK_ARG_CALL (length));
 }
@@ -59,11 +59,42 @@ static int flash_master_mock_set_spi_clock_frequency (const struct flash_master
 	MOCK_RETURN (&mock->mock, flash_master_mock_set_spi_clock_frequency, spi, MOCK_ARG_CALL (freq));
 }
 
+static int flash_master_mock_xfer_batch (const struct flash_master *spi,
+	const struct flash_xfer *xfer, size_t count)
+{
+	struct flash_master_mock *mock = (struct flash_master_mock*) spi;
+	size_t i;
+	int status;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	status = MOCK_VOID_RETURN (&mock->mock, flash_master_mock_xfer_batch, spi,
+		MOCK_ARG_CALL (count));
+	if (status != 0) {
+		return status;
+	}
+
+	/* Each transfer in the batch is checked against individual xfer expectations. */
+	for (i = 0; i < count; i++) {
+		status = flash_master_mock_xfer (spi, &xfer[i]);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
 static int flash_master_mock_func_arg_count (void *func)
 {
 	if (func == flash_master_mock_xfer) {
 		return 7;
 	}
+	else if (func == flash_master_mock_xfer_batch) {
+		return 1;
+	}
 	else if (func == flash_master_mock_set_spi_clock_frequency) {
 		return 1;
 	}
@@ -89,6 +120,9 @@ static const char* flash_master_mock_func_name_map (void *func)
 	else if (func == flash_master_mock_set_spi_clock_frequency) {
 		return "set_spi_clock_frequency";
 	}
+	else if (func == flash_master_mock_xfer_batch) {
+		return "xfer_batch";
+	}
 	else {
 		return "unknown";
 	}
@@ -129,6 +163,12 @@ static const char* flash_master_mock_arg_name_map (void *func, int arg)
 				return "freq";
 		}
 	}
+	else if (func == flash_master_mock_xfer_batch) {
+		switch (arg) {
+			case 0:
+				return "count";
+		}
+	}
 
 	return "unknown";
 }
@@ -163,6 +203,7 @@ int flash_master_mock_init (struct flash_master_mock *mock)
 	mock->base.capabilities = flash_master_mock_capabilities;
 	mock->base.get_spi_clock_frequency = flash_master_mock_get_spi_clock_frequency;
 	mock->base.set_spi_clock_frequency = flash_master_mock_set_spi_clock_frequency;
+	mock->base.xfer_batch = NULL;
 
 	mock->mock.func_arg_count = flash_master_mock_func_arg_count;
 	mock->mock.func_name_map = flash_master_mock_func_name_map;
@@ -171,6 +212,25 @@ int flash_master_mock_init (struct flash_master_mock *mock)
 	return 0;
 }
 
+/**
+ * Enable the optional batched transfer API on a flash master mock.  Each batch of transfers is
+ * reported as a call to xfer_batch followed by a call to xfer for every transfer in the batch.
+ *
+ * @param mock The mock to update.
+ *
+ * @return 0 if the batch API was enabled or an error code.
+ */
+int flash_master_mock_enable_xfer_batch (struct flash_master_mock *mock)
+{
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	mock->base.xfer_batch = flash_master_mock_xfer_batch;
+
+	return 0;
+}
+
 /**
  * Release the resources used by a flash master mock instance.
  *
@@ -349,7 +409,7 @@ static int flash_master_mock_expect_blank_check_ext (struct flash_master_mock *m
 	size_t page_len;
 
 	while (length > 0) {
-		page_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		page_len = (length > FLASH_BLANK_CHECK_BLOCK) ? FLASH_BLANK_CHECK_BLOCK : length;
 
 		status |= flash_master_mock_expect_rx_xfer (mock, 0, &WIP_STATUS, 1,
 			FLASH_EXP_READ_STATUS_REG);
@@ -430,12 +490,12 @@ static int flash_master_mock_expect_value_check_ext (struct flash_master_mock *m
 {
 	int status = 0;
 	size_t page_len;
-	uint8_t check[FLASH_VERIFICATION_BLOCK];
+	uint8_t check[FLASH_BLANK_CHECK_BLOCK];
 
 	memset (check, value, sizeof (check));
 
 	while (length > 0) {
-		page_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		page_len = (length > FLASH_BLANK_CHECK_BLOCK) ? FLASH_BLANK_CHECK_BLOCK : length;
 
 		status |= flash_master_mock_expect_rx_xfer (mock, 0, &WIP_STATUS, 1,
 			FLASH_EXP_READ_STATUS_REG);
@@ -23,11 +23,12 @@ extern const uint8_t WIP_STATUS;
 struct flash_master_mock {
 	struct flash_master base;					/**< The base flash master instance. */
 	struct mock mock;							/**< The base mock instance. */
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];	/**< Blank flash data. */
+	uint8_t blank[FLASH_BLANK_CHECK_BLOCK];		/**< Blank flash data. */
 };
 
 
 int flash_master_mock_init (struct flash_master_mock *mock);
+int flash_master_mock_enable_xfer_batch (struct flash_master_mock *mock);
 void flash_master_mock_release (struct flash_master_mock *mock);
 
 int flash_master_mock_validate_and_release (struct flash_master_mock *mock);
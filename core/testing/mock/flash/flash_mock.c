@@ -276,6 +276,7 @@ int flash_mock_init (struct flash_mock *mock)
 
 	mock->base.get_device_size = flash_mock_get_device_size;
 	mock->base.read = flash_mock_read;
+	mock->base.read_regions = NULL;
 	mock->base.get_page_size = flash_mock_get_page_size;
 	mock->base.minimum_write_per_page = flash_mock_minimum_write_per_page;
 	mock->base.write = flash_mock_write;
@@ -338,7 +339,7 @@ int flash_mock_expect_blank_check (struct flash_mock *mock, uint32_t start, size
 	size_t page_len;
 
 	while (length > 0) {
-		page_len = (length > FLASH_VERIFICATION_BLOCK) ? FLASH_VERIFICATION_BLOCK : length;
+		page_len = (length > FLASH_BLANK_CHECK_BLOCK) ? FLASH_BLANK_CHECK_BLOCK : length;
 
 		status |= mock_expect (&mock->mock, mock->base.read, mock, 0, MOCK_ARG (start),
 			MOCK_ARG_NOT_NULL, MOCK_ARG (page_len));
@@ -443,6 +444,82 @@ int flash_mock_expect_erase_flash_sector_ext (struct flash_mock *mock, uint32_t
 	return status;
 }
 
+/**
+ * Set up expectations for successfully erasing flash using the largest erase operations possible.
+ * The flash is assumed to be 16MB with standard sector and block sizes.
+ *
+ * @param mock The mock to update.
+ * @param addr The starting address of the region.
+ * @param length The length of the region to erase.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_mock_expect_erase_flash_optimal (struct flash_mock *mock, uint32_t addr, size_t length)
+{
+	return flash_mock_expect_erase_flash_optimal_ext (mock, addr, length, FLASH_SECTOR_SIZE,
+		FLASH_BLOCK_SIZE, 0x1000000);
+}
+
+/**
+ * Set up expectations for successfully erasing flash using the largest erase operations possible.
+ *
+ * @param mock The mock to update.
+ * @param addr The starting address of the region.
+ * @param length The length of the region to erase.
+ * @param sector_size The erase sector size.
+ * @param block_size The erase block size.
+ * @param device_size The total size of the flash device.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_mock_expect_erase_flash_optimal_ext (struct flash_mock *mock, uint32_t addr,
+	size_t length, uint32_t sector_size, uint32_t block_size, uint32_t device_size)
+{
+	int status;
+	size_t remaining;
+
+	if (length == 0) {
+		return 0;
+	}
+
+	status = mock_expect (&mock->mock, mock->base.get_sector_size, mock, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&mock->mock, 0, &sector_size, sizeof (sector_size), -1);
+
+	status |= mock_expect (&mock->mock, mock->base.get_block_size, mock, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&mock->mock, 0, &block_size, sizeof (block_size), -1);
+
+	remaining = length + FLASH_REGION_OFFSET (addr, sector_size);
+	remaining = ((remaining + sector_size - 1) / sector_size) * sector_size;
+	addr = FLASH_REGION_BASE (addr, sector_size);
+
+	if (addr == 0) {
+		status |= mock_expect (&mock->mock, mock->base.get_device_size, mock, 0,
+			MOCK_ARG_NOT_NULL);
+		status |= mock_expect_output_tmp (&mock->mock, 0, &device_size, sizeof (device_size), -1);
+
+		if (remaining >= device_size) {
+			status |= mock_expect (&mock->mock, mock->base.chip_erase, mock, 0);
+
+			return status;
+		}
+	}
+
+	while ((status == 0) && (remaining != 0)) {
+		if ((FLASH_REGION_OFFSET (addr, block_size) == 0) && (remaining >= block_size)) {
+			status |= mock_expect (&mock->mock, mock->base.block_erase, mock, 0, MOCK_ARG (addr));
+			addr += block_size;
+			remaining -= block_size;
+		}
+		else {
+			status |= mock_expect (&mock->mock, mock->base.sector_erase, mock, 0, MOCK_ARG (addr));
+			addr += sector_size;
+			remaining -= sector_size;
+		}
+	}
+
+	return status;
+}
+
 /**
  * Set up expectations for successfully erasing a region of flash blocks with a blank check.
  *
@@ -514,6 +591,49 @@ int flash_mock_expect_erase_flash_sector_verify_ext (struct flash_mock *mock, ui
 	return status;
 }
 
+/**
+ * Set up expectations for successfully erasing a region of flash using the largest erase operations
+ * possible with a blank check.  The flash is assumed to be 16MB with standard sector and block
+ * sizes.
+ *
+ * @param mock The mock to update.
+ * @param addr The starting address of the region.
+ * @param length The length of the region.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_mock_expect_erase_flash_optimal_verify (struct flash_mock *mock, uint32_t addr,
+	size_t length)
+{
+	return flash_mock_expect_erase_flash_optimal_verify_ext (mock, addr, length, FLASH_SECTOR_SIZE,
+		FLASH_BLOCK_SIZE, 0x1000000);
+}
+
+/**
+ * Set up expectations for successfully erasing a region of flash using the largest erase operations
+ * possible with a blank check.
+ *
+ * @param mock The mock to update.
+ * @param addr The starting address of the region.
+ * @param length The length of the region.
+ * @param sector_size The erase sector size.
+ * @param block_size The erase block size.
+ * @param device_size The total size of the flash device.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int flash_mock_expect_erase_flash_optimal_verify_ext (struct flash_mock *mock, uint32_t addr,
+	size_t length, uint32_t sector_size, uint32_t block_size, uint32_t device_size)
+{
+	int status;
+
+	status = flash_mock_expect_erase_flash_optimal_ext (mock, addr, length, sector_size,
+		block_size, device_size);
+	status |= flash_mock_expect_blank_check (mock, addr, length);
+
+	return status;
+}
+
 /**
  * Set up expectations for successfully copying flash data.
  *
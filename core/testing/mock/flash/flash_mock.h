@@ -16,7 +16,7 @@
 struct flash_mock {
 	struct flash base;							/**< The base flash API instance. */
 	struct mock mock;							/**< The base mock interface. */
-	uint8_t blank[FLASH_VERIFICATION_BLOCK];	/**< Blank flash data. */
+	uint8_t blank[FLASH_BLANK_CHECK_BLOCK];		/**< Blank flash data. */
 };
 
 
@@ -36,6 +36,9 @@ int flash_mock_expect_erase_flash_ext (struct flash_mock *mock, uint32_t addr, s
 int flash_mock_expect_erase_flash_sector (struct flash_mock *mock, uint32_t addr, size_t length);
 int flash_mock_expect_erase_flash_sector_ext (struct flash_mock *mock, uint32_t addr, size_t length,
 	uint32_t sector_size);
+int flash_mock_expect_erase_flash_optimal (struct flash_mock *mock, uint32_t addr, size_t length);
+int flash_mock_expect_erase_flash_optimal_ext (struct flash_mock *mock, uint32_t addr,
+	size_t length, uint32_t sector_size, uint32_t block_size, uint32_t device_size);
 
 int flash_mock_expect_erase_flash_verify (struct flash_mock *mock, uint32_t addr, size_t length);
 int flash_mock_expect_erase_flash_verify_ext (struct flash_mock *mock, uint32_t addr, size_t length,
@@ -44,6 +47,10 @@ int flash_mock_expect_erase_flash_sector_verify (struct flash_mock *mock, uint32
 	size_t length);
 int flash_mock_expect_erase_flash_sector_verify_ext (struct flash_mock *mock, uint32_t addr,
 	size_t length, uint32_t sector_size);
+int flash_mock_expect_erase_flash_optimal_verify (struct flash_mock *mock, uint32_t addr,
+	size_t length);
+int flash_mock_expect_erase_flash_optimal_verify_ext (struct flash_mock *mock, uint32_t addr,
+	size_t length, uint32_t sector_size, uint32_t block_size, uint32_t device_size);
 
 int flash_mock_expect_copy_flash_verify (struct flash_mock *mock_dest, struct flash_mock *mock_src,
 	uint32_t dest_addr, uint32_t src_addr, const uint8_t *data, size_t length);
@@ -0,0 +1,1767 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "state_manager/state_journal.h"
+#include "state_manager/state_journal_static.h"
+#include "crypto/checksum.h"
+#include "flash/flash_common.h"
+#include "testing/mock/flash/flash_mock.h"
+
+
+TEST_SUITE_LABEL ("state_journal");
+
+
+/**
+ * Base address of the journal used for testing.
+ */
+#define	STATE_JOURNAL_TESTING_BASE			0x10000
+
+/**
+ * The number of sectors in the journal used for testing.
+ */
+#define	STATE_JOURNAL_TESTING_SECTORS		3
+
+/**
+ * The number of records in each sector.
+ */
+#define	STATE_JOURNAL_TESTING_RECORDS		(FLASH_SECTOR_SIZE / sizeof (struct state_journal_record))
+
+
+/**
+ * Dependencies for testing the state journal.
+ */
+struct state_journal_testing {
+	struct flash_mock flash;					/**< Mock for the journal flash. */
+	struct state_journal_state state;			/**< Variable context for the journal. */
+	struct state_journal test;					/**< The journal under test. */
+	struct state_journal_record blank;			/**< A blank journal record. */
+};
+
+
+/**
+ * Build a valid journal record.
+ *
+ * @param record The record to build.
+ * @param sequence Sequence number for the record.
+ * @param state List of states to add to the record.
+ * @param count The number of states in the list.
+ */
+static void state_journal_testing_build_record (struct state_journal_record *record,
+	uint32_t sequence, const uint16_t *state, uint8_t count)
+{
+	memset (record, 0xff, sizeof (*record));
+
+	record->sequence = sequence;
+	memcpy (record->state, state, sizeof (uint16_t) * count);
+	record->count = count;
+	record->crc = checksum_update_smbus_crc8 (0, (uint8_t*) record,
+		offsetof (struct state_journal_record, crc));
+}
+
+/**
+ * Get the address of a record in the testing journal.
+ *
+ * @param sector The sector that contains the record.
+ * @param index Index of the record in the sector.
+ *
+ * @return The record address.
+ */
+static uint32_t state_journal_testing_addr (size_t sector, size_t index)
+{
+	return STATE_JOURNAL_TESTING_BASE + (sector * FLASH_SECTOR_SIZE) +
+		(index * sizeof (struct state_journal_record));
+}
+
+/**
+ * Set up expectations for reading a journal record.
+ *
+ * @param journal Testing components.
+ * @param addr Address of the record.
+ * @param record The record data to return.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int state_journal_testing_expect_read (struct state_journal_testing *journal,
+	uint32_t addr, const struct state_journal_record *record)
+{
+	int status;
+
+	status = mock_expect (&journal->flash.mock, journal->flash.base.read, &journal->flash, 0,
+		MOCK_ARG (addr), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (*record)));
+	status |= mock_expect_output (&journal->flash.mock, 1, record, sizeof (*record), 2);
+
+	return status;
+}
+
+/**
+ * Set up expectations for querying the flash sector size.
+ *
+ * @param journal Testing components.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int state_journal_testing_expect_sector_size (struct state_journal_testing *journal)
+{
+	static const uint32_t sector_size = FLASH_SECTOR_SIZE;
+	int status;
+
+	status = mock_expect (&journal->flash.mock, journal->flash.base.get_sector_size,
+		&journal->flash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&journal->flash.mock, 0, &sector_size, sizeof (sector_size),
+		-1);
+
+	return status;
+}
+
+/**
+ * Set up expectations for writing a journal record.
+ *
+ * @param journal Testing components.
+ * @param addr Address of the record.
+ * @param record The record that should be written.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+static int state_journal_testing_expect_write (struct state_journal_testing *journal,
+	uint32_t addr, const struct state_journal_record *record)
+{
+	return mock_expect (&journal->flash.mock, journal->flash.base.write, &journal->flash,
+		sizeof (*record), MOCK_ARG (addr), MOCK_ARG_PTR_CONTAINS (record, sizeof (*record)),
+		MOCK_ARG (sizeof (*record)));
+}
+
+/**
+ * Initialize the dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param journal Testing components to initialize.
+ */
+static void state_journal_testing_init_dependencies (CuTest *test,
+	struct state_journal_testing *journal)
+{
+	int status;
+
+	status = flash_mock_init (&journal->flash);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&journal->blank, 0xff, sizeof (journal->blank));
+}
+
+/**
+ * Initialize a state journal for testing that doesn't contain any records.
+ *
+ * @param test The testing framework.
+ * @param journal Testing components to initialize.
+ */
+static void state_journal_testing_init_blank (CuTest *test, struct state_journal_testing *journal)
+{
+	size_t i;
+	int status;
+
+	state_journal_testing_init_dependencies (test, journal);
+
+	status = state_journal_testing_expect_sector_size (journal);
+	for (i = 0; i < STATE_JOURNAL_TESTING_SECTORS; i++) {
+		status |= state_journal_testing_expect_read (journal, state_journal_testing_addr (i, 0),
+			&journal->blank);
+	}
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal->test, &journal->state, &journal->flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&journal->flash.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a state journal for testing that has records in the first sector.
+ *
+ * @param test The testing framework.
+ * @param journal Testing components to initialize.
+ * @param last Index of the last record in the first sector.
+ * @param latest The latest record in the journal.
+ */
+static void state_journal_testing_init_first_sector (CuTest *test,
+	struct state_journal_testing *journal, size_t last, const struct state_journal_record *latest)
+{
+	struct state_journal_record first;
+	uint16_t state[] = {0x1234};
+	size_t low = 0;
+	size_t high = STATE_JOURNAL_TESTING_RECORDS;
+	size_t mid;
+	size_t i;
+	int status;
+
+	state_journal_testing_init_dependencies (test, journal);
+
+	state_journal_testing_build_record (&first, latest->sequence - last, state, 1);
+
+	status = state_journal_testing_expect_sector_size (journal);
+	status |= state_journal_testing_expect_read (journal, state_journal_testing_addr (0, 0),
+		(last == 0) ? latest : &first);
+	for (i = 1; i < STATE_JOURNAL_TESTING_SECTORS; i++) {
+		status |= state_journal_testing_expect_read (journal, state_journal_testing_addr (i, 0),
+			&journal->blank);
+	}
+
+	while ((high - low) > 1) {
+		mid = low + ((high - low) / 2);
+		if (mid > last) {
+			status |= state_journal_testing_expect_read (journal,
+				state_journal_testing_addr (0, mid), &journal->blank);
+			high = mid;
+		}
+		else {
+			status |= state_journal_testing_expect_read (journal,
+				state_journal_testing_addr (0, mid), (mid == last) ? latest : &first);
+			low = mid;
+		}
+	}
+
+	if (last != 0) {
+		status |= state_journal_testing_expect_read (journal, state_journal_testing_addr (0, last),
+			latest);
+	}
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal->test, &journal->state, &journal->flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&journal->flash.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param journal Testing components to release.
+ */
+static void state_journal_testing_release (CuTest *test, struct state_journal_testing *journal)
+{
+	int status;
+
+	status = flash_mock_validate_and_release (&journal->flash);
+	CuAssertIntEquals (test, 0, status);
+
+	state_journal_release (&journal->test);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void state_journal_test_init_blank (CuTest *test)
+{
+	struct state_journal_testing journal;
+
+	TEST_START;
+
+	state_journal_testing_init_blank (test, &journal);
+
+	CuAssertIntEquals (test, 0, journal.state.stored_count);
+	CuAssertIntEquals (test, 0, journal.state.sequence);
+	CuAssertIntEquals (test, STATE_JOURNAL_TESTING_BASE, journal.state.next_addr);
+	CuAssertIntEquals (test, false, journal.state.force_write);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_find_latest (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record old;
+	struct state_journal_record first;
+	struct state_journal_record latest;
+	uint16_t old_state[] = {0x1111, 0x2222};
+	uint16_t state[] = {0x3333, 0x4444, 0x5555};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&old, 1, old_state, 2);
+	state_journal_testing_build_record (&first, 257, old_state, 2);
+	state_journal_testing_build_record (&latest, 262, state, 3);
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 0), &old);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 0),
+		&first);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (2, 0),
+		&journal.blank);
+
+	/* Binary search for the last record in the second sector. */
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 128),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 64),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 32),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 16),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 8),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 4),
+		&first);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 6),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 5),
+		&latest);
+
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 5),
+		&latest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 3, journal.state.stored_count);
+	CuAssertIntEquals (test, 0x3333, journal.state.stored[0]);
+	CuAssertIntEquals (test, 0x4444, journal.state.stored[1]);
+	CuAssertIntEquals (test, 0x5555, journal.state.stored[2]);
+	CuAssertIntEquals (test, 262, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (1, 6), journal.state.next_addr);
+	CuAssertIntEquals (test, false, journal.state.force_write);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_find_latest_first_record (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	uint16_t state[] = {0x3333};
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 1);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	CuAssertIntEquals (test, 1, journal.state.stored_count);
+	CuAssertIntEquals (test, 0x3333, journal.state.stored[0]);
+	CuAssertIntEquals (test, 10, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+	CuAssertIntEquals (test, false, journal.state.force_write);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_find_latest_full_sector (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	uint16_t state[] = {0x3333, 0x4444};
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 1000, state, 2);
+
+	state_journal_testing_init_first_sector (test, &journal, STATE_JOURNAL_TESTING_RECORDS - 1,
+		&latest);
+
+	CuAssertIntEquals (test, 2, journal.state.stored_count);
+	CuAssertIntEquals (test, 0x3333, journal.state.stored[0]);
+	CuAssertIntEquals (test, 0x4444, journal.state.stored[1]);
+	CuAssertIntEquals (test, 1000, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (1, 0), journal.state.next_addr);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_find_latest_last_sector_full (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record old;
+	struct state_journal_record first;
+	struct state_journal_record latest;
+	uint16_t state[] = {0x3333};
+	size_t mid;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&old, 20, state, 1);
+	state_journal_testing_build_record (&first, 600, state, 1);
+	state_journal_testing_build_record (&latest, 600 + STATE_JOURNAL_TESTING_RECORDS - 1, state, 1);
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 0), &old);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 0), &old);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (2, 0),
+		&first);
+
+	for (mid = 128; mid < STATE_JOURNAL_TESTING_RECORDS; mid += (STATE_JOURNAL_TESTING_RECORDS -
+		mid) / 2) {
+		status |= state_journal_testing_expect_read (&journal,
+			state_journal_testing_addr (2, mid),
+			(mid == (STATE_JOURNAL_TESTING_RECORDS - 1)) ? &latest : &first);
+		if (mid == (STATE_JOURNAL_TESTING_RECORDS - 1)) {
+			break;
+		}
+	}
+
+	status |= state_journal_testing_expect_read (&journal,
+		state_journal_testing_addr (2, STATE_JOURNAL_TESTING_RECORDS - 1), &latest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, journal.state.stored_count);
+	CuAssertIntEquals (test, latest.sequence, journal.state.sequence);
+	CuAssertIntEquals (test, STATE_JOURNAL_TESTING_BASE, journal.state.next_addr);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_find_latest_sector_wrap (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record sector0;
+	struct state_journal_record sector1;
+	struct state_journal_record sector2;
+	uint16_t state[] = {0x3333};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&sector0, 600, state, 1);
+	state_journal_testing_build_record (&sector1, 88, state, 1);
+	state_journal_testing_build_record (&sector2, 344, state, 1);
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 0),
+		&sector0);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 0),
+		&sector1);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (2, 0),
+		&sector2);
+
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 128),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 64),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 32),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 16),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 8),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 4),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 2),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 1),
+		&journal.blank);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, journal.state.stored_count);
+	CuAssertIntEquals (test, 600, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_last_record_corrupt (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record first;
+	struct state_journal_record valid;
+	struct state_journal_record corrupt;
+	uint16_t state[] = {0x3333, 0x4444};
+	uint16_t new_state[] = {0x5555, 0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&first, 50, state, 2);
+	state_journal_testing_build_record (&valid, 52, state, 2);
+	state_journal_testing_build_record (&corrupt, 53, new_state, 2);
+	corrupt.crc ^= 0x55;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 0),
+		&first);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 0),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (2, 0),
+		&journal.blank);
+
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 128),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 64),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 32),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 16),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 8),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 4),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 2),
+		&valid);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 3),
+		&corrupt);
+
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 3),
+		&corrupt);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 2),
+		&valid);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, journal.state.stored_count);
+	CuAssertIntEquals (test, 0x3333, journal.state.stored[0]);
+	CuAssertIntEquals (test, 0x4444, journal.state.stored[1]);
+	CuAssertIntEquals (test, 52, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 4), journal.state.next_addr);
+	CuAssertIntEquals (test, true, journal.state.force_write);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_corrupt_record_before_latest (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record first;
+	struct state_journal_record corrupt;
+	struct state_journal_record valid;
+	struct state_journal_record latest;
+	uint16_t state[] = {0x3333, 0x4444};
+	uint16_t new_state[] = {0x5555, 0x4444};
+	int status;
+
+	TEST_START;
+
+	/* A failed write in the middle of the sector leaves a record that is not valid, but it is not
+	 * blank and doesn't prevent finding the records written after it. */
+	state_journal_testing_build_record (&first, 50, state, 2);
+	state_journal_testing_build_record (&corrupt, 53, new_state, 2);
+	corrupt.crc ^= 0x55;
+	state_journal_testing_build_record (&valid, 53, new_state, 2);
+	state_journal_testing_build_record (&latest, 54, new_state, 2);
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 0),
+		&first);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 0),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (2, 0),
+		&journal.blank);
+
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 128),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 64),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 32),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 16),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 8),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 4),
+		&valid);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 6),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 5),
+		&latest);
+
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 5),
+		&latest);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, journal.state.stored_count);
+	CuAssertIntEquals (test, 0x5555, journal.state.stored[0]);
+	CuAssertIntEquals (test, 0x4444, journal.state.stored[1]);
+	CuAssertIntEquals (test, 54, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 6), journal.state.next_addr);
+	CuAssertIntEquals (test, false, journal.state.force_write);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_first_record_corrupt (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record corrupt;
+	uint16_t state[] = {0x3333};
+	int status;
+
+	TEST_START;
+
+	/* An interrupted write of the first record in a new sector leaves the previous sector with the
+	 * latest state. */
+	state_journal_testing_build_record (&latest, STATE_JOURNAL_TESTING_RECORDS, state, 1);
+	state_journal_testing_build_record (&corrupt, STATE_JOURNAL_TESTING_RECORDS + 1, state, 1);
+	corrupt.sequence = 0x12;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 0),
+		&latest);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 0),
+		&corrupt);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (2, 0),
+		&journal.blank);
+
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 128),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 64),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 32),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 16),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 8),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 4),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 2),
+		&journal.blank);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 1),
+		&journal.blank);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, journal.state.stored_count);
+	CuAssertIntEquals (test, STATE_JOURNAL_TESTING_RECORDS, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_not_journal_data (CuTest *test)
+{
+	struct state_journal_testing journal;
+	uint16_t legacy[8] = {0xff80, 0xff80, 0xff80, 0x0000, 0xffff, 0xffff, 0xffff, 0xffff};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 0),
+		(struct state_journal_record*) legacy);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (1, 0),
+		(struct state_journal_record*) legacy);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (2, 0),
+		&journal.blank);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, journal.state.stored_count);
+	CuAssertIntEquals (test, STATE_JOURNAL_TESTING_BASE, journal.state.next_addr);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_init_null (CuTest *test)
+{
+	struct state_journal_testing journal;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_init (NULL, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_journal_init (&journal.test, NULL, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_journal_init (&journal.test, &journal.state, NULL,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&journal.flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void state_journal_test_init_too_few_sectors (CuTest *test)
+{
+	struct state_journal_testing journal;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_MIN_SECTORS - 1);
+	CuAssertIntEquals (test, STATE_MANAGER_OUT_OF_RANGE, status);
+
+	status = flash_mock_validate_and_release (&journal.flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void state_journal_test_init_not_sector_aligned (CuTest *test)
+{
+	struct state_journal_testing journal;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE + 0x100, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, STATE_MANAGER_NOT_SECTOR_ALIGNED, status);
+
+	status = flash_mock_validate_and_release (&journal.flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void state_journal_test_init_sector_size_error (CuTest *test)
+{
+	struct state_journal_testing journal;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = mock_expect (&journal.flash.mock, journal.flash.base.get_sector_size, &journal.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	status = flash_mock_validate_and_release (&journal.flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void state_journal_test_init_read_error (CuTest *test)
+{
+	struct state_journal_testing journal;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= mock_expect (&journal.flash.mock, journal.flash.base.read, &journal.flash,
+		FLASH_READ_FAILED, MOCK_ARG (STATE_JOURNAL_TESTING_BASE), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (struct state_journal_record)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal.test, &journal.state, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&journal.flash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void state_journal_test_static_init (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal test_static = state_journal_static_init (&journal.state,
+		&journal.flash.base, STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_dependencies (test, &journal);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	for (i = 0; i < STATE_JOURNAL_TESTING_SECTORS; i++) {
+		status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (i, 0),
+			&journal.blank);
+	}
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, journal.state.stored_count);
+	CuAssertIntEquals (test, STATE_JOURNAL_TESTING_BASE, journal.state.next_addr);
+
+	status = flash_mock_validate_and_release (&journal.flash);
+	CuAssertIntEquals (test, 0, status);
+
+	state_journal_release (&test_static);
+}
+
+static void state_journal_test_static_init_null (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal null_state = state_journal_static_init (NULL, &journal.flash.base,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	struct state_journal null_flash = state_journal_static_init (&journal.state, NULL,
+		STATE_JOURNAL_TESTING_BASE, STATE_JOURNAL_TESTING_SECTORS);
+	int status;
+
+	TEST_START;
+
+	status = state_journal_init_state (NULL);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_journal_init_state (&null_state);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_journal_init_state (&null_flash);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+}
+
+static void state_journal_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	state_journal_release (NULL);
+}
+
+static void state_journal_test_attach (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_manager manager1;
+	struct state_manager manager2;
+	uint16_t state[] = {0x3333, 0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 2);
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_journal_attach (&journal.test, &manager1, 1);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x4444, manager1.nv_state);
+	CuAssertIntEquals (test, 0x4444, manager1.last_nv_stored);
+	CuAssertPtrEquals (test, &manager1, journal.state.managers[1]);
+
+	/* The state for managers not in the latest record is the default. */
+	status = state_journal_attach (&journal.test, &manager2, 2);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0xffff, manager2.nv_state);
+	CuAssertPtrEquals (test, &manager2, journal.state.managers[2]);
+
+	state_journal_detach (&journal.test, 1);
+	CuAssertPtrEquals (test, NULL, journal.state.managers[1]);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_attach_null (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_manager manager;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_blank (test, &journal);
+
+	status = state_journal_attach (NULL, &manager, 0);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_journal_attach (&journal.test, NULL, 0);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_attach_out_of_range (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_manager manager;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_blank (test, &journal);
+
+	status = state_journal_attach (&journal.test, &manager, STATE_JOURNAL_MAX_STATES);
+	CuAssertIntEquals (test, STATE_MANAGER_OUT_OF_RANGE, status);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_attach_index_in_use (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_manager manager1;
+	struct state_manager manager2;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_blank (test, &journal);
+
+	status = state_journal_attach (&journal.test, &manager1, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_attach (&journal.test, &manager2, 1);
+	CuAssertIntEquals (test, STATE_MANAGER_INDEX_IN_USE, status);
+	CuAssertPtrEquals (test, &manager1, journal.state.managers[1]);
+
+	/* The same manager can be attached again. */
+	status = state_journal_attach (&journal.test, &manager1, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The index can be used once the previous manager is detached. */
+	state_journal_detach (&journal.test, 1);
+
+	status = state_journal_attach (&journal.test, &manager2, 1);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &manager2, journal.state.managers[1]);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager1;
+	struct state_manager manager2;
+	uint16_t state[] = {0x3333, 0x4444};
+	uint16_t new_state[] = {0x3333, 0x5555};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 2);
+	state_journal_testing_build_record (&expected, 11, new_state, 2);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager1, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init_journal (&manager2, &journal.test, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	manager2.nv_state = 0x5555;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 1),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 11, journal.state.sequence);
+	CuAssertIntEquals (test, 0x5555, journal.state.stored[1]);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 2), journal.state.next_addr);
+
+	state_manager_release (&manager1);
+	state_manager_release (&manager2);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_no_change (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_manager manager1;
+	struct state_manager manager2;
+	uint16_t state[] = {0x3333, 0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 2);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager1, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init_journal (&manager2, &journal.test, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Nothing is read from or written to flash when the state hasn't changed. */
+	status = state_journal_testing_expect_sector_size (&journal);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 10, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+
+	state_manager_release (&manager1);
+	state_manager_release (&manager2);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_new_state (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager1;
+	struct state_manager manager2;
+	uint16_t state[] = {0x3333};
+	uint16_t new_state[] = {0x3333, 0xffff, 0x1234};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 1);
+	state_journal_testing_build_record (&expected, 11, new_state, 3);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager1, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init_journal (&manager2, &journal.test, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	manager2.nv_state = 0x1234;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 1),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 3, journal.state.stored_count);
+
+	state_manager_release (&manager1);
+	state_manager_release (&manager2);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_detached_manager (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager;
+	uint16_t state[] = {0x3333, 0x4444};
+	uint16_t new_state[] = {0x5555, 0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 2);
+	state_journal_testing_build_record (&expected, 11, new_state, 2);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x5555;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 1),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_blank_journal (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record expected;
+	struct state_manager manager;
+	uint16_t state[] = {0x1234};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&expected, 1, state, 1);
+
+	state_journal_testing_init_blank (test, &journal);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0xffff, manager.nv_state);
+
+	manager.nv_state = 0x1234;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= flash_mock_expect_erase_flash_sector_verify (&journal.flash,
+		STATE_JOURNAL_TESTING_BASE, FLASH_SECTOR_SIZE);
+	status |= state_journal_testing_expect_write (&journal, STATE_JOURNAL_TESTING_BASE, &expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_next_sector (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager;
+	uint16_t state[] = {0x3333};
+	uint16_t new_state[] = {0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 1000, state, 1);
+	state_journal_testing_build_record (&expected, 1001, new_state, 1);
+
+	state_journal_testing_init_first_sector (test, &journal, STATE_JOURNAL_TESTING_RECORDS - 1,
+		&latest);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x4444;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= flash_mock_expect_erase_flash_sector_verify (&journal.flash,
+		state_journal_testing_addr (1, 0), FLASH_SECTOR_SIZE);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (1, 0),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1001, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (1, 1), journal.state.next_addr);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_wrap (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record expected;
+	struct state_manager manager;
+	uint16_t new_state[] = {0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&expected, 1, new_state, 1);
+
+	state_journal_testing_init_blank (test, &journal);
+	journal.state.next_addr = state_journal_testing_addr (2, STATE_JOURNAL_TESTING_RECORDS - 1);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x4444;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal,
+		state_journal_testing_addr (2, STATE_JOURNAL_TESTING_RECORDS - 1), &expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, STATE_JOURNAL_TESTING_BASE, journal.state.next_addr);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_force_write (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager;
+	uint16_t state[] = {0x3333};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 1);
+	state_journal_testing_build_record (&expected, 11, state, 1);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+	journal.state.force_write = true;
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 1),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, journal.state.force_write);
+
+	status = mock_validate (&journal.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Once the state is stored, there is no need to write it again. */
+	status = state_journal_testing_expect_sector_size (&journal);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_through_state_manager (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager1;
+	struct state_manager manager2;
+	uint16_t state[] = {0x3333, 0x4444};
+	uint16_t new_state[] = {0x1111, 0x2222};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 2);
+	state_journal_testing_build_record (&expected, 11, new_state, 2);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager1, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init_journal (&manager2, &journal.test, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	manager1.nv_state = 0x1111;
+	manager2.nv_state = 0x2222;
+
+	/* Storing either manager saves the state for both, so only one record is written. */
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 1),
+		&expected);
+	status |= state_journal_testing_expect_sector_size (&journal);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_store_non_volatile_state (&manager1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_store_non_volatile_state (&manager2);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_release (&manager1);
+	state_manager_release (&manager2);
+
+	CuAssertPtrEquals (test, NULL, journal.state.managers[0]);
+	CuAssertPtrEquals (test, NULL, journal.state.managers[1]);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_through_state_manager_storage_blocked (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_journal_record unblocked;
+	struct state_manager manager1;
+	struct state_manager manager2;
+	uint16_t state[] = {0x3333, 0x4444};
+	uint16_t new_state[] = {0x1111, 0x4444};
+	uint16_t unblocked_state[] = {0x1111, 0x2222};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 2);
+	state_journal_testing_build_record (&expected, 11, new_state, 2);
+	state_journal_testing_build_record (&unblocked, 12, unblocked_state, 2);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager1, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init_journal (&manager2, &journal.test, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_block_non_volatile_state_storage (&manager2, true);
+
+	manager1.nv_state = 0x1111;
+	manager2.nv_state = 0x2222;
+
+	/* The state for the blocked manager must not be written when storing through another manager. */
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 1),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_store_non_volatile_state (&manager1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, state_manager_has_unstored_state (&manager1));
+	CuAssertIntEquals (test, true, state_manager_has_unstored_state (&manager2));
+
+	status = mock_validate (&journal.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_block_non_volatile_state_storage (&manager2, false);
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 2),
+		&unblocked);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_store_non_volatile_state (&manager2);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, state_manager_has_unstored_state (&manager2));
+
+	state_manager_release (&manager1);
+	state_manager_release (&manager2);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = state_journal_store (NULL);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+}
+
+static void state_journal_test_store_sector_size_error (CuTest *test)
+{
+	struct state_journal_testing journal;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_blank (test, &journal);
+
+	status = mock_expect (&journal.flash.mock, journal.flash.base.get_sector_size, &journal.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_erase_error (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_manager manager;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_blank (test, &journal);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x1234;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= mock_expect (&journal.flash.mock, journal.flash.base.get_sector_size, &journal.flash,
+		FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE_FAILED, status);
+
+	/* The same location is used for the next attempt. */
+	CuAssertIntEquals (test, STATE_JOURNAL_TESTING_BASE, journal.state.next_addr);
+	CuAssertIntEquals (test, 0, journal.state.sequence);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_write_error (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_journal_record next;
+	struct state_manager manager;
+	uint16_t state[] = {0x3333};
+	uint16_t new_state[] = {0x4444};
+	uint16_t next_state[] = {0x5555};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 1);
+	state_journal_testing_build_record (&expected, 11, new_state, 1);
+	state_journal_testing_build_record (&next, 12, next_state, 1);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x4444;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= mock_expect (&journal.flash.mock, journal.flash.base.write, &journal.flash,
+		FLASH_WRITE_FAILED, MOCK_ARG (state_journal_testing_addr (0, 1)),
+		MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)), MOCK_ARG (sizeof (expected)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	CuAssertIntEquals (test, 10, journal.state.sequence);
+	CuAssertIntEquals (test, 0x3333, journal.state.stored[0]);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+
+	status = mock_validate (&journal.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Nothing was written, so the next attempt uses the same location. */
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 1),
+		&journal.blank);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 1),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 11, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 2), journal.state.next_addr);
+
+	status = mock_validate (&journal.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Once a record has been written, the next location is not checked. */
+	manager.nv_state = 0x5555;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 2),
+		&next);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_incomplete_write (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_journal_record partial;
+	struct state_manager manager;
+	uint16_t state[] = {0x3333};
+	uint16_t new_state[] = {0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 1);
+	state_journal_testing_build_record (&expected, 11, new_state, 1);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x4444;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= mock_expect (&journal.flash.mock, journal.flash.base.write, &journal.flash,
+		sizeof (expected) - 1, MOCK_ARG (state_journal_testing_addr (0, 1)),
+		MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)), MOCK_ARG (sizeof (expected)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, STATE_MANAGER_INCOMPLETE_WRITE, status);
+
+	CuAssertIntEquals (test, 10, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+
+	status = mock_validate (&journal.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The partially written record is skipped on the next attempt. */
+	partial = expected;
+	partial.crc = 0xff;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= state_journal_testing_expect_read (&journal, state_journal_testing_addr (0, 1),
+		&partial);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (0, 2),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 11, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 3), journal.state.next_addr);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_first_record_write_error (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager;
+	uint16_t state[] = {0x3333};
+	uint16_t new_state[] = {0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 1000, state, 1);
+	state_journal_testing_build_record (&expected, 1001, new_state, 1);
+
+	state_journal_testing_init_first_sector (test, &journal, STATE_JOURNAL_TESTING_RECORDS - 1,
+		&latest);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x4444;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= flash_mock_expect_erase_flash_sector_verify (&journal.flash,
+		state_journal_testing_addr (1, 0), FLASH_SECTOR_SIZE);
+	status |= mock_expect (&journal.flash.mock, journal.flash.base.write, &journal.flash,
+		sizeof (expected) - 1, MOCK_ARG (state_journal_testing_addr (1, 0)),
+		MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)), MOCK_ARG (sizeof (expected)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, STATE_MANAGER_INCOMPLETE_WRITE, status);
+
+	CuAssertIntEquals (test, 1000, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (1, 0), journal.state.next_addr);
+
+	status = mock_validate (&journal.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The first record determines if the sector has the latest state, so the sector is erased
+	 * again and the record rewritten instead of skipping it. */
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= flash_mock_expect_erase_flash_sector_verify (&journal.flash,
+		state_journal_testing_addr (1, 0), FLASH_SECTOR_SIZE);
+	status |= state_journal_testing_expect_write (&journal, state_journal_testing_addr (1, 0),
+		&expected);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1001, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (1, 1), journal.state.next_addr);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_store_check_blank_read_error (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_journal_record latest;
+	struct state_journal_record expected;
+	struct state_manager manager;
+	uint16_t state[] = {0x3333};
+	uint16_t new_state[] = {0x4444};
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_build_record (&latest, 10, state, 1);
+	state_journal_testing_build_record (&expected, 11, new_state, 1);
+
+	state_journal_testing_init_first_sector (test, &journal, 0, &latest);
+
+	status = state_manager_init_journal (&manager, &journal.test, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manager.nv_state = 0x4444;
+
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= mock_expect (&journal.flash.mock, journal.flash.base.write, &journal.flash,
+		FLASH_WRITE_FAILED, MOCK_ARG (state_journal_testing_addr (0, 1)),
+		MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)), MOCK_ARG (sizeof (expected)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, FLASH_WRITE_FAILED, status);
+
+	status = mock_validate (&journal.flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Nothing is written if the location can't be checked. */
+	status = state_journal_testing_expect_sector_size (&journal);
+	status |= mock_expect (&journal.flash.mock, journal.flash.base.read, &journal.flash,
+		FLASH_READ_FAILED, MOCK_ARG (state_journal_testing_addr (0, 1)), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (expected)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_store (&journal.test);
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	CuAssertIntEquals (test, 10, journal.state.sequence);
+	CuAssertIntEquals (test, state_journal_testing_addr (0, 1), journal.state.next_addr);
+	CuAssertIntEquals (test, true, journal.state.check_blank);
+
+	state_manager_release (&manager);
+
+	state_journal_testing_release (test, &journal);
+}
+
+static void state_journal_test_state_manager_init_journal_null (CuTest *test)
+{
+	struct state_journal_testing journal;
+	struct state_manager manager;
+	int status;
+
+	TEST_START;
+
+	state_journal_testing_init_blank (test, &journal);
+
+	status = state_manager_init_journal (NULL, &journal.test, 0);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_manager_init_journal (&manager, NULL, 0);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_manager_init_journal (&manager, &journal.test, STATE_JOURNAL_MAX_STATES);
+	CuAssertIntEquals (test, STATE_MANAGER_OUT_OF_RANGE, status);
+
+	state_journal_testing_release (test, &journal);
+}
+
+
+TEST_SUITE_START (state_journal);
+
+TEST (state_journal_test_init_blank);
+TEST (state_journal_test_init_find_latest);
+TEST (state_journal_test_init_find_latest_first_record);
+TEST (state_journal_test_init_find_latest_full_sector);
+TEST (state_journal_test_init_find_latest_last_sector_full);
+TEST (state_journal_test_init_find_latest_sector_wrap);
+TEST (state_journal_test_init_last_record_corrupt);
+TEST (state_journal_test_init_corrupt_record_before_latest);
+TEST (state_journal_test_init_first_record_corrupt);
+TEST (state_journal_test_init_not_journal_data);
+TEST (state_journal_test_init_null);
+TEST (state_journal_test_init_too_few_sectors);
+TEST (state_journal_test_init_not_sector_aligned);
+TEST (state_journal_test_init_sector_size_error);
+TEST (state_journal_test_init_read_error);
+TEST (state_journal_test_static_init);
+TEST (state_journal_test_static_init_null);
+TEST (state_journal_test_release_null);
+TEST (state_journal_test_attach);
+TEST (state_journal_test_attach_null);
+TEST (state_journal_test_attach_out_of_range);
+TEST (state_journal_test_attach_index_in_use);
+TEST (state_journal_test_store);
+TEST (state_journal_test_store_no_change);
+TEST (state_journal_test_store_new_state);
+TEST (state_journal_test_store_detached_manager);
+TEST (state_journal_test_store_blank_journal);
+TEST (state_journal_test_store_next_sector);
+TEST (state_journal_test_store_wrap);
+TEST (state_journal_test_store_force_write);
+TEST (state_journal_test_store_through_state_manager);
+TEST (state_journal_test_store_through_state_manager_storage_blocked);
+TEST (state_journal_test_store_null);
+TEST (state_journal_test_store_sector_size_error);
+TEST (state_journal_test_store_erase_error);
+TEST (state_journal_test_store_write_error);
+TEST (state_journal_test_store_incomplete_write);
+TEST (state_journal_test_store_first_record_write_error);
+TEST (state_journal_test_store_check_blank_read_error);
+TEST (state_journal_test_state_manager_init_journal_null);
+
+TEST_SUITE_END;
@@ -10,6 +10,8 @@
 #include "state_manager/state_logging.h"
 #include "state_manager/state_persistence_handler.h"
 #include "state_manager/state_persistence_handler_static.h"
+#include "state_manager/state_journal.h"
+#include "crypto/checksum.h"
 #include "testing/mock/flash/flash_mock.h"
 #include "testing/mock/logging/logging_mock.h"
 #include "testing/logging/debug_log_testing.h"
@@ -126,6 +128,34 @@ static void state_persistence_handler_testing_init (CuTest *test,
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Initialize an instance for testing that stores state changes within a deadline.  All state
+ * managers will start with no changes to store.
+ *
+ * @param test The testing framework.
+ * @param handler The testing components to initialize.
+ * @param manager_list List of state managers to use with the handler.
+ * @param manager_count Number of state managers in the list.
+ * @param period_ms Time between handler executions that store all state.
+ * @param deadline_ms Maximum time to wait before storing a state change.
+ */
+static void state_persistence_handler_testing_init_with_deadline (CuTest *test,
+	struct state_persistence_handler_testing *handler, struct state_manager **manager_list,
+	size_t manager_count, uint32_t period_ms, uint32_t deadline_ms)
+{
+	int status;
+
+	state_persistence_handler_testing_init_dependencies (test, handler);
+
+	handler->manager1.last_nv_stored = 0xffbf;
+	handler->manager2.last_nv_stored = 0xffbf;
+	handler->manager3.last_nv_stored = 0xffbf;
+
+	status = state_persistence_handler_init_with_deadline (&handler->test, &handler->state,
+		manager_list, manager_count, period_ms, deadline_ms);
+	CuAssertIntEquals (test, 0, status);
+}
+
 /**
  * Initialize a static, instance for testing.
  *
@@ -685,6 +715,643 @@ static void state_persistence_handler_test_execute_static_init (CuTest *test)
 	state_persistence_handler_release (&test_static);
 }
 
+static void state_persistence_handler_test_init_with_deadline (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_dependencies (test, &handler);
+
+	status = state_persistence_handler_init_with_deadline (&handler.test, &handler.state, list,
+		count, 1000, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, handler.test.base.prepare);
+	CuAssertPtrNotNull (test, handler.test.base.get_next_execution);
+	CuAssertPtrNotNull (test, handler.test.base.execute);
+
+	CuAssertPtrNotNull (test, handler.test.base_system.on_shutdown);
+
+	CuAssertIntEquals (test, 1000, handler.test.period);
+	CuAssertIntEquals (test, 100, handler.test.deadline);
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_init_with_deadline_null (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_dependencies (test, &handler);
+
+	status = state_persistence_handler_init_with_deadline (NULL, &handler.state, list, count,
+		1000, 100);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_persistence_handler_init_with_deadline (&handler.test, NULL, list, count, 1000,
+		100);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_persistence_handler_init_with_deadline (&handler.test, &handler.state, NULL,
+		count, 1000, 100);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_persistence_handler_init_with_deadline (&handler.test, &handler.state, list, 0,
+		1000, 100);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	status = state_persistence_handler_init_with_deadline (&handler.test, &handler.state, list,
+		count, 1000, 0);
+	CuAssertIntEquals (test, STATE_MANAGER_INVALID_ARGUMENT, status);
+
+	state_persistence_handler_testing_release_dependencies (test, &handler);
+}
+
+static void state_persistence_handler_test_static_init_with_deadline (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct state_persistence_handler test_static =
+		state_persistence_handler_static_init_with_deadline (&handler.state, list, count, 5000,
+		100);
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_dependencies (test, &handler);
+
+	CuAssertPtrNotNull (test, test_static.base.prepare);
+	CuAssertPtrNotNull (test, test_static.base.get_next_execution);
+	CuAssertPtrNotNull (test, test_static.base.execute);
+
+	CuAssertPtrNotNull (test, test_static.base_system.on_shutdown);
+
+	CuAssertIntEquals (test, 100, test_static.deadline);
+
+	status = state_persistence_handler_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	state_persistence_handler_testing_release_dependencies (test, &handler);
+	state_persistence_handler_release (&test_static);
+}
+
+static void state_persistence_handler_test_get_next_execution_deadline_no_changes (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 100);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	/* Without any changes, the handler still runs within the deadline to check for changes. */
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.poll, (void*) next_time);
+	CuAssertIntEquals (test, false, handler.state.pending);
+
+	status = platform_get_timeout_remaining (next_time, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 100));
+	CuAssertTrue (test, (msec > 50));	/* Apply reasonable bounds for testing. */
+
+	status = platform_get_timeout_remaining (&handler.state.next, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 1000));
+	CuAssertTrue (test, (msec > 950));	/* Apply reasonable bounds for testing. */
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_get_next_execution_deadline_no_changes_after_period (
+	CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 100, 1000);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	/* The periodic execution comes before the next check for changes. */
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.next, (void*) next_time);
+
+	status = platform_get_timeout_remaining (next_time, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 100));
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_get_next_execution_deadline_change_while_waiting (
+	CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 100);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.poll, (void*) next_time);
+
+	/* A change made while the task is waiting gets a deadline from the time of the change, which is
+	 * after the time the task will wake up. */
+	platform_msleep (50);
+
+	handler.manager2.nv_state = 0xfffe;
+	state_persistence_handler_notify_change (&handler.test);
+
+	status = platform_get_timeout_remaining (&handler.state.poll, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 50));
+
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.deadline, (void*) next_time);
+
+	status = platform_get_timeout_remaining (next_time, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 100));
+	CuAssertTrue (test, (msec > 50));	/* Apply reasonable bounds for testing. */
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_get_next_execution_deadline_state_changed (
+	CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 100);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	/* A change is detected without any notification. */
+	handler.manager2.nv_state = 0xfffe;
+
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.deadline, (void*) next_time);
+
+	status = platform_get_timeout_remaining (next_time, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 100));
+	CuAssertTrue (test, (msec > 50));	/* Apply reasonable bounds for testing. */
+
+	platform_msleep (50);
+
+	/* The deadline is not restarted while changes are pending. */
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.deadline, (void*) next_time);
+
+	status = platform_get_timeout_remaining (next_time, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 50));
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_get_next_execution_deadline_after_period (
+	CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 100, 1000);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	handler.manager1.nv_state = 0xfffe;
+
+	/* The periodic execution comes before the deadline. */
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.next, (void*) next_time);
+
+	status = platform_get_timeout_remaining (next_time, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 100));
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_get_next_execution_deadline_no_prepare (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 100);
+
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, NULL, (void*) next_time);
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_notify_change (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 100);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	state_persistence_handler_notify_change (&handler.test);
+	CuAssertIntEquals (test, true, handler.state.pending);
+
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.deadline, (void*) next_time);
+
+	status = platform_get_timeout_remaining (next_time, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 100));
+	CuAssertTrue (test, (msec > 50));	/* Apply reasonable bounds for testing. */
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_notify_change_no_deadline (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init (test, &handler, list, count, 1000);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	state_persistence_handler_notify_change (&handler.test);
+	CuAssertIntEquals (test, false, handler.state.pending);
+
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.next, (void*) next_time);
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_notify_change_null (CuTest *test)
+{
+	TEST_START;
+
+	state_persistence_handler_notify_change (NULL);
+}
+
+static void state_persistence_handler_test_execute_deadline (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+	uint16_t expected[4] = {0xffbe, 0xffbe, 0xffbe, 0};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 100);
+
+	/* Only manager2 has changes to store. */
+	status = mock_expect (&handler.flash2.mock, handler.flash2.base.get_sector_size,
+		&handler.flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&handler.flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&handler.flash2.mock, handler.flash2.base.write, &handler.flash2,
+		sizeof (expected), MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	status |= flash_mock_expect_erase_flash_sector_verify (&handler.flash2, 0x11000, 0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	handler.manager2.nv_state = 0xfffe;
+
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.deadline, (void*) next_time);
+
+	platform_msleep (150);
+
+	handler.test.base.execute (&handler.test.base);
+
+	CuAssertIntEquals (test, false, state_manager_has_unstored_state (&handler.manager2));
+	CuAssertIntEquals (test, false, handler.state.pending);
+
+	/* The periodic timeout is not restarted. */
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.poll, (void*) next_time);
+
+	status = platform_get_timeout_remaining (&handler.state.next, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 850));
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_execute_deadline_failure (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	int status;
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = DEBUG_LOG_SEVERITY_ERROR,
+		.component = DEBUG_LOG_COMPONENT_STATE_MGR,
+		.msg_index = STATE_LOGGING_PERSIST_FAIL,
+		.arg1 = 2,
+		.arg2 = FLASH_SECTOR_SIZE_FAILED
+	};
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 100);
+
+	status = mock_expect (&handler.flash3.mock, handler.flash3.base.get_sector_size,
+		&handler.flash3, FLASH_SECTOR_SIZE_FAILED, MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&handler.log.mock, handler.log.base.create_entry, &handler.log, 0,
+		MOCK_ARG_PTR_CONTAINS_TMP ((uint8_t*) &entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	handler.manager3.nv_state = 0xfffe;
+	state_persistence_handler_notify_change (&handler.test);
+
+	handler.test.base.execute (&handler.test.base);
+
+	/* The change is still pending, so a new deadline is started. */
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.deadline, (void*) next_time);
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_execute_deadline_period_expired (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	const platform_clock *next_time;
+	uint32_t msec;
+	int status;
+	uint16_t expected[4] = {0xffbe, 0xffbe, 0xffbe, 0};
+	uint16_t stored[4] = {0xffbf, 0xffbf, 0xffbf, 0};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 100, 50);
+
+	/* When the period expires, the state for all managers is stored. */
+	status = mock_expect (&handler.flash1.mock, handler.flash1.base.get_sector_size,
+		&handler.flash1, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&handler.flash1.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&handler.flash1.mock, handler.flash1.base.write, &handler.flash1,
+		sizeof (expected), MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	status |= flash_mock_expect_erase_flash_sector_verify (&handler.flash1, 0x11000, 0x1000);
+
+	status |= mock_expect (&handler.flash2.mock, handler.flash2.base.get_sector_size,
+		&handler.flash2, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&handler.flash2.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&handler.flash2.mock, handler.flash2.base.read, &handler.flash2, 0,
+		MOCK_ARG (0x11ff8), MOCK_ARG_NOT_NULL, MOCK_ARG (8));
+	status |= mock_expect_output (&handler.flash2.mock, 1, stored, sizeof (stored), 2);
+
+	status |= mock_expect (&handler.flash3.mock, handler.flash3.base.get_sector_size,
+		&handler.flash3, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&handler.flash3.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&handler.flash3.mock, handler.flash3.base.read, &handler.flash3, 0,
+		MOCK_ARG (0x11ff8), MOCK_ARG_NOT_NULL, MOCK_ARG (8));
+	status |= mock_expect_output (&handler.flash3.mock, 1, stored, sizeof (stored), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	handler.test.base.prepare (&handler.test.base);
+	platform_msleep (150);
+
+	handler.manager1.nv_state = 0xfffe;
+
+	handler.test.base.execute (&handler.test.base);
+
+	/* Check the the timeout has been updated. */
+	next_time = handler.test.base.get_next_execution (&handler.test.base);
+	CuAssertPtrEquals (test, &handler.state.poll, (void*) next_time);
+
+	status = platform_get_timeout_remaining (&handler.state.next, &msec);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (msec <= 100));
+	CuAssertTrue (test, (msec > 50));	/* Apply reasonable bounds for testing. */
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_execute_deadline_shared_journal (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_journal_state journal_state;
+	struct state_journal journal;
+	struct state_manager journal1;
+	struct state_manager journal2;
+	struct state_manager *list[] = {&journal1, &journal2};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct state_journal_record blank;
+	struct state_journal_record expected;
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+	int status;
+
+	TEST_START;
+
+	memset (&blank, 0xff, sizeof (blank));
+
+	memset (&expected, 0xff, sizeof (expected));
+	expected.sequence = 1;
+	expected.state[0] = 0x1111;
+	expected.state[1] = 0x2222;
+	expected.count = 2;
+	expected.crc = checksum_update_smbus_crc8 (0, (uint8_t*) &expected,
+		offsetof (struct state_journal_record, crc));
+
+	state_persistence_handler_testing_init_dependencies (test, &handler);
+
+	status = mock_expect (&handler.flash1.mock, handler.flash1.base.get_sector_size,
+		&handler.flash1, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&handler.flash1.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&handler.flash1.mock, handler.flash1.base.read, &handler.flash1, 0,
+		MOCK_ARG (0x20000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (blank)));
+	status |= mock_expect_output (&handler.flash1.mock, 1, &blank, sizeof (blank), 2);
+
+	status |= mock_expect (&handler.flash1.mock, handler.flash1.base.read, &handler.flash1, 0,
+		MOCK_ARG (0x21000), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (blank)));
+	status |= mock_expect_output (&handler.flash1.mock, 1, &blank, sizeof (blank), 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_journal_init (&journal, &journal_state, &handler.flash1.base, 0x20000, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init_journal (&journal1, &journal, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_manager_init_journal (&journal2, &journal, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = state_persistence_handler_init_with_deadline (&handler.test, &handler.state, list,
+		count, 1000, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Changes to both managers are stored in a single record. */
+	status = mock_expect (&handler.flash1.mock, handler.flash1.base.get_sector_size,
+		&handler.flash1, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&handler.flash1.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= flash_mock_expect_erase_flash_sector_verify (&handler.flash1, 0x20000, 0x1000);
+
+	status |= mock_expect (&handler.flash1.mock, handler.flash1.base.write, &handler.flash1,
+		sizeof (expected), MOCK_ARG (0x20000), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	journal1.nv_state = 0x1111;
+	journal2.nv_state = 0x2222;
+	state_persistence_handler_notify_change (&handler.test);
+
+	handler.test.base.execute (&handler.test.base);
+
+	CuAssertIntEquals (test, false, state_manager_has_unstored_state (&journal1));
+	CuAssertIntEquals (test, false, state_manager_has_unstored_state (&journal2));
+
+	state_manager_release (&journal1);
+	state_manager_release (&journal2);
+	state_journal_release (&journal);
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_on_shutdown (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	int status;
+	uint16_t expected[4] = {0xffbe, 0xffbe, 0xffbe, 0};
+	uint32_t bytes = FLASH_SECTOR_SIZE;
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 500);
+
+	status = mock_expect (&handler.flash1.mock, handler.flash1.base.get_sector_size,
+		&handler.flash1, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&handler.flash1.mock, 0, &bytes, sizeof (bytes), -1);
+
+	status |= mock_expect (&handler.flash1.mock, handler.flash1.base.write, &handler.flash1,
+		sizeof (expected), MOCK_ARG (0x10000), MOCK_ARG_PTR_CONTAINS (&expected, sizeof (expected)),
+		MOCK_ARG (sizeof (expected)));
+
+	status |= flash_mock_expect_erase_flash_sector_verify (&handler.flash1, 0x11000, 0x1000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	handler.manager1.nv_state = 0xfffe;
+	state_persistence_handler_notify_change (&handler.test);
+
+	/* Changes are stored immediately without waiting for the deadline. */
+	handler.test.base_system.on_shutdown (&handler.test.base_system);
+
+	CuAssertIntEquals (test, false, state_manager_has_unstored_state (&handler.manager1));
+	CuAssertIntEquals (test, false, handler.state.pending);
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
+static void state_persistence_handler_test_on_shutdown_no_changes (CuTest *test)
+{
+	struct state_persistence_handler_testing handler;
+	struct state_manager *list[] = {&handler.manager1, &handler.manager2, &handler.manager3};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+
+	TEST_START;
+
+	state_persistence_handler_testing_init_with_deadline (test, &handler, list, count, 1000, 500);
+
+	handler.test.base.prepare (&handler.test.base);
+
+	handler.test.base_system.on_shutdown (&handler.test.base_system);
+
+	state_persistence_handler_testing_validate_and_release (test, &handler);
+}
+
 
 TEST_SUITE_START (state_persistence_handler);
 
@@ -701,5 +1368,23 @@ TEST (state_persistence_handler_test_execute_failure);
 TEST (state_persistence_handler_test_execute_multiple_managers);
 TEST (state_persistence_handler_test_execute_multiple_managers_failure);
 TEST (state_persistence_handler_test_execute_static_init);
+TEST (state_persistence_handler_test_init_with_deadline);
+TEST (state_persistence_handler_test_init_with_deadline_null);
+TEST (state_persistence_handler_test_static_init_with_deadline);
+TEST (state_persistence_handler_test_get_next_execution_deadline_no_changes);
+TEST (state_persistence_handler_test_get_next_execution_deadline_no_changes_after_period);
+TEST (state_persistence_handler_test_get_next_execution_deadline_change_while_waiting);
+TEST (state_persistence_handler_test_get_next_execution_deadline_state_changed);
+TEST (state_persistence_handler_test_get_next_execution_deadline_after_period);
+TEST (state_persistence_handler_test_get_next_execution_deadline_no_prepare);
+TEST (state_persistence_handler_test_notify_change);
+TEST (state_persistence_handler_test_notify_change_no_deadline);
+TEST (state_persistence_handler_test_notify_change_null);
+TEST (state_persistence_handler_test_execute_deadline);
+TEST (state_persistence_handler_test_execute_deadline_failure);
+TEST (state_persistence_handler_test_execute_deadline_period_expired);
+TEST (state_persistence_handler_test_execute_deadline_shared_journal);
+TEST (state_persistence_handler_test_on_shutdown);
+TEST (state_persistence_handler_test_on_shutdown_no_changes);
 
 TEST_SUITE_END;
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "cmd_dispatch_freertos.h"
+
+
+/**
+ * Task routine for executing dispatched requests.  The task deletes itself once the queue has been
+ * stopped.
+ *
+ * @param pool The worker pool for the task.
+ */
+static void cmd_dispatch_freertos_task (struct cmd_dispatch_freertos *pool)
+{
+	cmd_dispatch_run (pool->dispatch);
+
+	xSemaphoreGive (pool->exited);
+	vTaskDelete (NULL);
+}
+
+/**
+ * Start a pool of tasks to execute requests submitted to a dispatch queue.
+ *
+ * If any task fails to start, the dispatch queue will be stopped and all tasks that were started
+ * will exit.
+ *
+ * @param pool The worker pool to initialize.
+ * @param dispatch The queue that will be processed by the tasks.
+ * @param tasks Storage for the task handles.  This must remain valid until the pool is stopped.
+ * @param count The number of tasks to start.
+ * @param stack_words The size of each task stack.  The stack size is measured in words.
+ * @param priority The priority to assign to the tasks.  This would typically be lower than the
+ * priority of the tasks receiving packets so reception is not blocked by command execution.
+ *
+ * @return 0 if all tasks were started or an error code.
+ */
+int cmd_dispatch_freertos_start (struct cmd_dispatch_freertos *pool,
+	struct cmd_dispatch *dispatch, TaskHandle_t *tasks, size_t count, uint16_t stack_words,
+	int priority)
+{
+	int status;
+
+	if ((pool == NULL) || (dispatch == NULL) || (tasks == NULL) || (count == 0)) {
+		return CMD_DISPATCH_INVALID_ARGUMENT;
+	}
+
+	memset (pool, 0, sizeof (struct cmd_dispatch_freertos));
+
+	pool->dispatch = dispatch;
+	pool->tasks = tasks;
+	pool->exited = xSemaphoreCreateCounting (count, 0);
+	if (pool->exited == NULL) {
+		return CMD_DISPATCH_NO_MEMORY;
+	}
+
+	while (pool->count < count) {
+		status = xTaskCreate ((TaskFunction_t) cmd_dispatch_freertos_task, "CmdDisp", stack_words,
+			pool, priority, &tasks[pool->count]);
+		if (status != pdPASS) {
+			tasks[pool->count] = NULL;
+			cmd_dispatch_freertos_stop (pool);
+			return CMD_DISPATCH_NO_MEMORY;
+		}
+
+		pool->count++;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop the dispatch queue and wait for all worker tasks to exit.  All requests submitted before the
+ * queue was stopped will be executed.
+ *
+ * @param pool The worker pool to stop.
+ */
+void cmd_dispatch_freertos_stop (struct cmd_dispatch_freertos *pool)
+{
+	size_t i;
+
+	if ((pool != NULL) && (pool->exited != NULL)) {
+		cmd_dispatch_stop (pool->dispatch);
+
+		for (i = 0; i < pool->count; i++) {
+			xSemaphoreTake (pool->exited, portMAX_DELAY);
+			pool->tasks[i] = NULL;
+		}
+
+		vSemaphoreDelete (pool->exited);
+		pool->exited = NULL;
+		pool->count = 0;
+	}
+}
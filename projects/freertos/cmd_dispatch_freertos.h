@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_DISPATCH_FREERTOS_H_
+#define CMD_DISPATCH_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "cmd_interface/cmd_dispatch.h"
+
+
+/**
+ * Pool of FreeRTOS worker tasks for executing dispatched requests.
+ */
+struct cmd_dispatch_freertos {
+	struct cmd_dispatch *dispatch;	/**< The queue being processed by the tasks. */
+	TaskHandle_t *tasks;			/**< The tasks executing requests. */
+	size_t count;					/**< The number of running tasks. */
+	SemaphoreHandle_t exited;		/**< Signal that a task has finished processing. */
+};
+
+
+int cmd_dispatch_freertos_start (struct cmd_dispatch_freertos *pool,
+	struct cmd_dispatch *dispatch, TaskHandle_t *tasks, size_t count, uint16_t stack_words,
+	int priority);
+void cmd_dispatch_freertos_stop (struct cmd_dispatch_freertos *pool);
+
+
+#endif /* CMD_DISPATCH_FREERTOS_H_ */
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "flash_queue_freertos.h"
+
+
+/**
+ * Task routine for processing queued flash requests.  The task deletes itself once the queue has
+ * been stopped.
+ *
+ * @param worker The worker context for the task.
+ */
+static void flash_queue_freertos_task (struct flash_queue_freertos *worker)
+{
+	flash_queue_run (worker->queue);
+
+	xSemaphoreGive (worker->exited);
+	vTaskDelete (NULL);
+}
+
+/**
+ * Start a task to execute flash requests submitted to a queue.
+ *
+ * @param worker The worker context to initialize.
+ * @param queue The queue that will be processed by the task.
+ * @param stack_words The size of the task stack.  The stack size is measured in words.
+ * @param priority The priority to assign to the task.  This would typically be higher than the
+ * priority of the tasks submitting requests so queued operations are started promptly.
+ *
+ * @return 0 if the task was started or an error code.
+ */
+int flash_queue_freertos_start (struct flash_queue_freertos *worker, struct flash_queue *queue,
+	uint16_t stack_words, int priority)
+{
+	int status;
+
+	if ((worker == NULL) || (queue == NULL)) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	memset (worker, 0, sizeof (struct flash_queue_freertos));
+
+	worker->queue = queue;
+	worker->exited = xSemaphoreCreateBinary ();
+	if (worker->exited == NULL) {
+		return FLASH_QUEUE_NO_MEMORY;
+	}
+
+	status = xTaskCreate ((TaskFunction_t) flash_queue_freertos_task, "FlashQ", stack_words,
+		worker, priority, &worker->task);
+	if (status != pdPASS) {
+		vSemaphoreDelete (worker->exited);
+		worker->exited = NULL;
+		worker->task = NULL;
+		return FLASH_QUEUE_NO_MEMORY;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop the queue and wait for the worker task to exit.  All requests submitted before the queue was
+ * stopped will be executed.
+ *
+ * @param worker The worker context to stop.
+ */
+void flash_queue_freertos_stop (struct flash_queue_freertos *worker)
+{
+	if ((worker != NULL) && (worker->task != NULL)) {
+		flash_queue_stop (worker->queue);
+		xSemaphoreTake (worker->exited, portMAX_DELAY);
+
+		vSemaphoreDelete (worker->exited);
+		worker->exited = NULL;
+		worker->task = NULL;
+	}
+}
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_QUEUE_FREERTOS_H_
+#define FLASH_QUEUE_FREERTOS_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "flash/flash_queue.h"
+
+
+/**
+ * FreeRTOS worker task for executing queued flash requests.
+ */
+struct flash_queue_freertos {
+	struct flash_queue *queue;		/**< The queue being processed by the task. */
+	TaskHandle_t task;				/**< The task executing flash requests. */
+	SemaphoreHandle_t exited;		/**< Signal that the task has finished processing. */
+};
+
+
+int flash_queue_freertos_start (struct flash_queue_freertos *worker, struct flash_queue *queue,
+	uint16_t stack_words, int priority);
+void flash_queue_freertos_stop (struct flash_queue_freertos *worker);
+
+
+#endif /* FLASH_QUEUE_FREERTOS_H_ */
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include "host_fw_verify_freertos.h"
+#include "semphr.h"
+
+
+/**
+ * Context for a single verification task.
+ */
+struct host_fw_verify_freertos_worker {
+	struct host_fw_verify_work *work;				/**< The shared verification work. */
+	const struct host_fw_verify_engines *engines;	/**< Engines dedicated to the task. */
+	SemaphoreHandle_t done;							/**< Signal for task completion. */
+};
+
+/**
+ * Task entry point for image verification.  The task deletes itself when there are no more images
+ * to verify.
+ *
+ * @param worker The worker context.
+ */
+static void host_fw_verify_freertos_task (struct host_fw_verify_freertos_worker *worker)
+{
+	host_fw_verify_work_run (worker->work, worker->engines);
+
+	xSemaphoreGive (worker->done);
+	vTaskDelete (NULL);
+}
+
+/**
+ * Verify that images from multiple different firmware components on the flash are valid, using a
+ * separate task for each set of engines.  Only images flagged for validation will be checked.
+ *
+ * The calling task verifies images with the first set of engines while additional tasks are
+ * running.  If any task cannot be created, verification continues with the remaining workers.
+ *
+ * All image addresses specified in the PFM will be offset by a fixed amount.
+ *
+ * @param flash The flash that contains the images to validate.
+ * @param img_list An array of firmware images that should be validated.
+ * @param fw_count The number of firmware components in the list.
+ * @param offset The offset to apply to image addresses.
+ * @param engines The engines to use for verification.  Each entry must have a unique hash engine
+ * and, if one is provided, a unique hashing pipeline.
+ * @param engine_count The number of engine sets, which determines the number of workers.
+ * @param stack_words The size of the stack for each verification task.  The stack size is measured
+ * in words.
+ * @param priority The priority to assign to the verification tasks.
+ *
+ * @return 0 if all images that should be validated are good or an error code.  Image verification
+ * errors are the same as reported by host_fw_verify_offset_images_multiple_fw.
+ */
+int host_fw_verify_offset_images_multiple_fw_freertos (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset,
+	const struct host_fw_verify_engines *engines, size_t engine_count, uint16_t stack_words,
+	int priority)
+{
+	struct host_fw_verify_work work;
+	struct host_fw_verify_freertos_worker *workers = NULL;
+	SemaphoreHandle_t done = NULL;
+	size_t started = 0;
+	size_t i;
+	int status;
+
+	if ((engines == NULL) || (engine_count == 0)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < engine_count; i++) {
+		if ((engines[i].hash == NULL) || (engines[i].rsa == NULL)) {
+			return HOST_FW_UTIL_INVALID_ARGUMENT;
+		}
+	}
+
+	status = host_fw_verify_work_init (&work, flash, img_list, fw_count, offset);
+	if (status != 0) {
+		return status;
+	}
+
+	if (engine_count > 1) {
+		workers = platform_calloc (engine_count - 1,
+			sizeof (struct host_fw_verify_freertos_worker));
+		done = xSemaphoreCreateCounting (engine_count - 1, 0);
+		if ((workers == NULL) || (done == NULL)) {
+			/* Fall back to verifying everything from the calling task. */
+			engine_count = 1;
+		}
+	}
+
+	for (i = 1; i < engine_count; i++) {
+		workers[i - 1].work = &work;
+		workers[i - 1].engines = &engines[i];
+		workers[i - 1].done = done;
+
+		if (xTaskCreate ((TaskFunction_t) host_fw_verify_freertos_task, "FwVerify", stack_words,
+			&workers[i - 1], priority, NULL) == pdPASS) {
+			started++;
+		}
+	}
+
+	status = host_fw_verify_work_run (&work, &engines[0]);
+
+	for (i = 0; i < started; i++) {
+		xSemaphoreTake (done, portMAX_DELAY);
+	}
+
+	if (status == 0) {
+		status = host_fw_verify_work_get_status (&work);
+	}
+
+	if (done != NULL) {
+		vSemaphoreDelete (done);
+	}
+	platform_free (workers);
+	host_fw_verify_work_release (&work);
+
+	return status;
+}
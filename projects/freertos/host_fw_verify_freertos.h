@@ -0,0 +1,20 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HOST_FW_VERIFY_FREERTOS_H_
+#define HOST_FW_VERIFY_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "host_fw/host_fw_util.h"
+
+
+int host_fw_verify_offset_images_multiple_fw_freertos (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset,
+	const struct host_fw_verify_engines *engines, size_t engine_count, uint16_t stack_words,
+	int priority);
+
+
+#endif /* HOST_FW_VERIFY_FREERTOS_H_ */
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "cmd_dispatch_linux.h"
+
+
+/**
+ * Thread entry point for executing dispatched requests.
+ *
+ * @param arg The dispatch queue to process.
+ *
+ * @return Always null.
+ */
+static void* cmd_dispatch_linux_thread (void *arg)
+{
+	cmd_dispatch_run ((struct cmd_dispatch*) arg);
+	return NULL;
+}
+
+/**
+ * Start a pool of threads to execute requests submitted to a dispatch queue.
+ *
+ * If any thread fails to start, the dispatch queue will be stopped and all threads that were
+ * started will exit.
+ *
+ * @param pool The worker pool to initialize.
+ * @param dispatch The queue that will be processed by the threads.
+ * @param threads Storage for the thread handles.  This must remain valid until the pool is stopped.
+ * @param count The number of threads to start.
+ *
+ * @return 0 if all threads were started or an error code.
+ */
+int cmd_dispatch_linux_start (struct cmd_dispatch_linux *pool, struct cmd_dispatch *dispatch,
+	pthread_t *threads, size_t count)
+{
+	if ((pool == NULL) || (dispatch == NULL) || (threads == NULL) || (count == 0)) {
+		return CMD_DISPATCH_INVALID_ARGUMENT;
+	}
+
+	memset (pool, 0, sizeof (struct cmd_dispatch_linux));
+
+	pool->dispatch = dispatch;
+	pool->threads = threads;
+
+	while (pool->count < count) {
+		if (pthread_create (&threads[pool->count], NULL, cmd_dispatch_linux_thread,
+			dispatch) != 0) {
+			cmd_dispatch_linux_stop (pool);
+			return CMD_DISPATCH_NO_MEMORY;
+		}
+
+		pool->count++;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop the dispatch queue and wait for all worker threads to exit.  All requests submitted before
+ * the queue was stopped will be executed.
+ *
+ * @param pool The worker pool to stop.
+ */
+void cmd_dispatch_linux_stop (struct cmd_dispatch_linux *pool)
+{
+	size_t i;
+
+	if (pool != NULL) {
+		cmd_dispatch_stop (pool->dispatch);
+
+		for (i = 0; i < pool->count; i++) {
+			pthread_join (pool->threads[i], NULL);
+		}
+
+		pool->count = 0;
+	}
+}
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CMD_DISPATCH_LINUX_H_
+#define CMD_DISPATCH_LINUX_H_
+
+#include <stddef.h>
+#include <pthread.h>
+#include "cmd_interface/cmd_dispatch.h"
+
+
+/**
+ * Pool of Linux worker threads for executing dispatched requests.
+ */
+struct cmd_dispatch_linux {
+	struct cmd_dispatch *dispatch;	/**< The queue being processed by the threads. */
+	pthread_t *threads;				/**< The threads executing requests. */
+	size_t count;					/**< The number of running threads. */
+};
+
+
+int cmd_dispatch_linux_start (struct cmd_dispatch_linux *pool, struct cmd_dispatch *dispatch,
+	pthread_t *threads, size_t count);
+void cmd_dispatch_linux_stop (struct cmd_dispatch_linux *pool);
+
+
+#endif /* CMD_DISPATCH_LINUX_H_ */
@@ -17,6 +17,8 @@ static int aes_openssl_set_key (struct aes_engine *engine, const uint8_t *key, s
 		return AES_ENGINE_INVALID_ARGUMENT;
 	}
 
+	engine->key_generation++;
+
 	switch (length) {
 		case (128 / 8):
 		case (192 / 8):
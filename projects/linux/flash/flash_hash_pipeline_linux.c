@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "flash_hash_pipeline_linux.h"
+
+
+/**
+ * Thread entry point for the hashing stage of a pipeline.
+ *
+ * @param arg The pipeline to run.
+ *
+ * @return Always null.
+ */
+static void* flash_hash_pipeline_linux_thread (void *arg)
+{
+	flash_hash_pipeline_run ((struct flash_hash_pipeline*) arg);
+	return NULL;
+}
+
+/**
+ * Start a thread to hash flash data read through a pipeline.
+ *
+ * @param worker The worker context to initialize.
+ * @param pipeline The pipeline that will be run by the thread.
+ *
+ * @return 0 if the thread was started or an error code.
+ */
+int flash_hash_pipeline_linux_start (struct flash_hash_pipeline_linux *worker,
+	struct flash_hash_pipeline *pipeline)
+{
+	if ((worker == NULL) || (pipeline == NULL)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	memset (worker, 0, sizeof (struct flash_hash_pipeline_linux));
+
+	worker->pipeline = pipeline;
+	if (pthread_create (&worker->thread, NULL, flash_hash_pipeline_linux_thread, pipeline) != 0) {
+		return FLASH_UTIL_NO_MEMORY;
+	}
+
+	worker->running = true;
+
+	return 0;
+}
+
+/**
+ * Stop the hashing stage of the pipeline and wait for the worker thread to exit.
+ *
+ * @param worker The worker context to stop.
+ */
+void flash_hash_pipeline_linux_stop (struct flash_hash_pipeline_linux *worker)
+{
+	if ((worker != NULL) && worker->running) {
+		flash_hash_pipeline_stop (worker->pipeline);
+		pthread_join (worker->thread, NULL);
+
+		worker->running = false;
+	}
+}
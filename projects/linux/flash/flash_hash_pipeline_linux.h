@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_HASH_PIPELINE_LINUX_H_
+#define FLASH_HASH_PIPELINE_LINUX_H_
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "flash/flash_util.h"
+
+
+/**
+ * Linux thread for running the hashing stage of a flash hashing pipeline.
+ */
+struct flash_hash_pipeline_linux {
+	struct flash_hash_pipeline *pipeline;	/**< The pipeline being run by the thread. */
+	pthread_t thread;						/**< The thread hashing flash data. */
+	bool running;							/**< Flag indicating the thread has been started. */
+};
+
+
+int flash_hash_pipeline_linux_start (struct flash_hash_pipeline_linux *worker,
+	struct flash_hash_pipeline *pipeline);
+void flash_hash_pipeline_linux_stop (struct flash_hash_pipeline_linux *worker);
+
+
+#endif /* FLASH_HASH_PIPELINE_LINUX_H_ */
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "flash_queue_linux.h"
+
+
+/**
+ * Thread entry point for processing queued flash requests.
+ *
+ * @param arg The flash queue to process.
+ *
+ * @return Always null.
+ */
+static void* flash_queue_linux_thread (void *arg)
+{
+	flash_queue_run ((struct flash_queue*) arg);
+	return NULL;
+}
+
+/**
+ * Start a thread to execute flash requests submitted to a queue.
+ *
+ * @param worker The worker context to initialize.
+ * @param queue The queue that will be processed by the thread.
+ *
+ * @return 0 if the thread was started or an error code.
+ */
+int flash_queue_linux_start (struct flash_queue_linux *worker, struct flash_queue *queue)
+{
+	if ((worker == NULL) || (queue == NULL)) {
+		return FLASH_QUEUE_INVALID_ARGUMENT;
+	}
+
+	memset (worker, 0, sizeof (struct flash_queue_linux));
+
+	worker->queue = queue;
+	if (pthread_create (&worker->thread, NULL, flash_queue_linux_thread, queue) != 0) {
+		return FLASH_QUEUE_NO_MEMORY;
+	}
+
+	worker->running = true;
+
+	return 0;
+}
+
+/**
+ * Stop the queue and wait for the worker thread to exit.  All requests submitted before the queue
+ * was stopped will be executed.
+ *
+ * @param worker The worker context to stop.
+ */
+void flash_queue_linux_stop (struct flash_queue_linux *worker)
+{
+	if ((worker != NULL) && worker->running) {
+		flash_queue_stop (worker->queue);
+		pthread_join (worker->thread, NULL);
+
+		worker->running = false;
+	}
+}
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_QUEUE_LINUX_H_
+#define FLASH_QUEUE_LINUX_H_
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "flash/flash_queue.h"
+
+
+/**
+ * Linux worker thread for executing queued flash requests.
+ */
+struct flash_queue_linux {
+	struct flash_queue *queue;		/**< The queue being processed by the thread. */
+	pthread_t thread;				/**< The thread executing flash requests. */
+	bool running;					/**< Flag indicating the thread has been started. */
+};
+
+
+int flash_queue_linux_start (struct flash_queue_linux *worker, struct flash_queue *queue);
+void flash_queue_linux_stop (struct flash_queue_linux *worker);
+
+
+#endif /* FLASH_QUEUE_LINUX_H_ */
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "host_fw_verify_linux.h"
+
+
+/**
+ * Context for a single verification thread.
+ */
+struct host_fw_verify_linux_worker {
+	struct host_fw_verify_work *work;				/**< The shared verification work. */
+	const struct host_fw_verify_engines *engines;	/**< Engines dedicated to the thread. */
+	pthread_t thread;								/**< The thread running the verification. */
+	bool running;									/**< Flag indicating the thread was started. */
+};
+
+/**
+ * Thread entry point for image verification.
+ *
+ * @param arg The worker context.
+ *
+ * @return Always null.
+ */
+static void* host_fw_verify_linux_thread (void *arg)
+{
+	struct host_fw_verify_linux_worker *worker = arg;
+
+	host_fw_verify_work_run (worker->work, worker->engines);
+	return NULL;
+}
+
+/**
+ * Verify that images from multiple different firmware components on the flash are valid, using a
+ * separate thread for each set of engines.  Only images flagged for validation will be checked.
+ *
+ * The calling thread verifies images with the first set of engines while additional threads are
+ * running.  If any thread cannot be created, verification continues with the remaining workers.
+ *
+ * All image addresses specified in the PFM will be offset by a fixed amount.
+ *
+ * @param flash The flash that contains the images to validate.
+ * @param img_list An array of firmware images that should be validated.
+ * @param fw_count The number of firmware components in the list.
+ * @param offset The offset to apply to image addresses.
+ * @param engines The engines to use for verification.  Each entry must have a unique hash engine
+ * and, if one is provided, a unique hashing pipeline.
+ * @param engine_count The number of engine sets, which determines the number of workers.
+ *
+ * @return 0 if all images that should be validated are good or an error code.  Image verification
+ * errors are the same as reported by host_fw_verify_offset_images_multiple_fw.
+ */
+int host_fw_verify_offset_images_multiple_fw_linux (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset,
+	const struct host_fw_verify_engines *engines, size_t engine_count)
+{
+	struct host_fw_verify_work work;
+	struct host_fw_verify_linux_worker *workers = NULL;
+	size_t i;
+	int status;
+
+	if ((engines == NULL) || (engine_count == 0)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < engine_count; i++) {
+		if ((engines[i].hash == NULL) || (engines[i].rsa == NULL)) {
+			return HOST_FW_UTIL_INVALID_ARGUMENT;
+		}
+	}
+
+	status = host_fw_verify_work_init (&work, flash, img_list, fw_count, offset);
+	if (status != 0) {
+		return status;
+	}
+
+	if (engine_count > 1) {
+		workers = calloc (engine_count - 1, sizeof (struct host_fw_verify_linux_worker));
+		if (workers == NULL) {
+			/* Fall back to verifying everything from the calling thread. */
+			engine_count = 1;
+		}
+	}
+
+	for (i = 1; i < engine_count; i++) {
+		workers[i - 1].work = &work;
+		workers[i - 1].engines = &engines[i];
+		workers[i - 1].running = (pthread_create (&workers[i - 1].thread, NULL,
+			host_fw_verify_linux_thread, &workers[i - 1]) == 0);
+	}
+
+	status = host_fw_verify_work_run (&work, &engines[0]);
+
+	for (i = 1; i < engine_count; i++) {
+		if (workers[i - 1].running) {
+			pthread_join (workers[i - 1].thread, NULL);
+		}
+	}
+
+	if (status == 0) {
+		status = host_fw_verify_work_get_status (&work);
+	}
+
+	free (workers);
+	host_fw_verify_work_release (&work);
+
+	return status;
+}
@@ -66,6 +66,45 @@
 // #define PCD_FLASH_ATTESTATION_RSP_NOT_READY_MAX_RETRY_DEFAULT		3
 
 
+/*************
+ * Flash
+ *************/
+
+/**
+ * Default setting for skipping SPI flash status checks when the driver has no outstanding program
+ * or erase operations.  Only safe for flash devices not shared with another SPI master.
+ */
+// #define	SPI_FLASH_TRACK_WRITE_STATE_DEFAULT		false
+
+/**
+ * Upper bound, in milliseconds, on the delay between status checks while waiting for an erase to
+ * complete.
+ */
+// #define	SPI_FLASH_POLL_MAX_DELAY_MS				10
+
+/**
+ * Maximum number of read transfers submitted together when reading multiple flash regions.
+ */
+// #define	SPI_FLASH_READ_BATCH_SIZE				8
+
+/**
+ * Size of the stack buffer used when checking flash regions for blank or constant values.  Must
+ * be a multiple of 8 bytes.
+ */
+// #define	FLASH_BLANK_CHECK_BLOCK					4096
+
+
+/*************
+ * Logging
+ *************/
+
+/**
+ * The maximum number of full flash sectors a flash log will hold in memory when deferred flushing
+ * is enabled.
+ */
+// #define	LOGGING_FLASH_MAX_PENDING_SECTORS		4
+
+
 /*************
  * Crypto
  *************/
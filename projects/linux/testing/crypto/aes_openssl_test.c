@@ -30,6 +30,7 @@ static void aes_openssl_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.set_key);
 	CuAssertPtrNotNull (test, engine.base.encrypt_data);
 	CuAssertPtrNotNull (test, engine.base.decrypt_data);
+	CuAssertIntEquals (test, 0, engine.base.key_generation);
 
 	aes_openssl_release (&engine);
 }
@@ -238,6 +239,32 @@ static void aes_openssl_test_encrypt_data_no_key (CuTest *test)
 	aes_openssl_release (&engine);
 }
 
+static void aes_openssl_test_set_key_key_generation (CuTest *test)
+{
+	struct aes_engine_openssl engine;
+	int status;
+
+	TEST_START;
+
+	status = aes_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.set_key (&engine.base, AES_KEY, AES_KEY_LEN);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, engine.base.key_generation);
+
+	status = engine.base.set_key (&engine.base, AES_KEY, AES_KEY_LEN);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, engine.base.key_generation);
+
+	/* Every call updates the generation, even if the key was not set. */
+	status = engine.base.set_key (&engine.base, AES_KEY, 3);
+	CuAssertIntEquals (test, AES_ENGINE_INVALID_KEY_LENGTH, status);
+	CuAssertIntEquals (test, 3, engine.base.key_generation);
+
+	aes_openssl_release (&engine);
+}
+
 static void aes_openssl_test_set_key_null (CuTest *test)
 {
 	struct aes_engine_openssl engine;
@@ -666,6 +693,7 @@ TEST (aes_openssl_test_encrypt_data_no_key);
 TEST (aes_openssl_test_set_key_null);
 TEST (aes_openssl_test_set_key_bad_length);
 TEST (aes_openssl_test_set_key_unsupported_length);
+TEST (aes_openssl_test_set_key_key_generation);
 TEST (aes_openssl_test_decrypt_data);
 TEST (aes_openssl_test_decrypt_data_no_tag);
 TEST (aes_openssl_test_decrypt_data_same_buffer);
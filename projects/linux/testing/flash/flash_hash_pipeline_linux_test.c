@@ -0,0 +1,295 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "flash/flash_hash_pipeline_linux.h"
+#include "flash/flash_virtual_ram.h"
+#include "testing/engines/hash_testing_engine.h"
+
+
+TEST_SUITE_LABEL ("flash_hash_pipeline_linux");
+
+
+/**
+ * Size of the flash device used for hashing.  This is enough to cycle through every buffer in the
+ * pipeline more than once.
+ */
+#define	FLASH_HASH_PIPELINE_LINUX_TESTING_FLASH_SIZE	\
+	((FLASH_HASH_BLOCK_SIZE * (FLASH_HASH_PIPELINE_DEPTH + 2)) + 0x80)
+
+/**
+ * Number of requests hashing flash data in parallel.
+ */
+#define	FLASH_HASH_PIPELINE_LINUX_TESTING_REQUESTS		2
+
+/**
+ * A thread hashing flash data through a dedicated pipeline.
+ */
+struct flash_hash_pipeline_linux_testing_request {
+	struct flash_hash_pipeline pipeline;		/**< The pipeline for the request. */
+	struct flash_hash_pipeline_linux worker;	/**< The hashing stage for the pipeline. */
+	HASH_TESTING_ENGINE hash;					/**< Hash engine for the request. */
+	const struct flash *flash;					/**< The flash containing the data to hash. */
+	struct flash_region region;					/**< The flash region to hash. */
+	pthread_barrier_t *barrier;					/**< Barrier for all requests to reach first. */
+	pthread_t thread;							/**< The requesting thread. */
+	uint8_t digest[SHA256_HASH_LENGTH];			/**< The calculated hash. */
+	int status;									/**< Result of the request. */
+};
+
+/**
+ * Thread entry point for hashing flash data.
+ *
+ * @param arg The request context.
+ *
+ * @return Always null.
+ */
+static void* flash_hash_pipeline_linux_testing_request_thread (void *arg)
+{
+	struct flash_hash_pipeline_linux_testing_request *request = arg;
+
+	pthread_barrier_wait (request->barrier);
+
+	request->status = flash_hash_noncontiguous_contents_pipelined (&request->pipeline,
+		request->flash, 0, &request->region, 1, &request->hash.base, HASH_TYPE_SHA256,
+		request->digest, sizeof (request->digest));
+	return NULL;
+}
+
+/**
+ * Initialize a virtual flash device containing data to hash.
+ *
+ * @param test The test framework.
+ * @param flash The virtual flash device to initialize.
+ * @param state Variable context for the flash device.
+ * @param data Buffer to use for flash contents.  It will be filled with test data.
+ * @param length Length of the flash buffer.
+ */
+static void flash_hash_pipeline_linux_testing_init_flash (CuTest *test,
+	struct flash_virtual_ram *flash, struct flash_virtual_ram_state *state, uint8_t *data,
+	size_t length)
+{
+	size_t i;
+	int status;
+
+	for (i = 0; i < length; i++) {
+		data[i] = (uint8_t) (i * 7);
+	}
+
+	status = flash_virtual_ram_init (flash, state, data, length);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_hash_pipeline_linux_test_start_null (CuTest *test)
+{
+	struct flash_hash_pipeline_linux worker;
+	struct flash_hash_pipeline pipeline;
+	int status;
+
+	TEST_START;
+
+	status = flash_hash_pipeline_linux_start (NULL, &pipeline);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_pipeline_linux_start (&worker, NULL);
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	flash_hash_pipeline_linux_stop (NULL);
+}
+
+static void flash_hash_pipeline_linux_test_hash (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_hash_pipeline_linux worker;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_HASH_PIPELINE_LINUX_TESTING_FLASH_SIZE];
+	struct flash_region region;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_linux_testing_init_flash (test, &flash, &state, data, sizeof (data));
+
+	status = flash_hash_pipeline_init (&pipeline);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_linux_start (&worker, &pipeline);
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10;
+	region.length = sizeof (data) - 0x10;
+
+	status = hash.base.calculate_sha256 (&hash.base, &data[0x10], region.length, hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0, &region, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Hash the data again to reuse the pipeline after the first request. */
+	memset (hash_actual, 0, sizeof (hash_actual));
+
+	status = flash_hash_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0, &region, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_linux_stop (&worker);
+	CuAssertIntEquals (test, false, pipeline.running);
+
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_linux_test_hash_after_stop (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_hash_pipeline pipeline;
+	struct flash_hash_pipeline_linux worker;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_HASH_PIPELINE_LINUX_TESTING_FLASH_SIZE];
+	struct flash_region region;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	uint8_t hash_actual[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_linux_testing_init_flash (test, &flash, &state, data, sizeof (data));
+
+	status = flash_hash_pipeline_init (&pipeline);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_pipeline_linux_start (&worker, &pipeline);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_linux_stop (&worker);
+
+	region.start_addr = 0;
+	region.length = sizeof (data);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Without the hashing stage, data is hashed by the caller. */
+	status = flash_hash_noncontiguous_contents_pipelined (&pipeline, &flash.base, 0, &region, 1,
+		&hash.base, HASH_TYPE_SHA256, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_release (&pipeline);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_pipeline_linux_test_parallel_requests (CuTest *test)
+{
+	struct flash_hash_pipeline_linux_testing_request
+		request[FLASH_HASH_PIPELINE_LINUX_TESTING_REQUESTS];
+	HASH_TESTING_ENGINE hash;
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	static uint8_t data[FLASH_HASH_PIPELINE_LINUX_TESTING_FLASH_SIZE];
+	pthread_barrier_t barrier;
+	uint8_t hash_expected[SHA256_HASH_LENGTH];
+	int i;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_hash_pipeline_linux_testing_init_flash (test, &flash, &state, data, sizeof (data));
+
+	status = pthread_barrier_init (&barrier, NULL, FLASH_HASH_PIPELINE_LINUX_TESTING_REQUESTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash.base.calculate_sha256 (&hash.base, data, sizeof (data), hash_expected,
+		sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Each request has its own pipeline, so neither request waits for the other. */
+	for (i = 0; i < FLASH_HASH_PIPELINE_LINUX_TESTING_REQUESTS; i++) {
+		memset (&request[i], 0, sizeof (request[i]));
+
+		status = HASH_TESTING_ENGINE_INIT (&request[i].hash);
+		CuAssertIntEquals (test, 0, status);
+
+		status = flash_hash_pipeline_init (&request[i].pipeline);
+		CuAssertIntEquals (test, 0, status);
+
+		status = flash_hash_pipeline_linux_start (&request[i].worker, &request[i].pipeline);
+		CuAssertIntEquals (test, 0, status);
+
+		request[i].flash = &flash.base;
+		request[i].region.start_addr = 0;
+		request[i].region.length = sizeof (data);
+		request[i].barrier = &barrier;
+		request[i].status = -1;
+	}
+
+	for (i = 0; i < FLASH_HASH_PIPELINE_LINUX_TESTING_REQUESTS; i++) {
+		status = pthread_create (&request[i].thread, NULL,
+			flash_hash_pipeline_linux_testing_request_thread, &request[i]);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	for (i = 0; i < FLASH_HASH_PIPELINE_LINUX_TESTING_REQUESTS; i++) {
+		pthread_join (request[i].thread, NULL);
+
+		CuAssertIntEquals (test, 0, request[i].status);
+
+		status = testing_validate_array (hash_expected, request[i].digest, sizeof (hash_expected));
+		CuAssertIntEquals (test, 0, status);
+
+		flash_hash_pipeline_linux_stop (&request[i].worker);
+		flash_hash_pipeline_release (&request[i].pipeline);
+		HASH_TESTING_ENGINE_RELEASE (&request[i].hash);
+	}
+
+	pthread_barrier_destroy (&barrier);
+	flash_virtual_ram_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+
+TEST_SUITE_START (flash_hash_pipeline_linux);
+
+TEST (flash_hash_pipeline_linux_test_start_null);
+TEST (flash_hash_pipeline_linux_test_hash);
+TEST (flash_hash_pipeline_linux_test_hash_after_stop);
+TEST (flash_hash_pipeline_linux_test_parallel_requests);
+
+TEST_SUITE_END;
@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "flash/flash_queue_linux.h"
+#include "flash/flash_virtual_ram.h"
+
+
+TEST_SUITE_LABEL ("flash_queue_linux");
+
+
+/**
+ * Size of the flash device used by the queue.
+ */
+#define	FLASH_QUEUE_LINUX_TESTING_FLASH_SIZE		0x1000
+
+/**
+ * A thread waiting for a queued request to complete.
+ */
+struct flash_queue_linux_testing_waiter {
+	struct flash_queue *queue;					/**< The queue the request was submitted to. */
+	struct flash_queue_request *request;		/**< The request to wait for. */
+	pthread_t thread;							/**< The waiting thread. */
+	int status;									/**< Result of the wait. */
+};
+
+/**
+ * Thread entry point for waiting on a queued request.
+ *
+ * @param arg The waiter context.
+ *
+ * @return Always null.
+ */
+static void* flash_queue_linux_testing_wait_thread (void *arg)
+{
+	struct flash_queue_linux_testing_waiter *waiter = arg;
+
+	waiter->status = flash_queue_wait (waiter->queue, waiter->request, 5000);
+	return NULL;
+}
+
+/**
+ * Start threads to wait for requests and block until all of them are waiting on the queue.
+ *
+ * @param test The test framework.
+ * @param waiter The list of waiters to start.
+ * @param count The number of waiters.
+ */
+static void flash_queue_linux_testing_start_waiters (CuTest *test,
+	struct flash_queue_linux_testing_waiter *waiter, size_t count)
+{
+	struct flash_queue *queue = waiter[0].queue;
+	struct flash_queue_waiter *pos;
+	size_t waiting;
+	size_t i;
+	int status;
+
+	for (i = 0; i < count; i++) {
+		status = pthread_create (&waiter[i].thread, NULL, flash_queue_linux_testing_wait_thread,
+			&waiter[i]);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	do {
+		platform_msleep (1);
+
+		waiting = 0;
+		platform_mutex_lock (&queue->lock);
+		for (pos = queue->waiters; pos != NULL; pos = pos->next) {
+			waiting++;
+		}
+		platform_mutex_unlock (&queue->lock);
+	} while (waiting != count);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_queue_linux_test_wait (CuTest *test)
+{
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	uint8_t flash_data[FLASH_QUEUE_LINUX_TESTING_FLASH_SIZE];
+	struct flash_queue queue;
+	struct flash_queue_linux worker;
+	struct flash_queue_request request;
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	int status;
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+
+	status = flash_virtual_ram_init (&flash, &state, flash_data, sizeof (flash_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_init (&queue, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_linux_start (&worker, &queue);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_WRITE;
+	request.address = 0x100;
+	request.data = data;
+	request.length = sizeof (data);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_wait (&queue, &request, 5000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, &flash_data[0x100], sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_queue_linux_stop (&worker);
+	flash_queue_release (&queue);
+	flash_virtual_ram_release (&flash);
+}
+
+static void flash_queue_linux_test_multiple_waiters_same_request (CuTest *test)
+{
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	uint8_t flash_data[FLASH_QUEUE_LINUX_TESTING_FLASH_SIZE];
+	struct flash_queue queue;
+	struct flash_queue_linux worker;
+	struct flash_queue_request request;
+	struct flash_queue_linux_testing_waiter waiter[3];
+	uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+
+	status = flash_virtual_ram_init (&flash, &state, flash_data, sizeof (flash_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_init (&queue, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&request, 0, sizeof (request));
+	request.op = FLASH_QUEUE_OP_WRITE;
+	request.address = 0x100;
+	request.data = data;
+	request.length = sizeof (data);
+
+	status = flash_queue_submit (&queue, &request);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 3; i++) {
+		waiter[i].queue = &queue;
+		waiter[i].request = &request;
+		waiter[i].status = -1;
+	}
+
+	/* All contexts are waiting before the request is executed, so every one of them must be
+	 * notified by a single completion. */
+	flash_queue_linux_testing_start_waiters (test, waiter, 3);
+
+	status = flash_queue_linux_start (&worker, &queue);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 3; i++) {
+		pthread_join (waiter[i].thread, NULL);
+		CuAssertIntEquals (test, 0, waiter[i].status);
+	}
+
+	CuAssertPtrEquals (test, NULL, queue.waiters);
+
+	flash_queue_linux_stop (&worker);
+	flash_queue_release (&queue);
+	flash_virtual_ram_release (&flash);
+}
+
+static void flash_queue_linux_test_multiple_waiters_different_requests (CuTest *test)
+{
+	struct flash_virtual_ram flash;
+	struct flash_virtual_ram_state state;
+	uint8_t flash_data[FLASH_QUEUE_LINUX_TESTING_FLASH_SIZE];
+	struct flash_queue queue;
+	struct flash_queue_linux worker;
+	struct flash_queue_request request[4];
+	struct flash_queue_linux_testing_waiter waiter[4];
+	uint8_t data[4][4];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	memset (flash_data, 0xff, sizeof (flash_data));
+
+	status = flash_virtual_ram_init (&flash, &state, flash_data, sizeof (flash_data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_queue_init (&queue, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (request, 0, sizeof (request));
+	for (i = 0; i < 4; i++) {
+		memset (data[i], i + 1, sizeof (data[i]));
+
+		request[i].op = FLASH_QUEUE_OP_WRITE;
+		request[i].address = 0x100 * (i + 1);
+		request[i].data = data[i];
+		request[i].length = sizeof (data[i]);
+
+		status = flash_queue_submit (&queue, &request[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		waiter[i].queue = &queue;
+		waiter[i].request = &request[i];
+		waiter[i].status = -1;
+	}
+
+	/* Waiters are notified for the request they are waiting on, regardless of how many other
+	 * contexts are waiting for other requests. */
+	flash_queue_linux_testing_start_waiters (test, waiter, 4);
+
+	status = flash_queue_linux_start (&worker, &queue);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		pthread_join (waiter[i].thread, NULL);
+		CuAssertIntEquals (test, 0, waiter[i].status);
+
+		status = testing_validate_array (data[i], &flash_data[0x100 * (i + 1)], sizeof (data[i]));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	CuAssertPtrEquals (test, NULL, queue.waiters);
+
+	flash_queue_linux_stop (&worker);
+	flash_queue_release (&queue);
+	flash_virtual_ram_release (&flash);
+}
+
+
+TEST_SUITE_START (flash_queue_linux);
+
+TEST (flash_queue_linux_test_wait);
+TEST (flash_queue_linux_test_multiple_waiters_same_request);
+TEST (flash_queue_linux_test_multiple_waiters_different_requests);
+
+TEST_SUITE_END;
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LINUX_FLASH_ALL_TESTS_H_
+#define LINUX_FLASH_ALL_TESTS_H_
+
+#include "testing.h"
+#include "platform_all_tests.h"
+#include "common/unused.h"
+
+
+/**
+ * Add all tests for components in the 'flash' directory.
+ *
+ * Be sure to keep the test suites in alphabetical order for easier management.
+ *
+ * @param suite Suite to add the tests to.
+ */
+static void add_all_linux_flash_tests (CuSuite *suite)
+{
+	/* This is unused when no tests will be executed. */
+	UNUSED (suite);
+
+#if (defined TESTING_RUN_FLASH_HASH_PIPELINE_LINUX_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_LINUX_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_LINUX_TESTS)) && \
+	!defined TESTING_SKIP_FLASH_HASH_PIPELINE_LINUX_SUITE
+	TESTING_RUN_SUITE (flash_hash_pipeline_linux);
+#endif
+#if (defined TESTING_RUN_FLASH_QUEUE_LINUX_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_LINUX_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_LINUX_TESTS)) && \
+	!defined TESTING_SKIP_FLASH_QUEUE_LINUX_SUITE
+	TESTING_RUN_SUITE (flash_queue_linux);
+#endif
+}
+
+
+#endif /* LINUX_FLASH_ALL_TESTS_H_ */
@@ -0,0 +1,505 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "host_fw/host_fw_verify_linux.h"
+#include "flash/spi_flash.h"
+#include "flash/flash_hash_pipeline_linux.h"
+#include "common/unused.h"
+#include "testing/engines/hash_testing_engine.h"
+#include "testing/engines/rsa_testing_engine.h"
+
+
+TEST_SUITE_LABEL ("host_fw_verify_linux");
+
+
+/**
+ * Size of the flash device used for verification.
+ */
+#define	HOST_FW_VERIFY_LINUX_TESTING_FLASH_SIZE		0x10000
+
+/**
+ * Size of each image region stored in flash.
+ */
+#define	HOST_FW_VERIFY_LINUX_TESTING_IMAGE_SIZE		0x800
+
+/**
+ * Maximum number of workers used for verification.
+ */
+#define	HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS	4
+
+/**
+ * Number of images stored in flash.
+ */
+#define	HOST_FW_VERIFY_LINUX_TESTING_IMAGES			8
+
+/**
+ * A SPI master for a flash device stored in RAM.  Unlike the mock, this can be accessed from
+ * multiple threads.
+ */
+struct host_fw_verify_linux_testing_spi {
+	struct flash_master base;									/**< The base SPI master. */
+	uint8_t data[HOST_FW_VERIFY_LINUX_TESTING_FLASH_SIZE];		/**< The flash contents. */
+};
+
+/**
+ * A hash engine for a single verification thread.  Hashing is passed through to a real hash
+ * engine, but the worker can be configured to fail and to wait for all other workers before
+ * verifying its first image.
+ */
+struct host_fw_verify_linux_testing_hash {
+	struct hash_engine base;			/**< The base hash engine. */
+	struct hash_engine *engine;			/**< The hash engine to pass requests to. */
+	pthread_barrier_t *barrier;			/**< Barrier for all workers to reach before hashing. */
+	int fail;							/**< Error to return when starting a hash. */
+	int started;						/**< Number of hashes started by the worker. */
+};
+
+/**
+ * Context for testing image verification from multiple threads.
+ */
+struct host_fw_verify_linux_testing {
+	struct host_fw_verify_linux_testing_spi spi;				/**< SPI master for the flash. */
+	struct spi_flash_state flash_state;							/**< Context for the flash. */
+	struct spi_flash flash;										/**< Flash containing the images. */
+	RSA_TESTING_ENGINE rsa;										/**< RSA engine for all workers. */
+	pthread_barrier_t barrier;									/**< Barrier for worker startup. */
+	struct pfm_image_list list[2];								/**< Images for two components. */
+
+	/**
+	 * Hash engines used by each worker.
+	 */
+	HASH_TESTING_ENGINE hash[HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS];
+
+	/**
+	 * Hash engines that wrap the engine used by each worker.
+	 */
+	struct host_fw_verify_linux_testing_hash worker_hash[HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS];
+
+	/**
+	 * The set of engines for each worker.
+	 */
+	struct host_fw_verify_engines engines[HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS];
+
+	/**
+	 * The flash region for each image.
+	 */
+	struct flash_region region[HOST_FW_VERIFY_LINUX_TESTING_IMAGES];
+
+	/**
+	 * The expected hash for each image.
+	 */
+	struct pfm_image_hash img_hash[HOST_FW_VERIFY_LINUX_TESTING_IMAGES];
+};
+
+/**
+ * Execute a transfer against the RAM flash.  The status register always reports the device is idle.
+ */
+static int host_fw_verify_linux_testing_spi_xfer (const struct flash_master *spi,
+	const struct flash_xfer *xfer)
+{
+	struct host_fw_verify_linux_testing_spi *ram = (struct host_fw_verify_linux_testing_spi*) spi;
+
+	if (xfer->flags & FLASH_FLAG_DATA_TX) {
+		return FLASH_MASTER_UNSUPPORTED_XFER;
+	}
+
+	if (xfer->flags & FLASH_FLAG_NO_ADDRESS) {
+		memset (xfer->data, 0, xfer->length);
+		return 0;
+	}
+
+	if ((xfer->address >= sizeof (ram->data)) ||
+		(xfer->length > (sizeof (ram->data) - xfer->address))) {
+		return FLASH_MASTER_XFER_FAILED;
+	}
+
+	memcpy (xfer->data, &ram->data[xfer->address], xfer->length);
+	return 0;
+}
+
+/**
+ * Get the capabilities of the RAM flash SPI master.
+ */
+static uint32_t host_fw_verify_linux_testing_spi_capabilities (const struct flash_master *spi)
+{
+	UNUSED (spi);
+
+	return FLASH_CAP_3BYTE_ADDR;
+}
+
+/**
+ * Start a SHA-256 hash for the worker.  The first hash waits for all workers to be verifying an
+ * image.
+ */
+static int host_fw_verify_linux_testing_hash_start_sha256 (struct hash_engine *engine)
+{
+	struct host_fw_verify_linux_testing_hash *hash =
+		(struct host_fw_verify_linux_testing_hash*) engine;
+
+	if ((hash->started++ == 0) && hash->barrier) {
+		pthread_barrier_wait (hash->barrier);
+	}
+
+	if (hash->fail) {
+		return hash->fail;
+	}
+
+	return hash->engine->start_sha256 (hash->engine);
+}
+
+/**
+ * Pass a hash update to the real hash engine.
+ */
+static int host_fw_verify_linux_testing_hash_update (struct hash_engine *engine,
+	const uint8_t *data, size_t length)
+{
+	struct host_fw_verify_linux_testing_hash *hash =
+		(struct host_fw_verify_linux_testing_hash*) engine;
+
+	return hash->engine->update (hash->engine, data, length);
+}
+
+/**
+ * Get the final hash from the real hash engine.
+ */
+static int host_fw_verify_linux_testing_hash_finish (struct hash_engine *engine, uint8_t *digest,
+	size_t length)
+{
+	struct host_fw_verify_linux_testing_hash *hash =
+		(struct host_fw_verify_linux_testing_hash*) engine;
+
+	return hash->engine->finish (hash->engine, digest, length);
+}
+
+/**
+ * Cancel the hash in the real hash engine.
+ */
+static void host_fw_verify_linux_testing_hash_cancel (struct hash_engine *engine)
+{
+	struct host_fw_verify_linux_testing_hash *hash =
+		(struct host_fw_verify_linux_testing_hash*) engine;
+
+	hash->engine->cancel (hash->engine);
+}
+
+/**
+ * Initialize the flash, images, and engines for verification.  Half the images are in each of two
+ * firmware components.  Each image covers a unique region of flash.
+ *
+ * @param test The test framework.
+ * @param verify The testing context to initialize.
+ * @param workers The number of workers that will verify the images.
+ * @param sync Flag indicating whether all workers must claim an image before any are verified.
+ */
+static void host_fw_verify_linux_testing_init (CuTest *test,
+	struct host_fw_verify_linux_testing *verify, size_t workers, bool sync)
+{
+	size_t i;
+	int status;
+
+	memset (verify, 0, sizeof (*verify));
+
+	verify->spi.base.xfer = host_fw_verify_linux_testing_spi_xfer;
+	verify->spi.base.capabilities = host_fw_verify_linux_testing_spi_capabilities;
+	verify->spi.base.xfer_batch = NULL;
+
+	for (i = 0; i < sizeof (verify->spi.data); i++) {
+		verify->spi.data[i] = (uint8_t) (i * 7);
+	}
+
+	status = spi_flash_init (&verify->flash, &verify->flash_state, &verify->spi.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&verify->flash, sizeof (verify->spi.data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&verify->rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < workers; i++) {
+		status = HASH_TESTING_ENGINE_INIT (&verify->hash[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		verify->worker_hash[i].base.start_sha256 = host_fw_verify_linux_testing_hash_start_sha256;
+		verify->worker_hash[i].base.update = host_fw_verify_linux_testing_hash_update;
+		verify->worker_hash[i].base.finish = host_fw_verify_linux_testing_hash_finish;
+		verify->worker_hash[i].base.cancel = host_fw_verify_linux_testing_hash_cancel;
+		verify->worker_hash[i].engine = &verify->hash[i].base;
+
+		verify->engines[i].hash = &verify->worker_hash[i].base;
+		verify->engines[i].rsa = &verify->rsa.base;
+	}
+
+	if (sync) {
+		status = pthread_barrier_init (&verify->barrier, NULL, workers);
+		CuAssertIntEquals (test, 0, status);
+
+		for (i = 0; i < workers; i++) {
+			verify->worker_hash[i].barrier = &verify->barrier;
+		}
+	}
+
+	for (i = 0; i < HOST_FW_VERIFY_LINUX_TESTING_IMAGES; i++) {
+		verify->region[i].start_addr = i * HOST_FW_VERIFY_LINUX_TESTING_IMAGE_SIZE;
+		verify->region[i].length = HOST_FW_VERIFY_LINUX_TESTING_IMAGE_SIZE;
+
+		verify->img_hash[i].regions = &verify->region[i];
+		verify->img_hash[i].count = 1;
+		verify->img_hash[i].hash_length = SHA256_HASH_LENGTH;
+		verify->img_hash[i].hash_type = HASH_TYPE_SHA256;
+		verify->img_hash[i].always_validate = 1;
+
+		status = verify->hash[0].base.calculate_sha256 (&verify->hash[0].base,
+			&verify->spi.data[verify->region[i].start_addr], verify->region[i].length,
+			verify->img_hash[i].hash, sizeof (verify->img_hash[i].hash));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	verify->list[0].images_hash = &verify->img_hash[0];
+	verify->list[0].images_sig = NULL;
+	verify->list[0].count = HOST_FW_VERIFY_LINUX_TESTING_IMAGES / 2;
+
+	verify->list[1].images_hash = &verify->img_hash[HOST_FW_VERIFY_LINUX_TESTING_IMAGES / 2];
+	verify->list[1].images_sig = NULL;
+	verify->list[1].count = HOST_FW_VERIFY_LINUX_TESTING_IMAGES / 2;
+}
+
+/**
+ * Release the testing context.
+ *
+ * @param verify The testing context to release.
+ * @param workers The number of workers that were initialized.
+ * @param sync Flag indicating whether workers were synchronized.
+ */
+static void host_fw_verify_linux_testing_release (struct host_fw_verify_linux_testing *verify,
+	size_t workers, bool sync)
+{
+	size_t i;
+
+	if (sync) {
+		pthread_barrier_destroy (&verify->barrier);
+	}
+
+	for (i = 0; i < workers; i++) {
+		HASH_TESTING_ENGINE_RELEASE (&verify->hash[i]);
+	}
+
+	RSA_TESTING_ENGINE_RELEASE (&verify->rsa);
+	spi_flash_release (&verify->flash);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void host_fw_verify_linux_test_single_worker (CuTest *test)
+{
+	struct host_fw_verify_linux_testing verify;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_linux_testing_init (test, &verify, 1, false);
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		verify.engines, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, HOST_FW_VERIFY_LINUX_TESTING_IMAGES, verify.worker_hash[0].started);
+
+	host_fw_verify_linux_testing_release (&verify, 1, false);
+}
+
+static void host_fw_verify_linux_test_multiple_workers (CuTest *test)
+{
+	struct host_fw_verify_linux_testing verify;
+	int total = 0;
+	int i;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_linux_testing_init (test, &verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS,
+		true);
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		verify.engines, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Every worker verified at least one image, and every image was verified exactly once. */
+	for (i = 0; i < HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS; i++) {
+		CuAssertTrue (test, (verify.worker_hash[i].started > 0));
+		total += verify.worker_hash[i].started;
+	}
+
+	CuAssertIntEquals (test, HOST_FW_VERIFY_LINUX_TESTING_IMAGES, total);
+
+	host_fw_verify_linux_testing_release (&verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS, true);
+}
+
+static void host_fw_verify_linux_test_multiple_workers_pipelined (CuTest *test)
+{
+	struct host_fw_verify_linux_testing verify;
+	struct flash_hash_pipeline pipeline[HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS];
+	struct flash_hash_pipeline_linux hashing[HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS];
+	int total = 0;
+	int i;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_linux_testing_init (test, &verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS,
+		true);
+
+	/* Each worker hashes flash data through its own pipeline, so workers verifying images at the
+	 * same time do not wait on each other. */
+	for (i = 0; i < HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS; i++) {
+		status = flash_hash_pipeline_init (&pipeline[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		status = flash_hash_pipeline_linux_start (&hashing[i], &pipeline[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		verify.engines[i].pipeline = &pipeline[i];
+	}
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		verify.engines, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS; i++) {
+		CuAssertTrue (test, (verify.worker_hash[i].started > 0));
+		total += verify.worker_hash[i].started;
+
+		CuAssertIntEquals (test, false, pipeline[i].busy);
+
+		flash_hash_pipeline_linux_stop (&hashing[i]);
+		flash_hash_pipeline_release (&pipeline[i]);
+	}
+
+	CuAssertIntEquals (test, HOST_FW_VERIFY_LINUX_TESTING_IMAGES, total);
+
+	host_fw_verify_linux_testing_release (&verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS, true);
+}
+
+static void host_fw_verify_linux_test_multiple_workers_bad_hash (CuTest *test)
+{
+	struct host_fw_verify_linux_testing verify;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_linux_testing_init (test, &verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS,
+		true);
+
+	verify.img_hash[HOST_FW_VERIFY_LINUX_TESTING_IMAGES - 1].hash[0] ^= 0x55;
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		verify.engines, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS);
+	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
+
+	host_fw_verify_linux_testing_release (&verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS, true);
+}
+
+static void host_fw_verify_linux_test_multiple_workers_error (CuTest *test)
+{
+	struct host_fw_verify_linux_testing verify;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_linux_testing_init (test, &verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS,
+		true);
+
+	/* A worker running on a separate thread fails.  The error must be reported to the caller. */
+	verify.worker_hash[2].fail = HASH_ENGINE_START_SHA256_FAILED;
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		verify.engines, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	CuAssertIntEquals (test, 1, verify.worker_hash[2].started);
+
+	host_fw_verify_linux_testing_release (&verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS, true);
+}
+
+static void host_fw_verify_linux_test_multiple_workers_calling_thread_error (CuTest *test)
+{
+	struct host_fw_verify_linux_testing verify;
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_linux_testing_init (test, &verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS,
+		true);
+
+	verify.worker_hash[0].fail = HASH_ENGINE_START_SHA256_FAILED;
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		verify.engines, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	CuAssertIntEquals (test, 1, verify.worker_hash[0].started);
+
+	host_fw_verify_linux_testing_release (&verify, HOST_FW_VERIFY_LINUX_TESTING_MAX_WORKERS, true);
+}
+
+static void host_fw_verify_linux_test_null (CuTest *test)
+{
+	struct host_fw_verify_linux_testing verify;
+	struct host_fw_verify_engines bad_engines[2];
+	int status;
+
+	TEST_START;
+
+	host_fw_verify_linux_testing_init (test, &verify, 1, false);
+
+	bad_engines[0] = verify.engines[0];
+	bad_engines[1].hash = NULL;
+	bad_engines[1].rsa = &verify.rsa.base;
+	bad_engines[1].pipeline = NULL;
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (NULL, verify.list, 2, 0,
+		verify.engines, 1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, NULL, 2, 0,
+		verify.engines, 1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		NULL, 1);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		verify.engines, 0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_offset_images_multiple_fw_linux (&verify.flash, verify.list, 2, 0,
+		bad_engines, 2);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	CuAssertIntEquals (test, 0, verify.worker_hash[0].started);
+
+	host_fw_verify_linux_testing_release (&verify, 1, false);
+}
+
+
+TEST_SUITE_START (host_fw_verify_linux);
+
+TEST (host_fw_verify_linux_test_single_worker);
+TEST (host_fw_verify_linux_test_multiple_workers);
+TEST (host_fw_verify_linux_test_multiple_workers_pipelined);
+TEST (host_fw_verify_linux_test_multiple_workers_bad_hash);
+TEST (host_fw_verify_linux_test_multiple_workers_error);
+TEST (host_fw_verify_linux_test_multiple_workers_calling_thread_error);
+TEST (host_fw_verify_linux_test_null);
+
+TEST_SUITE_END;
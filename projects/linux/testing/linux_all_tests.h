@@ -9,6 +9,8 @@
 #include "platform_all_tests.h"
 #include "asn1/linux_asn1_all_tests.h"
 #include "crypto/linux_crypto_all_tests.h"
+#include "flash/linux_flash_all_tests.h"
+#include "host_fw/linux_host_fw_all_tests.h"
 
 
 TEST_SUITE_LABEL ("linux");
@@ -34,6 +36,8 @@ void add_all_linux_tests (CuSuite *suite)
 
 	add_all_linux_asn1_tests (suite);
 	add_all_linux_crypto_tests (suite);
+	add_all_linux_flash_tests (suite);
+	add_all_linux_host_fw_tests (suite);
 
 	SUITE_ADD_TEST (suite, linux_teardown);
 }
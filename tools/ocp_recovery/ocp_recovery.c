@@ -19,6 +19,7 @@
 #include <linux/i2c-dev.h>
 #include "crypto/checksum.h"
 #include "logging/debug_log.h"
+#include "logging/debug_log_compact_format.h"
 
 
 /**
@@ -1500,6 +1501,55 @@ void parse_ocp_log (uint8_t *data, uint32_t length)
 	}
 }
 
+/**
+ * Print the records in a Cerberus log entry that uses the compact encoding.
+ *
+ * @param fd The output file descriptor.
+ * @param data The log entry data following the entry header.
+ * @param length Length of the log entry data.
+ */
+void parse_cerberus_compact_entry (int fd, uint8_t *data, uint32_t length)
+{
+	struct debug_log_entry_info entry;
+	uint32_t repeat;
+	uint32_t offset;
+	int record = 0;
+	int status;
+
+	status = debug_log_compact_decode_header (data, length, &entry);
+	if (status < 0) {
+		print_message (fd, "\tMalformed compact entry header\n");
+		return;
+	}
+
+	print_message (fd, "\tEntry Format:  0x%02x\n", DEBUG_LOG_ENTRY_FORMAT_COMPACT);
+
+	offset = status;
+	while (offset < length) {
+		status = debug_log_compact_decode_record (&data[offset], length - offset, &entry, &repeat);
+		if (status < 0) {
+			print_message (fd, "\tMalformed compact record at offset 0x%x\n", offset);
+			return;
+		}
+
+		if (repeat != 0) {
+			print_message (fd, "\t\tRepeated: %u times\n", repeat);
+			print_message (fd, "\t\tLast Timestamp: 0x%llx\n", entry.time);
+		}
+		else {
+			print_message (fd, "\tRecord: %d\n", record++);
+			print_message (fd, "\t\tSeverity: 0x%02x\n", entry.severity);
+			print_message (fd, "\t\tComponent: 0x%02x\n", entry.component);
+			print_message (fd, "\t\tMessage ID: 0x%02x\n", entry.msg_index);
+			print_message (fd, "\t\tArg1: 0x%08x\n", entry.arg1);
+			print_message (fd, "\t\tArg2: 0x%08x\n", entry.arg2);
+			print_message (fd, "\t\tTimestamp: 0x%llx\n", entry.time);
+		}
+
+		offset += status;
+	}
+}
+
 /**
  * Parse a device log using Cerberus log formatting.
  *
@@ -1520,7 +1570,7 @@ void parse_cerberus_log (uint8_t *data, uint32_t length)
 		}
 	}
 
-	while (length >= sizeof (struct debug_log_entry)) {
+	while (length >= (sizeof (struct logging_entry_header) + sizeof (msg->entry.format))) {
 		msg = (struct debug_log_entry*) data;
 
 		if (!LOGGING_IS_ENTRY_START (msg->header.log_magic)) {
@@ -1534,8 +1584,28 @@ void parse_cerberus_log (uint8_t *data, uint32_t length)
 			exit (1);
 		}
 
+		if (msg->header.length <
+			(sizeof (struct logging_entry_header) + sizeof (msg->entry.format))) {
+			print_message (fd, "Malformed entry length 0x%04x\n", msg->header.length);
+			exit (1);
+		}
+
 		print_message (fd, "Entry: 0x%08x\n", msg->header.entry_id);
 		print_message (fd, "\tHeader Format: 0x%02x\n", msg->header.log_magic);
+
+		if (msg->entry.format == DEBUG_LOG_ENTRY_FORMAT_COMPACT) {
+			parse_cerberus_compact_entry (fd, &data[sizeof (struct logging_entry_header)],
+				msg->header.length - sizeof (struct logging_entry_header));
+
+			data += msg->header.length;
+			length -= msg->header.length;
+			continue;
+		}
+		else if (msg->header.length < sizeof (struct debug_log_entry)) {
+			print_message (fd, "Malformed entry length 0x%04x\n", msg->header.length);
+			exit (1);
+		}
+
 		print_message (fd, "\tEntry Format:  0x%02x\n", msg->entry.format);
 		print_message (fd, "\tSeverity: 0x%02x\n", msg->entry.severity);
 		print_message (fd, "\tComponent: 0x%02x\n", msg->entry.component);
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "crypto/checksum.h"
+#include "mctp/mctp_base_protocol.h"
+
+
+/**
+ * Default number of times the CRC is calculated for each packet size.
+ */
+#define	BENCHMARK_DEFAULT_ITERATIONS	100000
+
+
+/**
+ * Get the current monotonic time.
+ *
+ * @return The current time, in nanoseconds.
+ */
+static uint64_t benchmark_get_time_ns (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t) now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+/**
+ * Calculate the SMBus CRC8 one bit at a time.  This is used as the baseline for comparison.
+ *
+ * @param crc The initial CRC value.
+ * @param data The data to add to the CRC.
+ * @param len Length of the data.
+ *
+ * @return The updated CRC value.
+ */
+static uint8_t benchmark_bitwise_crc8 (uint8_t crc, const uint8_t *data, uint8_t len)
+{
+	int i;
+	int j;
+
+	for (i = 0; i < len; ++i) {
+		crc ^= data[i];
+
+		for (j = 0; j < 8; ++j) {
+			if ((crc & 0x80) != 0) {
+				crc = (uint8_t) ((crc << 1) ^ 0x07);
+			}
+			else {
+				crc <<= 1;
+			}
+		}
+	}
+
+	return crc;
+}
+
+/**
+ * Measure the time needed to calculate the PEC for a single packet size.
+ *
+ * @param crc8 The CRC implementation to measure.
+ * @param packet The packet data.
+ * @param len Length of the packet.
+ * @param iterations The number of times to calculate the CRC.
+ * @param result Output for the calculated CRC.
+ *
+ * @return The average time for a single calculation, in nanoseconds.
+ */
+static double benchmark_run (uint8_t (*crc8) (uint8_t, const uint8_t*, uint8_t),
+	const uint8_t *packet, uint8_t len, int iterations, uint8_t *result)
+{
+	volatile uint8_t crc = 0;
+	uint64_t start;
+	int i;
+
+	start = benchmark_get_time_ns ();
+	for (i = 0; i < iterations; i++) {
+		crc = crc8 (crc, packet, len);
+	}
+
+	*result = crc;
+	return (double) (benchmark_get_time_ns () - start) / iterations;
+}
+
+int main (int argc, char *argv[])
+{
+	uint8_t packet[MCTP_BASE_PROTOCOL_MAX_PACKET_LEN];
+	int iterations = BENCHMARK_DEFAULT_ITERATIONS;
+	double bitwise_ns;
+	double table_ns;
+	double bitwise_total = 0;
+	double table_total = 0;
+	uint8_t bitwise_crc;
+	uint8_t table_crc;
+	int errors = 0;
+	int len;
+	int i;
+
+	if (argc > 2) {
+		printf ("Usage: %s [iterations]\n", argv[0]);
+		return 1;
+	}
+
+	if (argc > 1) {
+		iterations = atoi (argv[1]);
+	}
+
+	if (iterations <= 0) {
+		printf ("Invalid iteration count.\n");
+		return 1;
+	}
+
+	for (i = 0; i < (int) sizeof (packet); i++) {
+		packet[i] = rand ();
+	}
+
+	printf ("%d iterations per packet size, slice-by-8 %s\n", iterations,
+		CHECKSUM_SMBUS_CRC8_SLICE_BY_8 ? "enabled" : "disabled");
+	printf ("%6s %12s %12s %8s\n", "bytes", "bitwise ns", "table ns", "speedup");
+
+	for (len = 1; len <= (int) sizeof (packet); len++) {
+		bitwise_ns = benchmark_run (benchmark_bitwise_crc8, packet, len, iterations, &bitwise_crc);
+		table_ns = benchmark_run (checksum_update_smbus_crc8, packet, len, iterations, &table_crc);
+
+		if (bitwise_crc != table_crc) {
+			printf ("CRC mismatch for %d bytes: bitwise=0x%02x, table=0x%02x\n", len, bitwise_crc,
+				table_crc);
+			errors++;
+		}
+
+		printf ("%6d %12.1f %12.1f %7.1fx\n", len, bitwise_ns, table_ns, bitwise_ns / table_ns);
+
+		bitwise_total += bitwise_ns;
+		table_total += table_ns;
+	}
+
+	printf ("%6s %12.1f %12.1f %7.1fx\n", "all", bitwise_total, table_total,
+		bitwise_total / table_total);
+
+	return (errors != 0);
+}
@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "logging/logging_memory.h"
+#include "logging/debug_log.h"
+
+
+/**
+ * Number of entries that can be stored in the log.
+ */
+#define	BENCHMARK_LOG_ENTRIES		1024
+
+/**
+ * Default number of threads concurrently adding entries to the log.
+ */
+#define	BENCHMARK_DEFAULT_THREADS	4
+
+/**
+ * Default number of entries added by each thread.
+ */
+#define	BENCHMARK_DEFAULT_ENTRIES	200000
+
+
+/**
+ * Context for a single producer thread.
+ */
+struct benchmark_producer {
+	pthread_t thread;					/**< The thread adding log entries. */
+	struct logging_memory *logging;		/**< The log being updated. */
+	pthread_barrier_t *start;			/**< Barrier to start all producers at the same time. */
+	int entries;						/**< The number of entries to add. */
+	uint64_t worst_ns;					/**< The longest time spent adding a single entry. */
+	int errors;							/**< The number of failed calls to add an entry. */
+};
+
+
+/**
+ * Get the current monotonic time.
+ *
+ * @return The current time, in nanoseconds.
+ */
+static uint64_t benchmark_get_time_ns (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t) now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+/**
+ * Thread entry point to add entries to the log.
+ *
+ * @param arg The producer context.
+ *
+ * @return Always NULL.
+ */
+static void* benchmark_producer_thread (void *arg)
+{
+	struct benchmark_producer *producer = arg;
+	struct debug_log_entry_info entry;
+	uint64_t start;
+	uint64_t duration;
+	int i;
+
+	memset (&entry, 0, sizeof (entry));
+	entry.format = DEBUG_LOG_ENTRY_FORMAT;
+	entry.severity = DEBUG_LOG_SEVERITY_INFO;
+
+	pthread_barrier_wait (producer->start);
+
+	for (i = 0; i < producer->entries; i++) {
+		entry.arg1 = i;
+
+		start = benchmark_get_time_ns ();
+		if (producer->logging->base.create_entry (&producer->logging->base, (uint8_t*) &entry,
+			sizeof (entry)) != 0) {
+			producer->errors++;
+		}
+		duration = benchmark_get_time_ns () - start;
+
+		if (duration > producer->worst_ns) {
+			producer->worst_ns = duration;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Run a single benchmark pass against a new log.
+ *
+ * @param name Name of the log mode being tested.
+ * @param lock_free Flag indicating if the log should use lock-free entry creation.
+ * @param threads The number of producer threads to run.
+ * @param entries The number of entries each producer should add.
+ *
+ * @return 0 if the benchmark completed successfully or 1 if not.
+ */
+static int benchmark_run (const char *name, bool lock_free, int threads, int entries)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	struct benchmark_producer *producer;
+	pthread_barrier_t start;
+	uint64_t begin;
+	uint64_t total;
+	uint64_t worst = 0;
+	int errors = 0;
+	int status;
+	int i;
+
+	producer = calloc (threads, sizeof (struct benchmark_producer));
+	if (producer == NULL) {
+		printf ("Failed to allocate producer contexts.\n");
+		return 1;
+	}
+
+	status = logging_memory_init (&logging, &state, BENCHMARK_LOG_ENTRIES,
+		sizeof (struct debug_log_entry_info));
+	if (status != 0) {
+		printf ("Failed to initialize the log: 0x%x\n", status);
+		free (producer);
+		return 1;
+	}
+
+	if (lock_free) {
+		status = logging_memory_enable_lock_free (&logging);
+		if (status != 0) {
+			printf ("Failed to enable lock-free entries: 0x%x\n", status);
+			goto exit;
+		}
+	}
+
+	pthread_barrier_init (&start, NULL, threads + 1);
+
+	for (i = 0; i < threads; i++) {
+		producer[i].logging = &logging;
+		producer[i].start = &start;
+		producer[i].entries = entries;
+
+		pthread_create (&producer[i].thread, NULL, benchmark_producer_thread, &producer[i]);
+	}
+
+	begin = benchmark_get_time_ns ();
+	pthread_barrier_wait (&start);
+
+	for (i = 0; i < threads; i++) {
+		pthread_join (producer[i].thread, NULL);
+
+		errors += producer[i].errors;
+		if (producer[i].worst_ns > worst) {
+			worst = producer[i].worst_ns;
+		}
+	}
+
+	total = benchmark_get_time_ns () - begin;
+	pthread_barrier_destroy (&start);
+
+	printf ("%-10s %10.1f ns/entry %10.3f ms total %10llu ns worst %d errors\n", name,
+		(double) total / ((uint64_t) threads * entries), (double) total / 1000000.0,
+		(unsigned long long) worst, errors);
+
+	status = (errors != 0);
+
+exit:
+	logging_memory_release (&logging);
+	free (producer);
+
+	return (status != 0);
+}
+
+int main (int argc, char *argv[])
+{
+	int threads = BENCHMARK_DEFAULT_THREADS;
+	int entries = BENCHMARK_DEFAULT_ENTRIES;
+	int status;
+
+	if (argc > 3) {
+		printf ("Usage: %s [threads] [entries per thread]\n", argv[0]);
+		return 1;
+	}
+
+	if (argc > 1) {
+		threads = atoi (argv[1]);
+	}
+	if (argc > 2) {
+		entries = atoi (argv[2]);
+	}
+
+	if ((threads <= 0) || (entries <= 0)) {
+		printf ("Invalid thread or entry count.\n");
+		return 1;
+	}
+
+	printf ("%d threads, %d entries per thread\n", threads, entries);
+
+	status = benchmark_run ("mutex", false, threads, entries);
+	status |= benchmark_run ("lock-free", true, threads, entries);
+
+	return status;
+}
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "cmd_interface/session_manager.h"
+#include "crypto/aes_openssl.h"
+#include "mctp/mctp_base_protocol.h"
+
+
+/**
+ * Default number of encrypted exchanges executed for each message size.
+ */
+#define	BENCHMARK_DEFAULT_ITERATIONS	20000
+
+/**
+ * EID of the device participating in the encrypted session.
+ */
+#define	BENCHMARK_EID					0x10
+
+
+/**
+ * Get the current monotonic time.
+ *
+ * @return The current time, in nanoseconds.
+ */
+static uint64_t benchmark_get_time_ns (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t) now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+/**
+ * Measure the time needed for encrypted exchanges with a single device.  Each exchange encrypts a
+ * message and then decrypts it again, which is the same work needed to receive an encrypted request
+ * and send an encrypted response.
+ *
+ * @param session The session manager to use for the exchanges.
+ * @param len Length of the message, including the Cerberus protocol header.
+ * @param iterations The number of exchanges to execute.
+ * @param reload Flag to discard the cached AES key before every message.  This matches the cost of
+ * setting the session key for every message.
+ * @param errors Incremented for every exchange that fails or does not return the original message.
+ *
+ * @return The average time for a single exchange, in nanoseconds.
+ */
+static double benchmark_run (struct session_manager *session, size_t len, int iterations,
+	bool reload, int *errors)
+{
+	static uint8_t buffer[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	static uint8_t message[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg request;
+	uint64_t start;
+	int status;
+	int i;
+
+	for (i = 0; i < (int) len; i++) {
+		message[i] = rand ();
+	}
+	message[0] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+
+	request.data = buffer;
+	request.source_eid = BENCHMARK_EID;
+	request.max_response = sizeof (buffer);
+
+	start = benchmark_get_time_ns ();
+	for (i = 0; i < iterations; i++) {
+		memcpy (buffer, message, len);
+		request.length = len;
+
+		if (reload) {
+			session->default_slot.loaded_key = NULL;
+		}
+
+		status = session_manager_encrypt_message (session, &request);
+		if (status != 0) {
+			(*errors)++;
+			continue;
+		}
+
+		if (reload) {
+			session->default_slot.loaded_key = NULL;
+		}
+
+		status = session_manager_decrypt_message (session, &request);
+		if ((status != 0) || (request.length != len) ||
+			(memcmp (&buffer[CERBERUS_PROTOCOL_HEADER_SIZE_NO_ID],
+				&message[CERBERUS_PROTOCOL_HEADER_SIZE_NO_ID],
+				len - CERBERUS_PROTOCOL_HEADER_SIZE_NO_ID) != 0)) {
+			(*errors)++;
+		}
+	}
+
+	return (double) (benchmark_get_time_ns () - start) / iterations;
+}
+
+int main (int argc, char *argv[])
+{
+	const size_t sizes[] = {
+		16, 64, 256, 1024, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY - SESSION_MANAGER_TRAILER_LEN
+	};
+	struct aes_engine_openssl aes;
+	struct hash_engine hash;
+	struct riot_key_manager riot;
+	struct session_manager session;
+	struct session_manager_entry sessions[1];
+	int iterations = BENCHMARK_DEFAULT_ITERATIONS;
+	double reload_ns;
+	double cached_ns;
+	int errors = 0;
+	size_t i;
+	int status;
+
+	if (argc > 2) {
+		printf ("Usage: %s [iterations]\n", argv[0]);
+		return 1;
+	}
+
+	if (argc > 1) {
+		iterations = atoi (argv[1]);
+	}
+
+	if (iterations <= 0) {
+		printf ("Invalid iteration count.\n");
+		return 1;
+	}
+
+	status = aes_openssl_init (&aes);
+	if (status != 0) {
+		printf ("aes_openssl_init failed: 0x%x\n", status);
+		return 1;
+	}
+
+	/* The hash engine and key manager are only needed to establish sessions, which is not part of
+	 * the measurement. */
+	memset (&hash, 0, sizeof (hash));
+	memset (&riot, 0, sizeof (riot));
+
+	status = session_manager_init (&session, &aes.base, &hash, &riot, sessions, 1, NULL, 0, NULL);
+	if (status != 0) {
+		printf ("session_manager_init failed: 0x%x\n", status);
+		aes_openssl_release (&aes);
+		return 1;
+	}
+
+	for (i = 0; i < sizeof (sessions[0].session_key); i++) {
+		sessions[0].session_key[i] = rand ();
+	}
+	sessions[0].eid = BENCHMARK_EID;
+	sessions[0].session_state = SESSION_STATE_ESTABLISHED;
+
+	printf ("%d encrypt/decrypt exchanges per message size\n", iterations);
+	printf ("%6s %12s %12s %8s\n", "bytes", "reload ns", "cached ns", "speedup");
+
+	for (i = 0; i < (sizeof (sizes) / sizeof (sizes[0])); i++) {
+		reload_ns = benchmark_run (&session, sizes[i], iterations, true, &errors);
+		cached_ns = benchmark_run (&session, sizes[i], iterations, false, &errors);
+
+		printf ("%6zu %12.1f %12.1f %7.2fx\n", sizes[i], reload_ns, cached_ns,
+			reload_ns / cached_ns);
+	}
+
+	if (errors != 0) {
+		printf ("%d exchanges failed\n", errors);
+	}
+
+	session_manager_release (&session);
+	aes_openssl_release (&aes);
+
+	return (errors != 0);
+}